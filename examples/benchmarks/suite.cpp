@@ -0,0 +1,618 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/*
+*   Benchmark:  Unified suite of BLAS 1/2/3, sparse matrix (all formats), solver, preconditioner, and FFT benchmarks
+*               with machine-readable output (suite.cpp and suite.cu are identical, the latter being required for compilation using CUDA nvcc)
+*
+*   Usage: suite [--size small|medium|large] [--precision float|double] [--filter STRING] [--min-time SECONDS]
+*                [--matrix FILE.mtx]... [--peak-bandwidth GB/s] [--peak-gflops GFLOPs/s] [--json FILE]
+*
+*   Each benchmark is repeated until at least --min-time seconds have passed, and the mean time per run is reported.
+*   Efficiencies are relative to the given peaks, or otherwise relative to the measured vector copy bandwidth and the fastest matrix-matrix product.
+*/
+
+#ifndef NDEBUG
+ #define NDEBUG
+#endif
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/compressed_compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/auto_sparse_matrix.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/row_scaling.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/amg.hpp"
+#include "viennacl/fft.hpp"
+#include "viennacl/linalg/fft_operations.hpp"
+#include "viennacl/io/matrix_market.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/tools/timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/** @brief Timing of a single benchmark */
+struct benchmark_result
+{
+  std::string family;
+  std::string name;
+  std::size_t iterations;
+  double      time;       // mean time per run in seconds
+  double      min_time;
+  double      bytes;      // bytes moved per run (estimate)
+  double      flops;      // floating point operations per run
+};
+
+/** @brief Options, results and output of the suite */
+class benchmark_runner
+{
+public:
+  benchmark_runner() : size_("medium"), precision_("double"), min_time_(0.5), peak_bandwidth_(0), peak_gflops_(0) {}
+
+  bool parse(int argc, char ** argv)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string arg(argv[i]);
+      if (arg == "--help" || i + 1 >= argc)
+      {
+        std::cout << "Usage: " << argv[0] << " [--size small|medium|large] [--precision float|double] [--filter STRING] [--min-time SECONDS]" << std::endl
+                  << "       [--matrix FILE.mtx]... [--peak-bandwidth GB/s] [--peak-gflops GFLOPs/s] [--json FILE]" << std::endl;
+        return false;
+      }
+      std::string value(argv[++i]);
+      if      (arg == "--size")           size_ = value;
+      else if (arg == "--precision")      precision_ = value;
+      else if (arg == "--filter")         filter_ = value;
+      else if (arg == "--min-time")       min_time_ = std::atof(value.c_str());
+      else if (arg == "--matrix")         matrix_files_.push_back(value);
+      else if (arg == "--peak-bandwidth") peak_bandwidth_ = std::atof(value.c_str());
+      else if (arg == "--peak-gflops")    peak_gflops_ = std::atof(value.c_str());
+      else if (arg == "--json")           json_file_ = value;
+      else
+      {
+        std::cerr << "Unknown option: " << arg << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** @brief Problem size scaling: 0 for small, 1 for medium, 2 for large */
+  int scale() const { return (size_ == "small") ? 0 : ((size_ == "large") ? 2 : 1); }
+  std::string const & precision() const { return precision_; }
+  double min_time() const { return min_time_; }
+  std::vector<std::string> const & matrix_files() const { return matrix_files_; }
+
+  bool selected(std::string const & family, std::string const & name) const
+  {
+    return filter_.empty() || (family + "/" + name).find(filter_) != std::string::npos;
+  }
+
+  void add(std::string const & family, std::string const & name, std::vector<double> const & timings, double bytes, double flops)
+  {
+    benchmark_result r;
+    r.family = family;
+    r.name = name;
+    r.iterations = timings.size();
+    r.time = 0;
+    r.min_time = timings[0];
+    for (std::size_t i=0; i<timings.size(); ++i)
+    {
+      r.time += timings[i];
+      r.min_time = std::min(r.min_time, timings[i]);
+    }
+    r.time /= double(timings.size());
+    r.bytes = bytes;
+    r.flops = flops;
+    results_.push_back(r);
+
+    std::cout << std::left << std::setw(48) << (family + "/" + name) << std::right
+              << std::setw(14) << std::setprecision(2) << std::fixed << 1e6 * r.time
+              << std::setw(12) << r.iterations
+              << std::setw(12) << (bytes > 0 ? 1e-9 * bytes / r.time : 0.0)
+              << std::setw(12) << (flops > 0 ? 1e-9 * flops / r.time : 0.0) << std::endl;
+  }
+
+  void print_header() const
+  {
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+              << std::setw(14) << "Time [us]" << std::setw(12) << "Runs" << std::setw(12) << "GB/s" << std::setw(12) << "GFLOPs/s" << std::endl;
+  }
+
+  /** @brief Reference bandwidth in GB/s: the given peak, or the measured vector copy bandwidth */
+  double peak_bandwidth() const
+  {
+    if (peak_bandwidth_ > 0)
+      return peak_bandwidth_;
+    double result = 0;
+    for (std::size_t i=0; i<results_.size(); ++i)
+      if (results_[i].family == "blas1" && results_[i].name == "copy")
+        result = std::max(result, 1e-9 * results_[i].bytes / results_[i].time);
+    return result;
+  }
+
+  /** @brief Reference floating point rate in GFLOPs/s: the given peak, or the fastest dense matrix-matrix product */
+  double peak_gflops() const
+  {
+    if (peak_gflops_ > 0)
+      return peak_gflops_;
+    double result = 0;
+    for (std::size_t i=0; i<results_.size(); ++i)
+      if (results_[i].family == "blas3")
+        result = std::max(result, 1e-9 * results_[i].flops / results_[i].time);
+    return result;
+  }
+
+  /** @brief Writes all results in a JSON format similar to the one of Google Benchmark */
+  void write_json() const
+  {
+    if (json_file_.empty())
+      return;
+
+    char date[64];
+    std::time_t now = std::time(NULL);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    double bw = peak_bandwidth();
+    double gf = peak_gflops();
+
+    std::ofstream json(json_file_.c_str());
+    json << std::setprecision(9);
+    json << "{" << std::endl;
+    json << "  \"context\": {" << std::endl;
+    json << "    \"date\": \"" << date << "\"," << std::endl;
+    json << "    \"library\": \"ViennaCL " << VIENNACL_MAJOR_VERSION << "." << VIENNACL_MINOR_VERSION << "." << VIENNACL_PATCH_VERSION << "\"," << std::endl;
+    json << "    \"backend\": \"" << backend_name() << "\"," << std::endl;
+    json << "    \"precision\": \"" << precision_ << "\"," << std::endl;
+    json << "    \"size\": \"" << size_ << "\"," << std::endl;
+    json << "    \"min_time\": " << min_time_ << "," << std::endl;
+    json << "    \"peak_bandwidth_gbs\": " << bw << "," << std::endl;
+    json << "    \"peak_gflops\": " << gf << std::endl;
+    json << "  }," << std::endl;
+    json << "  \"benchmarks\": [" << std::endl;
+    for (std::size_t i=0; i<results_.size(); ++i)
+    {
+      benchmark_result const & r = results_[i];
+      json << "    {" << std::endl;
+      json << "      \"name\": \"" << escape(r.family + "/" + r.name) << "\"," << std::endl;
+      json << "      \"family\": \"" << r.family << "\"," << std::endl;
+      json << "      \"iterations\": " << r.iterations << "," << std::endl;
+      json << "      \"real_time\": " << 1e9 * r.time << "," << std::endl;
+      json << "      \"min_time\": " << 1e9 * r.min_time << "," << std::endl;
+      json << "      \"time_unit\": \"ns\"," << std::endl;
+      json << "      \"bytes_per_second\": " << r.bytes / r.time << "," << std::endl;
+      json << "      \"flops_per_second\": " << r.flops / r.time << "," << std::endl;
+      json << "      \"bandwidth_efficiency\": " << ((bw > 0) ? 1e-9 * r.bytes / r.time / bw : 0.0) << "," << std::endl;
+      json << "      \"flop_efficiency\": " << ((gf > 0) ? 1e-9 * r.flops / r.time / gf : 0.0) << std::endl;
+      json << "    }" << ((i + 1 < results_.size()) ? "," : "") << std::endl;
+    }
+    json << "  ]" << std::endl;
+    json << "}" << std::endl;
+
+    std::cout << "Results written to " << json_file_ << std::endl;
+  }
+
+  static std::string backend_name()
+  {
+#if defined(VIENNACL_WITH_CUDA)
+    return "cuda";
+#elif defined(VIENNACL_WITH_OPENCL)
+    return "opencl";
+#elif defined(VIENNACL_WITH_OPENMP)
+    return "openmp";
+#else
+    return "host";
+#endif
+  }
+
+private:
+  static std::string escape(std::string const & s)
+  {
+    std::string result;
+    for (std::size_t i=0; i<s.size(); ++i)
+    {
+      if (s[i] == '"' || s[i] == '\\')
+        result += '\\';
+      result += s[i];
+    }
+    return result;
+  }
+
+  std::string                    size_;
+  std::string                    precision_;
+  std::string                    filter_;
+  double                         min_time_;
+  std::vector<std::string>       matrix_files_;
+  double                         peak_bandwidth_;
+  double                         peak_gflops_;
+  std::string                    json_file_;
+  std::vector<benchmark_result>  results_;
+};
+
+
+/** @brief Runs OPERATION once for warm-up, then repeatedly until the minimum time has passed, and records the mean time per run. Failing benchmarks (e.g. singular factorizations of user-supplied matrices) are skipped. */
+#define BENCHMARK_OP(RUNNER, FAMILY, NAME, OPERATION, BYTES, FLOPS) \
+  if (RUNNER.selected(FAMILY, NAME)) \
+  { \
+    try \
+    { \
+      OPERATION; \
+      viennacl::backend::finish(); \
+      std::vector<double> timings; \
+      double time_spent = 0; \
+      viennacl::tools::timer timer; \
+      while (time_spent < RUNNER.min_time() || timings.size() < 3) \
+      { \
+        timer.start(); \
+        OPERATION; \
+        viennacl::backend::finish(); \
+        timings.push_back(timer.get()); \
+        time_spent += timings.back(); \
+      } \
+      RUNNER.add(FAMILY, NAME, timings, BYTES, FLOPS); \
+    } \
+    catch (std::exception const & e) \
+    { \
+      std::cout << std::left << std::setw(48) << (std::string(FAMILY) + "/" + NAME) << std::right << "  skipped: " << e.what() << std::endl; \
+    } \
+  }
+
+
+template<typename T>
+void init_random(viennacl::vector<T> & x)
+{
+  std::vector<T> cx(x.size());
+  for (std::size_t i = 0; i < cx.size(); ++i)
+    cx[i] = T(rand())/T(RAND_MAX);
+  viennacl::copy(cx, x);
+}
+
+template<typename T, typename F>
+void init_random(viennacl::matrix<T, F> & M)
+{
+  std::vector<T> cM(M.internal_size());
+  for (std::size_t i = 0; i < M.size1(); ++i)
+    for (std::size_t j = 0; j < M.size2(); ++j)
+      cM[F::mem_index(i, j, M.internal_size1(), M.internal_size2())] = T(rand())/T(RAND_MAX);
+  viennacl::fast_copy(&cM[0], &cM[0] + cM.size(), M);
+}
+
+
+template<typename T>
+void bench_blas1(benchmark_runner & runner, std::size_t N)
+{
+  using viennacl::linalg::inner_prod;
+  using viennacl::linalg::norm_2;
+
+  viennacl::vector<T> x(N), y(N), z(N);
+  viennacl::scalar<T> s(0);
+  T alpha = T(2.4), beta = T(0.5);
+  init_random(x);
+  init_random(y);
+  init_random(z);
+
+  double n = double(N), bytes = double(N * sizeof(T));
+  BENCHMARK_OP(runner, "blas1", "copy",      x = y,                          2 * bytes, 0)
+  BENCHMARK_OP(runner, "blas1", "scale",     x = alpha * y,                  2 * bytes, n)
+  BENCHMARK_OP(runner, "blas1", "axpy",      x = y + alpha * x,              3 * bytes, 2 * n)
+  BENCHMARK_OP(runner, "blas1", "axpbypz",   x = alpha * y + beta * z + x,   4 * bytes, 4 * n)
+  BENCHMARK_OP(runner, "blas1", "dot",       s = inner_prod(x, y),           2 * bytes, 2 * n)
+  BENCHMARK_OP(runner, "blas1", "norm_2",    s = norm_2(x),                  bytes,     2 * n)
+}
+
+template<typename T>
+void bench_blas2(benchmark_runner & runner, std::size_t M, std::size_t N)
+{
+  using viennacl::linalg::prod;
+  using viennacl::trans;
+
+  viennacl::matrix<T> A(M, N);
+  viennacl::matrix<T, viennacl::column_major> A_col(M, N);
+  viennacl::vector<T> x(N), y(M);
+  init_random(A);
+  init_random(A_col);
+  init_random(x);
+  init_random(y);
+
+  double bytes = double((M * N + M + N) * sizeof(T)), flops = 2.0 * double(M) * double(N);
+  BENCHMARK_OP(runner, "blas2", "gemv-N-row", y = prod(A, x),            bytes, flops)
+  BENCHMARK_OP(runner, "blas2", "gemv-T-row", x = prod(trans(A), y),     bytes, flops)
+  BENCHMARK_OP(runner, "blas2", "gemv-N-col", y = prod(A_col, x),        bytes, flops)
+  BENCHMARK_OP(runner, "blas2", "gemv-T-col", x = prod(trans(A_col), y), bytes, flops)
+}
+
+template<typename T>
+void bench_blas3(benchmark_runner & runner, std::size_t M, std::size_t N, std::size_t K)
+{
+  using viennacl::linalg::prod;
+  using viennacl::trans;
+
+  viennacl::matrix<T> C(M, N), A(M, K), B(K, N);
+  init_random(A);
+  init_random(B);
+  viennacl::matrix<T> AT = trans(A);
+  viennacl::matrix<T> BT = trans(B);
+
+  double bytes = double((M * K + K * N + 2 * M * N) * sizeof(T)), flops = 2.0 * double(M) * double(N) * double(K);
+  BENCHMARK_OP(runner, "blas3", "gemm-NN", C = prod(A, B),                 bytes, flops)
+  BENCHMARK_OP(runner, "blas3", "gemm-NT", C = prod(A, trans(BT)),         bytes, flops)
+  BENCHMARK_OP(runner, "blas3", "gemm-TN", C = prod(trans(AT), B),         bytes, flops)
+  BENCHMARK_OP(runner, "blas3", "gemm-TT", C = prod(trans(AT), trans(BT)), bytes, flops)
+}
+
+
+/** @brief Sparse matrix-vector products of all formats, sparse matrix-dense matrix products, and sparse matrix-matrix products */
+template<typename T>
+void bench_sparse(benchmark_runner & runner, std::vector< std::map<unsigned int, T> > const & std_A, std::string const & label)
+{
+  using viennacl::linalg::prod;
+
+  viennacl::compressed_matrix<T>            A_csr;
+  viennacl::coordinate_matrix<T>            A_coo;
+  viennacl::ell_matrix<T>                   A_ell;
+  viennacl::sliced_ell_matrix<T>            A_sell;
+  viennacl::hyb_matrix<T>                   A_hyb;
+  viennacl::copy(std_A, A_csr);
+  viennacl::copy(std_A, A_coo);
+  viennacl::copy(std_A, A_ell);
+  viennacl::copy(std_A, A_sell);
+  viennacl::copy(std_A, A_hyb);
+
+  std::size_t rows = A_csr.size1(), cols = A_csr.size2();
+  double nnz = double(A_csr.nnz());
+  viennacl::vector<T> x(cols), y(rows);
+  init_random(x);
+
+  double spmv_bytes = nnz * double(sizeof(T) + sizeof(unsigned int)) + double((rows + 1) * sizeof(unsigned int)) + double((rows + cols) * sizeof(T));
+  BENCHMARK_OP(runner, "spmv", "csr/"       + label, y = prod(A_csr,  x), spmv_bytes, 2 * nnz)
+  BENCHMARK_OP(runner, "spmv", "coo/"       + label, y = prod(A_coo,  x), spmv_bytes, 2 * nnz)
+  BENCHMARK_OP(runner, "spmv", "ell/"       + label, y = prod(A_ell,  x), spmv_bytes, 2 * nnz)
+  BENCHMARK_OP(runner, "spmv", "sliced_ell/"+ label, y = prod(A_sell, x), spmv_bytes, 2 * nnz)
+  BENCHMARK_OP(runner, "spmv", "hyb/"       + label, y = prod(A_hyb,  x), spmv_bytes, 2 * nnz)
+
+  if (rows == cols)
+  {
+    viennacl::compressed_compressed_matrix<T> A_ccsr;
+    viennacl::copy(std_A, A_ccsr);
+    BENCHMARK_OP(runner, "spmv", "compressed_csr/" + label, y = prod(A_ccsr, x), spmv_bytes, 2 * nnz)
+  }
+
+  // format selected by the performance model:
+  viennacl::auto_sparse_matrix<T> A_auto;
+  viennacl::copy(std_A, A_auto);
+  BENCHMARK_OP(runner, "spmv", "auto/" + label, y = prod(A_auto, x), spmv_bytes, 2 * nnz)
+
+  // sparse matrix times dense matrix with a few columns:
+  std::size_t K = 8;
+  viennacl::matrix<T> X(cols, K), Y(rows, K);
+  init_random(X);
+  double spmm_bytes = nnz * double(sizeof(T) + sizeof(unsigned int)) + double((rows + 1) * sizeof(unsigned int)) + double((rows + cols) * K * sizeof(T));
+  BENCHMARK_OP(runner, "spmm", "csr/" + label, Y = prod(A_csr, X), spmm_bytes, 2 * nnz * double(K))
+  BENCHMARK_OP(runner, "spmm", "coo/" + label, Y = prod(A_coo, X), spmm_bytes, 2 * nnz * double(K))
+  BENCHMARK_OP(runner, "spmm", "ell/" + label, Y = prod(A_ell, X), spmm_bytes, 2 * nnz * double(K))
+  BENCHMARK_OP(runner, "spmm", "hyb/" + label, Y = prod(A_hyb, X), spmm_bytes, 2 * nnz * double(K))
+
+  // sparse matrix-matrix product A*A:
+  if (rows == cols)
+  {
+    double spgemm_flops = 0;
+    for (std::size_t i=0; i<std_A.size(); ++i)
+      for (typename std::map<unsigned int, T>::const_iterator it = std_A[i].begin(); it != std_A[i].end(); ++it)
+        spgemm_flops += 2.0 * double(std_A[it->first].size());
+
+    viennacl::compressed_matrix<T> C = prod(A_csr, A_csr);
+    double spgemm_bytes = 2 * nnz * double(sizeof(T) + sizeof(unsigned int)) + double(C.nnz()) * double(sizeof(T) + sizeof(unsigned int));
+    BENCHMARK_OP(runner, "spgemm", "csr/" + label, C = prod(A_csr, A_csr), spgemm_bytes, spgemm_flops)
+  }
+}
+
+
+/** @brief Setup and application of each preconditioner, and a fixed number of iterations of each solver */
+template<typename T>
+void bench_solvers(benchmark_runner & runner, std::vector< std::map<unsigned int, T> > const & std_A, std::string const & label, bool spd)
+{
+  typedef viennacl::compressed_matrix<T>                                                   MatrixType;
+  typedef viennacl::linalg::jacobi_precond<MatrixType>                                     jacobi_type;
+  typedef viennacl::linalg::row_scaling<MatrixType>                                        row_scaling_type;
+  typedef viennacl::linalg::ilu0_precond<MatrixType>                                       ilu0_type;
+  typedef viennacl::linalg::ilut_precond<MatrixType>                                       ilut_type;
+  typedef viennacl::linalg::block_ilu_precond<MatrixType, viennacl::linalg::ilu0_tag>      block_ilu0_type;
+  typedef viennacl::linalg::chow_patel_ilu_precond<MatrixType>                             chow_patel_type;
+  typedef viennacl::linalg::amg_precond<MatrixType>                                        amg_type;
+
+  using viennacl::linalg::solve;
+
+  MatrixType A;
+  viennacl::copy(std_A, A);
+  if (A.size1() != A.size2())
+    return;
+
+  viennacl::vector<T> b = viennacl::scalar_vector<T>(A.size1(), T(1));
+  viennacl::vector<T> x(A.size1()), r(A.size1());
+
+  // fixed number of iterations: tolerance is never reached
+  unsigned int iterations = 20;
+  viennacl::linalg::cg_tag       cg_tag(1e-30, iterations);
+  viennacl::linalg::bicgstab_tag bicgstab_tag(1e-30, iterations, iterations);
+  viennacl::linalg::gmres_tag    gmres_tag(1e-30, iterations, iterations);
+
+  std::string const it_label = label + "/" + "20it";
+  if (spd)
+    BENCHMARK_OP(runner, "solver", "cg/" + it_label,     x = solve(A, b, cg_tag),       0, 0)
+  BENCHMARK_OP(runner, "solver", "bicgstab/" + it_label, x = solve(A, b, bicgstab_tag), 0, 0)
+  BENCHMARK_OP(runner, "solver", "gmres/" + it_label,    x = solve(A, b, gmres_tag),    0, 0)
+
+  viennacl::linalg::amg_tag amg_tag;
+  amg_tag.set_coarsening_method(viennacl::linalg::AMG_COARSENING_METHOD_MIS2_AGGREGATION);
+  amg_tag.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION);
+
+  BENCHMARK_OP(runner, "precond_setup", "jacobi/" + label,      jacobi_type      p(A, viennacl::linalg::jacobi_tag()),      0, 0)
+  BENCHMARK_OP(runner, "precond_setup", "row_scaling/" + label, row_scaling_type p(A, viennacl::linalg::row_scaling_tag()), 0, 0)
+  BENCHMARK_OP(runner, "precond_setup", "ilu0/" + label,        ilu0_type        p(A, viennacl::linalg::ilu0_tag()),        0, 0)
+  BENCHMARK_OP(runner, "precond_setup", "ilut/" + label,        ilut_type        p(A, viennacl::linalg::ilut_tag()),        0, 0)
+  BENCHMARK_OP(runner, "precond_setup", "block_ilu0/" + label,  block_ilu0_type  p(A, viennacl::linalg::ilu0_tag()),        0, 0)
+  BENCHMARK_OP(runner, "precond_setup", "chow_patel/" + label,  chow_patel_type  p(A, viennacl::linalg::chow_patel_tag()),  0, 0)
+  if (spd)  // aggregation-based AMG is only robust for the generated model problem
+    BENCHMARK_OP(runner, "precond_setup", "amg/" + label,       amg_type         p(A, amg_tag); p.setup(),                  0, 0)
+
+  jacobi_type      jacobi(A, viennacl::linalg::jacobi_tag());
+  row_scaling_type row_scaling(A, viennacl::linalg::row_scaling_tag());
+  ilu0_type        ilu0(A, viennacl::linalg::ilu0_tag());
+  ilut_type        ilut(A, viennacl::linalg::ilut_tag());
+  block_ilu0_type  block_ilu0(A, viennacl::linalg::ilu0_tag());
+  chow_patel_type  chow_patel(A, viennacl::linalg::chow_patel_tag());
+  amg_type         amg(A, amg_tag);
+  if (spd)
+    amg.setup();
+
+  double vec_bytes = double(A.size1() * sizeof(T));
+  BENCHMARK_OP(runner, "precond_apply", "jacobi/" + label,      r = b; jacobi.apply(r),      3 * vec_bytes, 0)
+  BENCHMARK_OP(runner, "precond_apply", "row_scaling/" + label, r = b; row_scaling.apply(r), 3 * vec_bytes, 0)
+  BENCHMARK_OP(runner, "precond_apply", "ilu0/" + label,        r = b; ilu0.apply(r),        0, 0)
+  BENCHMARK_OP(runner, "precond_apply", "ilut/" + label,        r = b; ilut.apply(r),        0, 0)
+  BENCHMARK_OP(runner, "precond_apply", "block_ilu0/" + label,  r = b; block_ilu0.apply(r),  0, 0)
+  BENCHMARK_OP(runner, "precond_apply", "chow_patel/" + label,  r = b; chow_patel.apply(r),  0, 0)
+  if (spd)
+    BENCHMARK_OP(runner, "precond_apply", "amg/" + label,       r = b; amg.apply(r),         0, 0)
+
+  if (spd)
+  {
+    BENCHMARK_OP(runner, "solver", "cg+jacobi/" + it_label, x = solve(A, b, cg_tag, jacobi), 0, 0)
+    BENCHMARK_OP(runner, "solver", "cg+ilu0/" + it_label,   x = solve(A, b, cg_tag, ilu0),   0, 0)
+    BENCHMARK_OP(runner, "solver", "cg+amg/" + it_label,    x = solve(A, b, cg_tag, amg),    0, 0)
+  }
+  else
+  {
+    BENCHMARK_OP(runner, "solver", "bicgstab+jacobi/" + it_label, x = solve(A, b, bicgstab_tag, jacobi), 0, 0)
+    BENCHMARK_OP(runner, "solver", "bicgstab+ilu0/" + it_label,   x = solve(A, b, bicgstab_tag, ilu0),   0, 0)
+  }
+}
+
+
+template<typename T>
+void bench_fft(benchmark_runner & runner, std::size_t N)
+{
+  // complex numbers are stored interleaved:
+  viennacl::vector<T> input(2 * N), output(2 * N);
+  init_random(input);
+
+  double n = double(N), flops = 5.0 * n * std::log(n) / std::log(2.0);
+  BENCHMARK_OP(runner, "fft", "fft-1d",         viennacl::fft(input, output),  4 * n * sizeof(T), flops)
+  BENCHMARK_OP(runner, "fft", "inplace_fft-1d", viennacl::inplace_fft(input),  4 * n * sizeof(T), flops)
+}
+
+
+template<typename T>
+void run_suite(benchmark_runner & runner)
+{
+  int s = runner.scale();
+  std::size_t blas1_N[]      = {100000, 1000000, 10000000};
+  std::size_t blas2_N[]      = {500, 2000, 5000};
+  std::size_t blas3_N[]      = {128, 512, 1536};
+  std::size_t laplace_N[]    = {100, 300, 1000};
+  std::size_t solver_N[]     = {50, 150, 400};
+  std::size_t fft_N[]        = {4096, 65536, 1048576};
+
+  runner.print_header();
+
+  bench_blas1<T>(runner, blas1_N[s]);
+  bench_blas2<T>(runner, blas2_N[s], blas2_N[s]);
+  bench_blas3<T>(runner, blas3_N[s], blas3_N[s], blas3_N[s]);
+
+  std::ostringstream laplace_label;
+  laplace_label << "laplace" << laplace_N[s];
+  std::vector< std::map<unsigned int, T> > std_A;
+  viennacl::tools::sparse_matrix_adapter<T> adapted_A(std_A);
+  viennacl::tools::generate_fdm_laplace(adapted_A, laplace_N[s], laplace_N[s]);
+  bench_sparse<T>(runner, std_A, laplace_label.str());
+
+  std::ostringstream solver_label;
+  solver_label << "laplace" << solver_N[s];
+  viennacl::tools::generate_fdm_laplace(adapted_A, solver_N[s], solver_N[s]);
+  bench_solvers<T>(runner, std_A, solver_label.str(), true);
+
+  for (std::size_t i=0; i<runner.matrix_files().size(); ++i)
+  {
+    std::string const & file = runner.matrix_files()[i];
+    std::vector< std::map<unsigned int, T> > std_M;
+    if (!viennacl::io::read_matrix_market_file(std_M, file) || std_M.empty())
+    {
+      std::cerr << "Error reading matrix file " << file << std::endl;
+      continue;
+    }
+    std::string label = file.substr(file.find_last_of("/\\") + 1);
+    bench_sparse<T>(runner, std_M, label);
+    bench_solvers<T>(runner, std_M, label, false);
+  }
+
+  bench_fft<T>(runner, fft_N[s]);
+
+  std::cout << std::endl << "Reference bandwidth: " << runner.peak_bandwidth() << " GB/s, reference floating point rate: " << runner.peak_gflops() << " GFLOPs/s" << std::endl;
+  runner.write_json();
+}
+
+
+int main(int argc, char ** argv)
+{
+  benchmark_runner runner;
+  if (!runner.parse(argc, argv))
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  std::cout << viennacl::ocl::current_device().info() << std::endl;
+  if (runner.precision() == "double" && !viennacl::ocl::current_device().double_support())
+  {
+    std::cerr << "Device does not support double precision, use --precision float" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  std::cout << "# Backend: " << benchmark_runner::backend_name() << ", precision: " << runner.precision() << std::endl;
+  if (runner.precision() == "float")
+    run_suite<float>(runner);
+  else
+    run_suite<double>(runner);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1 @@
+suite.cpp
\ No newline at end of file
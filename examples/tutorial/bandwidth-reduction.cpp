@@ -33,6 +33,8 @@
 #include <deque>
 #include <cmath>
 
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/misc/bandwidth_reduction.hpp"
 
 
@@ -295,6 +297,20 @@ int main(int, char **)
   r = viennacl::reorder(matrix2, viennacl::gibbs_poole_stockmeyer_tag());
   std::cout << " * Reordered bandwidth: " << calc_reordered_bw(matrix2, r) << std::endl;
 
+  /**
+  * The reordering algorithms are also available for a viennacl::compressed_matrix.
+  * They operate directly on the CSR arrays and run in parallel if OpenMP is enabled.
+  * The resulting permutation is applied to the matrix with viennacl::linalg::permute():
+  **/
+  std::cout << "-- Reverse Cuthill-McKee algorithm on compressed_matrix --" << std::endl;
+  viennacl::compressed_matrix<double> A;
+  viennacl::copy(matrix2, A);
+  std::vector<unsigned int> r_csr = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  viennacl::compressed_matrix<double> A_reordered;
+  viennacl::linalg::permute(A_reordered, A, r_csr);
+  r.assign(r_csr.begin(), r_csr.end());
+  std::cout << " * Reordered bandwidth: " << calc_reordered_bw(matrix2, r) << std::endl;
+
   /**
   *  That's it.
   **/
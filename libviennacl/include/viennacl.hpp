@@ -93,6 +93,23 @@ typedef enum
   ViennaCLDouble
 } ViennaCLPrecision;
 
+typedef enum
+{
+  ViennaCLInvalidSolver,  // for catching uninitialized and invalid values
+  ViennaCLCG,
+  ViennaCLBiCGStab,
+  ViennaCLGMRES
+} ViennaCLSolverType;
+
+typedef enum
+{
+  ViennaCLInvalidPreconditioner,  // for catching uninitialized and invalid values
+  ViennaCLJacobi,
+  ViennaCLILU0,
+  ViennaCLILUT,
+  ViennaCLAMG
+} ViennaCLPreconditionerType;
+
 // Error codes:
 typedef enum
 {
@@ -125,6 +142,10 @@ typedef ViennaCLVector_impl*        ViennaCLVector;
 struct ViennaCLMatrix_impl;
 typedef ViennaCLMatrix_impl*        ViennaCLMatrix;
 
+/** @brief Opaque handle for a preconditioner, so that the setup cost is amortized over several solver calls */
+struct ViennaCLPreconditioner_impl;
+typedef ViennaCLPreconditioner_impl*  ViennaCLPreconditioner;
+
 
 /******************** BLAS Level 1 ***********************/
 
@@ -609,6 +630,184 @@ VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemm(ViennaCLBackend back
 
 VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLtrsm(ViennaCLMatrix A, ViennaCLUplo uplo, ViennaCLDiag diag, ViennaCLMatrix B);
 
+
+/******************** Batched operations on many small dense matrices ***********************/
+
+// All matrices of a batch share sizes, layout, and leading dimensions (BLAS conventions).
+// 'Batched' functions take an array of pointers to the individual matrices, 'StridedBatched' functions take a single buffer
+// in which the i-th matrix starts at entry i * stride.
+
+// xGEMM: C_i <- alpha * op(A_i) * op(B_i) + beta * C_i
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemmBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                   ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **B, ViennaCLInt ldb,
+                                                                   float beta,  float **C, ViennaCLInt ldc,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemmBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                   ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **B, ViennaCLInt ldb,
+                                                                   double beta,  double **C, ViennaCLInt ldc,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemmStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                          ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          float beta,  float *C, ViennaCLInt ldc, ViennaCLInt strideC,
+                                                                          ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemmStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                          ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          double beta,  double *C, ViennaCLInt ldc, ViennaCLInt strideC,
+                                                                          ViennaCLInt batch_count);
+
+// xGEMV: y_i <- alpha * op(A_i) * x_i + beta * y_i, where A_i is m x n
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemvBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                   ViennaCLInt m, ViennaCLInt n,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **x, ViennaCLInt incx,
+                                                                   float beta,  float **y, ViennaCLInt incy,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemvBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                   ViennaCLInt m, ViennaCLInt n,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **x, ViennaCLInt incx,
+                                                                   double beta,  double **y, ViennaCLInt incy,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemvStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                          ViennaCLInt m, ViennaCLInt n,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *x, ViennaCLInt incx, ViennaCLInt stridex,
+                                                                          float beta,  float *y, ViennaCLInt incy, ViennaCLInt stridey,
+                                                                          ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemvStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                          ViennaCLInt m, ViennaCLInt n,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *x, ViennaCLInt incx, ViennaCLInt stridex,
+                                                                          double beta,  double *y, ViennaCLInt incy, ViennaCLInt stridey,
+                                                                          ViennaCLInt batch_count);
+
+// xTRSM: Solves op(A_i) X_i = alpha * B_i for triangular m x m matrices A_i. B_i is m x nrhs and overwritten with X_i. 'uplo' refers to A_i.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrsmBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                   ViennaCLInt m, ViennaCLInt nrhs,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **B, ViennaCLInt ldb,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrsmBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                   ViennaCLInt m, ViennaCLInt nrhs,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **B, ViennaCLInt ldb,
+                                                                   ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrsmStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                          ViennaCLInt m, ViennaCLInt nrhs,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrsmStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                          ViennaCLInt m, ViennaCLInt nrhs,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          ViennaCLInt batch_count);
+
+// xGETRF: LU factorization with partial pivoting P_i A_i = L_i U_i of n x n matrices. 'ipiv' holds n zero-based row interchanges per matrix, stored consecutively.
+// 'num_singular' (may be NULL) returns the number of matrices with an exactly zero pivot.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrfBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n,
+                                                                    float **A, ViennaCLInt lda, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                    ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrfBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n,
+                                                                    double **A, ViennaCLInt lda, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                    ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrfStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n,
+                                                                           float *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                           ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrfStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n,
+                                                                           double *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                           ViennaCLInt batch_count);
+
+// xGETRS: Solves A_i X_i = B_i using the factors and row interchanges computed by xGETRF. B_i is n x nrhs and overwritten with X_i.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrsBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                    float **A, ViennaCLInt lda, ViennaCLInt *ipiv, float **B, ViennaCLInt ldb,
+                                                                    ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrsBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                    double **A, ViennaCLInt lda, ViennaCLInt *ipiv, double **B, ViennaCLInt ldb,
+                                                                    ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrsStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                           float *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv,
+                                                                           float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                           ViennaCLInt batch_count);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrsStridedBatched(ViennaCLBackend backend, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                           double *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv,
+                                                                           double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                           ViennaCLInt batch_count);
+
+
+/******************** Sparse matrices and iterative solvers ***********************/
+
+// Sparse matrices are passed in CSR format: 'row_ptr' holds m+1 zero-based offsets into 'col_idx' and 'values', which hold 'nnz' entries each.
+// The arrays are used in place (no copy), but only for the duration of the respective call.
+// All data resides in host memory: A ViennaCLGenericFailure is returned if 'backend' is set up for CUDA or OpenCL. 'backend' may be NULL.
+// As in BLAS, y (respectively C) is not read if beta is zero.
+
+// xCSRMV: y <- alpha * Ax + beta * y
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrmv(ViennaCLBackend backend,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt nnz,
+                                                             float alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                             float *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                             float beta,
+                                                             float *y, ViennaCLInt offy, ViennaCLInt incy);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrmv(ViennaCLBackend backend,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt nnz,
+                                                             double alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                             double *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                             double beta,
+                                                             double *y, ViennaCLInt offy, ViennaCLInt incy);
+
+// xCSRMM: C <- alpha * AB + beta * C, where A is sparse (m x k), B is dense (k x n), and C is dense (m x n)
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrmm(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt k, ViennaCLInt nnz,
+                                                             float alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                             float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             float beta,
+                                                             float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrmm(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt k, ViennaCLInt nnz,
+                                                             double alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                             double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             double beta,
+                                                             double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc);
+
+// Preconditioners: Set up once for an n x n CSR matrix, then pass to any number of solver calls. Default parameters of the respective preconditioner tags are used.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrPreconditionerCreate(ViennaCLBackend backend, ViennaCLPreconditioner *precond, ViennaCLPreconditionerType type,
+                                                                               ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrPreconditionerCreate(ViennaCLBackend backend, ViennaCLPreconditioner *precond, ViennaCLPreconditionerType type,
+                                                                               ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values);
+// Destroys the preconditioner and sets *precond to NULL. Does nothing if precond or *precond is NULL.
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLPreconditionerDestroy(ViennaCLPreconditioner *precond);
+
+// xCSRSOLVE: Iterative solution of Ax = b. On input, x holds the initial guess.
+// 'precond' may be NULL. 'krylov_dim' is only used by GMRES (values below 1 select the default). 'iterations' and 'error' may be NULL.
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrsolve(ViennaCLBackend backend, ViennaCLSolverType solver,
+                                                                ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                                float *b, ViennaCLInt offb, ViennaCLInt incb,
+                                                                float *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                                ViennaCLPreconditioner precond,
+                                                                double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                                                ViennaCLInt *iterations, double *error);
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrsolve(ViennaCLBackend backend, ViennaCLSolverType solver,
+                                                                ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                                double *b, ViennaCLInt offb, ViennaCLInt incb,
+                                                                double *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                                ViennaCLPreconditioner precond,
+                                                                double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                                                ViennaCLInt *iterations, double *error);
+
 #ifdef __cplusplus
 }
 #endif
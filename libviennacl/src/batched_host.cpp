@@ -0,0 +1,329 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "viennacl_private.hpp"
+
+#include "viennacl/linalg/host_based/batched_operations.hpp"
+
+
+namespace detail
+{
+  // the batched kernels operate on the raw arrays directly, no ViennaCL objects are created per matrix:
+  using viennacl::linalg::host_based::strided_batch;
+  using viennacl::linalg::host_based::pointer_array_batch;
+
+  inline bool batched_check_sizes(ViennaCLOrder order, ViennaCLInt m, ViennaCLInt n, ViennaCLInt batch_count)
+  {
+    return (order == ViennaCLRowMajor || order == ViennaCLColumnMajor) && m >= 0 && n >= 0 && batch_count >= 0;
+  }
+
+  template <typename NumericT, typename BatchAT, typename BatchBT, typename BatchCT>
+  ViennaCLStatus ViennaCLHostgemmBatched_impl(ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                              ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                              NumericT alpha, BatchAT const & A, ViennaCLInt lda, BatchBT const & B, ViennaCLInt ldb,
+                                              NumericT beta,  BatchCT const & C, ViennaCLInt ldc,
+                                              ViennaCLInt batch_count)
+  {
+    if (!batched_check_sizes(order, m, n, batch_count) || k < 0)
+      return ViennaCLGenericFailure;
+
+    viennacl::linalg::host_based::batched_gemm(viennacl::vcl_size_t(batch_count), order == ViennaCLRowMajor, transA == ViennaCLTrans, transB == ViennaCLTrans,
+                                               viennacl::vcl_size_t(m), viennacl::vcl_size_t(n), viennacl::vcl_size_t(k),
+                                               alpha, A, viennacl::vcl_size_t(lda), B, viennacl::vcl_size_t(ldb),
+                                               beta,  C, viennacl::vcl_size_t(ldc));
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT, typename BatchAT, typename BatchXT, typename BatchYT>
+  ViennaCLStatus ViennaCLHostgemvBatched_impl(ViennaCLOrder order, ViennaCLTranspose transA,
+                                              ViennaCLInt m, ViennaCLInt n,
+                                              NumericT alpha, BatchAT const & A, ViennaCLInt lda, BatchXT const & x, ViennaCLInt incx,
+                                              NumericT beta,  BatchYT const & y, ViennaCLInt incy,
+                                              ViennaCLInt batch_count)
+  {
+    if (!batched_check_sizes(order, m, n, batch_count))
+      return ViennaCLGenericFailure;
+
+    viennacl::linalg::host_based::batched_gemv(viennacl::vcl_size_t(batch_count), order == ViennaCLRowMajor, transA == ViennaCLTrans,
+                                               viennacl::vcl_size_t(m), viennacl::vcl_size_t(n),
+                                               alpha, A, viennacl::vcl_size_t(lda), x, viennacl::vcl_size_t(incx),
+                                               beta,  y, viennacl::vcl_size_t(incy));
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT, typename BatchAT, typename BatchBT>
+  ViennaCLStatus ViennaCLHosttrsmBatched_impl(ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                              ViennaCLInt m, ViennaCLInt nrhs,
+                                              NumericT alpha, BatchAT const & A, ViennaCLInt lda, BatchBT const & B, ViennaCLInt ldb,
+                                              ViennaCLInt batch_count)
+  {
+    if (!batched_check_sizes(order, m, nrhs, batch_count) || (uplo != ViennaCLLower && uplo != ViennaCLUpper))
+      return ViennaCLGenericFailure;
+
+    viennacl::linalg::host_based::batched_trsm(viennacl::vcl_size_t(batch_count), order == ViennaCLRowMajor,
+                                               uplo == ViennaCLLower, diag == ViennaCLUnit, transA == ViennaCLTrans,
+                                               viennacl::vcl_size_t(m), viennacl::vcl_size_t(nrhs),
+                                               alpha, A, viennacl::vcl_size_t(lda), B, viennacl::vcl_size_t(ldb));
+    return ViennaCLSuccess;
+  }
+
+  template <typename BatchAT>
+  ViennaCLStatus ViennaCLHostgetrfBatched_impl(ViennaCLOrder order, ViennaCLInt n,
+                                               BatchAT const & A, ViennaCLInt lda, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                               ViennaCLInt batch_count)
+  {
+    if (!batched_check_sizes(order, n, n, batch_count))
+      return ViennaCLGenericFailure;
+
+    viennacl::vcl_size_t singular = viennacl::linalg::host_based::batched_lu_factorize(viennacl::vcl_size_t(batch_count), order == ViennaCLRowMajor, viennacl::vcl_size_t(n),
+                                                                                       A, viennacl::vcl_size_t(lda),
+                                                                                       strided_batch<ViennaCLInt *>(ipiv, viennacl::vcl_size_t(n)));
+    if (num_singular)
+      *num_singular = static_cast<ViennaCLInt>(singular);
+    return ViennaCLSuccess;
+  }
+
+  template <typename BatchAT, typename BatchBT>
+  ViennaCLStatus ViennaCLHostgetrsBatched_impl(ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                               BatchAT const & A, ViennaCLInt lda, ViennaCLInt *ipiv, BatchBT const & B, ViennaCLInt ldb,
+                                               ViennaCLInt batch_count)
+  {
+    if (!batched_check_sizes(order, n, nrhs, batch_count))
+      return ViennaCLGenericFailure;
+
+    viennacl::linalg::host_based::batched_lu_substitute(viennacl::vcl_size_t(batch_count), order == ViennaCLRowMajor, viennacl::vcl_size_t(n), viennacl::vcl_size_t(nrhs),
+                                                        A, viennacl::vcl_size_t(lda),
+                                                        strided_batch<ViennaCLInt const *>(ipiv, viennacl::vcl_size_t(n)),
+                                                        B, viennacl::vcl_size_t(ldb));
+    return ViennaCLSuccess;
+  }
+}
+
+
+// xGEMM
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemmBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                   ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **B, ViennaCLInt ldb,
+                                                                   float beta,  float **C, ViennaCLInt ldc,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemmBatched_impl<float>(order, transA, transB, m, n, k,
+                                                     alpha, detail::pointer_array_batch<float *>(A), lda, detail::pointer_array_batch<float *>(B), ldb,
+                                                     beta,  detail::pointer_array_batch<float *>(C), ldc, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemmBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                   ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **B, ViennaCLInt ldb,
+                                                                   double beta,  double **C, ViennaCLInt ldc,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemmBatched_impl<double>(order, transA, transB, m, n, k,
+                                                      alpha, detail::pointer_array_batch<double *>(A), lda, detail::pointer_array_batch<double *>(B), ldb,
+                                                      beta,  detail::pointer_array_batch<double *>(C), ldc, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemmStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                          ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          float beta,  float *C, ViennaCLInt ldc, ViennaCLInt strideC,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemmBatched_impl<float>(order, transA, transB, m, n, k,
+                                                     alpha, detail::strided_batch<float *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                            detail::strided_batch<float *>(B, viennacl::vcl_size_t(strideB)), ldb,
+                                                     beta,  detail::strided_batch<float *>(C, viennacl::vcl_size_t(strideC)), ldc, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemmStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                                          ViennaCLInt m, ViennaCLInt n, ViennaCLInt k,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          double beta,  double *C, ViennaCLInt ldc, ViennaCLInt strideC,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemmBatched_impl<double>(order, transA, transB, m, n, k,
+                                                      alpha, detail::strided_batch<double *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                             detail::strided_batch<double *>(B, viennacl::vcl_size_t(strideB)), ldb,
+                                                      beta,  detail::strided_batch<double *>(C, viennacl::vcl_size_t(strideC)), ldc, batch_count);
+}
+
+
+// xGEMV
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemvBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                   ViennaCLInt m, ViennaCLInt n,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **x, ViennaCLInt incx,
+                                                                   float beta,  float **y, ViennaCLInt incy,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemvBatched_impl<float>(order, transA, m, n,
+                                                     alpha, detail::pointer_array_batch<float *>(A), lda, detail::pointer_array_batch<float *>(x), incx,
+                                                     beta,  detail::pointer_array_batch<float *>(y), incy, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemvBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                   ViennaCLInt m, ViennaCLInt n,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **x, ViennaCLInt incx,
+                                                                   double beta,  double **y, ViennaCLInt incy,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemvBatched_impl<double>(order, transA, m, n,
+                                                      alpha, detail::pointer_array_batch<double *>(A), lda, detail::pointer_array_batch<double *>(x), incx,
+                                                      beta,  detail::pointer_array_batch<double *>(y), incy, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgemvStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                          ViennaCLInt m, ViennaCLInt n,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *x, ViennaCLInt incx, ViennaCLInt stridex,
+                                                                          float beta,  float *y, ViennaCLInt incy, ViennaCLInt stridey,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemvBatched_impl<float>(order, transA, m, n,
+                                                     alpha, detail::strided_batch<float *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                            detail::strided_batch<float *>(x, viennacl::vcl_size_t(stridex)), incx,
+                                                     beta,  detail::strided_batch<float *>(y, viennacl::vcl_size_t(stridey)), incy, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgemvStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLTranspose transA,
+                                                                          ViennaCLInt m, ViennaCLInt n,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *x, ViennaCLInt incx, ViennaCLInt stridex,
+                                                                          double beta,  double *y, ViennaCLInt incy, ViennaCLInt stridey,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgemvBatched_impl<double>(order, transA, m, n,
+                                                      alpha, detail::strided_batch<double *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                             detail::strided_batch<double *>(x, viennacl::vcl_size_t(stridex)), incx,
+                                                      beta,  detail::strided_batch<double *>(y, viennacl::vcl_size_t(stridey)), incy, batch_count);
+}
+
+
+// xTRSM
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrsmBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                   ViennaCLInt m, ViennaCLInt nrhs,
+                                                                   float alpha, float **A, ViennaCLInt lda, float **B, ViennaCLInt ldb,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHosttrsmBatched_impl<float>(order, uplo, transA, diag, m, nrhs,
+                                                     alpha, detail::pointer_array_batch<float *>(A), lda, detail::pointer_array_batch<float *>(B), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrsmBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                   ViennaCLInt m, ViennaCLInt nrhs,
+                                                                   double alpha, double **A, ViennaCLInt lda, double **B, ViennaCLInt ldb,
+                                                                   ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHosttrsmBatched_impl<double>(order, uplo, transA, diag, m, nrhs,
+                                                      alpha, detail::pointer_array_batch<double *>(A), lda, detail::pointer_array_batch<double *>(B), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostStrsmStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                          ViennaCLInt m, ViennaCLInt nrhs,
+                                                                          float alpha, float *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                       float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHosttrsmBatched_impl<float>(order, uplo, transA, diag, m, nrhs,
+                                                     alpha, detail::strided_batch<float *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                            detail::strided_batch<float *>(B, viennacl::vcl_size_t(strideB)), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDtrsmStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                                          ViennaCLInt m, ViennaCLInt nrhs,
+                                                                          double alpha, double *A, ViennaCLInt lda, ViennaCLInt strideA,
+                                                                                        double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                          ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHosttrsmBatched_impl<double>(order, uplo, transA, diag, m, nrhs,
+                                                      alpha, detail::strided_batch<double *>(A, viennacl::vcl_size_t(strideA)), lda,
+                                                             detail::strided_batch<double *>(B, viennacl::vcl_size_t(strideB)), ldb, batch_count);
+}
+
+
+// xGETRF
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrfBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n,
+                                                                    float **A, ViennaCLInt lda, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                    ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrfBatched_impl(order, n, detail::pointer_array_batch<float *>(A), lda, ipiv, num_singular, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrfBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n,
+                                                                    double **A, ViennaCLInt lda, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                    ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrfBatched_impl(order, n, detail::pointer_array_batch<double *>(A), lda, ipiv, num_singular, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrfStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n,
+                                                                           float *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                           ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrfBatched_impl(order, n, detail::strided_batch<float *>(A, viennacl::vcl_size_t(strideA)), lda, ipiv, num_singular, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrfStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n,
+                                                                           double *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv, ViennaCLInt *num_singular,
+                                                                           ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrfBatched_impl(order, n, detail::strided_batch<double *>(A, viennacl::vcl_size_t(strideA)), lda, ipiv, num_singular, batch_count);
+}
+
+
+// xGETRS
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrsBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                    float **A, ViennaCLInt lda, ViennaCLInt *ipiv, float **B, ViennaCLInt ldb,
+                                                                    ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrsBatched_impl(order, n, nrhs, detail::pointer_array_batch<float *>(A), lda, ipiv, detail::pointer_array_batch<float *>(B), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrsBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                    double **A, ViennaCLInt lda, ViennaCLInt *ipiv, double **B, ViennaCLInt ldb,
+                                                                    ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrsBatched_impl(order, n, nrhs, detail::pointer_array_batch<double *>(A), lda, ipiv, detail::pointer_array_batch<double *>(B), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostSgetrsStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                           float *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv,
+                                                                           float *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                           ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrsBatched_impl(order, n, nrhs, detail::strided_batch<float *>(A, viennacl::vcl_size_t(strideA)), lda, ipiv,
+                                               detail::strided_batch<float *>(B, viennacl::vcl_size_t(strideB)), ldb, batch_count);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDgetrsStridedBatched(ViennaCLBackend /*backend*/, ViennaCLOrder order, ViennaCLInt n, ViennaCLInt nrhs,
+                                                                           double *A, ViennaCLInt lda, ViennaCLInt strideA, ViennaCLInt *ipiv,
+                                                                           double *B, ViennaCLInt ldb, ViennaCLInt strideB,
+                                                                           ViennaCLInt batch_count)
+{
+  return detail::ViennaCLHostgetrsBatched_impl(order, n, nrhs, detail::strided_batch<double *>(A, viennacl::vcl_size_t(strideA)), lda, ipiv,
+                                               detail::strided_batch<double *>(B, viennacl::vcl_size_t(strideB)), ldb, batch_count);
+}
@@ -0,0 +1,444 @@
+/* =========================================================================
+   Copyright (c) 2010-2014, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+#include <exception>
+
+#include "viennacl.hpp"
+#include "viennacl_private.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/amg.hpp"
+
+
+namespace detail
+{
+  /** @brief Type-erased preconditioner, so that a single solver instantiation serves all preconditioner types. */
+  template <typename NumericT>
+  class csr_preconditioner_base
+  {
+  public:
+    virtual ~csr_preconditioner_base() {}
+    virtual void apply(viennacl::vector<NumericT> & vec) const = 0;
+  };
+
+  template <typename NumericT, typename PreconditionerT>
+  class csr_preconditioner : public csr_preconditioner_base<NumericT>
+  {
+  public:
+    template <typename TagT>
+    csr_preconditioner(viennacl::compressed_matrix<NumericT> const & A, TagT const & tag) : precond_(A, tag) {}
+
+    PreconditionerT & get() { return precond_; }
+
+    void apply(viennacl::vector<NumericT> & vec) const { precond_.apply(vec); }
+
+  private:
+    PreconditionerT precond_;
+  };
+
+
+  /** @brief The CSR entry points operate on host memory. Returns false if the backend is set up for a device (CUDA or OpenCL) */
+  inline bool csr_host_backend(ViennaCLBackend backend)
+  {
+    return !backend || (backend->backend_type != ViennaCLCUDA && backend->backend_type != ViennaCLOpenCL);
+  }
+
+
+  //
+  // xCSRMV
+  //
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostcsrmv_impl(ViennaCLInt m, ViennaCLInt n, ViennaCLInt nnz,
+                                        NumericT alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, NumericT *values,
+                                        NumericT *x, ViennaCLInt offx, ViennaCLInt incx,
+                                        NumericT beta,
+                                        NumericT *y, ViennaCLInt offy, ViennaCLInt incy)
+  {
+    typedef typename viennacl::vector_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::vector_base<NumericT>::size_type           difference_type;
+
+    // wrap the caller-owned CSR arrays without copying the data. ViennaCLInt and unsigned int share the bit representation of valid indices:
+    viennacl::compressed_matrix<NumericT> A(reinterpret_cast<unsigned int *>(row_ptr), reinterpret_cast<unsigned int *>(col_idx), values, viennacl::MAIN_MEMORY,
+                                            static_cast<viennacl::vcl_size_t>(m), static_cast<viennacl::vcl_size_t>(n), static_cast<viennacl::vcl_size_t>(nnz));
+    viennacl::vector_base<NumericT> v1(x, viennacl::MAIN_MEMORY, size_type(n), size_type(offx), difference_type(incx));
+    viennacl::vector_base<NumericT> v2(y, viennacl::MAIN_MEMORY, size_type(m), size_type(offy), difference_type(incy));
+
+    viennacl::linalg::prod_impl(A, v1, alpha, v2, beta);
+
+    return ViennaCLSuccess;
+  }
+
+
+  //
+  // xCSRMM
+  //
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostcsrmm_impl(ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                        ViennaCLInt m, ViennaCLInt n, ViennaCLInt k, ViennaCLInt nnz,
+                                        NumericT alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, NumericT *values,
+                                        NumericT *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                        NumericT beta,
+                                        NumericT *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+  {
+    typedef typename viennacl::matrix_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::matrix_base<NumericT>::size_type           difference_type;
+
+    bool B_row_major = (orderB == ViennaCLRowMajor);
+    bool C_row_major = (orderC == ViennaCLRowMajor);
+
+    // zero-copy view of the CSR arrays (see ViennaCLHostcsrmv_impl):
+    viennacl::compressed_matrix<NumericT> A(reinterpret_cast<unsigned int *>(row_ptr), reinterpret_cast<unsigned int *>(col_idx), values, viennacl::MAIN_MEMORY,
+                                            static_cast<viennacl::vcl_size_t>(m), static_cast<viennacl::vcl_size_t>(k), static_cast<viennacl::vcl_size_t>(nnz));
+
+    viennacl::matrix_base<NumericT> matB(B, viennacl::MAIN_MEMORY,
+                                         size_type(k), size_type(offB_row), difference_type(incB_row), size_type(B_row_major ? k : ldb),
+                                         size_type(n), size_type(offB_col), difference_type(incB_col), size_type(B_row_major ? ldb : n), B_row_major);
+
+    viennacl::matrix_base<NumericT> matC(C, viennacl::MAIN_MEMORY,
+                                         size_type(m), size_type(offC_row), difference_type(incC_row), size_type(C_row_major ? m : ldc),
+                                         size_type(n), size_type(offC_col), difference_type(incC_col), size_type(C_row_major ? ldc : n), C_row_major);
+
+    if (alpha <= NumericT(1) && alpha >= NumericT(1) && beta <= NumericT(0) && beta >= NumericT(0))
+      viennacl::linalg::prod_impl(A, matB, matC);
+    else
+    {
+      viennacl::matrix_base<NumericT> temp(size_type(m), size_type(n), C_row_major, viennacl::context(viennacl::MAIN_MEMORY)); // same layout as C for the update below
+      viennacl::linalg::prod_impl(A, matB, temp);
+      if (beta <= NumericT(0) && beta >= NumericT(0)) // C is not read for beta == 0 (BLAS semantics), so Inf/NaN in uninitialized C do not propagate
+        matC = alpha * temp;
+      else
+      {
+        matC *= beta;
+        matC += alpha * temp;
+      }
+    }
+
+    return ViennaCLSuccess;
+  }
+
+
+  //
+  // Preconditioner setup
+  //
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostcsrPreconditionerCreate_impl(ViennaCLBackend backend, ViennaCLPreconditioner *precond, ViennaCLPreconditionerType type, ViennaCLPrecision precision,
+                                                          ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, NumericT *values)
+  {
+    typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+    if (!precond || !csr_host_backend(backend))
+      return ViennaCLGenericFailure;
+
+    // zero-copy view of the CSR arrays, the preconditioner holds its own data:
+    viennacl::compressed_matrix<NumericT> A(reinterpret_cast<unsigned int *>(row_ptr), reinterpret_cast<unsigned int *>(col_idx), values, viennacl::MAIN_MEMORY,
+                                            static_cast<viennacl::vcl_size_t>(n), static_cast<viennacl::vcl_size_t>(n), static_cast<viennacl::vcl_size_t>(nnz));
+    csr_preconditioner_base<NumericT> *p = NULL;
+
+    try
+    {
+      switch (type)
+      {
+      case ViennaCLJacobi:
+        p = new csr_preconditioner<NumericT, viennacl::linalg::jacobi_precond<MatrixType> >(A, viennacl::linalg::jacobi_tag());
+        break;
+      case ViennaCLILU0:
+        p = new csr_preconditioner<NumericT, viennacl::linalg::ilu0_precond<MatrixType> >(A, viennacl::linalg::ilu0_tag());
+        break;
+      case ViennaCLILUT:
+        p = new csr_preconditioner<NumericT, viennacl::linalg::ilut_precond<MatrixType> >(A, viennacl::linalg::ilut_tag());
+        break;
+      case ViennaCLAMG:
+      {
+        csr_preconditioner<NumericT, viennacl::linalg::amg_precond<MatrixType> > *amg = new csr_preconditioner<NumericT, viennacl::linalg::amg_precond<MatrixType> >(A, viennacl::linalg::amg_tag());
+        p = amg;
+        amg->get().setup();
+        break;
+      }
+      default:
+        break;
+      }
+    }
+    catch (std::exception const &)
+    {
+      delete p;
+      p = NULL;
+    }
+
+
+    if (!p)
+      return ViennaCLGenericFailure;
+
+    *precond = new ViennaCLPreconditioner_impl();
+    (*precond)->backend   = backend;
+    (*precond)->precision = precision;
+    (*precond)->type      = type;
+    (*precond)->size      = n;
+    (*precond)->precond   = p;
+
+    return ViennaCLSuccess;
+  }
+
+
+  //
+  // xCSRSOLVE
+  //
+  template <typename NumericT, typename PreconditionerT>
+  ViennaCLStatus csr_solve_dispatch(ViennaCLSolverType solver,
+                                    viennacl::compressed_matrix<NumericT> const & A,
+                                    viennacl::vector<NumericT> const & rhs,
+                                    viennacl::vector<NumericT> & result,
+                                    PreconditionerT const & precond,
+                                    double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                    ViennaCLInt *iterations, double *error)
+  {
+    unsigned int iters = 0;
+    double err = 0;
+
+    switch (solver)
+    {
+    case ViennaCLCG:
+    {
+      viennacl::linalg::cg_tag tag(tolerance, static_cast<unsigned int>(max_iterations));
+      result = viennacl::linalg::solve(A, rhs, tag, precond);
+      iters = tag.iters();
+      err   = tag.error();
+      break;
+    }
+    case ViennaCLBiCGStab:
+    {
+      viennacl::linalg::bicgstab_tag tag(tolerance, static_cast<unsigned int>(max_iterations));
+      result = viennacl::linalg::solve(A, rhs, tag, precond);
+      iters = tag.iters();
+      err   = tag.error();
+      break;
+    }
+    case ViennaCLGMRES:
+    {
+      viennacl::linalg::gmres_tag tag(tolerance, static_cast<unsigned int>(max_iterations));
+      if (krylov_dim > 0)
+        tag = viennacl::linalg::gmres_tag(tolerance, static_cast<unsigned int>(max_iterations), static_cast<unsigned int>(krylov_dim));
+      result = viennacl::linalg::solve(A, rhs, tag, precond);
+      iters = tag.iters();
+      err   = tag.error();
+      break;
+    }
+    default:
+      return ViennaCLGenericFailure;
+    }
+
+    if (iterations)
+      *iterations = static_cast<ViennaCLInt>(iters);
+    if (error)
+      *error = err;
+
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus ViennaCLHostcsrsolve_impl(ViennaCLSolverType solver, ViennaCLPrecision precision,
+                                           ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, NumericT *values,
+                                           NumericT *b, ViennaCLInt offb, ViennaCLInt incb,
+                                           NumericT *x, ViennaCLInt offx, ViennaCLInt incx,
+                                           ViennaCLPreconditioner precond,
+                                           double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                           ViennaCLInt *iterations, double *error)
+  {
+    typedef typename viennacl::vector_base<NumericT>::size_type           size_type;
+    typedef typename viennacl::vector_base<NumericT>::size_type           difference_type;
+
+    if (precond && (precond->precision != precision || precond->size != n))
+      return ViennaCLGenericFailure;
+
+    // zero-copy views:
+    viennacl::compressed_matrix<NumericT> A(reinterpret_cast<unsigned int *>(row_ptr), reinterpret_cast<unsigned int *>(col_idx), values, viennacl::MAIN_MEMORY,
+                                            static_cast<viennacl::vcl_size_t>(n), static_cast<viennacl::vcl_size_t>(n), static_cast<viennacl::vcl_size_t>(nnz));
+    viennacl::vector_base<NumericT> v_b(b, viennacl::MAIN_MEMORY, size_type(n), size_type(offb), difference_type(incb));
+    viennacl::vector_base<NumericT> v_x(x, viennacl::MAIN_MEMORY, size_type(n), size_type(offx), difference_type(incx));
+
+    ViennaCLStatus status = ViennaCLGenericFailure;
+    try
+    {
+      // solve for the correction to the initial guess: A y = b - A x
+      viennacl::vector<NumericT> rhs(size_type(n), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::vector<NumericT> result(size_type(n), viennacl::context(viennacl::MAIN_MEMORY));
+      viennacl::linalg::prod_impl(A, v_x, NumericT(-1), rhs, NumericT(0));
+      rhs += v_b;
+
+      if (precond)
+        status = csr_solve_dispatch(solver, A, rhs, result, *static_cast<csr_preconditioner_base<NumericT> *>(precond->precond),
+                                    tolerance, max_iterations, krylov_dim, iterations, error);
+      else
+        status = csr_solve_dispatch(solver, A, rhs, result, viennacl::linalg::no_precond(),
+                                    tolerance, max_iterations, krylov_dim, iterations, error);
+
+      if (status == ViennaCLSuccess)
+        v_x += result;
+    }
+    catch (std::exception const &)
+    {
+      status = ViennaCLGenericFailure;
+    }
+
+    return status;
+  }
+}
+
+
+// xCSRMV
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrmv(ViennaCLBackend backend,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt nnz,
+                                                             float alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                             float *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                             float beta,
+                                                             float *y, ViennaCLInt offy, ViennaCLInt incy)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrmv_impl<float>(m, n, nnz, alpha, row_ptr, col_idx, values, x, offx, incx, beta, y, offy, incy);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrmv(ViennaCLBackend backend,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt nnz,
+                                                             double alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                             double *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                             double beta,
+                                                             double *y, ViennaCLInt offy, ViennaCLInt incy)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrmv_impl<double>(m, n, nnz, alpha, row_ptr, col_idx, values, x, offx, incx, beta, y, offy, incy);
+}
+
+
+// xCSRMM
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrmm(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt k, ViennaCLInt nnz,
+                                                             float alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                             float *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             float beta,
+                                                             float *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrmm_impl<float>(orderB, orderC, m, n, k, nnz, alpha, row_ptr, col_idx, values,
+                                               B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                               beta,
+                                               C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrmm(ViennaCLBackend backend,
+                                                             ViennaCLOrder orderB, ViennaCLOrder orderC,
+                                                             ViennaCLInt m, ViennaCLInt n, ViennaCLInt k, ViennaCLInt nnz,
+                                                             double alpha, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                             double *B, ViennaCLInt offB_row, ViennaCLInt offB_col, ViennaCLInt incB_row, ViennaCLInt incB_col, ViennaCLInt ldb,
+                                                             double beta,
+                                                             double *C, ViennaCLInt offC_row, ViennaCLInt offC_col, ViennaCLInt incC_row, ViennaCLInt incC_col, ViennaCLInt ldc)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrmm_impl<double>(orderB, orderC, m, n, k, nnz, alpha, row_ptr, col_idx, values,
+                                                B, offB_row, offB_col, incB_row, incB_col, ldb,
+                                                beta,
+                                                C, offC_row, offC_col, incC_row, incC_col, ldc);
+}
+
+
+// Preconditioners
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrPreconditionerCreate(ViennaCLBackend backend, ViennaCLPreconditioner *precond, ViennaCLPreconditionerType type,
+                                                                               ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values)
+{
+  return detail::ViennaCLHostcsrPreconditionerCreate_impl<float>(backend, precond, type, ViennaCLFloat, n, nnz, row_ptr, col_idx, values);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrPreconditionerCreate(ViennaCLBackend backend, ViennaCLPreconditioner *precond, ViennaCLPreconditionerType type,
+                                                                               ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values)
+{
+  return detail::ViennaCLHostcsrPreconditionerCreate_impl<double>(backend, precond, type, ViennaCLDouble, n, nnz, row_ptr, col_idx, values);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLPreconditionerDestroy(ViennaCLPreconditioner *precond)
+{
+  if (!precond || !*precond)
+    return ViennaCLSuccess;
+
+  if ((*precond)->precision == ViennaCLFloat)
+    delete static_cast<detail::csr_preconditioner_base<float> *>((*precond)->precond);
+  else if ((*precond)->precision == ViennaCLDouble)
+    delete static_cast<detail::csr_preconditioner_base<double> *>((*precond)->precond);
+
+  delete *precond;
+  *precond = NULL;
+
+  return ViennaCLSuccess;
+}
+
+
+// xCSRSOLVE
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostScsrsolve(ViennaCLBackend backend, ViennaCLSolverType solver,
+                                                                ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, float *values,
+                                                                float *b, ViennaCLInt offb, ViennaCLInt incb,
+                                                                float *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                                ViennaCLPreconditioner precond,
+                                                                double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                                                ViennaCLInt *iterations, double *error)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrsolve_impl<float>(solver, ViennaCLFloat, n, nnz, row_ptr, col_idx, values,
+                                                  b, offb, incb, x, offx, incx,
+                                                  precond, tolerance, max_iterations, krylov_dim, iterations, error);
+}
+
+VIENNACL_EXPORTED_FUNCTION ViennaCLStatus ViennaCLHostDcsrsolve(ViennaCLBackend backend, ViennaCLSolverType solver,
+                                                                ViennaCLInt n, ViennaCLInt nnz, ViennaCLInt *row_ptr, ViennaCLInt *col_idx, double *values,
+                                                                double *b, ViennaCLInt offb, ViennaCLInt incb,
+                                                                double *x, ViennaCLInt offx, ViennaCLInt incx,
+                                                                ViennaCLPreconditioner precond,
+                                                                double tolerance, ViennaCLInt max_iterations, ViennaCLInt krylov_dim,
+                                                                ViennaCLInt *iterations, double *error)
+{
+  if (!detail::csr_host_backend(backend))
+    return ViennaCLGenericFailure;
+
+  return detail::ViennaCLHostcsrsolve_impl<double>(solver, ViennaCLDouble, n, nnz, row_ptr, col_idx, values,
+                                                   b, offb, incb, x, offx, incx,
+                                                   precond, tolerance, max_iterations, krylov_dim, iterations, error);
+}
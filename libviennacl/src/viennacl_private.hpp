@@ -138,4 +138,15 @@ struct ViennaCLMatrix_impl
 };
 
 
+struct ViennaCLPreconditioner_impl
+{
+  ViennaCLBackend             backend;
+  ViennaCLPrecision           precision;
+  ViennaCLPreconditionerType  type;
+  ViennaCLInt                 size;
+
+  void * precond;  // detail::csr_preconditioner_base<float or double>, see sparse_host.cpp
+};
+
+
 #endif
@@ -0,0 +1,165 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/auto_sparse_matrix.cpp  Tests the sparse format analyzer and the automatic format selection.
+*   \test Tests the sparse format analyzer and the automatic format selection.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/auto_sparse_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/tools/sparse_format_analyzer.hpp"
+
+#include "check.hpp"
+
+namespace vt = viennacl::tools;
+
+double diff(viennacl::vector<double> const & x, viennacl::vector<double> const & y)
+{
+  viennacl::vector<double> d = x - y;
+  return viennacl::linalg::norm_2(d) / viennacl::linalg::norm_2(y);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+  //
+  // Statistics of a 2d Laplace matrix
+  //
+  std::size_t n = 40;
+  std::vector< std::map<unsigned int, double> > laplace;
+  vt::sparse_matrix_adapter<double> adapted_laplace(laplace);
+  vt::generate_fdm_laplace(adapted_laplace, n, n);
+
+  vt::sparse_matrix_statistics stats = vt::analyze_sparse_matrix(laplace, 0, 4);
+  check(stats.rows == n * n && stats.cols == n * n && stats.nnz == 5 * n * n - 4 * n, "size of laplace matrix");
+  check(stats.min_row_length == 3 && stats.max_row_length == 5 && stats.empty_rows == 0, "row lengths of laplace matrix");
+  check(stats.bandwidth == n, "bandwidth of laplace matrix");
+  check(stats.ell_padding() < 1.1 && stats.partition_imbalance < 1.05, "padding and load balance of laplace matrix");
+
+  viennacl::compressed_matrix<double> A_csr(ctx);
+  viennacl::copy(laplace, A_csr);
+  vt::sparse_matrix_statistics stats_csr = vt::analyze_sparse_matrix(A_csr, 4);
+  check(stats_csr.nnz == stats.nnz && stats_csr.bandwidth == stats.bandwidth && stats_csr.sliced_ell_entries == stats.sliced_ell_entries, "statistics of compressed_matrix");
+
+  //
+  // Laplace matrix with an additional dense row: ELL padding is prohibitive
+  //
+  std::vector< std::map<unsigned int, double> > skewed = laplace;
+  for (unsigned int j = 0; j < n * n; ++j)
+    skewed[0][j] = 0.001;
+  vt::sparse_matrix_statistics stats_skewed = vt::analyze_sparse_matrix(skewed);
+  check(stats_skewed.max_row_length == n * n && stats_skewed.hyb_ell_width == 5 && stats_skewed.hyb_csr_nnz == n * n - 5, "HYB split of skewed matrix");
+  check(stats_skewed.ell_padding() > 100, "ELL padding of skewed matrix");
+
+  vt::sparse_performance_model host_model(viennacl::MAIN_MEMORY);
+  vt::sparse_performance_model device_model(viennacl::OPENCL_MEMORY);
+  check(host_model.predict_spmv_time(stats_skewed, vt::SPARSE_FORMAT_ELL, sizeof(double)) > 10 * host_model.predict_spmv_time(stats_skewed, vt::SPARSE_FORMAT_CSR, sizeof(double)), "ELL prediction for skewed matrix");
+  check(host_model.best_format(stats_skewed, sizeof(double)) != vt::SPARSE_FORMAT_ELL, "host format for skewed matrix");
+  check(device_model.best_format(stats_skewed, sizeof(double)) == vt::SPARSE_FORMAT_HYB, "device format for skewed matrix");
+  check(device_model.best_format(stats, sizeof(double)) == vt::SPARSE_FORMAT_ELL, "device format for laplace matrix");
+
+  //
+  // Matrix with mostly empty rows: compressed_compressed_matrix avoids the row overhead
+  //
+  std::vector< std::map<unsigned int, double> > sparse_rows(100000);
+  for (unsigned int i = 0; i < sparse_rows.size(); i += 100)
+    sparse_rows[i][i] = 1.0;
+  vt::sparse_matrix_statistics stats_sparse_rows = vt::analyze_sparse_matrix(sparse_rows);
+  check(stats_sparse_rows.empty_rows == 99000, "empty rows");
+  check(host_model.matrix_bytes(stats_sparse_rows, vt::SPARSE_FORMAT_COMPRESSED_CSR, sizeof(double)) < 0.2 * host_model.matrix_bytes(stats_sparse_rows, vt::SPARSE_FORMAT_CSR, sizeof(double)), "compressed CSR storage");
+
+  //
+  // Matrix-vector products in all formats
+  //
+  viennacl::vector<double> x = viennacl::scalar_vector<double>(skewed.size(), 1.0, ctx);
+  for (std::size_t i = 0; i < x.size(); ++i)
+    x[i] = 1.0 + double(i % 7);
+  viennacl::compressed_matrix<double> B_csr(ctx);
+  viennacl::copy(skewed, B_csr);
+  viennacl::vector<double> y_ref = viennacl::linalg::prod(B_csr, x);
+  viennacl::vector<double> z_ref = 2.0 * y_ref;
+
+  for (int i = 0; i < vt::SPARSE_FORMAT_COUNT; ++i)
+  {
+    vt::sparse_format f = static_cast<vt::sparse_format>(i);
+    viennacl::auto_sparse_matrix<double> B(ctx);
+    B.set(skewed, f);
+    check(B.format() == f && B.size1() == skewed.size() && B.nnz() == B_csr.nnz(), std::string("setup of ") + vt::sparse_format_name(f));
+
+    viennacl::vector<double> y = viennacl::linalg::prod(B, x);
+    check(diff(y, y_ref) < 1e-12, std::string("prod with ") + vt::sparse_format_name(f));
+
+    y += viennacl::linalg::prod(B, x);
+    check(diff(y, z_ref) < 1e-12, std::string("inplace_add of prod with ") + vt::sparse_format_name(f));
+
+    y -= viennacl::linalg::prod(B, viennacl::vector<double>(2.0 * x));
+    check(viennacl::linalg::norm_2(y) < 1e-12 * viennacl::linalg::norm_2(y_ref), std::string("inplace_sub of prod with ") + vt::sparse_format_name(f));
+  }
+
+  //
+  // Automatic selection, model-based and by trial runs
+  //
+  viennacl::auto_sparse_matrix<double> B_model(ctx);
+  viennacl::copy(B_csr, B_model);
+  check(B_model.format() == B_model.model().best_format(B_model.statistics(), sizeof(double)), "model-based selection");
+  check(B_model.measured_time(B_model.format()) < 0, "no trial runs");
+
+  viennacl::auto_sparse_matrix<double> B_trial(ctx, 3);
+  B_trial.model().calibrate(ctx, 1 << 18);
+  check(B_trial.model().bandwidth() > 0 && B_trial.model().serial_bandwidth() > 0, "bandwidth calibration");
+  viennacl::copy(skewed, B_trial);
+  check(B_trial.measured_time(B_trial.format()) > 0, "trial run of selected format");
+  for (int i = 0; i < vt::SPARSE_FORMAT_COUNT; ++i)
+  {
+    double t = B_trial.measured_time(static_cast<vt::sparse_format>(i));
+    check(t < 0 || t >= B_trial.measured_time(B_trial.format()), std::string("selected format is fastest, compared to ") + vt::sparse_format_name(static_cast<vt::sparse_format>(i)));
+  }
+  viennacl::vector<double> y_trial = viennacl::linalg::prod(B_trial, x);
+  check(diff(y_trial, y_ref) < 1e-12, "prod after trial selection");
+
+  //
+  // Use in iterative solvers
+  //
+  viennacl::auto_sparse_matrix<double> A(ctx);
+  viennacl::copy(laplace, A);
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(laplace.size(), 1.0, ctx);
+  viennacl::vector<double> result     = viennacl::linalg::solve(A,     rhs, viennacl::linalg::cg_tag(1e-10, 500));
+  viennacl::vector<double> result_ref = viennacl::linalg::solve(A_csr, rhs, viennacl::linalg::cg_tag(1e-10, 500));
+  check(diff(result, result_ref) < 1e-8, "CG with auto_sparse_matrix");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/bandwidth_reduction.cpp  Tests the bandwidth reduction algorithms operating on compressed_matrix and the symmetric permutation of a compressed_matrix.
+*   \test Tests the bandwidth reduction algorithms operating on compressed_matrix and the symmetric permutation of a compressed_matrix.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/misc/bandwidth_reduction.hpp"
+
+#include "check.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+// 5-point stencil on a nx-by-ny grid, nodes numbered starting at 'offset'
+void add_grid(std::vector< std::map<unsigned int, double> > & A, unsigned int offset, unsigned int nx, unsigned int ny)
+{
+  for (unsigned int i = 0; i < nx; ++i)
+    for (unsigned int j = 0; j < ny; ++j)
+    {
+      unsigned int row = offset + i * ny + j;
+      A[row][row] = 4.0;
+      if (i > 0)      A[row][row - ny] = -1.0;
+      if (i < nx - 1) A[row][row + ny] = -1.0;
+      if (j > 0)      A[row][row - 1]  = -1.0;
+      if (j < ny - 1) A[row][row + 1]  = -1.0;
+    }
+}
+
+template<typename IndexT>
+bool is_permutation(std::vector<IndexT> const & r)
+{
+  std::vector<bool> found(r.size(), false);
+  for (std::size_t i = 0; i < r.size(); ++i)
+  {
+    if (std::size_t(r[i]) >= r.size() || found[std::size_t(r[i])])
+      return false;
+    found[std::size_t(r[i])] = true;
+  }
+  return true;
+}
+
+template<typename IndexT>
+std::size_t bandwidth(std::vector< std::map<unsigned int, double> > const & A, std::vector<IndexT> const & r)
+{
+  std::size_t bw = 0;
+  for (std::size_t i = 0; i < A.size(); ++i)
+    for (std::map<unsigned int, double>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+    {
+      std::size_t row = std::size_t(r[i]), col = std::size_t(r[it->first]);
+      bw = std::max(bw, (row > col) ? row - col : col - row);
+    }
+  return bw;
+}
+
+std::size_t bandwidth(viennacl::compressed_matrix<double> const & A)
+{
+  unsigned int const * row_buffer = vhb::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = vhb::detail::extract_raw_pointer<unsigned int>(A.handle2());
+  std::size_t bw = 0;
+  for (std::size_t i = 0; i < A.size1(); ++i)
+    for (unsigned int j = row_buffer[i]; j < row_buffer[i+1]; ++j)
+      bw = std::max(bw, (i > col_buffer[j]) ? i - col_buffer[j] : col_buffer[j] - i);
+  return bw;
+}
+
+void test_permute(viennacl::compressed_matrix<double> const & A, std::vector<unsigned int> const & r, std::size_t bw, std::string const & name)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<double> B(ctx);
+  viennacl::linalg::permute(B, A, r);
+  check(B.nnz() == A.nnz() && bandwidth(B) == bw, "bandwidth of permuted matrix, " + name);
+
+  std::vector<double> std_x(A.size1()), std_x_perm(A.size1());
+  for (std::size_t i = 0; i < std_x.size(); ++i)
+  {
+    std_x[i] = 1.0 + double(i % 17);
+    std_x_perm[r[i]] = std_x[i];
+  }
+  viennacl::vector<double> x(A.size1(), ctx), x_perm(A.size1(), ctx);
+  viennacl::copy(std_x, x);
+  viennacl::copy(std_x_perm, x_perm);
+
+  viennacl::vector<double> y      = viennacl::linalg::prod(A, x);
+  viennacl::vector<double> y_perm = viennacl::linalg::prod(B, x_perm);
+  bool ok = true;
+  for (std::size_t i = 0; i < A.size1(); ++i)
+    ok = ok && std::fabs(y[i] - y_perm[r[i]]) <= 1e-12 * std::fabs(y[i]);
+  check(ok, "product with permuted matrix, " + name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  //
+  // Two grids, an isolated node, all nodes shuffled:
+  //
+  unsigned int nx = 40, ny = 25;
+  std::size_t N = nx * ny + 10 * 10 + 1;
+  std::vector< std::map<unsigned int, double> > std_grid(N);
+  add_grid(std_grid, 0, nx, ny);
+  add_grid(std_grid, nx * ny, 10, 10);
+  std_grid[N - 1][static_cast<unsigned int>(N - 1)] = 1.0;
+
+  std::vector<unsigned int> shuffle(N);
+  for (std::size_t i = 0; i < N; ++i)
+    shuffle[i] = static_cast<unsigned int>((i * 7919) % N); // N and 7919 are coprime
+  std::vector< std::map<unsigned int, double> > std_A(N);
+  for (std::size_t i = 0; i < N; ++i)
+    for (std::map<unsigned int, double>::const_iterator it = std_grid[i].begin(); it != std_grid[i].end(); ++it)
+      std_A[shuffle[i]][shuffle[it->first]] = it->second;
+
+  viennacl::compressed_matrix<double> A(viennacl::context(viennacl::MAIN_MEMORY));
+  viennacl::copy(std_A, A);
+
+  std::vector<unsigned int> identity(N);
+  for (std::size_t i = 0; i < N; ++i)
+    identity[i] = static_cast<unsigned int>(i);
+  std::size_t bw_initial = bandwidth(std_A, identity);
+  std::cout << " * Initial bandwidth: " << bw_initial << std::endl;
+
+  // reference: map-based Cuthill-McKee
+  std::vector<unsigned int> r_ref = viennacl::reorder(std_A, viennacl::cuthill_mckee_tag());
+  std::size_t bw_ref = bandwidth(std_A, r_ref);
+  std::cout << " * Bandwidth with Cuthill-McKee on std::vector<std::map<> >: " << bw_ref << std::endl;
+
+  //
+  // Cuthill-McKee, reverse Cuthill-McKee, and Gibbs-Poole-Stockmeyer for compressed_matrix
+  //
+  std::vector<unsigned int> r_cm = viennacl::reorder(A, viennacl::cuthill_mckee_tag());
+  std::size_t bw_cm = bandwidth(std_A, r_cm);
+  std::cout << " * Bandwidth with Cuthill-McKee on compressed_matrix: " << bw_cm << std::endl;
+  check(is_permutation(r_cm) && bw_cm <= std::size_t(ny) + 1 && bw_cm <= bw_ref, "Cuthill-McKee on compressed_matrix");
+
+  std::vector<unsigned int> r_rcm = viennacl::reorder(A, viennacl::reverse_cuthill_mckee_tag());
+  bool reversed = true;
+  for (std::size_t i = 0; i < N; ++i)
+    reversed = reversed && (r_rcm[i] == N - 1 - r_cm[i]);
+  check(reversed && bandwidth(std_A, r_rcm) == bw_cm, "reverse Cuthill-McKee on compressed_matrix");
+
+  std::vector<unsigned int> r_rcm_map = viennacl::reorder(std_A, viennacl::reverse_cuthill_mckee_tag());
+  check(is_permutation(r_rcm_map) && bandwidth(std_A, r_rcm_map) == bw_ref, "reverse Cuthill-McKee on std::vector<std::map<> >");
+
+  std::vector<unsigned int> r_gps = viennacl::reorder(A, viennacl::gibbs_poole_stockmeyer_tag());
+  std::size_t bw_gps = bandwidth(std_A, r_gps);
+  std::cout << " * Bandwidth with Gibbs-Poole-Stockmeyer on compressed_matrix: " << bw_gps << std::endl;
+  check(is_permutation(r_gps) && bw_gps <= std::size_t(ny) + 1, "Gibbs-Poole-Stockmeyer on compressed_matrix");
+
+  //
+  // The numbering does not depend on the number of threads
+  //
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  int thread_counts[3] = {1, 3, 8};
+  for (std::size_t t = 0; t < 3; ++t)
+  {
+    vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, thread_counts[t]);
+    check(viennacl::reorder(A, viennacl::cuthill_mckee_tag()) == r_cm
+       && viennacl::reorder(A, viennacl::gibbs_poole_stockmeyer_tag()) == r_gps, "independent of number of threads");
+  }
+
+  //
+  // Symmetric permutation of the matrix
+  //
+  test_permute(A, r_cm, bw_cm,   "Cuthill-McKee");
+  test_permute(A, r_gps, bw_gps, "Gibbs-Poole-Stockmeyer");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,424 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/blas3_batched.cpp   Tests the batched BLAS-like operations on many small matrices
+*   \test  Tests the batched BLAS-like operations on many small matrices
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+#include "viennacl/tools/random.hpp"
+
+
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Reference access to entry (i,j) of op(A) for a matrix in BLAS storage */
+template<typename NumericT>
+NumericT & entry(std::vector<NumericT> & data, std::size_t offset, std::size_t ld, bool row_major, bool trans, std::size_t i, std::size_t j)
+{
+  if (trans)
+    std::swap(i, j);
+  return row_major ? data[offset + i * ld + j] : data[offset + i + j * ld];
+}
+
+template<typename NumericT>
+NumericT max_rel_diff(std::vector<NumericT> const & v1, viennacl::vector<NumericT> const & v2)
+{
+  std::vector<NumericT> v2_cpu(v2.size());
+  viennacl::copy(v2, v2_cpu);
+
+  NumericT ret = 0;
+  for (std::size_t i=0; i<v1.size(); ++i)
+    if (std::max(std::fabs(v1[i]), std::fabs(v2_cpu[i])) > 0)
+      ret = std::max(ret, std::fabs(v1[i] - v2_cpu[i]) / std::max(std::fabs(v1[i]), std::fabs(v2_cpu[i])));
+  return ret;
+}
+
+template<typename NumericT>
+void fill_random(std::vector<NumericT> & v, viennacl::tools::uniform_random_numbers<NumericT> & randomNumber)
+{
+  for (std::size_t i=0; i<v.size(); ++i)
+    v[i] = randomNumber();
+}
+
+template<typename NumericT>
+int test_gemm(std::size_t batch_count, std::size_t m, std::size_t n, std::size_t k, bool row_major, bool trans_A, bool trans_B,
+              NumericT epsilon, viennacl::tools::uniform_random_numbers<NumericT> & randomNumber)
+{
+  // padded leading dimensions and strides
+  std::size_t lda = (row_major != trans_A) ? k + 1 : m + 2;
+  std::size_t ldb = (row_major != trans_B) ? n + 2 : k + 1;
+  std::size_t ldc = row_major ? n + 1 : m + 1;
+  std::size_t stride_A = lda * std::max(m, k) + 3;
+  std::size_t stride_B = ldb * std::max(k, n) + 1;
+  std::size_t stride_C = ldc * std::max(m, n);
+
+  std::vector<NumericT> A(batch_count * stride_A), B(batch_count * stride_B), C(batch_count * stride_C);
+  fill_random(A, randomNumber);
+  fill_random(B, randomNumber);
+  fill_random(C, randomNumber);
+
+  viennacl::vector<NumericT> vcl_A(A.size()), vcl_B(B.size()), vcl_C(C.size());
+  viennacl::copy(A, vcl_A);
+  viennacl::copy(B, vcl_B);
+  viennacl::copy(C, vcl_C);
+
+  NumericT alpha = NumericT(1.5);
+  NumericT beta  = NumericT(-0.5);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<n; ++j)
+      {
+        NumericT value = 0;
+        for (std::size_t l=0; l<k; ++l)
+          value += entry(A, b * stride_A, lda, row_major, trans_A, i, l) * entry(B, b * stride_B, ldb, row_major, trans_B, l, j);
+        NumericT & c = entry(C, b * stride_C, ldc, row_major, false, i, j);
+        c = alpha * value + beta * c;
+      }
+
+  viennacl::linalg::batched_gemm(batch_count, row_major, trans_A, trans_B, m, n, k,
+                                 alpha, vcl_A, lda, stride_A,
+                                        vcl_B, ldb, stride_B,
+                                 beta,  vcl_C, ldc, stride_C);
+  if (max_rel_diff(C, vcl_C) > epsilon)
+  {
+    std::cout << "# Error at operation: batched_gemm (strided) with m = " << m << ", n = " << n << ", k = " << k
+              << ", row_major = " << row_major << ", trans_A = " << trans_A << ", trans_B = " << trans_B << std::endl;
+    std::cout << "  diff: " << max_rel_diff(C, vcl_C) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // pointer arrays, processing the batch in reverse order. beta = 0 overwrites C:
+  std::vector<NumericT const *> ptr_A(batch_count), ptr_B(batch_count);
+  std::vector<NumericT *> ptr_C(batch_count);
+  std::vector<NumericT> C2(C.size(), NumericT(42));
+  for (std::size_t b=0; b<batch_count; ++b)
+  {
+    ptr_A[b] = &A[(batch_count - b - 1) * stride_A];
+    ptr_B[b] = &B[(batch_count - b - 1) * stride_B];
+    ptr_C[b] = &C2[(batch_count - b - 1) * stride_C];
+  }
+  viennacl::linalg::batched_gemm(batch_count, row_major, trans_A, trans_B, m, n, k,
+                                 NumericT(1), &ptr_A[0], lda, &ptr_B[0], ldb,
+                                 NumericT(0), &ptr_C[0], ldc);
+
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<n; ++j)
+      {
+        NumericT value = 0;
+        for (std::size_t l=0; l<k; ++l)
+          value += entry(A, b * stride_A, lda, row_major, trans_A, i, l) * entry(B, b * stride_B, ldb, row_major, trans_B, l, j);
+        NumericT computed = entry(C2, b * stride_C, ldc, row_major, false, i, j);
+        if (std::fabs(computed - value) > epsilon * std::max(NumericT(1), std::fabs(value)))
+        {
+          std::cout << "# Error at operation: batched_gemm (pointer array) with m = " << m << ", n = " << n << ", k = " << k << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_gemv(std::size_t batch_count, std::size_t m, std::size_t n, bool row_major, bool trans_A,
+              NumericT epsilon, viennacl::tools::uniform_random_numbers<NumericT> & randomNumber)
+{
+  std::size_t lda = row_major ? n + 1 : m + 1;
+  std::size_t stride_A = lda * std::max(m, n);
+  std::size_t size_x = trans_A ? m : n;
+  std::size_t size_y = trans_A ? n : m;
+  std::size_t stride_x = 2 * size_x + 1;
+  std::size_t stride_y = 3 * size_y;
+
+  std::vector<NumericT> A(batch_count * stride_A), x(batch_count * stride_x), y(batch_count * stride_y);
+  fill_random(A, randomNumber);
+  fill_random(x, randomNumber);
+  fill_random(y, randomNumber);
+
+  viennacl::vector<NumericT> vcl_A(A.size()), vcl_x(x.size()), vcl_y(y.size());
+  viennacl::copy(A, vcl_A);
+  viennacl::copy(x, vcl_x);
+  viennacl::copy(y, vcl_y);
+
+  NumericT alpha = NumericT(2);
+  NumericT beta  = NumericT(0.5);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<size_y; ++i)
+    {
+      NumericT value = 0;
+      for (std::size_t j=0; j<size_x; ++j)
+        value += entry(A, b * stride_A, lda, row_major, trans_A, i, j) * x[b * stride_x + 2 * j];
+      y[b * stride_y + 3 * i] = alpha * value + beta * y[b * stride_y + 3 * i];
+    }
+
+  viennacl::linalg::batched_gemv(batch_count, row_major, trans_A, m, n,
+                                 alpha, vcl_A, lda, stride_A,
+                                        vcl_x, 2, stride_x,
+                                 beta,  vcl_y, 3, stride_y);
+  if (max_rel_diff(y, vcl_y) > epsilon)
+  {
+    std::cout << "# Error at operation: batched_gemv with m = " << m << ", n = " << n << ", row_major = " << row_major << ", trans_A = " << trans_A << std::endl;
+    std::cout << "  diff: " << max_rel_diff(y, vcl_y) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT, typename SolverTagT>
+int test_trsm(std::size_t batch_count, std::size_t m, std::size_t nrhs, bool row_major, bool trans_A, SolverTagT tag,
+              NumericT epsilon, viennacl::tools::uniform_random_numbers<NumericT> & randomNumber)
+{
+  std::size_t lda = m + 1;
+  std::size_t ldb = row_major ? nrhs : m;
+  std::size_t stride_A = lda * m;
+  std::size_t stride_B = m * nrhs;
+  bool lower = viennacl::linalg::detail::batched_triangular_traits<SolverTagT>::lower;
+  bool unit  = viennacl::linalg::detail::batched_triangular_traits<SolverTagT>::unit_diagonal;
+
+  std::vector<NumericT> A(batch_count * stride_A), B(batch_count * stride_B);
+  fill_random(A, randomNumber);
+  fill_random(B, randomNumber);
+  for (std::size_t b=0; b<batch_count; ++b) // diagonally dominant for good conditioning
+    for (std::size_t i=0; i<m; ++i)
+      entry(A, b * stride_A, lda, row_major, false, i, i) += NumericT(m);
+
+  viennacl::vector<NumericT> vcl_A(A.size()), vcl_B(B.size());
+  viennacl::copy(A, vcl_A);
+  viennacl::copy(B, vcl_B);
+
+  NumericT alpha = NumericT(2);
+  viennacl::linalg::batched_trsm(batch_count, row_major, trans_A, m, nrhs, alpha, vcl_A, lda, stride_A, vcl_B, ldb, stride_B, tag);
+
+  // check op(A) X = alpha * B, only using the referenced triangle of A:
+  std::vector<NumericT> X(B.size());
+  viennacl::copy(vcl_B, X);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<nrhs; ++j)
+      {
+        NumericT value = 0;
+        for (std::size_t l=0; l<m; ++l)
+        {
+          std::size_t row = trans_A ? l : i;
+          std::size_t col = trans_A ? i : l;
+          if ((lower && col > row) || (!lower && col < row))
+            continue;
+          NumericT a = (row == col && unit) ? NumericT(1) : entry(A, b * stride_A, lda, row_major, false, row, col);
+          value += a * entry(X, b * stride_B, ldb, row_major, false, l, j);
+        }
+        NumericT rhs = alpha * entry(B, b * stride_B, ldb, row_major, false, i, j);
+        if (std::fabs(value - rhs) > epsilon * std::max(NumericT(1), std::fabs(rhs)))
+        {
+          std::cout << "# Error at operation: batched_trsm with m = " << m << ", tag = " << SolverTagT::name() << ", row_major = " << row_major << ", trans_A = " << trans_A << std::endl;
+          std::cout << "  residual: " << std::fabs(value - rhs) << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test_lu(std::size_t batch_count, std::size_t n, std::size_t nrhs, bool row_major,
+            viennacl::tools::uniform_random_numbers<NumericT> & randomNumber)
+{
+  std::size_t lda = n + 2;
+  std::size_t ldb = row_major ? nrhs : n;
+  std::size_t stride_A = lda * n;
+  std::size_t stride_B = n * nrhs;
+
+  // random matrices are generally not diagonally dominant, so pivoting is required
+  std::vector<NumericT> A(batch_count * stride_A), B(batch_count * stride_B);
+  fill_random(A, randomNumber);
+  fill_random(B, randomNumber);
+
+  // pointer arrays for the factorization, strided batch for the substitution:
+  std::vector<NumericT> LU(A);
+  std::vector<NumericT *> ptr_LU(batch_count);
+  for (std::size_t b=0; b<batch_count; ++b)
+    ptr_LU[b] = &LU[b * stride_A];
+
+  std::vector<viennacl::vcl_size_t> pivots;
+  if (viennacl::linalg::batched_lu_factorize(batch_count, row_major, n, &ptr_LU[0], lda, pivots) != 0)
+  {
+    std::cout << "# Error at operation: batched_lu_factorize reports singular matrix" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::vector<NumericT> vcl_LU(LU.size()), vcl_B(B.size());
+  viennacl::copy(LU, vcl_LU);
+  viennacl::copy(B, vcl_B);
+  viennacl::linalg::batched_lu_substitute(batch_count, row_major, n, nrhs, vcl_LU, lda, stride_A, pivots, vcl_B, ldb, stride_B);
+
+  // LU with partial pivoting is backward stable, so the residual is checked against the normwise bound n * eps * (||A|| ||x|| + ||b||) rather than
+  // an absolute tolerance, which random (possibly ill-conditioned) matrices may exceed:
+  std::vector<NumericT> X(B.size());
+  viennacl::copy(vcl_B, X);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t j=0; j<nrhs; ++j)
+    {
+      NumericT norm_A = 0, norm_x = 0, norm_b = 0;
+      for (std::size_t i=0; i<n; ++i)
+      {
+        NumericT row_sum = 0;
+        for (std::size_t l=0; l<n; ++l)
+          row_sum += std::fabs(entry(A, b * stride_A, lda, row_major, false, i, l));
+        norm_A = std::max(norm_A, row_sum);
+        norm_x = std::max(norm_x, std::fabs(entry(X, b * stride_B, ldb, row_major, false, i, j)));
+        norm_b = std::max(norm_b, std::fabs(entry(B, b * stride_B, ldb, row_major, false, i, j)));
+      }
+      NumericT tolerance = NumericT(10) * NumericT(n) * std::numeric_limits<NumericT>::epsilon() * (norm_A * norm_x + norm_b);
+
+      for (std::size_t i=0; i<n; ++i)
+      {
+        NumericT value = 0;
+        for (std::size_t l=0; l<n; ++l)
+          value += entry(A, b * stride_A, lda, row_major, false, i, l) * entry(X, b * stride_B, ldb, row_major, false, l, j);
+        NumericT rhs = entry(B, b * stride_B, ldb, row_major, false, i, j);
+        if (std::fabs(value - rhs) > tolerance)
+        {
+          std::cout << "# Error at operation: batched_lu_factorize/batched_lu_substitute with n = " << n << ", row_major = " << row_major << std::endl;
+          std::cout << "  residual: " << std::fabs(value - rhs) << ", tolerance: " << tolerance << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // a singular matrix is reported:
+  std::vector<NumericT> Z(stride_A);
+  NumericT * ptr_Z = &Z[0];
+  if (viennacl::linalg::batched_lu_factorize(1, row_major, n, &ptr_Z, lda, pivots) != 1)
+  {
+    std::cout << "# Error at operation: batched_lu_factorize does not detect singular matrix" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+template<typename NumericT>
+int test(NumericT epsilon)
+{
+  viennacl::tools::uniform_random_numbers<NumericT> randomNumber;
+
+  // sizes with compile-time kernels (2, 3, 4, 8, 16, 32, 64) and generic ones:
+  std::size_t sizes[] = {2, 3, 4, 5, 8, 16, 23, 32, 64};
+  std::size_t batch_count = 37;
+
+  for (std::size_t s=0; s<sizeof(sizes) / sizeof(std::size_t); ++s)
+  {
+    std::size_t n = sizes[s];
+    std::cout << "Testing size " << n << "..." << std::endl;
+    for (int layout = 0; layout < 2; ++layout)
+    {
+      bool row_major = (layout == 0);
+      for (int trans = 0; trans < 4; ++trans)
+      {
+        if (test_gemm(batch_count, n, n,     n,     row_major, trans % 2 == 1, trans / 2 == 1, epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+        if (test_gemm(batch_count, n, n + 1, n + 2, row_major, trans % 2 == 1, trans / 2 == 1, epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+      }
+
+      for (int trans = 0; trans < 2; ++trans)
+      {
+        if (test_gemv(batch_count, n, n,     row_major, trans == 1, epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+        if (test_gemv(batch_count, n, n + 3, row_major, trans == 1, epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+
+        if (test_trsm(batch_count, n, 3, row_major, trans == 1, viennacl::linalg::lower_tag(),      epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+        if (test_trsm(batch_count, n, 3, row_major, trans == 1, viennacl::linalg::upper_tag(),      epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+        if (test_trsm(batch_count, n, 1, row_major, trans == 1, viennacl::linalg::unit_lower_tag(), epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+        if (test_trsm(batch_count, n, 2, row_major, trans == 1, viennacl::linalg::unit_upper_tag(), epsilon, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+      }
+
+      if (test_lu(batch_count, n, 2, row_major, randomNumber) != EXIT_SUCCESS) return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Batched BLAS operations" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = NumericT(1.0E-3);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if ( retval == EXIT_SUCCESS )
+      std::cout << "# Test passed" << std::endl;
+    else
+      return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -40,7 +40,9 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/lu.hpp"
 #include "viennacl/tools/random.hpp"
 
 //
@@ -71,7 +73,7 @@ ScalarType diff(std::vector<ScalarType> & v1, viennacl::vector<ScalarType> & v2)
          v2_cpu[i] = 0.0;
    }
 
-   return norm_inf(v2_cpu);
+   return viennacl::linalg::norm_inf(v2_cpu);
 }
 
 
@@ -540,6 +542,124 @@ int test_solve(Epsilon const& epsilon)
 
 
 
+template< typename NumericT, typename F_A, typename F_B, typename Epsilon >
+int test_factorize(Epsilon const& epsilon)
+{
+  viennacl::tools::uniform_random_numbers<NumericT> randomNumber;
+
+  int retval = EXIT_SUCCESS;
+  std::size_t matrix_size = 135;  //some odd number, not too large
+  std::size_t rhs_num = 67;
+
+  std::cout << "--- Part 3: Testing dense factorizations ---" << std::endl;
+
+  // diagonally dominant matrix with rows in reverse order, hence requires pivoting:
+  std::vector<std::vector<NumericT> > A(matrix_size, std::vector<NumericT>(matrix_size));
+  std::vector<std::vector<NumericT> > S(matrix_size, std::vector<NumericT>(matrix_size));
+  std::vector<std::vector<NumericT> > B(matrix_size, std::vector<NumericT>(rhs_num));
+  std::vector<NumericT>               b(matrix_size);
+
+  for (std::size_t i = 0; i < matrix_size; ++i)
+  {
+    for (std::size_t j = 0; j < matrix_size; ++j)
+      A[matrix_size - i - 1][j] = static_cast<NumericT>(-0.5) * randomNumber();
+    A[matrix_size - i - 1][i] = NumericT(matrix_size) + randomNumber();
+  }
+
+  // symmetric positive definite matrix:
+  for (std::size_t i = 0; i < matrix_size; ++i)
+  {
+    for (std::size_t j = 0; j < i; ++j)
+      S[i][j] = S[j][i] = static_cast<NumericT>(-0.5) * randomNumber();
+    S[i][i] = NumericT(matrix_size) + randomNumber();
+  }
+
+  for (std::size_t i = 0; i < matrix_size; ++i)
+  {
+    for (std::size_t j = 0; j < rhs_num; ++j)
+      B[i][j] = NumericT(1) + randomNumber();
+    b[i] = NumericT(1) + randomNumber();
+  }
+
+  viennacl::matrix<NumericT, F_A> vcl_A(matrix_size, matrix_size);
+  viennacl::matrix<NumericT, F_A> vcl_LU(matrix_size, matrix_size);
+  viennacl::matrix<NumericT, F_B> vcl_B(matrix_size, rhs_num);
+  viennacl::matrix<NumericT, F_B> vcl_result(matrix_size, rhs_num);
+  viennacl::matrix<NumericT, F_B> vcl_check(matrix_size, rhs_num);
+  viennacl::vector<NumericT>      vcl_b(matrix_size);
+  viennacl::vector<NumericT>      vcl_x(matrix_size);
+  viennacl::vector<NumericT>      vcl_vec_result(matrix_size);
+
+  viennacl::copy(B, vcl_B);
+  viennacl::copy(b, vcl_b);
+
+  std::cout << " * LU with pivoting, A \\ B:  ";
+  viennacl::copy(A, vcl_A);
+  vcl_LU = vcl_A;
+  std::vector<viennacl::vcl_size_t> permutation;
+  viennacl::linalg::lu_factorize(vcl_LU, permutation);
+  vcl_result = vcl_B;
+  viennacl::linalg::lu_substitute(vcl_LU, permutation, vcl_result);
+  vcl_check = viennacl::linalg::prod(vcl_A, vcl_result);
+  run_solver_check(B, vcl_check, retval, epsilon);
+
+  std::cout << " * LU with pivoting, A \\ b:  ";
+  vcl_x = vcl_b;
+  viennacl::linalg::lu_substitute(vcl_LU, permutation, vcl_x);
+  vcl_vec_result = viennacl::linalg::prod(vcl_A, vcl_x);
+  run_solver_check(b, vcl_vec_result, retval, epsilon);
+
+  std::cout << " * LU with pivoting, singular:";
+  for (std::size_t i = 0; i < matrix_size; ++i)
+    A[i][matrix_size / 2] = 0;
+  viennacl::copy(A, vcl_LU);
+  try
+  {
+    viennacl::linalg::lu_factorize(vcl_LU, permutation);
+    std::cout << "# Error: no exception thrown for singular matrix" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  catch (viennacl::zero_on_diagonal_exception const &)
+  {
+    std::cout << " passed! " << std::endl;
+  }
+
+  std::cout << " * Cholesky, A \\ B:          ";
+  viennacl::copy(S, vcl_A);
+  vcl_LU = vcl_A;
+  viennacl::linalg::cholesky_factorize(vcl_LU);
+  vcl_result = vcl_B;
+  viennacl::linalg::cholesky_substitute(vcl_LU, vcl_result);
+  vcl_check = viennacl::linalg::prod(vcl_A, vcl_result);
+  run_solver_check(B, vcl_check, retval, epsilon);
+
+  std::cout << " * Cholesky, A \\ b:          ";
+  vcl_x = vcl_b;
+  viennacl::linalg::cholesky_substitute(vcl_LU, vcl_x);
+  vcl_vec_result = viennacl::linalg::prod(vcl_A, vcl_x);
+  run_solver_check(b, vcl_vec_result, retval, epsilon);
+
+  std::cout << " * Cholesky, L L^T == A:     ";
+  viennacl::matrix<NumericT, F_A> vcl_LLT = viennacl::linalg::prod(vcl_LU, trans(vcl_LU));
+  run_solver_check(S, vcl_LLT, retval, epsilon);
+
+  std::cout << " * Cholesky, indefinite:     ";
+  S[matrix_size / 2][matrix_size / 2] = -S[matrix_size / 2][matrix_size / 2];
+  viennacl::copy(S, vcl_LU);
+  try
+  {
+    viennacl::linalg::cholesky_factorize(vcl_LU);
+    std::cout << "# Error: no exception thrown for indefinite matrix" << std::endl;
+    retval = EXIT_FAILURE;
+  }
+  catch (viennacl::zero_on_diagonal_exception const &)
+  {
+    std::cout << " passed! " << std::endl;
+  }
+
+  return retval;
+}
+
 //
 // Control functions
 //
@@ -557,6 +677,10 @@ int test(Epsilon const& epsilon)
   if (ret != EXIT_SUCCESS)
     return ret;
 
+  ret = test_factorize<NumericT, viennacl::row_major, viennacl::row_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
 
   std::cout << "////////////////////////////////" << std::endl;
   std::cout << "/// Now testing A=row, B=col ///" << std::endl;
@@ -565,6 +689,10 @@ int test(Epsilon const& epsilon)
   if (ret != EXIT_SUCCESS)
     return ret;
 
+  ret = test_factorize<NumericT, viennacl::row_major, viennacl::column_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
   std::cout << "////////////////////////////////" << std::endl;
   std::cout << "/// Now testing A=col, B=row ///" << std::endl;
   std::cout << "////////////////////////////////" << std::endl;
@@ -572,6 +700,10 @@ int test(Epsilon const& epsilon)
   if (ret != EXIT_SUCCESS)
     return ret;
 
+  ret = test_factorize<NumericT, viennacl::column_major, viennacl::row_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
   std::cout << "////////////////////////////////" << std::endl;
   std::cout << "/// Now testing A=col, B=col ///" << std::endl;
   std::cout << "////////////////////////////////" << std::endl;
@@ -579,6 +711,10 @@ int test(Epsilon const& epsilon)
   if (ret != EXIT_SUCCESS)
     return ret;
 
+  ret = test_factorize<NumericT, viennacl::column_major, viennacl::column_major>(epsilon);
+  if (ret != EXIT_SUCCESS)
+    return ret;
+
 
 
   return ret;
@@ -0,0 +1,197 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/block_compressed_matrix.cpp  Tests the block compressed sparse row format (BSR): conversion, block size detection, products, block preconditioners and iterative solvers.
+*   \test Tests the block compressed sparse row format (BSR): conversion, block size detection, products, block preconditioners and iterative solvers.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/block_compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/ilu.hpp"
+
+#include "check.hpp"
+#include "sparse_products.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+/** @brief Assembles a system with three unknowns per node of a 2D grid, coupled by dense 3-by-3 blocks like a discretization of linear elasticity. */
+void assemble_block_system(unsigned int nx, unsigned int ny, double asymmetry, std::vector< std::map<unsigned int, double> > & A)
+{
+  A.clear();
+  A.resize(3 * nx * ny);
+  for (unsigned int i = 0; i < nx; ++i)
+    for (unsigned int j = 0; j < ny; ++j)
+    {
+      unsigned int node = i * ny + j;
+      unsigned int neighbors[4] = { i > 0 ? node - ny : node, i < nx - 1 ? node + ny : node,
+                                    j > 0 ? node - 1  : node, j < ny - 1 ? node + 1  : node };
+      for (unsigned int a = 0; a < 3; ++a)
+        for (unsigned int b = 0; b < 3; ++b)
+          A[3 * node + a][3 * node + b] = (a == b) ? 9.0 : 0.5;
+      for (unsigned int n = 0; n < 4; ++n)
+      {
+        if (neighbors[n] == node)
+          continue;
+        double scale = (neighbors[n] > node) ? 1.0 + asymmetry : 1.0 - asymmetry;
+        for (unsigned int a = 0; a < 3; ++a)
+          for (unsigned int b = 0; b < 3; ++b)
+            A[3 * node + a][3 * neighbors[n] + b] = scale * ((a == b) ? -1.0 : -0.2);
+      }
+    }
+}
+
+template<unsigned int BlockSize>
+void test_products(viennacl::compressed_matrix<double> const & A, std::vector< std::map<unsigned int, double> > const & std_A, std::string const & name)
+{
+  viennacl::block_compressed_matrix<double, BlockSize> A_block(A);
+  check(A_block.size1() == A.size1() && A_block.size2() == A.size2() && A_block.nnz() >= A.nnz(), name + ": conversion from compressed_matrix");
+
+  std::vector< std::map<unsigned int, double> > std_A_back;
+  viennacl::copy(A_block, std_A_back);
+  check(std_A_back == std_A, name + ": copy back to the host");
+
+  check_sparse_products(A_block, A, 1e-14, name);
+
+  // products with dense matrices:
+  std::size_t N = A.size1();
+  std::size_t K = 5;
+  viennacl::matrix<double> B(N, K, viennacl::traits::context(A)), C(N, K, viennacl::traits::context(A)), C_ref(N, K, viennacl::traits::context(A));
+  viennacl::matrix<double> B_trans(K, N, viennacl::traits::context(A));
+  std::vector<double> std_B(N * K);
+  for (std::size_t i = 0; i < N * K; ++i)
+    std_B[i] = double((i * 7) % 11) - 5.0;
+  viennacl::fast_copy(&(std_B[0]), &(std_B[0]) + N * K, B);
+  B_trans = viennacl::trans(B);
+
+  C_ref = viennacl::linalg::prod(A, B);
+  C = viennacl::linalg::prod(A_block, B);
+  C -= C_ref;
+  check(viennacl::linalg::norm_frobenius(C) <= 1e-14 * viennacl::linalg::norm_frobenius(C_ref), name + ": C = A * B");
+
+  C = viennacl::linalg::prod(A_block, viennacl::trans(B_trans));
+  C -= C_ref;
+  check(viennacl::linalg::norm_frobenius(C) <= 1e-14 * viennacl::linalg::norm_frobenius(C_ref), name + ": C = A * trans(B)");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+  std::vector< std::map<unsigned int, double> > std_A, std_B;
+  assemble_block_system(9, 7, 0.0, std_A);
+  assemble_block_system(9, 7, 0.3, std_B);
+
+  viennacl::compressed_matrix<double> A(ctx), B(ctx);
+  viennacl::copy(std_A, A);
+  viennacl::copy(std_B, B);
+
+  //
+  // Block size detection
+  //
+  check(viennacl::block_fill_ratio(A, 3) >= 1.0 && viennacl::block_fill_ratio(A, 2) < 1.0, "block fill ratio");
+  check(viennacl::detect_block_size(A) == 3, "detected block size is 3");
+
+  //
+  // Products, also with threads and with padding of the last block row (189 rows are not a multiple of 4)
+  //
+  test_products<3>(A, std_A, "BlockSize 3");
+  test_products<4>(B, std_B, "BlockSize 4");
+
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 3);
+  test_products<3>(B, std_B, "BlockSize 3 with threads");
+
+  viennacl::block_compressed_matrix<double, 2> B_from_host(ctx);
+  viennacl::copy(std_B, B_from_host);
+  std::vector< std::map<unsigned int, double> > std_B_back;
+  viennacl::copy(B_from_host, std_B_back);
+  check(std_B_back == std_B, "conversion from and to the host");
+
+  //
+  // Iterative solvers with block preconditioners
+  //
+  std::size_t N = A.size1();
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> result(N, ctx), result_ref(N, ctx);
+
+  viennacl::block_compressed_matrix<double, 3> A_block(A);
+  viennacl::block_compressed_matrix<double, 3> B_block(B);
+  viennacl::block_compressed_matrix<double, 4> B_block_padded(B);
+
+  viennacl::linalg::cg_tag cg_tag(1e-12, 1000);
+  result_ref = viennacl::linalg::solve(A, rhs, cg_tag);
+  unsigned int cg_iters = cg_tag.iters();
+
+  result = viennacl::linalg::solve(A_block, rhs, cg_tag);
+  check(relative_difference(result, result_ref) < 1e-8, "CG");
+
+  viennacl::linalg::jacobi_precond< viennacl::block_compressed_matrix<double, 3> > block_jacobi(A_block, viennacl::linalg::jacobi_tag());
+  result = viennacl::linalg::solve(A_block, rhs, cg_tag, block_jacobi);
+  check(relative_difference(result, result_ref) < 1e-8, "CG with block-Jacobi preconditioner");
+
+  viennacl::linalg::ilu0_precond< viennacl::block_compressed_matrix<double, 3> > block_ilu0_A(A_block, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(A_block, rhs, cg_tag, block_ilu0_A);
+  std::cout << " * CG iterations: " << cg_iters << " without preconditioner, " << cg_tag.iters() << " with block ILU0" << std::endl;
+  check(relative_difference(result, result_ref) < 1e-8 && cg_tag.iters() < cg_iters, "CG with block ILU0 preconditioner");
+
+  result_ref = viennacl::linalg::solve(B, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  result     = viennacl::linalg::solve(B_block, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab");
+
+  viennacl::linalg::ilu0_precond< viennacl::block_compressed_matrix<double, 3> > block_ilu0_B(B_block, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(B_block, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000), block_ilu0_B);
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab with block ILU0 preconditioner");
+
+  viennacl::linalg::jacobi_precond< viennacl::block_compressed_matrix<double, 4> > block_jacobi_padded(B_block_padded, viennacl::linalg::jacobi_tag());
+  result = viennacl::linalg::solve(B_block_padded, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000), block_jacobi_padded);
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab with block-Jacobi preconditioner and padding");
+
+  result = viennacl::linalg::solve(B_block, rhs, viennacl::linalg::gmres_tag(1e-12, 1000, 30));
+  check(relative_difference(result, result_ref) < 1e-8, "GMRES");
+
+  result = viennacl::linalg::solve(B_block_padded, rhs, viennacl::linalg::gmres_tag(1e-12, 1000, 10), block_jacobi_padded);
+  check(relative_difference(result, result_ref) < 1e-8, "GMRES with block-Jacobi preconditioner and padding");
+
+  viennacl::linalg::ilu0_precond< viennacl::block_compressed_matrix<double, 4> > block_ilu0_padded(B_block_padded, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(B_block_padded, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000), block_ilu0_padded);
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab with block ILU0 preconditioner and padding");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#ifndef VIENNACL_TESTS_CHECK_HPP_
+#define VIENNACL_TESTS_CHECK_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/check.hpp  Reporting shared by the tests which check a sequence of named conditions and abort at the first failure.
+**/
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+/** @brief Prints a success message for the named check, or aborts the test with an error message if the check failed */
+inline void check(bool ok, std::string const & name)
+{
+  if (!ok)
+  {
+    std::cerr << "Test failed: " << name << std::endl;
+    std::cerr << "Aborting!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "SUCCESS: " << name << std::endl;
+}
+
+#endif
@@ -0,0 +1,183 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/host_stream.cpp  Tests asynchronous host operations in streams and their futures.
+*   \test Tests asynchronous host operations in streams and their futures.
+**/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/linalg/host_based/async_operations.hpp"
+
+#include "check.hpp"
+
+namespace host_based = viennacl::linalg::host_based;
+
+/** @brief Writes the squared norm of a vector to a scalar */
+struct squared_norm_functor
+{
+  squared_norm_functor(viennacl::vector<double> const & x, viennacl::scalar<double> & s) : x_(&x), s_(&s) {}
+  void operator()() const { *s_ = viennacl::linalg::inner_prod(*x_, *x_); }
+
+  viennacl::vector<double> const * x_;
+  viennacl::scalar<double> * s_;
+};
+
+struct failing_functor
+{
+  void operator()() const { throw std::runtime_error("intentional failure"); }
+};
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<double> A(ctx);
+  viennacl::tools::generate_fdm_laplace(A, 150, 150);
+  std::size_t N = A.size1();
+
+  viennacl::vector<double> x = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> y(N, ctx);
+  viennacl::vector<double> u = viennacl::scalar_vector<double>(N, 2.0, ctx);
+  viennacl::vector<double> v = viennacl::scalar_vector<double>(N, 3.0, ctx);
+
+  viennacl::vector<double> y_ref = viennacl::linalg::prod(A, x);
+
+  // independent operations in two streams:
+  host_based::host_stream & stream_1 = host_based::get_host_stream(1);
+  host_based::host_stream & stream_2 = host_based::get_host_stream(2);
+
+  host_based::async_prod(stream_1, A, x, y);
+  host_based::host_future<double> norm_y = host_based::async_norm_2(stream_1, y);
+  host_based::host_future<double> uv     = host_based::async_inner_prod(stream_2, u, v);
+
+  check(std::fabs(uv.get() - 6.0 * double(N)) < 1e-8 * double(N), "inner product future");
+  check(std::fabs(norm_y.get() - viennacl::linalg::norm_2(y_ref)) < 1e-10, "norm of result of asynchronous product");
+
+  viennacl::backend::finish();
+  check(norm_y.ready() && uv.ready(), "futures ready after finish()");
+  viennacl::vector<double> d = y - y_ref;
+  check(viennacl::linalg::norm_2(d) <= 0, "asynchronous sparse matrix-vector product");
+
+  // reading a scalar computed earlier in the same stream:
+  viennacl::scalar<double> s(0, ctx);
+  stream_2.enqueue(squared_norm_functor(u, s));
+  host_based::host_future<double> s_value = host_based::async_read(stream_2, s);
+  check(std::fabs(s_value.get() - 4.0 * double(N)) < 1e-8 * double(N), "asynchronous read of scalar");
+
+  // operation chain:
+  host_based::operation_chain<double> chain(N);
+  chain.avbv(u, u, 1.0, v, -1.0);
+  host_based::async_execute(stream_1, chain);
+  host_based::host_future<double> norm_u = host_based::async_norm_2(stream_1, u);
+  check(std::fabs(norm_u.get() - std::sqrt(double(N))) < 1e-8, "asynchronous operation chain");
+
+  // operation chains executed concurrently by two streams and the calling thread, which share the team of host threads:
+  {
+    std::size_t repetitions = 100;
+    std::vector< viennacl::vector<double> > a, b;
+    std::vector<double> sums(3);
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      a.push_back(viennacl::scalar_vector<double>(N, 1.0, ctx));
+      b.push_back(viennacl::scalar_vector<double>(N, double(k + 1), ctx));
+    }
+
+    host_based::operation_chain<double> chain_1(N), chain_2(N), chain_3(N);
+    host_based::operation_chain<double> * chains[] = {&chain_1, &chain_2, &chain_3};
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      chains[k]->avbv(a[k], a[k], 1.0, b[k], 1.0);
+      chains[k]->inner_prod(a[k], b[k], sums[k]);
+    }
+
+    for (std::size_t i = 0; i < repetitions; ++i)
+    {
+      host_based::async_execute(stream_1, chain_1);
+      host_based::async_execute(stream_2, chain_2);
+    }
+    for (std::size_t i = 0; i < repetitions; ++i)
+      chain_3.execute();
+    stream_1.finish();
+    stream_2.finish();
+
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      double b_k = double(k + 1);
+      double a_k = 1.0 + double(repetitions) * b_k;
+      std::vector<double> host_a(N);
+      viennacl::copy(a[k], host_a);
+      double error = 0;
+      for (std::size_t i = 0; i < N; ++i)
+        error = std::max(error, std::fabs(host_a[i] - a_k));
+      check(error <= 0, "concurrent operation chains: vector update");
+      check(std::fabs(sums[k] - a_k * b_k * double(N)) < 1e-12 * a_k * b_k * double(N), "concurrent operation chains: reduction");
+    }
+  }
+
+  // errors are reported when waiting for the failed task, or by finish():
+  host_based::host_stream stream_3;
+  stream_3.enqueue(failing_functor());
+  host_based::host_future<double> unrelated = host_based::async_norm_2(stream_3, x);
+  check(std::fabs(unrelated.get() - std::sqrt(double(N))) < 1e-8, "error of another task not reported by future");
+
+  bool caught = false;
+  try
+  {
+    stream_3.finish();
+  }
+  catch (std::runtime_error const &)
+  {
+    caught = true;
+  }
+  check(caught, "error reporting by finish()");
+  stream_3.finish();
+
+  host_based::host_future<double> failed;
+  failed.attach(stream_3, stream_3.enqueue(failing_functor()));
+  caught = false;
+  try
+  {
+    failed.wait();
+  }
+  catch (std::runtime_error const &)
+  {
+    caught = true;
+  }
+  check(caught, "error reporting by future of failed task");
+  stream_3.finish();
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
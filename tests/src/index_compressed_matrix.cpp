@@ -0,0 +1,145 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/index_compressed_matrix.cpp  Tests the CSR format with compressed column indices: conversion, fallback blocks, products, and iterative solvers.
+*   \test Tests the CSR format with compressed column indices: conversion, fallback blocks, products, and iterative solvers.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/index_compressed_matrix.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+
+#include "check.hpp"
+#include "sparse_products.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+/** @brief Assembles the 5-point stencil on an nx-by-ny grid (bandwidth ny) plus a few rows coupled to the far end of the grid. B is slightly nonsymmetric. */
+void assemble(unsigned int nx, unsigned int ny, std::vector< std::map<unsigned int, double> > & std_A, std::vector< std::map<unsigned int, double> > & std_B)
+{
+  unsigned int N = nx * ny;
+  std_A.clear(); std_A.resize(N);
+  std_B.clear(); std_B.resize(N);
+  for (unsigned int i = 0; i < nx; ++i)
+    for (unsigned int j = 0; j < ny; ++j)
+    {
+      unsigned int row = i * ny + j;
+      std_A[row][row] = 4.0;
+      std_B[row][row] = 4.0;
+      if (i > 0)      { std_A[row][row - ny] = -1.0; std_B[row][row - ny] = -1.2; }
+      if (i < nx - 1) { std_A[row][row + ny] = -1.0; std_B[row][row + ny] = -0.8; }
+      if (j > 0)      { std_A[row][row - 1]  = -1.0; std_B[row][row - 1]  = -1.0; }
+      if (j < ny - 1) { std_A[row][row + 1]  = -1.0; std_B[row][row + 1]  = -1.0; }
+    }
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    unsigned int row = 37 * i, col = N - 1 - 37 * i;
+    std_A[row][col] = std_A[col][row] = -0.5;
+    std_A[row][row] += 0.5;
+    std_A[col][col] += 0.5;
+    std_B[row][col] = -0.3;
+    std_B[col][row] = -0.6;
+    std_B[row][row] += 1.0;
+    std_B[col][col] += 1.0;
+  }
+}
+
+template<typename OffsetT>
+void test_products(viennacl::compressed_matrix<double> const & A, std::vector< std::map<unsigned int, double> > const & std_A, std::string const & name)
+{
+  viennacl::index_compressed_matrix<double, OffsetT> A_icsr(A);
+  check(A_icsr.size1() == A.size1() && A_icsr.size2() == A.size2() && A_icsr.nnz() == A.nnz(), name + ": conversion from compressed_matrix");
+  std::cout << " * " << A_icsr.num_blocks() << " row blocks, " << A_icsr.fallback_nnz() << " of " << A_icsr.nnz() << " entries in fallback blocks, "
+            << A_icsr.index_bytes() << " index bytes instead of " << (A.size1() + 1 + A.nnz()) * sizeof(unsigned int) << std::endl;
+  check(A_icsr.compressed_nnz() > 0 && A_icsr.fallback_nnz() > 0 && A_icsr.fallback_nnz() < A_icsr.nnz() / 10, name + ": fallback blocks only for wide rows");
+  check(A_icsr.index_bytes() < (A.size1() + 1 + A.nnz()) * sizeof(unsigned int), name + ": fewer index bytes than compressed_matrix");
+
+  std::vector< std::map<unsigned int, double> > std_A_back;
+  viennacl::copy(A_icsr, std_A_back);
+  check(std_A_back == std_A, name + ": copy back to the host");
+
+  check_sparse_products(A_icsr, A, 1e-14, name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+  //
+  // Products with 16-bit offsets (requires more than 65536 unknowns for fallback blocks) and 8-bit offsets, also with threads
+  //
+  std::vector< std::map<unsigned int, double> > std_A, std_B;
+  viennacl::compressed_matrix<double> A(ctx), B(ctx);
+  assemble(300, 240, std_A, std_B);
+  viennacl::copy(std_A, A);
+  viennacl::copy(std_B, B);
+
+  test_products<unsigned short>(A, std_A, "16-bit offsets");
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 3);
+  test_products<unsigned short>(B, std_B, "16-bit offsets with threads");
+
+  assemble(100, 80, std_A, std_B);
+  viennacl::compressed_matrix<double> A_small(ctx), B_small(ctx);
+  viennacl::copy(std_A, A_small);
+  viennacl::copy(std_B, B_small);
+
+  test_products<unsigned char>(B_small, std_B, "8-bit offsets with threads");
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 1);
+  test_products<unsigned char>(A_small, std_A, "8-bit offsets");
+
+  viennacl::index_compressed_matrix<double, unsigned char> B_from_host(ctx);
+  viennacl::copy(std_B, B_from_host);
+  std::vector< std::map<unsigned int, double> > std_B_back;
+  viennacl::copy(B_from_host, std_B_back);
+  check(std_B_back == std_B, "conversion from and to the host");
+
+  //
+  // Iterative solvers
+  //
+  std::size_t N = A_small.size1();
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> result(N, ctx), result_ref(N, ctx);
+
+  viennacl::index_compressed_matrix<double> A_icsr(A_small);
+  result_ref = viennacl::linalg::solve(A_small, rhs, viennacl::linalg::cg_tag(1e-12, 1000));
+  result     = viennacl::linalg::solve(A_icsr, rhs, viennacl::linalg::cg_tag(1e-12, 1000));
+  check(relative_difference(result, result_ref) < 1e-8, "CG");
+
+  viennacl::index_compressed_matrix<double, unsigned char> B_icsr(B_small);
+  result_ref = viennacl::linalg::solve(B_small, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  result     = viennacl::linalg::solve(B_icsr, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,280 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** \file tests/src/iterative.cpp  Tests the iterative solvers.
+*   \test Tests the iterative solvers.
+**/
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/mixed_precision_refinement.hpp"
+
+
+/** @brief Sets up the upwind finite difference discretization of the convection-diffusion operator -Laplace(u) + b * grad(u) on a (points x points) grid. Nonsymmetric. */
+template<typename NumericT>
+void fill_convection_diffusion(std::vector< std::map<unsigned int, NumericT> > & A, unsigned int points, NumericT convection)
+{
+  A.clear();
+  A.resize(points * points);
+  for (unsigned int i=0; i<points; ++i)
+    for (unsigned int j=0; j<points; ++j)
+    {
+      unsigned int row = i * points + j;
+      A[row][row] = NumericT(4) + NumericT(2) * convection;
+      if (i > 0)
+        A[row][row - points] = NumericT(-1) - convection;
+      if (i < points - 1)
+        A[row][row + points] = NumericT(-1);
+      if (j > 0)
+        A[row][row - 1] = NumericT(-1) - convection;
+      if (j < points - 1)
+        A[row][row + 1] = NumericT(-1);
+    }
+}
+
+template<typename MatrixT, typename VectorT>
+typename viennacl::result_of::cpu_value_type<typename VectorT::value_type>::type
+relative_residual(MatrixT const & A, VectorT const & x, VectorT const & b)
+{
+  VectorT r = viennacl::linalg::prod(A, x);
+  r = b - r;
+  return viennacl::linalg::norm_2(r) / viennacl::linalg::norm_2(b);
+}
+
+template<typename NumericT>
+bool check(std::string const & name, NumericT residual, NumericT tolerance, unsigned int iterations)
+{
+  bool ok = (residual < tolerance);
+  std::cout << (ok ? "[[OK]] " : "[FAIL] ") << name << ": relative residual " << residual << " after " << iterations << " iterations" << std::endl;
+  return ok;
+}
+
+
+/** @brief A preconditioner which varies from one application to the next: a few iterations of an inner GMRES. Requires the flexible GMRES. */
+template<typename MatrixT>
+class inner_gmres_precond
+{
+public:
+  inner_gmres_precond(MatrixT const & A) : A_(A) {}
+
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    viennacl::linalg::gmres_tag inner_tag(1e-2, 5, 5);
+    VectorT tmp = viennacl::linalg::solve(A_, vec, inner_tag);
+    vec = tmp;
+  }
+
+private:
+  MatrixT const & A_;
+};
+
+
+template<typename NumericT>
+int test_gmres(NumericT tolerance)
+{
+  unsigned int points = 24;
+  std::vector< std::map<unsigned int, NumericT> > std_A;
+  fill_convection_diffusion(std_A, points, NumericT(0.5));
+
+  viennacl::compressed_matrix<NumericT> A;
+  viennacl::copy(std_A, A);
+
+  std::vector< std::vector<NumericT> > std_A_dense(std_A.size(), std::vector<NumericT>(std_A.size()));
+  for (std::size_t i=0; i<std_A.size(); ++i)
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = std_A[i].begin(); it != std_A[i].end(); ++it)
+      std_A_dense[i][it->first] = it->second;
+  viennacl::matrix<NumericT> A_dense(A.size1(), A.size2());
+  viennacl::copy(std_A_dense, A_dense);
+
+  std::vector<NumericT> std_b(A.size1());
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = NumericT(1) + NumericT(i % 7) / NumericT(7);
+  viennacl::vector<NumericT> b(A.size1());
+  viennacl::copy(std_b, b);
+
+  viennacl::vector<NumericT> x(A.size1());
+
+  unsigned int s_values[] = {2, 4, 5, 8};
+  for (std::size_t i=0; i<sizeof(s_values) / sizeof(unsigned int); ++i)
+  {
+    viennacl::linalg::gmres_tag tag(NumericT(0.1) * tolerance, 500, 30);
+    tag.s_step(s_values[i]);
+
+    x = viennacl::linalg::solve(A, b, tag);
+    std::cout << "s = " << s_values[i] << ": ";
+    if (!check("s-step GMRES, sparse", relative_residual(A, x, b), tolerance, tag.iters()))
+      return EXIT_FAILURE;
+
+    x = viennacl::linalg::solve(A_dense, b, tag);
+    std::cout << "s = " << s_values[i] << ": ";
+    if (!check("s-step GMRES, dense", relative_residual(A, x, b), tolerance, tag.iters()))
+      return EXIT_FAILURE;
+
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > ilu0(A, viennacl::linalg::ilu0_tag());
+    x = viennacl::linalg::solve(A, b, tag, ilu0);
+    std::cout << "s = " << s_values[i] << ": ";
+    if (!check("s-step GMRES, ILU0", relative_residual(A, x, b), tolerance, tag.iters()))
+      return EXIT_FAILURE;
+  }
+
+  //
+  // GMRES with deflated restarting and flexible GMRES at a small Krylov dimension
+  //
+  unsigned int deflation_values[] = {0, 2, 4};
+  for (std::size_t i=0; i<sizeof(deflation_values) / sizeof(unsigned int); ++i)
+  {
+    viennacl::linalg::gmres_tag tag(NumericT(0.1) * tolerance, 1000, 10);
+    tag.deflation_dim(deflation_values[i]);
+    tag.flexible(true);
+
+    x = viennacl::linalg::solve(A, b, tag);
+    std::cout << "k = " << deflation_values[i] << ": ";
+    if (!check("FGMRES-DR, sparse", relative_residual(A, x, b), tolerance, tag.iters()))
+      return EXIT_FAILURE;
+
+    inner_gmres_precond< viennacl::compressed_matrix<NumericT> > inner_gmres(A);
+    x = viennacl::linalg::solve(A, b, tag, inner_gmres);
+    std::cout << "k = " << deflation_values[i] << ": ";
+    if (!check("FGMRES-DR, inner GMRES", relative_residual(A, x, b), tolerance, tag.iters()))
+      return EXIT_FAILURE;
+
+    if (deflation_values[i] > 0)
+    {
+      tag.flexible(false);
+      x = viennacl::linalg::solve(A_dense, b, tag);
+      std::cout << "k = " << deflation_values[i] << ": ";
+      if (!check("GMRES-DR, dense", relative_residual(A, x, b), tolerance, tag.iters()))
+        return EXIT_FAILURE;
+
+      viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > ilu0(A, viennacl::linalg::ilu0_tag());
+      x = viennacl::linalg::solve(A, b, tag, ilu0);
+      std::cout << "k = " << deflation_values[i] << ": ";
+      if (!check("GMRES-DR, ILU0", relative_residual(A, x, b), tolerance, tag.iters()))
+        return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+int test_mixed_precision_refinement()
+{
+  unsigned int points = 32;
+  std::vector< std::map<unsigned int, double> > std_A;
+  fill_convection_diffusion(std_A, points, 0.5);
+
+  viennacl::compressed_matrix<double> A;
+  viennacl::copy(std_A, A);
+  viennacl::compressed_matrix<float> A_low(A);
+
+  std::vector<double> std_b(A.size1());
+  for (std::size_t i=0; i<std_b.size(); ++i)
+    std_b[i] = 1.0 + double(i % 7) / 7.0;
+  viennacl::vector<double> b(A.size1());
+  viennacl::copy(std_b, b);
+
+  viennacl::vector<double> x(A.size1());
+  double tolerance = 1e-10;
+
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<float> > ilu0(A_low, viennacl::linalg::ilu0_tag());
+
+  viennacl::linalg::mixed_precision_refinement_tag<viennacl::linalg::gmres_tag> gmres_tag(viennacl::linalg::gmres_tag(1e-3, 300, 30), 0.1 * tolerance);
+  x = viennacl::linalg::solve(A, b, gmres_tag, A_low, ilu0);
+  std::cout << gmres_tag.refinements() << " refinements: ";
+  if (!check("Mixed precision GMRES, ILU0", relative_residual(A, x, b), tolerance, gmres_tag.iters()) || gmres_tag.fallback_used())
+    return EXIT_FAILURE;
+
+  viennacl::linalg::mixed_precision_refinement_tag<viennacl::linalg::bicgstab_tag> bicgstab_tag(viennacl::linalg::bicgstab_tag(1e-3, 300), 0.1 * tolerance);
+  x = viennacl::linalg::solve(A, b, bicgstab_tag);
+  std::cout << bicgstab_tag.refinements() << " refinements: ";
+  if (!check("Mixed precision BiCGStab", relative_residual(A, x, b), tolerance, bicgstab_tag.iters()))
+    return EXIT_FAILURE;
+
+  // a stall ratio which cannot be met in single precision enforces the fallback to the double precision matrix:
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<float> > jacobi(A_low, viennacl::linalg::jacobi_tag());
+  viennacl::linalg::mixed_precision_refinement_tag<viennacl::linalg::gmres_tag> fallback_tag(viennacl::linalg::gmres_tag(1e-3, 300, 30), 0.1 * tolerance, 50, 1e-12);
+  x = viennacl::linalg::solve(A, b, fallback_tag, A_low, jacobi);
+  std::cout << fallback_tag.refinements() << " refinements: ";
+  if (!check("Mixed precision GMRES with fallback, Jacobi", relative_residual(A, x, b), tolerance, fallback_tag.iters()) || !fallback_tag.fallback_used())
+    return EXIT_FAILURE;
+
+  // symmetric positive definite for CG:
+  fill_convection_diffusion(std_A, points, 0.0);
+  viennacl::copy(std_A, A);
+  viennacl::linalg::mixed_precision_refinement_tag<viennacl::linalg::cg_tag> cg_tag(viennacl::linalg::cg_tag(1e-3, 300), 0.1 * tolerance);
+  x = viennacl::linalg::solve(A, b, cg_tag);
+  std::cout << cg_tag.refinements() << " refinements: ";
+  if (!check("Mixed precision CG", relative_residual(A, x, b), tolerance, cg_tag.iters()))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Iterative Solvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test_gmres<float>(1e-3f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: double" << std::endl;
+  if (test_gmres<double>(1e-8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "# Testing mixed precision iterative refinement" << std::endl;
+  if (test_mixed_precision_refinement() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
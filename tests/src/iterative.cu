@@ -0,0 +1 @@
+iterative.cpp
\ No newline at end of file
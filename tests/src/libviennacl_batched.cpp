@@ -0,0 +1,167 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/libviennacl_batched.cpp  Testing the batched operations on small dense matrices in the ViennaCL BLAS-like shared library
+*   \test Testing the batched operations on small dense matrices in the ViennaCL BLAS-like shared library
+**/
+
+
+// include necessary system headers
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "viennacl.hpp"
+
+#include "viennacl/tools/random.hpp"
+
+#include "check.hpp"
+
+
+template<typename NumericT>
+NumericT max_diff(std::vector<NumericT> const & v1, std::vector<NumericT> const & v2)
+{
+  NumericT ret = 0;
+  for (std::size_t i=0; i<v1.size(); ++i)
+    ret = std::max(ret, std::fabs(v1[i] - v2[i]));
+  return ret;
+}
+
+/** @brief Reference C_i = alpha * A_i * B_i + beta * C_i for row-major n x n matrices */
+template<typename NumericT>
+void reference_gemm(std::size_t batch_count, std::size_t n, NumericT alpha, std::vector<NumericT> const & A, std::vector<NumericT> const & B, NumericT beta, std::vector<NumericT> & C)
+{
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      for (std::size_t j=0; j<n; ++j)
+      {
+        NumericT value = 0;
+        for (std::size_t k=0; k<n; ++k)
+          value += A[b*n*n + i*n + k] * B[b*n*n + k*n + j];
+        C[b*n*n + i*n + j] = alpha * value + beta * C[b*n*n + i*n + j];
+      }
+}
+
+int main()
+{
+  viennacl::tools::uniform_random_numbers<double> randomDouble;
+
+  ViennaCLBackend my_backend;
+  ViennaCLBackendCreate(&my_backend);
+
+  ViennaCLInt batch_count = 100;
+  std::size_t sizes[] = {3, 4, 7};
+
+  for (std::size_t s=0; s<sizeof(sizes) / sizeof(std::size_t); ++s)
+  {
+    ViennaCLInt n = ViennaCLInt(sizes[s]);
+    std::size_t matrix_size = sizes[s] * sizes[s];
+    std::cout << std::endl << "-- Testing n = " << n << "...";
+
+    std::vector<double> A(std::size_t(batch_count) * matrix_size), B(A.size()), C(A.size());
+    for (std::size_t i=0; i<A.size(); ++i)
+    {
+      A[i] = randomDouble();
+      B[i] = randomDouble();
+      C[i] = randomDouble();
+    }
+    for (std::size_t b=0; b<std::size_t(batch_count); ++b)  // diagonally dominant, hence well conditioned
+      for (std::size_t i=0; i<sizes[s]; ++i)
+        A[b * matrix_size + i * sizes[s] + i] += double(n);
+
+    std::vector<double *> ptr_A(static_cast<std::size_t>(batch_count)), ptr_B(ptr_A.size()), ptr_C(ptr_A.size());
+    std::vector<double> C_batched(C);
+    std::vector<double> A_factors(A);
+    for (std::size_t b=0; b<std::size_t(batch_count); ++b)
+    {
+      ptr_A[b] = &A_factors[b * matrix_size];
+      ptr_B[b] = &B[b * matrix_size];
+      ptr_C[b] = &C_batched[b * matrix_size];
+    }
+
+    // xGEMM:
+    std::vector<double> C_ref(C);
+    reference_gemm(std::size_t(batch_count), sizes[s], 2.0, A, B, 0.5, C_ref);
+
+    check(ViennaCLHostDgemmStridedBatched(my_backend, ViennaCLRowMajor, ViennaCLNoTrans, ViennaCLNoTrans, n, n, n,
+                                          2.0, &A[0], n, ViennaCLInt(matrix_size), &B[0], n, ViennaCLInt(matrix_size),
+                                          0.5, &C[0], n, ViennaCLInt(matrix_size), batch_count) == ViennaCLSuccess, "ViennaCLHostDgemmStridedBatched");
+    check(max_diff(C, C_ref) < 1e-12, "ViennaCLHostDgemmStridedBatched result");
+
+    // a row-major buffer read in column-major layout is the transpose, hence this computes (B_i A_i)^T in row-major layout:
+    check(ViennaCLHostDgemmBatched(my_backend, ViennaCLColumnMajor, ViennaCLTrans, ViennaCLTrans, n, n, n,
+                                   1.0, &ptr_B[0], n, &ptr_A[0], n,
+                                   0.0, &ptr_C[0], n, batch_count) == ViennaCLSuccess, "ViennaCLHostDgemmBatched");
+    std::vector<double> BA(C.size(), 0.0);
+    reference_gemm(std::size_t(batch_count), sizes[s], 1.0, B, A, 0.0, BA);
+    std::vector<double> C_batched_t(C_batched.size());
+    for (std::size_t b=0; b<std::size_t(batch_count); ++b)
+      for (std::size_t i=0; i<sizes[s]; ++i)
+        for (std::size_t j=0; j<sizes[s]; ++j)
+          C_batched_t[b * matrix_size + i * sizes[s] + j] = C_batched[b * matrix_size + j * sizes[s] + i];
+    check(max_diff(C_batched_t, BA) < 1e-12, "ViennaCLHostDgemmBatched result");
+
+    // xGEMV:
+    std::vector<double> x(std::size_t(batch_count) * sizes[s], 1.0), y(x.size(), 0.0), y_ref(x.size(), 0.0);
+    for (std::size_t b=0; b<std::size_t(batch_count); ++b)
+      for (std::size_t i=0; i<sizes[s]; ++i)
+        for (std::size_t j=0; j<sizes[s]; ++j)
+          y_ref[b * sizes[s] + i] += A[b * matrix_size + i * sizes[s] + j];
+    check(ViennaCLHostDgemvStridedBatched(my_backend, ViennaCLRowMajor, ViennaCLNoTrans, n, n,
+                                          1.0, &A[0], n, ViennaCLInt(matrix_size), &x[0], 1, n,
+                                          0.0, &y[0], 1, n, batch_count) == ViennaCLSuccess, "ViennaCLHostDgemvStridedBatched");
+    check(max_diff(y, y_ref) < 1e-12, "ViennaCLHostDgemvStridedBatched result");
+
+    // xGETRF and xGETRS: solve A_i x_i = y_i, i.e. recover x_i = (1, ..., 1)
+    std::vector<ViennaCLInt> ipiv(std::size_t(batch_count) * sizes[s]);
+    ViennaCLInt num_singular = -1;
+    check(ViennaCLHostDgetrfBatched(my_backend, ViennaCLRowMajor, n, &ptr_A[0], n, &ipiv[0], &num_singular, batch_count) == ViennaCLSuccess && num_singular == 0, "ViennaCLHostDgetrfBatched");
+    check(ViennaCLHostDgetrsStridedBatched(my_backend, ViennaCLRowMajor, n, 1, &A_factors[0], n, ViennaCLInt(matrix_size), &ipiv[0],
+                                           &y[0], 1, n, batch_count) == ViennaCLSuccess, "ViennaCLHostDgetrsStridedBatched");
+    check(max_diff(y, x) < 1e-10, "ViennaCLHostDgetrsStridedBatched result");
+
+    // xTRSM in single precision: solve with the upper triangle of A_i
+    std::vector<float> A_float(A.begin(), A.end()), B_float(B.begin(), B.end()), X_float(B_float);
+    check(ViennaCLHostStrsmStridedBatched(my_backend, ViennaCLRowMajor, ViennaCLUpper, ViennaCLNoTrans, ViennaCLNonUnit, n, n,
+                                          1.0f, &A_float[0], n, ViennaCLInt(matrix_size), &X_float[0], n, ViennaCLInt(matrix_size), batch_count) == ViennaCLSuccess, "ViennaCLHostStrsmStridedBatched");
+    float residual = 0;
+    for (std::size_t b=0; b<std::size_t(batch_count); ++b)
+      for (std::size_t i=0; i<sizes[s]; ++i)
+        for (std::size_t j=0; j<sizes[s]; ++j)
+        {
+          float value = 0;
+          for (std::size_t k=i; k<sizes[s]; ++k)
+            value += A_float[b * matrix_size + i * sizes[s] + k] * X_float[b * matrix_size + k * sizes[s] + j];
+          residual = std::max(residual, std::fabs(value - B_float[b * matrix_size + i * sizes[s] + j]));
+        }
+    check(residual < 1e-5f, "ViennaCLHostStrsmStridedBatched result");
+
+    check(ViennaCLHostStrsmStridedBatched(my_backend, ViennaCLInvalidOrder, ViennaCLUpper, ViennaCLNoTrans, ViennaCLNonUnit, n, n,
+                                          1.0f, &A_float[0], n, ViennaCLInt(matrix_size), &X_float[0], n, ViennaCLInt(matrix_size), batch_count) == ViennaCLGenericFailure, "invalid order");
+  }
+
+  ViennaCLBackendDestroy(&my_backend);
+
+  //
+  //  That's it.
+  //
+  std::cout << std::endl << "!!!! TEST COMPLETED SUCCESSFULLY !!!!" << std::endl;
+
+  return EXIT_SUCCESS;
+}
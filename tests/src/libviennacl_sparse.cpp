@@ -0,0 +1,258 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/libviennacl_sparse.cpp  Testing the sparse matrix routines and iterative solvers in the ViennaCL BLAS-like shared library
+*   \test Testing the sparse matrix routines and iterative solvers in the ViennaCL BLAS-like shared library
+**/
+
+
+// include necessary system headers
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+
+#include "viennacl.hpp"
+
+#include "check.hpp"
+
+
+/** @brief Sets up the 5-point finite difference Laplacian on a (points x points) grid in CSR format */
+void fill_laplace(std::vector<ViennaCLInt> & row_ptr, std::vector<ViennaCLInt> & col_idx, std::vector<double> & values, ViennaCLInt points)
+{
+  row_ptr.assign(1, 0);
+  col_idx.clear();
+  values.clear();
+  for (ViennaCLInt i=0; i<points; ++i)
+    for (ViennaCLInt j=0; j<points; ++j)
+    {
+      ViennaCLInt row = i * points + j;
+      if (i > 0)          { col_idx.push_back(row - points); values.push_back(-1.0); }
+      if (j > 0)          { col_idx.push_back(row - 1);      values.push_back(-1.0); }
+                            col_idx.push_back(row);          values.push_back( 4.0);
+      if (j < points - 1) { col_idx.push_back(row + 1);      values.push_back(-1.0); }
+      if (i < points - 1) { col_idx.push_back(row + points); values.push_back(-1.0); }
+      row_ptr.push_back(static_cast<ViennaCLInt>(col_idx.size()));
+    }
+}
+
+template<typename NumericT>
+void reference_spmv(std::vector<ViennaCLInt> const & row_ptr, std::vector<ViennaCLInt> const & col_idx, std::vector<NumericT> const & values,
+                    std::vector<NumericT> const & x, std::vector<NumericT> & y)
+{
+  y.resize(row_ptr.size() - 1);
+  for (std::size_t i=0; i+1<row_ptr.size(); ++i)
+  {
+    NumericT sum = 0;
+    for (ViennaCLInt k=row_ptr[i]; k<row_ptr[i+1]; ++k)
+      sum += values[std::size_t(k)] * x[std::size_t(col_idx[std::size_t(k)])];
+    y[i] = sum;
+  }
+}
+
+template<typename NumericT>
+NumericT relative_residual(std::vector<ViennaCLInt> const & row_ptr, std::vector<ViennaCLInt> const & col_idx, std::vector<NumericT> const & values,
+                           std::vector<NumericT> const & x, std::vector<NumericT> const & b)
+{
+  std::vector<NumericT> Ax;
+  reference_spmv(row_ptr, col_idx, values, x, Ax);
+  NumericT norm_r = 0, norm_b = 0;
+  for (std::size_t i=0; i<b.size(); ++i)
+  {
+    norm_r += (b[i] - Ax[i]) * (b[i] - Ax[i]);
+    norm_b += b[i] * b[i];
+  }
+  return std::sqrt(norm_r / norm_b);
+}
+
+template<typename NumericT>
+NumericT max_rel_diff(std::vector<NumericT> const & v1, std::vector<NumericT> const & v2)
+{
+  NumericT ret = 0;
+  for (std::size_t i=0; i<v1.size(); ++i)
+    if (std::max(std::fabs(v1[i]), std::fabs(v2[i])) > 0)
+      ret = std::max(ret, std::fabs(v1[i] - v2[i]) / std::max(std::fabs(v1[i]), std::fabs(v2[i])));
+  return ret;
+}
+
+int main()
+{
+  ViennaCLInt points = 16;
+  ViennaCLInt n = points * points;
+
+  ViennaCLBackend my_backend;
+  ViennaCLBackendCreate(&my_backend);
+
+  std::vector<ViennaCLInt> row_ptr, col_idx;
+  std::vector<double> double_values;
+  fill_laplace(row_ptr, col_idx, double_values, points);
+  std::vector<float> float_values(double_values.begin(), double_values.end());
+  ViennaCLInt nnz = static_cast<ViennaCLInt>(col_idx.size());
+
+  //
+  // xCSRMV with offsets and strides
+  //
+  std::cout << std::endl << "-- Testing xCSRMV...";
+  {
+    std::vector<double> x(static_cast<std::size_t>(n)), y_ref;
+    for (std::size_t i=0; i<x.size(); ++i)
+      x[i] = 1.0 + double(i % 5);
+    reference_spmv(row_ptr, col_idx, double_values, x, y_ref);
+
+    std::vector<double> x_strided(static_cast<std::size_t>(2*n + 1)), y_strided(static_cast<std::size_t>(3*n + 2), 1.0);
+    for (std::size_t i=0; i<x.size(); ++i)
+      x_strided[1 + 2*i] = x[i];
+
+    ViennaCLHostDcsrmv(my_backend, n, n, nnz, 2.0, &row_ptr[0], &col_idx[0], &double_values[0],
+                       &x_strided[0], 1, 2,
+                       0.5,
+                       &y_strided[0], 2, 3);
+    std::vector<double> y(static_cast<std::size_t>(n));
+    for (std::size_t i=0; i<y.size(); ++i)
+    {
+      y[i] = y_strided[2 + 3*i];
+      y_ref[i] = 2.0 * y_ref[i] + 0.5;
+    }
+    check(max_rel_diff(y, y_ref) < 1e-12, "ViennaCLHostDcsrmv");
+
+    std::vector<float> float_x(x.begin(), x.end()), float_y(static_cast<std::size_t>(n)), float_y_ref;
+    reference_spmv(row_ptr, col_idx, float_values, float_x, float_y_ref);
+    ViennaCLHostScsrmv(my_backend, n, n, nnz, 1.0f, &row_ptr[0], &col_idx[0], &float_values[0],
+                       &float_x[0], 0, 1,
+                       0.0f,
+                       &float_y[0], 0, 1);
+    check(max_rel_diff(float_y, float_y_ref) < 1e-5f, "ViennaCLHostScsrmv");
+  }
+
+  //
+  // xCSRMM
+  //
+  std::cout << std::endl << "-- Testing xCSRMM...";
+  {
+    ViennaCLInt cols = 3;
+    std::vector<double> B(static_cast<std::size_t>(n * cols)), C(static_cast<std::size_t>(n * cols), 1.0), C_ref(static_cast<std::size_t>(n * cols));
+    for (std::size_t i=0; i<B.size(); ++i)
+      B[i] = double(i % 11) - 5.0;
+
+    for (ViennaCLInt j=0; j<cols; ++j)
+    {
+      std::vector<double> b_col(static_cast<std::size_t>(n)), c_col;
+      for (ViennaCLInt i=0; i<n; ++i)
+        b_col[std::size_t(i)] = B[std::size_t(i * cols + j)];  // row-major
+      reference_spmv(row_ptr, col_idx, double_values, b_col, c_col);
+      for (ViennaCLInt i=0; i<n; ++i)
+        C_ref[std::size_t(i + j * n)] = 3.0 * c_col[std::size_t(i)] - 1.0; // column-major
+    }
+
+    ViennaCLHostDcsrmm(my_backend, ViennaCLRowMajor, ViennaCLColumnMajor,
+                       n, cols, n, nnz,
+                       3.0, &row_ptr[0], &col_idx[0], &double_values[0],
+                       &B[0], 0, 0, 1, 1, cols,
+                       -1.0,
+                       &C[0], 0, 0, 1, 1, n);
+    check(max_rel_diff(C, C_ref) < 1e-12, "ViennaCLHostDcsrmm");
+
+    // C is not read for beta == 0, so NaN entries must not propagate:
+    for (std::size_t i=0; i<C.size(); ++i)
+    {
+      C[i] = std::numeric_limits<double>::quiet_NaN();
+      C_ref[i] = (C_ref[i] + 1.0) / 3.0 * 2.0;
+    }
+    ViennaCLHostDcsrmm(my_backend, ViennaCLRowMajor, ViennaCLColumnMajor,
+                       n, cols, n, nnz,
+                       2.0, &row_ptr[0], &col_idx[0], &double_values[0],
+                       &B[0], 0, 0, 1, 1, cols,
+                       0.0,
+                       &C[0], 0, 0, 1, 1, n);
+    bool no_nan = true;
+    for (std::size_t i=0; i<C.size(); ++i)
+      no_nan = no_nan && (C[i] == C[i]);
+    check(no_nan && max_rel_diff(C, C_ref) < 1e-12, "ViennaCLHostDcsrmm with beta = 0");
+  }
+
+  //
+  // Iterative solvers with and without preconditioner handles
+  //
+  std::cout << std::endl << "-- Testing xCSRSOLVE...";
+  {
+    std::vector<double> b(static_cast<std::size_t>(n));
+    for (std::size_t i=0; i<b.size(); ++i)
+      b[i] = 1.0 + double(i % 7) / 7.0;
+    std::vector<float> float_b(b.begin(), b.end());
+
+    ViennaCLSolverType solvers[] = {ViennaCLCG, ViennaCLBiCGStab, ViennaCLGMRES};
+    ViennaCLPreconditionerType preconditioners[] = {ViennaCLInvalidPreconditioner, ViennaCLJacobi, ViennaCLILU0, ViennaCLILUT, ViennaCLAMG};
+
+    for (std::size_t j=0; j<sizeof(preconditioners) / sizeof(ViennaCLPreconditionerType); ++j)
+    {
+      ViennaCLPreconditioner double_precond = NULL;
+      ViennaCLPreconditioner float_precond = NULL;
+      if (preconditioners[j] != ViennaCLInvalidPreconditioner)
+      {
+        check(ViennaCLHostDcsrPreconditionerCreate(my_backend, &double_precond, preconditioners[j], n, nnz, &row_ptr[0], &col_idx[0], &double_values[0]) == ViennaCLSuccess, "ViennaCLHostDcsrPreconditionerCreate");
+        check(ViennaCLHostScsrPreconditionerCreate(my_backend, &float_precond,  preconditioners[j], n, nnz, &row_ptr[0], &col_idx[0], &float_values[0])  == ViennaCLSuccess, "ViennaCLHostScsrPreconditionerCreate");
+      }
+
+      for (std::size_t i=0; i<sizeof(solvers) / sizeof(ViennaCLSolverType); ++i)
+      {
+        // preconditioned GMRES uses left preconditioning, i.e. the tolerance refers to the preconditioned residual. Only check the diagonal preconditioner, where both are comparable:
+        if (solvers[i] == ViennaCLGMRES && preconditioners[j] != ViennaCLInvalidPreconditioner && preconditioners[j] != ViennaCLJacobi)
+          continue;
+
+        // initial guess is taken into account:
+        std::vector<double> x(static_cast<std::size_t>(n), 0.5);
+        ViennaCLInt iters = 0;
+        double error = 0;
+        check(ViennaCLHostDcsrsolve(my_backend, solvers[i], n, nnz, &row_ptr[0], &col_idx[0], &double_values[0],
+                                    &b[0], 0, 1, &x[0], 0, 1,
+                                    double_precond, 1e-10, 500, 30, &iters, &error) == ViennaCLSuccess, "ViennaCLHostDcsrsolve");
+        check(relative_residual(row_ptr, col_idx, double_values, x, b) < 1e-8 && iters > 0, "ViennaCLHostDcsrsolve residual");
+
+        std::vector<float> float_x(static_cast<std::size_t>(n), 0.0f);
+        check(ViennaCLHostScsrsolve(my_backend, solvers[i], n, nnz, &row_ptr[0], &col_idx[0], &float_values[0],
+                                    &float_b[0], 0, 1, &float_x[0], 0, 1,
+                                    float_precond, 1e-5, 500, 0, NULL, NULL) == ViennaCLSuccess, "ViennaCLHostScsrsolve");
+        check(relative_residual(row_ptr, col_idx, float_values, float_x, float_b) < 1e-3f, "ViennaCLHostScsrsolve residual");
+      }
+
+      if (double_precond)
+      {
+        // precision mismatch is reported:
+        std::vector<float> float_x(static_cast<std::size_t>(n), 0.0f);
+        check(ViennaCLHostScsrsolve(my_backend, ViennaCLCG, n, nnz, &row_ptr[0], &col_idx[0], &float_values[0],
+                                    &float_b[0], 0, 1, &float_x[0], 0, 1,
+                                    double_precond, 1e-5, 500, 0, NULL, NULL) == ViennaCLGenericFailure, "precision mismatch");
+
+        ViennaCLPreconditionerDestroy(&double_precond);
+        ViennaCLPreconditionerDestroy(&float_precond);
+        check(double_precond == NULL && float_precond == NULL, "ViennaCLPreconditionerDestroy resets handle");
+        check(ViennaCLPreconditionerDestroy(&double_precond) == ViennaCLSuccess && ViennaCLPreconditionerDestroy(NULL) == ViennaCLSuccess, "ViennaCLPreconditionerDestroy on NULL");
+      }
+    }
+  }
+
+  ViennaCLBackendDestroy(&my_backend);
+
+  //
+  //  That's it.
+  //
+  std::cout << std::endl << "!!!! TEST COMPLETED SUCCESSFULLY !!!!" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/mixed_precision_sparse.cpp  Tests sparse matrices with reduced precision value storage: rounding to bfloat16 and half precision, products, and preconditioners.
+*   \test Tests sparse matrices with reduced precision value storage: rounding to bfloat16 and half precision, products, and preconditioners.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/mixed_precision_compressed_matrix.hpp"
+#include "viennacl/tools/reduced_precision.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/amg.hpp"
+
+#include "check.hpp"
+#include "sparse_products.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+/** @brief Assembles the 5-point stencil on an nx-by-ny grid. If 'variable' is set, the diffusion coefficient varies smoothly, so the entries are not representable in 16 bits. */
+void assemble(unsigned int nx, unsigned int ny, bool variable, std::vector< std::map<unsigned int, double> > & std_A)
+{
+  std_A.clear();
+  std_A.resize(nx * ny);
+  for (unsigned int i = 0; i < nx; ++i)
+    for (unsigned int j = 0; j < ny; ++j)
+    {
+      unsigned int row = i * ny + j;
+      double c = variable ? 1.0 + 0.5 * std::sin(0.1 * i) * std::cos(0.13 * j) : 1.0;
+      std_A[row][row] = 4.0 * c + (variable ? 0.01 : 0.0);
+      if (i > 0)      std_A[row][row - ny] = -c;
+      if (i < nx - 1) std_A[row][row + ny] = -c;
+      if (j > 0)      std_A[row][row - 1]  = -c;
+      if (j < ny - 1) std_A[row][row + 1]  = -c;
+    }
+}
+
+void test_conversions()
+{
+  check(float(viennacl::bfloat16(1.0f)) == 1.0f && float(viennacl::bfloat16(-3.5f)) == -3.5f, "bfloat16: exact values");
+  check(viennacl::bfloat16(1.0f + 1.0f / 256.0f).bits() == viennacl::bfloat16(1.0f).bits(), "bfloat16: ties to even (down)");
+  check(float(viennacl::bfloat16(1.0f + 3.0f / 256.0f)) == 1.0f + 4.0f / 256.0f, "bfloat16: ties to even (up)");
+  check(float(viennacl::bfloat16(1e30f)) > 9.9e29f && float(viennacl::bfloat16(1e30f)) < 1.01e30f, "bfloat16: range of float");
+  float bf_nan = float(viennacl::bfloat16(std::numeric_limits<float>::quiet_NaN()));
+  check(bf_nan != bf_nan, "bfloat16: NaN");
+
+  check(float(viennacl::half(1.0f)) == 1.0f && float(viennacl::half(-65504.0f)) == -65504.0f, "half: exact values");
+  check(float(viennacl::half(1.0f + 1.0f / 2048.0f)) == 1.0f, "half: ties to even");
+  check(float(viennacl::half(70000.0f)) == std::numeric_limits<float>::infinity(), "half: overflow to infinity");
+  check(float(viennacl::half(std::ldexp(1.0f, -24))) == std::ldexp(1.0f, -24) && float(viennacl::half(std::ldexp(1.0f, -26))) == 0.0f, "half: subnormals and underflow");
+
+  double max_error_bf16 = 0, max_error_half = 0;
+  for (unsigned int i = 1; i < 1000; ++i)
+  {
+    float value = 0.137f * float(i) - 50.0f;
+    max_error_bf16 = std::max(max_error_bf16, std::fabs(double(float(viennacl::bfloat16(value))) - value) / std::fabs(value));
+    max_error_half = std::max(max_error_half, std::fabs(double(float(viennacl::half(value))) - value) / std::fabs(value));
+  }
+  check(max_error_bf16 <= 1.0 / 256.0 && max_error_half <= 1.0 / 2048.0, "rounding errors within half a unit in the last place");
+}
+
+template<typename StorageT>
+void test_products(viennacl::compressed_matrix<double> const & A, double tolerance, std::string const & name)
+{
+  viennacl::mixed_precision_compressed_matrix<double, StorageT> A_mixed(A);
+  check(A_mixed.size1() == A.size1() && A_mixed.size2() == A.size2() && A_mixed.nnz() == A.nnz(), name + ": conversion from compressed_matrix");
+
+  check_sparse_products(A_mixed, A, tolerance, name);
+
+  // the values copied back are the rounded values, hence products with them are exact:
+  viennacl::compressed_matrix<double> A_back(A.size1(), A.size2(), viennacl::traits::context(A));
+  viennacl::copy(A_mixed, A_back);
+  check_sparse_products(A_mixed, A_back, 1e-14, name + ", copy back to compressed_matrix");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+  test_conversions();
+
+  //
+  // Products: Exact for small integer entries, within the storage precision otherwise. Also with threads.
+  //
+  std::vector< std::map<unsigned int, double> > std_A, std_B;
+  assemble(40, 30, false, std_A);
+  assemble(40, 30, true,  std_B);
+  viennacl::compressed_matrix<double> A(ctx), B(ctx);
+  viennacl::copy(std_A, A);
+  viennacl::copy(std_B, B);
+
+  test_products<float>(A, 1e-14, "float storage, integer entries");
+  test_products<viennacl::bfloat16>(A, 1e-14, "bfloat16 storage, integer entries");
+  test_products<viennacl::half>(A, 1e-14, "half storage, integer entries");
+
+  test_products<float>(B, 1e-6, "float storage");
+  test_products<viennacl::bfloat16>(B, 1e-2, "bfloat16 storage");
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 3);
+  test_products<viennacl::half>(B, 2e-3, "half storage with threads");
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 1);
+
+  viennacl::mixed_precision_compressed_matrix<double, viennacl::half> A_from_host(ctx);
+  viennacl::copy(std_A, A_from_host);
+  std::vector< std::map<unsigned int, double> > std_A_back;
+  viennacl::copy(A_from_host, std_A_back);
+  check(std_A_back == std_A, "conversion from and to the host");
+
+  //
+  // Preconditioners stored in reduced precision, applied to the full precision system
+  //
+  std::size_t N = B.size1();
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> result(N, ctx), result_ref(N, ctx);
+
+  viennacl::linalg::cg_tag cg_tag(1e-10, 1000);
+  result_ref = viennacl::linalg::solve(B, rhs, cg_tag);
+  unsigned int cg_iters = cg_tag.iters();
+
+  viennacl::mixed_precision_compressed_matrix<double, float> B_float(B);
+  result = viennacl::linalg::solve(B_float, rhs, cg_tag);
+  check(relative_difference(result, result_ref) < 1e-5, "CG with float system matrix");
+
+  viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<double> > ilu0(B, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(B, rhs, cg_tag, ilu0);
+  unsigned int ilu0_iters = cg_tag.iters();
+
+  viennacl::linalg::ilu0_precond< viennacl::mixed_precision_compressed_matrix<double, float> > ilu0_float(B, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(B, rhs, cg_tag, ilu0_float);
+  check(relative_difference(result, result_ref) < 1e-8 && cg_tag.iters() <= ilu0_iters + 1, "CG with float ILU0 preconditioner");
+
+  viennacl::linalg::ilu0_precond< viennacl::mixed_precision_compressed_matrix<double, viennacl::bfloat16> > ilu0_bf16(B, viennacl::linalg::ilu0_tag());
+  result = viennacl::linalg::solve(B, rhs, cg_tag, ilu0_bf16);
+  std::cout << " * CG iterations: " << cg_iters << " without preconditioner, " << ilu0_iters << " with ILU0, " << cg_tag.iters() << " with bfloat16 ILU0" << std::endl;
+  check(relative_difference(result, result_ref) < 1e-8 && cg_tag.iters() < cg_iters, "CG with bfloat16 ILU0 preconditioner");
+
+  viennacl::linalg::amg_tag amg_tag;
+  amg_tag.set_coarsening_method(viennacl::linalg::AMG_COARSENING_METHOD_MIS2_AGGREGATION);
+  amg_tag.set_interpolation_method(viennacl::linalg::AMG_INTERPOLATION_METHOD_SMOOTHED_AGGREGATION);
+  amg_tag.set_setup_context(ctx);
+  amg_tag.set_target_context(ctx);
+
+  viennacl::linalg::amg_precond< viennacl::compressed_matrix<double> > amg(B, amg_tag);
+  amg.setup();
+  result = viennacl::linalg::solve(B, rhs, cg_tag, amg);
+  unsigned int amg_iters = cg_tag.iters();
+
+  viennacl::linalg::amg_precond< viennacl::mixed_precision_compressed_matrix<double, float> > amg_float(B, amg_tag);
+  amg_float.setup();
+  result = viennacl::linalg::solve(B, rhs, cg_tag, amg_float);
+  std::cout << " * CG iterations: " << amg_iters << " with AMG, " << cg_tag.iters() << " with float AMG (" << amg_float.levels() << " levels)" << std::endl;
+  check(relative_difference(result, result_ref) < 1e-8 && cg_tag.iters() <= amg_iters + 2, "CG with float AMG preconditioner");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -23,8 +23,12 @@
 #include <ctime>
 #include <cmath>
 
+#include <map>
+#include <vector>
+
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/nmf.hpp"
+#include "viennacl/compressed_matrix.hpp"
 
 typedef float ScalarType;
 
@@ -97,6 +101,119 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
     exit(EXIT_FAILURE);
 }
 
+void test_nmf_hals(std::size_t m, std::size_t k, std::size_t n);
+
+void test_nmf_hals(std::size_t m, std::size_t k, std::size_t n)
+{
+  viennacl::matrix<ScalarType> v_ref(m, n);
+  viennacl::matrix<ScalarType> w_ref(m, k);
+  viennacl::matrix<ScalarType> h_ref(k, n);
+
+  fill_random(w_ref);
+  fill_random(h_ref);
+
+  v_ref = viennacl::linalg::prod(w_ref, h_ref);  //reference result
+
+  viennacl::matrix<ScalarType> w_nmf(m, k);
+  viennacl::matrix<ScalarType> h_nmf(k, n);
+
+  fill_random(w_nmf);
+  fill_random(h_nmf);
+
+  viennacl::linalg::nmf_config conf;
+  conf.method(viennacl::linalg::NMF_HALS);
+  conf.max_iterations(3000);
+
+  viennacl::linalg::nmf(v_ref, w_nmf, h_nmf, conf);
+
+  viennacl::matrix<ScalarType> v_nmf = viennacl::linalg::prod(w_nmf, h_nmf);
+
+  float diff = matrix_compare(v_ref, v_nmf);
+  bool diff_ok = fabs(diff) < EPS;
+
+  long iterations = static_cast<long>(conf.iters());
+  printf("%6s HALS   [%lux%lux%lu] diff = %.6f (%ld iterations)\n", diff_ok ? "[[OK]]" : "[FAIL]", m, k, n,
+      diff, iterations);
+
+  if (!diff_ok)
+    exit(EXIT_FAILURE);
+}
+
+void test_nmf_sparse(std::size_t m, std::size_t k, std::size_t n);
+
+/** @brief Factors with few nonzeros per row (W) and per column (H) result in a sparse V = W * H */
+void test_nmf_sparse(std::size_t m, std::size_t k, std::size_t n)
+{
+  viennacl::matrix<ScalarType> w_ref = viennacl::zero_matrix<ScalarType>(m, k);
+  viennacl::matrix<ScalarType> h_ref = viennacl::zero_matrix<ScalarType>(k, n);
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    w_ref(i, i % k)           = ScalarType(0.5) + static_cast<ScalarType>(rand()) / ScalarType(RAND_MAX);
+    w_ref(i, (i * 7 + 3) % k) = ScalarType(0.5) + static_cast<ScalarType>(rand()) / ScalarType(RAND_MAX);
+  }
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    h_ref(j % k, j)           = ScalarType(0.5) + static_cast<ScalarType>(rand()) / ScalarType(RAND_MAX);
+    h_ref((j * 5 + 1) % k, j) = ScalarType(0.5) + static_cast<ScalarType>(rand()) / ScalarType(RAND_MAX);
+  }
+
+  viennacl::matrix<ScalarType> v_ref = viennacl::linalg::prod(w_ref, h_ref);
+
+  std::vector<std::map<unsigned int, ScalarType> > v_map(m);
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < n; ++j)
+      if (v_ref(i, j) > 0)
+        v_map[i][static_cast<unsigned int>(j)] = v_ref(i, j);
+
+  viennacl::compressed_matrix<ScalarType> v_sparse;
+  viennacl::copy(v_map, v_sparse);
+
+  viennacl::matrix<ScalarType> w_nmf(m, k);
+  viennacl::matrix<ScalarType> h_nmf(k, n);
+
+  fill_random(w_nmf);
+  fill_random(h_nmf);
+
+  viennacl::linalg::nmf_config conf;
+  conf.max_iterations(3000);
+
+  // the first iterations agree with the dense HALS implementation:
+  {
+    viennacl::matrix<ScalarType> w_dense = w_nmf;
+    viennacl::matrix<ScalarType> h_dense = h_nmf;
+    viennacl::matrix<ScalarType> w_sparse = w_nmf;
+    viennacl::matrix<ScalarType> h_sparse = h_nmf;
+
+    viennacl::linalg::nmf_config conf_short;
+    conf_short.method(viennacl::linalg::NMF_HALS);
+    conf_short.max_iterations(20);
+    viennacl::linalg::nmf(v_ref,    w_dense,  h_dense,  conf_short);
+    viennacl::linalg::nmf(v_sparse, w_sparse, h_sparse, conf_short);
+
+    float diff_w = matrix_compare(w_dense, w_sparse);
+    float diff_h = matrix_compare(h_dense, h_sparse);
+    if (diff_w > 1e-3f || diff_h > 1e-3f)
+    {
+      printf("[FAIL] sparse [%lux%lux%lu] differs from dense HALS: %.6f, %.6f\n", m, k, n, diff_w, diff_h);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  viennacl::linalg::nmf(v_sparse, w_nmf, h_nmf, conf);
+
+  viennacl::matrix<ScalarType> v_nmf = viennacl::linalg::prod(w_nmf, h_nmf);
+
+  float diff = matrix_compare(v_ref, v_nmf);
+  bool diff_ok = fabs(diff) < EPS;
+
+  long iterations = static_cast<long>(conf.iters());
+  printf("%6s sparse [%lux%lux%lu] diff = %.6f (%ld iterations, %lu nonzeros)\n", diff_ok ? "[[OK]]" : "[FAIL]", m, k, n,
+      diff, iterations, static_cast<unsigned long>(v_sparse.nnz()));
+
+  if (!diff_ok)
+    exit(EXIT_FAILURE);
+}
+
 int main()
 {
   //srand(time(NULL));  //let's use deterministic tests, so keep the default srand() initialization
@@ -109,6 +226,13 @@ int main()
   test_nmf(16, 7, 12);
   test_nmf(140, 86, 113);
 
+  test_nmf_hals(5, 4, 5);
+  test_nmf_hals(16, 7, 12);
+  test_nmf_hals(70, 30, 60);
+
+  test_nmf_sparse(300, 6, 200);
+  test_nmf_sparse(400, 8, 300);
+
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
   std::cout << std::endl;
@@ -0,0 +1,129 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/numa_policy.cpp  Tests the placement policies for buffers in main memory on NUMA systems.
+*   \test Tests the placement policies for buffers in main memory on NUMA systems.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+
+#include "check.hpp"
+
+/** @brief Runs BLAS level 1 operations and a sparse matrix-vector product on buffers created with the given policy */
+void test_policy(viennacl::numa_policies policy, std::string const & name, std::size_t points)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY, policy);
+  std::size_t N = points * points;
+
+  // vectors:
+  std::vector<double> host_x(N), host_y(N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    host_x[i] = double(i % 17);
+    host_y[i] = 1.0 + double(i % 5);
+  }
+
+  viennacl::vector<double> x(N, ctx), y(N, ctx);
+  check(viennacl::traits::context(x).numa_policy() == policy, name + ": policy of vector");
+
+  // raw buffers created from host data, with a size which is not a multiple of the page size:
+  {
+    std::size_t bytes = N * sizeof(double) + 13;
+    std::vector<char> host_data(bytes), read_back(bytes);
+    for (std::size_t i=0; i<bytes; ++i)
+      host_data[i] = char(i % 127);
+
+    viennacl::backend::mem_handle handle;
+    viennacl::backend::memory_create(handle, bytes, ctx, &host_data[0]);
+    check(viennacl::traits::context(handle).numa_policy() == policy, name + ": policy of buffer");
+    viennacl::backend::memory_read(handle, 0, bytes, &read_back[0]);
+    check(read_back == host_data, name + ": buffer initialized from host data");
+  }
+
+  viennacl::copy(host_x, x);
+  viennacl::copy(host_y, y);
+
+  viennacl::vector<double> z(N, viennacl::traits::context(x));
+  check(viennacl::traits::context(z).numa_policy() == policy, name + ": policy inherited from context of vector");
+
+  z = x + 2.0 * y;
+  std::vector<double> host_z(N);
+  viennacl::copy(z, host_z);
+  double error = 0;
+  for (std::size_t i=0; i<N; ++i)
+    error = std::max(error, std::fabs(host_z[i] - host_x[i] - 2.0 * host_y[i]));
+  check(error <= 0, name + ": BLAS level 1");
+
+  // CSR matrix:
+  std::vector< std::map<unsigned int, double> > host_A;
+  viennacl::tools::sparse_matrix_adapter<double> adapted_A(host_A);
+  viennacl::tools::generate_fdm_laplace(adapted_A, points, points);
+
+  viennacl::compressed_matrix<double> A(ctx);
+  viennacl::copy(host_A, A);
+  check(viennacl::traits::context(A.handle()).numa_policy() == policy, name + ": policy of sparse matrix");
+
+  z = viennacl::linalg::prod(A, x);
+  viennacl::copy(z, host_z);
+  error = 0;
+  for (std::size_t i=0; i<N; ++i)
+  {
+    double value = 0;
+    for (std::map<unsigned int, double>::const_iterator it = host_A[i].begin(); it != host_A[i].end(); ++it)
+      value += it->second * host_x[it->first];
+    error = std::max(error, std::fabs(host_z[i] - value));
+  }
+  check(error <= 0, name + ": sparse matrix-vector product");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context default_ctx(viennacl::MAIN_MEMORY);
+  check(default_ctx.numa_policy() == viennacl::NUMA_FIRST_TOUCH, "default policy");
+
+  viennacl::context bound_ctx(viennacl::MAIN_MEMORY, viennacl::NUMA_BIND, 0);
+  check(bound_ctx.numa_node() == 0, "node of context");
+
+  std::size_t sizes[] = {7, 300};
+  for (std::size_t i=0; i<2; ++i)
+  {
+    std::cout << "# Problem size: " << sizes[i] * sizes[i] << std::endl;
+    test_policy(viennacl::NUMA_FIRST_TOUCH, "first touch", sizes[i]);
+    test_policy(viennacl::NUMA_INTERLEAVE,  "interleave",  sizes[i]);
+    test_policy(viennacl::NUMA_BIND,        "bind",        sizes[i]);
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
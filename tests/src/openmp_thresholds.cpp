@@ -0,0 +1,109 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/openmp_thresholds.cpp  Tests the runtime table of OpenMP thresholds and its calibration.
+*   \test Tests the runtime table of OpenMP thresholds and its calibration.
+**/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/host_based/openmp_calibration.hpp"
+
+#include "check.hpp"
+
+namespace host_based = viennacl::linalg::host_based;
+
+/** @brief Checks that the vector kernels compute correct results with the current table */
+void check_vector_kernels(std::string const & name)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  viennacl::vector<double> x = viennacl::scalar_vector<double>(100000, 1.0, ctx);
+  viennacl::vector<double> y = viennacl::scalar_vector<double>(100000, 2.0, ctx);
+  x += 2.0 * y;
+  check(std::fabs(viennacl::linalg::norm_2(x) - 5.0 * std::sqrt(100000.0)) < 1e-8, name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  std::string filename = "openmp_thresholds_test.txt";
+
+  // set and get:
+  host_based::set_openmp_min_size(host_based::openmp_vector_kernels, 1234);
+  host_based::set_openmp_num_threads(host_based::openmp_vector_kernels, 1);
+  check(host_based::openmp_min_size(host_based::openmp_vector_kernels) == 1234, "set_openmp_min_size");
+  check(host_based::openmp_num_threads(host_based::openmp_vector_kernels) == 1, "set_openmp_num_threads");
+  check_vector_kernels("vector kernels with custom threshold");
+
+  host_based::set_openmp_min_size(host_based::openmp_vector_kernels, 0);
+  host_based::set_openmp_num_threads(host_based::openmp_vector_kernels, 0);
+  check(host_based::openmp_num_threads(host_based::openmp_vector_kernels) >= 1, "default number of threads");
+  check_vector_kernels("vector kernels with zero threshold");
+
+  // save and load:
+  host_based::set_openmp_min_size(host_based::openmp_matrix_kernels, 4321);
+  host_based::set_openmp_num_threads(host_based::openmp_matrix_kernels, 3);
+  check(host_based::save_openmp_thresholds(filename), "save_openmp_thresholds");
+
+  host_based::set_openmp_min_size(host_based::openmp_matrix_kernels, 42);
+  host_based::set_openmp_num_threads(host_based::openmp_matrix_kernels, 0);
+  check(host_based::load_openmp_thresholds(filename), "load_openmp_thresholds");
+  check(host_based::openmp_min_size(host_based::openmp_matrix_kernels) == 4321, "loaded threshold");
+#ifdef VIENNACL_WITH_OPENMP
+  check(host_based::openmp_num_threads(host_based::openmp_matrix_kernels) == 3, "loaded number of threads");
+#endif
+  check(!host_based::load_openmp_thresholds("does_not_exist.txt"), "loading from missing file fails");
+
+  // a malformed file must not change the table, not even the entries preceding the error:
+  {
+    std::ofstream file(filename.c_str());
+    file << "matrix 17 2" << std::endl << "vector 18 not_a_number" << std::endl;
+  }
+  check(!host_based::load_openmp_thresholds(filename), "loading malformed file fails");
+  check(host_based::openmp_min_size(host_based::openmp_matrix_kernels) == 4321, "malformed file leaves table unchanged");
+  {
+    std::ofstream file(filename.c_str());
+    file << "matrix 17 2" << std::endl << "no_such_family 18 1" << std::endl;
+  }
+  check(!host_based::load_openmp_thresholds(filename), "loading file with unknown kernel family fails");
+  check(host_based::openmp_min_size(host_based::openmp_matrix_kernels) == 4321, "unknown kernel family leaves table unchanged");
+
+  // calibration:
+  std::remove(filename.c_str());
+  host_based::load_or_calibrate_openmp_thresholds(filename);
+  check(host_based::load_openmp_thresholds(filename), "calibrated table written");
+  for (int i = 0; i < host_based::openmp_kernel_family_count; ++i)
+    std::cout << " family " << i << ": min_size " << host_based::openmp_min_size(host_based::openmp_kernel_family(i))
+              << ", threads " << host_based::openmp_num_threads(host_based::openmp_kernel_family(i)) << std::endl;
+  check_vector_kernels("vector kernels with calibrated table");
+  std::remove(filename.c_str());
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
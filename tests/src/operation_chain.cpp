@@ -0,0 +1,123 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/operation_chain.cpp  Tests chains of vector operations executed by the host thread team.
+*   \test Tests chains of vector operations executed by the host thread team.
+**/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/linalg/host_based/operation_chain.hpp"
+
+#include "check.hpp"
+
+namespace host_based = viennacl::linalg::host_based;
+
+template<typename NumericT>
+NumericT diff(viennacl::vector<NumericT> const & v1, viennacl::vector<NumericT> const & v2)
+{
+  viennacl::vector<NumericT> d = v1 - v2;
+  return viennacl::linalg::norm_2(d) / viennacl::linalg::norm_2(v2);
+}
+
+/** @brief Runs conjugate gradient iterations for the 2d Laplace matrix once with separate operations and once with an operation chain per iteration */
+template<typename NumericT>
+void test_cg(std::size_t points, NumericT tolerance)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<NumericT> A(ctx);
+  viennacl::tools::generate_fdm_laplace(A, points, points);
+  std::size_t N = A.size1();
+  std::cout << "# Size: " << N << std::endl;
+
+  viennacl::vector<NumericT> b = viennacl::scalar_vector<NumericT>(N, NumericT(1), ctx);
+
+  // reference: separate operations
+  viennacl::vector<NumericT> x_ref = viennacl::zero_vector<NumericT>(N, ctx);
+  viennacl::vector<NumericT> r_ref = b, p_ref = b, Ap_ref(N, ctx);
+  NumericT rr_ref = viennacl::linalg::inner_prod(r_ref, r_ref);
+
+  // chained operations:
+  viennacl::vector<NumericT> x = viennacl::zero_vector<NumericT>(N, ctx);
+  viennacl::vector<NumericT> r = b, p = b, Ap(N, ctx);
+  NumericT rr = viennacl::linalg::inner_prod(r, r), pAp = 0, rr_new = 0, residual_norm = 0;
+
+  host_based::operation_chain<NumericT> chain(N);
+  chain.inner_prod(p, Ap, pAp);
+  chain.avbv(x, x, NumericT(1), p, host_based::chain_scalar<NumericT>(NumericT( 1), &rr, &pAp));
+  chain.avbv(r, r, NumericT(1), Ap, host_based::chain_scalar<NumericT>(NumericT(-1), &rr, &pAp));
+  chain.inner_prod(r, r, rr_new);
+  chain.avbv(p, r, NumericT(1), p, host_based::chain_scalar<NumericT>(NumericT(1), &rr_new, &rr));
+  chain.norm_2(r, residual_norm);
+
+  for (std::size_t iter = 0; iter < 20; ++iter)
+  {
+    Ap_ref = viennacl::linalg::prod(A, p_ref);
+    NumericT alpha = rr_ref / viennacl::linalg::inner_prod(p_ref, Ap_ref);
+    x_ref += alpha * p_ref;
+    r_ref -= alpha * Ap_ref;
+    NumericT rr_ref_new = viennacl::linalg::inner_prod(r_ref, r_ref);
+    p_ref = r_ref + (rr_ref_new / rr_ref) * p_ref;
+    rr_ref = rr_ref_new;
+
+    Ap = viennacl::linalg::prod(A, p);
+    chain.execute();
+    rr = rr_new;
+  }
+
+  check(diff(x, x_ref) < tolerance, "solution");
+  check(diff(p, p_ref) < tolerance, "search direction");
+  check(std::fabs(rr - rr_ref) <= tolerance * rr_ref, "inner product");
+  check(std::fabs(residual_norm - viennacl::linalg::norm_2(r_ref)) <= tolerance * std::sqrt(rr_ref), "norm");
+
+  // x = alpha * y:
+  host_based::operation_chain<NumericT> scale_chain(N);
+  scale_chain.av(x, b, NumericT(3));
+  scale_chain.execute();
+  viennacl::vector<NumericT> x_scaled = NumericT(3) * b;
+  check(diff(x, x_scaled) <= 0, "av");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  std::cout << "## Testing float" << std::endl;
+  test_cg<float>(10, 1e-4f);
+  test_cg<float>(200, 1e-3f);
+
+  std::cout << "## Testing double" << std::endl;
+  test_cg<double>(10, 1e-10);
+  test_cg<double>(200, 1e-10);
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/profiler.cpp  Tests the instrumentation of dispatched operations.
+*   \test Tests the instrumentation of dispatched operations.
+**/
+
+#ifndef VIENNACL_WITH_PROFILER
+  #define VIENNACL_WITH_PROFILER
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <pthread.h>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/scheduler/execute.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/tools/profiler.hpp"
+
+#include "check.hpp"
+
+void * thread_inner_prod(void * arg)
+{
+  viennacl::vector<double> const & x = *static_cast<viennacl::vector<double> const *>(arg);
+  double result = viennacl::linalg::inner_prod(x, x);
+  (void)result;
+  return NULL;
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  std::size_t N = 1000;
+  viennacl::vector<double> x = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> y = viennacl::scalar_vector<double>(N, 2.0, ctx);
+  viennacl::matrix<double> A = viennacl::scalar_matrix<double>(N, N, 1.0, ctx);
+  viennacl::compressed_matrix<double> B(ctx);
+  viennacl::tools::generate_fdm_laplace(B, 10, 100);
+
+  viennacl::tools::reset_profiler();
+
+  for (std::size_t i=0; i<5; ++i)
+  {
+    double ip = viennacl::linalg::inner_prod(x, y);
+    (void)ip;
+  }
+  y = viennacl::linalg::prod(A, x);
+  y = viennacl::linalg::prod(B, x);
+  x = 2.0 * x + y;
+
+  viennacl::scheduler::statement s(x, viennacl::op_assign(), y - x);
+  viennacl::scheduler::execute(s);
+
+  viennacl::tools::enable_profiler(false);
+  double ip = viennacl::linalg::inner_prod(x, y);
+  (void)ip;
+  viennacl::tools::enable_profiler(true);
+
+  // operations in a second thread are recorded separately:
+  pthread_t thread;
+  pthread_create(&thread, NULL, thread_inner_prod, &x);
+  pthread_join(thread, NULL);
+
+  std::map<std::string, viennacl::tools::profiler_counters> summary = viennacl::tools::profiler_summary();
+  viennacl::tools::print_profiler_summary(std::cout);
+
+  check(summary["vector::inner_prod"].calls == 6, "call count of inner products");
+  check(summary["vector::inner_prod"].bytes == 6 * 2 * double(N * sizeof(double)), "bytes of inner products");
+  check(summary["vector::inner_prod"].flops == 6 * 2 * double(N), "flops of inner products");
+  check(summary["matrix::prod (gemv)"].calls == 1 && summary["matrix::prod (gemv)"].flops == 2.0 * double(N) * double(N), "dense matrix-vector product");
+  check(summary["sparse::prod (spmv)"].calls == 1 && summary["sparse::prod (spmv)"].flops == 2.0 * double(B.nnz()), "sparse matrix-vector product");
+  check(summary["vector::avbv"].calls >= 1, "vector update");
+  check(summary["scheduler::execute"].calls == 1, "scheduler");
+  check(summary["matrix::prod (gemv)"].time > 0, "time measurement");
+
+  std::ostringstream trace;
+  viennacl::tools::write_chrome_trace(trace);
+  std::string json = trace.str();
+  check(json.find("{\"traceEvents\":[") == 0, "trace header");
+  check(json.find("\"name\":\"sparse::prod (spmv)\",\"cat\":\"viennacl\",\"ph\":\"X\"") != std::string::npos, "trace event");
+  check(json.find("\"tid\":1") != std::string::npos, "trace of second thread");
+
+  viennacl::tools::reset_profiler();
+  check(viennacl::tools::profiler_summary().size() == 0, "reset");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
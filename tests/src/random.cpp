@@ -0,0 +1,232 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/random.cpp  Tests the counter-based generation of random vectors and matrices.
+*   \test Tests the counter-based generation of random vectors and matrices.
+**/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/random_operations.hpp"
+#include "viennacl/tools/random.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include "check.hpp"
+
+namespace vt = viennacl::tools;
+
+bool check_philox(unsigned int c0, unsigned int c1, unsigned int c2, unsigned int c3, unsigned int k0, unsigned int k1,
+                  unsigned int r0, unsigned int r1, unsigned int r2, unsigned int r3)
+{
+  unsigned int ctr[4] = {c0, c1, c2, c3};
+  unsigned int key[2] = {k0, k1};
+  unsigned int result[4];
+  vt::detail::philox4x32_10(ctr, key, result);
+  return result[0] == r0 && result[1] == r1 && result[2] == r2 && result[3] == r3;
+}
+
+/** @brief Compares a generated value with the value of the sequential host generator.
+  *
+  * Values generated by the OpenCL and CUDA backends may differ in the last bits, cf. viennacl/linalg/random_operations.hpp.
+  */
+template<typename NumericT>
+bool same_value(NumericT generated, NumericT reference)
+{
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  NumericT tolerance = NumericT(100) * std::numeric_limits<NumericT>::epsilon();
+  return std::fabs(generated - reference) <= tolerance * (NumericT(1) + std::fabs(reference));
+#else
+  return generated == reference;
+#endif
+}
+
+template<typename NumericT>
+void test_distributions(std::string const & type_name)
+{
+  std::size_t N = 100000;
+  viennacl::vector<NumericT> x(N);
+  std::vector<NumericT> std_x(N);
+
+  //
+  // Uniform distribution
+  //
+  viennacl::linalg::fill_random(x, vt::uniform_distribution(-1.0, 3.0), 42);
+  viennacl::copy(x, std_x);
+
+  double mean = 0, var = 0, min_val = 10, max_val = -10;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    mean += double(std_x[i]) / double(N);
+    min_val = std::min(min_val, double(std_x[i]));
+    max_val = std::max(max_val, double(std_x[i]));
+  }
+  for (std::size_t i = 0; i < N; ++i)
+    var += (double(std_x[i]) - mean) * (double(std_x[i]) - mean) / double(N - 1);
+  check(min_val >= -1.0 && max_val < 3.0 && min_val < -0.99 && max_val > 2.99, "range of uniform distribution, " + type_name);
+  check(std::fabs(mean - 1.0) < 0.02 && std::fabs(var - 16.0 / 12.0) < 0.02, "mean and variance of uniform distribution, " + type_name);
+
+  // sequential generator yields the same stream:
+  vt::uniform_random_numbers<NumericT> uniform_gen(42);
+  bool same_stream = true;
+  for (std::size_t i = 0; i < 1000; ++i)
+    same_stream = same_stream && same_value(std_x[i], NumericT(-1) + NumericT(4) * uniform_gen());
+  check(same_stream, "uniform_random_numbers matches fill_random, " + type_name);
+
+  //
+  // Normal distribution
+  //
+  viennacl::linalg::fill_random(x, vt::normal_distribution(2.0, 0.5), 7);
+  viennacl::copy(x, std_x);
+
+  mean = 0; var = 0;
+  std::size_t within_one_sigma = 0;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    mean += double(std_x[i]) / double(N);
+    if (std::fabs(double(std_x[i]) - 2.0) < 0.5)
+      ++within_one_sigma;
+  }
+  for (std::size_t i = 0; i < N; ++i)
+    var += (double(std_x[i]) - mean) * (double(std_x[i]) - mean) / double(N - 1);
+  check(std::fabs(mean - 2.0) < 0.01 && std::fabs(var - 0.25) < 0.01, "mean and variance of normal distribution, " + type_name);
+  check(std::fabs(double(within_one_sigma) / double(N) - 0.6827) < 0.01, "shape of normal distribution, " + type_name);
+
+  vt::normal_random_numbers<NumericT> normal_gen(NumericT(2), NumericT(0.5), 7);
+  same_stream = true;
+  for (std::size_t i = 0; i < 1000; ++i)
+    same_stream = same_stream && same_value(std_x[i], normal_gen());
+  check(same_stream, "normal_random_numbers matches fill_random, " + type_name);
+
+  //
+  // Reproducibility and dependence on the seed
+  //
+  viennacl::vector<NumericT> y(N);
+  viennacl::linalg::fill_random(y, vt::normal_distribution(2.0, 0.5), 7);
+  std::vector<NumericT> std_y(N);
+  viennacl::copy(y, std_y);
+  check(std_x == std_y, "reproducibility for same seed, " + type_name);
+
+  viennacl::linalg::fill_random(y, vt::normal_distribution(2.0, 0.5), 8);
+  viennacl::copy(y, std_y);
+  std::size_t num_equal = 0;
+  for (std::size_t i = 0; i < N; ++i)
+    if (std_x[i] == std_y[i])
+      ++num_equal;
+  check(num_equal < 10, "different streams for different seeds, " + type_name);
+
+#ifdef VIENNACL_WITH_OPENMP
+  viennacl::linalg::host_based::set_openmp_min_size(viennacl::linalg::host_based::openmp_vector_kernels, 0);
+  int thread_counts[3] = {1, 3, 8};
+  for (std::size_t t = 0; t < 3; ++t)
+  {
+    viennacl::linalg::host_based::set_openmp_num_threads(viennacl::linalg::host_based::openmp_vector_kernels, thread_counts[t]);
+    viennacl::linalg::fill_random(y, vt::normal_distribution(2.0, 0.5), 7);
+    viennacl::copy(y, std_y);
+    check(std_x == std_y, "independent of number of threads, " + type_name);
+  }
+  viennacl::linalg::host_based::set_openmp_num_threads(viennacl::linalg::host_based::openmp_vector_kernels, 0);
+  viennacl::linalg::host_based::set_openmp_min_size(viennacl::linalg::host_based::openmp_vector_kernels, 5000);
+#endif
+
+  //
+  // Strided subvectors hold the beginning of the stream
+  //
+  viennacl::vector<NumericT> z = viennacl::scalar_vector<NumericT>(3 * 100 + 5, NumericT(-100));
+  viennacl::slice s(5, 3, 100);
+  viennacl::vector_slice<viennacl::vector<NumericT> > z_slice(z, s);
+  viennacl::linalg::fill_random(z_slice, vt::normal_distribution(2.0, 0.5), 7);
+  std::vector<NumericT> std_z(z.size());
+  viennacl::copy(z, std_z);
+  bool slice_ok = true;
+  for (std::size_t i = 0; i < std_z.size(); ++i)
+  {
+    if (i >= 5 && (i - 5) % 3 == 0)
+      slice_ok = slice_ok && (std_z[i] == std_x[(i - 5) / 3]);
+    else
+      slice_ok = slice_ok && (std_z[i] == NumericT(-100));
+  }
+  check(slice_ok, "fill_random on vector_slice, " + type_name);
+
+  //
+  // Matrices: Same entries for row-major and column-major layout
+  //
+  std::size_t rows = 37, cols = 53;
+  viennacl::matrix<NumericT, viennacl::row_major>    A(rows, cols);
+  viennacl::matrix<NumericT, viennacl::column_major> B(rows, cols);
+  viennacl::linalg::fill_random(A, vt::normal_distribution(2.0, 0.5), 7);
+  viennacl::linalg::fill_random(B, vt::normal_distribution(2.0, 0.5), 7);
+  std::vector<std::vector<NumericT> > std_A(rows, std::vector<NumericT>(cols)), std_B(rows, std::vector<NumericT>(cols));
+  viennacl::copy(A, std_A);
+  viennacl::copy(B, std_B);
+  bool matrix_ok = true;
+  for (std::size_t i = 0; i < rows; ++i)
+    for (std::size_t j = 0; j < cols; ++j)
+      matrix_ok = matrix_ok && (std_A[i][j] == std_x[i * cols + j]) && (std_B[i][j] == std_x[i * cols + j]);
+  check(matrix_ok, "fill_random on row-major and column-major matrices, " + type_name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  // Known-answer tests of Philox4x32-10 from the Random123 distribution:
+  check(check_philox(0, 0, 0, 0, 0, 0,
+                     0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8), "Philox4x32-10 with zero counter and key");
+  check(check_philox(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                     0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd), "Philox4x32-10 with all bits set");
+  check(check_philox(0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+                     0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1), "Philox4x32-10 with digits of pi");
+
+  test_distributions<float>("float");
+#ifdef VIENNACL_WITH_OPENCL
+  if (viennacl::ocl::current_device().double_support())
+#endif
+    test_distributions<double>("double");
+
+  // default-seeded generators provide distinct streams:
+  vt::uniform_random_numbers<double> gen1, gen2;
+  check(gen1.seed() != gen2.seed() && gen1() != gen2(), "distinct default seeds");
+
+#ifdef VIENNACL_WITH_OPENMP
+  // ... also when created concurrently:
+  std::vector<std::size_t> seeds(1000);
+  #pragma omp parallel for num_threads(4)
+  for (long i = 0; i < long(seeds.size()); ++i)
+    seeds[std::size_t(i)] = vt::uniform_random_numbers<double>().seed();
+  std::sort(seeds.begin(), seeds.end());
+  check(std::unique(seeds.begin(), seeds.end()) == seeds.end(), "distinct default seeds of generators created concurrently");
+#endif
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
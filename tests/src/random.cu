@@ -0,0 +1 @@
+random.cpp
\ No newline at end of file
@@ -0,0 +1,180 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/randomized_svd.cpp  Tests the randomized singular value decomposition for dense and sparse matrices with known singular values.
+*   \test Tests the randomized singular value decomposition for dense and sparse matrices with known singular values.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/randomized_svd.hpp"
+
+#include "check.hpp"
+
+/** @brief Orthonormal cosine basis vector r of length n, evaluated at i */
+double cosine_basis(std::size_t r, std::size_t i, std::size_t n)
+{
+  double pi = 3.1415926535897932384626433832795;
+  if (r == 0)
+    return std::sqrt(1.0 / double(n));
+  return std::sqrt(2.0 / double(n)) * std::cos(pi * (double(i) + 0.5) * double(r) / double(n));
+}
+
+/** @brief Checks the singular values, the orthonormality of the singular vectors, and the residual A V - U S */
+template<typename MatrixT>
+void check_triplets(std::vector<std::vector<double> > const & A,
+                    MatrixT const & U_dev, viennacl::vector<double> const & S_dev, MatrixT const & V_dev,
+                    std::vector<double> const & sigma_ref, double tolerance, std::string const & name)
+{
+  std::size_t m = A.size(), n = A[0].size(), k = sigma_ref.size();
+  check(U_dev.size1() == m && U_dev.size2() == k && V_dev.size1() == n && V_dev.size2() == k && S_dev.size() == k, name + ": sizes");
+
+  std::vector<std::vector<double> > U(m, std::vector<double>(k)), V(n, std::vector<double>(k));
+  std::vector<double> S(k);
+  viennacl::copy(U_dev, U);
+  viennacl::copy(V_dev, V);
+  viennacl::copy(S_dev, S);
+
+  double sv_error = 0;
+  for (std::size_t j = 0; j < k; ++j)
+    sv_error = std::max(sv_error, std::fabs(S[j] - sigma_ref[j]) / sigma_ref[0]);
+  check(sv_error < tolerance, name + ": singular values");
+
+  double ortho_error = 0;
+  for (std::size_t i = 0; i < k; ++i)
+    for (std::size_t j = 0; j < k; ++j)
+    {
+      double u_ij = 0, v_ij = 0;
+      for (std::size_t r = 0; r < m; ++r)
+        u_ij += U[r][i] * U[r][j];
+      for (std::size_t r = 0; r < n; ++r)
+        v_ij += V[r][i] * V[r][j];
+      ortho_error = std::max(ortho_error, std::fabs(u_ij - (i == j ? 1.0 : 0.0)));
+      if (sigma_ref[j] > 0 && sigma_ref[i] > 0)
+        ortho_error = std::max(ortho_error, std::fabs(v_ij - (i == j ? 1.0 : 0.0)));
+    }
+  check(ortho_error < tolerance, name + ": orthonormal singular vectors");
+
+  double residual = 0;
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j < k; ++j)
+    {
+      double av = 0;
+      for (std::size_t r = 0; r < n; ++r)
+        av += A[i][r] * V[r][j];
+      residual = std::max(residual, std::fabs(av - U[i][j] * S[j]));
+    }
+  check(residual < tolerance * sigma_ref[0], name + ": residual A V - U S");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  typedef viennacl::matrix<double, viennacl::column_major>  BlockType;
+
+  //
+  // Dense matrix with geometrically decaying singular values, built from cosine bases
+  //
+  {
+    std::size_t m = 203, n = 151;
+    std::vector<double> sigma(n);
+    for (std::size_t r = 0; r < n; ++r)
+      sigma[r] = std::pow(0.7, double(r));
+
+    std::vector<std::vector<double> > A_host(m, std::vector<double>(n, 0.0));
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        for (std::size_t r = 0; r < 40; ++r)
+          A_host[i][j] += sigma[r] * cosine_basis(r, i, m) * cosine_basis(r, j, n);
+
+    viennacl::matrix<double> A(m, n);
+    viennacl::copy(A_host, A);
+
+    BlockType U, V;
+    viennacl::vector<double> S;
+    viennacl::linalg::randomized_svd(A, U, S, V, viennacl::linalg::randomized_svd_tag(8));
+    check_triplets(A_host, U, S, V, std::vector<double>(sigma.begin(), sigma.begin() + 8), 1e-8, "dense, 8 triplets");
+
+    // fewer power iterations and oversampling still give the leading triplets
+    viennacl::linalg::randomized_svd_tag tag(5, 5, 1, 42);
+    viennacl::matrix<double, viennacl::row_major> U_row, V_row;
+    viennacl::linalg::randomized_svd(A, U_row, S, V_row, tag);
+    check_triplets(A_host, U_row, S, V_row, std::vector<double>(sigma.begin(), sigma.begin() + 5), 1e-4, "dense, row-major output, 1 power iteration");
+
+    // rank deficient: exact rank 3, but 6 triplets requested
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        A_host[i][j] = 0;
+        for (std::size_t r = 0; r < 3; ++r)
+          A_host[i][j] += sigma[r] * cosine_basis(r, i, m) * cosine_basis(r, j, n);
+      }
+    viennacl::copy(A_host, A);
+    viennacl::linalg::randomized_svd(A, U, S, V, viennacl::linalg::randomized_svd_tag(6));
+    std::vector<double> S_host(6);
+    viennacl::copy(S, S_host);
+    check(S_host[3] < 1e-6 && S_host[5] < 1e-6, "rank deficient: trailing singular values vanish");
+    for (std::size_t j = 0; j < 3; ++j)
+      check(std::fabs(S_host[j] - sigma[j]) < 1e-8, "rank deficient: leading singular values");
+  }
+
+  //
+  // Sparse matrix: scaled and permuted rectangular identity, singular values are the absolute values of the nonzeros
+  //
+  {
+    std::size_t m = 1200, n = 800;
+    std::vector<std::map<unsigned int, double> > A_map(m);
+    std::vector<double> sigma(n);
+    for (std::size_t r = 0; r < n; ++r)
+    {
+      sigma[r] = std::pow(0.8, double(r));
+      std::size_t row = (r * 7 + 3) % m;   // gcd(7, m) = 1
+      std::size_t col = (r * 13 + 5) % n;  // gcd(13, n) = 1
+      A_map[row][static_cast<unsigned int>(col)] = (r % 2) ? -sigma[r] : sigma[r];
+    }
+
+    viennacl::compressed_matrix<double> A;
+    viennacl::copy(A_map, A);
+
+    std::vector<std::vector<double> > A_host(m, std::vector<double>(n, 0.0));
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::map<unsigned int, double>::const_iterator it = A_map[i].begin(); it != A_map[i].end(); ++it)
+        A_host[i][it->first] = it->second;
+
+    BlockType U, V;
+    viennacl::vector<double> S;
+    viennacl::linalg::randomized_svd(A, U, S, V, viennacl::linalg::randomized_svd_tag(10, 10, 3));
+    check_triplets(A_host, U, S, V, std::vector<double>(sigma.begin(), sigma.begin() + 10), 1e-8, "sparse, 10 triplets");
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/reordered_matrix.cpp  Tests the nested dissection ordering, the cache miss estimate for sparse matrix-vector products, and the reordered_matrix in products and iterative solvers.
+*   \test Tests the nested dissection ordering, the cache miss estimate for sparse matrix-vector products, and the reordered_matrix in products and iterative solvers.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/reordered_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/tools/sparse_format_analyzer.hpp"
+
+#include "check.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+bool is_permutation(std::vector<unsigned int> const & r)
+{
+  std::vector<bool> found(r.size(), false);
+  for (std::size_t i = 0; i < r.size(); ++i)
+  {
+    if (std::size_t(r[i]) >= r.size() || found[r[i]])
+      return false;
+    found[r[i]] = true;
+  }
+  return true;
+}
+
+double relative_difference(viennacl::vector<double> const & x, viennacl::vector<double> const & y)
+{
+  return viennacl::linalg::norm_2(x - y) / viennacl::linalg::norm_2(y);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  //
+  // Shuffled 5-point stencil on a 60-by-50 grid, slightly nonsymmetric for the nonsymmetric solvers
+  //
+  unsigned int nx = 60, ny = 50;
+  std::size_t N = nx * ny;
+  std::vector<unsigned int> shuffle(N);
+  for (std::size_t i = 0; i < N; ++i)
+    shuffle[i] = static_cast<unsigned int>((i * 7919) % N); // N and 7919 are coprime
+
+  std::vector< std::map<unsigned int, double> > std_A(N), std_B(N);
+  for (unsigned int i = 0; i < nx; ++i)
+    for (unsigned int j = 0; j < ny; ++j)
+    {
+      unsigned int row = shuffle[i * ny + j];
+      std_A[row][row] = 4.0;
+      std_B[row][row] = 4.0;
+      if (i > 0)      { std_A[row][shuffle[(i-1) * ny + j]] = -1.0; std_B[row][shuffle[(i-1) * ny + j]] = -1.2; }
+      if (i < nx - 1) { std_A[row][shuffle[(i+1) * ny + j]] = -1.0; std_B[row][shuffle[(i+1) * ny + j]] = -0.8; }
+      if (j > 0)      { std_A[row][shuffle[i * ny + j - 1]] = -1.0; std_B[row][shuffle[i * ny + j - 1]] = -1.0; }
+      if (j < ny - 1) { std_A[row][shuffle[i * ny + j + 1]] = -1.0; std_B[row][shuffle[i * ny + j + 1]] = -1.0; }
+    }
+
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<double> A(ctx), B(ctx);
+  viennacl::copy(std_A, A);
+  viennacl::copy(std_B, B);
+
+  //
+  // Nested dissection ordering
+  //
+  std::vector<unsigned int> r_nd = viennacl::reorder(A, viennacl::nested_dissection_tag(64));
+  check(is_permutation(r_nd), "nested dissection ordering is a permutation");
+
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  int thread_counts[3] = {1, 3, 8};
+  for (std::size_t t = 0; t < 3; ++t)
+  {
+    vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, thread_counts[t]);
+    check(viennacl::reorder(A, viennacl::nested_dissection_tag(64)) == r_nd, "nested dissection independent of number of threads");
+  }
+
+  //
+  // Cache misses before and after reordering. The cache holds 1/16 of the input vector.
+  //
+  std::size_t cache_bytes = N * sizeof(double) / 16;
+  viennacl::tools::spmv_vector_cache_statistics stats_initial = viennacl::tools::spmv_vector_cache_misses(A, cache_bytes);
+  check(stats_initial.accesses == A.nnz() && stats_initial.compulsory_misses == (N * sizeof(double) + 63) / 64, "cache statistics: accesses and compulsory misses");
+
+  viennacl::reordered_matrix<double> A_rcm(A, viennacl::reverse_cuthill_mckee_tag());
+  viennacl::reordered_matrix<double> A_nd(A, viennacl::nested_dissection_tag(64));
+  viennacl::tools::spmv_vector_cache_statistics stats_rcm = viennacl::tools::spmv_vector_cache_misses(A_rcm.matrix(), cache_bytes);
+  viennacl::tools::spmv_vector_cache_statistics stats_nd  = viennacl::tools::spmv_vector_cache_misses(A_nd.matrix(), cache_bytes);
+  std::cout << " * Cache misses: initial " << stats_initial.misses << ", reverse Cuthill-McKee " << stats_rcm.misses << ", nested dissection " << stats_nd.misses
+            << " (compulsory: " << stats_initial.compulsory_misses << ")" << std::endl;
+  check(stats_rcm.misses == stats_rcm.compulsory_misses && stats_initial.misses > 2 * stats_initial.compulsory_misses, "reverse Cuthill-McKee reduces cache misses");
+  check(stats_nd.misses < stats_initial.misses / 2, "nested dissection reduces cache misses");
+
+  //
+  // Products in the original numbering
+  //
+  std::vector<double> std_x(N);
+  for (std::size_t i = 0; i < N; ++i)
+    std_x[i] = 1.0 + double(i % 17);
+  viennacl::vector<double> x(N, ctx), y(N, ctx), y_ref(N, ctx);
+  viennacl::copy(std_x, x);
+  y_ref = viennacl::linalg::prod(A, x);
+
+  y = viennacl::linalg::prod(A_nd, x);
+  check(relative_difference(y, y_ref) < 1e-14, "y = A * x");
+
+  y = 2.0 * y_ref;
+  y -= viennacl::linalg::prod(A_rcm, x);
+  check(relative_difference(y, y_ref) < 1e-14, "y -= A * x");
+
+  y = x;
+  y = viennacl::linalg::prod(A_rcm, y);
+  check(relative_difference(y, y_ref) < 1e-14, "x = A * x");
+
+  y = y_ref;
+  y += viennacl::linalg::prod(A_nd, x);
+  check(relative_difference(y, 2.0 * y_ref) < 1e-14, "y += A * x");
+
+  //
+  // Iterative solvers
+  //
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(N, 1.0, ctx);
+  viennacl::vector<double> result(N, ctx), result_ref(N, ctx);
+
+  result_ref = viennacl::linalg::solve(A, rhs, viennacl::linalg::cg_tag(1e-12, 1000));
+  result     = viennacl::linalg::solve(A_nd, rhs, viennacl::linalg::cg_tag(1e-12, 1000));
+  check(relative_difference(result, result_ref) < 1e-8, "CG with reordered_matrix");
+
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<double> > jacobi(A_rcm.matrix(), viennacl::linalg::jacobi_tag());
+  result = viennacl::linalg::solve(A_rcm, rhs, viennacl::linalg::cg_tag(1e-12, 1000), jacobi);
+  check(relative_difference(result, result_ref) < 1e-8, "CG with reordered_matrix and Jacobi preconditioner");
+
+  viennacl::reordered_matrix<double> B_rcm(B, viennacl::reverse_cuthill_mckee_tag());
+  result_ref = viennacl::linalg::solve(B, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  result     = viennacl::linalg::solve(B_rcm, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab with reordered_matrix");
+
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<double> > jacobi_B(B_rcm.matrix(), viennacl::linalg::jacobi_tag());
+  result = viennacl::linalg::solve(B_rcm, rhs, viennacl::linalg::bicgstab_tag(1e-12, 1000), jacobi_B);
+  check(relative_difference(result, result_ref) < 1e-8, "BiCGStab with reordered_matrix and Jacobi preconditioner");
+
+  result = viennacl::linalg::solve(B_rcm, rhs, viennacl::linalg::gmres_tag(1e-12, 1000, 30));
+  check(relative_difference(result, result_ref) < 1e-8, "GMRES with reordered_matrix");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
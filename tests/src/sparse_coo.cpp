@@ -0,0 +1,174 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/sparse_coo.cpp  Tests the segmented reduction kernels for coordinate_matrix and the conversion to compressed_matrix.
+*   \test Tests the segmented reduction kernels for coordinate_matrix and the conversion to compressed_matrix.
+**/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/random_operations.hpp"
+
+#include "check.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+double diff(viennacl::vector<double> const & x, viennacl::vector<double> const & y)
+{
+  viennacl::vector<double> d = x - y;
+  return viennacl::linalg::norm_2(d) / viennacl::linalg::norm_2(y);
+}
+
+template<typename LayoutT1, typename LayoutT2>
+void test_spmm(viennacl::coordinate_matrix<double> const & A_coo, viennacl::compressed_matrix<double> const & A_csr, std::string const & name)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+  std::size_t K = 5;
+
+  viennacl::matrix<double, LayoutT1> B(A_coo.size2(), K, ctx);
+  viennacl::matrix<double, LayoutT1> Bt(K, A_coo.size2(), ctx);
+  viennacl::linalg::fill_random(B,  viennacl::tools::uniform_distribution(), 1);
+  viennacl::linalg::fill_random(Bt, viennacl::tools::uniform_distribution(), 2);
+
+  viennacl::matrix<double, LayoutT2> C(A_coo.size1(), K, ctx);
+  viennacl::matrix<double, LayoutT2> C_ref(A_coo.size1(), K, ctx);
+
+  C     = viennacl::linalg::prod(A_coo, B);
+  C_ref = viennacl::linalg::prod(A_csr, B);
+  C_ref -= C;
+  check(viennacl::linalg::norm_frobenius(C_ref) < 1e-12 * viennacl::linalg::norm_frobenius(C), "SpMM with " + name);
+
+  C     = viennacl::linalg::prod(A_coo, viennacl::trans(Bt));
+  C_ref = viennacl::linalg::prod(A_csr, viennacl::trans(Bt));
+  C_ref -= C;
+  check(viennacl::linalg::norm_frobenius(C_ref) < 1e-12 * viennacl::linalg::norm_frobenius(C), "SpMM with transposed " + name);
+}
+
+void test_products(std::vector< std::map<unsigned int, double> > const & std_A, std::string const & name)
+{
+  viennacl::context ctx(viennacl::MAIN_MEMORY);
+
+  viennacl::coordinate_matrix<double> A_coo(ctx);
+  viennacl::compressed_matrix<double> A_csr(ctx);
+  viennacl::copy(std_A, A_coo);
+  viennacl::copy(std_A, A_csr);
+
+  viennacl::vector<double> x(A_coo.size2(), ctx);
+  viennacl::linalg::fill_random(x, viennacl::tools::normal_distribution(), 42);
+
+  viennacl::vector<double> y_ref = viennacl::linalg::prod(A_csr, x);
+  viennacl::vector<double> y     = viennacl::linalg::prod(A_coo, x);
+  check(diff(y, y_ref) < 1e-12, "SpMV, " + name);
+
+  y += viennacl::linalg::prod(A_coo, x);
+  viennacl::vector<double> z_ref = 2.0 * y_ref;
+  check(diff(y, z_ref) < 1e-12, "SpMV with inplace_add, " + name);
+
+  // strided vectors:
+  viennacl::vector<double> x_big = viennacl::scalar_vector<double>(2 * x.size() + 1, 0.0, ctx);
+  viennacl::vector<double> y_big = viennacl::scalar_vector<double>(3 * y.size() + 2, 7.0, ctx);
+  viennacl::vector_slice<viennacl::vector<double> > x_slice(x_big, viennacl::slice(1, 2, x.size()));
+  viennacl::vector_slice<viennacl::vector<double> > y_slice(y_big, viennacl::slice(2, 3, y.size()));
+  x_slice = x;
+  y_slice = viennacl::linalg::prod(A_coo, x_slice);
+  y = y_slice;
+  check(diff(y, y_ref) < 1e-12 && y_big[0] == 7.0 && y_big[3] == 7.0, "SpMV with strided vectors, " + name);
+
+  test_spmm<viennacl::row_major,    viennacl::row_major>(A_coo, A_csr, "row-major/row-major, " + name);
+  test_spmm<viennacl::row_major,    viennacl::column_major>(A_coo, A_csr, "row-major/column-major, " + name);
+  test_spmm<viennacl::column_major, viennacl::row_major>(A_coo, A_csr, "column-major/row-major, " + name);
+  test_spmm<viennacl::column_major, viennacl::column_major>(A_coo, A_csr, "column-major/column-major, " + name);
+
+  // conversion to CSR:
+  viennacl::compressed_matrix<double> B_csr(ctx);
+  viennacl::linalg::convert(B_csr, A_coo);
+  viennacl::vector<double> y_conv = viennacl::linalg::prod(B_csr, x);
+  check(B_csr.nnz() == A_csr.nnz() && B_csr.size1() == A_csr.size1() && B_csr.size2() == A_csr.size2() && diff(y_conv, y_ref) < 1e-12, "conversion to compressed_matrix, " + name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  // force several segments irrespective of the number of cores:
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 7);
+
+  //
+  // Matrix with rows of very different lengths, empty rows, and rows spanning several segments
+  //
+  std::size_t N = 1000;
+  std::vector< std::map<unsigned int, double> > std_A(N);
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    if (i % 10 == 3)
+      continue; // empty rows
+    std::size_t row_length = (i == 17) ? N : (i % 4) + 1;
+    for (std::size_t j = 0; j < row_length; ++j)
+      std_A[i][static_cast<unsigned int>((i * 7 + j * 13) % N)] = 1.0 + double((i + j) % 5);
+  }
+  std_A[N - 1][0] = 2.0;
+  test_products(std_A, "irregular matrix");
+
+  // a single row only, shared by all segments:
+  std::vector< std::map<unsigned int, double> > std_row(1);
+  for (unsigned int j = 0; j < 100; ++j)
+    std_row[0][j] = double(j);
+  test_products(std_row, "single row");
+
+  // fewer nonzeros than segments:
+  std::vector< std::map<unsigned int, double> > std_small(10);
+  std_small[2][3] = 1.0;
+  std_small[5][1] = 2.0;
+  std_small[5][7] = 3.0;
+  test_products(std_small, "fewer nonzeros than threads");
+
+  //
+  // Conversion of unsorted coordinate arrays
+  //
+  unsigned int coords[12] = { 2, 1,   0, 0,   2, 0,   0, 3,   4, 4,   1, 2 };
+  double       values[6]  = { 1.0,    2.0,    3.0,    4.0,    5.0,    6.0 };
+  std::vector<unsigned int> row_buffer(6), col_buffer(6);
+  std::vector<double> elements(6);
+  vhb::detail::coo_to_csr(coords, values, 6, 5, &row_buffer[0], &col_buffer[0], &elements[0]);
+  unsigned int row_ref[6] = { 0, 2, 3, 5, 5, 6 };
+  unsigned int col_ref[6] = { 0, 3, 2, 1, 0, 4 };
+  double       val_ref[6] = { 2.0, 4.0, 6.0, 1.0, 3.0, 5.0 };
+  check(std::equal(row_buffer.begin(), row_buffer.end(), row_ref)
+     && std::equal(col_buffer.begin(), col_buffer.end(), col_ref)
+     && std::equal(elements.begin(), elements.end(), val_ref), "conversion of unsorted coordinate arrays");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+#ifndef VIENNACL_TESTS_SPARSE_PRODUCTS_HPP_
+#define VIENNACL_TESTS_SPARSE_PRODUCTS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/sparse_products.hpp  Sparse matrix-vector product checks shared by the tests of the sparse formats derived from compressed_matrix.
+**/
+
+#include <vector>
+#include <string>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+
+#include "check.hpp"
+
+inline double relative_difference(viennacl::vector<double> const & x, viennacl::vector<double> const & y)
+{
+  return viennacl::linalg::norm_2(x - y) / viennacl::linalg::norm_2(y);
+}
+
+/** @brief Checks y = A * x, y += A * x, y -= A * x, x = A * x and the product with strided vectors for a sparse matrix converted from the compressed_matrix A. */
+template<typename SparseMatrixT>
+void check_sparse_products(SparseMatrixT const & A_test, viennacl::compressed_matrix<double> const & A, double tolerance, std::string const & name)
+{
+  std::size_t N = A.size1();
+  std::vector<double> std_x(N);
+  for (std::size_t i = 0; i < N; ++i)
+    std_x[i] = 1.0 + double(i % 13);
+  viennacl::vector<double> x(N, viennacl::traits::context(A)), y(N, viennacl::traits::context(A)), y_ref(N, viennacl::traits::context(A));
+  viennacl::copy(std_x, x);
+  y_ref = viennacl::linalg::prod(A, x);
+
+  y = viennacl::linalg::prod(A_test, x);
+  check(relative_difference(y, y_ref) <= tolerance, name + ": y = A * x");
+
+  y = y_ref;
+  y += viennacl::linalg::prod(A_test, x);
+  check(relative_difference(y, 2.0 * y_ref) <= tolerance, name + ": y += A * x");
+
+  y = 2.0 * y_ref;
+  y -= viennacl::linalg::prod(A_test, x);
+  check(relative_difference(y, y_ref) <= tolerance, name + ": y -= A * x");
+
+  y = x;
+  y = viennacl::linalg::prod(A_test, y);
+  check(relative_difference(y, y_ref) <= tolerance, name + ": x = A * x");
+
+  // strided vectors:
+  viennacl::vector<double> x_large(3 * N + 1, viennacl::traits::context(A)), y_large(2 * N + 2, viennacl::traits::context(A));
+  viennacl::vector_slice< viennacl::vector<double> > x_slice(x_large, viennacl::slice(1, 3, N));
+  viennacl::vector_slice< viennacl::vector<double> > y_slice(y_large, viennacl::slice(2, 2, N));
+  x_slice = x;
+  viennacl::linalg::prod_impl(A_test, x_slice, 1.0, y_slice, 0.0);
+  y = y_slice;
+  check(relative_difference(y, y_ref) <= tolerance, name + ": y = A * x for strided vectors");
+}
+
+#endif
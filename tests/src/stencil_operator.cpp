@@ -0,0 +1,245 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/stencil_operator.cpp  Tests the matrix-free stencil operator: products with constant and variable coefficients, the temporally blocked Jacobi smoother, and iterative solvers.
+*   \test Tests the matrix-free stencil operator: products with constant and variable coefficients, the temporally blocked Jacobi smoother, and iterative solvers.
+**/
+
+// small tiles, so that the tiling is exercised with small grids:
+#define VIENNACL_STENCIL_TILE_SIZE   64
+#define VIENNACL_STENCIL_TILE_PLANES 4
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/stencil_operator.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+
+#include "check.hpp"
+
+namespace vhb = viennacl::linalg::host_based;
+
+double relative_difference(viennacl::vector<double> const & x, viennacl::vector<double> const & y)
+{
+  return viennacl::linalg::norm_2(x - y) / viennacl::linalg::norm_2(y);
+}
+
+/** @brief Sets smoothly varying coefficients for all stencil points, with a dominant center. The operator is nonsymmetric unless 'symmetric' is set. */
+void set_variable_coefficients(viennacl::stencil_operator<double> & A, bool symmetric)
+{
+  std::vector<double> values(A.size1());
+  for (std::size_t s = 0; s < A.num_points(); ++s)
+  {
+    int di = A.offset(s, 0), dj = A.offset(s, 1), dk = A.offset(s, 2);
+    bool center = (di == 0 && dj == 0 && dk == 0);
+    for (std::size_t p = 0; p < A.size1(); ++p)
+    {
+      double variation = symmetric ? 0.0 : 0.2 * std::sin(0.3 * double(p) + double(s));
+      values[p] = center ? double(A.num_points()) + 0.5 * std::cos(0.1 * double(p)) : -1.0 + variation;
+    }
+    A.set_coefficients(di, dj, dk, &(values[0]));
+  }
+}
+
+void test_products(viennacl::stencil_operator<double> const & A, std::string const & name)
+{
+  std::vector< std::map<unsigned int, double> > std_A;
+  viennacl::copy(A, std_A);
+  viennacl::compressed_matrix<double> A_csr(viennacl::traits::context(A.handle()));
+  viennacl::copy(std_A, A_csr);
+  check(A.nnz() == A_csr.nnz(), name + ": number of nonzeros");
+
+  std::size_t N = A.size1();
+  std::vector<double> std_x(N);
+  for (std::size_t i = 0; i < N; ++i)
+    std_x[i] = 1.0 + double(i % 13);
+  viennacl::vector<double> x(N), y(N), y_ref(N);
+  viennacl::copy(std_x, x);
+  y_ref = viennacl::linalg::prod(A_csr, x);
+
+  y = viennacl::linalg::prod(A, x);
+  check(relative_difference(y, y_ref) < 1e-14, name + ": y = A * x");
+
+  y = y_ref;
+  y += viennacl::linalg::prod(A, x);
+  check(relative_difference(y, 2.0 * y_ref) < 1e-14, name + ": y += A * x");
+
+  y = 2.0 * y_ref;
+  y -= viennacl::linalg::prod(A, x);
+  check(relative_difference(y, y_ref) < 1e-14, name + ": y -= A * x");
+
+  y = x;
+  y = viennacl::linalg::prod(A, y);
+  check(relative_difference(y, y_ref) < 1e-14, name + ": x = A * x");
+
+  // strided vectors:
+  viennacl::vector<double> x_large(3 * N + 1), y_large(2 * N + 2);
+  viennacl::vector_slice< viennacl::vector<double> > x_slice(x_large, viennacl::slice(1, 3, N));
+  viennacl::vector_slice< viennacl::vector<double> > y_slice(y_large, viennacl::slice(2, 2, N));
+  x_slice = x;
+  viennacl::linalg::prod_impl(A, x_slice, 1.0, y_slice, 0.0);
+  y = y_slice;
+  check(relative_difference(y, y_ref) < 1e-14, name + ": y = A * x for strided vectors");
+}
+
+void test_smoother(viennacl::stencil_operator<double> const & A, unsigned int iterations, std::string const & name)
+{
+  std::vector< std::map<unsigned int, double> > std_A;
+  viennacl::copy(A, std_A);
+  viennacl::compressed_matrix<double> A_csr;
+  viennacl::copy(std_A, A_csr);
+
+  std::size_t N = A.size1();
+  std::vector<double> std_diag;
+  A.diagonal(std_diag);
+  viennacl::vector<double> diag(N), rhs(N), x(N), x_backup(N), x_ref(N), residual(N);
+  viennacl::copy(std_diag, diag);
+  std::vector<double> std_x(N), std_rhs(N);
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    std_x[i]   = std::sin(0.37 * double(i));
+    std_rhs[i] = 1.0 + double(i % 7);
+  }
+  viennacl::copy(std_x, x);
+  viennacl::copy(std_rhs, rhs);
+
+  x_ref = x;
+  double weight = 0.8;
+  for (unsigned int it = 0; it < iterations; ++it)
+  {
+    residual = viennacl::linalg::prod(A_csr, x_ref);
+    residual = rhs - residual;
+    x_ref += weight * viennacl::linalg::element_div(residual, diag);
+  }
+
+  viennacl::linalg::smooth_jacobi(iterations, A, x, x_backup, rhs, weight);
+  check(relative_difference(x, x_ref) < 1e-13, name);
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  //
+  // The 5-point stencil is the matrix of generate_fdm_laplace()
+  //
+  {
+    viennacl::stencil_operator<double> A(viennacl::STENCIL_5_POINT_2D, 21, 17);
+    viennacl::compressed_matrix<double> A_fdm;
+    viennacl::tools::generate_fdm_laplace(A_fdm, 21, 17);
+    viennacl::vector<double> x = viennacl::scalar_vector<double>(A.size1(), 1.0);
+    viennacl::vector<double> y_fdm = viennacl::linalg::prod(A_fdm, x);
+    viennacl::vector<double> y = viennacl::linalg::prod(A, x);
+    check(viennacl::linalg::norm_2(y - y_fdm) <= 0, "5-point stencil matches generate_fdm_laplace()");
+  }
+
+  //
+  // Products with constant and variable coefficients, also with threads
+  //
+  viennacl::stencil_operator<double> A_5(viennacl::STENCIL_5_POINT_2D, 37, 23);
+  viennacl::stencil_operator<double> A_7(viennacl::STENCIL_7_POINT_3D, 13, 11, 9);
+  viennacl::stencil_operator<double> A_27(viennacl::STENCIL_27_POINT_3D, 12, 10, 9);
+  viennacl::stencil_operator<double> A_thin(viennacl::STENCIL_27_POINT_3D, 1, 5, 3);
+
+  A_7.set_coefficient(1, 0, 0, -1.5);
+  A_7.set_coefficient(0, 0, -1, -0.5);
+
+  test_products(A_5,    "5-point stencil");
+  test_products(A_7,    "7-point stencil");
+  test_products(A_27,   "27-point stencil");
+  test_products(A_thin, "27-point stencil on a grid with a single point in x-direction");
+
+  set_variable_coefficients(A_5, false);
+  set_variable_coefficients(A_7, false);
+  set_variable_coefficients(A_27, false);
+  A_27.set_coefficient(-1, 1, 1, 0.25);
+  check(A_5.variable_coefficients() && A_7.variable_coefficients() && A_27.variable_coefficients(), "switch to variable coefficients");
+
+  test_products(A_5,  "5-point stencil with variable coefficients");
+  test_products(A_7,  "7-point stencil with variable coefficients");
+  vhb::set_openmp_min_size(vhb::openmp_vector_kernels, 0);
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 3);
+  test_products(A_27, "27-point stencil with variable coefficients and threads");
+
+  //
+  // Temporally blocked Jacobi smoother, even and odd number of iterations, with and without threads
+  //
+  test_smoother(A_5,  4, "Jacobi smoother, 5-point stencil, 4 iterations with threads");
+  test_smoother(A_27, 3, "Jacobi smoother, 27-point stencil, 3 iterations with threads");
+  vhb::set_openmp_num_threads(vhb::openmp_vector_kernels, 1);
+  test_smoother(A_7,  5, "Jacobi smoother, 7-point stencil, 5 iterations");
+  test_smoother(A_7,  1, "Jacobi smoother, 7-point stencil, 1 iteration");
+
+  //
+  // Iterative solvers
+  //
+  viennacl::stencil_operator<double> A_sym(viennacl::STENCIL_7_POINT_3D, 15, 12, 10);
+  set_variable_coefficients(A_sym, true);
+  std::vector< std::map<unsigned int, double> > std_A;
+  viennacl::compressed_matrix<double> A_sym_csr, A_7_csr;
+  viennacl::copy(A_sym, std_A);
+  viennacl::copy(std_A, A_sym_csr);
+  viennacl::copy(A_7, std_A);
+  viennacl::copy(std_A, A_7_csr);
+
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(A_sym.size1(), 1.0);
+  viennacl::vector<double> result, result_ref;
+
+  viennacl::linalg::cg_tag cg_tag(1e-12, 1000);
+  result_ref = viennacl::linalg::solve(A_sym_csr, rhs, cg_tag);
+  result     = viennacl::linalg::solve(A_sym, rhs, cg_tag);
+  check(relative_difference(result, result_ref) < 1e-8, "CG");
+
+  viennacl::linalg::jacobi_precond< viennacl::stencil_operator<double> > jacobi(A_sym, viennacl::linalg::jacobi_tag());
+  result = viennacl::linalg::solve(A_sym, rhs, cg_tag, jacobi);
+  check(relative_difference(result, result_ref) < 1e-8, "CG with Jacobi preconditioner");
+
+  viennacl::vector<double> rhs_7 = viennacl::scalar_vector<double>(A_7.size1(), 1.0);
+  viennacl::vector<double> result_7, result_7_ref;
+  result_7_ref = viennacl::linalg::solve(A_7_csr, rhs_7, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  result_7     = viennacl::linalg::solve(A_7, rhs_7, viennacl::linalg::bicgstab_tag(1e-12, 1000));
+  check(relative_difference(result_7, result_7_ref) < 1e-8, "BiCGStab");
+
+  result_7 = viennacl::linalg::solve(A_7, rhs_7, viennacl::linalg::gmres_tag(1e-12, 1000, 30));
+  check(relative_difference(result_7, result_7_ref) < 1e-8, "GMRES");
+
+  viennacl::linalg::gmres_tag fgmres_tag(1e-12, 1000, 30);
+  fgmres_tag.flexible(true);
+  viennacl::linalg::jacobi_precond< viennacl::stencil_operator<double> > jacobi_7(A_7, viennacl::linalg::jacobi_tag());
+  result_7 = viennacl::linalg::solve(A_7, rhs_7, fgmres_tag, jacobi_7);
+  check(relative_difference(result_7, result_7_ref) < 1e-8, "flexible GMRES with Jacobi preconditioner");
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** \file tests/src/thick_restart_lanczos.cpp  Tests the thick-restart Lanczos method for extremal and (in shift-invert mode) interior eigenvalues of the 2D Laplacian.
+*   \test Tests the thick-restart Lanczos method for extremal and (in shift-invert mode) interior eigenvalues of the 2D Laplacian.
+**/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/thick_restart_lanczos.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+
+#include "check.hpp"
+
+/** @brief Returns the exact eigenvalues of the 5-point Laplacian on an nx x ny grid */
+std::vector<double> laplace_eigenvalues(std::size_t nx, std::size_t ny)
+{
+  double pi = 3.1415926535897932384626433832795;
+  std::vector<double> eigenvalues;
+  for (std::size_t i = 1; i <= nx; ++i)
+    for (std::size_t j = 1; j <= ny; ++j)
+      eigenvalues.push_back(4.0 - 2.0 * std::cos(pi * double(i) / double(nx + 1)) - 2.0 * std::cos(pi * double(j) / double(ny + 1)));
+  return eigenvalues;
+}
+
+struct distance_to
+{
+  distance_to(double s) : shift(s) {}
+  bool operator()(double a, double b) const { return std::fabs(a - shift) < std::fabs(b - shift); }
+  double shift;
+};
+
+/** @brief Checks the eigenvalues against the reference values (as sets) and the residuals of the eigenpairs */
+template<typename MatrixT>
+void check_eigenpairs(MatrixT const & A, viennacl::matrix<double> const & eigenvectors,
+                      std::vector<double> eigenvalues, std::vector<double> reference, double tolerance, std::string const & name)
+{
+  check(eigenvalues.size() == reference.size(), name + ": number of eigenvalues");
+
+  // eigenpair residuals ||A x - lambda x|| / ||x||
+  double residual = 0;
+  for (std::size_t i = 0; i < eigenvalues.size(); ++i)
+  {
+    viennacl::vector<double> x(A.size1());
+    x = viennacl::column(eigenvectors, static_cast<unsigned int>(i));
+    viennacl::vector<double> Ax = viennacl::linalg::prod(A, x);
+    Ax -= eigenvalues[i] * x;
+    residual = std::max(residual, viennacl::linalg::norm_2(Ax) / viennacl::linalg::norm_2(x));
+  }
+  check(residual < tolerance, name + ": residuals");
+
+  std::sort(eigenvalues.begin(), eigenvalues.end());
+  std::sort(reference.begin(), reference.end());
+  double error = 0;
+  for (std::size_t i = 0; i < eigenvalues.size(); ++i)
+    error = std::max(error, std::fabs(eigenvalues[i] - reference[i]));
+  check(error < tolerance, name + ": eigenvalues");
+}
+
+int main()
+{
+  std::cout << "*" << std::endl;
+  std::cout << "* Test started!" << std::endl;
+  std::cout << "*" << std::endl;
+
+  std::size_t nx = 23, ny = 17;
+  viennacl::compressed_matrix<double> A;
+  viennacl::tools::generate_fdm_laplace(A, nx, ny);
+
+  std::vector<double> exact = laplace_eigenvalues(nx, ny);
+  std::sort(exact.begin(), exact.end());
+
+  //
+  // Largest and smallest eigenvalues, with a Krylov basis much smaller than needed by the unrestarted method
+  //
+  {
+    viennacl::linalg::thick_restart_lanczos_tag tag(6, 20, 1e-10);
+    viennacl::matrix<double> eigenvectors(A.size1(), 6);
+
+    std::vector<double> eigenvalues = viennacl::linalg::eig(A, eigenvectors, tag);
+    check(tag.num_converged() == 6, "largest: converged");
+    check(eigenvalues[0] >= eigenvalues[5], "largest: ordering");
+    check_eigenpairs(A, eigenvectors, eigenvalues, std::vector<double>(exact.end() - 6, exact.end()), 1e-8, "largest");
+    std::cout << "  restarts: " << tag.restarts() << std::endl;
+
+    tag.which(viennacl::linalg::thick_restart_lanczos_tag::smallest_eigenvalues);
+    tag.max_restarts(2000);
+    eigenvalues = viennacl::linalg::eig(A, eigenvectors, tag);
+    check(tag.num_converged() == 6, "smallest: converged");
+    check(eigenvalues[0] <= eigenvalues[5], "smallest: ordering");
+    check_eigenpairs(A, eigenvectors, eigenvalues, std::vector<double>(exact.begin(), exact.begin() + 6), 1e-8, "smallest");
+    std::cout << "  restarts: " << tag.restarts() << std::endl;
+  }
+
+  //
+  // Shift-invert mode: smallest eigenvalues with CG, interior eigenvalues with GMRES
+  //
+  {
+    viennacl::linalg::thick_restart_lanczos_tag tag(5, 16, 1e-10);
+    viennacl::matrix<double> eigenvectors(A.size1(), 5);
+
+    tag.shift(0.0);
+    std::vector<double> eigenvalues = viennacl::linalg::eig(A, eigenvectors, tag, viennacl::linalg::cg_tag(1e-14, 2000));
+    check(tag.num_converged() == 5, "shift-invert, shift 0: converged");
+    check_eigenpairs(A, eigenvectors, eigenvalues, std::vector<double>(exact.begin(), exact.begin() + 5), 1e-8, "shift-invert, shift 0");
+    std::cout << "  restarts: " << tag.restarts() << std::endl;
+
+    // interior eigenvalues on a coarser grid (simple spectrum, since 11 and 7 are coprime): the shifted system is indefinite,
+    // so GMRES is used without restarts to obtain accurate solves
+    viennacl::compressed_matrix<double> A_coarse;
+    viennacl::tools::generate_fdm_laplace(A_coarse, 10, 6);
+    double shift = 3.3;
+    std::vector<double> interior = laplace_eigenvalues(10, 6);
+    std::sort(interior.begin(), interior.end(), distance_to(shift));
+    interior.resize(5);
+
+    tag.shift(shift);
+    viennacl::matrix<double> eigenvectors_coarse(A_coarse.size1(), 5);
+    viennacl::linalg::jacobi_precond<viennacl::compressed_matrix<double> > precond(A_coarse, viennacl::linalg::jacobi_tag());
+    eigenvalues = viennacl::linalg::eig(A_coarse, eigenvectors_coarse, tag, viennacl::linalg::gmres_tag(1e-13, 300, 60), precond);
+    check(tag.num_converged() == 5, "shift-invert, interior: converged");
+    check(std::fabs(eigenvalues[0] - shift) <= std::fabs(eigenvalues[4] - shift), "shift-invert, interior: ordering");
+    check_eigenpairs(A_coarse, eigenvectors_coarse, eigenvalues, interior, 1e-6, "shift-invert, interior");
+    std::cout << "  restarts: " << tag.restarts() << std::endl;
+  }
+
+  //
+  // Dense matrix with known spectrum 1, 2, ..., n in a rotated basis
+  //
+  {
+    std::size_t n = 120;
+    std::vector<std::vector<double> > A_host(n, std::vector<double>(n, 0.0));
+    double pi = 3.1415926535897932384626433832795;
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        for (std::size_t r = 0; r < n; ++r)
+        {
+          double q_ir = std::sqrt(2.0 / double(n + 1)) * std::sin(pi * double((i + 1) * (r + 1)) / double(n + 1));
+          double q_jr = std::sqrt(2.0 / double(n + 1)) * std::sin(pi * double((j + 1) * (r + 1)) / double(n + 1));
+          A_host[i][j] += double(r + 1) * q_ir * q_jr;
+        }
+    viennacl::matrix<double> A_dense(n, n);
+    viennacl::copy(A_host, A_dense);
+
+    viennacl::linalg::thick_restart_lanczos_tag tag(4, 12, 1e-10);
+    viennacl::matrix<double> eigenvectors(n, 4);
+    std::vector<double> eigenvalues = viennacl::linalg::eig(A_dense, eigenvectors, tag);
+    std::vector<double> reference(4);
+    for (std::size_t i = 0; i < 4; ++i)
+      reference[i] = double(n - i);
+    check_eigenpairs(A_dense, eigenvectors, eigenvalues, reference, 1e-8, "dense matrix");
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,444 @@
+#ifndef VIENNACL_AUTO_SPARSE_MATRIX_HPP_
+#define VIENNACL_AUTO_SPARSE_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/auto_sparse_matrix.hpp
+    @brief Implementation of the auto_sparse_matrix class, which stores a sparse matrix in the format with the fastest predicted (or measured) matrix-vector product.
+*/
+
+#include <limits>
+#include <map>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/compressed_compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/sliced_ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/tools/adapter.hpp"
+#include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/tools/timer.hpp"
+#include "viennacl/tools/sparse_format_analyzer.hpp"
+
+/** @brief Only formats with a predicted time within this factor of the best prediction are considered in trial runs */
+#ifndef VIENNACL_AUTO_SPARSE_TRIAL_TOLERANCE
+  #define VIENNACL_AUTO_SPARSE_TRIAL_TOLERANCE 2.0
+#endif
+
+namespace viennacl
+{
+
+template<typename NumericT>
+class auto_sparse_matrix;
+
+namespace linalg
+{
+  template<typename NumericT>
+  void prod_impl(auto_sparse_matrix<NumericT> const & A,
+                 viennacl::vector_base<NumericT> const & x,
+                 NumericT alpha,
+                 viennacl::vector_base<NumericT> & result,
+                 NumericT beta);
+}
+
+/** @brief A sparse matrix which selects its storage format automatically.
+*
+* When the matrix is set, its row-length statistics are computed and the sparse matrix-vector product time of each format is predicted using a viennacl::tools::sparse_performance_model.
+* If trial runs are requested, the most promising formats are additionally built and timed on the actual device, and the fastest one is kept.
+* Only the selected format is kept in memory. The matrix can be used in matrix-vector products and thus in the iterative solvers.
+*
+* @tparam NumericT    Floating point type (either float or double, checked at compile time)
+*/
+template<typename NumericT>
+class auto_sparse_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                            handle_type;
+  typedef vcl_size_t                                                               size_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>   value_type;
+
+  /** @brief Creates an empty matrix.
+  *
+  * @param ctx          The context in which the matrix is created
+  * @param trial_runs   Number of timed matrix-vector products per candidate format. If zero, the format is selected based on the performance model only.
+  */
+  explicit auto_sparse_matrix(viennacl::context ctx = viennacl::context(), unsigned int trial_runs = 0)
+    : ctx_(ctx), model_(ctx.memory_type()), trial_runs_(trial_runs), format_(viennacl::tools::SPARSE_FORMAT_CSR), best_format_(viennacl::tools::SPARSE_FORMAT_CSR)
+  {
+    for (int i = 0; i < viennacl::tools::SPARSE_FORMAT_COUNT; ++i)
+      measured_time_[i] = -1;
+    reset_all();
+  }
+
+  /** @brief Sets the matrix and selects its format.
+  *
+  * @param cpu_matrix   The sparse matrix in the STL format
+  * @param cols         Number of columns. If zero, the largest column index plus one is used.
+  */
+  void set(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, vcl_size_t cols = 0)
+  {
+    stats_ = viennacl::tools::analyze_sparse_matrix(cpu_matrix, cols, partitions());
+    for (int i = 0; i < viennacl::tools::SPARSE_FORMAT_COUNT; ++i)
+      measured_time_[i] = -1;
+
+    reset_all();
+
+    viennacl::tools::sparse_format predicted = model_.best_format(stats_, sizeof(NumericT));
+    if (trial_runs_ == 0)
+    {
+      build(cpu_matrix, predicted);
+      return;
+    }
+
+    // time the most promising candidates and keep the fastest:
+    double best_prediction = predicted_time(predicted);
+    double best_time = std::numeric_limits<double>::max();
+    bool   has_best  = false;
+    for (int i = 0; i < viennacl::tools::SPARSE_FORMAT_COUNT; ++i)
+    {
+      viennacl::tools::sparse_format f = static_cast<viennacl::tools::sparse_format>(i);
+      if (!is_candidate(f) || predicted_time(f) > VIENNACL_AUTO_SPARSE_TRIAL_TOLERANCE * best_prediction)
+        continue;
+
+      build(cpu_matrix, f);
+      measured_time_[f] = time_spmv();
+      if (measured_time_[f] < best_time)
+      {
+        if (has_best)
+          reset(best_format_);
+        best_format_ = f;
+        best_time = measured_time_[f];
+        has_best = true;
+      }
+      else
+        reset(f);
+    }
+    format_ = best_format_;
+  }
+
+  /** @brief Sets the matrix using the given format, bypassing the automatic selection */
+  void set(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, viennacl::tools::sparse_format f, vcl_size_t cols = 0)
+  {
+    stats_ = viennacl::tools::analyze_sparse_matrix(cpu_matrix, cols, partitions());
+    for (int i = 0; i < viennacl::tools::SPARSE_FORMAT_COUNT; ++i)
+      measured_time_[i] = -1;
+    reset_all();
+    build(cpu_matrix, f);
+  }
+
+  /** @brief Returns the selected format */
+  viennacl::tools::sparse_format format() const { return format_; }
+
+  /** @brief Returns the row-length statistics of the matrix */
+  viennacl::tools::sparse_matrix_statistics const & statistics() const { return stats_; }
+
+  /** @brief Returns the performance model. Its parameters can be adjusted (or calibrated) before the matrix is set. */
+  viennacl::tools::sparse_performance_model       & model()       { return model_; }
+  viennacl::tools::sparse_performance_model const & model() const { return model_; }
+
+  /** @brief Returns the predicted time of a matrix-vector product in the given format */
+  double predicted_time(viennacl::tools::sparse_format f) const { return model_.predict_spmv_time(stats_, f, sizeof(NumericT)); }
+
+  /** @brief Returns the measured time of a matrix-vector product in the given format, or a negative value if the format was not part of the trial runs */
+  double measured_time(viennacl::tools::sparse_format f) const { return measured_time_[f]; }
+
+  /** @brief Number of timed matrix-vector products per candidate format (zero for model-based selection only) */
+  unsigned int trial_runs() const { return trial_runs_; }
+  void trial_runs(unsigned int num) { trial_runs_ = num; }
+
+  vcl_size_t size1() const { return stats_.rows; }
+  vcl_size_t size2() const { return stats_.cols; }
+  vcl_size_t nnz()   const { return stats_.nnz; }
+
+  /** @brief Returns the handle to the values of the matrix in the selected format */
+  const handle_type & handle() const
+  {
+    switch (format_)
+    {
+    case viennacl::tools::SPARSE_FORMAT_COO:            return coo_->handle();
+    case viennacl::tools::SPARSE_FORMAT_ELL:            return ell_->handle();
+    case viennacl::tools::SPARSE_FORMAT_SLICED_ELL:     return sliced_ell_->handle();
+    case viennacl::tools::SPARSE_FORMAT_HYB:            return hyb_->handle();
+    case viennacl::tools::SPARSE_FORMAT_COMPRESSED_CSR: return compressed_csr_->handle();
+    default:                                            return csr_->handle();
+    }
+  }
+
+  /** @brief Access to the matrix in the respective format. Only the one of the selected format() is non-empty. */
+  viennacl::compressed_matrix<NumericT>            const & csr()            const { return *csr_; }
+  viennacl::coordinate_matrix<NumericT>            const & coo()            const { return *coo_; }
+  viennacl::ell_matrix<NumericT>                   const & ell()            const { return *ell_; }
+  viennacl::sliced_ell_matrix<NumericT>            const & sliced_ell()     const { return *sliced_ell_; }
+  viennacl::hyb_matrix<NumericT>                   const & hyb()            const { return *hyb_; }
+  viennacl::compressed_compressed_matrix<NumericT> const & compressed_csr() const { return *compressed_csr_; }
+
+private:
+  vcl_size_t partitions() const
+  {
+    return (ctx_.memory_type() == viennacl::MAIN_MEMORY) ? viennacl::tools::detail::sparse_analyzer_default_partitions() : 1;
+  }
+
+  bool is_candidate(viennacl::tools::sparse_format f) const
+  {
+    return f != viennacl::tools::SPARSE_FORMAT_COMPRESSED_CSR || stats_.rows == stats_.cols;
+  }
+
+  void reset(viennacl::tools::sparse_format f)
+  {
+    switch (f)
+    {
+    case viennacl::tools::SPARSE_FORMAT_CSR:            csr_.reset(new viennacl::compressed_matrix<NumericT>(ctx_)); break;
+    case viennacl::tools::SPARSE_FORMAT_COO:            coo_.reset(new viennacl::coordinate_matrix<NumericT>(ctx_)); break;
+    case viennacl::tools::SPARSE_FORMAT_ELL:            ell_.reset(new viennacl::ell_matrix<NumericT>(ctx_)); break;
+    case viennacl::tools::SPARSE_FORMAT_SLICED_ELL:     sliced_ell_.reset(new viennacl::sliced_ell_matrix<NumericT>(ctx_)); break;
+    case viennacl::tools::SPARSE_FORMAT_HYB:            hyb_.reset(new viennacl::hyb_matrix<NumericT>(ctx_)); break;
+    case viennacl::tools::SPARSE_FORMAT_COMPRESSED_CSR: compressed_csr_.reset(new viennacl::compressed_compressed_matrix<NumericT>(ctx_)); break;
+    default: break;
+    }
+  }
+
+  void reset_all()
+  {
+    for (int i = 0; i < viennacl::tools::SPARSE_FORMAT_COUNT; ++i)
+      reset(static_cast<viennacl::tools::sparse_format>(i));
+  }
+
+  void build(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, viennacl::tools::sparse_format f)
+  {
+    if (!is_candidate(f))
+      throw memory_exception("compressed_compressed_matrix requires a square matrix");
+
+    reset(f);
+    viennacl::tools::const_sparse_matrix_adapter<NumericT> adapted(cpu_matrix, stats_.rows, stats_.cols);
+    switch (f)
+    {
+    case viennacl::tools::SPARSE_FORMAT_CSR:            viennacl::copy(adapted, *csr_);            break;
+    case viennacl::tools::SPARSE_FORMAT_COO:            viennacl::copy(adapted, *coo_);            break;
+    case viennacl::tools::SPARSE_FORMAT_ELL:            viennacl::copy(adapted, *ell_);            break;
+    case viennacl::tools::SPARSE_FORMAT_SLICED_ELL:     viennacl::copy(adapted, *sliced_ell_);     break;
+    case viennacl::tools::SPARSE_FORMAT_HYB:            viennacl::copy(adapted, *hyb_);            break;
+    case viennacl::tools::SPARSE_FORMAT_COMPRESSED_CSR: viennacl::copy(cpu_matrix, *compressed_csr_); break;
+    default: break;
+    }
+    format_ = f;
+  }
+
+  double time_spmv()
+  {
+    viennacl::vector<NumericT> x = viennacl::scalar_vector<NumericT>(stats_.cols, NumericT(1), ctx_);
+    viennacl::vector<NumericT> y(stats_.rows, ctx_);
+
+    viennacl::linalg::prod_impl(*this, x, NumericT(1), y, NumericT(0));  // warm-up, includes kernel compilation
+    viennacl::backend::finish();
+
+    viennacl::tools::timer timer;
+    timer.start();
+    for (unsigned int i = 0; i < trial_runs_; ++i)
+      viennacl::linalg::prod_impl(*this, x, NumericT(1), y, NumericT(0));
+    viennacl::backend::finish();
+    return timer.get() / double(trial_runs_);
+  }
+
+  viennacl::context                          ctx_;
+  viennacl::tools::sparse_performance_model  model_;
+  viennacl::tools::sparse_matrix_statistics  stats_;
+  unsigned int                               trial_runs_;
+  viennacl::tools::sparse_format             format_;
+  viennacl::tools::sparse_format             best_format_;
+  double                                     measured_time_[viennacl::tools::SPARSE_FORMAT_COUNT];
+
+  viennacl::tools::shared_ptr< viennacl::compressed_matrix<NumericT> >             csr_;
+  viennacl::tools::shared_ptr< viennacl::coordinate_matrix<NumericT> >             coo_;
+  viennacl::tools::shared_ptr< viennacl::ell_matrix<NumericT> >                    ell_;
+  viennacl::tools::shared_ptr< viennacl::sliced_ell_matrix<NumericT> >             sliced_ell_;
+  viennacl::tools::shared_ptr< viennacl::hyb_matrix<NumericT> >                    hyb_;
+  viennacl::tools::shared_ptr< viennacl::compressed_compressed_matrix<NumericT> >  compressed_csr_;
+};
+
+
+//
+// host to device:
+//
+
+/** @brief Copies a sparse matrix in the std::vector< std::map < > > format to an auto_sparse_matrix, which selects the format. */
+template<typename NumericT>
+void copy(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix,
+          auto_sparse_matrix<NumericT> & gpu_matrix)
+{
+  gpu_matrix.set(cpu_matrix);
+}
+
+/** @brief Copies a compressed_matrix to an auto_sparse_matrix, which selects the format. The matrix is converted on the host. */
+template<typename NumericT, unsigned int AlignmentV>
+void copy(compressed_matrix<NumericT, AlignmentV> const & csr_matrix,
+          auto_sparse_matrix<NumericT> & gpu_matrix)
+{
+  std::vector< std::map<unsigned int, NumericT> > cpu_matrix(csr_matrix.size1());
+  viennacl::copy(csr_matrix, cpu_matrix);
+  gpu_matrix.set(cpu_matrix, csr_matrix.size2());
+}
+
+
+namespace linalg
+{
+
+/** @brief Carries out the matrix-vector product result = alpha * prod(A, x) + beta * result using the format selected by the auto_sparse_matrix */
+template<typename NumericT>
+void prod_impl(auto_sparse_matrix<NumericT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               NumericT alpha,
+               viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  switch (A.format())
+  {
+  case viennacl::tools::SPARSE_FORMAT_CSR:            viennacl::linalg::prod_impl(A.csr(),            x, alpha, result, beta); break;
+  case viennacl::tools::SPARSE_FORMAT_COO:            viennacl::linalg::prod_impl(A.coo(),            x, alpha, result, beta); break;
+  case viennacl::tools::SPARSE_FORMAT_ELL:            viennacl::linalg::prod_impl(A.ell(),            x, alpha, result, beta); break;
+  case viennacl::tools::SPARSE_FORMAT_SLICED_ELL:     viennacl::linalg::prod_impl(A.sliced_ell(),     x, alpha, result, beta); break;
+  case viennacl::tools::SPARSE_FORMAT_HYB:            viennacl::linalg::prod_impl(A.hyb(),            x, alpha, result, beta); break;
+  case viennacl::tools::SPARSE_FORMAT_COMPRESSED_CSR: viennacl::linalg::prod_impl(A.compressed_csr(), x, alpha, result, beta); break;
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Carries out the matrix-vector product result = prod(A, x) */
+template<typename NumericT>
+void prod_impl(auto_sparse_matrix<NumericT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT> & result)
+{
+  prod_impl(A, x, NumericT(1), result, NumericT(0));
+}
+
+} //namespace linalg
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs += temp_result;
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const auto_sparse_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::vector<T> temp_result(lhs);
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, temp_result);
+      lhs -= temp_result;
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
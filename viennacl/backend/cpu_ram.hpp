@@ -22,15 +22,34 @@
     @brief Implementations for the OpenCL backend functionality
 */
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <vector>
 #ifdef VIENNACL_WITH_AVX2
 #include <stdlib.h>
 #endif
+#ifdef VIENNACL_WITH_NUMA
+#include <numa.h>
+#endif
 
 #include "viennacl/forwards.h"
 #include "viennacl/tools/shared_ptr.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Granularity (in bytes) at which buffers are distributed over NUMA nodes */
+#ifndef VIENNACL_NUMA_PAGE_SIZE
+  #define VIENNACL_NUMA_PAGE_SIZE 4096
+#endif
+
+/** @brief Minimum buffer size (in bytes) for which the pages are placed by parallel initialization. Matches the default OpenMP threshold of the vector kernels for double precision. */
+#ifndef VIENNACL_NUMA_MIN_SIZE
+  #define VIENNACL_NUMA_MIN_SIZE 40000
+#endif
+
 namespace viennacl
 {
 namespace backend
@@ -62,37 +81,176 @@ namespace detail
 #endif
   };
 
+
+  /** @brief Allocates an uninitialized buffer */
+  inline char * allocate(vcl_size_t size_in_bytes)
+  {
+#ifdef VIENNACL_WITH_AVX2
+    // Note: aligned_alloc not available on all compilers. Consider platform-specific alternatives such as posix_memalign()
+    return reinterpret_cast<char*>(aligned_alloc(32, size_in_bytes));
+#else
+    return new char[size_in_bytes];
+#endif
+  }
+
+  /** @brief Copies 'size_in_bytes' bytes from 'src' to 'dst', or sets them to zero if 'src' is NULL */
+  inline void fill_bytes(char * dst, const char * src, vcl_size_t size_in_bytes)
+  {
+    if (src)
+      std::memcpy(dst, src, size_in_bytes);
+    else
+      std::memset(dst, 0, size_in_bytes);
+  }
+
+  /** @brief Returns true if a buffer is large enough for the host kernels to process it in parallel, in which case its placement on NUMA nodes matters */
+  inline bool numa_parallel_init(vcl_size_t size_in_bytes)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    return size_in_bytes > VIENNACL_NUMA_MIN_SIZE && omp_get_max_threads() > 1;
+#else
+    (void)size_in_bytes;
+    return false;
+#endif
+  }
+
+  /** @brief Returns true if the pages of a buffer are placed by the threads writing to them first, so that a buffer without data needs to be written (with zeros) at creation */
+  inline bool numa_placement_by_touch(numa_policies policy)
+  {
+#ifdef VIENNACL_WITH_NUMA
+    return policy == NUMA_FIRST_TOUCH || (policy == NUMA_INTERLEAVE && numa_available() < 0);
+#else
+    return policy != NUMA_BIND;
+#endif
+  }
+
+  /** @brief Sets the memory policy of the pages of a buffer which have not been touched yet. Only has an effect if ViennaCL is built with VIENNACL_WITH_NUMA (requires linking with libnuma). */
+  inline void numa_apply_policy(char * ptr, vcl_size_t size_in_bytes, numa_policies policy, int node)
+  {
+#ifdef VIENNACL_WITH_NUMA
+    if (numa_available() < 0)
+      return;
+
+    // policies can only be set for whole pages:
+    vcl_size_t page_size = static_cast<vcl_size_t>(numa_pagesize());
+    vcl_size_t begin = (reinterpret_cast<vcl_size_t>(ptr) + page_size - 1) / page_size * page_size;
+    vcl_size_t end   = (reinterpret_cast<vcl_size_t>(ptr) + size_in_bytes) / page_size * page_size;
+    if (end <= begin)
+      return;
+
+    if (policy == NUMA_INTERLEAVE)
+      numa_interleave_memory(reinterpret_cast<void*>(begin), end - begin, numa_all_nodes_ptr);
+    else if (policy == NUMA_BIND && node >= 0)
+      numa_tonode_memory(reinterpret_cast<void*>(begin), end - begin, node);
+#else
+    (void)ptr; (void)size_in_bytes; (void)policy; (void)node;
+#endif
+  }
+
+  /** @brief Initializes a new buffer with the data from 'host_ptr' (or zeros if 'host_ptr' is NULL) such that the operating system places its pages according to the policy.
+   *
+   * NUMA_FIRST_TOUCH: Pages are written with the static partitioning (default number of threads) of the parallel loops in the host kernels, so each page ends up on the node of the thread later working on it.
+   * NUMA_INTERLEAVE:  Pages are written round-robin by all threads, which spreads them over the nodes even without libnuma.
+   * NUMA_BIND:        Pages are written by the calling thread (unless libnuma places them on the node given by the context).
+   */
+  inline void numa_initialize(char * ptr, const char * host_ptr, vcl_size_t size_in_bytes, numa_policies policy, int node)
+  {
+    numa_apply_policy(ptr, size_in_bytes, policy, node);
+
+    if (policy == NUMA_BIND || !numa_parallel_init(size_in_bytes))
+    {
+      fill_bytes(ptr, host_ptr, size_in_bytes);
+      return;
+    }
+
+    vcl_size_t page_size = VIENNACL_NUMA_PAGE_SIZE;
+    long num_pages = static_cast<long>((size_in_bytes + page_size - 1) / page_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+    if (policy == NUMA_INTERLEAVE)
+    {
+      #pragma omp parallel for schedule(static, 1)
+      for (long i = 0; i < num_pages; ++i)
+      {
+        vcl_size_t offset = vcl_size_t(i) * page_size;
+        fill_bytes(ptr + offset, host_ptr ? host_ptr + offset : NULL, std::min(page_size, size_in_bytes - offset));
+      }
+      return;
+    }
+
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < num_pages; ++i)
+    {
+      vcl_size_t offset = vcl_size_t(i) * page_size;
+      fill_bytes(ptr + offset, host_ptr ? host_ptr + offset : NULL, std::min(page_size, size_in_bytes - offset));
+    }
+  }
 }
 
 /** @brief Creates an array of the specified size in main RAM. If the second argument is provided, the buffer is initialized with data from that pointer.
+ *
+ * Buffers large enough to be processed in parallel by the host kernels are initialized such that their pages are placed according to the NUMA policy.
+ * Without data, such buffers are written with zeros only if the placement relies on first touch, i.e. for NUMA_FIRST_TOUCH, and for NUMA_INTERLEAVE without libnuma.
+ * Otherwise the buffer is left uninitialized, as are small buffers without data.
  *
  * @param size_in_bytes   Number of bytes to allocate
  * @param host_ptr        Pointer to data which will be copied to the new array. Must point to at least 'size_in_bytes' bytes of data.
+ * @param policy          Placement of the buffer on NUMA systems
+ * @param numa_node       Node used with NUMA_BIND. A negative value refers to the node of the calling thread.
  *
  */
-inline handle_type  memory_create(vcl_size_t size_in_bytes, const void * host_ptr = NULL)
+inline handle_type  memory_create(vcl_size_t size_in_bytes, const void * host_ptr = NULL, numa_policies policy = NUMA_FIRST_TOUCH, int numa_node = -1)
 {
-#ifdef VIENNACL_WITH_AVX2
-  // Note: aligned_alloc not available on all compilers. Consider platform-specific alternatives such as posix_memalign()
-  if (!host_ptr)
-    return handle_type(reinterpret_cast<char*>(aligned_alloc(32, size_in_bytes)), detail::array_deleter<char>());
+  handle_type new_handle(detail::allocate(size_in_bytes), detail::array_deleter<char>());
 
-  handle_type new_handle(reinterpret_cast<char*>(aligned_alloc(32, size_in_bytes)), detail::array_deleter<char>());
-#else
-  if (!host_ptr)
-    return handle_type(new char[size_in_bytes], detail::array_deleter<char>());
+  if (host_ptr)
+    detail::numa_initialize(new_handle.get(), static_cast<const char *>(host_ptr), size_in_bytes, policy, numa_node);
+  else if (detail::numa_parallel_init(size_in_bytes))
+  {
+    if (detail::numa_placement_by_touch(policy))
+      detail::numa_initialize(new_handle.get(), NULL, size_in_bytes, policy, numa_node);
+    else
+      detail::numa_apply_policy(new_handle.get(), size_in_bytes, policy, numa_node);
+  }
 
-  handle_type new_handle(new char[size_in_bytes], detail::array_deleter<char>());
-#endif
+  return new_handle;
+}
 
-  // copy data:
+/** @brief Creates the column index or value array of a CSR matrix in main RAM, initializing the entries of each row by the thread which processes that row in the row-parallel host kernels.
+ *
+ * Falls back to memory_create() for policies other than NUMA_FIRST_TOUCH and for small buffers.
+ *
+ * @param size_in_bytes   Number of bytes to allocate
+ * @param host_ptr        Pointer to data which will be copied to the new array, or NULL for zero initialization
+ * @param row_offsets     CSR row offsets (length rows+1) in units of entries
+ * @param rows            Number of rows
+ * @param element_size    Size of an entry in bytes
+ * @param policy          Placement of the buffer on NUMA systems
+ * @param numa_node       Node used with NUMA_BIND
+ */
+inline handle_type  memory_create_by_rows(vcl_size_t size_in_bytes, const void * host_ptr,
+                                          unsigned int const * row_offsets, vcl_size_t rows, vcl_size_t element_size,
+                                          numa_policies policy = NUMA_FIRST_TOUCH, int numa_node = -1)
+{
+  if (policy != NUMA_FIRST_TOUCH || !detail::numa_parallel_init(size_in_bytes))
+    return memory_create(size_in_bytes, host_ptr, policy, numa_node);
+
+  handle_type new_handle(detail::allocate(size_in_bytes), detail::array_deleter<char>());
   char * raw_ptr = new_handle.get();
   const char * data_ptr = static_cast<const char *>(host_ptr);
+
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
+  #pragma omp parallel for schedule(static)
 #endif
-  for (long i=0; i<long(size_in_bytes); ++i)
-    raw_ptr[i] = data_ptr[i];
+  for (long row = 0; row < static_cast<long>(rows); ++row)
+  {
+    vcl_size_t offset = vcl_size_t(row_offsets[row]) * element_size;
+    detail::fill_bytes(raw_ptr + offset, data_ptr ? data_ptr + offset : NULL, vcl_size_t(row_offsets[row+1] - row_offsets[row]) * element_size);
+  }
+
+  // padding after the last row:
+  vcl_size_t offset = std::min<vcl_size_t>(vcl_size_t(row_offsets[rows]) * element_size, size_in_bytes);
+  detail::fill_bytes(raw_ptr + offset, data_ptr ? data_ptr + offset : NULL, size_in_bytes - offset);
 
   return new_handle;
 }
@@ -93,7 +93,7 @@ public:
   typedef viennacl::tools::shared_ptr<char>      cuda_handle_type;
 
   /** @brief Default CTOR. No memory is allocated */
-  mem_handle() : active_handle_(MEMORY_NOT_INITIALIZED), size_in_bytes_(0) {}
+  mem_handle() : active_handle_(MEMORY_NOT_INITIALIZED), size_in_bytes_(0), numa_policy_(NUMA_FIRST_TOUCH), numa_node_(-1) {}
 
   /** @brief Returns the handle to a buffer in CPU RAM. NULL is returned if no such buffer has been allocated. */
   ram_handle_type       & ram_handle()       { return ram_handle_; }
@@ -215,6 +215,14 @@ public:
     other.ram_handle_ = ram_handle_;
     ram_handle_ = ram_handle_tmp;
 
+    numa_policies numa_policy_tmp = other.numa_policy_;
+    other.numa_policy_ = numa_policy_;
+    numa_policy_ = numa_policy_tmp;
+
+    int numa_node_tmp = other.numa_node_;
+    other.numa_node_ = numa_node_;
+    numa_node_ = numa_node_tmp;
+
     // swap OpenCL handle:
 #ifdef VIENNACL_WITH_OPENCL
     opencl_handle_.swap(other.opencl_handle_);
@@ -232,6 +240,19 @@ public:
   /** @brief Sets the size of the currently active buffer. Use with care! */
   void        raw_size(vcl_size_t new_size) { size_in_bytes_ = new_size; }
 
+  /** @brief Returns the placement policy of the buffer in main memory on NUMA systems */
+  numa_policies numa_policy() const { return numa_policy_; }
+
+  /** @brief Returns the NUMA node of the buffer in main memory if the policy is NUMA_BIND (negative: node of the allocating thread) */
+  int numa_node() const { return numa_node_; }
+
+  /** @brief Sets the placement policy used for subsequent allocations in main memory */
+  void numa_policy(numa_policies policy, int node)
+  {
+    numa_policy_ = policy;
+    numa_node_   = node;
+  }
+
 private:
   memory_types active_handle_;
   ram_handle_type ram_handle_;
@@ -242,6 +263,8 @@ private:
   cuda_handle_type        cuda_handle_;
 #endif
   vcl_size_t size_in_bytes_;
+  numa_policies numa_policy_;
+  int numa_node_;
 };
 
 
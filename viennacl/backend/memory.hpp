@@ -33,6 +33,10 @@
 
 #include "viennacl/backend/cpu_ram.hpp"
 
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+#include "viennacl/linalg/host_based/host_stream.hpp"
+#endif
+
 #ifdef VIENNACL_WITH_OPENCL
 #include "viennacl/backend/opencl.hpp"
 #include "viennacl/ocl/backend.hpp"
@@ -50,7 +54,7 @@ namespace backend
 
 
   // if a user compiles with CUDA, it is reasonable to expect that CUDA should be the default
-  /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) have completed. */
+  /** @brief Synchronizes the execution. finish() will only return after all compute kernels (CUDA, OpenCL) and all operations in host streams have completed. */
   inline void finish()
   {
 #ifdef VIENNACL_WITH_CUDA
@@ -58,6 +62,9 @@ namespace backend
 #endif
 #ifdef VIENNACL_WITH_OPENCL
     viennacl::ocl::get_queue().finish();
+#endif
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    viennacl::linalg::host_based::finish_host_streams();
 #endif
   }
 
@@ -94,7 +101,8 @@ namespace backend
       switch (handle.get_active_handle_id())
       {
       case MAIN_MEMORY:
-        handle.ram_handle() = cpu_ram::memory_create(size_in_bytes, host_ptr);
+        handle.numa_policy(ctx.numa_policy(), ctx.numa_node());
+        handle.ram_handle() = cpu_ram::memory_create(size_in_bytes, host_ptr, ctx.numa_policy(), ctx.numa_node());
         handle.raw_size(size_in_bytes);
         break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -118,6 +126,34 @@ namespace backend
     }
   }
 
+  /** @brief Creates the column index or value array of a CSR matrix.
+  *
+  * Same as memory_create(), except that in main memory the entries of each row are initialized by the thread which processes that row in the row-parallel host kernels (cf. NUMA_FIRST_TOUCH).
+  *
+  * @param handle          The generic wrapper handle for multiple memory domains which will hold the new buffer.
+  * @param size_in_bytes   Number of bytes to allocate
+  * @param ctx             Context in which the buffer is created
+  * @param host_ptr        Pointer to data which will be copied to the new array, or NULL
+  * @param row_offsets     CSR row offsets (length rows+1) in main memory, in units of entries
+  * @param rows            Number of rows
+  * @param element_size    Size of an entry in bytes
+  */
+  inline void memory_create_by_rows(mem_handle & handle, vcl_size_t size_in_bytes, viennacl::context const & ctx, const void * host_ptr,
+                                    unsigned int const * row_offsets, vcl_size_t rows, vcl_size_t element_size)
+  {
+    if (handle.get_active_handle_id() == MEMORY_NOT_INITIALIZED)
+      handle.switch_active_handle_id(ctx.memory_type());
+
+    if (size_in_bytes > 0 && handle.get_active_handle_id() == MAIN_MEMORY)
+    {
+      handle.numa_policy(ctx.numa_policy(), ctx.numa_node());
+      handle.ram_handle() = cpu_ram::memory_create_by_rows(size_in_bytes, host_ptr, row_offsets, rows, element_size, ctx.numa_policy(), ctx.numa_node());
+      handle.raw_size(size_in_bytes);
+    }
+    else
+      memory_create(handle, size_in_bytes, ctx, host_ptr);
+  }
+
   /*
   inline void memory_create(mem_handle & handle, vcl_size_t size_in_bytes, const void * host_ptr = NULL)
   {
@@ -417,7 +453,8 @@ namespace backend
         switch (new_ctx.memory_type())
         {
         case MAIN_MEMORY:
-          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size());
+          handle.numa_policy(new_ctx.numa_policy(), new_ctx.numa_node());
+          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size(), NULL, new_ctx.numa_policy(), new_ctx.numa_node());
           opencl::memory_read(handle.opencl_handle(), 0, handle.raw_size(), handle.ram_handle().get());
           break;
 #ifdef VIENNACL_WITH_CUDA
@@ -441,7 +478,8 @@ namespace backend
         switch (new_ctx.memory_type())
         {
         case MAIN_MEMORY:
-          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size());
+          handle.numa_policy(new_ctx.numa_policy(), new_ctx.numa_node());
+          handle.ram_handle() = cpu_ram::memory_create(handle.raw_size(), NULL, new_ctx.numa_policy(), new_ctx.numa_node());
           cuda::memory_read(handle.cuda_handle(), 0, handle.raw_size(), handle.ram_handle().get());
           break;
 #ifdef VIENNACL_WITH_OPENCL
@@ -0,0 +1,443 @@
+#ifndef VIENNACL_BLOCK_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_BLOCK_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/block_compressed_matrix.hpp
+    @brief Implementation of the block_compressed_matrix class (block compressed sparse row format, BSR) for matrices with small dense blocks.
+*/
+
+#include <vector>
+#include <map>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+
+template<typename NumericT, unsigned int AlignmentV, unsigned int BlockSize>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, block_compressed_matrix<NumericT, BlockSize> & B);
+
+/** @brief Sparse matrix class using the block compressed sparse row format (BSR) with dense blocks of size BlockSize x BlockSize.
+*
+* Systems arising from PDEs with several unknowns per node (e.g. 3 displacements in elasticity, or 5 conserved variables in 3D CFD) consist of small dense blocks.
+* Only a single column index is stored per block, hence the index traffic in sparse matrix-vector products is reduced by a factor of BlockSize^2 compared to compressed_matrix.
+* The blocks are stored row-major and contiguously, their size is known at compile time so that the block kernels are fully unrolled.
+*
+* If the number of rows is not a multiple of BlockSize, the last block row is padded.
+* For square matrices the diagonal blocks are always stored and the diagonal of the padding is set to one, so that block preconditioners remain well-defined.
+*
+* Products are currently only available in main memory.
+*
+* @tparam NumericT    Floating point type (either float or double, checked at compile time)
+* @tparam BlockSize   Number of rows and columns of the dense blocks
+*/
+template<typename NumericT, unsigned int BlockSize>
+class block_compressed_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>     value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  /** @brief Creates an empty matrix in the given context */
+  explicit block_compressed_matrix(viennacl::context ctx = viennacl::context()) : rows_(0), cols_(0), nnz_blocks_(0)
+  {
+    block_rows_.switch_active_handle_id(ctx.memory_type());
+    block_cols_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+
+    block_rows_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    block_cols_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      block_rows_.opencl_handle().context(ctx.opencl_context());
+      block_cols_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+  }
+
+  /** @brief Creates the block matrix from a compressed_matrix, residing in the same context. */
+  template<unsigned int AlignmentV>
+  explicit block_compressed_matrix(viennacl::compressed_matrix<NumericT, AlignmentV> const & A) : rows_(0), cols_(0), nnz_blocks_(0)
+  {
+    viennacl::context ctx = viennacl::traits::context(A);
+    block_rows_.switch_active_handle_id(ctx.memory_type());
+    block_cols_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+
+    block_rows_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    block_cols_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      block_rows_.opencl_handle().context(ctx.opencl_context());
+      block_cols_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+    viennacl::copy(A, *this);
+  }
+
+  /** @brief Sets the block CSR arrays directly.
+  *
+  * @param block_row_ptr   Offsets of the block rows, (rows + BlockSize - 1) / BlockSize + 1 entries
+  * @param block_col_ptr   Block column index of each block, nnz_blocks entries
+  * @param elements        Row-major dense blocks, nnz_blocks * BlockSize * BlockSize entries
+  * @param rows            Number of rows of the matrix (not of block rows)
+  * @param cols            Number of columns of the matrix (not of block columns)
+  * @param nnz_blocks      Number of stored blocks
+  */
+  void set(unsigned int const * block_row_ptr, unsigned int const * block_col_ptr, NumericT const * elements,
+           vcl_size_t rows, vcl_size_t cols, vcl_size_t nnz_blocks)
+  {
+    rows_       = rows;
+    cols_       = cols;
+    nnz_blocks_ = nnz_blocks;
+
+    viennacl::context ctx = viennacl::traits::context(elements_);
+    std::vector<unsigned int> dummy_index(1, 0);
+    std::vector<NumericT>     dummy_element(1, 0);
+    viennacl::backend::memory_create(block_rows_, sizeof(unsigned int) * (block_rows() + 1), ctx, block_row_ptr);
+    viennacl::backend::memory_create(block_cols_, sizeof(unsigned int) * std::max<vcl_size_t>(nnz_blocks, 1), ctx, nnz_blocks ? block_col_ptr : &(dummy_index[0]));
+    viennacl::backend::memory_create(elements_,   sizeof(NumericT) * std::max<vcl_size_t>(nnz_blocks * BlockSize * BlockSize, 1), ctx, nnz_blocks ? elements : &(dummy_element[0]));
+  }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return rows_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return cols_; }
+  /** @brief Returns the number of block rows, i.e. the number of rows divided by BlockSize and rounded up */
+  vcl_size_t block_rows() const { return (rows_ + BlockSize - 1) / BlockSize; }
+  /** @brief Returns the number of block columns, i.e. the number of columns divided by BlockSize and rounded up */
+  vcl_size_t block_cols() const { return (cols_ + BlockSize - 1) / BlockSize; }
+  /** @brief Returns the number of stored blocks */
+  vcl_size_t nnz_blocks() const { return nnz_blocks_; }
+  /** @brief Returns the number of stored entries, including the explicit zeros within the blocks */
+  vcl_size_t nnz() const { return nnz_blocks_ * BlockSize * BlockSize; }
+  /** @brief Returns the block size */
+  static unsigned int block_size() { return BlockSize; }
+
+  /** @brief Returns the OpenCL handle to the block row offsets */
+  const handle_type & handle1() const { return block_rows_; }
+  /** @brief Returns the OpenCL handle to the block column indices */
+  const handle_type & handle2() const { return block_cols_; }
+  /** @brief Returns the OpenCL handle to the row-major dense blocks */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Returns the OpenCL handle to the block row offsets */
+  handle_type & handle1() { return block_rows_; }
+  /** @brief Returns the OpenCL handle to the block column indices */
+  handle_type & handle2() { return block_cols_; }
+  /** @brief Returns the OpenCL handle to the row-major dense blocks */
+  handle_type & handle() { return elements_; }
+
+  /** @brief Switches the memory context of the matrix.
+  *
+  * Allows for e.g. an migration of the full matrix from OpenCL memory to host memory for e.g. computing a preconditioner.
+  */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(block_rows_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(block_cols_, new_ctx);
+    viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up for OpenMP, OpenCL, or CUDA. */
+  viennacl::memory_types memory_context() const
+  {
+    return elements_.get_active_handle_id();
+  }
+
+private:
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t nnz_blocks_;
+  handle_type block_rows_;
+  handle_type block_cols_;
+  handle_type elements_;
+};
+
+
+namespace detail
+{
+  /** @brief Reads the block CSR arrays of a block_compressed_matrix to the host, regardless of the memory it resides in. */
+  template<typename NumericT, unsigned int BlockSize>
+  void read_block_compressed_matrix(block_compressed_matrix<NumericT, BlockSize> const & A,
+                                    std::vector<unsigned int> & block_row_buffer, std::vector<unsigned int> & block_col_buffer, std::vector<NumericT> & elements)
+  {
+    block_row_buffer.resize(A.block_rows() + 1);
+    block_col_buffer.resize(A.nnz_blocks());
+    elements.resize(A.nnz());
+    viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * block_row_buffer.size(), &(block_row_buffer[0]));
+    if (A.nnz_blocks() > 0)
+    {
+      viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * block_col_buffer.size(), &(block_col_buffer[0]));
+      viennacl::backend::memory_read(A.handle(),  0, sizeof(NumericT) * elements.size(), &(elements[0]));
+    }
+  }
+}
+
+
+/** @brief Copies a compressed_matrix to a block_compressed_matrix. All blocks containing at least one entry are stored.
+*
+* The block matrix remains in its memory context. The conversion runs on the host, in parallel if OpenMP is enabled.
+*/
+template<typename NumericT, unsigned int AlignmentV, unsigned int BlockSize>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, block_compressed_matrix<NumericT, BlockSize> & B)
+{
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  std::vector<unsigned int> block_row_buffer, block_col_buffer;
+  std::vector<NumericT> block_elements;
+  viennacl::linalg::host_based::detail::csr_to_bsr<NumericT, BlockSize>(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), A.size1(), A.size2(),
+                                                                        block_row_buffer, block_col_buffer, block_elements);
+
+  B.set(&(block_row_buffer[0]),
+        block_col_buffer.size() ? &(block_col_buffer[0]) : NULL,
+        block_elements.size() ? &(block_elements[0]) : NULL,
+        A.size1(), A.size2(), block_col_buffer.size());
+}
+
+/** @brief Copies a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> > to a block_compressed_matrix.
+*
+* @param cpu_matrix   The sparse matrix on the host
+* @param B            The block matrix
+* @param cols         Number of columns. If zero, the largest column index plus one is used.
+*/
+template<typename NumericT, unsigned int BlockSize>
+void copy(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, block_compressed_matrix<NumericT, BlockSize> & B, vcl_size_t cols = 0)
+{
+  std::vector<unsigned int> row_buffer(cpu_matrix.size() + 1, 0);
+  std::vector<unsigned int> col_buffer;
+  std::vector<NumericT> elements;
+  vcl_size_t max_col = 0;
+  for (vcl_size_t i = 0; i < cpu_matrix.size(); ++i)
+  {
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = cpu_matrix[i].begin(); it != cpu_matrix[i].end(); ++it)
+    {
+      col_buffer.push_back(it->first);
+      elements.push_back(it->second);
+      max_col = std::max<vcl_size_t>(max_col, it->first + 1);
+    }
+    row_buffer[i+1] = static_cast<unsigned int>(col_buffer.size());
+  }
+  if (cols == 0)
+    cols = max_col;
+  col_buffer.push_back(0); // guard against empty buffers
+  elements.push_back(0);
+
+  std::vector<unsigned int> block_row_buffer, block_col_buffer;
+  std::vector<NumericT> block_elements;
+  viennacl::linalg::host_based::detail::csr_to_bsr<NumericT, BlockSize>(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), cpu_matrix.size(), cols,
+                                                                        block_row_buffer, block_col_buffer, block_elements);
+
+  B.set(&(block_row_buffer[0]),
+        block_col_buffer.size() ? &(block_col_buffer[0]) : NULL,
+        block_elements.size() ? &(block_elements[0]) : NULL,
+        cpu_matrix.size(), cols, block_col_buffer.size());
+}
+
+/** @brief Copies a block_compressed_matrix to a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> >.
+*
+* Explicitly stored zeros within blocks and the padding beyond the last row and column are skipped.
+*/
+template<typename NumericT, unsigned int BlockSize>
+void copy(block_compressed_matrix<NumericT, BlockSize> const & B, std::vector< std::map<unsigned int, NumericT> > & cpu_matrix)
+{
+  std::vector<unsigned int> block_row_buffer, block_col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_block_compressed_matrix(B, block_row_buffer, block_col_buffer, elements);
+
+  cpu_matrix.clear();
+  cpu_matrix.resize(B.size1());
+  for (vcl_size_t block_row = 0; block_row < B.block_rows(); ++block_row)
+    for (vcl_size_t k = block_row_buffer[block_row]; k < block_row_buffer[block_row + 1]; ++k)
+      for (vcl_size_t i = 0; i < BlockSize; ++i)
+        for (vcl_size_t j = 0; j < BlockSize; ++j)
+        {
+          vcl_size_t row = block_row * BlockSize + i;
+          vcl_size_t col = vcl_size_t(block_col_buffer[k]) * BlockSize + j;
+          NumericT value = elements[(k * BlockSize + i) * BlockSize + j];
+          if (row < B.size1() && col < B.size2() && (value < 0 || value > 0))
+            cpu_matrix[row][static_cast<unsigned int>(col)] = value;
+        }
+}
+
+/** @brief Returns the ratio of nonzeros of a compressed_matrix to the number of entries stored in a block_compressed_matrix with the given block size.
+*
+* A ratio of one means that the matrix consists of fully populated blocks of this size.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+double block_fill_ratio(compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t block_size)
+{
+  if (A.nnz() == 0 || block_size == 0)
+    return 1.0;
+
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  vcl_size_t num_blocks = viennacl::linalg::host_based::detail::csr_count_blocks(&(row_buffer[0]), &(col_buffer[0]), A.size1(), A.size2(), block_size);
+  return double(A.nnz()) / double(num_blocks * block_size * block_size);
+}
+
+/** @brief Detects the natural block size of a compressed_matrix.
+*
+* Returns the largest block size up to max_block_size for which the fill ratio (cf. block_fill_ratio()) is at least min_fill_ratio, or one if there is none.
+* The result is meant to select the BlockSize template argument of block_compressed_matrix.
+*
+* @param A                The sparse matrix
+* @param max_block_size   Largest block size considered
+* @param min_fill_ratio   Smallest acceptable ratio of nonzeros to stored entries
+*/
+template<typename NumericT, unsigned int AlignmentV>
+vcl_size_t detect_block_size(compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t max_block_size = 8, double min_fill_ratio = 0.9)
+{
+  if (A.nnz() == 0)
+    return 1;
+
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  for (vcl_size_t block_size = max_block_size; block_size > 1; --block_size)
+  {
+    vcl_size_t num_blocks = viennacl::linalg::host_based::detail::csr_count_blocks(&(row_buffer[0]), &(col_buffer[0]), A.size1(), A.size2(), block_size);
+    if (double(A.nnz()) >= min_fill_ratio * double(num_blocks * block_size * block_size))
+      return block_size;
+  }
+  return 1;
+}
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T, unsigned int B>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(1), lhs, T(1));
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, unsigned int B, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const block_compressed_matrix<T, B>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(-1), lhs, T(1));
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
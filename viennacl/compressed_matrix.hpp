@@ -634,6 +634,11 @@ public:
     elements_.switch_active_handle_id(ctx.memory_type());
     row_blocks_.switch_active_handle_id(ctx.memory_type());
 
+    row_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    col_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    row_blocks_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
     {
@@ -670,6 +675,11 @@ public:
     elements_.switch_active_handle_id(ctx.memory_type());
     row_blocks_.switch_active_handle_id(ctx.memory_type());
 
+    row_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    col_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    row_blocks_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
     {
@@ -698,6 +708,11 @@ public:
     elements_.switch_active_handle_id(ctx.memory_type());
     row_blocks_.switch_active_handle_id(ctx.memory_type());
 
+    row_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    col_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    row_blocks_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
     {
@@ -807,6 +822,11 @@ public:
     elements_.switch_active_handle_id(ctx.memory_type());
     row_blocks_.switch_active_handle_id(ctx.memory_type());
 
+    row_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    col_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    row_blocks_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
 #ifdef VIENNACL_WITH_OPENCL
     if (ctx.memory_type() == OPENCL_MEMORY)
     {
@@ -821,6 +841,56 @@ public:
     generate_row_block_information();
   }
 
+  /** @brief Creates a copy of a compressed matrix with a different floating point type, e.g. a single precision copy of a double precision matrix.
+    *
+    * The sparsity pattern is copied as-is, the nonzeros are converted within the memory domain of 'other'.
+    */
+  template<typename OtherNumericT, unsigned int OtherAlignmentV>
+  explicit compressed_matrix(compressed_matrix<OtherNumericT, OtherAlignmentV> const & other)
+    : rows_(other.size1()), cols_(other.size2()), nonzeros_(other.nnz()), row_block_num_(0)
+  {
+    viennacl::context ctx = viennacl::traits::context(other.handle1());
+
+    row_buffer_.switch_active_handle_id(ctx.memory_type());
+    col_buffer_.switch_active_handle_id(ctx.memory_type());
+    elements_.switch_active_handle_id(ctx.memory_type());
+    row_blocks_.switch_active_handle_id(ctx.memory_type());
+
+    row_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    col_buffer_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    elements_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+    row_blocks_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+    {
+      row_buffer_.opencl_handle().context(ctx.opencl_context());
+      col_buffer_.opencl_handle().context(ctx.opencl_context());
+      elements_.opencl_handle().context(ctx.opencl_context());
+      row_blocks_.opencl_handle().context(ctx.opencl_context());
+    }
+#endif
+    if (rows_ > 0)
+    {
+      viennacl::backend::memory_create(row_buffer_, other.handle1().raw_size(), ctx);
+      viennacl::backend::memory_copy(other.handle1(), row_buffer_, 0, 0, other.handle1().raw_size());
+    }
+    if (nonzeros_ > 0)
+    {
+      viennacl::backend::memory_create(col_buffer_, other.handle2().raw_size(), ctx);
+      viennacl::backend::memory_copy(other.handle2(), col_buffer_, 0, 0, other.handle2().raw_size());
+
+      viennacl::backend::memory_create(elements_, sizeof(NumericT) * nonzeros_, ctx);
+      viennacl::vector_base<OtherNumericT> other_elements(const_cast<handle_type &>(other.handle()), nonzeros_, 0, 1);
+      viennacl::vector_base<NumericT>      elements(elements_, nonzeros_, 0, 1);
+      elements = other_elements;
+    }
+
+    //generate block information for CSR-adaptive:
+    if (rows_ > 0)
+      generate_row_block_information();
+  }
+
   /** @brief Assignment a compressed matrix from possibly another memory domain. */
   compressed_matrix & operator=(compressed_matrix const & other)
   {
@@ -881,11 +951,15 @@ public:
     //row_buffer_.switch_active_handle_id(viennacl::backend::OPENCL_MEMORY);
     viennacl::backend::memory_create(row_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(row_buffer_).element_size() * (rows + 1), viennacl::traits::context(row_buffer_), row_jumper);
 
+    // in main memory, the entries of each row are initialized by the thread processing that row (NUMA first-touch):
+    unsigned int const * row_offsets = static_cast<unsigned int const *>(row_jumper);
+
     //col_buffer_.switch_active_handle_id(viennacl::backend::OPENCL_MEMORY);
-    viennacl::backend::memory_create(col_buffer_, viennacl::backend::typesafe_host_array<unsigned int>(col_buffer_).element_size() * nonzeros, viennacl::traits::context(col_buffer_), col_buffer);
+    vcl_size_t col_element_size = viennacl::backend::typesafe_host_array<unsigned int>(col_buffer_).element_size();
+    viennacl::backend::memory_create_by_rows(col_buffer_, col_element_size * nonzeros, viennacl::traits::context(col_buffer_), col_buffer, row_offsets, rows, col_element_size);
 
     //elements_.switch_active_handle_id(viennacl::backend::OPENCL_MEMORY);
-    viennacl::backend::memory_create(elements_, sizeof(NumericT) * nonzeros, viennacl::traits::context(elements_), elements);
+    viennacl::backend::memory_create_by_rows(elements_, sizeof(NumericT) * nonzeros, viennacl::traits::context(elements_), elements, row_offsets, rows, sizeof(NumericT));
 
     nonzeros_ = nonzeros;
     rows_ = rows;
@@ -1175,6 +1249,25 @@ std::ostream & operator<<(std::ostream & os, compressed_matrix<NumericT, Alignme
   return os;
 }
 
+namespace detail
+{
+  /** @brief Reads the CSR arrays of a compressed_matrix to the host, regardless of the memory it resides in. */
+  template<typename NumericT, unsigned int AlignmentV>
+  void read_compressed_matrix(compressed_matrix<NumericT, AlignmentV> const & A,
+                              std::vector<unsigned int> & row_buffer, std::vector<unsigned int> & col_buffer, std::vector<NumericT> & elements)
+  {
+    row_buffer.resize(A.size1() + 1);
+    col_buffer.resize(std::max<vcl_size_t>(A.nnz(), 1));
+    elements.resize(std::max<vcl_size_t>(A.nnz(), 1));
+    viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * row_buffer.size(), &(row_buffer[0]));
+    if (A.nnz() > 0)
+    {
+      viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * A.nnz(), &(col_buffer[0]));
+      viennacl::backend::memory_read(A.handle(),  0, sizeof(NumericT) * A.nnz(), &(elements[0]));
+    }
+  }
+}
+
 //
 // Specify available operations:
 //
@@ -39,7 +39,7 @@ namespace viennacl
 class context
 {
 public:
-  context() : mem_type_(viennacl::backend::default_memory_type())
+  context() : mem_type_(viennacl::backend::default_memory_type()), numa_policy_(NUMA_FIRST_TOUCH), numa_node_(-1)
   {
 #ifdef VIENNACL_WITH_OPENCL
     if (mem_type_ == OPENCL_MEMORY)
@@ -49,7 +49,7 @@ public:
 #endif
   }
 
-  explicit context(viennacl::memory_types mtype) : mem_type_(mtype)
+  explicit context(viennacl::memory_types mtype) : mem_type_(mtype), numa_policy_(NUMA_FIRST_TOUCH), numa_node_(-1)
   {
     if (mem_type_ == MEMORY_NOT_INITIALIZED)
       mem_type_ = viennacl::backend::default_memory_type();
@@ -61,8 +61,26 @@ public:
 #endif
   }
 
+  /** @brief Creates a context with the given placement of buffers in main memory on NUMA systems. The policy is ignored for buffers outside of main memory.
+    *
+    * @param mtype      The memory domain
+    * @param policy     Placement policy for buffers in main memory
+    * @param numa_node  Node the buffers are placed on if the policy is NUMA_BIND. A negative value refers to the node of the allocating thread.
+    */
+  context(viennacl::memory_types mtype, viennacl::numa_policies policy, int numa_node = -1) : mem_type_(mtype), numa_policy_(policy), numa_node_(numa_node)
+  {
+    if (mem_type_ == MEMORY_NOT_INITIALIZED)
+      mem_type_ = viennacl::backend::default_memory_type();
 #ifdef VIENNACL_WITH_OPENCL
-  context(viennacl::ocl::context const & ctx) : mem_type_(OPENCL_MEMORY), ocl_context_ptr_(&ctx) {}
+    if (mem_type_ == OPENCL_MEMORY)
+      ocl_context_ptr_ = &viennacl::ocl::current_context();
+    else
+      ocl_context_ptr_ = NULL;
+#endif
+  }
+
+#ifdef VIENNACL_WITH_OPENCL
+  context(viennacl::ocl::context const & ctx) : mem_type_(OPENCL_MEMORY), numa_policy_(NUMA_FIRST_TOUCH), numa_node_(-1), ocl_context_ptr_(&ctx) {}
 
   viennacl::ocl::context const & opencl_context() const
   {
@@ -75,8 +93,16 @@ public:
 
   viennacl::memory_types  memory_type() const { return mem_type_; }
 
+  /** @brief Returns the placement policy for buffers in main memory */
+  viennacl::numa_policies numa_policy() const { return numa_policy_; }
+
+  /** @brief Returns the NUMA node used with NUMA_BIND, or a negative value for the node of the allocating thread */
+  int numa_node() const { return numa_node_; }
+
 private:
   viennacl::memory_types   mem_type_;
+  viennacl::numa_policies  numa_policy_;
+  int                      numa_node_;
 #ifdef VIENNACL_WITH_OPENCL
   viennacl::ocl::context const * ocl_context_ptr_;
 #endif
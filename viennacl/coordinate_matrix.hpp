@@ -178,6 +178,9 @@ void copy(const coordinate_matrix<NumericT, AlignmentV> & gpu_matrix,
 /** @brief A sparse square matrix, where entries are stored as triplets (i,j, val), where i and j are the row and column indices and val denotes the entry.
   *
   * The present implementation of coordinate_matrix suffers from poor runtime efficiency. Users are adviced to use compressed_matrix in the meanwhile.
+  * Use viennacl::linalg::convert() to obtain a compressed_matrix from a coordinate_matrix.
+  *
+  * The compute kernels require the entries to be sorted by row, which is ensured by viennacl::copy().
   *
   * @tparam NumericT    The floating point type (either float or double, checked at compile time)
   * @tparam AlignmentV     The internal memory size for the arrays, given by (size()/AlignmentV + 1) * AlignmentV. AlignmentV must be a power of two.
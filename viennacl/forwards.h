@@ -374,6 +374,14 @@ namespace viennacl
     , CUDA_MEMORY
   };
 
+  /** @brief Placement of buffers in main memory on systems with non-uniform memory access (NUMA) */
+  enum numa_policies
+  {
+    NUMA_FIRST_TOUCH      ///< Pages are initialized in parallel with the static partitioning used by the host kernels, hence reside on the node of the thread working on them
+    , NUMA_INTERLEAVE     ///< Pages are distributed round-robin over all nodes
+    , NUMA_BIND           ///< Pages reside on a single node: the one given by the context, or the one of the allocating thread
+  };
+
   namespace backend
   {
     class mem_handle;
@@ -429,6 +437,21 @@ namespace viennacl
   template<class SCALARTYPE, unsigned int ALIGNMENT = 1>
   class hyb_matrix;
 
+  template<typename NumericT, unsigned int BlockSize>
+  class block_compressed_matrix;
+
+  template<typename NumericT, typename OffsetT = unsigned short>
+  class index_compressed_matrix;
+
+  template<typename NumericT, typename StorageT = float>
+  class mixed_precision_compressed_matrix;
+
+  template<typename NumericT>
+  class stencil_operator;
+
+  template<typename NumericT>
+  class reordered_matrix;
+
   template<class SCALARTYPE, unsigned int ALIGNMENT = 1>
   class circulant_matrix;
 
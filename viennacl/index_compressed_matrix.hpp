@@ -0,0 +1,374 @@
+#ifndef VIENNACL_INDEX_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_INDEX_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/index_compressed_matrix.hpp
+    @brief Implementation of the index_compressed_matrix class, a CSR format with column indices stored as narrow offsets per row block.
+*/
+
+#include <vector>
+#include <map>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+
+template<typename NumericT, unsigned int AlignmentV, typename OffsetT>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, index_compressed_matrix<NumericT, OffsetT> & B);
+
+/** @brief Sparse matrix class using the CSR format with compressed column indices.
+*
+* Sparse matrix-vector products are limited by memory bandwidth, and with compressed_matrix the 32-bit column indices account for a third of the data for double precision (half of it for single precision).
+* Like the row blocks of compressed_matrix, the rows are partitioned into blocks of at most VIENNACL_INDEX_COMPRESSION_BLOCK_SIZE nonzeros.
+* For each block a 32-bit base column is stored, and the column indices of the block are stored as offsets of type OffsetT to this base.
+* This requires the column indices within a block to span at most the range of OffsetT, which holds for banded matrices (e.g. after reordering with reverse Cuthill-McKee).
+* Rows with a wider range of column indices are gathered in fallback blocks, which keep their 32-bit column indices.
+*
+* Products are currently only available in main memory.
+*
+* @tparam NumericT    Floating point type (either float or double, checked at compile time)
+* @tparam OffsetT     Unsigned integer type of the column offsets, usually unsigned short or unsigned char
+*/
+template<typename NumericT, typename OffsetT>
+class index_compressed_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>     value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  /** @brief Creates an empty matrix in the given context */
+  explicit index_compressed_matrix(viennacl::context ctx = viennacl::context()) : rows_(0), cols_(0), nonzeros_(0), num_blocks_(0), compressed_nnz_(0)
+  {
+    init_handles(ctx);
+  }
+
+  /** @brief Creates the matrix from a compressed_matrix, residing in the same context. */
+  template<unsigned int AlignmentV>
+  explicit index_compressed_matrix(viennacl::compressed_matrix<NumericT, AlignmentV> const & A) : rows_(0), cols_(0), nonzeros_(0), num_blocks_(0), compressed_nnz_(0)
+  {
+    init_handles(viennacl::traits::context(A));
+    viennacl::copy(A, *this);
+  }
+
+  /** @brief Sets the matrix from CSR arrays on the host. The column indices are compressed on the host, in parallel if OpenMP is enabled.
+  *
+  * @param row_buffer   Row offsets, rows + 1 entries
+  * @param col_buffer   Column indices, row_buffer[rows] entries
+  * @param elements     Nonzero values, row_buffer[rows] entries
+  * @param rows         Number of rows
+  * @param cols         Number of columns
+  */
+  void set(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t rows, vcl_size_t cols)
+  {
+    std::vector<unsigned int> row_blocks, block_base, block_offset_ptr, fallback_cols;
+    std::vector<OffsetT> col_offsets;
+    viennacl::linalg::host_based::detail::csr_compress_indices(row_buffer, col_buffer, rows,
+                                                               row_blocks, block_base, block_offset_ptr, col_offsets, fallback_cols);
+
+    rows_           = rows;
+    cols_           = cols;
+    nonzeros_       = row_buffer[rows];
+    num_blocks_     = row_blocks.size() - 1;
+    compressed_nnz_ = block_offset_ptr.back();
+
+    viennacl::context ctx = viennacl::traits::context(elements_);
+    std::vector<NumericT> dummy_element(1, 0);
+    viennacl::backend::memory_create(row_buffer_,       sizeof(unsigned int) * (rows + 1),              ctx, row_buffer);
+    viennacl::backend::memory_create(col_offsets_,      sizeof(OffsetT) * col_offsets.size(),           ctx, &(col_offsets[0]));
+    viennacl::backend::memory_create(row_blocks_,       sizeof(unsigned int) * row_blocks.size(),       ctx, &(row_blocks[0]));
+    viennacl::backend::memory_create(block_base_,       sizeof(unsigned int) * block_base.size(),       ctx, &(block_base[0]));
+    viennacl::backend::memory_create(block_offset_ptr_, sizeof(unsigned int) * block_offset_ptr.size(), ctx, &(block_offset_ptr[0]));
+    viennacl::backend::memory_create(fallback_cols_,    sizeof(unsigned int) * fallback_cols.size(),    ctx, &(fallback_cols[0]));
+    viennacl::backend::memory_create(elements_,         sizeof(NumericT) * std::max<vcl_size_t>(nonzeros_, 1), ctx, nonzeros_ ? elements : &(dummy_element[0]));
+  }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return rows_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return cols_; }
+  /** @brief Returns the number of nonzero entries */
+  vcl_size_t nnz() const { return nonzeros_; }
+  /** @brief Returns the number of row blocks */
+  vcl_size_t num_blocks() const { return num_blocks_; }
+  /** @brief Returns the number of entries whose column index is stored as an offset of type OffsetT */
+  vcl_size_t compressed_nnz() const { return compressed_nnz_; }
+  /** @brief Returns the number of entries in fallback blocks, whose column index is stored with 32 bits */
+  vcl_size_t fallback_nnz() const { return nonzeros_ - compressed_nnz_; }
+
+  /** @brief Returns the number of bytes for the row offsets, the block information, and the column indices. The corresponding number for compressed_matrix is (size1() + 1 + nnz()) * sizeof(unsigned int). */
+  vcl_size_t index_bytes() const
+  {
+    return sizeof(unsigned int) * (rows_ + 1 + 3 * num_blocks_ + 2 + fallback_nnz()) + sizeof(OffsetT) * compressed_nnz_;
+  }
+
+  /** @brief Returns the OpenCL handle to the row offsets */
+  const handle_type & handle1() const { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column offsets within the compressed blocks */
+  const handle_type & handle2() const { return col_offsets_; }
+  /** @brief Returns the OpenCL handle to the first row of each block */
+  const handle_type & handle3() const { return row_blocks_; }
+  /** @brief Returns the OpenCL handle to the base column of each block */
+  const handle_type & handle4() const { return block_base_; }
+  /** @brief Returns the OpenCL handle to the number of compressed entries preceding each block */
+  const handle_type & handle5() const { return block_offset_ptr_; }
+  /** @brief Returns the OpenCL handle to the column indices within the fallback blocks */
+  const handle_type & handle6() const { return fallback_cols_; }
+  /** @brief Returns the OpenCL handle to the matrix entry array */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Switches the memory context of the matrix.
+  *
+  * Allows for e.g. an migration of the full matrix from OpenCL memory to host memory for e.g. computing a preconditioner.
+  */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<OffsetT>(col_offsets_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(row_blocks_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(block_base_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(block_offset_ptr_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(fallback_cols_, new_ctx);
+    viennacl::backend::switch_memory_context<NumericT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up for OpenMP, OpenCL, or CUDA. */
+  viennacl::memory_types memory_context() const
+  {
+    return elements_.get_active_handle_id();
+  }
+
+private:
+  void init_handles(viennacl::context ctx)
+  {
+    handle_type * handles[7] = { &row_buffer_, &col_offsets_, &row_blocks_, &block_base_, &block_offset_ptr_, &fallback_cols_, &elements_ };
+    for (vcl_size_t i = 0; i < 7; ++i)
+    {
+      handles[i]->switch_active_handle_id(ctx.memory_type());
+      handles[i]->numa_policy(ctx.numa_policy(), ctx.numa_node());
+#ifdef VIENNACL_WITH_OPENCL
+      if (ctx.memory_type() == OPENCL_MEMORY)
+        handles[i]->opencl_handle().context(ctx.opencl_context());
+#endif
+    }
+  }
+
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t nonzeros_;
+  vcl_size_t num_blocks_;
+  vcl_size_t compressed_nnz_;
+  handle_type row_buffer_;
+  handle_type col_offsets_;
+  handle_type row_blocks_;
+  handle_type block_base_;
+  handle_type block_offset_ptr_;
+  handle_type fallback_cols_;
+  handle_type elements_;
+};
+
+
+/** @brief Copies a compressed_matrix to an index_compressed_matrix.
+*
+* The index_compressed_matrix remains in its memory context. The compression of the column indices runs on the host.
+*/
+template<typename NumericT, unsigned int AlignmentV, typename OffsetT>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, index_compressed_matrix<NumericT, OffsetT> & B)
+{
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  B.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), A.size1(), A.size2());
+}
+
+/** @brief Copies a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> > to an index_compressed_matrix.
+*
+* @param cpu_matrix   The sparse matrix on the host
+* @param B            The index_compressed_matrix
+* @param cols         Number of columns. If zero, the largest column index plus one is used.
+*/
+template<typename NumericT, typename OffsetT>
+void copy(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, index_compressed_matrix<NumericT, OffsetT> & B, vcl_size_t cols = 0)
+{
+  std::vector<unsigned int> row_buffer(cpu_matrix.size() + 1, 0);
+  std::vector<unsigned int> col_buffer;
+  std::vector<NumericT> elements;
+  vcl_size_t max_col = 0;
+  for (vcl_size_t i = 0; i < cpu_matrix.size(); ++i)
+  {
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = cpu_matrix[i].begin(); it != cpu_matrix[i].end(); ++it)
+    {
+      col_buffer.push_back(it->first);
+      elements.push_back(it->second);
+      max_col = std::max<vcl_size_t>(max_col, it->first + 1);
+    }
+    row_buffer[i+1] = static_cast<unsigned int>(col_buffer.size());
+  }
+  if (cols == 0)
+    cols = max_col;
+  col_buffer.push_back(0); // guard against empty buffers
+  elements.push_back(0);
+
+  B.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), cpu_matrix.size(), cols);
+}
+
+/** @brief Copies an index_compressed_matrix to a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> >. */
+template<typename NumericT, typename OffsetT>
+void copy(index_compressed_matrix<NumericT, OffsetT> const & B, std::vector< std::map<unsigned int, NumericT> > & cpu_matrix)
+{
+  std::vector<unsigned int> row_buffer(B.size1() + 1), row_blocks(B.num_blocks() + 1), block_base(std::max<vcl_size_t>(B.num_blocks(), 1)), block_offset_ptr(B.num_blocks() + 1);
+  std::vector<unsigned int> fallback_cols(std::max<vcl_size_t>(B.fallback_nnz(), 1));
+  std::vector<OffsetT> col_offsets(std::max<vcl_size_t>(B.compressed_nnz(), 1));
+  std::vector<NumericT> elements(std::max<vcl_size_t>(B.nnz(), 1));
+
+  viennacl::backend::memory_read(B.handle1(), 0, sizeof(unsigned int) * row_buffer.size(),       &(row_buffer[0]));
+  viennacl::backend::memory_read(B.handle2(), 0, sizeof(OffsetT) * col_offsets.size(),           &(col_offsets[0]));
+  viennacl::backend::memory_read(B.handle3(), 0, sizeof(unsigned int) * row_blocks.size(),       &(row_blocks[0]));
+  viennacl::backend::memory_read(B.handle4(), 0, sizeof(unsigned int) * block_base.size(),       &(block_base[0]));
+  viennacl::backend::memory_read(B.handle5(), 0, sizeof(unsigned int) * block_offset_ptr.size(), &(block_offset_ptr[0]));
+  viennacl::backend::memory_read(B.handle6(), 0, sizeof(unsigned int) * fallback_cols.size(),    &(fallback_cols[0]));
+  viennacl::backend::memory_read(B.handle(),  0, sizeof(NumericT) * elements.size(),             &(elements[0]));
+
+  cpu_matrix.clear();
+  cpu_matrix.resize(B.size1());
+  for (vcl_size_t block = 0; block < B.num_blocks(); ++block)
+  {
+    unsigned int k_begin = row_buffer[row_blocks[block]];
+    unsigned int k_end   = row_buffer[row_blocks[block + 1]];
+    bool compressed = (block_offset_ptr[block + 1] - block_offset_ptr[block] == k_end - k_begin);
+    for (unsigned int row = row_blocks[block]; row < row_blocks[block + 1]; ++row)
+      for (unsigned int k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+      {
+        unsigned int col = compressed ? block_base[block] + static_cast<unsigned int>(col_offsets[block_offset_ptr[block] + k - k_begin])
+                                      : fallback_cols[k - block_offset_ptr[block]];
+        cpu_matrix[row][col] = elements[k];
+      }
+  }
+}
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T, typename OffsetT>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T, typename OffsetT>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T, typename OffsetT>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename OffsetT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename OffsetT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(1), lhs, T(1));
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename OffsetT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const index_compressed_matrix<T, OffsetT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(-1), lhs, T(1));
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/mixed_precision_compressed_matrix.hpp"
 
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
 #include "viennacl/linalg/sparse_matrix_operations.hpp"
@@ -389,6 +390,155 @@ private:
   amg_tag tag_;
 };
 
+
+/** @brief AMG preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for mixed_precision_compressed_matrix: The hierarchy is set up in full precision from a compressed_matrix.
+*  Afterwards the operators, prolongations and restrictions of all levels are stored in StorageT, while the cycle is carried out in NumericT.
+*  The dense LU factors of the coarsest level remain in full precision. Only available in main memory so far.
+*/
+template<typename NumericT, typename StorageT>
+class amg_precond< mixed_precision_compressed_matrix<NumericT, StorageT> >
+{
+  typedef viennacl::mixed_precision_compressed_matrix<NumericT, StorageT> SparseMatrixType;
+  typedef viennacl::compressed_matrix<NumericT>                           SetupMatrixType;
+  typedef viennacl::vector<NumericT>                                      VectorType;
+  typedef detail::amg::amg_level_context                                  AMGContextType;
+
+public:
+
+  amg_precond() {}
+
+  /** @brief The constructor. Builds data structures.
+  *
+  * @param mat  System matrix in full precision
+  * @param tag  The AMG tag
+  */
+  amg_precond(compressed_matrix<NumericT> const & mat,
+              amg_tag const & tag)
+  {
+    tag_ = tag;
+
+    // Initialize data structures.
+    detail::amg_init(mat, setup_A_list_, setup_P_list_, setup_R_list_, amg_context_list_, tag_);
+  }
+
+  /** @brief Start setup phase for this class and copy data structures.
+  */
+  void setup()
+  {
+    // Start setup phase in full precision.
+    vcl_size_t num_coarse_levels = detail::amg_setup(setup_A_list_, setup_P_list_, setup_R_list_, amg_context_list_, tag_);
+
+    // Setup precondition phase (Data structures).
+    detail::amg_setup_apply(result_list_, result_backup_list_, rhs_list_, residual_list_, setup_A_list_, num_coarse_levels, tag_);
+
+    // LU factorization for direct solve.
+    detail::amg_lu(coarsest_op_, setup_A_list_[num_coarse_levels], tag_);
+
+    // Round the operators to StorageT. The operator on the coarsest level is only needed for the direct solve.
+    A_list_.resize(num_coarse_levels, SparseMatrixType(tag_.get_target_context()));
+    P_list_.resize(num_coarse_levels, SparseMatrixType(tag_.get_target_context()));
+    R_list_.resize(num_coarse_levels, SparseMatrixType(tag_.get_target_context()));
+    for (vcl_size_t level = 0; level < num_coarse_levels; ++level)
+    {
+      viennacl::copy(setup_A_list_[level], A_list_[level]);
+      viennacl::copy(setup_P_list_[level], P_list_[level]);
+      viennacl::copy(setup_R_list_[level], R_list_[level]);
+    }
+    setup_A_list_.clear();
+    setup_P_list_.clear();
+    setup_R_list_.clear();
+  }
+
+
+  /** @brief Precondition Operation
+  *
+  * @param vec       The vector to which preconditioning is applied to
+  */
+  template<typename VectorT>
+  void apply(VectorT & vec) const
+  {
+    vcl_size_t level;
+
+    rhs_list_[0] = vec;
+
+    // Part 1: Restrict down to coarsest level
+    for (level=0; level < residual_list_.size(); level++)
+    {
+      result_list_[level].clear();
+
+      viennacl::linalg::detail::amg::smooth_jacobi(static_cast<unsigned int>(tag_.get_presmooth_steps()),
+                                                   A_list_[level],
+                                                   result_list_[level],
+                                                   result_backup_list_[level],
+                                                   rhs_list_[level],
+                                                   static_cast<NumericT>(tag_.get_jacobi_weight()));
+
+      residual_list_[level] = viennacl::linalg::prod(A_list_[level], result_list_[level]);
+      residual_list_[level] = rhs_list_[level] - residual_list_[level];
+
+      rhs_list_[level+1] = viennacl::linalg::prod(R_list_[level], residual_list_[level]);
+    }
+
+    // Part 2: On highest level use direct solve to solve equation (on the CPU)
+    result_list_[level] = rhs_list_[level];
+    viennacl::linalg::lu_substitute(coarsest_op_, result_list_[level]);
+
+    // Part 3: Prolongation to finest level
+    for (int level2 = static_cast<int>(residual_list_.size()-1); level2 >= 0; level2--)
+    {
+      level = static_cast<vcl_size_t>(level2);
+
+      result_backup_list_[level] = viennacl::linalg::prod(P_list_[level], result_list_[level+1]);
+      result_list_[level] += result_backup_list_[level];
+
+      viennacl::linalg::detail::amg::smooth_jacobi(static_cast<unsigned int>(tag_.get_postsmooth_steps()),
+                                                   A_list_[level],
+                                                   result_list_[level],
+                                                   result_backup_list_[level],
+                                                   rhs_list_[level],
+                                                   static_cast<NumericT>(tag_.get_jacobi_weight()));
+    }
+    vec = result_list_[0];
+  }
+
+  /** @brief Returns the total number of multigrid levels in the hierarchy including the finest level. */
+  vcl_size_t levels() const { return residual_list_.size(); }
+
+
+  /** @brief Returns the problem/operator size at the respective multigrid level
+    *
+    * @param level     Index of the multigrid level. 0 is the finest level, levels() - 1 is the coarsest level.
+    */
+  vcl_size_t size(vcl_size_t level) const
+  {
+    assert(level < levels() && bool("Level index out of bounds!"));
+    return residual_list_[level].size();
+  }
+
+  /** @brief Returns the associated preconditioner tag containing the configuration for the multigrid preconditioner. */
+  amg_tag const & tag() const { return tag_; }
+
+private:
+  std::vector<SetupMatrixType>  setup_A_list_;
+  std::vector<SetupMatrixType>  setup_P_list_;
+  std::vector<SetupMatrixType>  setup_R_list_;
+  std::vector<SparseMatrixType> A_list_;
+  std::vector<SparseMatrixType> P_list_;
+  std::vector<SparseMatrixType> R_list_;
+  std::vector<AMGContextType>   amg_context_list_;
+
+  viennacl::matrix<NumericT>        coarsest_op_;
+
+  mutable std::vector<VectorType> result_list_;
+  mutable std::vector<VectorType> result_backup_list_;
+  mutable std::vector<VectorType> rhs_list_;
+  mutable std::vector<VectorType> residual_list_;
+
+  amg_tag tag_;
+};
+
 }
 }
 
@@ -28,6 +28,7 @@
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/amg/amg_base.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/amg_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -50,6 +51,7 @@ namespace amg
 template<typename NumericT, typename AMGContextT>
 void amg_influence(compressed_matrix<NumericT> const & A, AMGContextT & amg_context, amg_tag & tag)
 {
+  VIENNACL_PROFILE_SCOPE("amg::influence", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -76,6 +78,7 @@ void amg_influence(compressed_matrix<NumericT> const & A, AMGContextT & amg_cont
 template<typename NumericT, typename AMGContextT>
 void amg_coarse(compressed_matrix<NumericT> const & A, AMGContextT & amg_context, amg_tag & tag)
 {
+  VIENNACL_PROFILE_SCOPE("amg::coarse", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -105,6 +108,7 @@ void amg_interpol(compressed_matrix<NumericT> const & A,
                   AMGContextT & amg_context,
                   amg_tag & tag)
 {
+  VIENNACL_PROFILE_SCOPE("amg::interpol", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -137,6 +141,7 @@ void amg_transpose(compressed_matrix<NumericT> & A,
   (void)orig_ctx;
   (void)cpu_ctx;
 
+  VIENNACL_PROFILE_SCOPE("amg::transpose", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -177,6 +182,7 @@ assign_to_dense(SparseMatrixType const & A,
   assert( (A.size1() == B.size1()) && bool("Size check failed for assignment to dense matrix: size1(A) != size1(B)"));
   assert( (A.size2() == B.size1()) && bool("Size check failed for assignment to dense matrix: size2(A) != size2(B)"));
 
+  VIENNACL_PROFILE_SCOPE("amg::assign_to_dense", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -207,6 +213,7 @@ void smooth_jacobi(unsigned int iterations,
                    vector<NumericT> const & rhs_smooth,
                    NumericT weight)
 {
+  VIENNACL_PROFILE_SCOPE("amg::smooth_jacobi", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -229,6 +236,28 @@ void smooth_jacobi(unsigned int iterations,
   }
 }
 
+/** @brief Damped Jacobi smoother for operators with values stored in reduced precision. Only implemented for main memory so far. */
+template<typename NumericT, typename StorageT>
+void smooth_jacobi(unsigned int iterations,
+                   mixed_precision_compressed_matrix<NumericT, StorageT> const & A,
+                   vector<NumericT> & x,
+                   vector<NumericT> & x_backup,
+                   vector<NumericT> const & rhs_smooth,
+                   NumericT weight)
+{
+  VIENNACL_PROFILE_SCOPE("amg::smooth_jacobi", 0, 0);
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::amg::smooth_jacobi(iterations, A, x, x_backup, rhs_smooth, weight);
+      break;
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
 } //namespace amg
 } //namespace detail
 } //namespace linalg
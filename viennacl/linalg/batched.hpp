@@ -0,0 +1,309 @@
+#ifndef VIENNACL_LINALG_BATCHED_HPP_
+#define VIENNACL_LINALG_BATCHED_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/batched.hpp
+    @brief Batched BLAS-like operations (GEMM, GEMV, TRSM, LU) for large numbers of small dense matrices.
+
+    Each batch is given either as a single vector holding all matrices at a constant stride ('strided batch'),
+    or as an array of host pointers ('pointer array batch'). Matrices use BLAS conventions for the leading dimension.
+    Currently only implemented for the host backend.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/tools/profiler.hpp"
+#include "viennacl/linalg/host_based/batched_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+namespace detail
+{
+  /** @brief Maps the triangular solver tags to the (lower, unit_diagonal) flags of the batched kernels */
+  template<typename SolverTagT>
+  struct batched_triangular_traits;
+
+  template<> struct batched_triangular_traits<viennacl::linalg::lower_tag>      { static const bool lower = true;  static const bool unit_diagonal = false; };
+  template<> struct batched_triangular_traits<viennacl::linalg::upper_tag>      { static const bool lower = false; static const bool unit_diagonal = false; };
+  template<> struct batched_triangular_traits<viennacl::linalg::unit_lower_tag> { static const bool lower = true;  static const bool unit_diagonal = true;  };
+  template<> struct batched_triangular_traits<viennacl::linalg::unit_upper_tag> { static const bool lower = false; static const bool unit_diagonal = true;  };
+
+  template<typename NumericT>
+  viennacl::linalg::host_based::strided_batch<NumericT const *> make_host_batch(viennacl::vector_base<NumericT> const & vec, vcl_size_t stride)
+  {
+    assert(vec.stride() == 1 && bool("Batched operations require unit stride of the vector holding the batch"));
+    return viennacl::linalg::host_based::strided_batch<NumericT const *>(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec) + vec.start(), stride);
+  }
+
+  template<typename NumericT>
+  viennacl::linalg::host_based::strided_batch<NumericT *> make_host_batch(viennacl::vector_base<NumericT> & vec, vcl_size_t stride)
+  {
+    assert(vec.stride() == 1 && bool("Batched operations require unit stride of the vector holding the batch"));
+    return viennacl::linalg::host_based::strided_batch<NumericT *>(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec) + vec.start(), stride);
+  }
+}
+
+
+//
+// Strided batches
+//
+
+/** @brief Computes C_i = alpha * op(A_i) * op(B_i) + beta * C_i for batch_count matrices stored at constant strides
+*
+* @param batch_count   Number of matrices in the batch
+* @param row_major     Whether the matrices are stored in row-major (true) or column-major (false) layout
+* @param trans_A       Whether op(A_i) is the transpose of A_i
+* @param trans_B       Whether op(B_i) is the transpose of B_i
+* @param m             Number of rows of op(A_i) and C_i
+* @param n             Number of columns of op(B_i) and C_i
+* @param k             Number of columns of op(A_i) and rows of op(B_i)
+* @param A             Vector holding the matrices A_i, where A_i starts at entry i * stride_A
+* @param lda           Leading dimension of A_i
+* @param stride_A      Distance between the first entries of A_i and A_{i+1}
+*/
+template<typename NumericT>
+void batched_gemm(vcl_size_t batch_count, bool row_major, bool trans_A, bool trans_B,
+                  vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                  NumericT alpha,
+                  viennacl::vector_base<NumericT> const & A, vcl_size_t lda, vcl_size_t stride_A,
+                  viennacl::vector_base<NumericT> const & B, vcl_size_t ldb, vcl_size_t stride_B,
+                  NumericT beta,
+                  viennacl::vector_base<NumericT>       & C, vcl_size_t ldc, vcl_size_t stride_C)
+{
+  VIENNACL_PROFILE_SCOPE("batched::gemm", 0, 0);
+  switch (viennacl::traits::handle(C).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::batched_gemm(batch_count, row_major, trans_A, trans_B, m, n, k,
+                                                 alpha, detail::make_host_batch(A, stride_A), lda,
+                                                        detail::make_host_batch(B, stride_B), ldb,
+                                                 beta,  detail::make_host_batch(C, stride_C), ldc);
+      break;
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes y_i = alpha * op(A_i) * x_i + beta * y_i for batch_count m x n matrices A_i and vectors x_i, y_i stored at constant strides */
+template<typename NumericT>
+void batched_gemv(vcl_size_t batch_count, bool row_major, bool trans_A,
+                  vcl_size_t m, vcl_size_t n,
+                  NumericT alpha,
+                  viennacl::vector_base<NumericT> const & A, vcl_size_t lda, vcl_size_t stride_A,
+                  viennacl::vector_base<NumericT> const & x, vcl_size_t inc_x, vcl_size_t stride_x,
+                  NumericT beta,
+                  viennacl::vector_base<NumericT>       & y, vcl_size_t inc_y, vcl_size_t stride_y)
+{
+  VIENNACL_PROFILE_SCOPE("batched::gemv", 0, 0);
+  switch (viennacl::traits::handle(y).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::batched_gemv(batch_count, row_major, trans_A, m, n,
+                                                 alpha, detail::make_host_batch(A, stride_A), lda,
+                                                        detail::make_host_batch(x, stride_x), inc_x,
+                                                 beta,  detail::make_host_batch(y, stride_y), inc_y);
+      break;
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Solves op(A_i) X_i = alpha * B_i for batch_count triangular m x m matrices A_i stored at constant strides. B_i is m x nrhs and overwritten with X_i.
+*
+* @param tag   Solver tag (lower_tag, upper_tag, unit_lower_tag, or unit_upper_tag) specifying the triangle of A_i (not of op(A_i))
+*/
+template<typename NumericT, typename SolverTagT>
+void batched_trsm(vcl_size_t batch_count, bool row_major, bool trans_A,
+                  vcl_size_t m, vcl_size_t nrhs,
+                  NumericT alpha,
+                  viennacl::vector_base<NumericT> const & A, vcl_size_t lda, vcl_size_t stride_A,
+                  viennacl::vector_base<NumericT>       & B, vcl_size_t ldb, vcl_size_t stride_B,
+                  SolverTagT)
+{
+  VIENNACL_PROFILE_SCOPE("batched::trsm", 0, 0);
+  switch (viennacl::traits::handle(B).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::batched_trsm(batch_count, row_major,
+                                                 detail::batched_triangular_traits<SolverTagT>::lower, detail::batched_triangular_traits<SolverTagT>::unit_diagonal,
+                                                 trans_A, m, nrhs, alpha,
+                                                 detail::make_host_batch(A, stride_A), lda,
+                                                 detail::make_host_batch(B, stride_B), ldb);
+      break;
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Computes the LU factorizations with partial pivoting of batch_count n x n matrices A_i stored at constant strides. A_i is overwritten with its factors.
+*
+* @param pivots   Resized to batch_count * n entries. Entries i*n, ..., i*n+n-1 hold the row interchanges of A_i, cf. host_based::batched_lu_factorize()
+* @return         The number of singular matrices (exactly zero pivot) in the batch
+*/
+template<typename NumericT>
+vcl_size_t batched_lu_factorize(vcl_size_t batch_count, bool row_major, vcl_size_t n,
+                                viennacl::vector_base<NumericT> & A, vcl_size_t lda, vcl_size_t stride_A,
+                                std::vector<vcl_size_t> & pivots)
+{
+  pivots.resize(batch_count * n);
+  if (pivots.empty())
+    return 0;
+
+  VIENNACL_PROFILE_SCOPE("batched::lu_factorize", 0, 0);
+  switch (viennacl::traits::handle(A).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      return viennacl::linalg::host_based::batched_lu_factorize(batch_count, row_major, n,
+                                                                detail::make_host_batch(A, stride_A), lda,
+                                                                viennacl::linalg::host_based::strided_batch<vcl_size_t *>(&pivots[0], n));
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Solves A_i X_i = B_i for batch_count matrices A_i factored by batched_lu_factorize(). B_i is n x nrhs and overwritten with X_i. */
+template<typename NumericT>
+void batched_lu_substitute(vcl_size_t batch_count, bool row_major, vcl_size_t n, vcl_size_t nrhs,
+                           viennacl::vector_base<NumericT> const & LU, vcl_size_t ldlu, vcl_size_t stride_LU,
+                           std::vector<vcl_size_t> const & pivots,
+                           viennacl::vector_base<NumericT>       & B, vcl_size_t ldb, vcl_size_t stride_B)
+{
+  assert(pivots.size() == batch_count * n && bool("Pivot array does not match the batch"));
+  if (pivots.empty())
+    return;
+
+  VIENNACL_PROFILE_SCOPE("batched::lu_substitute", 0, 0);
+  switch (viennacl::traits::handle(B).get_active_handle_id())
+  {
+    case viennacl::MAIN_MEMORY:
+      viennacl::linalg::host_based::batched_lu_substitute(batch_count, row_major, n, nrhs,
+                                                          detail::make_host_batch(LU, stride_LU), ldlu,
+                                                          viennacl::linalg::host_based::strided_batch<vcl_size_t const *>(&pivots[0], n),
+                                                          detail::make_host_batch(B, stride_B), ldb);
+      break;
+    case viennacl::MEMORY_NOT_INITIALIZED:
+      throw memory_exception("not initialised!");
+    default:
+      throw memory_exception("not implemented");
+  }
+}
+
+
+//
+// Pointer array batches (host memory only)
+//
+
+/** @brief Computes C_i = alpha * op(A_i) * op(B_i) + beta * C_i, where the i-th matrices of the batch are located at A[i], B[i], and C[i] in host memory */
+template<typename NumericT>
+void batched_gemm(vcl_size_t batch_count, bool row_major, bool trans_A, bool trans_B,
+                  vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                  NumericT alpha,
+                  NumericT const * const * A, vcl_size_t lda,
+                  NumericT const * const * B, vcl_size_t ldb,
+                  NumericT beta,
+                  NumericT       * const * C, vcl_size_t ldc)
+{
+  viennacl::linalg::host_based::batched_gemm(batch_count, row_major, trans_A, trans_B, m, n, k,
+                                             alpha, viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(A), lda,
+                                                    viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(B), ldb,
+                                             beta,  viennacl::linalg::host_based::pointer_array_batch<NumericT *>(C), ldc);
+}
+
+/** @brief Computes y_i = alpha * op(A_i) * x_i + beta * y_i, where the i-th matrix and vectors of the batch are located at A[i], x[i], and y[i] in host memory */
+template<typename NumericT>
+void batched_gemv(vcl_size_t batch_count, bool row_major, bool trans_A,
+                  vcl_size_t m, vcl_size_t n,
+                  NumericT alpha,
+                  NumericT const * const * A, vcl_size_t lda,
+                  NumericT const * const * x, vcl_size_t inc_x,
+                  NumericT beta,
+                  NumericT       * const * y, vcl_size_t inc_y)
+{
+  viennacl::linalg::host_based::batched_gemv(batch_count, row_major, trans_A, m, n,
+                                             alpha, viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(A), lda,
+                                                    viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(x), inc_x,
+                                             beta,  viennacl::linalg::host_based::pointer_array_batch<NumericT *>(y), inc_y);
+}
+
+/** @brief Solves op(A_i) X_i = alpha * B_i, where the i-th matrices of the batch are located at A[i] and B[i] in host memory */
+template<typename NumericT, typename SolverTagT>
+void batched_trsm(vcl_size_t batch_count, bool row_major, bool trans_A,
+                  vcl_size_t m, vcl_size_t nrhs,
+                  NumericT alpha,
+                  NumericT const * const * A, vcl_size_t lda,
+                  NumericT       * const * B, vcl_size_t ldb,
+                  SolverTagT)
+{
+  viennacl::linalg::host_based::batched_trsm(batch_count, row_major,
+                                             detail::batched_triangular_traits<SolverTagT>::lower, detail::batched_triangular_traits<SolverTagT>::unit_diagonal,
+                                             trans_A, m, nrhs, alpha,
+                                             viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(A), lda,
+                                             viennacl::linalg::host_based::pointer_array_batch<NumericT *>(B), ldb);
+}
+
+/** @brief Computes the LU factorizations with partial pivoting of the matrices located at A[i] in host memory. The row interchanges are stored as for the strided batch. */
+template<typename NumericT>
+vcl_size_t batched_lu_factorize(vcl_size_t batch_count, bool row_major, vcl_size_t n,
+                                NumericT * const * A, vcl_size_t lda,
+                                std::vector<vcl_size_t> & pivots)
+{
+  pivots.resize(batch_count * n);
+  if (pivots.empty())
+    return 0;
+
+  return viennacl::linalg::host_based::batched_lu_factorize(batch_count, row_major, n,
+                                                            viennacl::linalg::host_based::pointer_array_batch<NumericT *>(A), lda,
+                                                            viennacl::linalg::host_based::strided_batch<vcl_size_t *>(&pivots[0], n));
+}
+
+/** @brief Solves A_i X_i = B_i for the matrices located at LU[i] factored by batched_lu_factorize(). B[i] is overwritten with X_i. */
+template<typename NumericT>
+void batched_lu_substitute(vcl_size_t batch_count, bool row_major, vcl_size_t n, vcl_size_t nrhs,
+                           NumericT const * const * LU, vcl_size_t ldlu,
+                           std::vector<vcl_size_t> const & pivots,
+                           NumericT       * const * B, vcl_size_t ldb)
+{
+  assert(pivots.size() == batch_count * n && bool("Pivot array does not match the batch"));
+  if (pivots.empty())
+    return;
+
+  viennacl::linalg::host_based::batched_lu_substitute(batch_count, row_major, n, nrhs,
+                                                      viennacl::linalg::host_based::pointer_array_batch<NumericT const *>(LU), ldlu,
+                                                      viennacl::linalg::host_based::strided_batch<vcl_size_t const *>(&pivots[0], n),
+                                                      viennacl::linalg::host_based::pointer_array_batch<NumericT *>(B), ldb);
+}
+
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -281,6 +281,19 @@ namespace detail
   }
 
 
+  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, unsigned int BlockSize>
+  viennacl::vector<NumericT> solve_impl(viennacl::block_compressed_matrix<NumericT, BlockSize> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        bicgstab_tag const & tag,
+                                        viennacl::linalg::no_precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+  }
+
+
   /** @brief Implementation of the unpreconditioned stabilized Bi-conjugate gradient solver
   *
   * Following the description in "Iterative Methods for Sparse Linear Systems" by Y. Saad
@@ -488,6 +501,51 @@ namespace detail
     return result;
   }
 
+
+  /** @brief Overload for the reordered_matrix: The system is solved in the reordered numbering, only the right hand side and the result are permuted.
+  *
+  * The preconditioner needs to be set up for A.matrix(). The monitor is called with the current guess in the reordered numbering.
+  */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::reordered_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        bicgstab_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    viennacl::vector<NumericT> rhs_reordered(rhs.size(), viennacl::traits::context(rhs));
+    A.permute(rhs, rhs_reordered);
+    viennacl::vector<NumericT> result_reordered = detail::solve_impl(A.matrix(), rhs_reordered, tag, precond, monitor, monitor_data);
+
+    viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+    A.unpermute(result_reordered, result);
+    return result;
+  }
+
+
+  /** @brief Overload for the reordered_matrix: The system is solved in the reordered numbering, only the right hand side and the result are permuted.
+  *
+  * The preconditioner needs to be set up for A.matrix(). The monitor is called with the current guess in the reordered numbering.
+  * Separate overload for no_precond, which is otherwise ambiguous with the generic unpreconditioned implementation.
+  */
+  template<typename NumericT>
+  viennacl::vector<NumericT> solve_impl(viennacl::reordered_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        bicgstab_tag const & tag,
+                                        viennacl::linalg::no_precond precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    viennacl::vector<NumericT> rhs_reordered(rhs.size(), viennacl::traits::context(rhs));
+    A.permute(rhs, rhs_reordered);
+    viennacl::vector<NumericT> result_reordered = detail::solve_impl(A.matrix(), rhs_reordered, tag, precond, monitor, monitor_data);
+
+    viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+    A.unpermute(result_reordered, result);
+    return result;
+  }
+
 }
 
 
@@ -0,0 +1,159 @@
+#ifndef VIENNACL_LINALG_CUDA_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_CUDA_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cuda/random_operations.hpp
+    @brief Implementations of the generation of random vectors and matrices using CUDA. The generator must match viennacl/tools/random.hpp.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/random.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+
+#include "viennacl/linalg/cuda/common.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace cuda
+{
+namespace detail
+{
+  /** @brief Philox4x32-10 on the device. Maps the counter (c0, c1, c2, c3) and the key (k0, k1) to four 32-bit random numbers returned in place of the counter. */
+  inline __device__ void philox4x32_10(unsigned int & c0, unsigned int & c1, unsigned int & c2, unsigned int & c3,
+                                unsigned int k0, unsigned int k1)
+  {
+    for (unsigned int round = 0; round < 10; ++round)
+    {
+      unsigned int hi0 = __umulhi(0xD2511F53u, c0);
+      unsigned int lo0 = 0xD2511F53u * c0;
+      unsigned int hi1 = __umulhi(0xCD9E8D57u, c2);
+      unsigned int lo1 = 0xCD9E8D57u * c2;
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+  }
+
+  inline __device__ void random_uniform_block(unsigned int const * w, float * u)
+  {
+    for (unsigned int lane = 0; lane < 4; ++lane)
+      u[lane] = float(w[lane] >> 8) * (1.0f / 16777216.0f);
+  }
+
+  inline __device__ void random_uniform_block(unsigned int const * w, double * u)
+  {
+    for (unsigned int lane = 0; lane < 2; ++lane)
+      u[lane] = (double(w[2*lane] >> 5) * 67108864.0 + double(w[2*lane+1] >> 6)) * (1.0 / 9007199254740992.0);
+  }
+
+  template<typename NumericT>
+  __global__ void fill_random_kernel(NumericT * A,
+                                     unsigned int A_start1, unsigned int A_start2,
+                                     unsigned int A_inc1,   unsigned int A_inc2,
+                                     unsigned int A_size1,  unsigned int A_size2,
+                                     unsigned int A_internal_size1, unsigned int A_internal_size2,
+                                     bool row_major,
+                                     unsigned int seed_lo, unsigned int seed_hi,
+                                     bool normal_distribution,
+                                     NumericT p1, NumericT p2)
+  {
+    unsigned int lanes = 16 / sizeof(NumericT);
+    unsigned int size = A_size1 * A_size2;
+    unsigned int num_blocks = (size + lanes - 1) / lanes;
+    for (unsigned int block = blockIdx.x * blockDim.x + threadIdx.x; block < num_blocks; block += gridDim.x * blockDim.x)
+    {
+      unsigned int w[4] = { block, 0, 0, 0 };
+      philox4x32_10(w[0], w[1], w[2], w[3], seed_lo, seed_hi);
+
+      NumericT values[4];
+      random_uniform_block(w, values);
+      for (unsigned int lane = 0; lane < lanes; lane += 2)
+      {
+        NumericT u = values[lane];
+        NumericT v = values[lane + 1];
+        if (normal_distribution)
+        {
+          NumericT r     = sqrt(NumericT(-2) * log(NumericT(1) - u));
+          NumericT angle = NumericT(6.28318530717958647692) * v;
+          values[lane]     = p1 + p2 * r * cos(angle);
+          values[lane + 1] = p1 + p2 * r * sin(angle);
+        }
+        else
+        {
+          values[lane]     = p1 + (p2 - p1) * u;
+          values[lane + 1] = p1 + (p2 - p1) * v;
+        }
+      }
+
+      unsigned int index = block * lanes;
+      for (unsigned int lane = 0; lane < lanes && index < size; ++lane, ++index)
+      {
+        unsigned int row = A_start1 + (index / A_size2) * A_inc1;
+        unsigned int col = A_start2 + (index % A_size2) * A_inc2;
+        A[row_major ? row * A_internal_size2 + col : row + col * A_internal_size1] = values[lane];
+      }
+    }
+  }
+}
+
+/** @brief Fills a vector with random numbers drawn from the given distribution. See viennacl::linalg::fill_random() for details. */
+template<typename NumericT>
+void fill_random(vector_base<NumericT> & x, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  detail::fill_random_kernel<<<128, 128>>>(viennacl::cuda_arg(x),
+                                           static_cast<unsigned int>(viennacl::traits::start(x)), 0,
+                                           static_cast<unsigned int>(viennacl::traits::stride(x)), 1,
+                                           static_cast<unsigned int>(viennacl::traits::size(x)), 1,
+                                           static_cast<unsigned int>(x.internal_size()), 1,
+                                           true,
+                                           static_cast<unsigned int>(seed), static_cast<unsigned int>((seed >> 16) >> 16),
+                                           dist.type() == viennacl::tools::RANDOM_NORMAL_DISTRIBUTION,
+                                           NumericT(dist.param1()), NumericT(dist.param2()));
+  VIENNACL_CUDA_LAST_ERROR_CHECK("fill_random_kernel");
+}
+
+/** @brief Fills a dense matrix with random numbers drawn from the given distribution. See viennacl::linalg::fill_random() for details. */
+template<typename NumericT>
+void fill_random(matrix_base<NumericT> & A, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  detail::fill_random_kernel<<<128, 128>>>(viennacl::cuda_arg(A),
+                                           static_cast<unsigned int>(viennacl::traits::start1(A)),         static_cast<unsigned int>(viennacl::traits::start2(A)),
+                                           static_cast<unsigned int>(viennacl::traits::stride1(A)),        static_cast<unsigned int>(viennacl::traits::stride2(A)),
+                                           static_cast<unsigned int>(viennacl::traits::size1(A)),          static_cast<unsigned int>(viennacl::traits::size2(A)),
+                                           static_cast<unsigned int>(viennacl::traits::internal_size1(A)), static_cast<unsigned int>(viennacl::traits::internal_size2(A)),
+                                           A.row_major(),
+                                           static_cast<unsigned int>(seed), static_cast<unsigned int>((seed >> 16) >> 16),
+                                           dist.type() == viennacl::tools::RANDOM_NORMAL_DISTRIBUTION,
+                                           NumericT(dist.param1()), NumericT(dist.param2()));
+  VIENNACL_CUDA_LAST_ERROR_CHECK("fill_random_kernel");
+}
+
+} // namespace cuda
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,460 @@
+#ifndef VIENNACL_LINALG_DETAIL_HESSENBERG_QR_HPP_
+#define VIENNACL_LINALG_DETAIL_HESSENBERG_QR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/hessenberg_qr.hpp
+ *
+ * @brief Francis double shift QR iteration for upper Hessenberg matrices on the host. Shared by the nonsymmetric QR method and by the GMRES variants that need Ritz values.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+    template<typename SCALARTYPE, typename MatrixT>
+    void final_iter_update(MatrixT& A,
+                            int n,
+                            int last_n,
+                            SCALARTYPE q,
+                            SCALARTYPE p
+                            )
+    {
+        for (int i = 0; i < last_n; i++)
+        {
+            SCALARTYPE v_in = A(i, n);
+            SCALARTYPE z = A(i, n - 1);
+            A(i, n - 1) = q * z + p * v_in;
+            A(i, n) = q * v_in - p * z;
+        }
+    }
+
+    template<typename SCALARTYPE, typename MatrixT>
+    void update_float_QR_column(MatrixT& A,
+                            const std::vector<SCALARTYPE>& buf,
+                            int m,
+                            int n,
+                            int last_i,
+                            bool is_triangular
+                            )
+    {
+        for (int i = 0; i < last_i; i++)
+        {
+            int start_k = is_triangular?std::max(i + 1, m):m;
+
+            SCALARTYPE* a_row = A.row(i);
+
+            SCALARTYPE a_ik   = a_row[start_k];
+            SCALARTYPE a_ik_1 = 0;
+            SCALARTYPE a_ik_2 = 0;
+
+            if (start_k < n)
+                a_ik_1 = a_row[start_k + 1];
+
+            for (int k = start_k; k < n; k++)
+            {
+                bool notlast = (k != n - 1);
+
+                SCALARTYPE p = buf[5 * static_cast<vcl_size_t>(k)] * a_ik + buf[5 * static_cast<vcl_size_t>(k) + 1] * a_ik_1;
+
+                if (notlast)
+                {
+                    a_ik_2 = a_row[k + 2];
+                    p = p + buf[5 * static_cast<vcl_size_t>(k) + 2] * a_ik_2;
+                    a_ik_2 = a_ik_2 - p * buf[5 * static_cast<vcl_size_t>(k) + 4];
+                }
+
+                a_row[k] = a_ik - p;
+                a_ik_1 = a_ik_1 - p * buf[5 * static_cast<vcl_size_t>(k) + 3];
+
+                a_ik = a_ik_1;
+                a_ik_1 = a_ik_2;
+            }
+
+            if (start_k < n)
+                a_row[n] = a_ik;
+        }
+    }
+
+    /** @brief Internal helper class representing a row-major dense matrix used for the QR method for the purpose of computing eigenvalues. */
+    template<typename SCALARTYPE>
+    class FastMatrix
+    {
+    public:
+        FastMatrix()
+        {
+            size_ = 0;
+        }
+
+        FastMatrix(vcl_size_t sz, vcl_size_t internal_size) : size_(sz), internal_size_(internal_size)
+        {
+            data.resize(internal_size * internal_size);
+        }
+
+        SCALARTYPE& operator()(int i, int j)
+        {
+            return data[static_cast<vcl_size_t>(i) * internal_size_ + static_cast<vcl_size_t>(j)];
+        }
+
+        SCALARTYPE* row(int i)
+        {
+            return &data[static_cast<vcl_size_t>(i) * internal_size_];
+        }
+
+        SCALARTYPE* begin()
+        {
+            return &data[0];
+        }
+
+        SCALARTYPE* end()
+        {
+            return &data[0] + data.size();
+        }
+
+        std::vector<SCALARTYPE> data;
+    private:
+        vcl_size_t size_;
+        vcl_size_t internal_size_;
+    };
+
+    /** @brief Schur vector policy for hqr_schur_form() which does not accumulate any transformations. Used if only the eigenvalues are of interest. */
+    template<typename SCALARTYPE>
+    struct hqr_no_schur_vectors
+    {
+        void rotate(int, int, SCALARTYPE, SCALARTYPE) {}
+        void update_qr_column(std::vector<SCALARTYPE> const &, int, int, int) {}
+    };
+
+    /** @brief Reduces an upper Hessenberg matrix to real Schur form by the Francis double shift QR iteration.
+    *
+    * Nonsymmetric reduction from Hessenberg to real Schur form.
+    * This is derived from the Algol procedure hqr2, by Martin and Wilkinson, Handbook for Auto. Comp.,
+    * Vol.ii-Linear Algebra, and the corresponding  Fortran subroutine in EISPACK.
+    *
+    * @param H               Row-major upper Hessenberg matrix of size nn, overwritten by the quasi-triangular Schur form
+    * @param nn              Size of the matrix
+    * @param d               Real parts of the eigenvalues (output)
+    * @param e               Imaginary parts of the eigenvalues (output). Complex conjugate pairs are stored with the positive imaginary part first.
+    * @param eps             Relative tolerance for negligible subdiagonal entries
+    * @param norm            The 1-norm of the Hessenberg part of H (output)
+    * @param schur_vectors   Policy which receives the plane rotations (rotate()) and the double shift steps (update_qr_column()) for accumulating the Schur vectors
+    * @param max_iterations  Maximum number of QR steps per eigenvalue. Zero means no limit.
+    * @return false if the iteration did not converge within max_iterations
+    */
+    template<typename SCALARTYPE, typename MatrixT, typename VectorType, typename SchurVectorsT>
+    bool hqr_schur_form(MatrixT & H,
+                        int nn,
+                        VectorType & d,
+                        VectorType & e,
+                        SCALARTYPE eps,
+                        SCALARTYPE & norm,
+                        SchurVectorsT & schur_vectors,
+                        int max_iterations = 0)
+    {
+        std::vector<SCALARTYPE>  buf(5 * vcl_size_t(nn));
+
+        int n = nn - 1;
+
+        SCALARTYPE exshift = 0;
+        SCALARTYPE p = 0;
+        SCALARTYPE q = 0;
+        SCALARTYPE r = 0;
+        SCALARTYPE s = 0;
+        SCALARTYPE z = 0;
+        SCALARTYPE w;
+        SCALARTYPE x;
+        SCALARTYPE y;
+
+        // compute matrix norm
+        norm = 0;
+        for (int i = 0; i < nn; i++)
+        {
+            for (int j = std::max(i - 1, 0); j < nn; j++)
+                norm = norm + std::fabs(H(i, j));
+        }
+
+        // Outer loop over eigenvalue index
+        int iter = 0;
+        while (n >= 0)
+        {
+            // Look for single small sub-diagonal element
+            int l = n;
+            while (l > 0)
+            {
+                s = std::fabs(H(l - 1, l - 1)) + std::fabs(H(l, l));
+                if (s <= 0)
+                  s = norm;
+                if (std::fabs(H(l, l - 1)) < eps * s)
+                  break;
+
+                l--;
+            }
+
+            // Check for convergence
+            if (l == n)
+            {
+                // One root found
+                H(n, n) = H(n, n) + exshift;
+                d[vcl_size_t(n)] = H(n, n);
+                e[vcl_size_t(n)] = 0;
+                n--;
+                iter = 0;
+            }
+            else if (l == n - 1)
+            {
+                // Two roots found
+                w = H(n, n - 1) * H(n - 1, n);
+                p = (H(n - 1, n - 1) - H(n, n)) / 2;
+                q = p * p + w;
+                z = static_cast<SCALARTYPE>(std::sqrt(std::fabs(q)));
+                H(n, n) = H(n, n) + exshift;
+                H(n - 1, n - 1) = H(n - 1, n - 1) + exshift;
+                x = H(n, n);
+
+                if (q >= 0)
+                {
+                    // Real pair
+                    z = (p >= 0) ? (p + z) : (p - z);
+                    d[vcl_size_t(n) - 1] = x + z;
+                    d[vcl_size_t(n)] = d[vcl_size_t(n) - 1];
+                    if (z <= 0 && z >= 0) // z == 0 without compiler complaints
+                      d[vcl_size_t(n)] = x - w / z;
+                    e[vcl_size_t(n) - 1] = 0;
+                    e[vcl_size_t(n)] = 0;
+                    x = H(n, n - 1);
+                    s = std::fabs(x) + std::fabs(z);
+                    p = x / s;
+                    q = z / s;
+                    r = static_cast<SCALARTYPE>(std::sqrt(p * p + q * q));
+                    p = p / r;
+                    q = q / r;
+
+                    // Row modification
+                    for (int j = n - 1; j < nn; j++)
+                    {
+                        SCALARTYPE h_nj = H(n, j);
+                        z = H(n - 1, j);
+                        H(n - 1, j) = q * z + p * h_nj;
+                        H(n, j) = q * h_nj - p * z;
+                    }
+
+                    final_iter_update(H, n, n + 1, q, p);
+                    schur_vectors.rotate(n, nn, q, p);
+                }
+                else
+                {
+                    // Complex pair
+                    d[vcl_size_t(n) - 1] = x + p;
+                    d[vcl_size_t(n)] = x + p;
+                    e[vcl_size_t(n) - 1] = z;
+                    e[vcl_size_t(n)] = -z;
+                }
+
+                n = n - 2;
+                iter = 0;
+            }
+            else
+            {
+                // No convergence yet
+                if (max_iterations > 0 && iter >= max_iterations)
+                    return false;
+
+                // Form shift
+                x = H(n, n);
+                y = 0;
+                w = 0;
+                if (l < n)
+                {
+                    y = H(n - 1, n - 1);
+                    w = H(n, n - 1) * H(n - 1, n);
+                }
+
+                // Wilkinson's original ad hoc shift
+                if (iter == 10)
+                {
+                    exshift += x;
+                    for (int i = 0; i <= n; i++)
+                        H(i, i) -= x;
+
+                    s = std::fabs(H(n, n - 1)) + std::fabs(H(n - 1, n - 2));
+                    x = y = SCALARTYPE(0.75) * s;
+                    w = SCALARTYPE(-0.4375) * s * s;
+                }
+
+                // MATLAB's new ad hoc shift
+                if (iter == 30)
+                {
+                    s = (y - x) / 2;
+                    s = s * s + w;
+                    if (s > 0)
+                    {
+                        s = static_cast<SCALARTYPE>(std::sqrt(s));
+                        if (y < x) s = -s;
+                        s = x - w / ((y - x) / 2 + s);
+                        for (int i = 0; i <= n; i++)
+                            H(i, i) -= s;
+                        exshift += s;
+                        x = y = w = SCALARTYPE(0.964);
+                    }
+                }
+
+                iter = iter + 1;
+
+                // Look for two consecutive small sub-diagonal elements
+                int m = n - 2;
+                while (m >= l)
+                {
+                    SCALARTYPE h_m1_m1 = H(m + 1, m + 1);
+                    z = H(m, m);
+                    r = x - z;
+                    s = y - z;
+                    p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
+                    q = h_m1_m1 - z - r - s;
+                    r = H(m + 2, m + 1);
+                    s = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                    p = p / s;
+                    q = q / s;
+                    r = r / s;
+                    if (m == l)
+                        break;
+                    if (std::fabs(H(m, m - 1)) * (std::fabs(q) + std::fabs(r)) < eps * (std::fabs(p) * (std::fabs(H(m - 1, m - 1)) + std::fabs(z) + std::fabs(h_m1_m1))))
+                        break;
+                    m--;
+                }
+
+                for (int i = m + 2; i <= n; i++)
+                {
+                    H(i, i - 2) = 0;
+                    if (i > m + 2)
+                        H(i, i - 3) = 0;
+                }
+
+                // float QR step involving rows l:n and columns m:n
+                for (int k = m; k < n; k++)
+                {
+                    bool notlast = (k != n - 1);
+                    if (k != m)
+                    {
+                        p = H(k, k - 1);
+                        q = H(k + 1, k - 1);
+                        r = (notlast ? H(k + 2, k - 1) : 0);
+                        x = std::fabs(p) + std::fabs(q) + std::fabs(r);
+                        if (x > 0)
+                        {
+                            p = p / x;
+                            q = q / x;
+                            r = r / x;
+                        }
+                    }
+
+                    if (x <= 0 && x >= 0) break;  // x == 0 without compiler complaints
+
+                    s = static_cast<SCALARTYPE>(std::sqrt(p * p + q * q + r * r));
+                    if (p < 0) s = -s;
+
+                    if (s < 0 || s > 0)
+                    {
+                        if (k != m)
+                            H(k, k - 1) = -s * x;
+                        else
+                            if (l != m)
+                                H(k, k - 1) = -H(k, k - 1);
+
+                        p = p + s;
+                        y = q / s;
+                        z = r / s;
+                        x = p / s;
+                        q = q / p;
+                        r = r / p;
+
+                        buf[5 * vcl_size_t(k)] = x;
+                        buf[5 * vcl_size_t(k) + 1] = y;
+                        buf[5 * vcl_size_t(k) + 2] = z;
+                        buf[5 * vcl_size_t(k) + 3] = q;
+                        buf[5 * vcl_size_t(k) + 4] = r;
+
+
+                        SCALARTYPE* a_row_k = H.row(k);
+                        SCALARTYPE* a_row_k_1 = H.row(k + 1);
+                        SCALARTYPE* a_row_k_2 = H.row(k + 2);
+                        // Row modification
+                        for (int j = k; j < nn; j++)
+                        {
+                            SCALARTYPE h_kj = a_row_k[j];
+                            SCALARTYPE h_k1_j = a_row_k_1[j];
+
+                            p = h_kj + q * h_k1_j;
+                            if (notlast)
+                            {
+                                SCALARTYPE h_k2_j = a_row_k_2[j];
+                                p = p + r * h_k2_j;
+                                a_row_k_2[j] = h_k2_j - p * z;
+                            }
+
+                            a_row_k[j] = h_kj - p * x;
+                            a_row_k_1[j] = h_k1_j - p * y;
+                        }
+
+                        //H(k + 1, nn - 1) = h_kj;
+
+
+                        // Column modification
+                        for (int i = k; i < std::min(nn, k + 4); i++)
+                        {
+                            p = x * H(i, k) + y * H(i, k + 1);
+                            if (notlast)
+                            {
+                                p = p + z * H(i, k + 2);
+                                H(i, k + 2) = H(i, k + 2) - p * r;
+                            }
+
+                            H(i, k) = H(i, k) - p;
+                            H(i, k + 1) = H(i, k + 1) - p * q;
+                        }
+                    }
+                    else
+                    {
+                        buf[5 * vcl_size_t(k)] = 0;
+                        buf[5 * vcl_size_t(k) + 1] = 0;
+                        buf[5 * vcl_size_t(k) + 2] = 0;
+                        buf[5 * vcl_size_t(k) + 3] = 0;
+                        buf[5 * vcl_size_t(k) + 4] = 0;
+                    }
+                }
+
+                update_float_QR_column<SCALARTYPE>(H, buf, m, n, n, true);
+                schur_vectors.update_qr_column(buf, m, n, nn);
+            }
+        }
+
+        return true;
+    }
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -42,6 +42,8 @@
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/detail/ilu/common.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/block_compressed_matrix.hpp"
+#include "viennacl/mixed_precision_compressed_matrix.hpp"
 #include "viennacl/backend/memory.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
@@ -140,6 +142,80 @@ void precondition(viennacl::compressed_matrix<NumericT> & A, ilu0_tag const & /*
 }
 
 
+/** @brief Implementation of a block ILU-preconditioner with static pattern for block_compressed_matrix.
+  *
+  * The scalar operations of the algorithm in Saad's book are replaced by operations on the dense blocks, where divisions become multiplications with the inverse diagonal blocks of U.
+  * The unit lower triangular blocks of L and the upper triangular blocks of U are stored in the off-diagonal blocks of A, the diagonal blocks of A are overwritten by the inverses of the diagonal blocks of U.
+  * The block column indices within each block row are sorted (cf. copy() for block_compressed_matrix).
+  *
+  *  @param A       The sparse matrix matrix. The result is directly written to A.
+  */
+template<typename NumericT, unsigned int BlockSize>
+void precondition(viennacl::block_compressed_matrix<NumericT, BlockSize> & A, ilu0_tag const & /* tag */)
+{
+  typedef viennacl::linalg::host_based::detail::bsr_block<NumericT, BlockSize>   block_ops;
+  vcl_size_t const block_entries = BlockSize * BlockSize;
+
+  assert( (A.handle1().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
+  assert( (A.handle2().get_active_handle_id() == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
+  assert( (A.handle().get_active_handle_id()  == viennacl::MAIN_MEMORY) && bool("System matrix must reside in main memory for ILU0") );
+  assert( (A.size1() == A.size2()) && bool("Block ILU0 requires a square matrix") );
+
+  NumericT           * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
+  unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
+
+  NumericT block_tmp[BlockSize * BlockSize];
+
+  for (vcl_size_t i = 0; i < A.block_rows(); ++i)
+  {
+    unsigned int row_i_begin = row_buffer[i];
+    unsigned int row_i_end   = row_buffer[i+1];
+    unsigned int buf_index_ii = row_i_end;
+
+    for (unsigned int buf_index_k = row_i_begin; buf_index_k < row_i_end; ++buf_index_k)
+    {
+      unsigned int k = col_buffer[buf_index_k];
+      if (k >= i)
+      {
+        if (k == i)
+          buf_index_ii = buf_index_k;
+        break;
+      }
+
+      // A_ik = A_ik * inv(U_kk), the inverse is stored in the diagonal block of the already processed row k:
+      unsigned int row_k_begin = row_buffer[k];
+      unsigned int row_k_end   = row_buffer[k+1];
+      unsigned int buf_index_kk = static_cast<unsigned int>(std::lower_bound(col_buffer + row_k_begin, col_buffer + row_k_end, k) - col_buffer);
+
+      NumericT * a_ik = elements + buf_index_k * block_entries;
+      std::copy(a_ik, a_ik + block_entries, block_tmp);
+      block_ops::mat_prod(block_tmp, elements + buf_index_kk * block_entries, a_ik);
+
+      // A_ij -= A_ik * U_kj for all j > k present in both row i and row k:
+      unsigned int buf_index_j = buf_index_k + 1;
+      for (unsigned int buf_index_kj = buf_index_kk + 1; buf_index_kj < row_k_end; ++buf_index_kj)
+      {
+        while (buf_index_j < row_i_end && col_buffer[buf_index_j] < col_buffer[buf_index_kj])
+          ++buf_index_j;
+        if (buf_index_j == row_i_end)
+          break;
+        if (col_buffer[buf_index_j] == col_buffer[buf_index_kj])
+          block_ops::mat_prod_sub(a_ik, elements + buf_index_kj * block_entries, elements + buf_index_j * block_entries);
+      }
+    }
+
+    if (buf_index_ii == row_i_end)
+      throw zero_on_diagonal_exception("ViennaCL: Missing diagonal block encountered while computing block ILU0!");
+
+    NumericT * a_ii = elements + buf_index_ii * block_entries;
+    std::copy(a_ii, a_ii + block_entries, block_tmp);
+    if (!block_ops::invert(block_tmp, a_ii))
+      throw zero_on_diagonal_exception("ViennaCL: Singular diagonal block encountered while computing block ILU0!");
+  }
+}
+
+
 /** @brief ILU0 preconditioner class, can be supplied to solve()-routines
 */
 template<typename MatrixT>
@@ -369,6 +445,123 @@ private:
 
 };
 
+
+/** @brief ILU0 preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for block_compressed_matrix: Block ILU0 with dense diagonal blocks, computed and applied on the host.
+*/
+template<typename NumericT, unsigned int BlockSize>
+class ilu0_precond< viennacl::block_compressed_matrix<NumericT, BlockSize> >
+{
+  typedef viennacl::block_compressed_matrix<NumericT, BlockSize>   MatrixType;
+
+public:
+  ilu0_precond(MatrixType const & mat, ilu0_tag const & tag) : tag_(tag), LU_(viennacl::context(viennacl::MAIN_MEMORY))
+  {
+    init(mat);
+  }
+
+  void apply(viennacl::vector<NumericT> & vec) const
+  {
+    assert(LU_.size1() == vec.size() && bool("Size mismatch"));
+
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::context old_context = viennacl::traits::context(vec);
+    if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+      viennacl::switch_memory_context(vec, host_context);
+
+    // the substitution operates on whole blocks, hence on a copy of vec padded to a multiple of the block size:
+    NumericT * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+    std::copy(vec_buffer, vec_buffer + vec.size(), padded_vec_.begin());
+    viennacl::linalg::host_based::detail::bsr_inplace_solve_lu<NumericT, BlockSize>(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle1()),
+                                                                                   viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2()),
+                                                                                   viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(LU_.handle()),
+                                                                                   LU_.block_rows(), &(padded_vec_[0]));
+    std::copy(padded_vec_.begin(), padded_vec_.begin() + static_cast<long>(vec.size()), vec_buffer);
+
+    if (old_context.memory_type() != viennacl::MAIN_MEMORY)
+      viennacl::switch_memory_context(vec, old_context);
+  }
+
+private:
+  void init(MatrixType const & mat)
+  {
+    std::vector<unsigned int> block_row_buffer, block_col_buffer;
+    std::vector<NumericT> elements;
+    viennacl::detail::read_block_compressed_matrix(mat, block_row_buffer, block_col_buffer, elements);
+    LU_.set(&(block_row_buffer[0]),
+            block_col_buffer.size() ? &(block_col_buffer[0]) : NULL,
+            elements.size() ? &(elements[0]) : NULL,
+            mat.size1(), mat.size2(), mat.nnz_blocks());
+
+    viennacl::linalg::precondition(LU_, tag_);
+    padded_vec_.resize(LU_.block_rows() * BlockSize);
+  }
+
+  ilu0_tag                         tag_;
+  MatrixType                       LU_;
+  mutable std::vector<NumericT>    padded_vec_;
+};
+
+/** @brief ILU0 preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for mixed_precision_compressed_matrix: The factorization is computed on the host in full precision, but the factors are stored in StorageT.
+*  The substitutions accumulate in NumericT, hence only the memory traffic for the factors is reduced.
+*/
+template<typename NumericT, typename StorageT>
+class ilu0_precond< viennacl::mixed_precision_compressed_matrix<NumericT, StorageT> >
+{
+  typedef viennacl::mixed_precision_compressed_matrix<NumericT, StorageT>   MatrixType;
+
+public:
+  /** @brief Computes the factors from the full precision system matrix */
+  ilu0_precond(viennacl::compressed_matrix<NumericT> const & mat, ilu0_tag const & tag) : tag_(tag), LU_(viennacl::context(viennacl::MAIN_MEMORY))
+  {
+    viennacl::compressed_matrix<NumericT> LU_full(mat.size1(), mat.size2(), viennacl::context(viennacl::MAIN_MEMORY));
+    LU_full = mat;
+    init(LU_full);
+  }
+
+  /** @brief Computes the factors from the system matrix with values already rounded to StorageT */
+  ilu0_precond(MatrixType const & mat, ilu0_tag const & tag) : tag_(tag), LU_(viennacl::context(viennacl::MAIN_MEMORY))
+  {
+    viennacl::compressed_matrix<NumericT> LU_full(viennacl::context(viennacl::MAIN_MEMORY));
+    viennacl::copy(mat, LU_full);
+    init(LU_full);
+  }
+
+  void apply(viennacl::vector<NumericT> & vec) const
+  {
+    assert(LU_.size1() == vec.size() && bool("Size mismatch"));
+
+    viennacl::context host_context(viennacl::MAIN_MEMORY);
+    viennacl::context old_context = viennacl::traits::context(vec);
+    if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
+      viennacl::switch_memory_context(vec, host_context);
+
+    unsigned int const * row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle1());
+    unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU_.handle2());
+    StorageT     const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<StorageT>(LU_.handle());
+    NumericT           * vec_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, LU_.size2(), unit_lower_tag());
+    viennacl::linalg::host_based::detail::csr_inplace_solve<NumericT>(row_buffer, col_buffer, elements, vec_buffer, LU_.size2(), upper_tag());
+
+    if (old_context.memory_type() != viennacl::MAIN_MEMORY)
+      viennacl::switch_memory_context(vec, old_context);
+  }
+
+private:
+  void init(viennacl::compressed_matrix<NumericT> & LU_full)
+  {
+    viennacl::linalg::precondition(LU_full, tag_);
+    viennacl::copy(LU_full, LU_);
+  }
+
+  ilu0_tag     tag_;
+  MatrixType   LU_;
+};
+
 } // namespace linalg
 } // namespace viennacl
 
@@ -0,0 +1,107 @@
+#ifndef VIENNACL_LINALG_DETAIL_SYMMETRIC_JACOBI_HPP_
+#define VIENNACL_LINALG_DETAIL_SYMMETRIC_JACOBI_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/symmetric_jacobi.hpp
+ *
+ * @brief Eigendecomposition of small dense symmetric matrices on the host, as needed for projected problems (Rayleigh-Ritz, Gram matrices).
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+
+#include "viennacl/forwards.h"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace detail
+{
+
+/** @brief Cyclic Jacobi method for a small symmetric matrix G (column-major, n-by-n).
+*
+* On exit, the diagonal of G holds the eigenvalues and the columns of W hold the eigenvectors.
+*/
+template<typename NumericT>
+void symmetric_jacobi_eigen(std::vector<NumericT> & G, vcl_size_t n, std::vector<NumericT> & W)
+{
+  W.assign(n * n, NumericT(0));
+  for (vcl_size_t i = 0; i < n; ++i)
+    W[i + i * n] = NumericT(1);
+
+  NumericT eps = std::numeric_limits<NumericT>::epsilon();
+  for (vcl_size_t sweep = 0; sweep < 100; ++sweep)
+  {
+    NumericT off_norm  = 0;
+    NumericT diag_norm = 0;
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      diag_norm += G[j + j * n] * G[j + j * n];
+      for (vcl_size_t i = 0; i < j; ++i)
+        off_norm += G[i + j * n] * G[i + j * n];
+    }
+    if (off_norm <= eps * eps * diag_norm)
+      break;
+
+    for (vcl_size_t p = 0; p < n; ++p)
+      for (vcl_size_t q = p + 1; q < n; ++q)
+      {
+        NumericT g_pq = G[p + q * n];
+        if (g_pq == NumericT(0))
+          continue;
+
+        NumericT theta = (G[q + q * n] - G[p + p * n]) / (NumericT(2) * g_pq);
+        NumericT t = NumericT(1) / (std::fabs(theta) + std::sqrt(theta * theta + NumericT(1)));
+        if (theta < 0)
+          t = -t;
+        NumericT c = NumericT(1) / std::sqrt(t * t + NumericT(1));
+        NumericT s = t * c;
+
+        for (vcl_size_t k = 0; k < n; ++k) // G <- G J
+        {
+          NumericT g_kp = G[k + p * n];
+          NumericT g_kq = G[k + q * n];
+          G[k + p * n] = c * g_kp - s * g_kq;
+          G[k + q * n] = s * g_kp + c * g_kq;
+        }
+        for (vcl_size_t k = 0; k < n; ++k) // G <- J^T G
+        {
+          NumericT g_pk = G[p + k * n];
+          NumericT g_qk = G[q + k * n];
+          G[p + k * n] = c * g_pk - s * g_qk;
+          G[q + k * n] = s * g_pk + c * g_qk;
+        }
+        for (vcl_size_t k = 0; k < n; ++k) // W <- W J
+        {
+          NumericT w_kp = W[k + p * n];
+          NumericT w_kq = W[k + q * n];
+          W[k + p * n] = c * w_kp - s * w_kq;
+          W[k + q * n] = s * w_kp + c * w_kq;
+        }
+      }
+  }
+}
+
+} //namespace detail
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -29,6 +29,7 @@
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/direct_solve.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -63,6 +64,7 @@ namespace detail
   {
     assert( (viennacl::traits::size1(A) == viennacl::traits::size2(A)) && bool("Size check failed in inplace_solve(): size1(A) != size2(A)"));
     assert( (viennacl::traits::size1(A) == viennacl::traits::size1(B)) && bool("Size check failed in inplace_solve(): size1(A) != size1(B)"));
+    VIENNACL_PROFILE_SCOPE("direct_solve::inplace_solve (matrix)", 0, 0);
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
@@ -98,6 +100,7 @@ namespace detail
     assert( (mat.size1() == vec.size()) && bool("Size check failed in inplace_solve(): size1(A) != size(b)"));
     assert( (mat.size2() == vec.size()) && bool("Size check failed in inplace_solve(): size2(A) != size(b)"));
 
+    VIENNACL_PROFILE_SCOPE("direct_solve::inplace_solve (vector)", 0, 0);
     switch (viennacl::traits::handle(mat).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
@@ -127,7 +130,7 @@ namespace detail
     typedef typename viennacl::result_of::cpu_value_type<MatrixT1>::type  NumericType;
 
     vcl_size_t blockSize = VIENNACL_DIRECT_SOLVE_BLOCKSIZE;
-    if (A.size1() <= blockSize)
+    if (A.size1() <= blockSize || viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY) // host backend takes care of blocking itself
       inplace_solve_kernel(A, B, SolverTagT());
     else
     {
@@ -169,7 +172,7 @@ namespace detail
     typedef typename viennacl::result_of::cpu_value_type<MatrixT1>::type  NumericType;
 
     int blockSize = VIENNACL_DIRECT_SOLVE_BLOCKSIZE;
-    if (static_cast<int>(A.size1()) <= blockSize)
+    if (static_cast<int>(A.size1()) <= blockSize || viennacl::traits::active_handle_id(A) == viennacl::MAIN_MEMORY) // host backend takes care of blocking itself
       inplace_solve_kernel(A, B, SolverTagT());
     else
     {
@@ -24,6 +24,7 @@
 
 #include <viennacl/vector.hpp>
 #include <viennacl/matrix.hpp>
+#include "viennacl/tools/profiler.hpp"
 
 #include "viennacl/linalg/host_based/fft_operations.hpp"
 
@@ -54,6 +55,7 @@ void direct(viennacl::vector<NumericT, AlignmentV> const & in,
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
 
+  VIENNACL_PROFILE_SCOPE("fft::direct", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -92,6 +94,7 @@ void direct(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const &
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
 
+  VIENNACL_PROFILE_SCOPE("fft::direct", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -126,6 +129,7 @@ void reorder(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_si
              vcl_size_t bits_datasize, vcl_size_t batch_num,
              viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
+  VIENNACL_PROFILE_SCOPE("fft::reorder", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -163,6 +167,7 @@ void radix2(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> & in, vc
             vcl_size_t stride, vcl_size_t batch_num, NumericT sign = NumericT(-1),
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
+  VIENNACL_PROFILE_SCOPE("fft::radix2", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -200,6 +205,7 @@ void radix2(viennacl::vector<NumericT, AlignmentV>& in, vcl_size_t size, vcl_siz
             viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::DATA_ORDER data_order = viennacl::linalg::host_based::detail::fft::FFT_DATA_ORDER::ROW_MAJOR)
 {
 
+  VIENNACL_PROFILE_SCOPE("fft::radix2", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -236,6 +242,7 @@ void bluestein(viennacl::vector<NumericT, AlignmentV> & in,
                viennacl::vector<NumericT, AlignmentV> & out, vcl_size_t /*batch_num*/)
 {
 
+  VIENNACL_PROFILE_SCOPE("fft::bluestein", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -268,6 +275,7 @@ void multiply_complex(viennacl::vector<NumericT, AlignmentV> const & input1,
                       viennacl::vector<NumericT, AlignmentV> const & input2,
                       viennacl::vector<NumericT, AlignmentV>       & output)
 {
+  VIENNACL_PROFILE_SCOPE("fft::multiply_complex", 0, 0);
   switch (viennacl::traits::handle(input1).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -298,6 +306,7 @@ void multiply_complex(viennacl::vector<NumericT, AlignmentV> const & input1,
 template<typename NumericT, unsigned int AlignmentV>
 void normalize(viennacl::vector<NumericT, AlignmentV> & input)
 {
+  VIENNACL_PROFILE_SCOPE("fft::normalize", 0, 0);
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -328,6 +337,7 @@ void normalize(viennacl::vector<NumericT, AlignmentV> & input)
 template<typename NumericT, unsigned int AlignmentV>
 void transpose(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> & input)
 {
+  VIENNACL_PROFILE_SCOPE("fft::transpose", 0, 0);
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -359,6 +369,7 @@ template<typename NumericT, unsigned int AlignmentV>
 void transpose(viennacl::matrix<NumericT, viennacl::row_major, AlignmentV> const & input,
                viennacl::matrix<NumericT, viennacl::row_major, AlignmentV>       & output)
 {
+  VIENNACL_PROFILE_SCOPE("fft::transpose", 0, 0);
   switch (viennacl::traits::handle(input).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -390,6 +401,7 @@ template<typename NumericT>
 void real_to_complex(viennacl::vector_base<NumericT> const & in,
                      viennacl::vector_base<NumericT>       & out, vcl_size_t size)
 {
+  VIENNACL_PROFILE_SCOPE("fft::real_to_complex", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
     case viennacl::MAIN_MEMORY:
@@ -421,6 +433,7 @@ template<typename NumericT>
 void complex_to_real(viennacl::vector_base<NumericT> const & in,
                      viennacl::vector_base<NumericT>       & out, vcl_size_t size)
 {
+  VIENNACL_PROFILE_SCOPE("fft::complex_to_real", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -451,6 +464,7 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
 template<typename NumericT>
 void reverse(viennacl::vector_base<NumericT> & in)
 {
+  VIENNACL_PROFILE_SCOPE("fft::reverse", 0, 0);
   switch (viennacl::traits::handle(in).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -25,6 +25,9 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <complex>
+#include <stdexcept>
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/norm_2.hpp"
@@ -37,6 +40,9 @@
 
 #include "viennacl/linalg/iterative_operations.hpp"
 #include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/detail/hessenberg_qr.hpp"
 
 
 namespace viennacl
@@ -56,7 +62,7 @@ public:
   * @param krylov_dim     The maximum dimension of the Krylov space before restart (number of restarts is found by max_iterations / krylov_dim)
   */
   gmres_tag(double tol = 1e-10, unsigned int max_iterations = 300, unsigned int krylov_dim = 20)
-   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim), iters_taken_(0) {}
+   : tol_(tol), abs_tol_(0), iterations_(max_iterations), krylov_dim_(krylov_dim), s_step_(0), deflation_dim_(0), flexible_(false), iters_taken_(0) {}
 
   /** @brief Returns the relative tolerance */
   double tolerance() const { return tol_; }
@@ -79,6 +85,21 @@ public:
     return ret;
   }
 
+  /** @brief Returns the number of Krylov vectors generated per block by the communication-avoiding (s-step) GMRES. Values below 2 select the classical GMRES. */
+  unsigned int s_step() const { return s_step_; }
+  /** @brief Enables the communication-avoiding (s-step) GMRES, which generates and orthogonalizes 's' Krylov vectors at a time. Pass 0 to disable. */
+  void s_step(unsigned int s) { s_step_ = s; }
+
+  /** @brief Returns the number of harmonic Ritz vectors kept at each restart (GMRES-DR). Zero for the classical restarted GMRES. */
+  unsigned int deflation_dim() const { return deflation_dim_; }
+  /** @brief Enables GMRES with deflated restarting (GMRES-DR), which keeps 'k' approximate eigenvectors for the eigenvalues of smallest magnitude when restarting. Must be smaller than krylov_dim() - 1. */
+  void deflation_dim(unsigned int k) { deflation_dim_ = k; }
+
+  /** @brief Returns true if the flexible GMRES (FGMRES) is used, which allows for preconditioners varying from one iteration to the next. */
+  bool flexible() const { return flexible_; }
+  /** @brief Enables the flexible GMRES (FGMRES). Requires storage for another krylov_dim() vectors. */
+  void flexible(bool b) { flexible_ = b; }
+
   /** @brief Return the number of solver iterations: */
   unsigned int iters() const { return iters_taken_; }
   /** @brief Set the number of solver iterations (should only be modified by the solver) */
@@ -94,6 +115,9 @@ private:
   double abs_tol_;
   unsigned int iterations_;
   unsigned int krylov_dim_;
+  unsigned int s_step_;
+  unsigned int deflation_dim_;
+  bool flexible_;
 
   //return values from solver
   mutable unsigned int iters_taken_;
@@ -366,6 +390,1108 @@ namespace detail
     return result;
   }
 
+  //
+  // Small dense helpers on the host for the s-step GMRES and the GMRES with deflated restarting
+  //
+
+  /** @brief Computes the eigenvalues of a small upper Hessenberg matrix on the host using the Francis double shift QR algorithm (see detail::hqr_schur_form()).
+  *
+  * Used for obtaining the Ritz values from which the shifts of the Newton basis in the s-step GMRES are taken, and the harmonic Ritz values in GMRES-DR.
+  *
+  * @param H      Hessenberg matrix, column-major with leading dimension 'ld'. Only the leading n-by-n block is used.
+  * @param ld     Leading dimension of H
+  * @param n      Size of the matrix
+  * @param wr     Real parts of the eigenvalues (output)
+  * @param wi     Imaginary parts of the eigenvalues (output)
+  * @return false if the iteration did not converge
+  */
+  template<typename NumericT>
+  bool gmres_hessenberg_eigenvalues(std::vector<NumericT> const & H, vcl_size_t ld, vcl_size_t n,
+                                     std::vector<NumericT> & wr, std::vector<NumericT> & wi)
+  {
+    FastMatrix<NumericT> A(n, n);
+    for (vcl_size_t i=0; i<n; ++i)
+      for (vcl_size_t j=0; j<n; ++j)
+        A(int(i), int(j)) = H[i + j*ld];
+
+    wr.resize(n);
+    wi.resize(n);
+
+    NumericT norm = 0;
+    hqr_no_schur_vectors<NumericT> no_schur_vectors;
+    return hqr_schur_form(A, int(n), wr, wi, std::numeric_limits<NumericT>::epsilon(), norm, no_schur_vectors, 100);
+  }
+
+  /** @brief Reduces a small dense matrix (column-major, leading dimension 'ld') to upper Hessenberg form by Householder similarity transformations on the host. Eigenvalues are preserved. */
+  template<typename NumericT>
+  void gmres_hessenberg_reduction(std::vector<NumericT> & A, vcl_size_t ld, vcl_size_t n)
+  {
+    std::vector<NumericT> v(n);
+    for (vcl_size_t k=0; k+2<n; ++k)
+    {
+      NumericT alpha = 0;
+      for (vcl_size_t i=k+1; i<n; ++i)
+        alpha += A[i + k*ld] * A[i + k*ld];
+      alpha = std::sqrt(alpha);
+      if (!(alpha > 0))
+        continue;
+      if (A[k+1 + k*ld] > 0)
+        alpha = -alpha;
+
+      // v = x - alpha e_1, normalized:
+      NumericT norm_v = 0;
+      for (vcl_size_t i=k+1; i<n; ++i)
+      {
+        v[i] = A[i + k*ld];
+        if (i == k+1)
+          v[i] -= alpha;
+        norm_v += v[i] * v[i];
+      }
+      norm_v = std::sqrt(norm_v);
+      if (!(norm_v > 0))
+        continue;
+      for (vcl_size_t i=k+1; i<n; ++i)
+        v[i] /= norm_v;
+
+      // A <- (I - 2 v v^T) A (I - 2 v v^T):
+      for (vcl_size_t j=0; j<n; ++j)
+      {
+        NumericT dot = 0;
+        for (vcl_size_t i=k+1; i<n; ++i)
+          dot += v[i] * A[i + j*ld];
+        for (vcl_size_t i=k+1; i<n; ++i)
+          A[i + j*ld] -= NumericT(2) * dot * v[i];
+      }
+      for (vcl_size_t i=0; i<n; ++i)
+      {
+        NumericT dot = 0;
+        for (vcl_size_t j=k+1; j<n; ++j)
+          dot += A[i + j*ld] * v[j];
+        for (vcl_size_t j=k+1; j<n; ++j)
+          A[i + j*ld] -= NumericT(2) * dot * v[j];
+      }
+    }
+  }
+
+  /** @brief Solves a small dense system (column-major, leading dimension n) by Gaussian elimination with partial pivoting on the host. Works for real and std::complex<> entries.
+  *
+  * Exactly singular pivots are replaced by a tiny value, which is what inverse iteration with an eigenvalue as shift requires.
+  */
+  template<typename ScalarT, typename NumericT>
+  void gmres_small_dense_solve(std::vector<ScalarT> A, vcl_size_t n, std::vector<ScalarT> & b, NumericT tiny)
+  {
+    for (vcl_size_t k=0; k<n; ++k)
+    {
+      vcl_size_t pivot = k;
+      for (vcl_size_t i=k+1; i<n; ++i)
+        if (std::abs(A[i + k*n]) > std::abs(A[pivot + k*n]))
+          pivot = i;
+      if (pivot != k)
+      {
+        for (vcl_size_t j=k; j<n; ++j)
+          std::swap(A[k + j*n], A[pivot + j*n]);
+        std::swap(b[k], b[pivot]);
+      }
+      if (!(std::abs(A[k + k*n]) > tiny))
+        A[k + k*n] = ScalarT(tiny);
+
+      for (vcl_size_t i=k+1; i<n; ++i)
+      {
+        ScalarT factor = A[i + k*n] / A[k + k*n];
+        for (vcl_size_t j=k+1; j<n; ++j)
+          A[i + j*n] -= factor * A[k + j*n];
+        b[i] -= factor * b[k];
+      }
+    }
+
+    for (vcl_size_t i2=n; i2>0; --i2)
+    {
+      vcl_size_t i = i2 - 1;
+      for (vcl_size_t j=i+1; j<n; ++j)
+        b[i] -= A[i + j*n] * b[j];
+      b[i] /= A[i + i*n];
+    }
+  }
+
+  //
+  // Communication-avoiding (s-step) GMRES
+  //
+
+  /** @brief Sorts the Ritz values in modified Leja order, keeping complex conjugate pairs adjacent (positive imaginary part first).
+  *
+  * The Leja ordering keeps the Newton basis well-conditioned, cf. Bai, Hu, and Reichel: "A Newton basis GMRES implementation".
+  */
+  template<typename NumericT>
+  void s_step_leja_order(std::vector<NumericT> const & wr, std::vector<NumericT> const & wi,
+                         std::vector<NumericT> & shifts_re, std::vector<NumericT> & shifts_im)
+  {
+    // one representative per conjugate pair:
+    std::vector<NumericT> cand_re, cand_im;
+    for (vcl_size_t i=0; i<wr.size(); ++i)
+    {
+      if (wi[i] < 0)
+        continue;
+      cand_re.push_back(wr[i]);
+      cand_im.push_back(wi[i]);
+    }
+
+    shifts_re.clear();
+    shifts_im.clear();
+    std::vector<bool> taken(cand_re.size(), false);
+    for (vcl_size_t count=0; count<cand_re.size(); ++count)
+    {
+      vcl_size_t best = cand_re.size();
+      NumericT best_value = 0;
+      for (vcl_size_t i=0; i<cand_re.size(); ++i)
+      {
+        if (taken[i])
+          continue;
+
+        // modulus for the first shift, sum of logarithmic distances to all previous shifts otherwise:
+        NumericT value = std::sqrt(cand_re[i] * cand_re[i] + cand_im[i] * cand_im[i]);
+        if (count > 0)
+        {
+          value = 0;
+          for (vcl_size_t j=0; j<shifts_re.size(); ++j)
+          {
+            NumericT dist = std::sqrt((cand_re[i] - shifts_re[j]) * (cand_re[i] - shifts_re[j]) + (cand_im[i] - shifts_im[j]) * (cand_im[i] - shifts_im[j]));
+            value += std::log(std::max(dist, std::numeric_limits<NumericT>::min()));
+          }
+        }
+
+        if (best == cand_re.size() || value > best_value)
+        {
+          best = i;
+          best_value = value;
+        }
+      }
+
+      taken[best] = true;
+      shifts_re.push_back(cand_re[best]);
+      shifts_im.push_back(cand_im[best]);
+      if (cand_im[best] > 0)
+      {
+        shifts_re.push_back(cand_re[best]);
+        shifts_im.push_back(-cand_im[best]);
+      }
+    }
+  }
+
+  /** @brief Computes the inner products of the columns 0, ..., j+t of the Krylov basis with the block of columns j+1, ..., j+t in a single reduction and copies the result to the host. */
+  template<typename NumericT>
+  void s_step_block_gram(viennacl::matrix<NumericT, viennacl::column_major> & basis,
+                         viennacl::matrix<NumericT, viennacl::column_major> & device_buffer,
+                         std::vector<NumericT> & host_buffer,
+                         vcl_size_t j, vcl_size_t t)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>    MatrixType;
+
+    viennacl::range all_rows(0, basis.size1());
+    viennacl::matrix_range<MatrixType> Q_all(basis, all_rows, viennacl::range(0, j + t + 1));
+    viennacl::matrix_range<MatrixType> W(basis, all_rows, viennacl::range(j + 1, j + t + 1));
+    viennacl::matrix_range<MatrixType> G(device_buffer, viennacl::range(0, j + t + 1), viennacl::range(0, t));
+
+    G = viennacl::linalg::prod(trans(Q_all), W);
+    viennacl::backend::memory_read(device_buffer.handle(), 0, sizeof(NumericT) * host_buffer.size(), &(host_buffer[0]));
+  }
+
+  /** @brief Replaces the block of columns j+1, ..., j+t of the Krylov basis by the linear combination of columns 0, ..., j+t given by the (column-major) coefficients on the host. */
+  template<typename NumericT>
+  void s_step_block_update(viennacl::matrix<NumericT, viennacl::column_major> & basis,
+                           viennacl::matrix<NumericT, viennacl::column_major> & device_buffer,
+                           std::vector<NumericT> const & host_buffer,
+                           viennacl::matrix<NumericT, viennacl::column_major> & block_buffer,
+                           vcl_size_t j, vcl_size_t t)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>    MatrixType;
+
+    viennacl::backend::memory_write(device_buffer.handle(), 0, sizeof(NumericT) * host_buffer.size(), &(host_buffer[0]));
+
+    viennacl::range all_rows(0, basis.size1());
+    viennacl::matrix_range<MatrixType> Q_all(basis, all_rows, viennacl::range(0, j + t + 1));
+    viennacl::matrix_range<MatrixType> W(basis, all_rows, viennacl::range(j + 1, j + t + 1));
+    viennacl::matrix_range<MatrixType> coeffs(device_buffer, viennacl::range(0, j + t + 1), viennacl::range(0, t));
+    viennacl::matrix_range<MatrixType> W_new(block_buffer, all_rows, viennacl::range(0, t));
+
+    W_new = viennacl::linalg::prod(Q_all, coeffs);
+    W = W_new;
+  }
+
+  /** @brief Cholesky factorization S = R^T R of the small projected Gram matrix of a block on the host.
+  *
+  * @return The number of leading columns for which the factorization succeeded with a pivot of at least 'threshold' times the squared column norm
+  */
+  template<typename NumericT>
+  vcl_size_t s_step_cholesky(std::vector<NumericT> & S, std::vector<NumericT> const & col_norms_squared, vcl_size_t t, NumericT threshold, NumericT & min_ratio)
+  {
+    min_ratio = 1;
+    for (vcl_size_t i=0; i<t; ++i)
+    {
+      NumericT d = S[i + i*t];
+      for (vcl_size_t l=0; l<i; ++l)
+        d -= S[l + i*t] * S[l + i*t];
+
+      if (d <= threshold * col_norms_squared[i])
+        return i;
+      min_ratio = std::min(min_ratio, d / col_norms_squared[i]);
+
+      d = std::sqrt(d);
+      S[i + i*t] = d;
+      for (vcl_size_t c=i+1; c<t; ++c)
+      {
+        NumericT val = S[i + c*t];
+        for (vcl_size_t l=0; l<i; ++l)
+          val -= S[l + i*t] * S[l + c*t];
+        S[i + c*t] = val / d;
+      }
+    }
+    return t;
+  }
+
+  /** @brief Implementation of the communication-avoiding (s-step) GMRES.
+  *
+  * Following Hoemmen: "Communication-avoiding Krylov subspace methods", PhD thesis, UC Berkeley, 2010.
+  * Within each restart cycle, blocks of s Krylov vectors are generated with a Newton basis (shifts are the Leja-ordered Ritz values from the first cycle)
+  * and orthogonalized against the previous basis vectors and among themselves by a single block Gram-Schmidt/CholQR step.
+  * Hence, only one reduction is required per block of s vectors rather than per vector.
+  * If the Cholesky factorization indicates a loss of orthogonality, a second orthogonalization pass is carried out (CholQR2).
+  *
+  * @param A            The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param precond      A preconditioner. Precondition operation is done via member function apply()
+  * @param monitor      A callback routine which is called at each GMRES restart
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> s_step_solve(MatrixT const & A,
+                                          viennacl::vector<NumericT> const & rhs,
+                                          gmres_tag const & tag,
+                                          PreconditionerT const & precond,
+                                          bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                          void *monitor_data = NULL)
+  {
+    typedef viennacl::matrix<NumericT, viennacl::column_major>    MatrixType;
+
+    vcl_size_t n = rhs.size();
+    viennacl::context ctx = viennacl::traits::context(rhs);
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(n, ctx);
+
+    vcl_size_t m = std::min<vcl_size_t>(tag.krylov_dim(), n); // see solve_impl()
+    vcl_size_t s = std::max<vcl_size_t>(std::min<vcl_size_t>(tag.s_step(), m), 1);
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    tag.iters(0);
+    tag.error(0);
+    if (norm_rhs <= tag.abs_tolerance()) //solution is zero if RHS norm is zero
+      return result;
+
+    MatrixType basis(n, m + 1, ctx);
+    MatrixType block_buffer(n, s, ctx);
+    MatrixType device_small(m + 1, s, ctx); // Gram matrix of a block and coefficients for updating a block
+    std::vector<NumericT> host_small(device_small.internal_size());
+    viennacl::vector<NumericT> residual(n, ctx);
+    viennacl::vector<NumericT> temp(n, ctx);
+    viennacl::vector<NumericT> device_y(m, ctx);
+
+    vcl_size_t ld = m + 1;
+    std::vector<NumericT> H(ld * m);                 // Hessenberg matrix, column-major
+    std::vector<NumericT> H_rot(ld * m);             // Hessenberg matrix after Givens rotations
+    std::vector<NumericT> givens_c(m), givens_s(m);
+    std::vector<NumericT> g(m + 1);
+    std::vector<NumericT> y(m);
+
+    std::vector<NumericT> shifts_re, shifts_im;
+    bool have_shifts = (s == 1);                   // s = 1 is the classical Arnoldi process and needs no shifts
+
+    NumericT reorth_threshold = std::sqrt(std::sqrt(std::numeric_limits<NumericT>::epsilon())); // loss of orthogonality of a single CholQR pass is of the order eps / min_ratio
+    NumericT rank_threshold   = NumericT(100) * std::numeric_limits<NumericT>::epsilon();
+
+    for (unsigned int it = 0; it <= tag.max_restarts(); ++it)
+    {
+      //
+      // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+      //
+      residual = viennacl::linalg::prod(A, result);
+      residual = rhs - residual;
+      precond.apply(residual);
+
+      NumericT beta = viennacl::linalg::norm_2(residual);
+
+      if (beta / norm_rhs < tag.tolerance() || beta < tag.abs_tolerance())
+      {
+        tag.error(beta / norm_rhs);
+        return result;
+      }
+
+      viennacl::vector_base<NumericT> q_0(basis.handle(), n, 0, 1);
+      q_0 = residual;
+      q_0 /= beta;
+
+      std::fill(g.begin(), g.end(), NumericT(0));
+      g[0] = beta;
+
+      vcl_size_t k = 0; // number of orthonormal basis vectors available after q_0, equals the number of columns of H
+      bool converged = false;
+      while (k < m && !converged)
+      {
+        vcl_size_t t = have_shifts ? std::min(s, m - k) : 1;
+
+        //
+        // Matrix powers kernel: Newton basis v_{i+1} = (M^{-1} A - theta_i) v_i, where complex conjugate pairs are handled in real arithmetic
+        //
+        for (vcl_size_t i=0; i<t; ++i)
+        {
+          viennacl::vector_base<NumericT> v_i     (basis.handle(), n, (k + i    ) * basis.internal_size1(), 1);
+          viennacl::vector_base<NumericT> v_i_next(basis.handle(), n, (k + i + 1) * basis.internal_size1(), 1);
+
+          temp = viennacl::linalg::prod(A, v_i);
+          precond.apply(temp);
+          v_i_next = temp;
+
+          if (have_shifts && s > 1)
+          {
+            if (shifts_re[i] > 0 || shifts_re[i] < 0)
+              v_i_next -= shifts_re[i] * v_i;
+            if (shifts_im[i] < 0) // second shift of a conjugate pair
+            {
+              viennacl::vector_base<NumericT> v_i_prev(basis.handle(), n, (k + i - 1) * basis.internal_size1(), 1);
+              v_i_next += (shifts_im[i] * shifts_im[i]) * v_i_prev;
+            }
+          }
+        }
+
+        //
+        // Block orthogonalization (first pass): [Q W]^T W in one reduction, then R^T R = W^T W - C^T C with C = Q^T W
+        //
+        std::vector<NumericT> C((k + 1) * t), C_pass((k + 1) * t);
+        std::vector<NumericT> S(t * t), col_norms_squared(t);
+
+        s_step_block_gram(basis, device_small, host_small, k, t);
+        for (vcl_size_t c=0; c<t; ++c)
+        {
+          for (vcl_size_t r=0; r<=k; ++r)
+            C[r + c*(k+1)] = host_small[r + c*device_small.internal_size1()];
+          for (vcl_size_t r=0; r<t; ++r)
+          {
+            NumericT val = host_small[k + 1 + r + c*device_small.internal_size1()];
+            for (vcl_size_t l=0; l<=k; ++l)
+              val -= host_small[l + r*device_small.internal_size1()] * host_small[l + c*device_small.internal_size1()];
+            S[r + c*t] = val;
+          }
+          col_norms_squared[c] = host_small[k + 1 + c + c*device_small.internal_size1()];
+        }
+        C_pass = C;
+
+        NumericT min_ratio = 0;
+        vcl_size_t t_ok = s_step_cholesky(S, col_norms_squared, t, rank_threshold, min_ratio);
+
+        if (t_ok < t || min_ratio < reorth_threshold)
+        {
+          //
+          // Second pass: explicitly project out the previous basis, W <- W - Q C, and orthogonalize once more
+          //
+          std::fill(host_small.begin(), host_small.end(), NumericT(0));
+          for (vcl_size_t c=0; c<t; ++c)
+          {
+            for (vcl_size_t r=0; r<=k; ++r)
+              host_small[r + c*device_small.internal_size1()] = -C[r + c*(k+1)];
+            host_small[k + 1 + c + c*device_small.internal_size1()] = NumericT(1);
+          }
+          s_step_block_update(basis, device_small, host_small, block_buffer, k, t);
+
+          s_step_block_gram(basis, device_small, host_small, k, t);
+          for (vcl_size_t c=0; c<t; ++c)
+          {
+            for (vcl_size_t r=0; r<=k; ++r)
+            {
+              C_pass[r + c*(k+1)] = host_small[r + c*device_small.internal_size1()];
+              C[r + c*(k+1)] += C_pass[r + c*(k+1)];
+            }
+            for (vcl_size_t r=0; r<t; ++r)
+            {
+              NumericT val = host_small[k + 1 + r + c*device_small.internal_size1()];
+              for (vcl_size_t l=0; l<=k; ++l)
+                val -= host_small[l + r*device_small.internal_size1()] * host_small[l + c*device_small.internal_size1()];
+              S[r + c*t] = val;
+            }
+            col_norms_squared[c] = host_small[k + 1 + c + c*device_small.internal_size1()];
+          }
+          t_ok = s_step_cholesky(S, col_norms_squared, t, rank_threshold, min_ratio);
+        }
+
+        vcl_size_t t_eff = t_ok;
+        if (t_eff == 0) // Krylov space is invariant (lucky breakdown)
+          break;
+
+        // R^{-1} (upper triangular, t-by-t):
+        std::vector<NumericT> R_inv(t_eff * t_eff);
+        for (vcl_size_t c=0; c<t_eff; ++c)
+        {
+          R_inv[c + c*t_eff] = NumericT(1) / S[c + c*t];
+          for (vcl_size_t r2=c; r2>0; --r2)
+          {
+            vcl_size_t r = r2 - 1;
+            NumericT val = 0;
+            for (vcl_size_t l=r+1; l<=c; ++l)
+              val -= S[r + l*t] * R_inv[l + c*t_eff];
+            R_inv[r + c*t_eff] = val / S[r + r*t];
+          }
+        }
+
+        // Q_new = (W - Q C) R^{-1}:
+        std::fill(host_small.begin(), host_small.end(), NumericT(0));
+        for (vcl_size_t c=0; c<t_eff; ++c)
+        {
+          for (vcl_size_t r=0; r<=k; ++r)
+          {
+            NumericT val = 0;
+            for (vcl_size_t l=0; l<=c; ++l)
+              val -= C_pass[r + l*(k+1)] * R_inv[l + c*t_eff];
+            host_small[r + c*device_small.internal_size1()] = val;
+          }
+          for (vcl_size_t r=0; r<=c; ++r)
+            host_small[k + 1 + r + c*device_small.internal_size1()] = R_inv[r + c*t_eff];
+        }
+        s_step_block_update(basis, device_small, host_small, block_buffer, k, t_eff);
+
+        //
+        // Recover the Hessenberg matrix from the change of basis:  H(:, k:k+t-1) = (Rhat B - [H_old P_top; 0]) P_bot^{-1},
+        // where [q_k, w_1, ..., w_t] = Q Rhat and M^{-1} A [q_k, w_1, ..., w_{t-1}] = [q_k, w_1, ..., w_t] B.
+        //
+        for (vcl_size_t c=0; c<t_eff; ++c)
+        {
+          NumericT *h = &(H[(k + c) * ld]);
+          std::fill(h, h + ld, NumericT(0));
+
+          // Rhat(:,c+1) * B(c+1,c) with B(c+1,c) = 1:
+          for (vcl_size_t r=0; r<=k; ++r)
+            h[r] += C[r + c*(k+1)];
+          for (vcl_size_t r=0; r<=c; ++r)
+            h[k + 1 + r] += S[r + c*t];
+
+          // Rhat(:,c) * B(c,c) and Rhat(:,c-1) * B(c-1,c):
+          NumericT theta   = (have_shifts && s > 1) ? shifts_re[c] : NumericT(0);
+          NumericT b_upper = (have_shifts && s > 1 && shifts_im[c] < 0) ? -shifts_im[c] * shifts_im[c] : NumericT(0);
+          for (vcl_size_t i=(c > 0 ? c-1 : 0); i<=c; ++i)
+          {
+            NumericT b_ic = (i == c) ? theta : b_upper;
+            if (!(b_ic > 0 || b_ic < 0))
+              continue;
+            if (i == 0)
+              h[k] += b_ic;
+            else
+            {
+              for (vcl_size_t r=0; r<=k; ++r)
+                h[r] += b_ic * C[r + (i-1)*(k+1)];
+              for (vcl_size_t r=0; r<i; ++r)
+                h[k + 1 + r] += b_ic * S[r + (i-1)*t];
+            }
+          }
+
+          // - H_old * P_top, where P_top(l,c) = C(l,c-1) for l < k:
+          if (c > 0)
+            for (vcl_size_t l=0; l<k; ++l)
+            {
+              NumericT p_lc = C[l + (c-1)*(k+1)];
+              for (vcl_size_t r=0; r<=l+1; ++r)
+                h[r] -= H[r + l*ld] * p_lc;
+            }
+
+          // multiply with P_bot^{-1}, where P_bot(0,0) = 1, P_bot(0,c) = C(k,c-1), P_bot(l,c) = R(l-1,c-1):
+          for (vcl_size_t l=0; l<c; ++l)
+          {
+            NumericT p_lc = (l == 0) ? C[k + (c-1)*(k+1)] : S[(l-1) + (c-1)*t];
+            for (vcl_size_t r=0; r<ld; ++r)
+              h[r] -= H[r + (k + l)*ld] * p_lc;
+          }
+          NumericT p_cc = (c == 0) ? NumericT(1) : S[(c-1) + (c-1)*t];
+          for (vcl_size_t r=0; r<ld; ++r)
+            h[r] /= p_cc;
+        }
+
+        //
+        // Least squares problem: Apply Givens rotations to the new columns and check for convergence
+        //
+        for (vcl_size_t c=0; c<t_eff; ++c, ++k)
+        {
+          NumericT *h = &(H_rot[k * ld]);
+          std::copy(H.begin() + static_cast<long>(k * ld), H.begin() + static_cast<long>((k + 1) * ld), h);
+
+          for (vcl_size_t i=0; i<k; ++i)
+          {
+            NumericT tmp = givens_c[i] * h[i] + givens_s[i] * h[i+1];
+            h[i+1]       = givens_c[i] * h[i+1] - givens_s[i] * h[i];
+            h[i]         = tmp;
+          }
+
+          NumericT denom = std::sqrt(h[k] * h[k] + h[k+1] * h[k+1]);
+          givens_c[k] = (denom > 0) ? h[k] / denom : NumericT(1);
+          givens_s[k] = (denom > 0) ? h[k+1] / denom : NumericT(0);
+          h[k] = denom;
+          h[k+1] = 0;
+
+          g[k+1] = -givens_s[k] * g[k];
+          g[k]   =  givens_c[k] * g[k];
+
+          tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+          if (std::fabs(g[k+1]) / norm_rhs < tag.tolerance() || std::fabs(g[k+1]) < tag.abs_tolerance())
+          {
+            ++k;
+            converged = true;
+            break;
+          }
+        }
+
+        //
+        // Shifts for the Newton basis: Leja-ordered Ritz values after the first s Arnoldi steps
+        //
+        if (!have_shifts && k >= s)
+        {
+          std::vector<NumericT> wr, wi;
+          shifts_re.assign(s, NumericT(0));
+          shifts_im.assign(s, NumericT(0));
+          if (gmres_hessenberg_eigenvalues(H, ld, s, wr, wi))
+          {
+            s_step_leja_order(wr, wi, shifts_re, shifts_im);
+            shifts_re.resize(s);
+            shifts_im.resize(s);
+          }
+          have_shifts = true;
+        }
+      }
+
+      //
+      // Solve the triangular system and update the result: x += Q y
+      //
+      for (vcl_size_t i2=k; i2>0; --i2)
+      {
+        vcl_size_t i = i2 - 1;
+        NumericT val = g[i];
+        for (vcl_size_t j=i+1; j<k; ++j)
+          val -= H_rot[i + j*ld] * y[j];
+        y[i] = val / H_rot[i + i*ld];
+      }
+
+      if (k > 0)
+      {
+        viennacl::vector_range<viennacl::vector<NumericT> > y_range(device_y, viennacl::range(0, k));
+        viennacl::fast_copy(y.begin(), y.begin() + static_cast<long>(k), device_y.begin());
+        viennacl::matrix_range<MatrixType> Q_k(basis, viennacl::range(0, n), viennacl::range(0, k));
+        result += viennacl::linalg::prod(Q_k, y_range);
+      }
+
+      tag.error(std::fabs(g[k]) / norm_rhs);
+
+      if (monitor && monitor(result, tag.error(), monitor_data))
+        break;
+
+      if (tag.error() < tag.tolerance())
+        return result;
+    }
+
+    return result;
+  }
+
+  //
+  // Flexible GMRES and GMRES with deflated restarting
+  //
+
+  /** @brief Computes an orthonormal basis of the harmonic Ritz vectors for the k harmonic Ritz values of smallest magnitude.
+  *
+  * The harmonic Ritz pairs are the eigenpairs of H_m + h_{m+1,m}^2 H_m^{-T} e_m e_m^T, cf. Morgan: "GMRES with deflated restarting", SIAM J. Sci. Comput. 24(1), 2002.
+  * Complex conjugate pairs are represented by the real and the imaginary part of the eigenvector, hence up to k+1 vectors are returned.
+  *
+  * @param H      The (m+1)-by-m Hessenberg matrix of the Arnoldi relation, column-major with leading dimension m+1
+  * @param m      Number of columns of H
+  * @param k      Requested number of harmonic Ritz vectors
+  * @param P      Orthonormal basis of the harmonic Ritz vectors, column-major with leading dimension m+1 (output, last row is zero). Has room for k+2 columns, so that the caller can append the residual vector.
+  * @return The number of columns of P
+  */
+  template<typename NumericT>
+  vcl_size_t gmres_dr_harmonic_ritz_vectors(std::vector<NumericT> const & H, vcl_size_t m, vcl_size_t k, std::vector<NumericT> & P)
+  {
+    vcl_size_t ld = m + 1;
+    NumericT tiny = std::numeric_limits<NumericT>::epsilon() * std::numeric_limits<NumericT>::epsilon();
+
+    // f = H_m^{-T} e_m:
+    std::vector<NumericT> H_m_trans(m * m);
+    for (vcl_size_t i=0; i<m; ++i)
+      for (vcl_size_t j=0; j<m; ++j)
+        H_m_trans[j + i*m] = H[i + j*ld];
+    std::vector<NumericT> f(m);
+    f[m-1] = NumericT(1);
+    gmres_small_dense_solve(H_m_trans, m, f, tiny);
+
+    // G = H_m + h_{m+1,m}^2 f e_m^T:
+    NumericT h = H[m + (m-1)*ld];
+    std::vector<NumericT> G(m * m);
+    for (vcl_size_t j=0; j<m; ++j)
+      for (vcl_size_t i=0; i<m; ++i)
+        G[i + j*m] = H[i + j*ld];
+    for (vcl_size_t i=0; i<m; ++i)
+      G[i + (m-1)*m] += h * h * f[i];
+
+    std::vector<NumericT> G_hessenberg(G);
+    std::vector<NumericT> wr, wi;
+    gmres_hessenberg_reduction(G_hessenberg, m, m);
+    if (!gmres_hessenberg_eigenvalues(G_hessenberg, m, m, wr, wi))
+      return 0;
+
+    // sort by magnitude (insertion sort, m is small):
+    std::vector<vcl_size_t> order(m);
+    for (vcl_size_t i=0; i<m; ++i)
+      order[i] = i;
+    for (vcl_size_t i=1; i<m; ++i)
+      for (vcl_size_t j=i; j>0 && std::sqrt(wr[order[j]]*wr[order[j]] + wi[order[j]]*wi[order[j]]) < std::sqrt(wr[order[j-1]]*wr[order[j-1]] + wi[order[j-1]]*wi[order[j-1]]); --j)
+        std::swap(order[j], order[j-1]);
+
+    // eigenvectors by inverse iteration in complex arithmetic:
+    P.assign(ld * (k + 2), NumericT(0)); // one extra column for a split complex pair and one for the residual
+    vcl_size_t num_vectors = 0;
+    for (vcl_size_t idx=0; idx<m && num_vectors < k; ++idx)
+    {
+      NumericT theta_re = wr[order[idx]];
+      NumericT theta_im = wi[order[idx]];
+      if (theta_im < 0) // conjugate partner is taken together with the eigenvalue with positive imaginary part
+        continue;
+      if (theta_im > 0 && (num_vectors + 2 > k + 1 || num_vectors + 2 > m - 1))
+        break;
+
+      std::vector< std::complex<NumericT> > G_shifted(m * m);
+      for (vcl_size_t i=0; i<m*m; ++i)
+        G_shifted[i] = G[i];
+      for (vcl_size_t i=0; i<m; ++i)
+        G_shifted[i + i*m] -= std::complex<NumericT>(theta_re, theta_im);
+
+      std::vector< std::complex<NumericT> > g(m, std::complex<NumericT>(1));
+      for (unsigned int iter=0; iter<2; ++iter)
+      {
+        gmres_small_dense_solve(G_shifted, m, g, tiny);
+        NumericT norm_g = 0;
+        for (vcl_size_t i=0; i<m; ++i)
+          norm_g += std::norm(g[i]);
+        norm_g = std::sqrt(norm_g);
+        for (vcl_size_t i=0; i<m; ++i)
+          g[i] /= norm_g;
+      }
+
+      for (vcl_size_t i=0; i<m; ++i)
+        P[i + num_vectors*ld] = g[i].real();
+      ++num_vectors;
+      if (theta_im > 0)
+      {
+        for (vcl_size_t i=0; i<m; ++i)
+          P[i + num_vectors*ld] = g[i].imag();
+        ++num_vectors;
+      }
+    }
+
+    // orthonormalize (modified Gram-Schmidt, twice), dropping linearly dependent vectors:
+    vcl_size_t rank = 0;
+    for (vcl_size_t c=0; c<num_vectors; ++c)
+    {
+      if (c != rank)
+        std::copy(P.begin() + static_cast<long>(c*ld), P.begin() + static_cast<long>((c+1)*ld), P.begin() + static_cast<long>(rank*ld));
+
+      for (unsigned int pass=0; pass<2; ++pass)
+        for (vcl_size_t l=0; l<rank; ++l)
+        {
+          NumericT dot = 0;
+          for (vcl_size_t i=0; i<ld; ++i)
+            dot += P[i + l*ld] * P[i + rank*ld];
+          for (vcl_size_t i=0; i<ld; ++i)
+            P[i + rank*ld] -= dot * P[i + l*ld];
+        }
+
+      NumericT norm_p = 0;
+      for (vcl_size_t i=0; i<ld; ++i)
+        norm_p += P[i + rank*ld] * P[i + rank*ld];
+      norm_p = std::sqrt(norm_p);
+      if (norm_p > std::sqrt(std::numeric_limits<NumericT>::epsilon()))
+      {
+        for (vcl_size_t i=0; i<ld; ++i)
+          P[i + rank*ld] /= norm_p;
+        ++rank;
+      }
+    }
+
+    return rank;
+  }
+
+  /** @brief Applies the plane rotation (c, s) to the entries (i, i+1) of the column-major array 'x' */
+  template<typename NumericT>
+  void gmres_apply_givens(NumericT * x, vcl_size_t i, NumericT c, NumericT s)
+  {
+    NumericT tmp = c * x[i] + s * x[i+1];
+    x[i+1]       = c * x[i+1] - s * x[i];
+    x[i]         = tmp;
+  }
+
+  /** @brief Computes the plane rotation (c, s) which annihilates x[i+1] and applies it to x */
+  template<typename NumericT>
+  void gmres_setup_givens(NumericT * x, vcl_size_t i, NumericT & c, NumericT & s)
+  {
+    NumericT denom = std::sqrt(x[i] * x[i] + x[i+1] * x[i+1]);
+    c = (denom > 0) ? x[i] / denom : NumericT(1);
+    s = (denom > 0) ? x[i+1] / denom : NumericT(0);
+    x[i]   = denom;
+    x[i+1] = 0;
+  }
+
+  /** @brief Implementation of the flexible GMRES (FGMRES) with optional deflated restarting (GMRES-DR).
+  *
+  * Uses right preconditioning. For the flexible variant (see gmres_tag::flexible()), the preconditioned basis vectors z_j = M_j^{-1} v_j are stored,
+  * so that the preconditioner may change from one iteration to the next (e.g. an inner Krylov solver or an AMG cycle with varying smoother), cf. Saad: "A flexible inner-outer preconditioned GMRES algorithm".
+  * Otherwise the update is computed as x += M^{-1} V y without storing the preconditioned basis.
+  *
+  * If gmres_tag::deflation_dim() is nonzero, the harmonic Ritz vectors for the eigenvalues of smallest magnitude are kept at restart (GMRES-DR, cf. Morgan),
+  * which avoids the stagnation of restarted GMRES for small Krylov dimensions.
+  *
+  * The Arnoldi process reuses the fused Gram-Schmidt kernels of the pipelined GMRES (classical Gram-Schmidt with reorthogonalization), hence the memory footprint is fixed by the Krylov dimension.
+  *
+  * @param A            The system matrix
+  * @param rhs          The load vector
+  * @param tag          Solver configuration tag
+  * @param precond      A preconditioner. Precondition operation is done via member function apply()
+  * @param monitor      A callback routine which is called at each GMRES restart
+  * @param monitor_data Data pointer to be passed to the callback routine to pass on user-specific data
+  * @return The result vector
+  */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> flexible_deflated_solve(MatrixT const & A,
+                                                     viennacl::vector<NumericT> const & rhs,
+                                                     gmres_tag const & tag,
+                                                     PreconditionerT const & precond,
+                                                     bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                                     void *monitor_data = NULL)
+  {
+    typedef viennacl::vector_range<viennacl::vector<NumericT> >   VectorRangeType;
+    typedef viennacl::matrix_range<viennacl::matrix_base<NumericT> > MatrixRangeType;
+
+    vcl_size_t n = rhs.size();
+    viennacl::context ctx = viennacl::traits::context(rhs);
+    viennacl::vector<NumericT> result = viennacl::zero_vector<NumericT>(n, ctx);
+
+    vcl_size_t m = std::min<vcl_size_t>(tag.krylov_dim(), n); // see solve_impl()
+    vcl_size_t ld = m + 1;
+    vcl_size_t max_deflation_dim = (m > 2) ? std::min<vcl_size_t>(tag.deflation_dim(), m - 2) : 0;
+    bool flexible = tag.flexible();
+
+    NumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+    tag.iters(0);
+    tag.error(0);
+    if (norm_rhs <= tag.abs_tolerance()) //solution is zero if RHS norm is zero
+      return result;
+
+    vcl_size_t vec_size = rhs.internal_size();
+    vcl_size_t buffer_size_per_vector = 128;
+    viennacl::vector<NumericT> device_krylov_basis(vec_size * ld, ctx);
+    viennacl::vector<NumericT> device_precond_basis(flexible ? vec_size * m : 1, ctx);
+    viennacl::vector<NumericT> device_buffer_R  = viennacl::zero_vector<NumericT>(ld * ld, ctx); // first Gram-Schmidt pass and norms
+    viennacl::vector<NumericT> device_buffer_R2 = viennacl::zero_vector<NumericT>(ld * ld, ctx); // second Gram-Schmidt pass
+    viennacl::vector<NumericT> device_inner_prod_buffer = viennacl::zero_vector<NumericT>(3 * buffer_size_per_vector, ctx);
+    viennacl::vector<NumericT> device_vi_in_vk_buffer   = viennacl::zero_vector<NumericT>(buffer_size_per_vector * ld, ctx);
+    viennacl::vector<NumericT> device_r_dot_vk_buffer   = viennacl::zero_vector<NumericT>(buffer_size_per_vector * ld, ctx);
+    viennacl::vector<NumericT> temp(n, ctx);
+    viennacl::vector<NumericT> device_y(m, ctx);
+
+    viennacl::matrix_base<NumericT> V(device_krylov_basis.handle(),  n, 0, 1, vec_size, ld, 0, 1, ld, false);
+    viennacl::matrix_base<NumericT> Z(device_precond_basis.handle(), n, 0, 1, vec_size, flexible ? m : 0, 0, 1, flexible ? m : 0, false);
+
+    std::vector<NumericT> H(ld * m);      // generalized Hessenberg matrix of the Arnoldi relation A Z_m = V_{m+1} H
+    std::vector<NumericT> H_rot(ld * m);  // H after plane rotations
+    std::vector<NumericT> c(ld);          // right hand side of the least squares problem
+    std::vector<NumericT> g(ld);          // c after plane rotations
+    std::vector<NumericT> y(m);
+    std::vector<vcl_size_t> rot_index;
+    std::vector<NumericT>   rot_c, rot_s;
+    std::vector<NumericT> host_R(ld), host_R2(ld);
+
+    VectorRangeType v_0(device_krylov_basis, viennacl::range(0, n));
+
+    vcl_size_t k = 0; // number of deflation vectors carried over from the previous cycle
+    while (tag.iters() < tag.max_iterations())
+    {
+      if (k == 0)
+      {
+        //
+        // (Re-)Initialize residual: r = b - A*x (without temporary for the result of A*x)
+        //
+        temp = viennacl::linalg::prod(A, result);
+        temp = rhs - temp;
+
+        NumericT beta = viennacl::linalg::norm_2(temp);
+        if (beta / norm_rhs < tag.tolerance() || beta < tag.abs_tolerance())
+        {
+          tag.error(beta / norm_rhs);
+          return result;
+        }
+
+        v_0 = temp;
+        v_0 /= beta;
+
+        std::fill(c.begin(), c.end(), NumericT(0));
+        c[0] = beta;
+        g = c;
+        rot_index.clear();
+        rot_c.clear();
+        rot_s.clear();
+      }
+
+      //
+      // Arnoldi process
+      //
+      vcl_size_t j = k;
+      bool converged = false;
+      for (; j < m && tag.iters() < tag.max_iterations(); ++j)
+      {
+        VectorRangeType v_j   (device_krylov_basis, viennacl::range( j   *vec_size,  j   *vec_size + n));
+        VectorRangeType v_next(device_krylov_basis, viennacl::range((j+1)*vec_size, (j+1)*vec_size + n));
+
+        temp = v_j;
+        precond.apply(temp);
+        if (flexible)
+        {
+          VectorRangeType z_j(device_precond_basis, viennacl::range(j*vec_size, j*vec_size + n));
+          z_j = temp;
+        }
+        v_next = viennacl::linalg::prod(A, temp);
+
+        // classical Gram-Schmidt with reorthogonalization using the fused kernels, coefficients of the two passes go to R and R2:
+        viennacl::linalg::pipelined_gmres_gram_schmidt_stage1(device_krylov_basis, n, vec_size, j+1, device_vi_in_vk_buffer, buffer_size_per_vector);
+        viennacl::linalg::pipelined_gmres_gram_schmidt_stage2(device_krylov_basis, n, vec_size, j+1,
+                                                              device_vi_in_vk_buffer,
+                                                              device_buffer_R, ld,
+                                                              device_inner_prod_buffer, buffer_size_per_vector);
+        viennacl::linalg::pipelined_gmres_gram_schmidt_stage1(device_krylov_basis, n, vec_size, j+1, device_vi_in_vk_buffer, buffer_size_per_vector);
+        viennacl::linalg::pipelined_gmres_gram_schmidt_stage2(device_krylov_basis, n, vec_size, j+1,
+                                                              device_vi_in_vk_buffer,
+                                                              device_buffer_R2, ld,
+                                                              device_inner_prod_buffer, buffer_size_per_vector);
+        viennacl::linalg::pipelined_gmres_normalize_vk(v_next, v_0,
+                                                       device_buffer_R, (j+1) + (j+1)*ld,
+                                                       device_inner_prod_buffer, device_r_dot_vk_buffer,
+                                                       buffer_size_per_vector, (j+1)*buffer_size_per_vector);
+
+        viennacl::backend::memory_read(device_buffer_R.handle(),  sizeof(NumericT) * (j+1)*ld, sizeof(NumericT) * (j+2), &(host_R[0]));
+        viennacl::backend::memory_read(device_buffer_R2.handle(), sizeof(NumericT) * (j+1)*ld, sizeof(NumericT) * (j+1), &(host_R2[0]));
+
+        NumericT *h = &(H[j*ld]);
+        NumericT norm_h = 0;
+        std::fill(h, h + ld, NumericT(0));
+        for (vcl_size_t i=0; i<=j; ++i)
+        {
+          h[i] = host_R[i] + host_R2[i];
+          norm_h += h[i] * h[i];
+        }
+        h[j+1] = host_R[j+1];
+        norm_h = std::sqrt(norm_h + h[j+1] * h[j+1]);
+
+        // update QR factorization of H by plane rotations:
+        NumericT *h_rot = &(H_rot[j*ld]);
+        std::copy(h, h + ld, h_rot);
+        for (vcl_size_t r=0; r<rot_index.size(); ++r)
+          gmres_apply_givens(h_rot, rot_index[r], rot_c[r], rot_s[r]);
+
+        NumericT cs, sn;
+        gmres_setup_givens(h_rot, j, cs, sn);
+        gmres_apply_givens(&(g[0]), j, cs, sn);
+        rot_index.push_back(j);
+        rot_c.push_back(cs);
+        rot_s.push_back(sn);
+
+        tag.iters( tag.iters() + 1 ); //increase iteration counter
+
+        bool breakdown = !(h[j+1] > std::numeric_limits<NumericT>::epsilon() * norm_h); // Krylov space is invariant, v_{j+1} is not usable
+        if (breakdown || std::fabs(g[j+1]) / norm_rhs < tag.tolerance() || std::fabs(g[j+1]) < tag.abs_tolerance())
+        {
+          ++j;
+          converged = true;
+          break;
+        }
+      }
+
+      //
+      // Solve the triangular system and update the result
+      //
+      vcl_size_t num_columns = j;
+      for (vcl_size_t i2=num_columns; i2>0; --i2)
+      {
+        vcl_size_t i = i2 - 1;
+        NumericT val = g[i];
+        for (vcl_size_t l=i+1; l<num_columns; ++l)
+          val -= H_rot[i + l*ld] * y[l];
+        y[i] = val / H_rot[i + i*ld];
+      }
+
+      if (num_columns > 0)
+      {
+        viennacl::fast_copy(y.begin(), y.begin() + static_cast<long>(num_columns), device_y.begin());
+        VectorRangeType y_range(device_y, viennacl::range(0, num_columns));
+        if (flexible)
+        {
+          MatrixRangeType Z_used(Z, viennacl::range(0, n), viennacl::range(0, num_columns));
+          result += viennacl::linalg::prod(Z_used, y_range);
+        }
+        else
+        {
+          MatrixRangeType V_used(V, viennacl::range(0, n), viennacl::range(0, num_columns));
+          temp = viennacl::linalg::prod(V_used, y_range);
+          precond.apply(temp);
+          result += temp;
+        }
+      }
+
+      tag.error(std::fabs(g[num_columns]) / norm_rhs);
+
+      if (monitor && monitor(result, tag.error(), monitor_data))
+        break;
+
+      if (converged || tag.error() < tag.tolerance())
+        return result;
+
+      //
+      // Deflated restart: keep the harmonic Ritz vectors and the residual in the new basis
+      //
+      k = 0;
+      if (max_deflation_dim > 0 && num_columns == m)
+      {
+        std::vector<NumericT> P;
+        vcl_size_t k_new = gmres_dr_harmonic_ritz_vectors(H, m, max_deflation_dim, P);
+
+        // residual of the least squares problem, s = c - H y, orthonormalized against the Ritz vectors as last column of P:
+        std::vector<NumericT> s_vec(c);
+        for (vcl_size_t l=0; l<m; ++l)
+          for (vcl_size_t i=0; i<ld; ++i)
+            s_vec[i] -= H[i + l*ld] * y[l];
+        NumericT norm_s = 0;
+        for (vcl_size_t i=0; i<ld; ++i)
+          norm_s += s_vec[i] * s_vec[i];
+        norm_s = std::sqrt(norm_s);
+
+        std::vector<NumericT> p_last(s_vec);
+        for (unsigned int pass=0; pass<2; ++pass)
+          for (vcl_size_t l=0; l<k_new; ++l)
+          {
+            NumericT dot = 0;
+            for (vcl_size_t i=0; i<ld; ++i)
+              dot += P[i + l*ld] * p_last[i];
+            for (vcl_size_t i=0; i<ld; ++i)
+              p_last[i] -= dot * P[i + l*ld];
+          }
+        NumericT norm_p = 0;
+        for (vcl_size_t i=0; i<ld; ++i)
+          norm_p += p_last[i] * p_last[i];
+        norm_p = std::sqrt(norm_p);
+
+        if (k_new > 0 && norm_p > std::sqrt(std::numeric_limits<NumericT>::epsilon()) * norm_s)
+        {
+          for (vcl_size_t i=0; i<ld; ++i)
+            P[i + k_new*ld] = p_last[i] / norm_p;
+
+          // H_new = P_{k+1}^T H P_k and c_new = P_{k+1}^T s:
+          std::vector<NumericT> HP(ld * k_new);
+          for (vcl_size_t col=0; col<k_new; ++col)
+            for (vcl_size_t l=0; l<m; ++l)
+              for (vcl_size_t i=0; i<ld; ++i)
+                HP[i + col*ld] += H[i + l*ld] * P[l + col*ld];
+
+          std::fill(H.begin(), H.end(), NumericT(0));
+          std::fill(c.begin(), c.end(), NumericT(0));
+          for (vcl_size_t row=0; row<=k_new; ++row)
+          {
+            for (vcl_size_t col=0; col<k_new; ++col)
+            {
+              NumericT val = 0;
+              for (vcl_size_t i=0; i<ld; ++i)
+                val += P[i + row*ld] * HP[i + col*ld];
+              H[row + col*ld] = val;
+            }
+            NumericT val = 0;
+            for (vcl_size_t i=0; i<ld; ++i)
+              val += P[i + row*ld] * s_vec[i];
+            c[row] = val;
+          }
+
+          // V_{k+1} <- V_{m+1} P_{k+1} and Z_k <- Z_m P_k:
+          viennacl::matrix<NumericT, viennacl::column_major> device_P(ld, k_new + 1, ctx);
+          viennacl::matrix<NumericT, viennacl::column_major> new_basis(n, k_new + 1, ctx);
+          std::vector<NumericT> host_P(device_P.internal_size());
+          for (vcl_size_t col=0; col<=k_new; ++col)
+            for (vcl_size_t i=0; i<ld; ++i)
+              host_P[i + col*device_P.internal_size1()] = P[i + col*ld];
+          viennacl::backend::memory_write(device_P.handle(), 0, sizeof(NumericT) * host_P.size(), &(host_P[0]));
+
+          new_basis = viennacl::linalg::prod(V, device_P);
+          MatrixRangeType V_new(V, viennacl::range(0, n), viennacl::range(0, k_new + 1));
+          V_new = new_basis;
+
+          if (flexible)
+          {
+            viennacl::range all_rows(0, n);
+            viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > P_k(device_P, viennacl::range(0, m), viennacl::range(0, k_new));
+            viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > new_Z(new_basis, all_rows, viennacl::range(0, k_new));
+            new_Z = viennacl::linalg::prod(Z, P_k);
+            MatrixRangeType Z_new(Z, all_rows, viennacl::range(0, k_new));
+            Z_new = new_Z;
+          }
+
+          // QR factorization of the new (k+1)-by-k block by plane rotations:
+          H_rot = H;
+          g = c;
+          rot_index.clear();
+          rot_c.clear();
+          rot_s.clear();
+          for (vcl_size_t col=0; col<k_new; ++col)
+            for (vcl_size_t row=k_new; row>col; --row)
+            {
+              NumericT cs, sn;
+              gmres_setup_givens(&(H_rot[col*ld]), row-1, cs, sn);
+              for (vcl_size_t col2=col+1; col2<k_new; ++col2)
+                gmres_apply_givens(&(H_rot[col2*ld]), row-1, cs, sn);
+              gmres_apply_givens(&(g[0]), row-1, cs, sn);
+              rot_index.push_back(row-1);
+              rot_c.push_back(cs);
+              rot_s.push_back(sn);
+            }
+
+          k = k_new;
+        }
+      }
+    }
+
+    return result;
+  }
+
+
+  /** @brief Returns true if the s-step GMRES, the flexible GMRES or the GMRES-DR is enabled in the tag. */
+  inline bool gmres_variant_requested(gmres_tag const & tag)
+  {
+    return tag.flexible() || tag.deflation_dim() > 0 || tag.s_step() > 1;
+  }
+
+  /** @brief Runs the s-step GMRES, the flexible GMRES or the GMRES-DR. Only available for ViennaCL vectors, hence this fallback throws. */
+  template<typename MatrixT, typename VectorT, typename PreconditionerT, typename MonitorT>
+  VectorT gmres_variant_solve(MatrixT const &, VectorT const &, gmres_tag const &, PreconditionerT const &, MonitorT, void *)
+  {
+    throw std::runtime_error("GMRES: The s-step, flexible and deflated restarting variants are only available for viennacl::vector.");
+  }
+
+  /** @brief Runs the s-step GMRES, the flexible GMRES or the GMRES-DR as requested in the tag. */
+  template<typename MatrixT, typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> gmres_variant_solve(MatrixT const & A, viennacl::vector<NumericT> const & rhs,
+                                                 gmres_tag const & tag, PreconditionerT const & precond,
+                                                 bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*), void *monitor_data)
+  {
+    if (tag.flexible() || tag.deflation_dim() > 0)
+      return flexible_deflated_solve(A, rhs, tag, precond, monitor, monitor_data);
+    return s_step_solve(A, rhs, tag, precond, monitor, monitor_data);
+  }
+
+
   /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
   template<typename NumericT>
   viennacl::vector<NumericT> solve_impl(viennacl::compressed_matrix<NumericT> const & A,
@@ -375,7 +1501,9 @@ namespace detail
                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                         void *monitor_data = NULL)
   {
-    return pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
   }
 
 
@@ -388,6 +1516,8 @@ namespace detail
                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                         void *monitor_data = NULL)
   {
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
     return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
   }
 
@@ -402,6 +1532,8 @@ namespace detail
                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                         void *monitor_data = NULL)
   {
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
     return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
   }
 
@@ -416,6 +1548,8 @@ namespace detail
                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                         void *monitor_data = NULL)
   {
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
     return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
   }
 
@@ -429,6 +1563,23 @@ namespace detail
                                         bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
                                         void *monitor_data = NULL)
   {
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+    return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
+  }
+
+
+  /** @brief Overload for the pipelined CG implementation for the ViennaCL sparse matrix types */
+  template<typename NumericT, unsigned int BlockSize>
+  viennacl::vector<NumericT> solve_impl(viennacl::block_compressed_matrix<NumericT, BlockSize> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        gmres_tag const & tag,
+                                        viennacl::linalg::no_precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
     return detail::pipelined_solve(A, rhs, tag, viennacl::linalg::no_precond(), monitor, monitor_data);
   }
 
@@ -457,6 +1608,9 @@ namespace detail
     typedef typename viennacl::result_of::value_type<VectorT>::type            NumericType;
     typedef typename viennacl::result_of::cpu_value_type<NumericType>::type    CPU_NumericType;
 
+    if (detail::gmres_variant_requested(tag))
+      return detail::gmres_variant_solve(matrix, rhs, tag, precond, monitor, monitor_data);
+
     unsigned int problem_size = static_cast<unsigned int>(viennacl::traits::size(rhs));
     VectorT result = rhs;
     viennacl::traits::clear(result);
@@ -630,6 +1784,28 @@ namespace detail
     return result;
   }
 
+
+  /** @brief Overload for the reordered_matrix: The system is solved in the reordered numbering, only the right hand side and the result are permuted.
+  *
+  * The preconditioner needs to be set up for A.matrix(). The monitor is called with the current guess in the reordered numbering.
+  */
+  template<typename NumericT, typename PreconditionerT>
+  viennacl::vector<NumericT> solve_impl(viennacl::reordered_matrix<NumericT> const & A,
+                                        viennacl::vector<NumericT> const & rhs,
+                                        gmres_tag const & tag,
+                                        PreconditionerT const & precond,
+                                        bool (*monitor)(viennacl::vector<NumericT> const &, NumericT, void*) = NULL,
+                                        void *monitor_data = NULL)
+  {
+    viennacl::vector<NumericT> rhs_reordered(rhs.size(), viennacl::traits::context(rhs));
+    A.permute(rhs, rhs_reordered);
+    viennacl::vector<NumericT> result_reordered = detail::solve_impl(A.matrix(), rhs_reordered, tag, precond, monitor, monitor_data);
+
+    viennacl::vector<NumericT> result(rhs.size(), viennacl::traits::context(rhs));
+    A.unpermute(result_reordered, result);
+    return result;
+  }
+
 }
 
 template<typename MatrixT, typename VectorT, typename PreconditionerT>
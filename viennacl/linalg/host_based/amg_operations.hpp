@@ -1514,7 +1514,7 @@ void assign_to_dense(viennacl::compressed_matrix<NumericT, AlignmentV> const & A
 
 }
 
-/** @brief Damped Jacobi Smoother (CUDA version)
+/** @brief Implementation of the damped Jacobi smoother for CSR matrices with values of type ElementT, which are converted to NumericT
 *
 * @param iterations  Number of smoother iterations
 * @param A           Operator matrix for the smoothing
@@ -1523,16 +1523,16 @@ void assign_to_dense(viennacl::compressed_matrix<NumericT, AlignmentV> const & A
 * @param rhs_smooth  The right hand side of the equation for the smoother
 * @param weight      Damping factor. 0: No effect of smoother. 1: Undamped Jacobi iteration
 */
-template<typename NumericT>
-void smooth_jacobi(unsigned int iterations,
-                   compressed_matrix<NumericT> const & A,
-                   vector<NumericT> & x,
-                   vector<NumericT> & x_backup,
-                   vector<NumericT> const & rhs_smooth,
-                   NumericT weight)
+template<typename NumericT, typename ElementT, typename SparseMatrixT>
+void smooth_jacobi_impl(unsigned int iterations,
+                        SparseMatrixT const & A,
+                        vector<NumericT> & x,
+                        vector<NumericT> & x_backup,
+                        vector<NumericT> const & rhs_smooth,
+                        NumericT weight)
 {
 
-  NumericT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(A.handle());
+  ElementT     const * A_elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ElementT>(A.handle());
   unsigned int const * A_row_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle1());
   unsigned int const * A_col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(A.handle2());
   NumericT     const * rhs_elements = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(rhs_smooth.handle());
@@ -1558,9 +1558,9 @@ void smooth_jacobi(unsigned int iterations,
       {
         unsigned int col = A_col_buffer[index];
         if (col == row)
-          diag = A_elements[index];
+          diag = static_cast<NumericT>(A_elements[index]);
         else
-          sum += A_elements[index] * x_old_elements[col];
+          sum += static_cast<NumericT>(A_elements[index]) * x_old_elements[col];
       }
 
       x_elements[row] = weight * (rhs_elements[row] - sum) / diag + (NumericT(1) - weight) * x_old_elements[row];
@@ -1568,6 +1568,46 @@ void smooth_jacobi(unsigned int iterations,
   }
 }
 
+/** @brief Damped Jacobi Smoother (CUDA version)
+*
+* @param iterations  Number of smoother iterations
+* @param A           Operator matrix for the smoothing
+* @param x           The vector smoothing is applied to
+* @param x_backup    (Different) Vector holding the same values as x
+* @param rhs_smooth  The right hand side of the equation for the smoother
+* @param weight      Damping factor. 0: No effect of smoother. 1: Undamped Jacobi iteration
+*/
+template<typename NumericT>
+void smooth_jacobi(unsigned int iterations,
+                   compressed_matrix<NumericT> const & A,
+                   vector<NumericT> & x,
+                   vector<NumericT> & x_backup,
+                   vector<NumericT> const & rhs_smooth,
+                   NumericT weight)
+{
+  smooth_jacobi_impl<NumericT, NumericT>(iterations, A, x, x_backup, rhs_smooth, weight);
+}
+
+/** @brief Damped Jacobi Smoother for operators with values stored in reduced precision. The values are converted to NumericT, hence the smoother runs in full precision.
+*
+* @param iterations  Number of smoother iterations
+* @param A           Operator matrix for the smoothing
+* @param x           The vector smoothing is applied to
+* @param x_backup    (Different) Vector holding the same values as x
+* @param rhs_smooth  The right hand side of the equation for the smoother
+* @param weight      Damping factor. 0: No effect of smoother. 1: Undamped Jacobi iteration
+*/
+template<typename NumericT, typename StorageT>
+void smooth_jacobi(unsigned int iterations,
+                   mixed_precision_compressed_matrix<NumericT, StorageT> const & A,
+                   vector<NumericT> & x,
+                   vector<NumericT> & x_backup,
+                   vector<NumericT> const & rhs_smooth,
+                   NumericT weight)
+{
+  smooth_jacobi_impl<NumericT, StorageT>(iterations, A, x, x_backup, rhs_smooth, weight);
+}
+
 } //namespace amg
 } //namespace host_based
 } //namespace linalg
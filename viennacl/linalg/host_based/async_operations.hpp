@@ -0,0 +1,143 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_ASYNC_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_ASYNC_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/async_operations.hpp
+    @brief Asynchronous versions of common operations on objects in main memory, enqueued into a host_stream.
+
+    All objects passed by reference must stay alive until the operation has completed (cf. host_stream::finish() and viennacl::backend::finish()).
+    Operations in different streams must not write to objects used by each other.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/host_based/host_stream.hpp"
+#include "viennacl/linalg/host_based/operation_chain.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  template<typename MatrixT, typename NumericT>
+  struct async_prod_functor
+  {
+    async_prod_functor(MatrixT const & A, vector_base<NumericT> const & x, vector_base<NumericT> & y) : A_(&A), x_(&x), y_(&y) {}
+    void operator()() const { *y_ = viennacl::linalg::prod(*A_, *x_); }
+
+    MatrixT const * A_;
+    vector_base<NumericT> const * x_;
+    vector_base<NumericT> * y_;
+  };
+
+  template<typename NumericT>
+  struct async_inner_prod_functor
+  {
+    async_inner_prod_functor(vector_base<NumericT> const & x, vector_base<NumericT> const & y, NumericT * result) : x_(&x), y_(&y), result_(result) {}
+    void operator()() const { *result_ = viennacl::linalg::inner_prod(*x_, *y_); }
+
+    vector_base<NumericT> const * x_;
+    vector_base<NumericT> const * y_;
+    NumericT * result_;
+  };
+
+  template<typename NumericT>
+  struct async_norm_2_functor
+  {
+    async_norm_2_functor(vector_base<NumericT> const & x, NumericT * result) : x_(&x), result_(result) {}
+    void operator()() const { *result_ = viennacl::linalg::norm_2(*x_); }
+
+    vector_base<NumericT> const * x_;
+    NumericT * result_;
+  };
+
+  template<typename NumericT>
+  struct async_read_functor
+  {
+    async_read_functor(viennacl::scalar<NumericT> const & s, NumericT * result) : s_(&s), result_(result) {}
+    void operator()() const { *result_ = *s_; }
+
+    viennacl::scalar<NumericT> const * s_;
+    NumericT * result_;
+  };
+
+  template<typename NumericT>
+  struct async_chain_functor
+  {
+    explicit async_chain_functor(operation_chain<NumericT> & chain) : chain_(&chain) {}
+    void operator()() const { chain_->execute(); }
+
+    operation_chain<NumericT> * chain_;
+  };
+}
+
+/** @brief Enqueues y = prod(A, x) */
+template<typename MatrixT, typename NumericT>
+void async_prod(host_stream & stream, MatrixT const & A, vector_base<NumericT> const & x, vector_base<NumericT> & y)
+{
+  stream.enqueue(detail::async_prod_functor<MatrixT, NumericT>(A, x, y));
+}
+
+/** @brief Enqueues the inner product of x and y */
+template<typename NumericT>
+host_future<NumericT> async_inner_prod(host_stream & stream, vector_base<NumericT> const & x, vector_base<NumericT> const & y)
+{
+  host_future<NumericT> result;
+  result.attach(stream, stream.enqueue(detail::async_inner_prod_functor<NumericT>(x, y, result.result_location())));
+  return result;
+}
+
+/** @brief Enqueues the 2-norm of x */
+template<typename NumericT>
+host_future<NumericT> async_norm_2(host_stream & stream, vector_base<NumericT> const & x)
+{
+  host_future<NumericT> result;
+  result.attach(stream, stream.enqueue(detail::async_norm_2_functor<NumericT>(x, result.result_location())));
+  return result;
+}
+
+/** @brief Enqueues reading the value of a scalar, e.g. once the operations computing it earlier in the stream have completed */
+template<typename NumericT>
+host_future<NumericT> async_read(host_stream & stream, viennacl::scalar<NumericT> const & s)
+{
+  host_future<NumericT> result;
+  result.attach(stream, stream.enqueue(detail::async_read_functor<NumericT>(s, result.result_location())));
+  return result;
+}
+
+/** @brief Enqueues the execution of an operation chain. The chain must not be modified until it has been executed. */
+template<typename NumericT>
+void async_execute(host_stream & stream, operation_chain<NumericT> & chain)
+{
+  stream.enqueue(detail::async_chain_functor<NumericT>(chain));
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,526 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/batched_operations.hpp
+    @brief Batched dense operations (GEMM, GEMV, TRSM, LU) on many small matrices on the CPU using a single thread or OpenMP.
+
+    The matrices of a batch are addressed either by a base pointer plus a constant stride between consecutive matrices, or by an array of pointers.
+    Each matrix is processed by a single thread without any temporaries on the heap.
+    Square matrices of size 2, 3, 4, 8, 16, 32 and 64 use kernels with compile-time dimensions, which work on local copies of the operands.
+    All other sizes, as well as non-square GEMM and GEMV operands, are processed by generic loops with run-time dimensions.
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Addresses the matrices of a batch stored at a constant distance from each other in a single buffer */
+template<typename PointerT>
+class strided_batch
+{
+public:
+  strided_batch(PointerT base, vcl_size_t stride) : base_(base), stride_(stride) {}
+
+  PointerT operator[](vcl_size_t i) const { return base_ + i * stride_; }
+
+private:
+  PointerT base_;
+  vcl_size_t stride_;
+};
+
+/** @brief Addresses the matrices of a batch through an array of pointers */
+template<typename PointerT>
+class pointer_array_batch
+{
+public:
+  explicit pointer_array_batch(PointerT const * pointers) : pointers_(pointers) {}
+
+  PointerT operator[](vcl_size_t i) const { return pointers_[i]; }
+
+private:
+  PointerT const * pointers_;
+};
+
+namespace detail
+{
+  /** @brief Distances between consecutive rows and columns of op(A) for a matrix with leading dimension 'ld' */
+  struct batched_layout
+  {
+    batched_layout(bool row_major, bool trans, vcl_size_t ld)
+      : row_stride((row_major != trans) ? ld : 1), col_stride((row_major != trans) ? 1 : ld) {}
+
+    vcl_size_t row_stride;
+    vcl_size_t col_stride;
+  };
+
+
+  //
+  // GEMM: C = alpha * op(A) * op(B) + beta * C
+  //
+
+  template<typename NumericT>
+  void batched_gemm_store(NumericT * C, NumericT alpha, NumericT value, NumericT beta)
+  {
+    // as in BLAS, C is not read if beta is zero (so that it may hold uninitialized data):
+    *C = (beta > 0 || beta < 0) ? alpha * value + beta * (*C) : alpha * value;
+  }
+
+  template<unsigned int N, typename NumericT>
+  void batched_gemm_fixed(NumericT alpha,
+                          NumericT const * A, batched_layout const & layout_A,
+                          NumericT const * B, batched_layout const & layout_B,
+                          NumericT beta,
+                          NumericT * C, batched_layout const & layout_C)
+  {
+    NumericT a[N][N];
+    NumericT b[N][N];
+    for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+      {
+        a[i][j] = A[i * layout_A.row_stride + j * layout_A.col_stride];
+        b[i][j] = B[i * layout_B.row_stride + j * layout_B.col_stride];
+      }
+
+    for (unsigned int i = 0; i < N; ++i)
+    {
+      NumericT c[N];
+      for (unsigned int j = 0; j < N; ++j)
+        c[j] = 0;
+      for (unsigned int k = 0; k < N; ++k)
+        for (unsigned int j = 0; j < N; ++j)
+          c[j] += a[i][k] * b[k][j];
+
+      for (unsigned int j = 0; j < N; ++j)
+        batched_gemm_store(C + i * layout_C.row_stride + j * layout_C.col_stride, alpha, c[j], beta);
+    }
+  }
+
+  template<typename NumericT>
+  void batched_gemm_single(vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                           NumericT alpha,
+                           NumericT const * A, batched_layout const & layout_A,
+                           NumericT const * B, batched_layout const & layout_B,
+                           NumericT beta,
+                           NumericT * C, batched_layout const & layout_C)
+  {
+    if (m == n && m == k)
+    {
+      switch (m)
+      {
+      case  2: batched_gemm_fixed< 2>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case  3: batched_gemm_fixed< 3>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case  4: batched_gemm_fixed< 4>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case  8: batched_gemm_fixed< 8>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case 16: batched_gemm_fixed<16>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case 32: batched_gemm_fixed<32>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      case 64: batched_gemm_fixed<64>(alpha, A, layout_A, B, layout_B, beta, C, layout_C); return;
+      default: break;
+      }
+    }
+
+    for (vcl_size_t i = 0; i < m; ++i)
+      for (vcl_size_t j = 0; j < n; ++j)
+      {
+        NumericT value = 0;
+        for (vcl_size_t l = 0; l < k; ++l)
+          value += A[i * layout_A.row_stride + l * layout_A.col_stride] * B[l * layout_B.row_stride + j * layout_B.col_stride];
+        batched_gemm_store(C + i * layout_C.row_stride + j * layout_C.col_stride, alpha, value, beta);
+      }
+  }
+
+
+  //
+  // GEMV: y = alpha * op(A) * x + beta * y
+  //
+
+  template<unsigned int N, typename NumericT>
+  void batched_gemv_fixed(NumericT alpha,
+                          NumericT const * A, batched_layout const & layout_A,
+                          NumericT const * x, vcl_size_t inc_x,
+                          NumericT beta,
+                          NumericT * y, vcl_size_t inc_y)
+  {
+    NumericT x_local[N];
+    for (unsigned int j = 0; j < N; ++j)
+      x_local[j] = x[j * inc_x];
+
+    for (unsigned int i = 0; i < N; ++i)
+    {
+      NumericT value = 0;
+      for (unsigned int j = 0; j < N; ++j)
+        value += A[i * layout_A.row_stride + j * layout_A.col_stride] * x_local[j];
+      batched_gemm_store(y + i * inc_y, alpha, value, beta);
+    }
+  }
+
+  template<typename NumericT>
+  void batched_gemv_single(vcl_size_t m, vcl_size_t n,
+                           NumericT alpha,
+                           NumericT const * A, batched_layout const & layout_A,
+                           NumericT const * x, vcl_size_t inc_x,
+                           NumericT beta,
+                           NumericT * y, vcl_size_t inc_y)
+  {
+    if (m == n)
+    {
+      switch (m)
+      {
+      case  2: batched_gemv_fixed< 2>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case  3: batched_gemv_fixed< 3>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case  4: batched_gemv_fixed< 4>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case  8: batched_gemv_fixed< 8>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case 16: batched_gemv_fixed<16>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case 32: batched_gemv_fixed<32>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      case 64: batched_gemv_fixed<64>(alpha, A, layout_A, x, inc_x, beta, y, inc_y); return;
+      default: break;
+      }
+    }
+
+    for (vcl_size_t i = 0; i < m; ++i)
+    {
+      NumericT value = 0;
+      for (vcl_size_t j = 0; j < n; ++j)
+        value += A[i * layout_A.row_stride + j * layout_A.col_stride] * x[j * inc_x];
+      batched_gemm_store(y + i * inc_y, alpha, value, beta);
+    }
+  }
+
+
+  //
+  // TRSM: op(A) X = alpha * B, B is overwritten with X
+  //
+
+  /** @brief Solves with a single right hand side. Only the triangle given by 'lower' is accessed. */
+  template<typename NumericT, typename SizeT>
+  void batched_trsv(SizeT m, bool lower, bool unit_diagonal,
+                    NumericT const * A, batched_layout const & layout_A,
+                    NumericT * b, vcl_size_t inc_b)
+  {
+    for (SizeT step = 0; step < m; ++step)
+    {
+      SizeT i = lower ? step : m - step - 1;
+      NumericT value = b[i * inc_b];
+      if (lower)
+      {
+        for (SizeT j = 0; j < i; ++j)
+          value -= A[i * layout_A.row_stride + j * layout_A.col_stride] * b[j * inc_b];
+      }
+      else
+      {
+        for (SizeT j = i + 1; j < m; ++j)
+          value -= A[i * layout_A.row_stride + j * layout_A.col_stride] * b[j * inc_b];
+      }
+      b[i * inc_b] = unit_diagonal ? value : value / A[i * layout_A.row_stride + i * layout_A.col_stride];
+    }
+  }
+
+  template<unsigned int N, typename NumericT>
+  void batched_trsm_fixed(vcl_size_t nrhs, bool lower, bool unit_diagonal, NumericT alpha,
+                          NumericT const * A, batched_layout const & layout_A,
+                          NumericT * B, batched_layout const & layout_B)
+  {
+    NumericT a[N * N];
+    for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+        a[i * N + j] = A[i * layout_A.row_stride + j * layout_A.col_stride];
+    batched_layout layout_a(true, false, N);
+
+    for (vcl_size_t col = 0; col < nrhs; ++col)
+    {
+      NumericT b[N];
+      for (unsigned int i = 0; i < N; ++i)
+        b[i] = alpha * B[i * layout_B.row_stride + col * layout_B.col_stride];
+
+      batched_trsv(N, lower, unit_diagonal, a, layout_a, b, 1);
+
+      for (unsigned int i = 0; i < N; ++i)
+        B[i * layout_B.row_stride + col * layout_B.col_stride] = b[i];
+    }
+  }
+
+  template<typename NumericT>
+  void batched_trsm_single(vcl_size_t m, vcl_size_t nrhs, bool lower, bool unit_diagonal,
+                           NumericT alpha,
+                           NumericT const * A, batched_layout const & layout_A,
+                           NumericT * B, batched_layout const & layout_B)
+  {
+    switch (m)
+    {
+    case  2: batched_trsm_fixed< 2>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case  3: batched_trsm_fixed< 3>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case  4: batched_trsm_fixed< 4>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case  8: batched_trsm_fixed< 8>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case 16: batched_trsm_fixed<16>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case 32: batched_trsm_fixed<32>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    case 64: batched_trsm_fixed<64>(nrhs, lower, unit_diagonal, alpha, A, layout_A, B, layout_B); return;
+    default: break;
+    }
+
+    for (vcl_size_t col = 0; col < nrhs; ++col)
+    {
+      NumericT * b = B + col * layout_B.col_stride;
+      if (alpha < 1 || alpha > 1)
+        for (vcl_size_t i = 0; i < m; ++i)
+          b[i * layout_B.row_stride] *= alpha;
+      batched_trsv(m, lower, unit_diagonal, A, layout_A, b, layout_B.row_stride);
+    }
+  }
+
+
+  //
+  // LU factorization with partial pivoting: P A = L U, L with unit diagonal.
+  // pivots[i] holds the row interchanged with row i in step i (zero-based, as in LAPACK's getrf apart from the offset).
+  //
+
+  /** @brief Returns false if an exactly zero pivot was encountered. The factorization is still completed in that case, skipping the respective elimination step. */
+  template<typename NumericT, typename SizeT, typename IndexT>
+  bool batched_lu_factorize_kernel(SizeT n, NumericT * A, batched_layout const & layout_A, IndexT * pivots)
+  {
+    bool regular = true;
+    for (SizeT k = 0; k < n; ++k)
+    {
+      SizeT pivot_row = k;
+      NumericT pivot_value = std::fabs(A[k * layout_A.row_stride + k * layout_A.col_stride]);
+      for (SizeT i = k + 1; i < n; ++i)
+      {
+        NumericT value = std::fabs(A[i * layout_A.row_stride + k * layout_A.col_stride]);
+        if (value > pivot_value)
+        {
+          pivot_value = value;
+          pivot_row = i;
+        }
+      }
+      pivots[k] = static_cast<IndexT>(pivot_row);
+
+      if (pivot_row != k)
+        for (SizeT j = 0; j < n; ++j)
+          std::swap(A[k * layout_A.row_stride + j * layout_A.col_stride], A[pivot_row * layout_A.row_stride + j * layout_A.col_stride]);
+
+      NumericT diag = A[k * layout_A.row_stride + k * layout_A.col_stride];
+      if (pivot_value <= 0)
+      {
+        regular = false;
+        continue;
+      }
+
+      for (SizeT i = k + 1; i < n; ++i)
+      {
+        NumericT factor = A[i * layout_A.row_stride + k * layout_A.col_stride] / diag;
+        A[i * layout_A.row_stride + k * layout_A.col_stride] = factor;
+        for (SizeT j = k + 1; j < n; ++j)
+          A[i * layout_A.row_stride + j * layout_A.col_stride] -= factor * A[k * layout_A.row_stride + j * layout_A.col_stride];
+      }
+    }
+    return regular;
+  }
+
+  template<unsigned int N, typename NumericT, typename IndexT>
+  bool batched_lu_factorize_fixed(NumericT * A, batched_layout const & layout_A, IndexT * pivots)
+  {
+    NumericT a[N * N];
+    for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+        a[i * N + j] = A[i * layout_A.row_stride + j * layout_A.col_stride];
+
+    bool regular = batched_lu_factorize_kernel(N, a, batched_layout(true, false, N), pivots);
+
+    for (unsigned int i = 0; i < N; ++i)
+      for (unsigned int j = 0; j < N; ++j)
+        A[i * layout_A.row_stride + j * layout_A.col_stride] = a[i * N + j];
+    return regular;
+  }
+
+  template<typename NumericT, typename IndexT>
+  bool batched_lu_factorize_single(vcl_size_t n, NumericT * A, batched_layout const & layout_A, IndexT * pivots)
+  {
+    switch (n)
+    {
+    case  2: return batched_lu_factorize_fixed< 2>(A, layout_A, pivots);
+    case  3: return batched_lu_factorize_fixed< 3>(A, layout_A, pivots);
+    case  4: return batched_lu_factorize_fixed< 4>(A, layout_A, pivots);
+    case  8: return batched_lu_factorize_fixed< 8>(A, layout_A, pivots);
+    case 16: return batched_lu_factorize_fixed<16>(A, layout_A, pivots);
+    case 32: return batched_lu_factorize_fixed<32>(A, layout_A, pivots);
+    case 64: return batched_lu_factorize_fixed<64>(A, layout_A, pivots);
+    default: break;
+    }
+    return batched_lu_factorize_kernel(n, A, layout_A, pivots);
+  }
+
+  template<typename NumericT, typename IndexT>
+  void batched_lu_substitute_single(vcl_size_t n, vcl_size_t nrhs,
+                                    NumericT const * LU, batched_layout const & layout_LU, IndexT const * pivots,
+                                    NumericT * B, batched_layout const & layout_B)
+  {
+    for (vcl_size_t k = 0; k < n; ++k)
+    {
+      vcl_size_t pivot_row = static_cast<vcl_size_t>(pivots[k]);
+      if (pivot_row != k)
+        for (vcl_size_t col = 0; col < nrhs; ++col)
+          std::swap(B[k * layout_B.row_stride + col * layout_B.col_stride], B[pivot_row * layout_B.row_stride + col * layout_B.col_stride]);
+    }
+
+    batched_trsm_single(n, nrhs, true,  true,  NumericT(1), LU, layout_LU, B, layout_B);
+    batched_trsm_single(n, nrhs, false, false, NumericT(1), LU, layout_LU, B, layout_B);
+  }
+
+} // namespace detail
+
+
+/** @brief Computes C_i = alpha * op(A_i) * op(B_i) + beta * C_i for all matrices of the batch
+*
+* op(A_i) is m x k, op(B_i) is k x n, and C_i is m x n. All matrices use the same layout and leading dimensions lda, ldb, ldc (as in BLAS).
+*
+* @param batch_count   Number of matrices in the batch
+* @param row_major     Whether the matrices are stored in row-major (true) or column-major (false) layout
+* @param trans_A       Whether op(A_i) is the transpose of A_i
+* @param trans_B       Whether op(B_i) is the transpose of B_i
+*/
+template<typename NumericT, typename BatchAT, typename BatchBT, typename BatchCT>
+void batched_gemm(vcl_size_t batch_count, bool row_major, bool trans_A, bool trans_B,
+                  vcl_size_t m, vcl_size_t n, vcl_size_t k,
+                  NumericT alpha,
+                  BatchAT const & A, vcl_size_t lda,
+                  BatchBT const & B, vcl_size_t ldb,
+                  NumericT beta,
+                  BatchCT const & C, vcl_size_t ldc)
+{
+  detail::batched_layout layout_A(row_major, trans_A, lda);
+  detail::batched_layout layout_B(row_major, trans_B, ldb);
+  detail::batched_layout layout_C(row_major, false,   ldc);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((batch_count * m * n * k) > VIENNACL_OPENMP_BATCHED_MIN_SIZE) num_threads(VIENNACL_OPENMP_BATCHED_NUM_THREADS)
+#endif
+  for (long i = 0; i < static_cast<long>(batch_count); ++i)
+    detail::batched_gemm_single(m, n, k, alpha, A[vcl_size_t(i)], layout_A, B[vcl_size_t(i)], layout_B, beta, C[vcl_size_t(i)], layout_C);
+}
+
+/** @brief Computes y_i = alpha * op(A_i) * x_i + beta * y_i for all matrices of the batch, where A_i is m x n
+*
+* @param batch_count   Number of matrices in the batch
+* @param row_major     Whether the matrices are stored in row-major (true) or column-major (false) layout
+* @param trans_A       Whether op(A_i) is the transpose of A_i
+*/
+template<typename NumericT, typename BatchAT, typename BatchXT, typename BatchYT>
+void batched_gemv(vcl_size_t batch_count, bool row_major, bool trans_A,
+                  vcl_size_t m, vcl_size_t n,
+                  NumericT alpha,
+                  BatchAT const & A, vcl_size_t lda,
+                  BatchXT const & x, vcl_size_t inc_x,
+                  NumericT beta,
+                  BatchYT const & y, vcl_size_t inc_y)
+{
+  detail::batched_layout layout_A(row_major, trans_A, lda);
+  vcl_size_t rows = trans_A ? n : m;
+  vcl_size_t cols = trans_A ? m : n;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((batch_count * m * n) > VIENNACL_OPENMP_BATCHED_MIN_SIZE) num_threads(VIENNACL_OPENMP_BATCHED_NUM_THREADS)
+#endif
+  for (long i = 0; i < static_cast<long>(batch_count); ++i)
+    detail::batched_gemv_single(rows, cols, alpha, A[vcl_size_t(i)], layout_A, x[vcl_size_t(i)], inc_x, beta, y[vcl_size_t(i)], inc_y);
+}
+
+/** @brief Solves op(A_i) X_i = alpha * B_i for all matrices of the batch. A_i is a triangular m x m matrix, B_i is m x nrhs and overwritten with X_i.
+*
+* @param batch_count    Number of matrices in the batch
+* @param row_major      Whether the matrices are stored in row-major (true) or column-major (false) layout
+* @param lower          Whether A_i is lower (true) or upper (false) triangular. Only this triangle of A_i is accessed.
+* @param unit_diagonal  Whether A_i has unit diagonal (the diagonal is not accessed then)
+* @param trans_A        Whether op(A_i) is the transpose of A_i
+*/
+template<typename NumericT, typename BatchAT, typename BatchBT>
+void batched_trsm(vcl_size_t batch_count, bool row_major, bool lower, bool unit_diagonal, bool trans_A,
+                  vcl_size_t m, vcl_size_t nrhs,
+                  NumericT alpha,
+                  BatchAT const & A, vcl_size_t lda,
+                  BatchBT const & B, vcl_size_t ldb)
+{
+  detail::batched_layout layout_A(row_major, trans_A, lda);
+  detail::batched_layout layout_B(row_major, false,   ldb);
+  bool op_lower = (lower != trans_A);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((batch_count * m * m * nrhs) > VIENNACL_OPENMP_BATCHED_MIN_SIZE) num_threads(VIENNACL_OPENMP_BATCHED_NUM_THREADS)
+#endif
+  for (long i = 0; i < static_cast<long>(batch_count); ++i)
+    detail::batched_trsm_single(m, nrhs, op_lower, unit_diagonal, alpha, A[vcl_size_t(i)], layout_A, B[vcl_size_t(i)], layout_B);
+}
+
+/** @brief Computes the LU factorizations P_i A_i = L_i U_i with partial pivoting for all n x n matrices of the batch. A_i is overwritten with L_i (without the unit diagonal) and U_i.
+*
+* @param batch_count   Number of matrices in the batch
+* @param row_major     Whether the matrices are stored in row-major (true) or column-major (false) layout
+* @param pivots        Batch of arrays with n entries each. pivots_i[k] is the (zero-based) row interchanged with row k in the k-th step.
+* @return              The number of matrices for which an exactly zero pivot was encountered
+*/
+template<typename BatchAT, typename BatchPivotT>
+vcl_size_t batched_lu_factorize(vcl_size_t batch_count, bool row_major,
+                                vcl_size_t n,
+                                BatchAT const & A, vcl_size_t lda,
+                                BatchPivotT const & pivots)
+{
+  detail::batched_layout layout_A(row_major, false, lda);
+  long num_singular = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for reduction(+: num_singular) if ((batch_count * n * n * n) > VIENNACL_OPENMP_BATCHED_MIN_SIZE) num_threads(VIENNACL_OPENMP_BATCHED_NUM_THREADS)
+#endif
+  for (long i = 0; i < static_cast<long>(batch_count); ++i)
+    if (!detail::batched_lu_factorize_single(n, A[vcl_size_t(i)], layout_A, pivots[vcl_size_t(i)]))
+      num_singular += 1;
+
+  return static_cast<vcl_size_t>(num_singular);
+}
+
+/** @brief Solves A_i X_i = B_i for all matrices of the batch, using the LU factorizations computed by batched_lu_factorize(). B_i is n x nrhs and overwritten with X_i. */
+template<typename BatchLUT, typename BatchPivotT, typename BatchBT>
+void batched_lu_substitute(vcl_size_t batch_count, bool row_major,
+                           vcl_size_t n, vcl_size_t nrhs,
+                           BatchLUT const & LU, vcl_size_t ldlu,
+                           BatchPivotT const & pivots,
+                           BatchBT const & B, vcl_size_t ldb)
+{
+  detail::batched_layout layout_LU(row_major, false, ldlu);
+  detail::batched_layout layout_B(row_major, false, ldb);
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel for if ((batch_count * n * n * nrhs) > VIENNACL_OPENMP_BATCHED_MIN_SIZE) num_threads(VIENNACL_OPENMP_BATCHED_NUM_THREADS)
+#endif
+  for (long i = 0; i < static_cast<long>(batch_count); ++i)
+    detail::batched_lu_substitute_single(n, nrhs, LU[vcl_size_t(i)], layout_LU, pivots[vcl_size_t(i)], B[vcl_size_t(i)], layout_B);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
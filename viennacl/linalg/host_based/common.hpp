@@ -23,6 +23,7 @@
 */
 
 #include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/openmp_thresholds.hpp"
 
 namespace viennacl
 {
@@ -22,10 +22,14 @@
     @brief Implementations of dense direct triangular solvers are found here.
 */
 
+#include <algorithm>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
 
 namespace viennacl
 {
@@ -114,75 +118,174 @@ namespace detail
     lower_inplace_solve_matrix(A, B, A_size, B_size, false);
   }
 
-}
+  /** @brief Runs the triangular solver on independent panels of right hand sides in parallel.
+  *
+  * @param A        The (small) system matrix
+  * @param B        The matrix of row vectors, where the solution is directly written to
+  */
+  template<typename LayoutAT, typename LayoutBT, typename NumericT, typename SolverTagT>
+  void inplace_solve_panels(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, SolverTagT)
+  {
+    typedef NumericT        value_type;
 
-//
-// Note: By convention, all size checks are performed in the calling frontend. No need to double-check here.
-//
+    static const vcl_size_t panel_size = 64;
 
-////////////////// upper triangular solver (upper_tag) //////////////////////////////////////
-/** @brief Direct inplace solver for triangular systems with multiple right hand sides, i.e. A \ B   (MATLAB notation)
-*
-* @param A        The system matrix
-* @param B        The matrix of row vectors, where the solution is directly written to
-*/
-template<typename NumericT, typename SolverTagT>
-void inplace_solve(matrix_base<NumericT> const & A,
-                   matrix_base<NumericT> & B,
-                   SolverTagT)
-{
-  typedef NumericT        value_type;
+    value_type const * data_A = extract_raw_pointer<value_type>(A);
+    value_type       * data_B = extract_raw_pointer<value_type>(B);
+
+    vcl_size_t A_start1 = viennacl::traits::start1(A);
+    vcl_size_t A_start2 = viennacl::traits::start2(A);
+    vcl_size_t A_inc1   = viennacl::traits::stride1(A);
+    vcl_size_t A_inc2   = viennacl::traits::stride2(A);
+    vcl_size_t A_size2  = viennacl::traits::size2(A);
+    vcl_size_t A_internal_size1  = viennacl::traits::internal_size1(A);
+    vcl_size_t A_internal_size2  = viennacl::traits::internal_size2(A);
 
-  value_type const * data_A = detail::extract_raw_pointer<value_type>(A);
-  value_type       * data_B = detail::extract_raw_pointer<value_type>(B);
-
-  vcl_size_t A_start1 = viennacl::traits::start1(A);
-  vcl_size_t A_start2 = viennacl::traits::start2(A);
-  vcl_size_t A_inc1   = viennacl::traits::stride1(A);
-  vcl_size_t A_inc2   = viennacl::traits::stride2(A);
-  //vcl_size_t A_size1  = viennacl::traits::size1(A);
-  vcl_size_t A_size2  = viennacl::traits::size2(A);
-  vcl_size_t A_internal_size1  = viennacl::traits::internal_size1(A);
-  vcl_size_t A_internal_size2  = viennacl::traits::internal_size2(A);
-
-  vcl_size_t B_start1 = viennacl::traits::start1(B);
-  vcl_size_t B_start2 = viennacl::traits::start2(B);
-  vcl_size_t B_inc1   = viennacl::traits::stride1(B);
-  vcl_size_t B_inc2   = viennacl::traits::stride2(B);
-  //vcl_size_t B_size1  = viennacl::traits::size1(B);
-  vcl_size_t B_size2  = viennacl::traits::size2(B);
-  vcl_size_t B_internal_size1  = viennacl::traits::internal_size1(B);
-  vcl_size_t B_internal_size2  = viennacl::traits::internal_size2(B);
-
-
-  if (A.row_major() && B.row_major())
+    vcl_size_t B_start1 = viennacl::traits::start1(B);
+    vcl_size_t B_start2 = viennacl::traits::start2(B);
+    vcl_size_t B_inc1   = viennacl::traits::stride1(B);
+    vcl_size_t B_inc2   = viennacl::traits::stride2(B);
+    vcl_size_t B_size2  = viennacl::traits::size2(B);
+    vcl_size_t B_internal_size1  = viennacl::traits::internal_size1(B);
+    vcl_size_t B_internal_size2  = viennacl::traits::internal_size2(B);
+
+    if (B_size2 == 0)
+      return;
+
+    vcl_size_t num_panels = (B_size2 - 1) / panel_size + 1;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((A_size2*B_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
+#endif
+    for (long panel_idx2 = 0; panel_idx2 < static_cast<long>(num_panels); ++panel_idx2)
+    {
+      vcl_size_t panel_start = static_cast<vcl_size_t>(panel_idx2) * panel_size;
+      vcl_size_t panel_cols  = std::min<vcl_size_t>(panel_size, B_size2 - panel_start);
+
+      matrix_array_wrapper<value_type const, LayoutAT, false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
+      matrix_array_wrapper<value_type,       LayoutBT, false>   wrapper_B(data_B, B_start1, B_start2 + panel_start * B_inc2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+
+      inplace_solve_matrix(wrapper_A, wrapper_B, A_size2, panel_cols, SolverTagT());
+    }
+  }
+
+  /** @brief Dispatches the triangular solver for small systems to the respective memory layouts */
+  template<typename NumericT, typename SolverTagT>
+  void inplace_solve_small(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, SolverTagT)
   {
-    detail::matrix_array_wrapper<value_type const, row_major, false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
-    detail::matrix_array_wrapper<value_type,       row_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+    if (A.row_major() && B.row_major())
+      inplace_solve_panels<row_major,    row_major   >(A, B, SolverTagT());
+    else if (A.row_major() && !B.row_major())
+      inplace_solve_panels<row_major,    column_major>(A, B, SolverTagT());
+    else if (!A.row_major() && B.row_major())
+      inplace_solve_panels<column_major, row_major   >(A, B, SolverTagT());
+    else
+      inplace_solve_panels<column_major, column_major>(A, B, SolverTagT());
+  }
+
+  /** @brief Recursive triangular solver for lower triangular matrices. Most of the work is cast into matrix-matrix products. */
+  template<typename NumericT, typename SolverTagT>
+  void inplace_solve_lower_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, SolverTagT)
+  {
+    static const vcl_size_t min_recursion_size = 64;
+
+    vcl_size_t n = viennacl::traits::size1(A);
+    if (n <= min_recursion_size)
+    {
+      inplace_solve_small(A, B, SolverTagT());
+      return;
+    }
 
-    detail::inplace_solve_matrix(wrapper_A, wrapper_B, A_size2, B_size2, SolverTagT());
+    vcl_size_t n1 = n / 2;
+    viennacl::range r1(0, n1);
+    viennacl::range r2(n1, n);
+    viennacl::range all_cols(0, viennacl::traits::size2(B));
+
+    viennacl::matrix_range<matrix_base<NumericT> > A_11(A, r1, r1);
+    viennacl::matrix_range<matrix_base<NumericT> > A_21(A, r2, r1);
+    viennacl::matrix_range<matrix_base<NumericT> > A_22(A, r2, r2);
+    viennacl::matrix_range<matrix_base<NumericT> > B_1(B, r1, all_cols);
+    viennacl::matrix_range<matrix_base<NumericT> > B_2(B, r2, all_cols);
+
+    inplace_solve_lower_recursive(A_11, B_1, SolverTagT());
+    viennacl::linalg::host_based::prod_impl(A_21, false, B_1, false, B_2, NumericT(-1), NumericT(1));
+    inplace_solve_lower_recursive(A_22, B_2, SolverTagT());
   }
-  else if (A.row_major() && !B.row_major())
+
+  /** @brief Recursive triangular solver for upper triangular matrices. Most of the work is cast into matrix-matrix products. */
+  template<typename NumericT, typename SolverTagT>
+  void inplace_solve_upper_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, SolverTagT)
   {
-    detail::matrix_array_wrapper<value_type const, row_major,    false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
-    detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+    static const vcl_size_t min_recursion_size = 64;
 
-    detail::inplace_solve_matrix(wrapper_A, wrapper_B, A_size2, B_size2, SolverTagT());
+    vcl_size_t n = viennacl::traits::size1(A);
+    if (n <= min_recursion_size)
+    {
+      inplace_solve_small(A, B, SolverTagT());
+      return;
+    }
+
+    vcl_size_t n1 = n / 2;
+    viennacl::range r1(0, n1);
+    viennacl::range r2(n1, n);
+    viennacl::range all_cols(0, viennacl::traits::size2(B));
+
+    viennacl::matrix_range<matrix_base<NumericT> > A_11(A, r1, r1);
+    viennacl::matrix_range<matrix_base<NumericT> > A_12(A, r1, r2);
+    viennacl::matrix_range<matrix_base<NumericT> > A_22(A, r2, r2);
+    viennacl::matrix_range<matrix_base<NumericT> > B_1(B, r1, all_cols);
+    viennacl::matrix_range<matrix_base<NumericT> > B_2(B, r2, all_cols);
+
+    inplace_solve_upper_recursive(A_22, B_2, SolverTagT());
+    viennacl::linalg::host_based::prod_impl(A_12, false, B_2, false, B_1, NumericT(-1), NumericT(1));
+    inplace_solve_upper_recursive(A_11, B_1, SolverTagT());
   }
-  else if (!A.row_major() && B.row_major())
+
+  template<typename NumericT>
+  void inplace_solve_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, viennacl::linalg::lower_tag)
   {
-    detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
-    detail::matrix_array_wrapper<value_type,       row_major,    false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+    inplace_solve_lower_recursive(A, B, viennacl::linalg::lower_tag());
+  }
 
-    detail::inplace_solve_matrix(wrapper_A, wrapper_B, A_size2, B_size2, SolverTagT());
+  template<typename NumericT>
+  void inplace_solve_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, viennacl::linalg::unit_lower_tag)
+  {
+    inplace_solve_lower_recursive(A, B, viennacl::linalg::unit_lower_tag());
   }
-  else
+
+  template<typename NumericT>
+  void inplace_solve_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, viennacl::linalg::upper_tag)
   {
-    detail::matrix_array_wrapper<value_type const, column_major, false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
-    detail::matrix_array_wrapper<value_type,       column_major, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+    inplace_solve_upper_recursive(A, B, viennacl::linalg::upper_tag());
+  }
 
-    detail::inplace_solve_matrix(wrapper_A, wrapper_B, A_size2, B_size2, SolverTagT());
+  template<typename NumericT>
+  void inplace_solve_recursive(matrix_base<NumericT> const & A, matrix_base<NumericT> & B, viennacl::linalg::unit_upper_tag)
+  {
+    inplace_solve_upper_recursive(A, B, viennacl::linalg::unit_upper_tag());
   }
+
+} // namespace detail
+
+//
+// Note: By convention, all size checks are performed in the calling frontend. No need to double-check here.
+//
+
+////////////////// triangular solver with multiple right hand sides //////////////////////////////////////
+/** @brief Direct inplace solver for triangular systems with multiple right hand sides, i.e. A \ B   (MATLAB notation)
+*
+* The system matrix is split recursively, so that most of the work is carried out by the blocked matrix-matrix product.
+* The remaining small triangular systems are solved in parallel for panels of right hand sides.
+*
+* @param A        The system matrix
+* @param B        The matrix of row vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename SolverTagT>
+void inplace_solve(matrix_base<NumericT> const & A,
+                   matrix_base<NumericT> & B,
+                   SolverTagT)
+{
+  detail::inplace_solve_recursive(A, B, SolverTagT());
 }
 
 
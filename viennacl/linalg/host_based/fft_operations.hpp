@@ -97,7 +97,7 @@ namespace detail
                                viennacl::vector<NumericT, AlignmentV> const & in, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size * 2); i2 += 2)
       { //change array to complex array
@@ -111,7 +111,7 @@ namespace detail
                                viennacl::vector_base<NumericT> const & in, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size * 2); i2 += 2)
       { //change array to complex array
@@ -125,7 +125,7 @@ namespace detail
                         viennacl::vector<NumericT, AlignmentV> & in, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size); i2++)
       {
@@ -140,7 +140,7 @@ namespace detail
                                NumericT const * in, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size * 2); i2 += 2)
       { //change array to complex array
@@ -153,7 +153,7 @@ namespace detail
     void copy_to_vector(std::complex<NumericT> * input_complex, NumericT * in, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size); i2++)
       {
@@ -169,7 +169,7 @@ namespace detail
     {
       std::vector<NumericT> temp(2 * size);
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size); i2++)
       {
@@ -184,7 +184,7 @@ namespace detail
     void zero2(NumericT *input1, NumericT *input2, vcl_size_t size)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
       for (long i2 = 0; i2 < long(size); i2++)
       {
@@ -801,7 +801,7 @@ void real_to_complex(viennacl::vector_base<NumericT> const & in,
   NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
   for (long i2 = 0; i2 < long(size); i2++)
   {
@@ -822,7 +822,7 @@ void complex_to_real(viennacl::vector_base<NumericT> const & in,
   NumericT       * data_out = detail::extract_raw_pointer<NumericT>(out);
 
 #ifdef VIENNACL_WITH_OPENMP
-#pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
   for (long i = 0; i < long(size); i++)
     data_out[i] = data_in[2*i];
@@ -837,7 +837,7 @@ void reverse(viennacl::vector_base<NumericT> & in)
   vcl_size_t size = in.size();
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+  #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
 #endif
   for (long i2 = 0; i2 < long(size); i2++)
   {
@@ -0,0 +1,364 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_GRAPH_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_GRAPH_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/graph_operations.hpp
+    @brief Graph traversals on the sparsity pattern of a compressed_matrix on the CPU using a single thread or OpenMP.
+
+    These kernels are the building blocks of the bandwidth reduction algorithms in viennacl/misc/cuthill_mckee.hpp and viennacl/misc/gibbs_poole_stockmeyer.hpp.
+    The pattern is interpreted as an undirected graph, hence it is assumed to be structurally symmetric. Diagonal entries are ignored.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  /** @brief Marks nodes not visited by a breadth-first search */
+  inline vcl_size_t csr_unvisited() { return ~vcl_size_t(0); }
+
+  /** @brief Marks nodes which are excluded from a breadth-first search, e.g. separators in nested dissection */
+  inline vcl_size_t csr_removed() { return ~vcl_size_t(0) - 1; }
+
+  /** @brief Read-only view of the sparsity pattern of a square compressed_matrix in host memory.
+  *
+  * For matrices in main memory the CSR arrays are used directly, otherwise they are copied to the host once.
+  */
+  class csr_graph
+  {
+  public:
+    template<typename NumericT, unsigned int AlignmentV>
+    explicit csr_graph(viennacl::compressed_matrix<NumericT, AlignmentV> const & A) : size_(A.size1())
+    {
+      assert( (A.size1() == A.size2()) && bool("Sparsity pattern of a non-square matrix is not a graph!"));
+
+      if (viennacl::traits::handle(A).get_active_handle_id() == viennacl::MAIN_MEMORY)
+      {
+        row_buffer_ = detail::extract_raw_pointer<unsigned int>(A.handle1());
+        col_buffer_ = detail::extract_raw_pointer<unsigned int>(A.handle2());
+      }
+      else
+      {
+        row_copy_.resize(A.size1() + 1);
+        col_copy_.resize(std::max<vcl_size_t>(A.nnz(), 1));
+        viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * row_copy_.size(), &(row_copy_[0]));
+        if (A.nnz() > 0)
+          viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * A.nnz(), &(col_copy_[0]));
+        row_buffer_ = &(row_copy_[0]);
+        col_buffer_ = &(col_copy_[0]);
+      }
+    }
+
+    vcl_size_t size() const { return size_; }
+    unsigned int const * row_buffer() const { return row_buffer_; }
+    unsigned int const * col_buffer() const { return col_buffer_; }
+
+  private:
+    csr_graph(csr_graph const &);
+    csr_graph & operator=(csr_graph const &);
+
+    vcl_size_t size_;
+    unsigned int const * row_buffer_;
+    unsigned int const * col_buffer_;
+    std::vector<unsigned int> row_copy_;
+    std::vector<unsigned int> col_copy_;
+  };
+
+  /** @brief Returns the number of threads used for traversing 'work' adjacency entries. */
+  inline long csr_graph_num_threads(vcl_size_t work)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (work > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      return std::max<long>(1, VIENNACL_OPENMP_VECTOR_NUM_THREADS);
+#else
+    (void)work;
+#endif
+    return 1;
+  }
+
+  /** @brief Computes the degree (number of off-diagonal entries) of each node */
+  inline void csr_graph_degrees(csr_graph const & g, std::vector<vcl_size_t> & degree)
+  {
+    unsigned int const * row_buffer = g.row_buffer();
+    unsigned int const * col_buffer = g.col_buffer();
+    degree.resize(g.size());
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (g.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long row = 0; row < static_cast<long>(g.size()); ++row)
+    {
+      vcl_size_t d = 0;
+      for (unsigned int j = row_buffer[row]; j < row_buffer[row+1]; ++j)
+        if (col_buffer[j] != static_cast<unsigned int>(row))
+          ++d;
+      degree[vcl_size_t(row)] = d;
+    }
+  }
+
+  /** @brief Orders nodes by increasing degree, ties are broken by the node index */
+  class csr_degree_less
+  {
+  public:
+    csr_degree_less(std::vector<vcl_size_t> const & degree) : degree_(degree) {}
+
+    bool operator()(vcl_size_t a, vcl_size_t b) const
+    {
+      return degree_[a] < degree_[b] || (degree_[a] == degree_[b] && a < b);
+    }
+
+  private:
+    std::vector<vcl_size_t> const & degree_;
+  };
+
+  /** @brief Level-synchronous breadth-first search starting at node 'root'.
+  *
+  * The nodes of each level are appended to 'order' and label[v] is set to the position of node v in 'order'.
+  * On entry, all nodes reachable from 'root' must be labeled csr_unvisited(). Nodes labeled csr_removed() are treated as removed from the graph.
+  *
+  * Each level is obtained in parallel from the previous one: First, every unvisited neighbor of the frontier is claimed by one of its visited neighbors.
+  * The claiming node is arbitrary if several threads compete, but each node ends up in exactly one of the per-thread lists, which are then merged.
+  * If 'cuthill_mckee_order' is set, the level is subsequently sorted by the position of the first visited neighbor ('parent') and by increasing degree,
+  * which yields the numbering of the Cuthill-McKee algorithm irrespective of the number of threads.
+  * Otherwise, the order of the nodes within a level is unspecified.
+  *
+  * @param g                    The graph
+  * @param degree               The node degrees as computed by csr_graph_degrees()
+  * @param root                 The start node
+  * @param cuthill_mckee_order  Whether to sort the nodes within each level as in the Cuthill-McKee algorithm
+  * @param label                Position of each node in 'order'. Length n
+  * @param claim                Scratch buffer. Length n
+  * @param order                Visited nodes are appended to this array level by level
+  * @param level_ptr            Output: Positions in 'order' at which the levels start, with the end of the last level as final entry
+  */
+  inline void csr_bfs(csr_graph const & g, std::vector<vcl_size_t> const & degree, vcl_size_t root, bool cuthill_mckee_order,
+                      std::vector<vcl_size_t> & label, std::vector<vcl_size_t> & claim,
+                      std::vector<vcl_size_t> & order, std::vector<vcl_size_t> & level_ptr)
+  {
+    unsigned int const * row_buffer = g.row_buffer();
+    unsigned int const * col_buffer = g.col_buffer();
+    vcl_size_t unvisited = csr_unvisited();
+
+    level_ptr.resize(1);
+    level_ptr[0] = order.size();
+    label[root] = order.size();
+    order.push_back(root);
+    level_ptr.push_back(order.size());
+
+    std::vector< std::vector<vcl_size_t> > thread_nodes;
+    std::vector<vcl_size_t> parent;
+    std::vector<vcl_size_t> child_ptr;
+    std::vector<vcl_size_t> level;
+
+    while (true)
+    {
+      vcl_size_t begin = level_ptr[level_ptr.size() - 2];
+      vcl_size_t end   = level_ptr.back();
+
+      vcl_size_t work = 0;
+      for (vcl_size_t p = begin; p < end; ++p)
+        work += row_buffer[order[p] + 1] - row_buffer[order[p]];
+      long thread_count = std::min<long>(csr_graph_num_threads(work), static_cast<long>(end - begin));
+
+      //
+      // Phase 1: Claim unvisited neighbors of the frontier (concurrent atomic writes store the position of one of the claiming nodes)
+      //
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (thread_count > 1) num_threads(thread_count)
+#endif
+      for (long t = 0; t < thread_count; ++t)
+      {
+        vcl_size_t chunk_begin = begin + ((end - begin) * vcl_size_t(t))     / vcl_size_t(thread_count);
+        vcl_size_t chunk_end   = begin + ((end - begin) * vcl_size_t(t + 1)) / vcl_size_t(thread_count);
+        for (vcl_size_t p = chunk_begin; p < chunk_end; ++p)
+        {
+          vcl_size_t u = order[p];
+          for (unsigned int j = row_buffer[u]; j < row_buffer[u+1]; ++j)
+            if (label[col_buffer[j]] == unvisited)
+            {
+              vcl_size_t & claimed_by = claim[col_buffer[j]];
+#ifdef VIENNACL_WITH_OPENMP
+              #pragma omp atomic write
+#endif
+              claimed_by = p;
+            }
+        }
+      }
+
+      //
+      // Phase 2: Each claiming node collects the nodes it has claimed successfully
+      //
+      thread_nodes.resize(vcl_size_t(thread_count));
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (thread_count > 1) num_threads(thread_count)
+#endif
+      for (long t = 0; t < thread_count; ++t)
+      {
+        std::vector<vcl_size_t> & nodes = thread_nodes[vcl_size_t(t)];
+        nodes.clear();
+        vcl_size_t chunk_begin = begin + ((end - begin) * vcl_size_t(t))     / vcl_size_t(thread_count);
+        vcl_size_t chunk_end   = begin + ((end - begin) * vcl_size_t(t + 1)) / vcl_size_t(thread_count);
+        for (vcl_size_t p = chunk_begin; p < chunk_end; ++p)
+        {
+          vcl_size_t u = order[p];
+          for (unsigned int j = row_buffer[u]; j < row_buffer[u+1]; ++j)
+            if (label[col_buffer[j]] == unvisited && claim[col_buffer[j]] == p)
+              nodes.push_back(col_buffer[j]);
+        }
+      }
+
+      level.clear();
+      for (vcl_size_t t = 0; t < thread_nodes.size(); ++t)
+        level.insert(level.end(), thread_nodes[t].begin(), thread_nodes[t].end());
+      if (level.size() == 0)
+        break;
+
+      vcl_size_t level_begin = order.size();
+      vcl_size_t level_size  = level.size();
+      order.resize(level_begin + level_size);
+      long level_threads = csr_graph_num_threads(level_size);
+#ifndef VIENNACL_WITH_OPENMP
+      (void)level_threads;
+#endif
+
+      if (cuthill_mckee_order)
+      {
+        //
+        // Phase 3: The parent of each node is its visited neighbor with the smallest position
+        //
+        parent.resize(level_size);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (level_threads > 1) num_threads(level_threads)
+#endif
+        for (long i = 0; i < static_cast<long>(level_size); ++i)
+        {
+          vcl_size_t w = level[vcl_size_t(i)];
+          vcl_size_t p_min = end;
+          for (unsigned int j = row_buffer[w]; j < row_buffer[w+1]; ++j)
+            if (label[col_buffer[j]] < p_min)
+              p_min = label[col_buffer[j]];
+          parent[vcl_size_t(i)] = p_min - begin;
+        }
+
+        //
+        // Phase 4: Counting sort by parent, then sort the children of each parent by degree
+        //
+        child_ptr.assign(end - begin + 1, 0);
+        for (vcl_size_t i = 0; i < level_size; ++i)
+          ++child_ptr[parent[i] + 1];
+        for (vcl_size_t p = 0; p < end - begin; ++p)
+          child_ptr[p + 1] += child_ptr[p];
+        for (vcl_size_t i = 0; i < level_size; ++i)
+          order[level_begin + child_ptr[parent[i]]++] = level[i];
+        // child_ptr[p] now holds the end of the children of parent p:
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (level_threads > 1) num_threads(level_threads)
+#endif
+        for (long p = 0; p < static_cast<long>(end - begin); ++p)
+        {
+          vcl_size_t child_begin = (p > 0) ? child_ptr[vcl_size_t(p) - 1] : 0;
+          std::sort(order.begin() + static_cast<long>(level_begin + child_begin),
+                    order.begin() + static_cast<long>(level_begin + child_ptr[vcl_size_t(p)]),
+                    csr_degree_less(degree));
+        }
+      }
+      else
+        std::copy(level.begin(), level.end(), order.begin() + static_cast<long>(level_begin));
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (level_threads > 1) num_threads(level_threads)
+#endif
+      for (long i = 0; i < static_cast<long>(level_size); ++i)
+        label[order[level_begin + vcl_size_t(i)]] = level_begin + vcl_size_t(i);
+
+      level_ptr.push_back(order.size());
+    }
+  }
+
+  /** @brief Resets the labels of the nodes in order[begin, end) to csr_unvisited() */
+  inline void csr_reset_labels(std::vector<vcl_size_t> const & order, vcl_size_t begin, vcl_size_t end, std::vector<vcl_size_t> & label)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (end - begin > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = static_cast<long>(begin); i < static_cast<long>(end); ++i)
+      label[order[vcl_size_t(i)]] = csr_unvisited();
+  }
+
+  /** @brief Returns the node of minimum degree in order[begin, end). Ties are broken by the node index. */
+  inline vcl_size_t csr_min_degree_node(std::vector<vcl_size_t> const & order, vcl_size_t begin, vcl_size_t end, std::vector<vcl_size_t> const & degree)
+  {
+    return *std::min_element(order.begin() + static_cast<long>(begin), order.begin() + static_cast<long>(end), csr_degree_less(degree));
+  }
+
+  /** @brief Returns the maximum number of nodes in a level of a level structure */
+  inline vcl_size_t csr_level_width(std::vector<vcl_size_t> const & level_ptr)
+  {
+    vcl_size_t width = 0;
+    for (vcl_size_t i = 1; i < level_ptr.size(); ++i)
+      width = std::max(width, level_ptr[i] - level_ptr[i-1]);
+    return width;
+  }
+
+  /** @brief Finds a pseudo-peripheral node in the connected component of 'root' using the algorithm of George and Liu.
+  *
+  * Starting from 'root', a breadth-first search is repeatedly started from a node of minimum degree in the last level, until the number of levels no longer increases.
+  * 'label' and 'claim' are scratch buffers of length n with all nodes of the component labeled csr_unvisited() on entry and on exit.
+  */
+  inline vcl_size_t csr_pseudo_peripheral_node(csr_graph const & g, std::vector<vcl_size_t> const & degree, vcl_size_t root,
+                                               std::vector<vcl_size_t> & label, std::vector<vcl_size_t> & claim,
+                                               std::vector<vcl_size_t> & order, std::vector<vcl_size_t> & level_ptr)
+  {
+    vcl_size_t num_levels = 0;
+    while (true)
+    {
+      order.clear();
+      csr_bfs(g, degree, root, false, label, claim, order, level_ptr);
+      csr_reset_labels(order, 0, order.size(), label);
+
+      if (level_ptr.size() - 1 <= num_levels)
+        return root;
+
+      num_levels = level_ptr.size() - 1;
+      root = csr_min_degree_node(order, level_ptr[level_ptr.size() - 2], level_ptr.back(), degree);
+    }
+  }
+
+} //namespace detail
+} //namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_HOST_STREAM_HPP_
+#define VIENNACL_LINALG_HOST_BASED_HOST_STREAM_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/host_stream.hpp
+    @brief In-order queues of host operations executed asynchronously by a dedicated thread, the host counterpart of an OpenCL command queue.
+
+    Operations enqueued into one stream run in the order of submission, operations in different streams may overlap.
+    Asynchronous execution requires VIENNACL_WITH_HOST_THREAD_POOL (POSIX threads). Otherwise, operations are executed immediately when enqueued.
+*/
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/shared_ptr.hpp"
+
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+#include <deque>
+#include <pthread.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief An operation enqueued into a host_stream */
+class host_task
+{
+public:
+  virtual ~host_task() {}
+  virtual void run() = 0;
+};
+
+namespace detail
+{
+  /** @brief Wraps a function object with operator()() const into a host_task */
+  template<typename FunctorT>
+  class host_functor_task : public host_task
+  {
+  public:
+    explicit host_functor_task(FunctorT const & functor) : functor_(functor) {}
+    void run() { functor_(); }
+
+  private:
+    FunctorT functor_;
+  };
+}
+
+/** @brief In-order queue of host operations, executed by a dedicated thread.
+  *
+  * If a task throws, the error is reported as std::runtime_error by wait() with the ticket of that task (e.g. through host_future::wait()),
+  * or otherwise by the next call to finish(). Errors of other tasks in the stream do not affect wait().
+  */
+class host_stream
+{
+public:
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+  host_stream() : enqueued_(0), completed_(0), shutdown_(false)
+  {
+    pthread_mutex_init(&mutex_, NULL);
+    pthread_cond_init(&work_available_, NULL);
+    pthread_cond_init(&work_completed_, NULL);
+    pthread_create(&thread_, NULL, &host_stream::worker_main, this);
+  }
+
+  ~host_stream()
+  {
+    pthread_mutex_lock(&mutex_);
+    shutdown_ = true;
+    pthread_cond_signal(&work_available_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(thread_, NULL);
+
+    pthread_cond_destroy(&work_completed_);
+    pthread_cond_destroy(&work_available_);
+    pthread_mutex_destroy(&mutex_);
+  }
+#else
+  host_stream() : enqueued_(0), completed_(0) {}
+#endif
+
+  /** @brief Enqueues a task and takes ownership of it. Returns the ticket of the task, to be passed to wait() or is_complete(). */
+  vcl_size_t enqueue_task(host_task * task)
+  {
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_lock(&mutex_);
+    queue_.push_back(task);
+    vcl_size_t ticket = ++enqueued_;
+    pthread_cond_signal(&work_available_);
+    pthread_mutex_unlock(&mutex_);
+    return ticket;
+#else
+    vcl_size_t ticket = ++enqueued_;
+    record_error(ticket, run_task(task));
+    ++completed_;
+    return ticket;
+#endif
+  }
+
+  /** @brief Enqueues a copy of the function object, which is called without arguments */
+  template<typename FunctorT>
+  vcl_size_t enqueue(FunctorT const & functor)
+  {
+    return enqueue_task(new detail::host_functor_task<FunctorT>(functor));
+  }
+
+  /** @brief Returns true if the task with the given ticket has completed */
+  bool is_complete(vcl_size_t ticket)
+  {
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_lock(&mutex_);
+    bool complete = (completed_ >= ticket);
+    pthread_mutex_unlock(&mutex_);
+    return complete;
+#else
+    return completed_ >= ticket;
+#endif
+  }
+
+  /** @brief Blocks until the task with the given ticket (and all tasks enqueued before it) have completed. Errors are not reported. */
+  void block(vcl_size_t ticket)
+  {
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_lock(&mutex_);
+    while (completed_ < ticket)
+      pthread_cond_wait(&work_completed_, &mutex_);
+    pthread_mutex_unlock(&mutex_);
+#else
+    (void)ticket;
+#endif
+  }
+
+  /** @brief Blocks until the task with the given ticket (and all tasks enqueued before it) have completed, then reports the error of that task if it failed */
+  void wait(vcl_size_t ticket)
+  {
+    block(ticket);
+    report_errors(ticket, ticket);
+  }
+
+  /** @brief Blocks until all enqueued tasks have completed, then reports the first error of a failed task not reported by wait() yet */
+  void finish()
+  {
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_lock(&mutex_);
+    vcl_size_t ticket = enqueued_;
+    pthread_mutex_unlock(&mutex_);
+#else
+    vcl_size_t ticket = enqueued_;
+#endif
+    block(ticket);
+    report_errors(1, ticket);
+  }
+
+private:
+  host_stream(host_stream const &);
+  host_stream & operator=(host_stream const &);
+
+  /** @brief Runs and deletes the task, returns the error message if it throws */
+  static std::string run_task(host_task * task)
+  {
+    std::string error;
+    try
+    {
+      task->run();
+    }
+    catch (std::exception const & e)
+    {
+      error = e.what();
+    }
+    catch (...)
+    {
+      error = "unknown exception";
+    }
+    delete task;
+    return error;
+  }
+
+  /** @brief Keeps the error of a failed task until it is reported. Must be called with the mutex held. */
+  void record_error(vcl_size_t ticket, std::string const & error)
+  {
+    if (error.size() > 0)
+      errors_[ticket] = error;
+  }
+
+  /** @brief Throws the first error recorded for a ticket in [first, last] and discards all errors in that range */
+  void report_errors(vcl_size_t first, vcl_size_t last)
+  {
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_lock(&mutex_);
+#endif
+    std::string error;
+    std::map<vcl_size_t, std::string>::iterator begin = errors_.lower_bound(first);
+    std::map<vcl_size_t, std::string>::iterator end   = errors_.upper_bound(last);
+    if (begin != end)
+      error = begin->second;
+    errors_.erase(begin, end);
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+    pthread_mutex_unlock(&mutex_);
+#endif
+
+    if (error.size() > 0)
+      throw std::runtime_error("Asynchronous host operation failed: " + error);
+  }
+
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+  static void * worker_main(void * arg)
+  {
+    static_cast<host_stream *>(arg)->worker_loop();
+    return NULL;
+  }
+
+  void worker_loop()
+  {
+    pthread_mutex_lock(&mutex_);
+    for (;;)
+    {
+      while (queue_.empty() && !shutdown_)
+        pthread_cond_wait(&work_available_, &mutex_);
+      if (queue_.empty())  // shut down once all work is done
+        break;
+
+      host_task * task = queue_.front();
+      queue_.pop_front();
+      pthread_mutex_unlock(&mutex_);
+
+      std::string error = run_task(task);
+
+      pthread_mutex_lock(&mutex_);
+      record_error(completed_ + 1, error);
+      ++completed_;
+      pthread_cond_broadcast(&work_completed_);
+    }
+    pthread_mutex_unlock(&mutex_);
+  }
+
+  std::deque<host_task *> queue_;
+  pthread_t       thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t  work_available_;
+  pthread_cond_t  work_completed_;
+#endif
+
+  vcl_size_t  enqueued_;
+  vcl_size_t  completed_;
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+  bool        shutdown_;
+#endif
+  std::map<vcl_size_t, std::string> errors_;
+};
+
+namespace detail
+{
+  /** @brief Storage of the result of an asynchronous operation. Waits for the operation on destruction, so that the result is never written to freed memory. */
+  template<typename T>
+  struct host_future_state
+  {
+    host_future_state() : stream(NULL), ticket(0), value() {}
+    ~host_future_state()
+    {
+      if (stream)
+        stream->block(ticket);
+    }
+
+    host_stream * stream;
+    vcl_size_t    ticket;
+    T             value;
+  };
+}
+
+/** @brief Result of an asynchronous host operation. get() blocks until the result is available.
+  *
+  * Copies share the result. Once the last copy is destroyed, the destructor blocks until the operation has completed.
+  * Copies must only be created and destroyed by the thread which enqueued the operation.
+  */
+template<typename T>
+class host_future
+{
+public:
+  host_future() : state_(new detail::host_future_state<T>()) {}
+
+  /** @brief Location the operation writes its result to. Only to be used by the enqueued task. */
+  T * result_location() const { return &(state_->value); }
+
+  /** @brief Associates the future with the task writing to result_location() */
+  void attach(host_stream & stream, vcl_size_t ticket)
+  {
+    state_->stream = &stream;
+    state_->ticket = ticket;
+  }
+
+  /** @brief Returns true if the result is available without blocking */
+  bool ready() const { return !state_->stream || state_->stream->is_complete(state_->ticket); }
+
+  /** @brief Blocks until the result is available */
+  void wait() const
+  {
+    if (state_->stream)
+      state_->stream->wait(state_->ticket);
+  }
+
+  /** @brief Blocks until the result is available and returns it */
+  T get() const
+  {
+    wait();
+    return state_->value;
+  }
+
+private:
+  viennacl::tools::shared_ptr< detail::host_future_state<T> > state_;
+};
+
+namespace detail
+{
+  /** @brief Owns the streams returned by get_host_stream(). The template parameter is only introduced for linkage reasons, never use a value other than the default. */
+  template<bool dummy = false>
+  class host_stream_registry
+  {
+  public:
+    ~host_stream_registry()
+    {
+      for (typename std::map<vcl_size_t, host_stream *>::iterator it = streams_.begin(); it != streams_.end(); ++it)
+        delete it->second;
+    }
+
+    host_stream & get(vcl_size_t id)
+    {
+      host_stream * & stream = streams_[id];
+      if (!stream)
+        stream = new host_stream();
+      return *stream;
+    }
+
+    void finish()
+    {
+      for (typename std::map<vcl_size_t, host_stream *>::iterator it = streams_.begin(); it != streams_.end(); ++it)
+        it->second->finish();
+    }
+
+    static host_stream_registry & instance()
+    {
+      static host_stream_registry registry;
+      return registry;
+    }
+
+  private:
+    std::map<vcl_size_t, host_stream *> streams_;
+  };
+}
+
+/** @brief Returns the host stream with the given ID, creating it on first use. Similar to viennacl::ocl::get_queue(), this function is not thread-safe. */
+inline host_stream & get_host_stream(vcl_size_t id = 0)
+{
+  return detail::host_stream_registry<>::instance().get(id);
+}
+
+/** @brief Blocks until all tasks in all streams obtained from get_host_stream() have completed */
+inline void finish_host_streams()
+{
+  detail::host_stream_registry<>::instance().finish();
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -37,11 +37,6 @@
 #include "viennacl/traits/stride.hpp"
 
 
-// Minimum vector size for using OpenMP on vector operations:
-#ifndef VIENNACL_OPENMP_ILU_MIN_SIZE
-  #define VIENNACL_OPENMP_ILU_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
 namespace linalg
@@ -65,7 +60,7 @@ void extract_L(compressed_matrix<NumericT> const & A,
   // Step 1: Count elements in L
   //
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -94,7 +89,7 @@ void extract_L(compressed_matrix<NumericT> const & A,
   // Step 3: Write entries:
   //
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -136,7 +131,7 @@ void icc_scale(compressed_matrix<NumericT> const & A,
   // Step 1: Determine D
   //
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -162,7 +157,7 @@ void icc_scale(compressed_matrix<NumericT> const & A,
   NumericT           *L_elements   = detail::extract_raw_pointer<NumericT>(L.handle());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -196,7 +191,7 @@ void icc_chow_patel_sweep(compressed_matrix<NumericT> & L,
 
   // backup:
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (L.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (L.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long i = 0; i < static_cast<long>(L.nnz()); ++i)
     L_backup[i] = L_elements[i];
@@ -204,7 +199,7 @@ void icc_chow_patel_sweep(compressed_matrix<NumericT> & L,
 
   // sweep
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(L.size1()); ++row)
   {
@@ -272,7 +267,7 @@ void extract_LU(compressed_matrix<NumericT> const & A,
   // Step 1: Count elements in L and U
   //
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -310,7 +305,7 @@ void extract_LU(compressed_matrix<NumericT> const & A,
   // Step 3: Write entries:
   //
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -362,7 +357,7 @@ void ilu_scale(compressed_matrix<NumericT> const & A,
   // Step 1: Determine D
   //
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -388,7 +383,7 @@ void ilu_scale(compressed_matrix<NumericT> const & A,
   NumericT           *L_elements   = detail::extract_raw_pointer<NumericT>(L.handle());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -409,7 +404,7 @@ void ilu_scale(compressed_matrix<NumericT> const & A,
   NumericT           *U_elements   = detail::extract_raw_pointer<NumericT>(U.handle());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+  #pragma omp parallel for if (A.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(A.size1()); ++row)
   {
@@ -523,20 +518,20 @@ void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
 
   // backup:
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (L.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (L.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long i = 0; i < static_cast<long>(L.nnz()); ++i)
     L_backup[i] = L_elements[i];
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (U_trans.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (U_trans.nnz() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long i = 0; i < static_cast<long>(U_trans.nnz()); ++i)
     U_backup[i] = U_elements[i];
 
   // sweep
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (L.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(L.size1()); ++row)
   {
@@ -633,7 +628,7 @@ void ilu_form_neumann_matrix(compressed_matrix<NumericT> & R,
   NumericT     *diag_R_ptr   = detail::extract_raw_pointer<NumericT>(diag_R.handle());
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if (R.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE)
+    #pragma omp parallel for if (R.size1() > VIENNACL_OPENMP_ILU_MIN_SIZE) num_threads(VIENNACL_OPENMP_ILU_NUM_THREADS)
 #endif
   for (long row = 0; row < static_cast<long>(R.size1()); ++row)
   {
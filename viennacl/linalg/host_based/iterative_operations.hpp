@@ -33,6 +33,7 @@
 #include "viennacl/traits/size.hpp"
 #include "viennacl/traits/start.hpp"
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/detail/op_applier.hpp"
 #include "viennacl/traits/stride.hpp"
 
@@ -128,19 +129,24 @@ namespace detail
     value_type         * data_buffer  = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
 
     // flush result buffer (cannot be expected to be zero)
-    for (vcl_size_t i = 0; i< Ap.size(); ++i)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (Ap.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(Ap.size()); ++i)
       Ap_buf[i] = 0;
 
-    // matrix-vector product with a general COO format
-    for (vcl_size_t i = 0; i < A.nnz(); ++i)
-      Ap_buf[coord_buffer[2*i]] += elements[i] * p_buf[coord_buffer[2*i+1]];
+    // matrix-vector product with a COO format sorted by rows, using a segmented reduction:
+    viennacl::linalg::host_based::detail::coo_prod_segmented(elements, coord_buffer, A.nnz(), p_buf, 0, 1, NumericT(1), Ap_buf, 0, 1);
 
     // computing the inner products (Ap, Ap) and (p, Ap):
-    // Note: The COO format does not allow to inject the subsequent operations into the matrix-vector product, because row and column ordering assumptions are too weak
+    // Note: The COO format does not allow to inject the subsequent operations into the matrix-vector product, because rows may be shared by several threads
     value_type inner_prod_ApAp = 0;
     value_type inner_prod_pAp = 0;
     value_type inner_prod_Ap_r0star = 0;
-    for (vcl_size_t i = 0; i<Ap.size(); ++i)
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star) if (Ap.size() > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(Ap.size()); ++i)
     {
       NumericT value_Ap = Ap_buf[i];
       NumericT value_p  =  p_buf[i];
@@ -364,6 +370,71 @@ namespace detail
       data_buffer[buffer_chunk_offset] = inner_prod_Ap_r0star;
   }
 
+
+  /** @brief Implementation of a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined CG algorithm.
+    *
+    * This routines computes for a matrix A and vectors 'p', 'Ap', and 'r0':
+    *   Ap = prod(A, p);
+    * and computes the two reduction stages for computing inner_prod(p,Ap), inner_prod(Ap,Ap), inner_prod(Ap, r0)
+    */
+  template<typename NumericT, unsigned int BlockSize>
+  void pipelined_prod_impl(block_compressed_matrix<NumericT, BlockSize> const & A,
+                           vector_base<NumericT> const & p,
+                           vector_base<NumericT> & Ap,
+                           NumericT const * r0star,
+                           vector_base<NumericT> & inner_prod_buffer,
+                           vcl_size_t buffer_chunk_size,
+                           vcl_size_t buffer_chunk_offset)
+  {
+    typedef NumericT     value_type;
+    typedef unsigned int index_type;
+
+    value_type       * Ap_buf            = detail::extract_raw_pointer<value_type>(Ap.handle()) + viennacl::traits::start(Ap);
+    value_type const *  p_raw            = detail::extract_raw_pointer<value_type>(p.handle());
+    value_type const *  p_buf            = p_raw + viennacl::traits::start(p);
+    value_type const * elements          = detail::extract_raw_pointer<value_type>(A.handle());
+    index_type const * block_row_buffer  = detail::extract_raw_pointer<index_type>(A.handle1());
+    index_type const * block_col_buffer  = detail::extract_raw_pointer<index_type>(A.handle2());
+    value_type         * data_buffer     = detail::extract_raw_pointer<value_type>(inner_prod_buffer);
+
+    value_type inner_prod_ApAp = 0;
+    value_type inner_prod_pAp = 0;
+    value_type inner_prod_Ap_r0star = 0;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: inner_prod_ApAp, inner_prod_pAp, inner_prod_Ap_r0star)
+#endif
+    for (long block_row = 0; block_row < static_cast<long>(A.block_rows()); ++block_row)
+    {
+      value_type y_block[BlockSize];
+      value_type x_buffer[BlockSize];
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        y_block[i] = 0;
+
+      for (vcl_size_t k = block_row_buffer[block_row]; k < block_row_buffer[block_row + 1]; ++k)
+      {
+        value_type const * x_block = bsr_load_block<value_type, BlockSize>(p_raw, viennacl::traits::start(p), 1, A.size2(), vcl_size_t(block_col_buffer[k]) * BlockSize, x_buffer);
+        bsr_block<value_type, BlockSize>::prod_add(elements + k * BlockSize * BlockSize, x_block, y_block);
+      }
+
+      vcl_size_t row_begin = vcl_size_t(block_row) * BlockSize;
+      vcl_size_t row_end   = std::min<vcl_size_t>(row_begin + BlockSize, A.size1());
+      for (vcl_size_t row = row_begin; row < row_end; ++row)
+      {
+        value_type sum = y_block[row - row_begin];
+        Ap_buf[row] = sum;
+        inner_prod_ApAp += sum * sum;
+        inner_prod_pAp  += p_buf[row] * sum;
+        inner_prod_Ap_r0star += r0star ? sum * r0star[row] : value_type(0);
+      }
+    }
+
+    data_buffer[    buffer_chunk_size] = inner_prod_ApAp;
+    data_buffer[2 * buffer_chunk_size] = inner_prod_pAp;
+    if (r0star)
+      data_buffer[buffer_chunk_offset] = inner_prod_Ap_r0star;
+  }
+
 } // namespace detail
 
 
@@ -505,6 +576,23 @@ void pipelined_cg_prod(hyb_matrix<NumericT> const & A,
   viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, PtrType(NULL), inner_prod_buffer, inner_prod_buffer.size() / 3, 0);
 }
 
+
+/** @brief Performs a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined CG algorithm.
+  *
+  * This routines computes for a matrix A and vectors 'p' and 'Ap':
+  *   Ap = prod(A, p);
+  * and computes the two reduction stages for computing inner_prod(p,Ap), inner_prod(Ap,Ap)
+  */
+template<typename NumericT, unsigned int BlockSize>
+void pipelined_cg_prod(block_compressed_matrix<NumericT, BlockSize> const & A,
+                       vector_base<NumericT> const & p,
+                       vector_base<NumericT> & Ap,
+                       vector_base<NumericT> & inner_prod_buffer)
+{
+  typedef NumericT const *    PtrType;
+  viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, PtrType(NULL), inner_prod_buffer, inner_prod_buffer.size() / 3, 0);
+}
+
 //////////////////////////
 
 
@@ -720,6 +808,26 @@ void pipelined_bicgstab_update_s(vector_base<NumericT> & s,
    viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, data_r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
  }
 
+ /** @brief Performs a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined BiCGStab algorithm.
+   *
+   * This routines computes for a matrix A and vectors 'p', 'Ap', and 'r0':
+   *   Ap = prod(A, p);
+   * and computes the two reduction stages for computing inner_prod(p,Ap), inner_prod(Ap,Ap), inner_prod(Ap, r0)
+   */
+ template<typename NumericT, unsigned int BlockSize>
+ void pipelined_bicgstab_prod(block_compressed_matrix<NumericT, BlockSize> const & A,
+                              vector_base<NumericT> const & p,
+                              vector_base<NumericT> & Ap,
+                              vector_base<NumericT> const & r0star,
+                              vector_base<NumericT> & inner_prod_buffer,
+                              vcl_size_t buffer_chunk_size,
+                              vcl_size_t buffer_chunk_offset)
+ {
+   NumericT const * data_r0star   = detail::extract_raw_pointer<NumericT>(r0star);
+
+   viennacl::linalg::host_based::detail::pipelined_prod_impl(A, p, Ap, data_r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+ }
+
 
 /////////////////////////////////////////////////////////////
 
@@ -817,7 +925,7 @@ void pipelined_gmres_gram_schmidt_stage1(vector_base<T> const & device_krylov_ba
     thread_count = static_cast<long>(omp_get_num_threads());
 #endif
 
-    long work_per_thread = long(v_k_size - 1) / thread_count;
+    long work_per_thread = long(v_k_size - 1) / thread_count + 1;
     long thread_start = work_per_thread * thread_id;
     long thread_stop  = std::min<long>(work_per_thread * (thread_id + 1), long(v_k_size));
 
@@ -38,11 +38,6 @@
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/prod.hpp"
 
-// Minimum Matrix size(size1*size2) for using OpenMP on matrix operations:
-#ifndef VIENNACL_OPENMP_MATRIX_MIN_SIZE
-  #define VIENNACL_OPENMP_MATRIX_MIN_SIZE  5000
-#endif
-
 namespace viennacl
 {
 namespace linalg
@@ -84,7 +79,7 @@ void convert(matrix_base<DestNumericT> & mat1, matrix_base<SrcNumericT> const &
     detail::matrix_array_wrapper<SrcNumericT const, row_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -96,7 +91,7 @@ void convert(matrix_base<DestNumericT> & mat1, matrix_base<SrcNumericT> const &
     detail::matrix_array_wrapper<SrcNumericT const, column_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -142,7 +137,7 @@ void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>
   if (proxy.lhs().row_major())
   {
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for(long i = 0; i < static_cast<long>(row_count*col_count); ++i)//This is the main part of the transposition
     {
@@ -185,7 +180,7 @@ void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>
   else
   {
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for(long i = 0; i < static_cast<long>(row_count*col_count); ++i)//This is the main part of the transposition
     {
@@ -266,7 +261,7 @@ void am(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -275,7 +270,7 @@ void am(matrix_base<NumericT> & mat1,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -290,7 +285,7 @@ void am(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -299,7 +294,7 @@ void am(matrix_base<NumericT> & mat1,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -363,7 +358,7 @@ void ambm(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -372,7 +367,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -381,7 +376,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -390,7 +385,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -406,7 +401,7 @@ void ambm(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -415,7 +410,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -424,7 +419,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -433,7 +428,7 @@ void ambm(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -498,7 +493,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -507,7 +502,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -516,7 +511,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -525,7 +520,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
         for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -541,7 +536,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     if (reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -550,7 +545,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -559,7 +554,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -568,7 +563,7 @@ void ambm_m(matrix_base<NumericT> & mat1,
     else if (!reciprocal_alpha && !reciprocal_beta)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long col = 0; col < static_cast<long>(A_size2); ++col)
         for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -603,7 +598,7 @@ void matrix_assign(matrix_base<NumericT> & mat, NumericT s, bool clear = false)
     detail::matrix_array_wrapper<value_type, row_major, false> wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -616,7 +611,7 @@ void matrix_assign(matrix_base<NumericT> & mat, NumericT s, bool clear = false)
     detail::matrix_array_wrapper<value_type, column_major, false> wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -650,7 +645,7 @@ void matrix_diagonal_assign(matrix_base<NumericT> & mat, NumericT s)
     detail::matrix_array_wrapper<value_type, row_major, false> wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       wrapper_A(row, row) = alpha;
@@ -660,7 +655,7 @@ void matrix_diagonal_assign(matrix_base<NumericT> & mat, NumericT s)
     detail::matrix_array_wrapper<value_type, column_major, false> wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       wrapper_A(row, row) = alpha;
@@ -887,7 +882,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, row_major, false> wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -900,7 +895,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, column_major, false> wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -950,7 +945,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, row_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -962,7 +957,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, column_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -1009,7 +1004,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, row_major, false> wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -1021,7 +1016,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, column_major, false> wrapper_C(data_C, C_start1, C_start2, C_inc1, C_inc2, C_internal_size1, C_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -1069,7 +1064,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, row_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long row = 0; row < static_cast<long>(A_size1); ++row)
       for (vcl_size_t col = 0; col < A_size2; ++col)
@@ -1081,7 +1076,7 @@ void element_op(matrix_base<NumericT> & A,
     detail::matrix_array_wrapper<value_type const, column_major, false> wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
 
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long col = 0; col < static_cast<long>(A_size2); ++col)
       for (vcl_size_t row = 0; row < A_size1; ++row)
@@ -1177,7 +1172,7 @@ void prod_impl(const matrix_base<NumericT> & mat, bool trans,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
       {
@@ -1233,7 +1228,7 @@ void prod_impl(const matrix_base<NumericT> & mat, bool trans,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size2); ++row)
       {
@@ -1273,7 +1268,7 @@ namespace detail
     // outer loop pair: Run over all blocks with indices (block_idx_i, block_idx_j) of the result matrix C:
     //
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((C_size1*C_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((C_size1*C_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
     for (long block_idx_i2=0; block_idx_i2<static_cast<long>(num_blocks_C1); ++block_idx_i2)
     {
@@ -1715,7 +1710,7 @@ void scaled_rank_1_update(matrix_base<NumericT> & mat1,
     if(reciprocal_alpha)
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
       {
@@ -1727,7 +1722,7 @@ void scaled_rank_1_update(matrix_base<NumericT> & mat1,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for (long row = 0; row < static_cast<long>(A_size1); ++row)
       {
@@ -1742,7 +1737,7 @@ void scaled_rank_1_update(matrix_base<NumericT> & mat1,
       if(reciprocal_alpha)
       {
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+        #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
         for (long col = 0; col < static_cast<long>(A_size2); ++col)  //run through matrix sequentially
         {
@@ -1754,7 +1749,7 @@ void scaled_rank_1_update(matrix_base<NumericT> & mat1,
       else
       {
 #ifdef VIENNACL_WITH_OPENMP
-        #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+        #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
         for (long col = 0; col < static_cast<long>(A_size2); ++col)  //run through matrix sequentially
         {
@@ -1806,7 +1801,7 @@ template <typename NumericT, typename S1>
    if (A.row_major())
    {
 #ifdef VIENNACL_WITH_OPENMP
-     #pragma omp parallel for if ((size1*size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+     #pragma omp parallel for if ((size1*size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
      for(long i2 = 0;  i2 < long(size) - 1; i2++)
      {
@@ -1820,7 +1815,7 @@ template <typename NumericT, typename S1>
    else
    {
 #ifdef VIENNACL_WITH_OPENMP
-     #pragma omp parallel for if ((size1*size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+     #pragma omp parallel for if ((size1*size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
      for(long i2 = 0;  i2 < long(size) - 1; i2++)
      {
@@ -1884,7 +1879,7 @@ template <typename NumericT, typename S1>
            for(vcl_size_t j = row_start; j < A_size1; j++)
                ss = ss + data_D[start1 + inc1 * j] * data_A[viennacl::row_major::mem_index((j) * A_inc1 + A_start1, (i) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)];
 #ifdef VIENNACL_WITH_OPENMP
-           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
            for(long j = static_cast<long>(row_start); j < static_cast<long>(A_size1); j++)
                data_A[viennacl::row_major::mem_index(static_cast<vcl_size_t>(j) * A_inc1 + A_start1, (i) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] =
@@ -1900,7 +1895,7 @@ template <typename NumericT, typename S1>
            for(vcl_size_t j = row_start; j < A_size1; j++)
                ss = ss + data_D[start1 + inc1 * j] * data_A[viennacl::column_major::mem_index((j) * A_inc1 + A_start1, (i) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)];
 #ifdef VIENNACL_WITH_OPENMP
-           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
            for(long j = static_cast<long>(row_start); j < static_cast<long>(A_size1); j++)
                data_A[viennacl::column_major::mem_index(static_cast<vcl_size_t>(j) * A_inc1 + A_start1, (i) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)]=
@@ -1949,7 +1944,7 @@ template <typename NumericT, typename S1>
 
            NumericT sum_Av = ss;
 #ifdef VIENNACL_WITH_OPENMP
-           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
            for(long j = 0; j < static_cast<long>(A_size2); j++) // A(i, j) = A(i, j) - 2 * D[j] * sum_Av
                data_A[viennacl::row_major::mem_index((i) * A_inc1 + A_start1, static_cast<vcl_size_t>(j) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)]  =
@@ -1966,7 +1961,7 @@ template <typename NumericT, typename S1>
 
            NumericT sum_Av = ss;
 #ifdef VIENNACL_WITH_OPENMP
-           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+           #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
            for(long j = 0; j < static_cast<long>(A_size2); j++) // A(i, j) = A(i, j) - 2 * D[j] * sum_Av
                data_A[viennacl::column_major::mem_index((i) * A_inc1 + A_start1, static_cast<vcl_size_t>(j) * A_inc2 + A_start2, A_internal_size1, A_internal_size2)]  =
@@ -2042,7 +2037,7 @@ template <typename NumericT, typename S1>
          for( int i = m - 1; i >= l; i--)
            {
 #ifdef VIENNACL_WITH_OPENMP
-             #pragma omp parallel for if ((Q_size1*Q_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+             #pragma omp parallel for if ((Q_size1*Q_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
              for(long k = 0; k < static_cast<long>(Q_size1); k++)
                {
@@ -2065,7 +2060,7 @@ template <typename NumericT, typename S1>
          for( int i = m - 1; i >= l; i--)
            {
 #ifdef VIENNACL_WITH_OPENMP
-             #pragma omp parallel for if ((Q_size1*Q_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+             #pragma omp parallel for if ((Q_size1*Q_size1) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
              for(long k = 0; k < static_cast<long>(Q_size1); k++)
                {
@@ -2119,7 +2114,7 @@ void copy_vec(matrix_base<NumericT>& A, vector_base<S1> & V,
     if (A.row_major())
     {
 #ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+    #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for(long i = static_cast<long>(row_start); i < static_cast<long>(A_size1); i++)
       {
@@ -2129,7 +2124,7 @@ void copy_vec(matrix_base<NumericT>& A, vector_base<S1> & V,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for(long i = static_cast<long>(row_start); i < static_cast<long>(A_size1); i++)
       {
@@ -2142,7 +2137,7 @@ void copy_vec(matrix_base<NumericT>& A, vector_base<S1> & V,
     if (A.row_major())
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for(long i = static_cast<long>(col_start); i < static_cast<long>(A_size2); i++)
       {
@@ -2152,7 +2147,7 @@ void copy_vec(matrix_base<NumericT>& A, vector_base<S1> & V,
     else
     {
 #ifdef VIENNACL_WITH_OPENMP
-      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE)
+      #pragma omp parallel for if ((A_size1*A_size2) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
 #endif
       for(long i = static_cast<long>(col_start); i < static_cast<long>(A_size2); i++)
       {
@@ -30,11 +30,21 @@
 
 #include "viennacl/linalg/host_based/common.hpp"
 
+#include <vector>
+#include <algorithm>
+
 namespace viennacl
 {
 namespace linalg
 {
 
+/** @brief The update scheme of the nonnegative matrix factorization */
+enum nmf_method
+{
+  NMF_MULTIPLICATIVE_UPDATE, // multiplicative updates as suggested by Lee and Seung
+  NMF_HALS                   // hierarchical alternating least squares (column-wise exact updates of W and H)
+};
+
 /** @brief Configuration class for the nonnegative-matrix-factorization algorithm. Specify tolerances, maximum iteration counts, etc., here. */
 class nmf_config
 {
@@ -42,7 +52,7 @@ public:
   nmf_config(double val_epsilon = 1e-4, double val_epsilon_stagnation = 1e-5,
       vcl_size_t num_max_iters = 10000, vcl_size_t num_check_iters = 100) :
       eps_(val_epsilon), stagnation_eps_(val_epsilon_stagnation), max_iters_(num_max_iters), check_after_steps_(
-          (num_check_iters > 0) ? num_check_iters : 1), print_relative_error_(false), iters_(0)
+          (num_check_iters > 0) ? num_check_iters : 1), print_relative_error_(false), method_(NMF_MULTIPLICATIVE_UPDATE), iters_(0)
   {
   }
 
@@ -110,6 +120,17 @@ public:
     print_relative_error_ = b;
   }
 
+  /** @brief Returns the update scheme */
+  nmf_method method() const
+  {
+    return method_;
+  }
+  /** @brief Sets the update scheme. Sparse input matrices always use NMF_HALS. */
+  void method(nmf_method m)
+  {
+    method_ = m;
+  }
+
   template<typename ScalarType>
   friend void nmf(viennacl::matrix_base<ScalarType> const & V,
       viennacl::matrix_base<ScalarType> & W, viennacl::matrix_base<ScalarType> & H,
@@ -121,6 +142,7 @@ private:
   vcl_size_t max_iters_;
   vcl_size_t check_after_steps_;
   bool print_relative_error_;
+  nmf_method method_;
 public:
   mutable vcl_size_t iters_;
 };
@@ -240,6 +262,82 @@ namespace host_based
     }
   }
 
+  /** @brief Hierarchical alternating least squares (HALS) update of a factor X (N x k), where the other factor is fixed.
+   *
+   * For each row x of X and each component r = 0, ..., k-1, the update x_r <- max(0, x_r + (b_r - (x G)_r) / G_rr) minimizes the residual in x_r exactly.
+   * B (N x k) holds the products of the data matrix with the other factor and G (k x k) is the Gram matrix of the other factor.
+   * Since the rows of X are independent, the element-wise update is fused with the product x G and carried out row by row in parallel.
+   * Components with G_rr = 0 are left unchanged.
+   *
+   * @param X     The factor to update (W, or the transpose of H)
+   * @param B     Product of the data matrix with the other factor: V H^T for W, V^T W for H^T
+   * @param G     Gram matrix of the other factor: H H^T for W, W^T W for H^T
+   */
+  template<typename NumericT>
+  void nmf_hals_update(viennacl::matrix_base<NumericT>       & X,
+                       viennacl::matrix_base<NumericT> const & B,
+                       viennacl::matrix_base<NumericT> const & G)
+  {
+    vcl_size_t N = X.size1();
+    vcl_size_t k = X.size2();
+
+    NumericT       * data_X = detail::extract_raw_pointer<NumericT>(X);
+    NumericT const * data_B = detail::extract_raw_pointer<NumericT>(B);
+    NumericT const * data_G = detail::extract_raw_pointer<NumericT>(G);
+
+    // the Gram matrix is small, keep a dense row-major copy together with the inverse diagonal:
+    detail::matrix_array_wrapper<NumericT const, row_major,    false> G_row(data_G, G.start1(), G.start2(), G.stride1(), G.stride2(), G.internal_size1(), G.internal_size2());
+    detail::matrix_array_wrapper<NumericT const, column_major, false> G_col(data_G, G.start1(), G.start2(), G.stride1(), G.stride2(), G.internal_size1(), G.internal_size2());
+    std::vector<NumericT> gram(k * k);
+    std::vector<NumericT> inv_diag(k);
+    for (vcl_size_t r = 0; r < k; ++r)
+    {
+      for (vcl_size_t s = 0; s < k; ++s)
+        gram[r * k + s] = G.row_major() ? G_row(r, s) : G_col(r, s);
+      inv_diag[r] = (gram[r * k + r] > 0) ? NumericT(1) / gram[r * k + r] : NumericT(0);
+    }
+
+    detail::matrix_array_wrapper<NumericT,       row_major,    false> X_row(data_X, X.start1(), X.start2(), X.stride1(), X.stride2(), X.internal_size1(), X.internal_size2());
+    detail::matrix_array_wrapper<NumericT,       column_major, false> X_col(data_X, X.start1(), X.start2(), X.stride1(), X.stride2(), X.internal_size1(), X.internal_size2());
+    detail::matrix_array_wrapper<NumericT const, row_major,    false> B_row(data_B, B.start1(), B.start2(), B.stride1(), B.stride2(), B.internal_size1(), B.internal_size2());
+    detail::matrix_array_wrapper<NumericT const, column_major, false> B_col(data_B, B.start1(), B.start2(), B.stride1(), B.stride2(), B.internal_size1(), B.internal_size2());
+    bool X_row_major = X.row_major();
+    bool B_row_major = B.row_major();
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if ((N*k) > VIENNACL_OPENMP_MATRIX_MIN_SIZE) num_threads(VIENNACL_OPENMP_MATRIX_NUM_THREADS)
+#endif
+    for (long i2 = 0; i2 < static_cast<long>(N); ++i2)
+    {
+      vcl_size_t i = static_cast<vcl_size_t>(i2);
+      std::vector<NumericT> x(k);
+      for (vcl_size_t r = 0; r < k; ++r)
+        x[r] = X_row_major ? X_row(i, r) : X_col(i, r);
+
+      for (vcl_size_t r = 0; r < k; ++r)
+      {
+        if (inv_diag[r] <= 0)
+          continue;
+
+        NumericT const * gram_r = &gram[r * k];
+        NumericT xg = 0;
+        for (vcl_size_t s = 0; s < k; ++s)
+          xg += x[s] * gram_r[s];
+
+        NumericT b = B_row_major ? B_row(i, r) : B_col(i, r);
+        x[r] = std::max(NumericT(0), x[r] + (b - xg) * inv_diag[r]);
+      }
+
+      for (vcl_size_t r = 0; r < k; ++r)
+      {
+        if (X_row_major)
+          X_row(i, r) = x[r];
+        else
+          X_col(i, r) = x[r];
+      }
+    }
+  }
+
 } //namespace host_based
 } //namespace linalg
 } //namespace viennacl
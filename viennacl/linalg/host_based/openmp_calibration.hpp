@@ -0,0 +1,282 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_OPENMP_CALIBRATION_HPP_
+#define VIENNACL_LINALG_HOST_BASED_OPENMP_CALIBRATION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/openmp_calibration.hpp
+    @brief Measures the OpenMP thresholds and thread counts of the host kernels on the current machine.
+
+    For each kernel family a representative kernel is timed for increasing problem sizes, once sequentially and once in parallel.
+    The threshold is placed between the largest size for which the sequential run is faster and the first size for which the parallel run is clearly faster.
+    Afterwards, the number of threads giving the shortest execution time for a large problem is determined.
+    Calibration takes a few seconds, hence the results should be stored with save_openmp_thresholds() and reused, see load_or_calibrate_openmp_thresholds().
+*/
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/timer.hpp"
+#include "viennacl/tools/matrix_generation.hpp"
+#include "viennacl/linalg/ilu_operations.hpp"
+#include "viennacl/linalg/host_based/openmp_thresholds.hpp"
+#include "viennacl/linalg/host_based/batched_operations.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  /** @brief Vector kernel used for calibration: x = y + z */
+  class openmp_calibration_vector_kernel
+  {
+  public:
+    void resize(vcl_size_t n)
+    {
+      viennacl::context ctx(viennacl::MAIN_MEMORY);
+      x_.resize(n, ctx, false);
+      y_.resize(n, ctx, false);
+      z_.resize(n, ctx, false);
+      y_ = viennacl::scalar_vector<double>(n, 1.0, ctx);
+      z_ = viennacl::scalar_vector<double>(n, 2.0, ctx);
+    }
+
+    vcl_size_t size() const { return x_.size(); }
+
+    void run() { x_ = y_ + z_; }
+
+  private:
+    viennacl::vector<double> x_, y_, z_;
+  };
+
+  /** @brief Dense matrix kernel used for calibration: A = B + C for square matrices */
+  class openmp_calibration_matrix_kernel
+  {
+  public:
+    openmp_calibration_matrix_kernel() : A_(1, 1, viennacl::context(viennacl::MAIN_MEMORY)),
+                                         B_(1, 1, viennacl::context(viennacl::MAIN_MEMORY)),
+                                         C_(1, 1, viennacl::context(viennacl::MAIN_MEMORY)) {}
+
+    void resize(vcl_size_t n)
+    {
+      vcl_size_t dim = 1;
+      while (4 * dim * dim <= n)
+        dim *= 2;
+
+      A_.resize(dim, dim, false);
+      B_.resize(dim, dim, false);
+      C_.resize(dim, dim, false);
+      B_ = viennacl::scalar_matrix<double>(dim, dim, 1.0);
+      C_ = viennacl::scalar_matrix<double>(dim, dim, 2.0);
+    }
+
+    vcl_size_t size() const { return A_.size1() * A_.size2(); }
+
+    void run() { A_ = B_ + C_; }
+
+  private:
+    viennacl::matrix<double> A_, B_, C_;
+  };
+
+  /** @brief ILU setup kernel used for calibration: extraction of the lower triangular part of a 2d finite difference matrix */
+  class openmp_calibration_ilu_kernel
+  {
+  public:
+    openmp_calibration_ilu_kernel() : A_(viennacl::context(viennacl::MAIN_MEMORY)) {}
+
+    void resize(vcl_size_t n)
+    {
+      vcl_size_t points = 1;
+      while (4 * points * points <= n)
+        points *= 2;
+
+      A_.resize(points * points, points * points, false);
+      viennacl::tools::generate_fdm_laplace(A_, points, points);
+    }
+
+    vcl_size_t size() const { return A_.size1(); }
+
+    void run()
+    {
+      viennacl::compressed_matrix<double> L(A_.size1(), A_.size2(), viennacl::traits::context(A_));
+      viennacl::linalg::host_based::extract_L(A_, L);
+    }
+
+  private:
+    viennacl::compressed_matrix<double> A_;
+  };
+
+  /** @brief Batched kernel used for calibration: products of 4x4 matrices */
+  class openmp_calibration_batched_kernel
+  {
+  public:
+    openmp_calibration_batched_kernel() : batch_count_(0) {}
+
+    void resize(vcl_size_t n)
+    {
+      batch_count_ = (n + 63) / 64;
+      A_.assign(batch_count_ * 16, 1.0);
+      B_.assign(batch_count_ * 16, 2.0);
+      C_.assign(batch_count_ * 16, 0.0);
+    }
+
+    vcl_size_t size() const { return batch_count_ * 64; }
+
+    void run()
+    {
+      viennacl::linalg::host_based::batched_gemm(batch_count_, true, false, false, 4, 4, 4,
+                                                 1.0, strided_batch<double const *>(&A_[0], 16), 4,
+                                                      strided_batch<double const *>(&B_[0], 16), 4,
+                                                 0.0, strided_batch<double *>(&C_[0], 16), 4);
+    }
+
+  private:
+    vcl_size_t batch_count_;
+    std::vector<double> A_, B_, C_;
+  };
+
+  /** @brief Returns the execution time of a single kernel run in seconds. Takes the best of three measurements, each repeating the kernel for at least one millisecond. */
+  template<typename KernelT>
+  double openmp_calibration_time(KernelT & kernel)
+  {
+    kernel.run(); // warm-up
+
+    double best_time = std::numeric_limits<double>::max();
+    viennacl::tools::timer timer;
+    for (int trial = 0; trial < 3; ++trial)
+    {
+      vcl_size_t runs = 0;
+      double elapsed = 0;
+      timer.start();
+      do
+      {
+        kernel.run();
+        ++runs;
+        elapsed = timer.get();
+      } while (elapsed < 1e-3);
+
+      best_time = std::min(best_time, elapsed / double(runs));
+    }
+    return best_time;
+  }
+
+  /** @brief Determines threshold and thread count for one kernel family, testing problem sizes up to max_size */
+  template<typename KernelT>
+  void calibrate_openmp_family(openmp_kernel_family family, KernelT & kernel, vcl_size_t max_size)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    vcl_size_t no_parallelization = std::numeric_limits<vcl_size_t>::max();
+
+    //
+    // Step 1: Threshold with the default number of threads
+    //
+    set_openmp_num_threads(family, 0);
+
+    vcl_size_t min_size = 0;
+    bool found_crossover = false;
+    for (vcl_size_t n = 256; n <= max_size; n *= 2)
+    {
+      kernel.resize(n);
+
+      set_openmp_min_size(family, no_parallelization);
+      double serial_time = openmp_calibration_time(kernel);
+
+      set_openmp_min_size(family, 0);
+      double parallel_time = openmp_calibration_time(kernel);
+
+      if (parallel_time < 0.9 * serial_time)
+      {
+        min_size = (min_size + kernel.size()) / 2;
+        found_crossover = true;
+        break;
+      }
+      min_size = kernel.size();
+    }
+
+    //
+    // Step 2: Number of threads for the largest problem size
+    //
+    set_openmp_min_size(family, 0);
+    kernel.resize(max_size);
+
+    int max_threads = omp_get_max_threads();
+    int best_threads = max_threads;
+    double best_time = std::numeric_limits<double>::max();
+    for (int threads = 1; threads <= max_threads; threads = (threads < max_threads && 2 * threads > max_threads) ? max_threads : 2 * threads)
+    {
+      set_openmp_num_threads(family, threads);
+      double time = openmp_calibration_time(kernel);
+      if (time < best_time)
+      {
+        best_time = time;
+        best_threads = threads;
+      }
+    }
+
+    set_openmp_num_threads(family, (best_threads == max_threads) ? 0 : best_threads);
+    set_openmp_min_size(family, (found_crossover && best_threads > 1) ? min_size : no_parallelization);
+#else
+    (void)family; (void)kernel; (void)max_size;
+#endif
+  }
+}
+
+/** @brief Measures the OpenMP thresholds and thread counts of all kernel families on the current machine and updates the runtime table.
+  *
+  * Without OpenMP this is a no-op (apart from writing the file).
+  *
+  * @param filename   If not empty, the resulting table is written to this file using save_openmp_thresholds()
+  */
+inline void calibrate_openmp_thresholds(std::string const & filename = std::string())
+{
+  detail::openmp_calibration_vector_kernel vector_kernel;
+  detail::calibrate_openmp_family(openmp_vector_kernels, vector_kernel, vcl_size_t(1) << 21);
+
+  detail::openmp_calibration_matrix_kernel matrix_kernel;
+  detail::calibrate_openmp_family(openmp_matrix_kernels, matrix_kernel, vcl_size_t(1) << 20);
+
+  detail::openmp_calibration_ilu_kernel ilu_kernel;
+  detail::calibrate_openmp_family(openmp_ilu_kernels, ilu_kernel, vcl_size_t(1) << 18);
+
+  detail::openmp_calibration_batched_kernel batched_kernel;
+  detail::calibrate_openmp_family(openmp_batched_kernels, batched_kernel, vcl_size_t(1) << 22);
+
+  if (filename.size() > 0)
+    save_openmp_thresholds(filename);
+}
+
+/** @brief Loads the OpenMP thresholds from a file. If the file cannot be read, the thresholds are calibrated and written to the file. */
+inline void load_or_calibrate_openmp_thresholds(std::string const & filename)
+{
+  if (!load_openmp_thresholds(filename))
+    calibrate_openmp_thresholds(filename);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
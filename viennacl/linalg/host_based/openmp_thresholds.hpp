@@ -0,0 +1,246 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_OPENMP_THRESHOLDS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_OPENMP_THRESHOLDS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/openmp_thresholds.hpp
+    @brief Runtime table of the problem sizes above which the host kernels use OpenMP, and of the number of threads used.
+
+    The host kernels are grouped into families (vector, matrix, ILU, and batched operations), each with its own entry.
+    Entries can be set directly, loaded from a file, or measured on the current machine, cf. viennacl/linalg/host_based/openmp_calibration.hpp.
+    If the environment variable VIENNACL_OPENMP_THRESHOLDS holds the name of a file written by save_openmp_thresholds(), it is loaded on first use.
+
+    Defining one of the macros VIENNACL_OPENMP_VECTOR_MIN_SIZE, VIENNACL_OPENMP_MATRIX_MIN_SIZE, VIENNACL_OPENMP_ILU_MIN_SIZE, or VIENNACL_OPENMP_BATCHED_MIN_SIZE
+    to a constant before including ViennaCL fixes the respective threshold at compile time, as in previous versions.
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "viennacl/forwards.h"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Families of host kernels sharing one OpenMP threshold and thread count */
+enum openmp_kernel_family
+{
+  openmp_vector_kernels = 0,  ///< Vector operations and FFT, size measured in vector entries
+  openmp_matrix_kernels,      ///< Dense matrix operations, size measured in matrix entries
+  openmp_ilu_kernels,         ///< Setup of ILU-type preconditioners, size measured in rows or nonzeros
+  openmp_batched_kernels,     ///< Batched operations on small matrices, size measured in floating point operations
+  openmp_kernel_family_count
+};
+
+namespace detail
+{
+  /** @brief Storage of the threshold table. The template parameter is only introduced for linkage reasons, never use a value other than the default. */
+  template<bool dummy = false>
+  struct openmp_threshold_table
+  {
+    static vcl_size_t min_size[openmp_kernel_family_count];
+    static int        num_threads[openmp_kernel_family_count];
+  };
+
+  template<bool dummy>
+  vcl_size_t openmp_threshold_table<dummy>::min_size[openmp_kernel_family_count] = {5000, 5000, 5000, 5000};
+
+  template<bool dummy>
+  int openmp_threshold_table<dummy>::num_threads[openmp_kernel_family_count] = {0, 0, 0, 0};
+
+  inline const char * openmp_kernel_family_name(openmp_kernel_family family)
+  {
+    switch (family)
+    {
+    case openmp_vector_kernels:  return "vector";
+    case openmp_matrix_kernels:  return "matrix";
+    case openmp_ilu_kernels:     return "ilu";
+    case openmp_batched_kernels: return "batched";
+    default: return "";
+    }
+  }
+
+  /** @brief Reads entries of the form '<family> <min_size> <num_threads>'. Lines starting with '#' are ignored.
+    *
+    * The entries are parsed into a copy of the table, which replaces the current table only if the whole file is valid.
+    */
+  inline bool read_openmp_thresholds(std::string const & filename)
+  {
+    std::ifstream file(filename.c_str());
+    if (!file)
+      return false;
+
+    vcl_size_t min_sizes[openmp_kernel_family_count];
+    int        num_threads[openmp_kernel_family_count];
+    for (int i = 0; i < openmp_kernel_family_count; ++i)
+    {
+      min_sizes[i]   = openmp_threshold_table<>::min_size[i];
+      num_threads[i] = openmp_threshold_table<>::num_threads[i];
+    }
+
+    std::string name;
+    while (file >> name)
+    {
+      if (name[0] == '#')
+      {
+        std::getline(file, name);
+        continue;
+      }
+
+      int family = 0;
+      while (family < openmp_kernel_family_count && name != openmp_kernel_family_name(openmp_kernel_family(family)))
+        ++family;
+      if (family == openmp_kernel_family_count)  // unknown kernel family
+        return false;
+
+      if (!(file >> min_sizes[family] >> num_threads[family]))
+        return false;
+    }
+    if (!file.eof())
+      return false;
+
+    for (int i = 0; i < openmp_kernel_family_count; ++i)
+    {
+      openmp_threshold_table<>::min_size[i]    = min_sizes[i];
+      openmp_threshold_table<>::num_threads[i] = num_threads[i];
+    }
+    return true;
+  }
+
+  inline bool load_openmp_thresholds_from_environment()
+  {
+    if (const char * filename = std::getenv("VIENNACL_OPENMP_THRESHOLDS"))
+      return read_openmp_thresholds(filename);
+    return false;
+  }
+
+  /** @brief Loads the table named by VIENNACL_OPENMP_THRESHOLDS exactly once.
+    *
+    * The initialization of a local static is guarded by the compiler (guaranteed by C++11, and done by GCC, Clang, and recent MSVC in C++98 mode as well),
+    * so concurrent first calls from several threads block until the table is loaded.
+    */
+  inline void init_openmp_thresholds()
+  {
+    static bool const loaded = load_openmp_thresholds_from_environment();
+    (void)loaded;
+  }
+}
+
+/** @brief Returns the problem size above which kernels of the given family run in parallel */
+inline vcl_size_t openmp_min_size(openmp_kernel_family family)
+{
+  detail::init_openmp_thresholds();
+  return detail::openmp_threshold_table<>::min_size[family];
+}
+
+/** @brief Returns the number of OpenMP threads used by parallel kernels of the given family */
+inline int openmp_num_threads(openmp_kernel_family family)
+{
+  detail::init_openmp_thresholds();
+  int num_threads = detail::openmp_threshold_table<>::num_threads[family];
+#ifdef VIENNACL_WITH_OPENMP
+  if (num_threads <= 0)
+    num_threads = omp_get_max_threads();
+#else
+  num_threads = 1;
+#endif
+  return num_threads;
+}
+
+/** @brief Sets the problem size above which kernels of the given family run in parallel. Must not be called while host kernels are running in other threads. */
+inline void set_openmp_min_size(openmp_kernel_family family, vcl_size_t min_size)
+{
+  detail::init_openmp_thresholds();
+  detail::openmp_threshold_table<>::min_size[family] = min_size;
+}
+
+/** @brief Sets the number of OpenMP threads for parallel kernels of the given family. A value of zero selects the OpenMP default. */
+inline void set_openmp_num_threads(openmp_kernel_family family, int num_threads)
+{
+  detail::init_openmp_thresholds();
+  detail::openmp_threshold_table<>::num_threads[family] = num_threads;
+}
+
+/** @brief Loads a table written by save_openmp_thresholds(). Families not listed in the file keep their current values. Returns false and leaves the table unchanged if the file cannot be read or is malformed. */
+inline bool load_openmp_thresholds(std::string const & filename)
+{
+  detail::init_openmp_thresholds();
+  return detail::read_openmp_thresholds(filename);
+}
+
+/** @brief Writes the current table to a file. Returns false if the file cannot be written. */
+inline bool save_openmp_thresholds(std::string const & filename)
+{
+  detail::init_openmp_thresholds();
+
+  std::ofstream file(filename.c_str());
+  if (!file)
+    return false;
+
+  file << "# ViennaCL OpenMP thresholds: <kernel family> <minimum size for parallel execution> <number of threads, 0 for default>" << std::endl;
+  for (int i = 0; i < openmp_kernel_family_count; ++i)
+    file << detail::openmp_kernel_family_name(openmp_kernel_family(i)) << " "
+         << detail::openmp_threshold_table<>::min_size[i] << " "
+         << detail::openmp_threshold_table<>::num_threads[i] << std::endl;
+  return bool(file);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+// Minimum problem sizes for using OpenMP, and the number of threads, as used by the host kernels:
+#ifndef VIENNACL_OPENMP_VECTOR_MIN_SIZE
+  #define VIENNACL_OPENMP_VECTOR_MIN_SIZE     viennacl::linalg::host_based::openmp_min_size(viennacl::linalg::host_based::openmp_vector_kernels)
+#endif
+#ifndef VIENNACL_OPENMP_VECTOR_NUM_THREADS
+  #define VIENNACL_OPENMP_VECTOR_NUM_THREADS  viennacl::linalg::host_based::openmp_num_threads(viennacl::linalg::host_based::openmp_vector_kernels)
+#endif
+
+#ifndef VIENNACL_OPENMP_MATRIX_MIN_SIZE
+  #define VIENNACL_OPENMP_MATRIX_MIN_SIZE     viennacl::linalg::host_based::openmp_min_size(viennacl::linalg::host_based::openmp_matrix_kernels)
+#endif
+#ifndef VIENNACL_OPENMP_MATRIX_NUM_THREADS
+  #define VIENNACL_OPENMP_MATRIX_NUM_THREADS  viennacl::linalg::host_based::openmp_num_threads(viennacl::linalg::host_based::openmp_matrix_kernels)
+#endif
+
+#ifndef VIENNACL_OPENMP_ILU_MIN_SIZE
+  #define VIENNACL_OPENMP_ILU_MIN_SIZE        viennacl::linalg::host_based::openmp_min_size(viennacl::linalg::host_based::openmp_ilu_kernels)
+#endif
+#ifndef VIENNACL_OPENMP_ILU_NUM_THREADS
+  #define VIENNACL_OPENMP_ILU_NUM_THREADS     viennacl::linalg::host_based::openmp_num_threads(viennacl::linalg::host_based::openmp_ilu_kernels)
+#endif
+
+#ifndef VIENNACL_OPENMP_BATCHED_MIN_SIZE
+  #define VIENNACL_OPENMP_BATCHED_MIN_SIZE    viennacl::linalg::host_based::openmp_min_size(viennacl::linalg::host_based::openmp_batched_kernels)
+#endif
+#ifndef VIENNACL_OPENMP_BATCHED_NUM_THREADS
+  #define VIENNACL_OPENMP_BATCHED_NUM_THREADS viennacl::linalg::host_based::openmp_num_threads(viennacl::linalg::host_based::openmp_batched_kernels)
+#endif
+
+#endif
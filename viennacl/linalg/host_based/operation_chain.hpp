@@ -0,0 +1,294 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_OPERATION_CHAIN_HPP_
+#define VIENNACL_LINALG_HOST_BASED_OPERATION_CHAIN_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/operation_chain.hpp
+    @brief Sequences of vector operations in main memory which are executed by a team of threads without a global barrier after each operation.
+
+    Each thread processes the same contiguous index range in every operation of the chain.
+    Since entry i of an element-wise operation only depends on entry i of its operands, consecutive element-wise operations run without synchronization.
+    Only reductions (inner products, norms) require barriers, after which all threads see the result.
+    Hence, a Krylov iteration consisting of a handful of vector updates and inner products costs a single fork/join instead of one per operation.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/thread_pool.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief A scalar factor in an operation chain, evaluated when the operation is executed: factor * (*numerator) / (*denominator).
+  *
+  * Numerator and denominator may refer to results of reductions earlier in the same chain. A NULL pointer stands for one.
+  */
+template<typename NumericT>
+class chain_scalar
+{
+public:
+  chain_scalar(NumericT value) : factor_(value), numerator_(NULL), denominator_(NULL) {}
+
+  chain_scalar(NumericT factor, NumericT const * numerator, NumericT const * denominator = NULL)
+    : factor_(factor), numerator_(numerator), denominator_(denominator) {}
+
+  NumericT operator()() const
+  {
+    NumericT value = factor_;
+    if (numerator_)
+      value *= *numerator_;
+    if (denominator_)
+      value /= *denominator_;
+    return value;
+  }
+
+private:
+  NumericT         factor_;
+  NumericT const * numerator_;
+  NumericT const * denominator_;
+};
+
+namespace detail
+{
+  /** @brief Strided view of a vector in main memory */
+  template<typename NumericT>
+  struct chain_vector
+  {
+    explicit chain_vector(vector_base<NumericT> const & v)
+      : data(const_cast<NumericT *>(detail::extract_raw_pointer<NumericT>(v))), start(viennacl::traits::start(v)), stride(viennacl::traits::stride(v)) {}
+
+    NumericT & operator[](vcl_size_t i) const { return data[i * stride + start]; }
+
+    NumericT * data;
+    vcl_size_t start;
+    vcl_size_t stride;
+  };
+
+  /** @brief Operation within a chain, executed by each thread on its index range */
+  template<typename NumericT>
+  class chain_operation
+  {
+  public:
+    virtual ~chain_operation() {}
+
+    /** @brief Processes the indices [begin, end) on thread 'thread_id' */
+    virtual void run(vcl_size_t thread_id, vcl_size_t begin, vcl_size_t end) = 0;
+
+    /** @brief Whether the operation combines contributions of all threads. If so, finalize() is called by a single thread once all threads have completed run(). */
+    virtual bool is_reduction() const { return false; }
+
+    virtual void prepare(vcl_size_t /*num_threads*/) {}
+    virtual void finalize(vcl_size_t /*num_threads*/) {}
+  };
+
+  /** @brief x = alpha * y + beta * z, where z is optional */
+  template<typename NumericT>
+  class chain_avbv : public chain_operation<NumericT>
+  {
+  public:
+    chain_avbv(vector_base<NumericT> & x, vector_base<NumericT> const & y, chain_scalar<NumericT> const & alpha)
+      : x_(x), y_(y), z_(y), alpha_(alpha), beta_(NumericT(0)), has_z_(false) {}
+
+    chain_avbv(vector_base<NumericT> & x, vector_base<NumericT> const & y, chain_scalar<NumericT> const & alpha,
+                                          vector_base<NumericT> const & z, chain_scalar<NumericT> const & beta)
+      : x_(x), y_(y), z_(z), alpha_(alpha), beta_(beta), has_z_(true) {}
+
+    void run(vcl_size_t, vcl_size_t begin, vcl_size_t end)
+    {
+      NumericT alpha = alpha_();
+      if (has_z_)
+      {
+        NumericT beta = beta_();
+        for (vcl_size_t i = begin; i < end; ++i)
+          x_[i] = alpha * y_[i] + beta * z_[i];
+      }
+      else
+        for (vcl_size_t i = begin; i < end; ++i)
+          x_[i] = alpha * y_[i];
+    }
+
+  private:
+    chain_vector<NumericT> x_, y_, z_;
+    chain_scalar<NumericT> alpha_, beta_;
+    bool has_z_;
+  };
+
+  /** @brief result = <x, y>, or result = sqrt(<x, x>) for the 2-norm */
+  template<typename NumericT>
+  class chain_inner_prod : public chain_operation<NumericT>
+  {
+    // distance of the partial results of two threads, avoids false sharing:
+    static const vcl_size_t padding = 64 / sizeof(NumericT) + 1;
+
+  public:
+    chain_inner_prod(vector_base<NumericT> const & x, vector_base<NumericT> const & y, NumericT & result, bool take_sqrt)
+      : x_(x), y_(y), result_(result), take_sqrt_(take_sqrt) {}
+
+    bool is_reduction() const { return true; }
+
+    void prepare(vcl_size_t num_threads) { partial_results_.resize(num_threads * padding); }
+
+    void run(vcl_size_t thread_id, vcl_size_t begin, vcl_size_t end)
+    {
+      NumericT value = 0;
+      for (vcl_size_t i = begin; i < end; ++i)
+        value += x_[i] * y_[i];
+      partial_results_[thread_id * padding] = value;
+    }
+
+    void finalize(vcl_size_t num_threads)
+    {
+      NumericT value = 0;
+      for (vcl_size_t i = 0; i < num_threads; ++i)
+        value += partial_results_[i * padding];
+      result_ = take_sqrt_ ? std::sqrt(value) : value;
+    }
+
+  private:
+    chain_vector<NumericT> x_, y_;
+    NumericT & result_;
+    bool take_sqrt_;
+    std::vector<NumericT> partial_results_;
+  };
+}
+
+/** @brief Records vector operations in main memory and executes them with a single fork/join of the host threads.
+  *
+  * All vectors in a chain must have the same size. Vectors may be identical, but must not partially overlap.
+  * Scalars produced by reductions are written to the host variables passed by reference, which can be used as numerator or denominator of later chain_scalar factors.
+  *
+  * Example (one step of the conjugate gradient method, given rr = <r, r>):
+  *
+  *   operation_chain<double> chain(N);
+  *   chain.inner_prod(p, Ap, pAp);
+  *   chain.avbv(x, x, 1.0, p, chain_scalar<double>( 1.0, &rr, &pAp));
+  *   chain.avbv(r, r, 1.0, Ap, chain_scalar<double>(-1.0, &rr, &pAp));
+  *   chain.inner_prod(r, r, rr_new);
+  *   chain.avbv(p, r, 1.0, p, chain_scalar<double>(1.0, &rr_new, &rr));
+  *   chain.execute();
+  */
+template<typename NumericT>
+class operation_chain : public host_job
+{
+  typedef detail::chain_operation<NumericT>   operation_type;
+
+public:
+  explicit operation_chain(vcl_size_t size) : size_(size) {}
+
+  ~operation_chain() { clear(); }
+
+  /** @brief Appends x = alpha * y */
+  void av(vector_base<NumericT> & x, vector_base<NumericT> const & y, chain_scalar<NumericT> const & alpha)
+  {
+    check_size(x); check_size(y);
+    operations_.push_back(new detail::chain_avbv<NumericT>(x, y, alpha));
+  }
+
+  /** @brief Appends x = alpha * y + beta * z */
+  void avbv(vector_base<NumericT> & x, vector_base<NumericT> const & y, chain_scalar<NumericT> const & alpha,
+                                       vector_base<NumericT> const & z, chain_scalar<NumericT> const & beta)
+  {
+    check_size(x); check_size(y); check_size(z);
+    operations_.push_back(new detail::chain_avbv<NumericT>(x, y, alpha, z, beta));
+  }
+
+  /** @brief Appends result = <x, y>. The result is available to all subsequent operations of the chain. */
+  void inner_prod(vector_base<NumericT> const & x, vector_base<NumericT> const & y, NumericT & result)
+  {
+    check_size(x); check_size(y);
+    operations_.push_back(new detail::chain_inner_prod<NumericT>(x, y, result, false));
+  }
+
+  /** @brief Appends result = ||x||_2. The result is available to all subsequent operations of the chain. */
+  void norm_2(vector_base<NumericT> const & x, NumericT & result)
+  {
+    check_size(x);
+    operations_.push_back(new detail::chain_inner_prod<NumericT>(x, x, result, true));
+  }
+
+  /** @brief Executes all operations in the order they were added. The chain can be executed repeatedly. */
+  void execute()
+  {
+    run_host_job(*this, size_ > VIENNACL_OPENMP_VECTOR_MIN_SIZE);
+  }
+
+  /** @brief Removes all operations from the chain */
+  void clear()
+  {
+    for (vcl_size_t i = 0; i < operations_.size(); ++i)
+      delete operations_[i];
+    operations_.clear();
+  }
+
+  /** @brief Executes the share of one thread, called by run_host_job() */
+  void execute(vcl_size_t thread_id, vcl_size_t num_threads, host_barrier & barrier)
+  {
+    if (thread_id == 0)
+      for (vcl_size_t i = 0; i < operations_.size(); ++i)
+        operations_[i]->prepare(num_threads);
+    barrier.wait();
+
+    // same static partitioning for all operations:
+    vcl_size_t begin = (size_ * thread_id) / num_threads;
+    vcl_size_t end   = (size_ * (thread_id + 1)) / num_threads;
+
+    for (vcl_size_t i = 0; i < operations_.size(); ++i)
+    {
+      operations_[i]->run(thread_id, begin, end);
+      if (operations_[i]->is_reduction())
+      {
+        barrier.wait();
+        if (thread_id == 0)
+          operations_[i]->finalize(num_threads);
+        barrier.wait();
+      }
+    }
+  }
+
+private:
+  operation_chain(operation_chain const &);
+  operation_chain & operator=(operation_chain const &);
+
+  void check_size(vector_base<NumericT> const & v) const
+  {
+    assert(viennacl::traits::size(v) == size_ && bool("Size mismatch in operation chain"));
+    assert(viennacl::traits::active_handle_id(v) == viennacl::MAIN_MEMORY && bool("Operation chains require vectors in main memory"));
+    (void)v;
+  }
+
+  vcl_size_t size_;
+  std::vector<operation_type *> operations_;
+};
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
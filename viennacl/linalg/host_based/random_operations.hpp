@@ -0,0 +1,120 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/random_operations.hpp
+    @brief Implementations of the generation of random vectors and matrices using a plain single-threaded or OpenMP-enabled execution on CPU
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/random.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+namespace detail
+{
+  /** @brief Fills the logical size1 x size2 array at 'data' with random numbers. Entry (i,j) receives the value with index i*size2+j of the random stream.
+   *
+   *  The stream is processed in Philox blocks, where each block is computed by a single thread. Thus, the result does not depend on the number of threads.
+   */
+  template<typename NumericT>
+  void fill_random(NumericT * data,
+                   vcl_size_t start1, vcl_size_t start2,
+                   vcl_size_t inc1,   vcl_size_t inc2,
+                   vcl_size_t size1,  vcl_size_t size2,
+                   vcl_size_t internal_size1, vcl_size_t internal_size2, bool row_major,
+                   viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+  {
+    vcl_size_t lanes      = viennacl::tools::detail::random_values_per_block<NumericT>::value;
+    vcl_size_t size       = size1 * size2;
+    vcl_size_t num_blocks = (size + lanes - 1) / lanes;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      NumericT values[4];
+      viennacl::tools::detail::random_block(vcl_size_t(block), seed, dist, values);
+
+      vcl_size_t index = vcl_size_t(block) * lanes;
+      for (vcl_size_t lane = 0; lane < lanes && index < size; ++lane, ++index)
+      {
+        vcl_size_t row = start1 + (index / size2) * inc1;
+        vcl_size_t col = start2 + (index % size2) * inc2;
+        data[row_major ? row * internal_size2 + col : row + col * internal_size1] = values[lane];
+      }
+    }
+  }
+}
+
+/** @brief Fills a vector with random numbers drawn from the given distribution.
+*
+* @param x     The vector to be filled
+* @param dist  The distribution, either viennacl::tools::uniform_distribution or viennacl::tools::normal_distribution
+* @param seed  The seed of the random number stream
+*/
+template<typename NumericT>
+void fill_random(vector_base<NumericT> & x, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  NumericT * data_x = detail::extract_raw_pointer<NumericT>(x);
+
+  detail::fill_random(data_x,
+                      viennacl::traits::start(x), 0, viennacl::traits::stride(x), 1,
+                      viennacl::traits::size(x), 1, x.internal_size(), 1, true,
+                      dist, seed);
+}
+
+/** @brief Fills a dense matrix with random numbers drawn from the given distribution. Entry (i,j) is the same for row-major and column-major matrices.
+*
+* @param A     The matrix to be filled
+* @param dist  The distribution, either viennacl::tools::uniform_distribution or viennacl::tools::normal_distribution
+* @param seed  The seed of the random number stream
+*/
+template<typename NumericT>
+void fill_random(matrix_base<NumericT> & A, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  NumericT * data_A = detail::extract_raw_pointer<NumericT>(A);
+
+  detail::fill_random(data_A,
+                      viennacl::traits::start1(A), viennacl::traits::start2(A),
+                      viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                      viennacl::traits::size1(A), viennacl::traits::size2(A),
+                      viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A), A.row_major(),
+                      dist, seed);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -31,7 +31,11 @@
 
 #include "viennacl/linalg/host_based/spgemm_vector.hpp"
 
+#include <cmath>
 #include <vector>
+#include <algorithm>
+#include <utility>
+#include <limits>
 
 #ifdef VIENNACL_WITH_OPENMP
 #include <omp.h>
@@ -119,7 +123,7 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for schedule(static)
 #endif
   for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
   {
@@ -152,7 +156,7 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   if (   alpha <= NumericT(1) && alpha >= NumericT(1)
       &&  beta <= NumericT(0) &&  beta >= NumericT(0)
       && vec.start() == 0 && vec.stride() == 1
-      && result.start() == 0 && result.stride() == 0)
+      && result.start() == 0 && result.stride() == 1)
   {
     prod_impl(mat, vec, result);
     return;
@@ -165,7 +169,7 @@ void prod_impl(const viennacl::compressed_matrix<NumericT, AlignmentV> & mat,
   unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
 
 #ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
+  #pragma omp parallel for schedule(static)
 #endif
   for (long row = 0; row < static_cast<long>(mat.size1()); ++row)
   {
@@ -1208,6 +1212,272 @@ namespace detail
 
     result_buf[last_row] = value;
   }
+
+  /** @brief Returns the number of contiguous chunks of nonzeros processed in parallel by the segmented reduction kernels for coordinate_matrix */
+  inline long coo_num_segments(vcl_size_t nnz)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+      return std::max<long>(1, std::min<long>(VIENNACL_OPENMP_VECTOR_NUM_THREADS, static_cast<long>(nnz)));
+#else
+    (void)nnz;
+#endif
+    return 1;
+  }
+
+  /** @brief Computes y += alpha * A * x for a coordinate_matrix A with entries sorted by row using a segmented reduction.
+  *
+  * The nonzeros are split into contiguous chunks of equal size, one per thread.
+  * Rows entirely within a chunk are owned by the respective thread and written directly.
+  * The partial sums of the first and the last row of each chunk may be shared with neighboring chunks, hence they are stored as carries and added in a short serial pass afterwards.
+  * Thus, no atomic operations are required.
+  */
+  template<typename NumericT>
+  void coo_prod_segmented(NumericT const * elements, unsigned int const * coords, vcl_size_t nnz,
+                          NumericT const * x, vcl_size_t x_start, vcl_size_t x_inc,
+                          NumericT alpha,
+                          NumericT * y, vcl_size_t y_start, vcl_size_t y_inc)
+  {
+    if (nnz == 0)
+      return;
+
+    long num_segments = coo_num_segments(nnz);
+    std::vector<unsigned int> carry_rows(2 * vcl_size_t(num_segments), 0);
+    std::vector<NumericT>     carry_values(2 * vcl_size_t(num_segments), 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_segments > 1) num_threads(num_segments)
+#endif
+    for (long seg = 0; seg < num_segments; ++seg)
+    {
+      vcl_size_t begin = (nnz * vcl_size_t(seg))     / vcl_size_t(num_segments);
+      vcl_size_t end   = (nnz * vcl_size_t(seg + 1)) / vcl_size_t(num_segments);
+      if (begin == end)
+        continue;
+
+      unsigned int first_row = coords[2*begin];
+      unsigned int last_row  = coords[2*(end-1)];
+      unsigned int row = first_row;
+      NumericT sum = 0;
+      for (vcl_size_t i = begin; i < end; ++i)
+      {
+        unsigned int current_row = coords[2*i];
+        if (current_row != row)
+        {
+          if (row == first_row)
+            carry_values[2*vcl_size_t(seg)] = sum;
+          else
+            y[vcl_size_t(row) * y_inc + y_start] += alpha * sum;
+          row = current_row;
+          sum = 0;
+        }
+        sum += elements[i] * x[vcl_size_t(coords[2*i+1]) * x_inc + x_start];
+      }
+
+      carry_rows[2*vcl_size_t(seg)]     = first_row;
+      carry_rows[2*vcl_size_t(seg) + 1] = last_row;
+      if (row == first_row)
+        carry_values[2*vcl_size_t(seg)] = sum;
+      else
+        carry_values[2*vcl_size_t(seg) + 1] = sum;
+    }
+
+    for (vcl_size_t i = 0; i < carry_rows.size(); ++i)
+      y[vcl_size_t(carry_rows[i]) * y_inc + y_start] += alpha * carry_values[i];
+  }
+
+  /** @brief Computes C += A * B for a coordinate_matrix A with entries sorted by row and dense matrices B and C using the segmented reduction of coo_prod_segmented().
+  *
+  * B and C are accessed through matrix_array_wrapper objects, hence the same kernel also covers transposed matrices B.
+  */
+  template<typename NumericT, typename DenseWrapperT, typename ResultWrapperT>
+  void coo_prod_dense_segmented(NumericT const * elements, unsigned int const * coords, vcl_size_t nnz,
+                                DenseWrapperT B, ResultWrapperT C, vcl_size_t num_cols)
+  {
+    if (nnz == 0 || num_cols == 0)
+      return;
+
+    long num_segments = coo_num_segments(nnz);
+    std::vector<unsigned int> carry_rows(2 * vcl_size_t(num_segments), 0);
+    std::vector<NumericT>     carry_values(2 * vcl_size_t(num_segments) * num_cols, 0);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (num_segments > 1) num_threads(num_segments)
+#endif
+    for (long seg = 0; seg < num_segments; ++seg)
+    {
+      vcl_size_t begin = (nnz * vcl_size_t(seg))     / vcl_size_t(num_segments);
+      vcl_size_t end   = (nnz * vcl_size_t(seg + 1)) / vcl_size_t(num_segments);
+      if (begin == end)
+        continue;
+
+      unsigned int first_row = coords[2*begin];
+      unsigned int last_row  = coords[2*(end-1)];
+      NumericT * carry_first = &(carry_values[0]) + 2 * vcl_size_t(seg) * num_cols;
+      NumericT * carry_last  = carry_first + num_cols;
+      for (vcl_size_t i = begin; i < end; ++i)
+      {
+        NumericT     value = elements[i];
+        unsigned int row   = coords[2*i];
+        vcl_size_t   col   = coords[2*i+1];
+        if (row == first_row)
+          for (vcl_size_t k = 0; k < num_cols; ++k)
+            carry_first[k] += value * B(col, k);
+        else if (row == last_row)
+          for (vcl_size_t k = 0; k < num_cols; ++k)
+            carry_last[k] += value * B(col, k);
+        else
+          for (vcl_size_t k = 0; k < num_cols; ++k)
+            C(vcl_size_t(row), k) += value * B(col, k);
+      }
+
+      carry_rows[2*vcl_size_t(seg)]     = first_row;
+      carry_rows[2*vcl_size_t(seg) + 1] = last_row;
+    }
+
+    for (vcl_size_t i = 0; i < carry_rows.size(); ++i)
+      for (vcl_size_t k = 0; k < num_cols; ++k)
+        C(vcl_size_t(carry_rows[i]), k) += carry_values[i * num_cols + k];
+  }
+
+  /** @brief Converts the coordinate (COO) arrays of a matrix to compressed sparse row (CSR) arrays.
+  *
+  * If the entries are sorted by row (as set up by viennacl::copy()), the row offsets are obtained in parallel from the row changes between consecutive entries and the column indices and values are copied in parallel.
+  * Otherwise, a stable counting sort by row is used, which runs on a single thread.
+  *
+  * @param coords        Row and column index of each entry, interleaved. Length 2*nnz
+  * @param elements      The values of the entries. Length nnz
+  * @param nnz           Number of entries
+  * @param rows          Number of rows of the matrix
+  * @param row_buffer    Output: Row offsets. Length rows+1
+  * @param col_buffer    Output: Column indices. Length nnz
+  * @param csr_elements  Output: Values. Length nnz
+  */
+  template<typename NumericT>
+  void coo_to_csr(unsigned int const * coords, NumericT const * elements, vcl_size_t nnz, vcl_size_t rows,
+                  unsigned int * row_buffer, unsigned int * col_buffer, NumericT * csr_elements)
+  {
+    long unsorted = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(+: unsorted) if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 1; i < static_cast<long>(nnz); ++i)
+      if (coords[2*i] < coords[2*i-2])
+        ++unsorted;
+
+    if (unsorted == 0)
+    {
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+      for (long i = 0; i < static_cast<long>(nnz); ++i)
+      {
+        // entry i is the first one of all rows between the row of the previous entry (exclusive) and its own row (inclusive):
+        unsigned int row       = coords[2*i];
+        unsigned int first_row = (i > 0) ? coords[2*i-2] + 1 : 0;
+        for (unsigned int r = first_row; r <= row; ++r)
+          row_buffer[r] = static_cast<unsigned int>(i);
+
+        col_buffer[i]   = coords[2*i+1];
+        csr_elements[i] = elements[i];
+      }
+
+      vcl_size_t tail_begin = (nnz > 0) ? vcl_size_t(coords[2*nnz-2]) + 1 : 0;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for if (rows - tail_begin > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+      for (long r = static_cast<long>(tail_begin); r <= static_cast<long>(rows); ++r)
+        row_buffer[r] = static_cast<unsigned int>(nnz);
+    }
+    else
+    {
+      std::fill(row_buffer, row_buffer + rows + 1, 0u);
+      for (vcl_size_t i = 0; i < nnz; ++i)
+        ++row_buffer[coords[2*i] + 1];
+      for (vcl_size_t r = 0; r < rows; ++r)
+        row_buffer[r + 1] += row_buffer[r];
+
+      std::vector<unsigned int> next_entry(row_buffer, row_buffer + rows);
+      for (vcl_size_t i = 0; i < nnz; ++i)
+      {
+        unsigned int index = next_entry[coords[2*i]]++;
+        col_buffer[index]   = coords[2*i+1];
+        csr_elements[index] = elements[i];
+      }
+    }
+  }
+
+  /** @brief Computes the CSR arrays of the symmetrically permuted matrix P * A * P^T, i.e. entry (i,j) of A becomes entry (perm[i], perm[j]).
+  *
+  * The row lengths are gathered in parallel, followed by a prefix sum. Then each row of the result is filled and sorted by column index in parallel.
+  *
+  * @param row_buffer    Row offsets of A. Length n+1
+  * @param col_buffer    Column indices of A
+  * @param elements      Values of A
+  * @param n             Number of rows and columns of A
+  * @param perm          The permutation: perm[i] is the new index of row and column i. Length n
+  * @param new_row_buffer  Output: Row offsets. Length n+1
+  * @param new_col_buffer  Output: Column indices. Length nnz
+  * @param new_elements    Output: Values. Length nnz
+  */
+  template<typename NumericT, typename IndexT>
+  void csr_permute(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t n,
+                   IndexT const * perm,
+                   unsigned int * new_row_buffer, unsigned int * new_col_buffer, NumericT * new_elements)
+  {
+    std::vector<vcl_size_t> inverse_perm(n);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(n); ++i)
+    {
+      inverse_perm[vcl_size_t(perm[i])] = vcl_size_t(i);
+      new_row_buffer[vcl_size_t(perm[i]) + 1] = row_buffer[i+1] - row_buffer[i];
+    }
+
+    new_row_buffer[0] = 0;
+    for (vcl_size_t i = 0; i < n; ++i)
+      new_row_buffer[i+1] += new_row_buffer[i];
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel if (n > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    {
+      std::vector< std::pair<unsigned int, NumericT> > row_entries;
+
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long new_row = 0; new_row < static_cast<long>(n); ++new_row)
+      {
+        vcl_size_t old_row = inverse_perm[vcl_size_t(new_row)];
+        row_entries.resize(0);
+        for (unsigned int j = row_buffer[old_row]; j < row_buffer[old_row+1]; ++j)
+          row_entries.push_back(std::make_pair(static_cast<unsigned int>(perm[col_buffer[j]]), elements[j]));
+        std::sort(row_entries.begin(), row_entries.end());
+
+        unsigned int offset = new_row_buffer[new_row];
+        for (vcl_size_t j = 0; j < row_entries.size(); ++j)
+        {
+          new_col_buffer[offset + j] = row_entries[j].first;
+          new_elements[offset + j]   = row_entries[j].second;
+        }
+      }
+    }
+  }
+
+  /** @brief Permutes the entries of a strided array: Entry i of 'src' becomes entry perm[i] of 'dest'. */
+  template<typename NumericT, typename IndexT>
+  void vector_permute(NumericT const * src, vcl_size_t src_start, vcl_size_t src_inc,
+                      NumericT * dest, vcl_size_t dest_start, vcl_size_t dest_inc,
+                      vcl_size_t size, IndexT const * perm)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(size); ++i)
+      dest[dest_start + vcl_size_t(perm[i]) * dest_inc] = src[src_start + vcl_size_t(i) * src_inc];
+  }
 }
 
 /** @brief Carries out matrix-vector multiplication with a coordinate_matrix
@@ -1230,20 +1500,30 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & mat,
   NumericT     const * elements     = detail::extract_raw_pointer<NumericT>(mat.handle());
   unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle12());
 
+  vcl_size_t result_size  = result.size();
+  vcl_size_t result_start = result.start();
+  vcl_size_t result_inc   = result.stride();
+
   if (beta < 0 || beta > 0)
   {
-    for (vcl_size_t i = 0; i< result.size(); ++i)
-      result_buf[i * result.stride() + result.start()] *= beta;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (result_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(result_size); ++i)
+      result_buf[vcl_size_t(i) * result_inc + result_start] *= beta;
   }
   else // flush
   {
-    for (vcl_size_t i = 0; i< result.size(); ++i)
-      result_buf[i * result.stride() + result.start()] = 0;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (result_size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(result_size); ++i)
+      result_buf[vcl_size_t(i) * result_inc + result_start] = 0;
   }
 
-  for (vcl_size_t i = 0; i < mat.nnz(); ++i)
-    result_buf[coord_buffer[2*i] * result.stride() + result.start()]
-      += alpha * elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
+  detail::coo_prod_segmented(elements, coord_buffer, mat.nnz(),
+                             vec_buf, vec.start(), vec.stride(),
+                             alpha, result_buf, result_start, result_inc);
 }
 
 /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
@@ -1289,74 +1569,34 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
   detail::matrix_array_wrapper<NumericT, column_major, false>
       result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-  if ( d_mat.row_major() ) {
-
+  // filling result with zeros, as the products are accumulated:
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
-    {
-      if (result.row_major())
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_row(row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_col(row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-        NumericT y = d_mat_wrapper_row( c, col);
-        if (result.row_major())
-          result_wrapper_row(r, col) += x * y;
-        else
-          result_wrapper_col(r, col) += x * y;
-      }
-    }
+  for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
+  {
+    if (result.row_major())
+      for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
+        result_wrapper_row(row, col) = (NumericT)0;
+    else
+      for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
+        result_wrapper_col(row, col) = (NumericT)0;
   }
 
-  else {
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col)
-    {
-      if (result.row_major())
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_row( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col) {
-
-      for (vcl_size_t i = 0; i < sp_mat.nnz(); ++i) {
-
-        NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-        vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-        vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-        NumericT y = d_mat_wrapper_col( c, col);
-
-        if (result.row_major())
-          result_wrapper_row( r, col) += x*y;
-        else
-          result_wrapper_col( r, col) += x*y;
-      }
-
-    }
+  if (d_mat.row_major())
+  {
+    if (result.row_major())
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_row, result_wrapper_row, d_mat.size2());
+    else
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_row, result_wrapper_col, d_mat.size2());
+  }
+  else
+  {
+    if (result.row_major())
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_col, result_wrapper_row, d_mat.size2());
+    else
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_col, result_wrapper_col, d_mat.size2());
   }
-
 }
 
 
@@ -1395,9 +1635,10 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
   vcl_size_t result_internal_size1  = viennacl::traits::internal_size1(result);
   vcl_size_t result_internal_size2  = viennacl::traits::internal_size2(result);
 
-  detail::matrix_array_wrapper<NumericT const, row_major, false>
+  // the wrappers for d_mat swap row and column indices, i.e. d_mat_wrapper(i, j) returns the entry (i, j) of trans(d_mat):
+  detail::matrix_array_wrapper<NumericT const, row_major, true>
       d_mat_wrapper_row(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
-  detail::matrix_array_wrapper<NumericT const, column_major, false>
+  detail::matrix_array_wrapper<NumericT const, column_major, true>
       d_mat_wrapper_col(d_mat_data, d_mat_start1, d_mat_start2, d_mat_inc1, d_mat_inc2, d_mat_internal_size1, d_mat_internal_size2);
 
   detail::matrix_array_wrapper<NumericT, row_major, false>
@@ -1405,85 +1646,34 @@ void prod_impl(const viennacl::coordinate_matrix<NumericT, AlignmentV> & sp_mat,
   detail::matrix_array_wrapper<NumericT, column_major, false>
       result_wrapper_col(result_data, result_start1, result_start2, result_inc1, result_inc2, result_internal_size1, result_internal_size2);
 
-  if ( d_mat.lhs().row_major() )
-  {
+  // filling result with zeros, as the products are accumulated:
 #ifdef VIENNACL_WITH_OPENMP
   #pragma omp parallel for
 #endif
-    for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
-    {
-      if (result.row_major())
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_row( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
-          result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-    #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      if (result.row_major())
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_row( col, c);
-          result_wrapper_row(r, col) += x * y;
-        }
-      }
-      else
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_row( col, c);
-          result_wrapper_col(r, col) += x * y;
-        }
-      }
-    }
-
+  for (long row = 0; row < static_cast<long>(sp_mat.size1()); ++row)
+  {
+    if (result.row_major())
+      for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
+        result_wrapper_row(row, col) = (NumericT)0;
+    else
+      for (vcl_size_t col = 0; col < d_mat.size2(); ++col)
+        result_wrapper_col(row, col) = (NumericT)0;
+  }
 
+  if (d_mat.lhs().row_major())
+  {
+    if (result.row_major())
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_row, result_wrapper_row, d_mat.size2());
+    else
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_row, result_wrapper_col, d_mat.size2());
   }
   else
   {
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long col = 0; col < static_cast<long>(d_mat.size2()); ++col)
-    {
-      if (result.row_major())
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_row( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-      else
-        for (vcl_size_t row = 0; row < sp_mat.size1(); ++row)
-          result_wrapper_col( row, col) = (NumericT)0; /* filling result with zeros, as the product loops are reordered */
-    }
-
-#ifdef VIENNACL_WITH_OPENMP
-  #pragma omp parallel for
-#endif
-    for (long i = 0; i < static_cast<long>(sp_mat.nnz()); ++i) {
-      NumericT x = static_cast<NumericT>(sp_mat_elements[i]);
-      vcl_size_t r = static_cast<vcl_size_t>(sp_mat_coords[2*i]);
-      vcl_size_t c = static_cast<vcl_size_t>(sp_mat_coords[2*i+1]);
-      if (result.row_major())
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_col( col, c);
-          result_wrapper_row(r, col) += x * y;
-        }
-      }
-      else
-      {
-        for (vcl_size_t col = 0; col < d_mat.size2(); ++col) {
-          NumericT y = d_mat_wrapper_col( col, c);
-          result_wrapper_col(r, col) += x * y;
-        }
-      }
-    }
+    if (result.row_major())
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_col, result_wrapper_row, d_mat.size2());
+    else
+      detail::coo_prod_dense_segmented(sp_mat_elements, sp_mat_coords, sp_mat.nnz(), d_mat_wrapper_col, result_wrapper_col, d_mat.size2());
   }
-
 }
 
 
@@ -2117,6 +2307,1033 @@ void prod_impl(const viennacl::hyb_matrix<NumericT, AlignmentV> & mat,
 }
 
 
+//
+// Block Compressed Matrix (BSR)
+//
+
+namespace detail
+{
+  /** @brief Kernels for the dense BlockSize x BlockSize blocks of a block_compressed_matrix, which are stored row-major.
+  *
+  * Since the block size is a compile time constant, all loops have fixed trip counts and are fully unrolled and vectorized by the compiler.
+  */
+  template<typename NumericT, unsigned int BlockSize>
+  struct bsr_block
+  {
+    /** @brief y += A * x */
+    static void prod_add(NumericT const * A, NumericT const * x, NumericT * y)
+    {
+      for (unsigned int i = 0; i < BlockSize; ++i)
+      {
+        NumericT sum = 0;
+        for (unsigned int j = 0; j < BlockSize; ++j)
+          sum += A[i * BlockSize + j] * x[j];
+        y[i] += sum;
+      }
+    }
+
+    /** @brief y -= A * x */
+    static void prod_sub(NumericT const * A, NumericT const * x, NumericT * y)
+    {
+      for (unsigned int i = 0; i < BlockSize; ++i)
+      {
+        NumericT sum = 0;
+        for (unsigned int j = 0; j < BlockSize; ++j)
+          sum += A[i * BlockSize + j] * x[j];
+        y[i] -= sum;
+      }
+    }
+
+    /** @brief y = A * x, where x and y must not overlap */
+    static void prod(NumericT const * A, NumericT const * x, NumericT * y)
+    {
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        y[i] = 0;
+      prod_add(A, x, y);
+    }
+
+    /** @brief C = A * B, where C must not overlap with A or B */
+    static void mat_prod(NumericT const * A, NumericT const * B, NumericT * C)
+    {
+      for (unsigned int i = 0; i < BlockSize; ++i)
+      {
+        for (unsigned int j = 0; j < BlockSize; ++j)
+          C[i * BlockSize + j] = 0;
+        for (unsigned int k = 0; k < BlockSize; ++k)
+          for (unsigned int j = 0; j < BlockSize; ++j)
+            C[i * BlockSize + j] += A[i * BlockSize + k] * B[k * BlockSize + j];
+      }
+    }
+
+    /** @brief C -= A * B, where C must not overlap with A or B */
+    static void mat_prod_sub(NumericT const * A, NumericT const * B, NumericT * C)
+    {
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        for (unsigned int k = 0; k < BlockSize; ++k)
+          for (unsigned int j = 0; j < BlockSize; ++j)
+            C[i * BlockSize + j] -= A[i * BlockSize + k] * B[k * BlockSize + j];
+    }
+
+    /** @brief Computes the inverse of A by Gauss-Jordan elimination with partial pivoting. Returns false if A is singular. */
+    static bool invert(NumericT const * A, NumericT * A_inv)
+    {
+      NumericT work[BlockSize * BlockSize];
+      for (unsigned int i = 0; i < BlockSize * BlockSize; ++i)
+      {
+        work[i]  = A[i];
+        A_inv[i] = 0;
+      }
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        A_inv[i * BlockSize + i] = 1;
+
+      for (unsigned int k = 0; k < BlockSize; ++k)
+      {
+        unsigned int pivot = k;
+        for (unsigned int i = k + 1; i < BlockSize; ++i)
+          if (std::fabs(work[i * BlockSize + k]) > std::fabs(work[pivot * BlockSize + k]))
+            pivot = i;
+        if (work[pivot * BlockSize + k] <= 0 && work[pivot * BlockSize + k] >= 0)
+          return false;
+
+        if (pivot != k)
+          for (unsigned int j = 0; j < BlockSize; ++j)
+          {
+            std::swap(work[k * BlockSize + j],  work[pivot * BlockSize + j]);
+            std::swap(A_inv[k * BlockSize + j], A_inv[pivot * BlockSize + j]);
+          }
+
+        NumericT inv_pivot = NumericT(1) / work[k * BlockSize + k];
+        for (unsigned int j = 0; j < BlockSize; ++j)
+        {
+          work[k * BlockSize + j]  *= inv_pivot;
+          A_inv[k * BlockSize + j] *= inv_pivot;
+        }
+
+        for (unsigned int i = 0; i < BlockSize; ++i)
+        {
+          NumericT factor = work[i * BlockSize + k];
+          if (i == k || (factor <= 0 && factor >= 0))
+            continue;
+          for (unsigned int j = 0; j < BlockSize; ++j)
+          {
+            work[i * BlockSize + j]  -= factor * work[k * BlockSize + j];
+            A_inv[i * BlockSize + j] -= factor * A_inv[k * BlockSize + j];
+          }
+        }
+      }
+      return true;
+    }
+  };
+
+  /** @brief Returns the number of nonzero BlockSize x BlockSize blocks of a CSR matrix. Used for detecting the natural block size of a matrix. */
+  inline vcl_size_t csr_count_blocks(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t rows, vcl_size_t cols, vcl_size_t block_size)
+  {
+    vcl_size_t block_cols = (cols + block_size - 1) / block_size;
+    std::vector<vcl_size_t> last_block_row(block_cols, rows); // rows is never a valid block row index
+    vcl_size_t num_blocks = 0;
+    for (vcl_size_t row = 0; row < rows; ++row)
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+      {
+        vcl_size_t block_col = col_buffer[i] / block_size;
+        if (last_block_row[block_col] != row / block_size)
+        {
+          last_block_row[block_col] = row / block_size;
+          ++num_blocks;
+        }
+      }
+    return num_blocks;
+  }
+
+  /** @brief Collects the sorted block column indices of the block row 'block_row' of a CSR matrix. For square matrices, the diagonal block is always included. */
+  template<unsigned int BlockSize>
+  void csr_block_row_pattern(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t rows, bool square,
+                             vcl_size_t block_row, std::vector<unsigned int> & pattern)
+  {
+    pattern.clear();
+    if (square)
+      pattern.push_back(static_cast<unsigned int>(block_row));
+    vcl_size_t row_end = std::min<vcl_size_t>((block_row + 1) * BlockSize, rows);
+    for (vcl_size_t row = block_row * BlockSize; row < row_end; ++row)
+      for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+        pattern.push_back(col_buffer[i] / BlockSize);
+    std::sort(pattern.begin(), pattern.end());
+    pattern.erase(std::unique(pattern.begin(), pattern.end()), pattern.end());
+  }
+
+  /** @brief Converts a CSR matrix to the block CSR format of block_compressed_matrix.
+  *
+  * Each block row holds all blocks containing at least one entry of the CSR matrix, zeros are stored explicitly within blocks.
+  * For square matrices, the diagonal blocks are always stored, and the diagonal of the padding beyond the last row is set to one, such that the diagonal blocks remain invertible.
+  */
+  template<typename NumericT, unsigned int BlockSize>
+  void csr_to_bsr(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements,
+                  vcl_size_t rows, vcl_size_t cols,
+                  std::vector<unsigned int> & block_row_buffer, std::vector<unsigned int> & block_col_buffer, std::vector<NumericT> & block_elements)
+  {
+    vcl_size_t block_rows = (rows + BlockSize - 1) / BlockSize;
+    bool square = (rows == cols);
+
+    // pass 1: number of blocks per block row
+    block_row_buffer.assign(block_rows + 1, 0);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector<unsigned int> pattern;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long block_row = 0; block_row < static_cast<long>(block_rows); ++block_row)
+      {
+        csr_block_row_pattern<BlockSize>(row_buffer, col_buffer, rows, square, vcl_size_t(block_row), pattern);
+        block_row_buffer[vcl_size_t(block_row) + 1] = static_cast<unsigned int>(pattern.size());
+      }
+    }
+    for (vcl_size_t i = 0; i < block_rows; ++i)
+      block_row_buffer[i+1] += block_row_buffer[i];
+
+    // pass 2: block column indices and values
+    vcl_size_t nnz_blocks = block_row_buffer[block_rows];
+    block_col_buffer.resize(nnz_blocks);
+    block_elements.resize(nnz_blocks * BlockSize * BlockSize);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel
+#endif
+    {
+      std::vector<unsigned int> pattern;
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp for
+#endif
+      for (long block_row = 0; block_row < static_cast<long>(block_rows); ++block_row)
+      {
+        csr_block_row_pattern<BlockSize>(row_buffer, col_buffer, rows, square, vcl_size_t(block_row), pattern);
+        vcl_size_t offset = block_row_buffer[vcl_size_t(block_row)];
+        std::copy(pattern.begin(), pattern.end(), block_col_buffer.begin() + static_cast<long>(offset));
+        std::fill(block_elements.begin() + static_cast<long>(offset * BlockSize * BlockSize),
+                  block_elements.begin() + static_cast<long>((offset + pattern.size()) * BlockSize * BlockSize), NumericT(0));
+
+        vcl_size_t row_begin = vcl_size_t(block_row) * BlockSize;
+        vcl_size_t row_end   = std::min<vcl_size_t>(row_begin + BlockSize, rows);
+        for (vcl_size_t row = row_begin; row < row_end; ++row)
+          for (vcl_size_t i = row_buffer[row]; i < row_buffer[row+1]; ++i)
+          {
+            unsigned int block_col = col_buffer[i] / BlockSize;
+            vcl_size_t block = offset + vcl_size_t(std::lower_bound(pattern.begin(), pattern.end(), block_col) - pattern.begin());
+            block_elements[block * BlockSize * BlockSize + (row - row_begin) * BlockSize + col_buffer[i] % BlockSize] = elements[i];
+          }
+
+        if (square && row_end - row_begin < BlockSize) // padding of the last diagonal block
+        {
+          vcl_size_t block = offset + vcl_size_t(std::lower_bound(pattern.begin(), pattern.end(), static_cast<unsigned int>(block_row)) - pattern.begin());
+          for (vcl_size_t i = row_end - row_begin; i < BlockSize; ++i)
+            block_elements[block * BlockSize * BlockSize + i * BlockSize + i] = NumericT(1);
+        }
+      }
+    }
+  }
+
+  /** @brief Loads the BlockSize entries of x starting at entry 'first'. Returns a pointer to x itself if the entries are contiguous, otherwise a copy in 'buffer' padded with zeros. */
+  template<typename NumericT, unsigned int BlockSize>
+  NumericT const * bsr_load_block(NumericT const * x, vcl_size_t x_start, vcl_size_t x_inc, vcl_size_t x_size,
+                                  vcl_size_t first, NumericT * buffer)
+  {
+    if (x_inc == 1 && first + BlockSize <= x_size)
+      return x + x_start + first;
+    for (vcl_size_t j = 0; j < BlockSize; ++j)
+      buffer[j] = (first + j < x_size) ? x[(first + j) * x_inc + x_start] : NumericT(0);
+    return buffer;
+  }
+
+  /** @brief Computes y = alpha * A * x + beta * y for a block_compressed_matrix A. Each thread processes whole block rows, hence no synchronization is required. */
+  template<typename NumericT, unsigned int BlockSize>
+  void bsr_prod(unsigned int const * block_row_buffer, unsigned int const * block_col_buffer, NumericT const * elements,
+                vcl_size_t rows, vcl_size_t cols,
+                NumericT const * x, vcl_size_t x_start, vcl_size_t x_inc,
+                NumericT alpha,
+                NumericT * y, vcl_size_t y_start, vcl_size_t y_inc,
+                NumericT beta)
+  {
+    vcl_size_t block_rows = (rows + BlockSize - 1) / BlockSize;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long block_row = 0; block_row < static_cast<long>(block_rows); ++block_row)
+    {
+      NumericT y_block[BlockSize];
+      NumericT x_buffer[BlockSize];
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        y_block[i] = 0;
+
+      vcl_size_t block_end = block_row_buffer[block_row + 1];
+      for (vcl_size_t k = block_row_buffer[block_row]; k < block_end; ++k)
+      {
+        NumericT const * x_block = bsr_load_block<NumericT, BlockSize>(x, x_start, x_inc, cols, vcl_size_t(block_col_buffer[k]) * BlockSize, x_buffer);
+        bsr_block<NumericT, BlockSize>::prod_add(elements + k * BlockSize * BlockSize, x_block, y_block);
+      }
+
+      vcl_size_t row_begin = vcl_size_t(block_row) * BlockSize;
+      vcl_size_t row_end   = std::min<vcl_size_t>(row_begin + BlockSize, rows);
+      for (vcl_size_t row = row_begin; row < row_end; ++row)
+      {
+        vcl_size_t index = row * y_inc + y_start;
+        if (beta < 0 || beta > 0)
+          y[index] = alpha * y_block[row - row_begin] + beta * y[index];
+        else
+          y[index] = alpha * y_block[row - row_begin];
+      }
+    }
+  }
+
+  /** @brief Computes C = A * B for a block_compressed_matrix A and dense matrices B and C accessed through matrix_array_wrapper objects (hence also covering transposed matrices B). */
+  template<typename NumericT, unsigned int BlockSize, typename DenseWrapperT, typename ResultWrapperT>
+  void bsr_prod_dense(unsigned int const * block_row_buffer, unsigned int const * block_col_buffer, NumericT const * elements,
+                      vcl_size_t rows, vcl_size_t cols,
+                      DenseWrapperT B, ResultWrapperT C, vcl_size_t num_cols)
+  {
+    vcl_size_t block_rows = (rows + BlockSize - 1) / BlockSize;
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long block_row = 0; block_row < static_cast<long>(block_rows); ++block_row)
+    {
+      vcl_size_t row_begin = vcl_size_t(block_row) * BlockSize;
+      vcl_size_t row_end   = std::min<vcl_size_t>(row_begin + BlockSize, rows);
+      vcl_size_t block_end = block_row_buffer[block_row + 1];
+
+      for (vcl_size_t col = 0; col < num_cols; ++col)
+      {
+        NumericT y_block[BlockSize];
+        NumericT x_block[BlockSize];
+        for (unsigned int i = 0; i < BlockSize; ++i)
+          y_block[i] = 0;
+
+        for (vcl_size_t k = block_row_buffer[block_row]; k < block_end; ++k)
+        {
+          vcl_size_t first = vcl_size_t(block_col_buffer[k]) * BlockSize;
+          for (vcl_size_t j = 0; j < BlockSize; ++j)
+            x_block[j] = (first + j < cols) ? B(first + j, col) : NumericT(0);
+          bsr_block<NumericT, BlockSize>::prod_add(elements + k * BlockSize * BlockSize, x_block, y_block);
+        }
+
+        for (vcl_size_t row = row_begin; row < row_end; ++row)
+          C(row, col) = y_block[row - row_begin];
+      }
+    }
+  }
+
+  /** @brief Computes the inverses of the diagonal blocks of a square block_compressed_matrix, stored consecutively in 'inverses'. Returns false if a diagonal block is singular. */
+  template<typename NumericT, unsigned int BlockSize>
+  bool bsr_invert_diagonal_blocks(unsigned int const * block_row_buffer, unsigned int const * block_col_buffer, NumericT const * elements,
+                                  vcl_size_t block_rows, NumericT * inverses)
+  {
+    bool success = true;
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for reduction(&&: success)
+#endif
+    for (long block_row = 0; block_row < static_cast<long>(block_rows); ++block_row)
+    {
+      unsigned int const * diag = std::lower_bound(block_col_buffer + block_row_buffer[block_row], block_col_buffer + block_row_buffer[block_row + 1], static_cast<unsigned int>(block_row));
+      if (diag == block_col_buffer + block_row_buffer[block_row + 1] || *diag != static_cast<unsigned int>(block_row))
+        success = false;
+      else if (!bsr_block<NumericT, BlockSize>::invert(elements + vcl_size_t(diag - block_col_buffer) * BlockSize * BlockSize, inverses + vcl_size_t(block_row) * BlockSize * BlockSize))
+        success = false;
+    }
+    return success;
+  }
+
+  /** @brief Solves LU x = b in place for the block ILU factorization of a block_compressed_matrix computed by viennacl::linalg::precondition().
+  *
+  * L has unit diagonal blocks, the diagonal blocks of the factorization hold the inverses of the diagonal blocks of U. The vector x is padded to a multiple of BlockSize.
+  */
+  template<typename NumericT, unsigned int BlockSize>
+  void bsr_inplace_solve_lu(unsigned int const * block_row_buffer, unsigned int const * block_col_buffer, NumericT const * elements,
+                            vcl_size_t block_rows, NumericT * x)
+  {
+    // forward substitution with the unit lower triangular factor:
+    for (vcl_size_t block_row = 0; block_row < block_rows; ++block_row)
+      for (vcl_size_t k = block_row_buffer[block_row]; k < block_row_buffer[block_row + 1] && block_col_buffer[k] < block_row; ++k)
+        bsr_block<NumericT, BlockSize>::prod_sub(elements + k * BlockSize * BlockSize, x + vcl_size_t(block_col_buffer[k]) * BlockSize, x + block_row * BlockSize);
+
+    // backward substitution with the upper triangular factor:
+    for (vcl_size_t block_row = block_rows; block_row-- > 0; )
+    {
+      NumericT y_block[BlockSize];
+      vcl_size_t diag = block_row_buffer[block_row];
+      for (vcl_size_t k = block_row_buffer[block_row]; k < block_row_buffer[block_row + 1]; ++k)
+      {
+        if (block_col_buffer[k] > block_row)
+          bsr_block<NumericT, BlockSize>::prod_sub(elements + k * BlockSize * BlockSize, x + vcl_size_t(block_col_buffer[k]) * BlockSize, x + block_row * BlockSize);
+        else if (block_col_buffer[k] == block_row)
+          diag = k;
+      }
+      bsr_block<NumericT, BlockSize>::prod(elements + diag * BlockSize * BlockSize, x + block_row * BlockSize, y_block);
+      for (unsigned int i = 0; i < BlockSize; ++i)
+        x[block_row * BlockSize + i] = y_block[i];
+    }
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a block_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param alpha  Scaling factor for the product
+* @param result The result vector
+* @param beta   Scaling factor for the previous content of the result vector
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+               NumericT alpha,
+                     viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  detail::bsr_prod<NumericT, BlockSize>(detail::extract_raw_pointer<unsigned int>(mat.handle1()),
+                                        detail::extract_raw_pointer<unsigned int>(mat.handle2()),
+                                        detail::extract_raw_pointer<NumericT>(mat.handle()),
+                                        mat.size1(), mat.size2(),
+                                        detail::extract_raw_pointer<NumericT>(vec.handle()), vec.start(), vec.stride(),
+                                        alpha,
+                                        detail::extract_raw_pointer<NumericT>(result.handle()), result.start(), result.stride(),
+                                        beta);
+}
+
+/** @brief Carries out matrix-matrix multiplication of a block_compressed_matrix with a dense matrix
+*
+* Implementation of the convenience expression result = prod(sp_mat, d_mat);
+*
+* @param sp_mat     The sparse matrix
+* @param d_mat      The dense matrix
+* @param result     The result matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_base<NumericT> & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  unsigned int const * block_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
+  unsigned int const * block_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+  NumericT     const * elements         = detail::extract_raw_pointer<NumericT>(sp_mat.handle());
+
+  NumericT const * d_mat_data  = detail::extract_raw_pointer<NumericT>(d_mat);
+  NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+  detail::matrix_array_wrapper<NumericT const, row_major, false>
+      d_mat_wrapper_row(d_mat_data, viennacl::traits::start1(d_mat), viennacl::traits::start2(d_mat), viennacl::traits::stride1(d_mat), viennacl::traits::stride2(d_mat), viennacl::traits::internal_size1(d_mat), viennacl::traits::internal_size2(d_mat));
+  detail::matrix_array_wrapper<NumericT const, column_major, false>
+      d_mat_wrapper_col(d_mat_data, viennacl::traits::start1(d_mat), viennacl::traits::start2(d_mat), viennacl::traits::stride1(d_mat), viennacl::traits::stride2(d_mat), viennacl::traits::internal_size1(d_mat), viennacl::traits::internal_size2(d_mat));
+
+  detail::matrix_array_wrapper<NumericT, row_major, false>
+      result_wrapper_row(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+  detail::matrix_array_wrapper<NumericT, column_major, false>
+      result_wrapper_col(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+
+  if (d_mat.row_major())
+  {
+    if (result.row_major())
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_row, result_wrapper_row, d_mat.size2());
+    else
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_row, result_wrapper_col, d_mat.size2());
+  }
+  else
+  {
+    if (result.row_major())
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_col, result_wrapper_row, d_mat.size2());
+    else
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_col, result_wrapper_col, d_mat.size2());
+  }
+}
+
+/** @brief Carries out matrix-matrix multiplication of a block_compressed_matrix with a transposed dense matrix
+*
+* Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+*
+* @param sp_mat     The sparse matrix
+* @param d_mat      The transposed dense matrix
+* @param result     The result matrix
+*/
+template<typename NumericT, unsigned int BlockSize>
+void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & sp_mat,
+               const viennacl::matrix_expression< const viennacl::matrix_base<NumericT>,
+                                                  const viennacl::matrix_base<NumericT>,
+                                                  viennacl::op_trans > & d_mat,
+                     viennacl::matrix_base<NumericT> & result)
+{
+  unsigned int const * block_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
+  unsigned int const * block_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
+  NumericT     const * elements         = detail::extract_raw_pointer<NumericT>(sp_mat.handle());
+
+  viennacl::matrix_base<NumericT> const & B = d_mat.lhs();
+  NumericT const * d_mat_data  = detail::extract_raw_pointer<NumericT>(B);
+  NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
+
+  // the wrappers for d_mat swap row and column indices, i.e. d_mat_wrapper(i, j) returns the entry (i, j) of trans(d_mat):
+  detail::matrix_array_wrapper<NumericT const, row_major, true>
+      d_mat_wrapper_row(d_mat_data, viennacl::traits::start1(B), viennacl::traits::start2(B), viennacl::traits::stride1(B), viennacl::traits::stride2(B), viennacl::traits::internal_size1(B), viennacl::traits::internal_size2(B));
+  detail::matrix_array_wrapper<NumericT const, column_major, true>
+      d_mat_wrapper_col(d_mat_data, viennacl::traits::start1(B), viennacl::traits::start2(B), viennacl::traits::stride1(B), viennacl::traits::stride2(B), viennacl::traits::internal_size1(B), viennacl::traits::internal_size2(B));
+
+  detail::matrix_array_wrapper<NumericT, row_major, false>
+      result_wrapper_row(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+  detail::matrix_array_wrapper<NumericT, column_major, false>
+      result_wrapper_col(result_data, viennacl::traits::start1(result), viennacl::traits::start2(result), viennacl::traits::stride1(result), viennacl::traits::stride2(result), viennacl::traits::internal_size1(result), viennacl::traits::internal_size2(result));
+
+  if (B.row_major())
+  {
+    if (result.row_major())
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_row, result_wrapper_row, d_mat.size2());
+    else
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_row, result_wrapper_col, d_mat.size2());
+  }
+  else
+  {
+    if (result.row_major())
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_col, result_wrapper_row, d_mat.size2());
+    else
+      detail::bsr_prod_dense<NumericT, BlockSize>(block_row_buffer, block_col_buffer, elements, sp_mat.size1(), sp_mat.size2(), d_mat_wrapper_col, result_wrapper_col, d_mat.size2());
+  }
+}
+
+
+//
+// Index Compressed Matrix
+//
+
+/** @brief Maximum number of nonzeros in a row block of an index_compressed_matrix, matching the row blocks of compressed_matrix. A single longer row forms a block on its own. */
+#ifndef VIENNACL_INDEX_COMPRESSION_BLOCK_SIZE
+  #define VIENNACL_INDEX_COMPRESSION_BLOCK_SIZE 1024
+#endif
+
+namespace detail
+{
+  /** @brief Partitions the rows of a CSR matrix into the row blocks of an index_compressed_matrix and encodes the column indices.
+  *
+  * A block holds consecutive rows with at most VIENNACL_INDEX_COMPRESSION_BLOCK_SIZE nonzeros.
+  * Additionally, the column indices of a compressed block must not span more than the range of OffsetT, so that they are stored as offsets to the smallest column index of the block.
+  * Consecutive rows which exceed this range on their own are gathered in fallback blocks, which keep their 32-bit column indices.
+  *
+  * @param row_buffer        Row offsets of the CSR matrix
+  * @param col_buffer        Column indices of the CSR matrix
+  * @param rows              Number of rows
+  * @param row_blocks        Output: First row of each block, plus the number of rows
+  * @param block_base        Output: Smallest column index of each compressed block (zero for fallback blocks)
+  * @param block_offset_ptr  Output: Number of compressed entries before each block, plus the total number of compressed entries
+  * @param col_offsets       Output: Column offsets of the entries in compressed blocks
+  * @param fallback_cols     Output: Column indices of the entries in fallback blocks
+  */
+  template<typename OffsetT>
+  void csr_compress_indices(unsigned int const * row_buffer, unsigned int const * col_buffer, vcl_size_t rows,
+                            std::vector<unsigned int> & row_blocks, std::vector<unsigned int> & block_base, std::vector<unsigned int> & block_offset_ptr,
+                            std::vector<OffsetT> & col_offsets, std::vector<unsigned int> & fallback_cols)
+  {
+    unsigned int const max_span = static_cast<unsigned int>(std::numeric_limits<OffsetT>::max());
+
+    // range of column indices in each row (empty rows have row_min > row_max):
+    std::vector<unsigned int> row_min(rows), row_max(rows);
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (rows > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long row = 0; row < static_cast<long>(rows); ++row)
+    {
+      unsigned int lo = std::numeric_limits<unsigned int>::max();
+      unsigned int hi = 0;
+      for (unsigned int k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+      {
+        lo = std::min(lo, col_buffer[k]);
+        hi = std::max(hi, col_buffer[k]);
+      }
+      row_min[static_cast<vcl_size_t>(row)] = lo;
+      row_max[static_cast<vcl_size_t>(row)] = hi;
+    }
+
+    // greedy partitioning into blocks:
+    row_blocks.assign(1, 0);
+    block_base.clear();
+    block_offset_ptr.assign(1, 0);
+    vcl_size_t row = 0;
+    while (row < rows)
+    {
+      vcl_size_t block_begin = row;
+      unsigned int lo = row_min[row];
+      unsigned int hi = row_max[row];
+      bool compressed = (lo > hi) || (hi - lo <= max_span);
+      for (++row; row < rows && row_buffer[row + 1] - row_buffer[block_begin] <= VIENNACL_INDEX_COMPRESSION_BLOCK_SIZE; ++row)
+      {
+        if (row_min[row] > row_max[row]) // empty rows fit into any block
+          continue;
+        if (compressed)
+        {
+          unsigned int new_lo = std::min(lo, row_min[row]);
+          unsigned int new_hi = std::max(hi, row_max[row]);
+          if (new_hi - new_lo > max_span)
+            break;
+          lo = new_lo;
+          hi = new_hi;
+        }
+        else if (row_max[row] - row_min[row] <= max_span) // row can be compressed, start a new block
+          break;
+      }
+
+      vcl_size_t block_nnz = row_buffer[row] - row_buffer[block_begin];
+      row_blocks.push_back(static_cast<unsigned int>(row));
+      block_base.push_back((compressed && lo <= hi) ? lo : 0);
+      block_offset_ptr.push_back(block_offset_ptr.back() + (compressed ? static_cast<unsigned int>(block_nnz) : 0));
+    }
+
+    // encode the column indices:
+    vcl_size_t num_blocks = block_base.size();
+    vcl_size_t nnz = row_buffer[rows];
+    col_offsets.resize(std::max<vcl_size_t>(block_offset_ptr.back(), 1));
+    fallback_cols.resize(std::max<vcl_size_t>(nnz - block_offset_ptr.back(), 1));
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (nnz > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      unsigned int k_begin = row_buffer[row_blocks[block]];
+      unsigned int k_end   = row_buffer[row_blocks[block + 1]];
+      if (block_offset_ptr[block + 1] - block_offset_ptr[block] == k_end - k_begin)
+      {
+        OffsetT * offsets = &(col_offsets[0]) + block_offset_ptr[block];
+        for (unsigned int k = k_begin; k < k_end; ++k)
+          offsets[k - k_begin] = static_cast<OffsetT>(col_buffer[k] - block_base[block]);
+      }
+      else // fallback entries preceding this block: k_begin - block_offset_ptr[block]
+        for (unsigned int k = k_begin; k < k_end; ++k)
+          fallback_cols[k - block_offset_ptr[block]] = col_buffer[k];
+    }
+
+    if (block_base.empty())
+      block_base.push_back(0); // guard against empty buffers
+  }
+
+  /** @brief Computes y = alpha * A * x + beta * y for an index_compressed_matrix A. Each thread processes whole row blocks.
+  *
+  * Within a compressed block the column indices are decoded as base + offset on the fly.
+  * The inner loop is a plain gather with narrow indices, which compilers vectorize for the usual SIMD instruction sets.
+  */
+  template<typename NumericT, typename OffsetT>
+  void icsr_prod(unsigned int const * row_buffer, unsigned int const * row_blocks, unsigned int const * block_base, unsigned int const * block_offset_ptr,
+                 OffsetT const * col_offsets, unsigned int const * fallback_cols, NumericT const * elements, vcl_size_t num_blocks,
+                 NumericT const * x, vcl_size_t x_start, vcl_size_t x_inc,
+                 NumericT alpha,
+                 NumericT * y, vcl_size_t y_start, vcl_size_t y_inc,
+                 NumericT beta)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long block = 0; block < static_cast<long>(num_blocks); ++block)
+    {
+      unsigned int row_begin = row_blocks[block];
+      unsigned int row_end   = row_blocks[block + 1];
+      unsigned int k_begin   = row_buffer[row_begin];
+      bool compressed = (block_offset_ptr[block + 1] - block_offset_ptr[block] == row_buffer[row_end] - k_begin);
+
+      NumericT const * x_base = x + x_start + vcl_size_t(block_base[block]) * x_inc;
+
+      for (unsigned int row = row_begin; row < row_end; ++row)
+      {
+        NumericT sum = 0;
+        unsigned int row_nnz = row_buffer[row + 1] - row_buffer[row];
+        NumericT const * row_elements = elements + row_buffer[row];
+        if (compressed)
+        {
+          OffsetT const * row_offsets = col_offsets + block_offset_ptr[block] + (row_buffer[row] - k_begin);
+          if (x_inc == 1)
+            for (unsigned int j = 0; j < row_nnz; ++j)
+              sum += row_elements[j] * x_base[row_offsets[j]];
+          else
+            for (unsigned int j = 0; j < row_nnz; ++j)
+              sum += row_elements[j] * x_base[vcl_size_t(row_offsets[j]) * x_inc];
+        }
+        else
+        {
+          unsigned int const * row_cols = fallback_cols + (row_buffer[row] - block_offset_ptr[block]);
+          for (unsigned int j = 0; j < row_nnz; ++j)
+            sum += row_elements[j] * x[vcl_size_t(row_cols[j]) * x_inc + x_start];
+        }
+
+        vcl_size_t index = vcl_size_t(row) * y_inc + y_start;
+        if (beta < 0 || beta > 0)
+          y[index] = alpha * sum + beta * y[index];
+        else
+          y[index] = alpha * sum;
+      }
+    }
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with an index_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param alpha  Scaling factor for the product
+* @param result The result vector
+* @param beta   Scaling factor for the previous content of the result vector
+*/
+template<typename NumericT, typename OffsetT>
+void prod_impl(const viennacl::index_compressed_matrix<NumericT, OffsetT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+               NumericT alpha,
+                     viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  detail::icsr_prod<NumericT, OffsetT>(detail::extract_raw_pointer<unsigned int>(mat.handle1()),
+                                       detail::extract_raw_pointer<unsigned int>(mat.handle3()),
+                                       detail::extract_raw_pointer<unsigned int>(mat.handle4()),
+                                       detail::extract_raw_pointer<unsigned int>(mat.handle5()),
+                                       detail::extract_raw_pointer<OffsetT>(mat.handle2()),
+                                       detail::extract_raw_pointer<unsigned int>(mat.handle6()),
+                                       detail::extract_raw_pointer<NumericT>(mat.handle()),
+                                       mat.num_blocks(),
+                                       detail::extract_raw_pointer<NumericT>(vec.handle()), vec.start(), vec.stride(),
+                                       alpha,
+                                       detail::extract_raw_pointer<NumericT>(result.handle()), result.start(), result.stride(),
+                                       beta);
+}
+
+
+//
+// Mixed Precision Compressed Matrix
+//
+
+namespace detail
+{
+  /** @brief Rounds the values of a sparse matrix to the storage type of a mixed_precision_compressed_matrix */
+  template<typename NumericT, typename StorageT>
+  void round_to_storage(NumericT const * elements, StorageT * narrow_elements, vcl_size_t size)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for if (size > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+    for (long i = 0; i < static_cast<long>(size); ++i)
+      narrow_elements[i] = static_cast<StorageT>(elements[i]);
+  }
+
+  /** @brief Computes y = alpha * A * x + beta * y for a CSR matrix A with values of type StorageT. The values are converted to NumericT before the multiplication, so that the accumulation is in full precision. */
+  template<typename NumericT, typename StorageT>
+  void mixed_precision_csr_prod(unsigned int const * row_buffer, unsigned int const * col_buffer, StorageT const * elements, vcl_size_t rows,
+                                NumericT const * x, vcl_size_t x_start, vcl_size_t x_inc,
+                                NumericT alpha,
+                                NumericT * y, vcl_size_t y_start, vcl_size_t y_inc,
+                                NumericT beta)
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long row = 0; row < static_cast<long>(rows); ++row)
+    {
+      NumericT sum = 0;
+      unsigned int row_end = row_buffer[row + 1];
+      if (x_inc == 1)
+        for (unsigned int k = row_buffer[row]; k < row_end; ++k)
+          sum += static_cast<NumericT>(elements[k]) * x[col_buffer[k] + x_start];
+      else
+        for (unsigned int k = row_buffer[row]; k < row_end; ++k)
+          sum += static_cast<NumericT>(elements[k]) * x[vcl_size_t(col_buffer[k]) * x_inc + x_start];
+
+      vcl_size_t index = static_cast<vcl_size_t>(row) * y_inc + y_start;
+      if (beta < 0 || beta > 0)
+        y[index] = alpha * sum + beta * y[index];
+      else
+        y[index] = alpha * sum;
+    }
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a mixed_precision_compressed_matrix
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+*
+* @param mat    The matrix
+* @param vec    The vector
+* @param alpha  Scaling factor for the product
+* @param result The result vector
+* @param beta   Scaling factor for the previous content of the result vector
+*/
+template<typename NumericT, typename StorageT>
+void prod_impl(const viennacl::mixed_precision_compressed_matrix<NumericT, StorageT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+               NumericT alpha,
+                     viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  detail::mixed_precision_csr_prod<NumericT, StorageT>(detail::extract_raw_pointer<unsigned int>(mat.handle1()),
+                                                       detail::extract_raw_pointer<unsigned int>(mat.handle2()),
+                                                       detail::extract_raw_pointer<StorageT>(mat.handle()),
+                                                       mat.size1(),
+                                                       detail::extract_raw_pointer<NumericT>(vec.handle()), vec.start(), vec.stride(),
+                                                       alpha,
+                                                       detail::extract_raw_pointer<NumericT>(result.handle()), result.start(), result.stride(),
+                                                       beta);
+}
+
+
+
+//
+// Stencil Operator
+//
+
+/** @brief Number of grid points of a plane which are kept in cache by the products with a stencil_operator, i.e. the planes are tiled in y-direction such that a tile holds at most this number of grid points (at least one grid line). */
+#ifndef VIENNACL_STENCIL_TILE_SIZE
+  #define VIENNACL_STENCIL_TILE_SIZE 4096
+#endif
+
+/** @brief Number of consecutive z-planes processed for one tile by the products with a stencil_operator. Smaller values yield more work items for threads, larger values reload fewer planes at the tile boundaries. */
+#ifndef VIENNACL_STENCIL_TILE_PLANES
+  #define VIENNACL_STENCIL_TILE_PLANES 16
+#endif
+
+namespace detail
+{
+  /** @brief Computes the product of a stencil_operator with x for the grid line 'line' (index j + ny * k), i.e. the grid points (0..nx-1, j, k), and writes it to 'result'.
+  *
+  * Stencil points with the same y- and z-offset are consecutive and are applied in a single pass over the line, such that the inner loops have unit stride and vectorize.
+  */
+  template<typename NumericT>
+  void stencil_line(viennacl::stencil_operator<NumericT> const & A, NumericT const * coefficients,
+                    NumericT const * x, vcl_size_t line, NumericT * result)
+  {
+    long nx = static_cast<long>(A.size_x());
+    long ny = static_cast<long>(A.size_y());
+    long nz = static_cast<long>(A.size_z());
+    long j  = static_cast<long>(line) % ny;
+    long k  = static_cast<long>(line) / ny;
+    vcl_size_t line_start = line * A.size_x();
+
+    for (long i = 0; i < nx; ++i)
+      result[i] = 0;
+
+    vcl_size_t num_points = A.num_points();
+    for (vcl_size_t s = 0; s < num_points; )
+    {
+      // group of stencil points with the same y- and z-offset:
+      vcl_size_t s_end = s + 1;
+      while (s_end < num_points && A.offset(s_end, 1) == A.offset(s, 1) && A.offset(s_end, 2) == A.offset(s, 2))
+        ++s_end;
+
+      long jj = j + A.offset(s, 1);
+      long kk = k + A.offset(s, 2);
+      if (jj < 0 || jj >= ny || kk < 0 || kk >= nz)
+      {
+        s = s_end;
+        continue;
+      }
+      NumericT const * x_line = x + (kk * ny + jj) * nx;
+
+      if (s_end - s == 3 && nx > 1) // offsets -1, 0, 1 in x-direction
+      {
+        if (A.variable_coefficients())
+        {
+          NumericT const * c0 = coefficients +  s      * A.size1() + line_start;
+          NumericT const * c1 = coefficients + (s + 1) * A.size1() + line_start;
+          NumericT const * c2 = coefficients + (s + 2) * A.size1() + line_start;
+          result[0] += c1[0] * x_line[0] + c2[0] * x_line[1];
+          for (long i = 1; i < nx - 1; ++i)
+            result[i] += c0[i] * x_line[i - 1] + c1[i] * x_line[i] + c2[i] * x_line[i + 1];
+          result[nx - 1] += c0[nx - 1] * x_line[nx - 2] + c1[nx - 1] * x_line[nx - 1];
+        }
+        else
+        {
+          NumericT c0 = coefficients[s], c1 = coefficients[s + 1], c2 = coefficients[s + 2];
+          result[0] += c1 * x_line[0] + c2 * x_line[1];
+          for (long i = 1; i < nx - 1; ++i)
+            result[i] += c0 * x_line[i - 1] + c1 * x_line[i] + c2 * x_line[i + 1];
+          result[nx - 1] += c0 * x_line[nx - 2] + c1 * x_line[nx - 1];
+        }
+      }
+      else
+      {
+        for (vcl_size_t p = s; p < s_end; ++p)
+        {
+          long di = A.offset(p, 0);
+          long lo = (di < 0) ? -di : 0;
+          long hi = (di > 0) ? nx - di : nx;
+          NumericT const * x_p = x_line + lo + di;
+          NumericT       * r_p = result + lo;
+          if (A.variable_coefficients())
+          {
+            NumericT const * c_p = coefficients + p * A.size1() + line_start + static_cast<vcl_size_t>(lo);
+            for (long i = 0; i < hi - lo; ++i)
+              r_p[i] += c_p[i] * x_p[i];
+          }
+          else
+          {
+            NumericT c_p = coefficients[p];
+            for (long i = 0; i < hi - lo; ++i)
+              r_p[i] += c_p * x_p[i];
+          }
+        }
+      }
+      s = s_end;
+    }
+  }
+}
+
+/** @brief Carries out matrix-vector multiplication with a stencil_operator
+*
+* Implementation of the convenience expression result = prod(mat, vec);
+* Each plane is split into tiles of at most VIENNACL_STENCIL_TILE_SIZE grid points, which are processed for VIENNACL_STENCIL_TILE_PLANES consecutive planes.
+* Thus, the three planes of a tile needed for the current plane remain in cache and each entry of vec is loaded from memory only once.
+*
+* @param mat    The stencil operator
+* @param vec    The vector
+* @param alpha  Scaling factor for the product
+* @param result The result vector
+* @param beta   Scaling factor for the previous content of the result vector
+*/
+template<typename NumericT>
+void prod_impl(const viennacl::stencil_operator<NumericT> & mat,
+               const viennacl::vector_base<NumericT> & vec,
+               NumericT alpha,
+                     viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  if (vec.stride() != 1)
+  {
+    viennacl::vector<NumericT> temp(vec);
+    prod_impl(mat, temp, alpha, result, beta);
+    return;
+  }
+
+  NumericT const * coefficients = detail::extract_raw_pointer<NumericT>(mat.handle());
+  NumericT const * x            = detail::extract_raw_pointer<NumericT>(vec.handle()) + vec.start();
+  NumericT       * y            = detail::extract_raw_pointer<NumericT>(result.handle());
+  vcl_size_t y_start = result.start();
+  vcl_size_t y_inc   = result.stride();
+
+  long nx = static_cast<long>(mat.size_x());
+  long ny = static_cast<long>(mat.size_y());
+  long nz = static_cast<long>(mat.size_z());
+  long tile_lines = std::max<long>(1, VIENNACL_STENCIL_TILE_SIZE / std::max<long>(nx, 1));
+  long tiles      = (ny + tile_lines - 1) / tile_lines;
+  long chunks     = (nz + VIENNACL_STENCIL_TILE_PLANES - 1) / VIENNACL_STENCIL_TILE_PLANES;
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (mat.size1() > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+  {
+    std::vector<NumericT> line_buffer(static_cast<vcl_size_t>(std::max<long>(nx, 1)));
+    NumericT * line_result = &(line_buffer[0]);
+
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp for schedule(static)
+#endif
+    for (long item = 0; item < tiles * chunks; ++item)
+    {
+      long j_begin = (item % tiles) * tile_lines;
+      long j_end   = std::min(j_begin + tile_lines, ny);
+      long k_begin = (item / tiles) * VIENNACL_STENCIL_TILE_PLANES;
+      long k_end   = std::min<long>(k_begin + VIENNACL_STENCIL_TILE_PLANES, nz);
+
+      for (long k = k_begin; k < k_end; ++k)
+        for (long j = j_begin; j < j_end; ++j)
+        {
+          vcl_size_t line = static_cast<vcl_size_t>(k * ny + j);
+          detail::stencil_line(mat, coefficients, x, line, line_result);
+
+          NumericT * y_line = y + line * mat.size_x() * y_inc + y_start;
+          if (beta < 0 || beta > 0)
+            for (long i = 0; i < nx; ++i)
+              y_line[i * long(y_inc)] = alpha * line_result[i] + beta * y_line[i * long(y_inc)];
+          else
+            for (long i = 0; i < nx; ++i)
+              y_line[i * long(y_inc)] = alpha * line_result[i];
+        }
+    }
+  }
+}
+
+/** @brief Runs damped Jacobi iterations x <- x + weight * D^{-1} (rhs - A x) for a stencil_operator A with diagonal D. The iterations are temporally blocked.
+*
+* The grid is split into bands of grid lines: a z-plane for 3D grids, or VIENNACL_STENCIL_TILE_SIZE / nx grid lines for 2D grids.
+* Since an iteration on a band only depends on the previous iteration on the neighboring bands, all iterations are carried out in a single sweep over the bands in the manner of a wavefront:
+* After the first iteration on band b, the second iteration is carried out on band b-1, the third on band b-2, and so on.
+* Hence, each entry of x, rhs, and x_backup is loaded from memory once (instead of once per iteration) as long as about 2 * (iterations + 2) bands fit into cache.
+* The wavefront only needs x and x_backup as storage, because a band of the previous iteration is always consumed before it is overwritten.
+*
+* @param iterations  Number of Jacobi iterations
+* @param A           The stencil operator
+* @param x           The vector to be smoothed, updated in place
+* @param x_backup    Vector of the same size as x used as additional storage
+* @param rhs         The right hand side
+* @param weight      Damping factor. 1: Undamped Jacobi iteration
+*/
+template<typename NumericT>
+void smooth_jacobi(unsigned int iterations,
+                   viennacl::stencil_operator<NumericT> const & A,
+                   viennacl::vector_base<NumericT> & x,
+                   viennacl::vector_base<NumericT> & x_backup,
+                   viennacl::vector_base<NumericT> const & rhs,
+                   NumericT weight)
+{
+  if (iterations == 0)
+    return;
+
+  NumericT const * coefficients = detail::extract_raw_pointer<NumericT>(A.handle());
+  NumericT       * buffers[2]   = { detail::extract_raw_pointer<NumericT>(x.handle()) + x.start(),
+                                    detail::extract_raw_pointer<NumericT>(x_backup.handle()) + x_backup.start() };
+  NumericT const * b            = detail::extract_raw_pointer<NumericT>(rhs.handle()) + rhs.start();
+
+  long nx = static_cast<long>(A.size_x());
+  long lines      = static_cast<long>(A.size_y() * A.size_z());
+  long band_lines = (A.size_z() > 1) ? static_cast<long>(A.size_y()) : std::max<long>(1, VIENNACL_STENCIL_TILE_SIZE / std::max<long>(nx, 1));
+  long bands      = (lines + band_lines - 1) / band_lines;
+  long steps      = bands + long(iterations) - 1;
+
+  vcl_size_t center = A.point_index(0, 0, 0);
+  NumericT const * diag = coefficients + (A.variable_coefficients() ? center * A.size1() : center);
+  NumericT weight_over_diag = weight / diag[0];
+
+#ifdef VIENNACL_WITH_OPENMP
+  #pragma omp parallel if (A.size1() > VIENNACL_OPENMP_VECTOR_MIN_SIZE) num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+#endif
+  {
+    std::vector<NumericT> line_buffer(static_cast<vcl_size_t>(std::max<long>(nx, 1)));
+    NumericT * line_result = &(line_buffer[0]);
+
+    for (long step = 0; step < steps; ++step)
+      for (long t = 0; t < long(iterations); ++t)
+      {
+        long band = step - t;
+        if (band < 0 || band >= bands)
+          continue;
+
+        NumericT const * x_old = buffers[t % 2];
+        NumericT       * x_new = buffers[(t + 1) % 2];
+        long line_begin = band * band_lines;
+        long line_end   = std::min(line_begin + band_lines, lines);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (long line = line_begin; line < line_end; ++line)
+        {
+          detail::stencil_line(A, coefficients, x_old, static_cast<vcl_size_t>(line), line_result);
+
+          long offset = line * nx;
+          if (A.variable_coefficients())
+            for (long i = 0; i < nx; ++i)
+              x_new[offset + i] = x_old[offset + i] + weight * (b[offset + i] - line_result[i]) / diag[offset + i];
+          else
+            for (long i = 0; i < nx; ++i)
+              x_new[offset + i] = x_old[offset + i] + weight_over_diag * (b[offset + i] - line_result[i]);
+        }
+      }
+  }
+
+  if (iterations % 2 == 1)
+    std::copy(buffers[1], buffers[1] + A.size1(), buffers[0]);
+}
+
+
 } // namespace host_based
 } //namespace linalg
 } //namespace viennacl
@@ -0,0 +1,339 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_THREAD_POOL_HPP_
+#define VIENNACL_LINALG_HOST_BASED_THREAD_POOL_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/thread_pool.hpp
+    @brief Execution of jobs by a team of host threads, either by a persistent pool of POSIX threads or by an OpenMP parallel region.
+
+    The persistent pool is enabled by defining VIENNACL_WITH_HOST_THREAD_POOL (requires POSIX threads and GCC-compatible atomic builtins).
+    Idle workers spin for a while and then sleep on a condition variable, so that jobs issued in quick succession do not pay for waking up threads.
+    Without the pool, jobs run within a single OpenMP parallel region if VIENNACL_WITH_OPENMP is defined, or sequentially otherwise.
+*/
+
+#include <cstdlib>
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/linalg/host_based/openmp_thresholds.hpp"
+
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+/** @brief Number of polling iterations before an idle worker of the host thread pool goes to sleep */
+#ifndef VIENNACL_HOST_THREAD_POOL_SPIN_COUNT
+  #define VIENNACL_HOST_THREAD_POOL_SPIN_COUNT 100000
+#endif
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace host_based
+{
+
+/** @brief Synchronization point for all threads executing a job */
+class host_barrier
+{
+public:
+  virtual ~host_barrier() {}
+
+  /** @brief Returns once all threads of the team have called wait() */
+  virtual void wait() = 0;
+};
+
+/** @brief Interface for work executed by all threads of a team */
+class host_job
+{
+public:
+  virtual ~host_job() {}
+
+  /** @brief Executes the share of the calling thread. Called once by each of the 'num_threads' threads with a distinct 'thread_id'. */
+  virtual void execute(vcl_size_t thread_id, vcl_size_t num_threads, host_barrier & barrier) = 0;
+};
+
+namespace detail
+{
+  /** @brief Barrier for a single thread */
+  class serial_barrier : public host_barrier
+  {
+  public:
+    void wait() {}
+  };
+
+#ifdef VIENNACL_WITH_OPENMP
+  /** @brief Barrier for the threads of the enclosing OpenMP parallel region */
+  class openmp_barrier : public host_barrier
+  {
+  public:
+    void wait()
+    {
+      #pragma omp barrier
+    }
+  };
+#endif
+
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+  inline long atomic_load(long volatile * value) { return __sync_fetch_and_add(value, 0); }
+
+  inline void cpu_relax()
+  {
+#if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__("pause");
+#endif
+  }
+
+  /** @brief Sense-reversing barrier which spins and then yields the processor */
+  class spin_barrier : public host_barrier
+  {
+  public:
+    spin_barrier() : count_(0), generation_(0), num_threads_(1) {}
+
+    void reset(long num_threads) { num_threads_ = num_threads; }
+
+    void wait()
+    {
+      long generation = atomic_load(&generation_);
+      if (__sync_add_and_fetch(&count_, 1) == num_threads_)
+      {
+        count_ = 0;
+        __sync_fetch_and_add(&generation_, 1);
+        return;
+      }
+
+      for (long spins = 0; atomic_load(&generation_) == generation; ++spins)
+      {
+        if (spins < VIENNACL_HOST_THREAD_POOL_SPIN_COUNT)
+          cpu_relax();
+        else
+          sched_yield();
+      }
+    }
+
+  private:
+    long volatile count_;
+    long volatile generation_;
+    long num_threads_;
+  };
+#endif
+}
+
+#ifdef VIENNACL_WITH_HOST_THREAD_POOL
+
+/** @brief Persistent team of POSIX threads. The thread calling run() participates as thread 0. */
+class host_thread_pool
+{
+  struct worker_info
+  {
+    host_thread_pool * pool;
+    vcl_size_t         thread_id;
+  };
+
+public:
+  /** @brief Starts 'num_threads - 1' worker threads */
+  explicit host_thread_pool(vcl_size_t num_threads)
+    : job_(NULL), generation_(0), finished_(0), sleeping_(0), shutdown_(false), workers_(num_threads > 1 ? num_threads - 1 : 0)
+  {
+    pthread_mutex_init(&mutex_, NULL);
+    pthread_mutex_init(&run_mutex_, NULL);
+    pthread_cond_init(&wake_up_, NULL);
+
+    for (vcl_size_t i = 0; i < workers_.size(); ++i)
+    {
+      workers_[i].pool      = this;
+      workers_[i].thread_id = i + 1;
+    }
+    threads_.resize(workers_.size());
+    for (vcl_size_t i = 0; i < workers_.size(); ++i)
+      pthread_create(&threads_[i], NULL, &host_thread_pool::worker_main, &workers_[i]);
+  }
+
+  ~host_thread_pool()
+  {
+    shutdown_ = true;
+    pthread_mutex_lock(&mutex_);
+    __sync_fetch_and_add(&generation_, 1);
+    pthread_cond_broadcast(&wake_up_);
+    pthread_mutex_unlock(&mutex_);
+
+    for (vcl_size_t i = 0; i < threads_.size(); ++i)
+      pthread_join(threads_[i], NULL);
+
+    pthread_cond_destroy(&wake_up_);
+    pthread_mutex_destroy(&run_mutex_);
+    pthread_mutex_destroy(&mutex_);
+  }
+
+  /** @brief Number of threads in the team, including the calling thread */
+  vcl_size_t size() const { return workers_.size() + 1; }
+
+  /** @brief Executes the job on all threads of the team and returns once all threads are done.
+    *
+    * The team executes one job at a time. If it is busy with a job issued by another thread (e.g. by a host_stream), or if run() is called from within a job,
+    * the job is executed by the calling thread alone instead.
+    */
+  void run(host_job & job)
+  {
+    if (pthread_mutex_trylock(&run_mutex_) != 0)
+    {
+      detail::serial_barrier barrier;
+      job.execute(0, 1, barrier);
+      return;
+    }
+
+    job_ = &job;
+    finished_ = 0;
+    barrier_.reset(long(size()));
+
+    // publish the job, wake up workers only if some of them went to sleep:
+    __sync_fetch_and_add(&generation_, 1);
+    if (detail::atomic_load(&sleeping_) > 0)
+    {
+      pthread_mutex_lock(&mutex_);
+      pthread_cond_broadcast(&wake_up_);
+      pthread_mutex_unlock(&mutex_);
+    }
+
+    job.execute(0, size(), barrier_);
+
+    for (long spins = 0; detail::atomic_load(&finished_) < long(workers_.size()); ++spins)
+    {
+      if (spins < VIENNACL_HOST_THREAD_POOL_SPIN_COUNT)
+        detail::cpu_relax();
+      else
+        sched_yield();
+    }
+
+    pthread_mutex_unlock(&run_mutex_);
+  }
+
+  /** @brief Returns the pool shared by all host kernels. Its size is taken from the environment variable VIENNACL_HOST_THREADS, or the number of online processors. */
+  static host_thread_pool & instance()
+  {
+    static host_thread_pool pool(default_size());
+    return pool;
+  }
+
+private:
+  host_thread_pool(host_thread_pool const &);
+  host_thread_pool & operator=(host_thread_pool const &);
+
+  static vcl_size_t default_size()
+  {
+    if (const char * num_threads = std::getenv("VIENNACL_HOST_THREADS"))
+      if (std::atoi(num_threads) > 0)
+        return vcl_size_t(std::atoi(num_threads));
+
+    long num_procs = sysconf(_SC_NPROCESSORS_ONLN);
+    return num_procs > 0 ? vcl_size_t(num_procs) : 1;
+  }
+
+  static void * worker_main(void * arg)
+  {
+    worker_info * info = static_cast<worker_info *>(arg);
+    info->pool->worker_loop(info->thread_id);
+    return NULL;
+  }
+
+  void worker_loop(vcl_size_t thread_id)
+  {
+    long seen_generation = 0;
+    for (;;)
+    {
+      // spin, then park:
+      long spins = 0;
+      while (detail::atomic_load(&generation_) == seen_generation && spins < VIENNACL_HOST_THREAD_POOL_SPIN_COUNT)
+      {
+        detail::cpu_relax();
+        ++spins;
+      }
+
+      if (detail::atomic_load(&generation_) == seen_generation)
+      {
+        pthread_mutex_lock(&mutex_);
+        __sync_fetch_and_add(&sleeping_, 1);
+        while (detail::atomic_load(&generation_) == seen_generation)
+          pthread_cond_wait(&wake_up_, &mutex_);
+        __sync_fetch_and_sub(&sleeping_, 1);
+        pthread_mutex_unlock(&mutex_);
+      }
+
+      seen_generation = detail::atomic_load(&generation_);
+      if (shutdown_)
+        return;
+
+      job_->execute(thread_id, size(), barrier_);
+      __sync_fetch_and_add(&finished_, 1);
+    }
+  }
+
+  host_job * volatile job_;
+  long volatile generation_;
+  long volatile finished_;
+  long volatile sleeping_;
+  bool volatile shutdown_;
+
+  std::vector<worker_info> workers_;
+  std::vector<pthread_t>   threads_;
+  pthread_mutex_t          mutex_;
+  pthread_mutex_t          run_mutex_;
+  pthread_cond_t           wake_up_;
+  detail::spin_barrier     barrier_;
+};
+
+#endif
+
+/** @brief Executes a job on a team of host threads: the persistent pool if VIENNACL_WITH_HOST_THREAD_POOL is defined, an OpenMP parallel region if VIENNACL_WITH_OPENMP is defined, or the calling thread otherwise.
+  *
+  * @param job       The job to execute
+  * @param parallel  If false, the job is executed by the calling thread only (e.g. because the amount of work is small)
+  */
+inline void run_host_job(host_job & job, bool parallel = true)
+{
+  if (parallel)
+  {
+#if defined(VIENNACL_WITH_HOST_THREAD_POOL)
+    host_thread_pool::instance().run(job);
+    return;
+#elif defined(VIENNACL_WITH_OPENMP)
+    #pragma omp parallel num_threads(VIENNACL_OPENMP_VECTOR_NUM_THREADS)
+    {
+      detail::openmp_barrier barrier;
+      job.execute(vcl_size_t(omp_get_thread_num()), vcl_size_t(omp_get_num_threads()), barrier);
+    }
+    return;
+#endif
+  }
+
+  detail::serial_barrier barrier;
+  job.execute(0, 1, barrier);
+}
+
+} // namespace host_based
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -32,6 +32,7 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/ilu_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -56,6 +57,7 @@ template<typename NumericT>
 void extract_L(compressed_matrix<NumericT> const & A,
                compressed_matrix<NumericT>       & L)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::extract_L", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -87,6 +89,7 @@ template<typename NumericT>
 void icc_scale(compressed_matrix<NumericT> const & A,
                compressed_matrix<NumericT>       & L)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::icc_scale", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -121,6 +124,7 @@ template<typename NumericT>
 void icc_chow_patel_sweep(compressed_matrix<NumericT>       & L,
                           vector<NumericT>                  & aij_L)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::icc_chow_patel_sweep", 0, 0);
   switch (viennacl::traits::handle(L).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -157,6 +161,7 @@ void extract_LU(compressed_matrix<NumericT> const & A,
                 compressed_matrix<NumericT>       & L,
                 compressed_matrix<NumericT>       & U)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::extract_LU", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -189,6 +194,7 @@ void ilu_scale(compressed_matrix<NumericT> const & A,
                compressed_matrix<NumericT>       & L,
                compressed_matrix<NumericT>       & U)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::scale", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -228,6 +234,7 @@ void ilu_transpose(compressed_matrix<NumericT> const & A,
   viennacl::compressed_matrix<NumericT> A_host(0, 0, 0, cpu_ctx);
   (void)A_host;
 
+  VIENNACL_PROFILE_SCOPE("ilu::transpose", 0, 0);
   switch (viennacl::traits::handle(A).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -274,6 +281,7 @@ void ilu_chow_patel_sweep(compressed_matrix<NumericT>       & L,
                           compressed_matrix<NumericT>       & U_trans,
                           vector<NumericT>            const & aij_U_trans)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::chow_patel_sweep", 0, 0);
   switch (viennacl::traits::handle(L).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -305,6 +313,7 @@ template<typename NumericT>
 void ilu_form_neumann_matrix(compressed_matrix<NumericT> & R,
                              vector<NumericT> & diag_R)
 {
+  VIENNACL_PROFILE_SCOPE("ilu::form_neumann_matrix", 0, 0);
   switch (viennacl::traits::handle(R).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
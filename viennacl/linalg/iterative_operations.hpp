@@ -32,6 +32,7 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/iterative_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -64,6 +65,7 @@ void pipelined_cg_vector_update(vector_base<NumericT> & result,
                                 NumericT beta,
                                 vector_base<NumericT> & inner_prod_buffer)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_cg_vector_update", 7 * viennacl::tools::profiler_bytes(result), 10 * viennacl::traits::size(result));
   switch (viennacl::traits::handle(result).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -99,6 +101,7 @@ void pipelined_cg_prod(MatrixT const & A,
                        vector_base<NumericT> & Ap,
                        vector_base<NumericT> & inner_prod_buffer)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_cg_prod", viennacl::tools::profiler_sparse_bytes<NumericT>(A) + 2 * viennacl::tools::profiler_bytes(p), 2 * viennacl::tools::profiler_nnz(A) + 4 * viennacl::traits::size(p));
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -138,6 +141,7 @@ void pipelined_bicgstab_update_s(vector_base<NumericT> & s,
                                  vcl_size_t buffer_chunk_size,
                                  vcl_size_t buffer_chunk_offset)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_bicgstab_update_s", 0, 0);
   switch (viennacl::traits::handle(s).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -175,6 +179,7 @@ void pipelined_bicgstab_vector_update(vector_base<NumericT> & result, NumericT a
                                       vector_base<NumericT> & inner_prod_buffer,
                                       vcl_size_t buffer_chunk_size)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_bicgstab_vector_update", 0, 0);
   switch (viennacl::traits::handle(s).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -213,6 +218,7 @@ void pipelined_bicgstab_prod(MatrixT const & A,
                              vcl_size_t buffer_chunk_size,
                              vcl_size_t buffer_chunk_offset)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_bicgstab_prod", viennacl::tools::profiler_sparse_bytes<NumericT>(A) + 3 * viennacl::tools::profiler_bytes(p), 2 * viennacl::tools::profiler_nnz(A) + 6 * viennacl::traits::size(p));
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -254,6 +260,7 @@ void pipelined_gmres_normalize_vk(vector_base<T> & v_k,
                                   vcl_size_t buffer_chunk_size,
                                   vcl_size_t buffer_chunk_offset)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_normalize_vk", 0, 0);
   switch (viennacl::traits::handle(v_k).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -290,6 +297,7 @@ void pipelined_gmres_gram_schmidt_stage1(vector_base<T> const & device_krylov_ba
                                          vector_base<T> & vi_in_vk_buffer,
                                          vcl_size_t buffer_chunk_size)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_gram_schmidt_stage1", 0, 0);
   switch (viennacl::traits::handle(device_krylov_basis).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -328,6 +336,7 @@ void pipelined_gmres_gram_schmidt_stage2(vector_base<T> & device_krylov_basis,
                                          vector_base<T> & inner_prod_buffer,
                                          vcl_size_t buffer_chunk_size)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_gram_schmidt_stage2", 0, 0);
   switch (viennacl::traits::handle(device_krylov_basis).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -361,6 +370,7 @@ void pipelined_gmres_update_result(vector_base<T> & result,
                                    vector_base<T> const & coefficients,
                                    vcl_size_t k)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_update_result", 0, 0);
   switch (viennacl::traits::handle(result).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -395,6 +405,7 @@ void pipelined_gmres_prod(MatrixType const & A,
                        vector_base<T> & Ap,
                        vector_base<T> & inner_prod_buffer)
 {
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_prod", viennacl::tools::profiler_sparse_bytes<T>(A), 2 * viennacl::tools::profiler_nnz(A));
   switch (viennacl::traits::handle(p).get_active_handle_id())
   {
   case viennacl::MAIN_MEMORY:
@@ -417,6 +428,73 @@ void pipelined_gmres_prod(MatrixType const & A,
   }
 }
 
+//
+// block_compressed_matrix: Only implemented for main memory so far
+//
+
+/** @brief Performs a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined CG algorithm. */
+template<typename NumericT, unsigned int BlockSize>
+void pipelined_cg_prod(block_compressed_matrix<NumericT, BlockSize> const & A,
+                       vector_base<NumericT> const & p,
+                       vector_base<NumericT> & Ap,
+                       vector_base<NumericT> & inner_prod_buffer)
+{
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_cg_prod", viennacl::tools::profiler_sparse_bytes<NumericT>(A) + 2 * viennacl::tools::profiler_bytes(p), 2 * viennacl::tools::profiler_nnz(A) + 4 * viennacl::traits::size(p));
+  switch (viennacl::traits::handle(p).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_cg_prod(A, p, Ap, inner_prod_buffer);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined BiCGStab algorithm. */
+template<typename NumericT, unsigned int BlockSize>
+void pipelined_bicgstab_prod(block_compressed_matrix<NumericT, BlockSize> const & A,
+                             vector_base<NumericT> const & p,
+                             vector_base<NumericT> & Ap,
+                             vector_base<NumericT> const & r0star,
+                             vector_base<NumericT> & inner_prod_buffer,
+                             vcl_size_t buffer_chunk_size,
+                             vcl_size_t buffer_chunk_offset)
+{
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_bicgstab_prod", viennacl::tools::profiler_sparse_bytes<NumericT>(A) + 3 * viennacl::tools::profiler_bytes(p), 2 * viennacl::tools::profiler_nnz(A) + 6 * viennacl::traits::size(p));
+  switch (viennacl::traits::handle(p).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_bicgstab_prod(A, p, Ap, r0star, inner_prod_buffer, buffer_chunk_size, buffer_chunk_offset);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
+/** @brief Performs a fused matrix-vector product with a block_compressed_matrix for an efficient pipelined GMRES algorithm. */
+template<typename NumericT, unsigned int BlockSize>
+void pipelined_gmres_prod(block_compressed_matrix<NumericT, BlockSize> const & A,
+                          vector_base<NumericT> const & p,
+                          vector_base<NumericT> & Ap,
+                          vector_base<NumericT> & inner_prod_buffer)
+{
+  VIENNACL_PROFILE_SCOPE("iterative::pipelined_gmres_prod", viennacl::tools::profiler_sparse_bytes<NumericT>(A), 2 * viennacl::tools::profiler_nnz(A));
+  switch (viennacl::traits::handle(p).get_active_handle_id())
+  {
+  case viennacl::MAIN_MEMORY:
+    viennacl::linalg::host_based::pipelined_gmres_prod(A, p, Ap, inner_prod_buffer);
+    break;
+  case viennacl::MEMORY_NOT_INITIALIZED:
+    throw memory_exception("not initialised!");
+  default:
+    throw memory_exception("not implemented");
+  }
+}
+
 
 } //namespace linalg
 } //namespace viennacl
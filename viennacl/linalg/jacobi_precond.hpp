@@ -27,6 +27,8 @@
 #include "viennacl/forwards.h"
 #include "viennacl/vector.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/block_compressed_matrix.hpp"
+#include "viennacl/stencil_operator.hpp"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/linalg/sparse_matrix_operations.hpp"
 #include "viennacl/linalg/row_scaling.hpp"
@@ -129,6 +131,96 @@ class jacobi_precond<MatrixT, true>
     viennacl::vector<NumericType> diag_A_;
 };
 
+
+/** @brief Block-Jacobi preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for block_compressed_matrix: The inverses of the dense diagonal blocks are computed on the host and applied as a block-diagonal block_compressed_matrix.
+*/
+template<typename NumericT, unsigned int BlockSize>
+class jacobi_precond< viennacl::block_compressed_matrix<NumericT, BlockSize>, false >
+{
+    typedef viennacl::block_compressed_matrix<NumericT, BlockSize>   MatrixType;
+
+  public:
+    jacobi_precond(MatrixType const & mat, jacobi_tag const &) : inv_diag_A_(viennacl::traits::context(mat))
+    {
+      init(mat);
+    }
+
+
+    void init(MatrixType const & mat)
+    {
+      assert( (mat.size1() == mat.size2()) && bool("Block-Jacobi preconditioner requires a square matrix"));
+
+      std::vector<unsigned int> block_row_buffer, block_col_buffer;
+      std::vector<NumericT> elements;
+      viennacl::detail::read_block_compressed_matrix(mat, block_row_buffer, block_col_buffer, elements);
+
+      vcl_size_t block_rows = mat.block_rows();
+      std::vector<NumericT> inverses(std::max<vcl_size_t>(block_rows, 1) * BlockSize * BlockSize);
+      if (block_rows > 0
+          && !viennacl::linalg::host_based::detail::bsr_invert_diagonal_blocks<NumericT, BlockSize>(&(block_row_buffer[0]), &(block_col_buffer[0]), &(elements[0]),
+                                                                                                   block_rows, &(inverses[0])))
+        throw zero_on_diagonal_exception("ViennaCL: Singular diagonal block encountered while setting up block-Jacobi preconditioner!");
+
+      std::vector<unsigned int> diag_row_buffer(block_rows + 1), diag_col_buffer(std::max<vcl_size_t>(block_rows, 1));
+      for (vcl_size_t i = 0; i <= block_rows; ++i)
+        diag_row_buffer[i] = static_cast<unsigned int>(i);
+      for (vcl_size_t i = 0; i < block_rows; ++i)
+        diag_col_buffer[i] = static_cast<unsigned int>(i);
+
+      inv_diag_A_.set(&(diag_row_buffer[0]), &(diag_col_buffer[0]), &(inverses[0]), mat.size1(), mat.size2(), block_rows);
+    }
+
+
+    template<unsigned int AlignmentV>
+    void apply(viennacl::vector<NumericT, AlignmentV> & vec) const
+    {
+      assert(inv_diag_A_.size1() == viennacl::traits::size(vec) && bool("Size mismatch"));
+      vec = viennacl::linalg::prod(inv_diag_A_, vec);
+    }
+
+  private:
+    MatrixType inv_diag_A_;
+};
+
+
+/** @brief Jacobi preconditioner class, can be supplied to solve()-routines.
+*
+*  Specialization for stencil_operator: The diagonal is given by the coefficients of the center of the stencil.
+*/
+template<typename NumericT>
+class jacobi_precond< viennacl::stencil_operator<NumericT>, false >
+{
+  public:
+    jacobi_precond(viennacl::stencil_operator<NumericT> const & mat, jacobi_tag const &) : diag_A_(mat.size1(), viennacl::traits::context(mat.handle()))
+    {
+      init(mat);
+    }
+
+
+    void init(viennacl::stencil_operator<NumericT> const & mat)
+    {
+      std::vector<NumericT> diag;
+      mat.diagonal(diag);
+      for (vcl_size_t i = 0; i < diag.size(); ++i)
+        if (diag[i] <= 0 && diag[i] >= 0)
+          throw zero_on_diagonal_exception("ViennaCL: Zero in diagonal encountered while setting up Jacobi preconditioner!");
+      viennacl::copy(diag, diag_A_);
+    }
+
+
+    template<unsigned int AlignmentV>
+    void apply(viennacl::vector<NumericT, AlignmentV> & vec) const
+    {
+      assert(viennacl::traits::size(diag_A_) == viennacl::traits::size(vec) && bool("Size mismatch"));
+      vec = element_div(vec, diag_A_);
+    }
+
+  private:
+    viennacl::vector<NumericT> diag_A_;
+};
+
 }
 }
 
@@ -19,172 +19,341 @@
 ============================================================================= */
 
 /** @file viennacl/linalg/lu.hpp
-    @brief Implementations of LU factorization for row-major and column-major dense matrices.
+    @brief Implementations of LU (with and without partial pivoting) and Cholesky factorizations for row-major and column-major dense matrices.
 */
 
 #include <algorithm>    //for std::min
+#include <cmath>
+#include <vector>
 
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/matrix_operations.hpp"
+#include "viennacl/linalg/vector_operations.hpp"
+
+#ifndef VIENNACL_LU_BLOCKSIZE
+  #define VIENNACL_LU_BLOCKSIZE  16
+#endif
 
 namespace viennacl
 {
 namespace linalg
 {
-/** @brief LU factorization of a row-major dense matrix.
-*
-* @param A    The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
-*/
-template<typename NumericT>
-void lu_factorize(matrix<NumericT, viennacl::row_major> & A)
+
+namespace detail
 {
-  typedef matrix<NumericT, viennacl::row_major>  MatrixType;
+  /** @brief Returns the index of the entry (i, j) of A (which might be a range or slice) within the underlying buffer */
+  template<typename NumericT>
+  vcl_size_t lu_mem_index(matrix_base<NumericT> const & A, vcl_size_t i, vcl_size_t j)
+  {
+    if (A.row_major())
+      return row_major::mem_index(A.start1() + i * A.stride1(), A.start2() + j * A.stride2(), A.internal_size1(), A.internal_size2());
+    return column_major::mem_index(A.start1() + i * A.stride1(), A.start2() + j * A.stride2(), A.internal_size1(), A.internal_size2());
+  }
 
-  vcl_size_t max_block_size = 32;
-  vcl_size_t num_blocks = (A.size2() - 1) / max_block_size + 1;
-  std::vector<NumericT> temp_buffer(A.internal_size2() * max_block_size);
+  /** @brief Distance in memory of two consecutive entries in a row of A */
+  template<typename NumericT>
+  vcl_size_t lu_row_inc(matrix_base<NumericT> const & A)
+  {
+    return A.row_major() ? A.stride2() : A.stride2() * A.internal_size1();
+  }
 
-  // Iterate over panels
-  for (vcl_size_t panel_id = 0; panel_id < num_blocks; ++panel_id)
+  /** @brief Distance in memory of two consecutive entries in a column of A */
+  template<typename NumericT>
+  vcl_size_t lu_col_inc(matrix_base<NumericT> const & A)
   {
-    vcl_size_t row_start = panel_id * max_block_size;
-    vcl_size_t current_block_size = std::min<vcl_size_t>(A.size1() - row_start, max_block_size);
+    return A.row_major() ? A.stride1() * A.internal_size2() : A.stride1();
+  }
 
-    viennacl::range     block_range(row_start, row_start + current_block_size);
-    viennacl::range remainder_range(row_start + current_block_size, A.size1());
+  /** @brief Swaps the rows i and k of A within the columns [col_begin, col_end). Works on all compute backends. */
+  template<typename NumericT>
+  void lu_swap_rows(matrix_base<NumericT> & A, vcl_size_t i, vcl_size_t k, vcl_size_t col_begin, vcl_size_t col_end)
+  {
+    if (i == k || col_begin >= col_end)
+      return;
 
-    //
-    // Perform LU factorization on panel:
-    //
+    viennacl::vector_base<NumericT> row_i(A.handle(), col_end - col_begin, lu_mem_index(A, i, col_begin), lu_row_inc(A));
+    viennacl::vector_base<NumericT> row_k(A.handle(), col_end - col_begin, lu_mem_index(A, k, col_begin), lu_row_inc(A));
+    viennacl::swap(row_i, row_k);
+  }
+
+  /** @brief Applies the row interchanges ipiv[row_begin], ..., ipiv[row_end-1] (LAPACK convention) to the columns [col_begin, col_end) of A */
+  template<typename NumericT>
+  void lu_apply_pivots(matrix_base<NumericT> & A, vcl_size_t const * ipiv, vcl_size_t row_begin, vcl_size_t row_end, vcl_size_t col_begin, vcl_size_t col_end)
+  {
+    for (vcl_size_t k = row_begin; k < row_end; ++k)
+      lu_swap_rows(A, k, ipiv[k], col_begin, col_end);
+  }
 
+  /** @brief Unblocked right-looking LU factorization of a narrow panel (size1(A) >= size2(A)).
+  *
+  * If ipiv is not NULL, partial pivoting is applied within the panel and the row interchanges are recorded in ipiv.
+  * All operations are expressed through vector operations and rank-1 updates with the pivot kept in device memory, hence no data is transferred to the host except for the pivot indices.
+  * With pivoting, the diagonal of the panel is checked for zeros once the panel is factored. Without pivoting, no check is done (as before), so a zero pivot results in Inf/NaN entries.
+  */
+  template<typename NumericT>
+  void lu_factorize_panel(matrix_base<NumericT> & A, vcl_size_t * ipiv)
+  {
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
 
-    // Read from matrix to buffer:
-    viennacl::backend::memory_read(A.handle(),
-                                   sizeof(NumericT) * row_start          * A.internal_size2(),
-                                   sizeof(NumericT) * current_block_size * A.internal_size2(),
-                                   &(temp_buffer[0]));
+    viennacl::scalar<NumericT> a_kk(0, viennacl::traits::context(A));
 
-    // Factorize (kij-version):
-    for (vcl_size_t k=0; k < current_block_size - 1; ++k)
+    for (vcl_size_t k = 0; k < n; ++k)
     {
-      for (vcl_size_t i=k+1; i < current_block_size; ++i)
+      if (ipiv)
+      {
+        viennacl::vector_base<NumericT> col_k(A.handle(), m - k, lu_mem_index(A, k, k), lu_col_inc(A));
+        vcl_size_t pivot = viennacl::linalg::index_norm_inf(col_k);
+        ipiv[k] = k + (pivot < m - k ? pivot : 0);  // the host backend does not return a valid index for a zero column
+        lu_swap_rows(A, k, ipiv[k], 0, n);
+      }
+
+      if (k + 1 < m)
       {
-        temp_buffer[row_start + i * A.internal_size2() + k] /= temp_buffer[row_start + k * A.internal_size2() + k];  // write l_ik
+        viennacl::backend::memory_copy(A.handle(), a_kk.handle(), sizeof(NumericT) * lu_mem_index(A, k, k), 0, sizeof(NumericT));
 
-        NumericT l_ik = temp_buffer[row_start + i * A.internal_size2() + k];
+        viennacl::vector_base<NumericT> l_k(A.handle(), m - k - 1, lu_mem_index(A, k + 1, k), lu_col_inc(A));
+        l_k /= a_kk;
 
-        for (vcl_size_t j = row_start + k + 1; j < A.size1(); ++j)
-          temp_buffer[i * A.internal_size2() + j] -= l_ik * temp_buffer[k * A.internal_size2() + j];  // l_ik * a_kj
+        if (k + 1 < n)
+        {
+          viennacl::vector_base<NumericT> u_k(A.handle(), n - k - 1, lu_mem_index(A, k, k + 1), lu_row_inc(A));
+          viennacl::matrix_range<matrix_base<NumericT> > A_22(A, viennacl::range(k + 1, m), viennacl::range(k + 1, n));
+          viennacl::linalg::scaled_rank_1_update(A_22, NumericT(-1), 1, false, false, l_k, u_k);
+        }
       }
     }
 
-    // Write back:
-    viennacl::backend::memory_write(A.handle(),
-                                    sizeof(NumericT) * row_start          * A.internal_size2(),
-                                    sizeof(NumericT) * current_block_size * A.internal_size2(),
-                                    &(temp_buffer[0]));
-
-    if (remainder_range.size() > 0)
+    if (ipiv && n > 0)
     {
-      //
-      // Compute L_12 = [ (U_11)^{T}^{-1} A_{21}^T ]^T
-      //
-      viennacl::matrix_range<MatrixType> U_11(A, block_range,     block_range);
-      viennacl::matrix_range<MatrixType> A_21(A, remainder_range, block_range);
-      viennacl::linalg::inplace_solve(trans(U_11), trans(A_21), viennacl::linalg::lower_tag());
-
-      //
-      // Update remainder of A
-      //
-      viennacl::matrix_range<MatrixType> L_21(A, remainder_range, block_range);
-      viennacl::matrix_range<MatrixType> U_12(A, block_range,     remainder_range);
-      viennacl::matrix_range<MatrixType> A_22(A, remainder_range, remainder_range);
-
-      A_22 -= viennacl::linalg::prod(L_21, U_12);
+      viennacl::vector_base<NumericT> diagonal(A.handle(), n, lu_mem_index(A, 0, 0), lu_col_inc(A) + lu_row_inc(A));
+      std::vector<NumericT> diagonal_host(n);
+      viennacl::copy(diagonal.begin(), diagonal.end(), diagonal_host.begin());
+      for (vcl_size_t k = 0; k < n; ++k)
+        if (!(diagonal_host[k] > 0 || diagonal_host[k] < 0))
+          throw zero_on_diagonal_exception("ViennaCL: Singular matrix encountered in LU factorization!");
     }
   }
 
-}
+  /** @brief Recursive LU factorization (Toledo) of a panel A with size1(A) >= size2(A).
+  *
+  * The columns are split in halves until the panel is at most VIENNACL_LU_BLOCKSIZE wide.
+  * Thus, most of the work ends up in a few large triangular solves and matrix-matrix products, which are run in parallel by the respective backend.
+  *
+  * @param A      The panel to be factorized in place
+  * @param ipiv   Row interchanges relative to the first row of A. Pass NULL to factorize without pivoting.
+  */
+  template<typename NumericT>
+  void lu_factorize_recursive(matrix_base<NumericT> & A, vcl_size_t * ipiv)
+  {
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
 
+    if (n <= VIENNACL_LU_BLOCKSIZE)
+    {
+      lu_factorize_panel(A, ipiv);
+      return;
+    }
 
-/** @brief LU factorization of a column-major dense matrix.
-*
-* @param A    The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
-*/
-template<typename NumericT>
-void lu_factorize(matrix<NumericT, viennacl::column_major> & A)
-{
-  typedef matrix<NumericT, viennacl::column_major>  MatrixType;
+    vcl_size_t n1 = n / 2;
 
-  vcl_size_t max_block_size = 32;
-  vcl_size_t num_blocks = (A.size1() - 1) / max_block_size + 1;
-  std::vector<NumericT> temp_buffer(A.internal_size1() * max_block_size);
+    // factor left half:
+    viennacl::matrix_range<matrix_base<NumericT> > A_left(A, viennacl::range(0, m), viennacl::range(0, n1));
+    lu_factorize_recursive(A_left, ipiv);
+    if (ipiv)
+      lu_apply_pivots(A, ipiv, 0, n1, n1, n);
 
-  // Iterate over panels
-  for (vcl_size_t panel_id = 0; panel_id < num_blocks; ++panel_id)
-  {
-    vcl_size_t col_start = panel_id * max_block_size;
-    vcl_size_t current_block_size = std::min<vcl_size_t>(A.size1() - col_start, max_block_size);
+    // U_12 = L_11^{-1} A_12
+    viennacl::matrix_range<matrix_base<NumericT> > L_11(A, viennacl::range(0, n1), viennacl::range(0,  n1));
+    viennacl::matrix_range<matrix_base<NumericT> > A_12(A, viennacl::range(0, n1), viennacl::range(n1, n));
+    viennacl::linalg::inplace_solve(L_11, A_12, viennacl::linalg::unit_lower_tag());
 
-    viennacl::range     block_range(col_start, col_start + current_block_size);
-    viennacl::range remainder_range(col_start + current_block_size, A.size1());
+    // A_22 -= L_21 * U_12
+    viennacl::matrix_range<matrix_base<NumericT> > L_21(A, viennacl::range(n1, m), viennacl::range(0,  n1));
+    viennacl::matrix_range<matrix_base<NumericT> > A_22(A, viennacl::range(n1, m), viennacl::range(n1, n));
+    viennacl::linalg::prod_impl(L_21, A_12, A_22, NumericT(-1), NumericT(1));
 
-    //
-    // Perform LU factorization on panel:
-    //
+    // factor right half:
+    lu_factorize_recursive(A_22, ipiv ? ipiv + n1 : NULL);
+    if (ipiv)
+    {
+      for (vcl_size_t k = n1; k < n; ++k)
+        ipiv[k] += n1;
+      lu_apply_pivots(A, ipiv, n1, n, 0, n1);
+    }
+  }
 
+  /** @brief Unblocked Cholesky factorization of a diagonal block, with the pivots kept in device memory as in lu_factorize_panel().
+  *
+  * The square roots of the pivots are computed in place. The diagonal is transferred to the host once the block is factored in order to check for positive definiteness.
+  */
+  template<typename NumericT>
+  void cholesky_factorize_block(matrix_base<NumericT> & A)
+  {
+    vcl_size_t n = A.size1();
 
-    // Read from matrix to buffer:
-    viennacl::backend::memory_read(A.handle(),
-                                   sizeof(NumericT) * col_start          * A.internal_size1(),
-                                   sizeof(NumericT) * current_block_size * A.internal_size1(),
-                                   &(temp_buffer[0]));
+    viennacl::scalar<NumericT> a_kk(0, viennacl::traits::context(A));
 
-    // Factorize (kji-version):
-    for (vcl_size_t k=0; k < current_block_size; ++k)
+    for (vcl_size_t k = 0; k < n; ++k)
     {
-      NumericT a_kk = temp_buffer[col_start + k + k * A.internal_size1()];
-      for (vcl_size_t i=col_start+k+1; i < A.size1(); ++i)
-        temp_buffer[i + k * A.internal_size1()] /= a_kk;  // write l_ik
+      viennacl::vector_base<NumericT> pivot(A.handle(), 1, lu_mem_index(A, k, k), 1);
+      pivot = viennacl::linalg::element_sqrt(pivot);
 
-      for (vcl_size_t j=k+1; j < current_block_size; ++j)
+      if (k + 1 < n)
       {
-        NumericT a_kj = temp_buffer[col_start + k + j * A.internal_size1()];
-        for (vcl_size_t i=col_start+k+1; i < A.size1(); ++i)
-          temp_buffer[i + j * A.internal_size1()] -= temp_buffer[i + k * A.internal_size1()] * a_kj;  // l_ik * a_kj
+        viennacl::backend::memory_copy(A.handle(), a_kk.handle(), sizeof(NumericT) * lu_mem_index(A, k, k), 0, sizeof(NumericT));
+
+        viennacl::vector_base<NumericT> l_k(A.handle(), n - k - 1, lu_mem_index(A, k + 1, k), lu_col_inc(A));
+        l_k /= a_kk;
+
+        viennacl::matrix_range<matrix_base<NumericT> > A_22(A, viennacl::range(k + 1, n), viennacl::range(k + 1, n));
+        viennacl::linalg::scaled_rank_1_update(A_22, NumericT(-1), 1, false, false, l_k, l_k);
+
+        viennacl::vector_base<NumericT> u_k(A.handle(), n - k - 1, lu_mem_index(A, k, k + 1), lu_row_inc(A));
+        viennacl::linalg::vector_assign(u_k, NumericT(0));
       }
     }
 
-    // Write back:
-    viennacl::backend::memory_write(A.handle(),
-                                    sizeof(NumericT) * col_start          * A.internal_size1(),
-                                    sizeof(NumericT) * current_block_size * A.internal_size1(),
-                                    &(temp_buffer[0]));
+    if (n > 0)
+    {
+      // a non-positive pivot results in a zero or NaN entry on the diagonal:
+      viennacl::vector_base<NumericT> diagonal(A.handle(), n, lu_mem_index(A, 0, 0), lu_col_inc(A) + lu_row_inc(A));
+      std::vector<NumericT> diagonal_host(n);
+      viennacl::copy(diagonal.begin(), diagonal.end(), diagonal_host.begin());
+      for (vcl_size_t k = 0; k < n; ++k)
+        if (!(diagonal_host[k] > 0))
+          throw zero_on_diagonal_exception("ViennaCL: Matrix not positive definite in Cholesky factorization!");
+    }
+  }
+
+  /** @brief Recursive Cholesky factorization A = L L^T of a symmetric positive definite matrix. The strict upper part of A is set to zero. */
+  template<typename NumericT>
+  void cholesky_factorize_recursive(matrix_base<NumericT> & A)
+  {
+    vcl_size_t n = A.size1();
 
-    if (remainder_range.size() > 0)
+    if (n <= VIENNACL_LU_BLOCKSIZE)
     {
-      //
-      // Compute U_12:
-      //
-      viennacl::matrix_range<MatrixType> L_11(A, block_range,     block_range);
-      viennacl::matrix_range<MatrixType> A_12(A, block_range, remainder_range);
-      viennacl::linalg::inplace_solve(L_11, A_12, viennacl::linalg::unit_lower_tag());
-
-      //
-      // Update remainder of A
-      //
-      viennacl::matrix_range<MatrixType> L_21(A, remainder_range, block_range);
-      viennacl::matrix_range<MatrixType> U_12(A, block_range,     remainder_range);
-      viennacl::matrix_range<MatrixType> A_22(A, remainder_range, remainder_range);
-
-      A_22 -= viennacl::linalg::prod(L_21, U_12);
+      cholesky_factorize_block(A);
+      return;
     }
 
+    vcl_size_t n1 = n / 2;
+
+    viennacl::matrix_range<matrix_base<NumericT> > L_11(A, viennacl::range(0,  n1), viennacl::range(0,  n1));
+    viennacl::matrix_range<matrix_base<NumericT> > A_12(A, viennacl::range(0,  n1), viennacl::range(n1, n));
+    viennacl::matrix_range<matrix_base<NumericT> > A_21(A, viennacl::range(n1, n),  viennacl::range(0,  n1));
+    viennacl::matrix_range<matrix_base<NumericT> > A_22(A, viennacl::range(n1, n),  viennacl::range(n1, n));
+
+    cholesky_factorize_recursive(L_11);
+
+    // L_21 = A_21 L_11^{-T}, i.e. L_11 L_21^T = A_21^T
+    viennacl::matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans> L_21_trans(A_21, A_21);
+    viennacl::linalg::inplace_solve(L_11, L_21_trans, viennacl::linalg::lower_tag());
+
+    // A_22 -= L_21 L_21^T
+    viennacl::linalg::prod_impl(A_21, L_21_trans, A_22, NumericT(-1), NumericT(1));
+
+    viennacl::linalg::matrix_assign(A_12, NumericT(0));
+
+    cholesky_factorize_recursive(A_22);
   }
 
+  /** @brief Applies the row permutation 'permutation' to B, i.e. row i of the result is row permutation[i] of the input */
+  template<typename NumericT>
+  void lu_permute_rows(matrix_base<NumericT> & B, std::vector<vcl_size_t> const & permutation)
+  {
+    // position[r]: current row index of the original row r, current[i]: original row at current row index i
+    std::vector<vcl_size_t> position(permutation.size());
+    std::vector<vcl_size_t> current(permutation.size());
+    for (vcl_size_t i = 0; i < permutation.size(); ++i)
+      position[i] = current[i] = i;
+
+    for (vcl_size_t i = 0; i < permutation.size(); ++i)
+    {
+      vcl_size_t k = position[permutation[i]];
+      if (k != i)
+      {
+        lu_swap_rows(B, i, k, 0, B.size2());
+        position[current[i]] = k;
+        position[current[k]] = i;
+        std::swap(current[i], current[k]);
+      }
+    }
+  }
+
+  /** @brief Applies the row permutation 'permutation' to the vector vec, i.e. entry i of the result is entry permutation[i] of the input */
+  template<typename NumericT>
+  void lu_permute_rows(vector_base<NumericT> & vec, std::vector<vcl_size_t> const & permutation)
+  {
+    std::vector<NumericT> buffer(vec.size());
+    viennacl::copy(vec.begin(), vec.end(), buffer.begin());
+
+    std::vector<NumericT> permuted(vec.size());
+    for (vcl_size_t i = 0; i < permutation.size(); ++i)
+      permuted[i] = buffer[permutation[i]];
+
+    viennacl::copy(permuted.begin(), permuted.end(), vec.begin());
+  }
+
+} //namespace detail
+
+
+/** @brief LU factorization of a dense matrix without pivoting.
+*
+* A recursive blocked algorithm is used, casting most of the work into triangular solves and matrix-matrix products.
+* Note that the factorization is numerically unstable unless the matrix is e.g. diagonally dominant. Use the overload with pivoting otherwise.
+*
+* @param A    The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+*/
+template<typename NumericT, typename F>
+void lu_factorize(matrix<NumericT, F> & A)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  detail::lu_factorize_recursive(A, NULL);
+}
+
+/** @brief LU factorization of a dense matrix with partial (row) pivoting, i.e. P A = L U.
+*
+* A recursive blocked algorithm is used, casting most of the work into triangular solves and matrix-matrix products.
+*
+* @param A            The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+* @param permutation  The row permutation P, where row i of P A is row permutation[i] of A. Resized by this function.
+*
+* Throws a zero_on_diagonal_exception if A is singular. The overload without pivoting does not check the pivots.
+*/
+template<typename NumericT, typename F>
+void lu_factorize(matrix<NumericT, F> & A, std::vector<vcl_size_t> & permutation)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+  std::vector<vcl_size_t> ipiv(A.size1());
+  if (A.size1() > 0)
+    detail::lu_factorize_recursive(A, &(ipiv[0]));
+
+  permutation.resize(A.size1());
+  for (vcl_size_t i = 0; i < permutation.size(); ++i)
+    permutation[i] = i;
+  for (vcl_size_t k = 0; k < ipiv.size(); ++k)
+    std::swap(permutation[k], permutation[ipiv[k]]);
+}
+
+/** @brief Cholesky factorization A = L L^T of a symmetric positive definite dense matrix.
+*
+* A recursive blocked algorithm is used, casting most of the work into triangular solves and matrix-matrix products.
+* Only the lower triangular part of A is referenced.
+*
+* @param A    The system matrix. On output, holds the lower triangular factor L. The strict upper triangular part is set to zero.
+*/
+template<typename NumericT, typename F>
+void cholesky_factorize(matrix<NumericT, F> & A)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  detail::cholesky_factorize_recursive(A);
 }
 
 
@@ -221,6 +390,67 @@ void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
   inplace_solve(A, vec, upper_tag());
 }
 
+/** @brief LU substitution for the system LU = P rhs, where the LU factorization and the permutation P are obtained from lu_factorize() with pivoting.
+*
+* @param A            The LU factors as computed by lu_factorize()
+* @param permutation  The row permutation as computed by lu_factorize()
+* @param B            The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void lu_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                   std::vector<vcl_size_t> const & permutation,
+                   matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == permutation.size() && bool("Permutation size does not match matrix size"));
+  detail::lu_permute_rows(B, permutation);
+  lu_substitute(A, B);
+}
+
+/** @brief LU substitution for the system LU = P rhs, where the LU factorization and the permutation P are obtained from lu_factorize() with pivoting.
+*
+* @param A            The LU factors as computed by lu_factorize()
+* @param permutation  The row permutation as computed by lu_factorize()
+* @param vec          The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void lu_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                   std::vector<vcl_size_t> const & permutation,
+                   vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == permutation.size() && bool("Permutation size does not match matrix size"));
+  detail::lu_permute_rows(vec, permutation);
+  lu_substitute(A, vec);
+}
+
+/** @brief Cholesky substitution for the system L L^T = rhs.
+*
+* @param A    The Cholesky factor L as computed by cholesky_factorize()
+* @param B    The matrix of load vectors, where the solution is directly written to
+*/
+template<typename NumericT, typename F1, typename F2, unsigned int AlignmentV1, unsigned int AlignmentV2>
+void cholesky_substitute(matrix<NumericT, F1, AlignmentV1> const & A,
+                         matrix<NumericT, F2, AlignmentV2> & B)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  assert(A.size1() == B.size1() && bool("Matrix must be square"));
+  inplace_solve(A, B, lower_tag());
+  inplace_solve(trans(A), B, upper_tag());
+}
+
+/** @brief Cholesky substitution for the system L L^T = rhs.
+*
+* @param A      The Cholesky factor L as computed by cholesky_factorize()
+* @param vec    The load vector, where the solution is directly written to
+*/
+template<typename NumericT, typename F, unsigned int MatAlignmentV, unsigned int VecAlignmentV>
+void cholesky_substitute(matrix<NumericT, F, MatAlignmentV> const & A,
+                         vector<NumericT, VecAlignmentV> & vec)
+{
+  assert(A.size1() == A.size2() && bool("Matrix must be square"));
+  inplace_solve(A, vec, lower_tag());
+  inplace_solve(trans(A), vec, upper_tag());
+}
+
 }
 }
 
@@ -35,6 +35,7 @@
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/matrix_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -56,6 +57,7 @@ namespace viennacl
       assert(viennacl::traits::size1(dest) == viennacl::traits::size1(src) && bool("Incompatible matrix sizes in m1 = m2 (convert): size1(m1) != size1(m2)"));
       assert(viennacl::traits::size2(dest) == viennacl::traits::size2(src) && bool("Incompatible matrix sizes in m1 = m2 (convert): size2(m1) != size2(m2)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::convert", 0, 0);
       switch (viennacl::traits::handle(dest).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -83,6 +85,7 @@ namespace viennacl
     void trans(const matrix_expression<const matrix_base<NumericT, SizeT, DistanceT>,const matrix_base<NumericT, SizeT, DistanceT>, op_trans> & proxy,
               matrix_base<NumericT> & temp_trans)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::trans", 2 * viennacl::tools::profiler_bytes(proxy.lhs()), 0);
       switch (viennacl::traits::handle(proxy).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -111,6 +114,7 @@ namespace viennacl
     void am(matrix_base<NumericT> & mat1,
             matrix_base<NumericT> const & mat2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::am", 2 * viennacl::tools::profiler_bytes(mat1), viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -140,6 +144,7 @@ namespace viennacl
               matrix_base<NumericT> const & mat2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
               matrix_base<NumericT> const & mat3, ScalarType2 const & beta,  vcl_size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::ambm", 3 * viennacl::tools::profiler_bytes(mat1), 3 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -175,6 +180,7 @@ namespace viennacl
                 matrix_base<NumericT> const & mat2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
                 matrix_base<NumericT> const & mat3, ScalarType2 const & beta,  vcl_size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::ambm_m", 4 * viennacl::tools::profiler_bytes(mat1), 4 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -207,6 +213,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_assign(matrix_base<NumericT> & mat, NumericT s, bool clear = false)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::assign", viennacl::tools::profiler_bytes(mat), 0);
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -233,6 +240,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_diagonal_assign(matrix_base<NumericT> & mat, NumericT s)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::diagonal_assign", 0, 0);
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -260,6 +268,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_diag_from_vector(const vector_base<NumericT> & v, int k, matrix_base<NumericT> & A)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::diag_from_vector", 0, 0);
       switch (viennacl::traits::handle(v).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -286,6 +295,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_diag_to_vector(const matrix_base<NumericT> & A, int k, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::diag_to_vector", 0, 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -311,6 +321,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_row(const matrix_base<NumericT> & A, unsigned int i, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::row", 0, 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -336,6 +347,7 @@ namespace viennacl
     template<typename NumericT>
     void matrix_column(const matrix_base<NumericT> & A, unsigned int j, vector_base<NumericT> & v)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::column", 0, 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -442,6 +454,7 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat) == viennacl::traits::size(result)) && bool("Size check failed at v1 = prod(A, v2): size1(A) != size(v1)"));
       assert( (viennacl::traits::size2(mat) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = prod(A, v2): size2(A) != size(v2)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemv)", viennacl::tools::profiler_bytes(mat) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::traits::size1(mat) * viennacl::traits::size2(mat));
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -483,6 +496,7 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat_trans.lhs()) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = trans(A) * v2: size1(A) != size(v2)"));
       assert( (viennacl::traits::size2(mat_trans.lhs()) == viennacl::traits::size(result)) && bool("Size check failed at v1 = trans(A) * v2: size2(A) != size(v1)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemv, trans)", viennacl::tools::profiler_bytes(mat_trans) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::traits::size1(mat_trans.lhs()) * viennacl::traits::size2(mat_trans.lhs()));
       switch (viennacl::traits::handle(mat_trans.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -527,6 +541,7 @@ namespace viennacl
       assert( (viennacl::traits::size2(B) == viennacl::traits::size2(C)) && bool("Size check failed at C = prod(A, B): size2(B) != size2(C)"));
 
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemm)", viennacl::tools::profiler_bytes(A) + viennacl::tools::profiler_bytes(B) + 2 * viennacl::tools::profiler_bytes(C), 2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -569,6 +584,7 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size1(B) && bool("Size check failed at C = prod(trans(A), B): size1(A) != size1(B)"));
       assert(viennacl::traits::size2(B)       == viennacl::traits::size2(C) && bool("Size check failed at C = prod(trans(A), B): size2(B) != size2(C)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemm)", viennacl::tools::profiler_bytes(A) + viennacl::tools::profiler_bytes(B) + 2 * viennacl::tools::profiler_bytes(C), 2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -610,6 +626,7 @@ namespace viennacl
       assert(viennacl::traits::size2(A)       == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(A, trans(B)): size2(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(A, trans(B)): size1(B) != size2(C)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemm)", viennacl::tools::profiler_bytes(A) + viennacl::tools::profiler_bytes(B) + 2 * viennacl::tools::profiler_bytes(C), 2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -650,6 +667,7 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(trans(A), trans(B)): size1(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(trans(A), trans(B)): size1(B) != size2(C)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::prod (gemm)", viennacl::tools::profiler_bytes(A) + viennacl::tools::profiler_bytes(B) + 2 * viennacl::tools::profiler_bytes(C), 2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -705,6 +723,7 @@ namespace viennacl
       assert( (viennacl::traits::size1(A) == viennacl::traits::size1(proxy)) && bool("Size check failed at A = element_op(B): size1(A) != size1(B)"));
       assert( (viennacl::traits::size2(A) == viennacl::traits::size2(proxy)) && bool("Size check failed at A = element_op(B): size2(A) != size2(B)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::element_op", 3 * viennacl::tools::profiler_bytes(A), viennacl::traits::size1(A) * viennacl::traits::size2(A));
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -739,6 +758,7 @@ namespace viennacl
       assert( (viennacl::traits::size1(A) == viennacl::traits::size1(proxy)) && bool("Size check failed at A = element_op(B): size1(A) != size1(B)"));
       assert( (viennacl::traits::size2(A) == viennacl::traits::size2(proxy)) && bool("Size check failed at A = element_op(B): size2(A) != size2(B)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::element_op", 2 * viennacl::tools::profiler_bytes(A), viennacl::traits::size1(A) * viennacl::traits::size2(A));
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -773,6 +793,7 @@ namespace viennacl
       assert( (viennacl::traits::size1(A) == viennacl::traits::size1(proxy)) && bool("Size check failed at A = element_op(B): size1(A) != size1(B)"));
       assert( (viennacl::traits::size2(A) == viennacl::traits::size2(proxy)) && bool("Size check failed at A = element_op(B): size2(A) != size2(B)"));
 
+      VIENNACL_PROFILE_SCOPE("matrix::element_op", 3 * viennacl::tools::profiler_bytes(A), viennacl::traits::size1(A) * viennacl::traits::size2(A));
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -978,6 +999,7 @@ namespace viennacl
                               const vector_base<NumericT> & vec1,
                               const vector_base<NumericT> & vec2)
     {
+      VIENNACL_PROFILE_SCOPE("matrix::scaled_rank_1_update", 2 * viennacl::tools::profiler_bytes(mat1) + viennacl::tools::profiler_bytes(vec1) + viennacl::tools::profiler_bytes(vec2), 2 * viennacl::traits::size1(mat1) * viennacl::traits::size2(mat1));
       switch (viennacl::traits::handle(mat1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1020,6 +1042,7 @@ namespace viennacl
                      VectorType & sh
                     )
     {
+      VIENNACL_PROFILE_SCOPE("matrix::bidiag_pack", 0, 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1063,6 +1086,7 @@ namespace viennacl
                   bool copy_col
     )
     {
+      VIENNACL_PROFILE_SCOPE("matrix::copy_vec", 0, 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1099,6 +1123,7 @@ namespace viennacl
                            vector_base<NumericT>    & D,
                            vcl_size_t start)
   {
+    VIENNACL_PROFILE_SCOPE("matrix::house_update_A_left", 0, 0);
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
@@ -1135,6 +1160,7 @@ namespace viennacl
   void house_update_A_right(matrix_base<NumericT>& A,
                             vector_base<NumericT>   & D)
   {
+    VIENNACL_PROFILE_SCOPE("matrix::house_update_A_right", 0, 0);
     switch (viennacl::traits::handle(A).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
@@ -1171,6 +1197,7 @@ namespace viennacl
                        vector_base<NumericT>    & D,
                        vcl_size_t A_size1)
   {
+    VIENNACL_PROFILE_SCOPE("matrix::house_update_QL", 0, 0);
     switch (viennacl::traits::handle(Q).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
@@ -1213,6 +1240,7 @@ namespace viennacl
                    int m
                 )
   {
+    VIENNACL_PROFILE_SCOPE("matrix::givens_next", 0, 0);
     switch (viennacl::traits::handle(Q).get_active_handle_id())
     {
       case viennacl::MAIN_MEMORY:
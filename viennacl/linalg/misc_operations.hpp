@@ -27,6 +27,7 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/misc_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -59,6 +60,7 @@ namespace viennacl
         assert( viennacl::traits::handle(vec).get_active_handle_id() ==      col_buffer.get_active_handle_id() && bool("Incompatible memory domains"));
         assert( viennacl::traits::handle(vec).get_active_handle_id() ==  element_buffer.get_active_handle_id() && bool("Incompatible memory domains"));
 
+        VIENNACL_PROFILE_SCOPE("misc::level_scheduling_substitute", 0, 0);
         switch (viennacl::traits::handle(vec).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
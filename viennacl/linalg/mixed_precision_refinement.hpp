@@ -0,0 +1,245 @@
+#ifndef VIENNACL_LINALG_MIXED_PRECISION_REFINEMENT_HPP_
+#define VIENNACL_LINALG_MIXED_PRECISION_REFINEMENT_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/mixed_precision_refinement.hpp
+    @brief Mixed precision iterative refinement: Runs any of the iterative solvers on a low precision copy of the system matrix and computes the corrections in high precision.
+*/
+
+#include <cmath>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/traits/context.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the mixed precision iterative refinement. Used for supplying solver parameters and for dispatching the solve() function
+*
+* @tparam InnerTagT   Tag of the solver used for the low precision correction equations, e.g. gmres_tag, bicgstab_tag or cg_tag
+*/
+template<typename InnerTagT>
+class mixed_precision_refinement_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param inner_tag        Tag of the inner solver. Its tolerance is relative to the current residual, hence a moderate value such as 1e-3 is usually best.
+  * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
+  * @param max_refinements  The maximum number of refinement steps (i.e. inner solver runs)
+  * @param stall_ratio      Refinement is considered stalled if a step reduces the residual norm by less than this factor.
+  *                         In that case the inner solver is run on the high precision matrix (with the low precision preconditioner) for the remaining steps.
+  */
+  mixed_precision_refinement_tag(InnerTagT const & inner_tag, double tol = 1e-10, unsigned int max_refinements = 50, double stall_ratio = 0.5)
+    : inner_tag_(inner_tag), tol_(tol), max_refinements_(max_refinements), stall_ratio_(stall_ratio), iters_taken_(0), refinements_taken_(0), last_error_(0), fallback_used_(false) {}
+
+  /** @brief Returns the tag of the inner solver */
+  InnerTagT const & inner_tag() const { return inner_tag_; }
+  /** @brief Returns the relative tolerance */
+  double tolerance() const { return tol_; }
+  /** @brief Returns the maximum number of refinement steps */
+  unsigned int max_refinements() const { return max_refinements_; }
+  /** @brief Returns the minimum residual reduction per refinement step below which the low precision correction is considered stalled */
+  double stall_ratio() const { return stall_ratio_; }
+
+  /** @brief Returns the total number of iterations of the inner solver */
+  unsigned int iters() const { return iters_taken_; }
+  /** @brief Sets the total number of iterations of the inner solver (should only be modified by the solver) */
+  void iters(unsigned int i) const { iters_taken_ = i; }
+
+  /** @brief Returns the number of refinement steps */
+  unsigned int refinements() const { return refinements_taken_; }
+  /** @brief Sets the number of refinement steps (should only be modified by the solver) */
+  void refinements(unsigned int i) const { refinements_taken_ = i; }
+
+  /** @brief Returns the relative residual at the end of the solver run */
+  double error() const { return last_error_; }
+  /** @brief Sets the relative residual at the end of the solver run */
+  void error(double e) const { last_error_ = e; }
+
+  /** @brief Returns true if refinement stalled and the inner solver was switched to the high precision matrix */
+  bool fallback_used() const { return fallback_used_; }
+  /** @brief Sets the fallback flag (should only be modified by the solver) */
+  void fallback_used(bool b) const { fallback_used_ = b; }
+
+private:
+  InnerTagT inner_tag_;
+  double tol_;
+  unsigned int max_refinements_;
+  double stall_ratio_;
+
+  //return values from solver
+  mutable unsigned int iters_taken_;
+  mutable unsigned int refinements_taken_;
+  mutable double last_error_;
+  mutable bool fallback_used_;
+};
+
+
+namespace detail
+{
+  /** @brief Applies a preconditioner set up for a low precision matrix to a high precision vector. Used for the high precision fallback of the iterative refinement. */
+  template<typename PreconditionerT, typename LowNumericT>
+  class mixed_precision_precond_adapter
+  {
+  public:
+    mixed_precision_precond_adapter(PreconditionerT const & precond, viennacl::context ctx) : precond_(precond), ctx_(ctx) {}
+
+    template<typename VectorT>
+    void apply(VectorT & vec) const
+    {
+      if (low_precision_vec_.size() != vec.size())
+        low_precision_vec_ = viennacl::vector<LowNumericT>(vec.size(), ctx_);
+      low_precision_vec_ = vec;
+      precond_.apply(low_precision_vec_);
+      vec = low_precision_vec_;
+    }
+
+  private:
+    PreconditionerT const & precond_;
+    viennacl::context ctx_;
+    mutable viennacl::vector<LowNumericT> low_precision_vec_;
+  };
+
+  /** @brief No conversions needed without preconditioner */
+  template<typename LowNumericT>
+  class mixed_precision_precond_adapter<viennacl::linalg::no_precond, LowNumericT>
+  {
+  public:
+    mixed_precision_precond_adapter(viennacl::linalg::no_precond const &, viennacl::context) {}
+
+    template<typename VectorT>
+    void apply(VectorT &) const {}
+  };
+}
+
+
+/** @brief Implementation of the mixed precision iterative refinement.
+*
+* Each refinement step solves the correction equation A_low d = r / ||r|| with the inner solver in low precision, where the residual r = b - A x and the update x += ||r|| d are computed in high precision.
+* The inner solves only need half the memory bandwidth, while the final accuracy is that of the high precision residual.
+* If a refinement step reduces the residual by less than tag.stall_ratio() (e.g. because the matrix is too ill-conditioned for the low precision),
+* the remaining correction equations are solved with the high precision matrix, still using the low precision preconditioner.
+*
+* @param A            The system matrix in high precision
+* @param rhs          The load vector
+* @param tag          Solver configuration tag, holding the tag of the inner solver
+* @param A_low        Low precision copy of the system matrix, cf. the converting constructor of compressed_matrix
+* @param precond      Preconditioner set up for A_low. Precondition operation is done via member function apply()
+* @return The result vector
+*/
+template<typename HighNumericT, typename LowNumericT, unsigned int AlignmentV, typename InnerTagT, typename PreconditionerT>
+viennacl::vector<HighNumericT> solve(viennacl::compressed_matrix<HighNumericT, AlignmentV> const & A,
+                                     viennacl::vector<HighNumericT> const & rhs,
+                                     mixed_precision_refinement_tag<InnerTagT> const & tag,
+                                     viennacl::compressed_matrix<LowNumericT, AlignmentV> const & A_low,
+                                     PreconditionerT const & precond)
+{
+  viennacl::context ctx = viennacl::traits::context(rhs);
+  viennacl::vector<HighNumericT> result = viennacl::zero_vector<HighNumericT>(rhs.size(), ctx);
+  viennacl::vector<HighNumericT> residual = rhs;
+  viennacl::vector<HighNumericT> correction(rhs.size(), ctx);
+  viennacl::vector<LowNumericT>  residual_low_precision(rhs.size(), ctx);
+  viennacl::vector<LowNumericT>  correction_low_precision(rhs.size(), ctx);
+
+  detail::mixed_precision_precond_adapter<PreconditionerT, LowNumericT> fallback_precond(precond, ctx);
+
+  tag.iters(0);
+  tag.refinements(0);
+  tag.error(0);
+  tag.fallback_used(false);
+
+  HighNumericT norm_rhs = viennacl::linalg::norm_2(rhs);
+  if (norm_rhs <= 0) //solution is zero if RHS norm is zero
+    return result;
+
+  HighNumericT norm_residual = norm_rhs;
+  for (unsigned int i = 0; i < tag.max_refinements(); ++i)
+  {
+    if (tag.fallback_used())
+    {
+      // high precision correction equation with low precision preconditioner:
+      correction = residual / norm_residual;
+      correction = viennacl::linalg::solve(A, correction, tag.inner_tag(), fallback_precond);
+    }
+    else
+    {
+      // scale to unit norm, so that the residual is representable in low precision even if it is tiny:
+      residual_low_precision = residual;
+      residual_low_precision /= static_cast<LowNumericT>(norm_residual);
+      correction_low_precision = viennacl::linalg::solve(A_low, residual_low_precision, tag.inner_tag(), precond);
+      correction = correction_low_precision;
+    }
+    tag.iters(tag.iters() + tag.inner_tag().iters());
+    tag.refinements(i + 1);
+
+    result += norm_residual * correction;
+
+    // residual = b - Ax  (without introducing a temporary)
+    residual = viennacl::linalg::prod(A, result);
+    residual = rhs - residual;
+
+    HighNumericT new_norm_residual = viennacl::linalg::norm_2(residual);
+    if (new_norm_residual / norm_rhs < tag.tolerance())
+    {
+      tag.error(new_norm_residual / norm_rhs);
+      break;
+    }
+
+    if (!(new_norm_residual < norm_residual)) // correction made things worse: revert and switch to high precision (or give up if already there)
+    {
+      result -= norm_residual * correction;
+      residual = viennacl::linalg::prod(A, result);
+      residual = rhs - residual;
+      tag.error(norm_residual / norm_rhs);
+      if (tag.fallback_used())
+        break;
+      tag.fallback_used(true);
+      continue;
+    }
+
+    tag.error(new_norm_residual / norm_rhs);
+    if (!(new_norm_residual < tag.stall_ratio() * norm_residual))
+      tag.fallback_used(true);
+
+    norm_residual = new_norm_residual;
+  }
+
+  return result;
+}
+
+/** @brief Convenience overload for the mixed precision iterative refinement without preconditioner. The single precision copy of the system matrix is created internally. */
+template<typename HighNumericT, unsigned int AlignmentV, typename InnerTagT>
+viennacl::vector<HighNumericT> solve(viennacl::compressed_matrix<HighNumericT, AlignmentV> const & A,
+                                     viennacl::vector<HighNumericT> const & rhs,
+                                     mixed_precision_refinement_tag<InnerTagT> const & tag)
+{
+  viennacl::compressed_matrix<float, AlignmentV> A_low(A);
+  return viennacl::linalg::solve(A, rhs, tag, A_low, viennacl::linalg::no_precond());
+}
+
+}
+}
+
+#endif
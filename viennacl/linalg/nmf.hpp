@@ -24,11 +24,17 @@
 
  */
 
+#include <vector>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/ilu_operations.hpp"
+#include "viennacl/linalg/random_operations.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 #include "viennacl/linalg/host_based/nmf_operations.hpp"
 
@@ -46,6 +52,174 @@ namespace viennacl
   namespace linalg
   {
 
+    namespace detail
+    {
+      /** @brief HALS update of the factor X for fixed products B and Gram matrix G, see viennacl::linalg::host_based::nmf_hals_update() */
+      template<typename NumericT>
+      void nmf_hals_update(viennacl::matrix_base<NumericT> & X, viennacl::matrix_base<NumericT> const & B, viennacl::matrix_base<NumericT> const & G)
+      {
+        switch (viennacl::traits::handle(X).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::nmf_hals_update(X, B, G);
+            break;
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+
+      /** @brief Products of a dense data matrix and its transpose with the factors */
+      template<typename NumericT>
+      class nmf_dense_data
+      {
+      public:
+        nmf_dense_data(viennacl::matrix_base<NumericT> const & V) : V_(V) {}
+
+        NumericT squared_norm() const
+        {
+          NumericT norm = viennacl::linalg::norm_frobenius(V_);
+          return norm * norm;
+        }
+
+        /** @brief Computes Y = V * X */
+        void apply(viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(V_, X); }
+        /** @brief Computes Y = V^T * X */
+        void apply_trans(viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(trans(V_), X); }
+
+      private:
+        viennacl::matrix_base<NumericT> const & V_;
+      };
+
+      /** @brief Products of a sparse data matrix and its transpose with the factors. The transpose is set up once, so that both products are row-wise. */
+      template<typename NumericT>
+      class nmf_sparse_data
+      {
+      public:
+        nmf_sparse_data(viennacl::compressed_matrix<NumericT> const & V) : V_(V), Vt_(V.size2(), V.size1(), V.nnz(), viennacl::traits::context(V))
+        {
+          viennacl::linalg::ilu_transpose(V, Vt_);
+        }
+
+        NumericT squared_norm() const
+        {
+          typedef typename viennacl::compressed_matrix<NumericT>::handle_type  HandleType;
+          viennacl::vector_base<NumericT> values(const_cast<HandleType &>(V_.handle()), V_.nnz(), 0, 1);
+          NumericT norm = viennacl::linalg::norm_2(values);
+          return norm * norm;
+        }
+
+        void apply(viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(V_, X); }
+        void apply_trans(viennacl::matrix_base<NumericT> const & X, viennacl::matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(Vt_, X); }
+
+      private:
+        viennacl::compressed_matrix<NumericT> const & V_;
+        viennacl::compressed_matrix<NumericT> Vt_;
+      };
+
+      /** @brief Nonnegative matrix factorization by hierarchical alternating least squares (Cichocki and Phan, 2009).
+       *
+       * Each iteration needs one product of V and one of V^T with a factor, and the two k x k Gram matrices of the factors.
+       * The residual is evaluated from these quantities via ||V - W H||^2 = ||V||^2 - 2 <W, V H^T> + <W^T W, H H^T>, so no reconstruction W * H is formed.
+       */
+      template<typename DataT, typename NumericT>
+      void nmf_hals(DataT const & V, viennacl::matrix_base<NumericT> & W, viennacl::matrix_base<NumericT> & H, viennacl::linalg::nmf_config const & conf)
+      {
+        vcl_size_t m = W.size1();
+        vcl_size_t k = W.size2();
+        vcl_size_t n = H.size2();
+        viennacl::context ctx = viennacl::traits::context(W);
+        conf.iters_ = 0;
+
+        // all-equal initial factors are a fixed point of the column-wise updates, hence initialize randomly
+        if (viennacl::linalg::norm_frobenius(W) <= 0)
+          viennacl::linalg::fill_random(W, viennacl::tools::uniform_distribution(), 0);
+        if (viennacl::linalg::norm_frobenius(H) <= 0)
+          viennacl::linalg::fill_random(H, viennacl::tools::uniform_distribution(), 1);
+
+        // H is updated as its transpose, so that both factors are updated row by row:
+        viennacl::matrix<NumericT> W_rows(m, k, ctx);
+        viennacl::matrix<NumericT> Ht(n, k, ctx);
+        W_rows = W;
+        Ht = trans(H);
+
+        viennacl::matrix<NumericT> VHt(m, k, ctx);   // V * H^T
+        viennacl::matrix<NumericT> VtW(n, k, ctx);   // V^T * W
+        viennacl::matrix<NumericT> WtW(k, k, ctx);
+        viennacl::matrix<NumericT> HHt(k, k, ctx);
+        viennacl::matrix<NumericT> cross(k, k, ctx);
+        std::vector<std::vector<NumericT> > WtW_host(k, std::vector<NumericT>(k));
+        std::vector<std::vector<NumericT> > HHt_host(k, std::vector<NumericT>(k));
+        std::vector<std::vector<NumericT> > cross_host(k, std::vector<NumericT>(k));
+
+        NumericT V_norm2 = V.squared_norm();
+
+        NumericT last_diff = 0;
+        NumericT diff_init = 0;
+        bool stagnation_flag = false;
+
+        WtW = viennacl::linalg::prod(trans(W_rows), W_rows);
+        for (vcl_size_t i = 0; i < conf.max_iterations(); i++)
+        {
+          conf.iters_ = i + 1;
+
+          V.apply_trans(W_rows, VtW);
+          nmf_hals_update(Ht, VtW, WtW);
+
+          HHt = viennacl::linalg::prod(trans(Ht), Ht);
+          V.apply(Ht, VHt);
+          nmf_hals_update(W_rows, VHt, HHt);
+
+          WtW = viennacl::linalg::prod(trans(W_rows), W_rows);
+
+          if (i % conf.check_after_steps() == 0)  //check for convergence
+          {
+            cross = viennacl::linalg::prod(trans(W_rows), VHt);
+            viennacl::copy(WtW, WtW_host);
+            viennacl::copy(HHt, HHt_host);
+            viennacl::copy(cross, cross_host);
+
+            double diff_squared = static_cast<double>(V_norm2);
+            for (vcl_size_t r = 0; r < k; ++r)
+            {
+              diff_squared -= 2.0 * static_cast<double>(cross_host[r][r]);
+              for (vcl_size_t s = 0; s < k; ++s)
+                diff_squared += static_cast<double>(WtW_host[r][s]) * static_cast<double>(HHt_host[r][s]);
+            }
+            NumericT diff_val = static_cast<NumericT>(std::sqrt(std::max(diff_squared, 0.0)));
+
+            if (i == 0)
+              diff_init = diff_val;
+
+            if (conf.print_relative_error())
+              std::cout << diff_val / diff_init << std::endl;
+
+            // Approximation check
+            if (diff_val <= 0 || diff_val / diff_init < conf.tolerance())
+              break;
+
+            // Stagnation check
+            if (std::fabs(diff_val - last_diff) / (diff_val * NumericT(conf.check_after_steps())) < conf.stagnation_tolerance()) //avoid situations where convergence stagnates
+            {
+              if (stagnation_flag)    // iteration stagnates (two iterates with no notable progress)
+                break;
+              else                    // record stagnation in this iteration
+                stagnation_flag = true;
+            }
+            else                      // good progress in this iteration, so unset stagnation flag
+              stagnation_flag = false;
+
+            // prepare for next iterate:
+            last_diff = diff_val;
+          }
+        }
+
+        W = W_rows;
+        H = trans(Ht);
+      }
+    }
+
     /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
      *
      * @param V     Input matrix
@@ -60,6 +234,13 @@ namespace viennacl
       assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
       assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
 
+      VIENNACL_PROFILE_SCOPE("nmf", 0, 0);
+      if (conf.method() == viennacl::linalg::NMF_HALS)
+      {
+        detail::nmf_hals(detail::nmf_dense_data<ScalarType>(V), W, H, conf);
+        return;
+      }
+
       switch (viennacl::traits::handle(V).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -85,6 +266,27 @@ namespace viennacl
       }
 
     }
+
+    /** @brief Nonnegative matrix factorization of a sparse matrix V with nonnegative entries into dense factors W and H such that ||V - W*H|| is minimized.
+     *
+     * Uses hierarchical alternating least squares (HALS) irrespective of conf.method(), so that V is never densified:
+     * Each iteration consists of one sparse matrix-dense matrix product with V and one with its transpose, which is set up once.
+     *
+     * @param V     Input matrix
+     * @param W     First factor
+     * @param H     Second factor
+     * @param conf  A configuration object holding tolerances and the like
+     */
+    template<typename ScalarType>
+    void nmf(viennacl::compressed_matrix<ScalarType> const & V, viennacl::matrix_base<ScalarType> & W,
+        viennacl::matrix_base<ScalarType> & H, viennacl::linalg::nmf_config const & conf)
+    {
+      assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
+      assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
+
+      VIENNACL_PROFILE_SCOPE("nmf", 0, 0);
+      detail::nmf_hals(detail::nmf_sparse_data<ScalarType>(V), W, H, conf);
+    }
   }
 }
 
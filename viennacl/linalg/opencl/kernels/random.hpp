@@ -0,0 +1,163 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/random.hpp
+ *  @brief OpenCL kernel file for the generation of random vectors and matrices using Philox4x32-10. Must match viennacl/tools/random.hpp. */
+namespace viennacl
+{
+namespace linalg
+{
+namespace opencl
+{
+namespace kernels
+{
+
+template<typename StringT>
+void generate_random_philox(StringT & source)
+{
+  source.append("uint4 philox4x32_10(uint4 ctr, uint2 key) \n");
+  source.append("{ \n");
+  source.append("  for (uint round = 0; round < 10; ++round) \n");
+  source.append("  { \n");
+  source.append("    uint hi0 = mul_hi(0xD2511F53u, ctr.x); \n");
+  source.append("    uint lo0 = 0xD2511F53u * ctr.x; \n");
+  source.append("    uint hi1 = mul_hi(0xCD9E8D57u, ctr.z); \n");
+  source.append("    uint lo1 = 0xCD9E8D57u * ctr.z; \n");
+  source.append("    ctr = (uint4)(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0); \n");
+  source.append("    key.x += 0x9E3779B9u; \n");
+  source.append("    key.y += 0xBB67AE85u; \n");
+  source.append("  } \n");
+  source.append("  return ctr; \n");
+  source.append("} \n");
+}
+
+template<typename StringT>
+void generate_random_fill(StringT & source, std::string const & numeric_string)
+{
+  bool is_float = (numeric_string == "float");
+
+  source.append("__kernel void fill_random( \n");
+  source.append("  __global "); source.append(numeric_string); source.append(" * A, \n");
+  source.append("  unsigned int A_start1, unsigned int A_start2, \n");
+  source.append("  unsigned int A_inc1,   unsigned int A_inc2, \n");
+  source.append("  unsigned int A_size1,  unsigned int A_size2, \n");
+  source.append("  unsigned int A_internal_size1, unsigned int A_internal_size2, \n");
+  source.append("  unsigned int row_major, \n");
+  source.append("  unsigned int seed_lo, unsigned int seed_hi, \n");
+  source.append("  unsigned int normal_distribution, \n");
+  source.append("  "); source.append(numeric_string); source.append(" p1, \n");
+  source.append("  "); source.append(numeric_string); source.append(" p2) \n");
+  source.append("{ \n");
+  source.append("  unsigned int lanes = "); source.append(is_float ? "4" : "2"); source.append("; \n");
+  source.append("  unsigned int size = A_size1 * A_size2; \n");
+  source.append("  unsigned int num_blocks = (size + lanes - 1) / lanes; \n");
+  source.append("  for (unsigned int block = get_global_id(0); block < num_blocks; block += get_global_size(0)) \n");
+  source.append("  { \n");
+  source.append("    uint4 w = philox4x32_10((uint4)(block, 0, 0, 0), (uint2)(seed_lo, seed_hi)); \n");
+  source.append("    "); source.append(numeric_string); source.append(" u[4]; \n");
+  if (is_float)
+  {
+    source.append("    u[0] = (float)(w.x >> 8) * (1.0f / 16777216.0f); \n");
+    source.append("    u[1] = (float)(w.y >> 8) * (1.0f / 16777216.0f); \n");
+    source.append("    u[2] = (float)(w.z >> 8) * (1.0f / 16777216.0f); \n");
+    source.append("    u[3] = (float)(w.w >> 8) * (1.0f / 16777216.0f); \n");
+  }
+  else
+  {
+    source.append("    u[0] = ((double)(w.x >> 5) * 67108864.0 + (double)(w.y >> 6)) * (1.0 / 9007199254740992.0); \n");
+    source.append("    u[1] = ((double)(w.z >> 5) * 67108864.0 + (double)(w.w >> 6)) * (1.0 / 9007199254740992.0); \n");
+  }
+  source.append("    "); source.append(numeric_string); source.append(" values[4]; \n");
+  source.append("    for (unsigned int lane = 0; lane < lanes; lane += 2) \n");
+  source.append("    { \n");
+  source.append("      if (normal_distribution) \n");
+  source.append("      { \n");
+  source.append("        "); source.append(numeric_string); source.append(" r = sqrt(-2 * log(1 - u[lane])); \n");
+  source.append("        "); source.append(numeric_string); source.append(" angle = ("); source.append(numeric_string); source.append(")6.28318530717958647692 * u[lane + 1]; \n");
+  source.append("        values[lane]     = p1 + p2 * r * cos(angle); \n");
+  source.append("        values[lane + 1] = p1 + p2 * r * sin(angle); \n");
+  source.append("      } \n");
+  source.append("      else \n");
+  source.append("      { \n");
+  source.append("        values[lane]     = p1 + (p2 - p1) * u[lane]; \n");
+  source.append("        values[lane + 1] = p1 + (p2 - p1) * u[lane + 1]; \n");
+  source.append("      } \n");
+  source.append("    } \n");
+  source.append("    unsigned int index = block * lanes; \n");
+  source.append("    for (unsigned int lane = 0; lane < lanes && index < size; ++lane, ++index) \n");
+  source.append("    { \n");
+  source.append("      unsigned int row = A_start1 + (index / A_size2) * A_inc1; \n");
+  source.append("      unsigned int col = A_start2 + (index % A_size2) * A_inc2; \n");
+  source.append("      A[row_major ? row * A_internal_size2 + col : row + col * A_internal_size1] = values[lane]; \n");
+  source.append("    } \n");
+  source.append("  } \n");
+  source.append("} \n");
+}
+
+// main kernel class
+/** @brief Main kernel class for generating OpenCL kernels for filling vectors and matrices with random numbers. */
+template<typename NumericT>
+struct random
+{
+  static std::string program_name()
+  {
+    return viennacl::ocl::type_to_string<NumericT>::apply() + "_random";
+  }
+
+  static void init(viennacl::ocl::context & ctx)
+  {
+    static std::map<cl_context, bool> init_done;
+    if (!init_done[ctx.handle().get()])
+    {
+      viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+      std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+      std::string source;
+      source.reserve(8192);
+
+      viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+      // only generate for floating points (forces error for integers)
+      if (numeric_string == "float" || numeric_string == "double")
+      {
+        generate_random_philox(source);
+        generate_random_fill(source, numeric_string);
+      }
+
+      std::string prog_name = program_name();
+      #ifdef VIENNACL_BUILD_INFO
+      std::cout << "Creating program " << prog_name << std::endl;
+      #endif
+      ctx.add_program(source, prog_name);
+      init_done[ctx.handle().get()] = true;
+    } //if
+  } //init
+};
+
+}  // namespace kernels
+}  // namespace opencl
+}  // namespace linalg
+}  // namespace viennacl
+#endif
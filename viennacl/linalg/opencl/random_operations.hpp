@@ -0,0 +1,103 @@
+#ifndef VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/random_operations.hpp
+    @brief Implementations of the generation of random vectors and matrices using OpenCL
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/tools/random.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/opencl/kernels/random.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+namespace opencl
+{
+namespace detail
+{
+  template<typename NumericT>
+  void fill_random(viennacl::ocl::handle<cl_mem> const & data,
+                   viennacl::ocl::context & ctx,
+                   vcl_size_t start1, vcl_size_t start2,
+                   vcl_size_t inc1,   vcl_size_t inc2,
+                   vcl_size_t size1,  vcl_size_t size2,
+                   vcl_size_t internal_size1, vcl_size_t internal_size2, bool row_major,
+                   viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+  {
+    viennacl::linalg::opencl::kernels::random<NumericT>::init(ctx);
+    viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::random<NumericT>::program_name(), "fill_random");
+
+    vcl_size_t lanes = viennacl::tools::detail::random_values_per_block<NumericT>::value;
+    k.global_work_size(0, std::min<vcl_size_t>(128 * k.local_work_size(),
+                                                viennacl::tools::align_to_multiple<vcl_size_t>((size1 * size2 + lanes - 1) / lanes, k.local_work_size()) ) );
+
+    viennacl::ocl::enqueue(k(data,
+                             cl_uint(start1), cl_uint(start2),
+                             cl_uint(inc1),   cl_uint(inc2),
+                             cl_uint(size1),  cl_uint(size2),
+                             cl_uint(internal_size1), cl_uint(internal_size2),
+                             cl_uint(row_major ? 1 : 0),
+                             cl_uint(seed), cl_uint((seed >> 16) >> 16),
+                             cl_uint(dist.type() == viennacl::tools::RANDOM_NORMAL_DISTRIBUTION ? 1 : 0),
+                             NumericT(dist.param1()), NumericT(dist.param2())));
+  }
+}
+
+/** @brief Fills a vector with random numbers drawn from the given distribution. See viennacl::linalg::fill_random() for details. */
+template<typename NumericT>
+void fill_random(vector_base<NumericT> & x, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(x).context());
+
+  detail::fill_random<NumericT>(x.handle().opencl_handle(), ctx,
+                                viennacl::traits::start(x), 0, viennacl::traits::stride(x), 1,
+                                viennacl::traits::size(x), 1, x.internal_size(), 1, true,
+                                dist, seed);
+}
+
+/** @brief Fills a dense matrix with random numbers drawn from the given distribution. See viennacl::linalg::fill_random() for details. */
+template<typename NumericT>
+void fill_random(matrix_base<NumericT> & A, viennacl::tools::random_distribution const & dist, vcl_size_t seed)
+{
+  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+
+  detail::fill_random<NumericT>(A.handle().opencl_handle(), ctx,
+                                viennacl::traits::start1(A), viennacl::traits::start2(A),
+                                viennacl::traits::stride1(A), viennacl::traits::stride2(A),
+                                viennacl::traits::size1(A), viennacl::traits::size2(A),
+                                viennacl::traits::internal_size1(A), viennacl::traits::internal_size2(A), A.row_major(),
+                                dist, seed);
+}
+
+} // namespace opencl
+} //namespace linalg
+} //namespace viennacl
+
+
+#endif
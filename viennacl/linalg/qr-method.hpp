@@ -22,6 +22,7 @@
 #include "viennacl/matrix.hpp"
 
 #include "viennacl/linalg/qr-method-common.hpp"
+#include "viennacl/linalg/detail/hessenberg_qr.hpp"
 #include "viennacl/linalg/tql2.hpp"
 #include "viennacl/linalg/prod.hpp"
 
@@ -124,114 +125,31 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
 #endif
 }
 
-    template<typename SCALARTYPE, typename MatrixT>
-    void final_iter_update(MatrixT& A,
-                            int n,
-                            int last_n,
-                            SCALARTYPE q,
-                            SCALARTYPE p
-                            )
-    {
-        for (int i = 0; i < last_n; i++)
-        {
-            SCALARTYPE v_in = A(i, n);
-            SCALARTYPE z = A(i, n - 1);
-            A(i, n - 1) = q * z + p * v_in;
-            A(i, n) = q * v_in - p * z;
-        }
-    }
-
-    template<typename SCALARTYPE, typename MatrixT>
-    void update_float_QR_column(MatrixT& A,
-                            const std::vector<SCALARTYPE>& buf,
-                            int m,
-                            int n,
-                            int last_i,
-                            bool is_triangular
-                            )
-    {
-        for (int i = 0; i < last_i; i++)
-        {
-            int start_k = is_triangular?std::max(i + 1, m):m;
-
-            SCALARTYPE* a_row = A.row(i);
-
-            SCALARTYPE a_ik   = a_row[start_k];
-            SCALARTYPE a_ik_1 = 0;
-            SCALARTYPE a_ik_2 = 0;
-
-            if (start_k < n)
-                a_ik_1 = a_row[start_k + 1];
-
-            for (int k = start_k; k < n; k++)
-            {
-                bool notlast = (k != n - 1);
-
-                SCALARTYPE p = buf[5 * static_cast<vcl_size_t>(k)] * a_ik + buf[5 * static_cast<vcl_size_t>(k) + 1] * a_ik_1;
-
-                if (notlast)
-                {
-                    a_ik_2 = a_row[k + 2];
-                    p = p + buf[5 * static_cast<vcl_size_t>(k) + 2] * a_ik_2;
-                    a_ik_2 = a_ik_2 - p * buf[5 * static_cast<vcl_size_t>(k) + 4];
-                }
-
-                a_row[k] = a_ik - p;
-                a_ik_1 = a_ik_1 - p * buf[5 * static_cast<vcl_size_t>(k) + 3];
-
-                a_ik = a_ik_1;
-                a_ik_1 = a_ik_2;
-            }
-
-            if (start_k < n)
-                a_row[n] = a_ik;
-        }
-    }
-
-    /** @brief Internal helper class representing a row-major dense matrix used for the QR method for the purpose of computing eigenvalues. */
+    /** @brief Schur vector policy for hqr_schur_form() which applies the transformations to V on the device. */
     template<typename SCALARTYPE>
-    class FastMatrix
+    struct hqr2_schur_vectors
     {
-    public:
-        FastMatrix()
-        {
-            size_ = 0;
-        }
-
-        FastMatrix(vcl_size_t sz, vcl_size_t internal_size) : size_(sz), internal_size_(internal_size)
-        {
-            data.resize(internal_size * internal_size);
-        }
+        hqr2_schur_vectors(matrix_base<SCALARTYPE> & V, viennacl::vector<SCALARTYPE> & buf_vcl) : V_(V), buf_vcl_(buf_vcl) {}
 
-        SCALARTYPE& operator()(int i, int j)
+        void rotate(int n, int last_n, SCALARTYPE q, SCALARTYPE p)
         {
-            return data[static_cast<vcl_size_t>(i) * internal_size_ + static_cast<vcl_size_t>(j)];
+            final_iter_update_gpu(V_, n, last_n, q, p);
         }
 
-        SCALARTYPE* row(int i)
+        void update_qr_column(std::vector<SCALARTYPE> const & buf, int m, int n, int last_n)
         {
-            return &data[static_cast<vcl_size_t>(i) * internal_size_];
+            update_float_QR_column_gpu(V_, buf, buf_vcl_, m, n, last_n, false);
         }
 
-        SCALARTYPE* begin()
-        {
-            return &data[0];
-        }
-
-        SCALARTYPE* end()
-        {
-            return &data[0] + data.size();
-        }
-
-        std::vector<SCALARTYPE> data;
     private:
-        vcl_size_t size_;
-        vcl_size_t internal_size_;
+        matrix_base<SCALARTYPE> & V_;
+        viennacl::vector<SCALARTYPE> & buf_vcl_;
     };
 
     // Nonsymmetric reduction from Hessenberg to real Schur form.
     // This is derived from the Algol procedure hqr2, by Martin and Wilkinson, Handbook for Auto. Comp.,
     // Vol.ii-Linear Algebra, and the corresponding  Fortran subroutine in EISPACK.
+    // The iteration to real Schur form is shared with the eigenvalue-only callers in hqr_schur_form().
     template <typename SCALARTYPE, typename VectorType>
     void hqr2(viennacl::matrix<SCALARTYPE>& vcl_H,
                 viennacl::matrix<SCALARTYPE>& V,
@@ -244,17 +162,13 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
 
         FastMatrix<SCALARTYPE> H(vcl_size_t(nn), vcl_H.internal_size2());//, V(nn);
 
-        std::vector<SCALARTYPE>  buf(5 * vcl_size_t(nn));
-        //boost::numeric::ublas::vector<float>  buf(5 * nn);
         viennacl::vector<SCALARTYPE> buf_vcl(5 * vcl_size_t(nn));
 
         viennacl::fast_copy(vcl_H, H.begin());
 
-
-        int n = nn - 1;
+        int n;
 
         SCALARTYPE eps = 2 * static_cast<SCALARTYPE>(EPS);
-        SCALARTYPE exshift = 0;
         SCALARTYPE p = 0;
         SCALARTYPE q = 0;
         SCALARTYPE r = 0;
@@ -267,270 +181,9 @@ void update_float_QR_column_gpu(matrix_base<SCALARTYPE> & A,
 
         SCALARTYPE out1, out2;
 
-        // compute matrix norm
         SCALARTYPE norm = 0;
-        for (int i = 0; i < nn; i++)
-        {
-            for (int j = std::max(i - 1, 0); j < nn; j++)
-                norm = norm + std::fabs(H(i, j));
-        }
-
-        // Outer loop over eigenvalue index
-        int iter = 0;
-        while (n >= 0)
-        {
-            // Look for single small sub-diagonal element
-            int l = n;
-            while (l > 0)
-            {
-                s = std::fabs(H(l - 1, l - 1)) + std::fabs(H(l, l));
-                if (s <= 0)
-                  s = norm;
-                if (std::fabs(H(l, l - 1)) < eps * s)
-                  break;
-
-                l--;
-            }
-
-            // Check for convergence
-            if (l == n)
-            {
-                // One root found
-                H(n, n) = H(n, n) + exshift;
-                d[vcl_size_t(n)] = H(n, n);
-                e[vcl_size_t(n)] = 0;
-                n--;
-                iter = 0;
-            }
-            else if (l == n - 1)
-            {
-                // Two roots found
-                w = H(n, n - 1) * H(n - 1, n);
-                p = (H(n - 1, n - 1) - H(n, n)) / 2;
-                q = p * p + w;
-                z = static_cast<SCALARTYPE>(std::sqrt(std::fabs(q)));
-                H(n, n) = H(n, n) + exshift;
-                H(n - 1, n - 1) = H(n - 1, n - 1) + exshift;
-                x = H(n, n);
-
-                if (q >= 0)
-                {
-                    // Real pair
-                    z = (p >= 0) ? (p + z) : (p - z);
-                    d[vcl_size_t(n) - 1] = x + z;
-                    d[vcl_size_t(n)] = d[vcl_size_t(n) - 1];
-                    if (z <= 0 && z >= 0) // z == 0 without compiler complaints
-                      d[vcl_size_t(n)] = x - w / z;
-                    e[vcl_size_t(n) - 1] = 0;
-                    e[vcl_size_t(n)] = 0;
-                    x = H(n, n - 1);
-                    s = std::fabs(x) + std::fabs(z);
-                    p = x / s;
-                    q = z / s;
-                    r = static_cast<SCALARTYPE>(std::sqrt(p * p + q * q));
-                    p = p / r;
-                    q = q / r;
-
-                    // Row modification
-                    for (int j = n - 1; j < nn; j++)
-                    {
-                        SCALARTYPE h_nj = H(n, j);
-                        z = H(n - 1, j);
-                        H(n - 1, j) = q * z + p * h_nj;
-                        H(n, j) = q * h_nj - p * z;
-                    }
-
-                    final_iter_update(H, n, n + 1, q, p);
-                    final_iter_update_gpu(V, n, nn, q, p);
-                }
-                else
-                {
-                    // Complex pair
-                    d[vcl_size_t(n) - 1] = x + p;
-                    d[vcl_size_t(n)] = x + p;
-                    e[vcl_size_t(n) - 1] = z;
-                    e[vcl_size_t(n)] = -z;
-                }
-
-                n = n - 2;
-                iter = 0;
-            }
-            else
-            {
-                // No convergence yet
-
-                // Form shift
-                x = H(n, n);
-                y = 0;
-                w = 0;
-                if (l < n)
-                {
-                    y = H(n - 1, n - 1);
-                    w = H(n, n - 1) * H(n - 1, n);
-                }
-
-                // Wilkinson's original ad hoc shift
-                if (iter == 10)
-                {
-                    exshift += x;
-                    for (int i = 0; i <= n; i++)
-                        H(i, i) -= x;
-
-                    s = std::fabs(H(n, n - 1)) + std::fabs(H(n - 1, n - 2));
-                    x = y = SCALARTYPE(0.75) * s;
-                    w = SCALARTYPE(-0.4375) * s * s;
-                }
-
-                // MATLAB's new ad hoc shift
-                if (iter == 30)
-                {
-                    s = (y - x) / 2;
-                    s = s * s + w;
-                    if (s > 0)
-                    {
-                        s = static_cast<SCALARTYPE>(std::sqrt(s));
-                        if (y < x) s = -s;
-                        s = x - w / ((y - x) / 2 + s);
-                        for (int i = 0; i <= n; i++)
-                            H(i, i) -= s;
-                        exshift += s;
-                        x = y = w = SCALARTYPE(0.964);
-                    }
-                }
-
-                iter = iter + 1;
-
-                // Look for two consecutive small sub-diagonal elements
-                int m = n - 2;
-                while (m >= l)
-                {
-                    SCALARTYPE h_m1_m1 = H(m + 1, m + 1);
-                    z = H(m, m);
-                    r = x - z;
-                    s = y - z;
-                    p = (r * s - w) / H(m + 1, m) + H(m, m + 1);
-                    q = h_m1_m1 - z - r - s;
-                    r = H(m + 2, m + 1);
-                    s = std::fabs(p) + std::fabs(q) + std::fabs(r);
-                    p = p / s;
-                    q = q / s;
-                    r = r / s;
-                    if (m == l)
-                        break;
-                    if (std::fabs(H(m, m - 1)) * (std::fabs(q) + std::fabs(r)) < eps * (std::fabs(p) * (std::fabs(H(m - 1, m - 1)) + std::fabs(z) + std::fabs(h_m1_m1))))
-                        break;
-                    m--;
-                }
-
-                for (int i = m + 2; i <= n; i++)
-                {
-                    H(i, i - 2) = 0;
-                    if (i > m + 2)
-                        H(i, i - 3) = 0;
-                }
-
-                // float QR step involving rows l:n and columns m:n
-                for (int k = m; k < n; k++)
-                {
-                    bool notlast = (k != n - 1);
-                    if (k != m)
-                    {
-                        p = H(k, k - 1);
-                        q = H(k + 1, k - 1);
-                        r = (notlast ? H(k + 2, k - 1) : 0);
-                        x = std::fabs(p) + std::fabs(q) + std::fabs(r);
-                        if (x > 0)
-                        {
-                            p = p / x;
-                            q = q / x;
-                            r = r / x;
-                        }
-                    }
-
-                    if (x <= 0 && x >= 0) break;  // x == 0 without compiler complaints
-
-                    s = static_cast<SCALARTYPE>(std::sqrt(p * p + q * q + r * r));
-                    if (p < 0) s = -s;
-
-                    if (s < 0 || s > 0)
-                    {
-                        if (k != m)
-                            H(k, k - 1) = -s * x;
-                        else
-                            if (l != m)
-                                H(k, k - 1) = -H(k, k - 1);
-
-                        p = p + s;
-                        y = q / s;
-                        z = r / s;
-                        x = p / s;
-                        q = q / p;
-                        r = r / p;
-
-                        buf[5 * vcl_size_t(k)] = x;
-                        buf[5 * vcl_size_t(k) + 1] = y;
-                        buf[5 * vcl_size_t(k) + 2] = z;
-                        buf[5 * vcl_size_t(k) + 3] = q;
-                        buf[5 * vcl_size_t(k) + 4] = r;
-
-
-                        SCALARTYPE* a_row_k = H.row(k);
-                        SCALARTYPE* a_row_k_1 = H.row(k + 1);
-                        SCALARTYPE* a_row_k_2 = H.row(k + 2);
-                        // Row modification
-                        for (int j = k; j < nn; j++)
-                        {
-                            SCALARTYPE h_kj = a_row_k[j];
-                            SCALARTYPE h_k1_j = a_row_k_1[j];
-
-                            p = h_kj + q * h_k1_j;
-                            if (notlast)
-                            {
-                                SCALARTYPE h_k2_j = a_row_k_2[j];
-                                p = p + r * h_k2_j;
-                                a_row_k_2[j] = h_k2_j - p * z;
-                            }
-
-                            a_row_k[j] = h_kj - p * x;
-                            a_row_k_1[j] = h_k1_j - p * y;
-                        }
-
-                        //H(k + 1, nn - 1) = h_kj;
-
-
-                        // Column modification
-                        for (int i = k; i < std::min(nn, k + 4); i++)
-                        {
-                            p = x * H(i, k) + y * H(i, k + 1);
-                            if (notlast)
-                            {
-                                p = p + z * H(i, k + 2);
-                                H(i, k + 2) = H(i, k + 2) - p * r;
-                            }
-
-                            H(i, k) = H(i, k) - p;
-                            H(i, k + 1) = H(i, k + 1) - p * q;
-                        }
-                    }
-                    else
-                    {
-                        buf[5 * vcl_size_t(k)] = 0;
-                        buf[5 * vcl_size_t(k) + 1] = 0;
-                        buf[5 * vcl_size_t(k) + 2] = 0;
-                        buf[5 * vcl_size_t(k) + 3] = 0;
-                        buf[5 * vcl_size_t(k) + 4] = 0;
-                    }
-                }
-
-                // Timer timer;
-                // timer.start();
-
-                update_float_QR_column<SCALARTYPE>(H, buf, m, n, n, true);
-                update_float_QR_column_gpu(V, buf, buf_vcl, m, n, nn, false);
-
-                // std::cout << timer.get() << "\n";
-            }
-        }
+        hqr2_schur_vectors<SCALARTYPE> schur_vectors(V, buf_vcl);
+        hqr_schur_form(H, nn, d, e, eps, norm, schur_vectors);
 
         // Backsubstitute to find vectors of upper triangular form
         if (norm <= 0)
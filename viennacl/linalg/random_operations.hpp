@@ -0,0 +1,117 @@
+#ifndef VIENNACL_LINALG_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/random_operations.hpp
+    @brief Filling vectors and matrices with random numbers using the counter-based generator from viennacl/tools/random.hpp
+
+    All backends compute the same random stream: Entry i of a vector and entry (i,j) of a matrix with n columns receive the i-th and the (i*n+j)-th value of the stream, respectively.
+    Thus, the result is the same for any number of threads and for row-major as well as column-major matrices.
+    The host-based, OpenCL and CUDA results may differ in the last bits for normally distributed values due to different implementations of log(), sin() and cos().
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/tools/random.hpp"
+#include "viennacl/tools/profiler.hpp"
+#include "viennacl/linalg/host_based/random_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/random_operations.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+  #include "viennacl/linalg/cuda/random_operations.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief Fills a vector with random numbers.
+    *
+    * @param x     The vector to be filled
+    * @param dist  The distribution, either viennacl::tools::uniform_distribution or viennacl::tools::normal_distribution
+    * @param seed  The seed of the random number stream. Identical seeds result in identical vectors.
+    */
+    template<typename NumericT>
+    void fill_random(vector_base<NumericT> & x, viennacl::tools::random_distribution const & dist, vcl_size_t seed = 0)
+    {
+      VIENNACL_PROFILE_SCOPE("random::fill_random", viennacl::tools::profiler_bytes(x), 0);
+      switch (viennacl::traits::handle(x).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fill_random(x, dist, seed);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::fill_random(x, dist, seed);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::fill_random(x, dist, seed);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Fills a dense matrix with random numbers. Row-major and column-major matrices with the same seed hold the same entries.
+    *
+    * @param A     The matrix to be filled
+    * @param dist  The distribution, either viennacl::tools::uniform_distribution or viennacl::tools::normal_distribution
+    * @param seed  The seed of the random number stream. Identical seeds result in identical matrices.
+    */
+    template<typename NumericT>
+    void fill_random(matrix_base<NumericT> & A, viennacl::tools::random_distribution const & dist, vcl_size_t seed = 0)
+    {
+      VIENNACL_PROFILE_SCOPE("random::fill_random", viennacl::tools::profiler_bytes(A), 0);
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::fill_random(A, dist, seed);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::fill_random(A, dist, seed);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::fill_random(A, dist, seed);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+#define VIENNACL_LINALG_RANDOMIZED_SVD_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/randomized_svd.hpp
+    @brief Randomized singular value decomposition for computing the dominant singular triplets of large dense and sparse matrices.
+
+    The range of A is sampled with a Gaussian test matrix, refined by power (subspace) iterations, and A is projected onto the resulting orthonormal basis (Halko, Martinsson, Tropp, SIAM Review 53(2), 2011).
+    All passes over A are matrix-matrix products, the orthonormalization uses Gram matrices computed by matrix-matrix products.
+    Only the decompositions of small matrices with as many rows and columns as the sample size are computed on the host.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/ilu_operations.hpp"
+#include "viennacl/linalg/random_operations.hpp"
+#include "viennacl/linalg/detail/symmetric_jacobi.hpp"
+#include "viennacl/tools/random.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the randomized singular value decomposition. */
+class randomized_svd_tag
+{
+public:
+  /** @brief The constructor
+  *
+  * @param rank               Number of singular triplets to compute
+  * @param oversampling       Number of additional samples of the range of A. Five to ten are usually sufficient.
+  * @param power_iterations   Number of power iterations. Increase for matrices with slowly decaying singular values.
+  * @param seed               Seed for the Gaussian test matrix
+  */
+  randomized_svd_tag(vcl_size_t rank, vcl_size_t oversampling = 10, vcl_size_t power_iterations = 2, vcl_size_t seed = 0)
+    : rank_(rank), oversampling_(oversampling), power_iterations_(power_iterations), seed_(seed) {}
+
+  /** @brief Returns the number of singular triplets to compute */
+  vcl_size_t rank() const { return rank_; }
+  /** @brief Sets the number of singular triplets to compute */
+  void rank(vcl_size_t r) { rank_ = r; }
+
+  /** @brief Returns the number of additional samples */
+  vcl_size_t oversampling() const { return oversampling_; }
+  /** @brief Sets the number of additional samples */
+  void oversampling(vcl_size_t p) { oversampling_ = p; }
+
+  /** @brief Returns the number of power iterations */
+  vcl_size_t power_iterations() const { return power_iterations_; }
+  /** @brief Sets the number of power iterations */
+  void power_iterations(vcl_size_t q) { power_iterations_ = q; }
+
+  /** @brief Returns the seed for the Gaussian test matrix */
+  vcl_size_t seed() const { return seed_; }
+  /** @brief Sets the seed for the Gaussian test matrix */
+  void seed(vcl_size_t s) { seed_ = s; }
+
+private:
+  vcl_size_t rank_;
+  vcl_size_t oversampling_;
+  vcl_size_t power_iterations_;
+  vcl_size_t seed_;
+};
+
+
+namespace detail
+{
+  /** @brief Products of a dense matrix and its transpose with a block of vectors */
+  template<typename NumericT>
+  class rsvd_dense_operator
+  {
+  public:
+    rsvd_dense_operator(matrix_base<NumericT> const & A) : A_(A) {}
+
+    vcl_size_t size1() const { return A_.size1(); }
+    vcl_size_t size2() const { return A_.size2(); }
+    viennacl::context context() const { return viennacl::traits::context(A_); }
+
+    /** @brief Computes Y = A * X */
+    void apply(matrix_base<NumericT> const & X, matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(A_, X); }
+    /** @brief Computes Y = A^T * X */
+    void apply_trans(matrix_base<NumericT> const & X, matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(trans(A_), X); }
+
+  private:
+    matrix_base<NumericT> const & A_;
+  };
+
+  /** @brief Products of a sparse matrix and its transpose with a block of vectors. The transpose is set up explicitly once, so that both products are row-wise. */
+  template<typename NumericT>
+  class rsvd_sparse_operator
+  {
+  public:
+    rsvd_sparse_operator(compressed_matrix<NumericT> const & A) : A_(A), At_(A.size2(), A.size1(), A.nnz(), viennacl::traits::context(A))
+    {
+      viennacl::linalg::ilu_transpose(A, At_);
+    }
+
+    vcl_size_t size1() const { return A_.size1(); }
+    vcl_size_t size2() const { return A_.size2(); }
+    viennacl::context context() const { return viennacl::traits::context(A_); }
+
+    void apply(matrix_base<NumericT> const & X, matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(A_, X); }
+    void apply_trans(matrix_base<NumericT> const & X, matrix_base<NumericT> & Y) const { Y = viennacl::linalg::prod(At_, X); }
+
+  private:
+    compressed_matrix<NumericT> const & A_;
+    compressed_matrix<NumericT> At_;
+  };
+
+
+  /** @brief One-sided Jacobi SVD M = U * diag(sigma) * V^T of a small square matrix M (column-major, n-by-n).
+  *
+  * M is overwritten with U. Columns of U belonging to zero singular values are zero.
+  */
+  template<typename NumericT>
+  void rsvd_small_svd(std::vector<NumericT> & M, vcl_size_t n, std::vector<NumericT> & sigma, std::vector<NumericT> & V)
+  {
+    V.assign(n * n, NumericT(0));
+    for (vcl_size_t i = 0; i < n; ++i)
+      V[i + i * n] = NumericT(1);
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    for (vcl_size_t sweep = 0; sweep < 100; ++sweep)
+    {
+      bool converged = true;
+      for (vcl_size_t p = 0; p < n; ++p)
+        for (vcl_size_t q = p + 1; q < n; ++q)
+        {
+          NumericT alpha = 0, beta = 0, gamma = 0;
+          for (vcl_size_t k = 0; k < n; ++k)
+          {
+            alpha += M[k + p * n] * M[k + p * n];
+            beta  += M[k + q * n] * M[k + q * n];
+            gamma += M[k + p * n] * M[k + q * n];
+          }
+          if (std::fabs(gamma) <= eps * std::sqrt(alpha * beta))
+            continue;
+          converged = false;
+
+          NumericT zeta = (beta - alpha) / (NumericT(2) * gamma);
+          NumericT t = NumericT(1) / (std::fabs(zeta) + std::sqrt(zeta * zeta + NumericT(1)));
+          if (zeta < 0)
+            t = -t;
+          NumericT c = NumericT(1) / std::sqrt(t * t + NumericT(1));
+          NumericT s = t * c;
+
+          for (vcl_size_t k = 0; k < n; ++k)
+          {
+            NumericT m_kp = M[k + p * n];
+            NumericT m_kq = M[k + q * n];
+            M[k + p * n] = c * m_kp - s * m_kq;
+            M[k + q * n] = s * m_kp + c * m_kq;
+
+            NumericT v_kp = V[k + p * n];
+            NumericT v_kq = V[k + q * n];
+            V[k + p * n] = c * v_kp - s * v_kq;
+            V[k + q * n] = s * v_kp + c * v_kq;
+          }
+        }
+      if (converged)
+        break;
+    }
+
+    sigma.resize(n);
+    for (vcl_size_t j = 0; j < n; ++j)
+    {
+      NumericT norm = 0;
+      for (vcl_size_t k = 0; k < n; ++k)
+        norm += M[k + j * n] * M[k + j * n];
+      sigma[j] = std::sqrt(norm);
+      NumericT scale = (sigma[j] > 0) ? NumericT(1) / sigma[j] : NumericT(0);
+      for (vcl_size_t k = 0; k < n; ++k)
+        M[k + j * n] *= scale;
+    }
+  }
+
+  template<typename NumericT>
+  void rsvd_to_host(matrix<NumericT, column_major> const & A_dev, std::vector<NumericT> & A)
+  {
+    vcl_size_t n = A_dev.size1();
+    std::vector<std::vector<NumericT> > A_host(n, std::vector<NumericT>(A_dev.size2()));
+    viennacl::copy(A_dev, A_host);
+    A.resize(n * A_dev.size2());
+    for (vcl_size_t j = 0; j < A_dev.size2(); ++j)
+      for (vcl_size_t i = 0; i < n; ++i)
+        A[i + j * n] = A_host[i][j];
+  }
+
+  /** @brief Orthonormalizes the columns of Y by two passes of Y <- Y * W * Lambda^{-1/2}, where Y^T Y = W Lambda W^T.
+  *
+  * This is CholeskyQR2 with the Cholesky factorization replaced by an eigendecomposition of the Gram matrix:
+  * Directions with eigenvalues at the level of round-off are dropped (the respective columns become zero), so that rank deficient samples are handled gracefully.
+  *
+  * @param Y        The block of vectors to orthonormalize
+  * @param buffer   Temporary of the same size as Y
+  */
+  template<typename NumericT>
+  void rsvd_orthonormalize(matrix<NumericT, column_major> & Y, matrix<NumericT, column_major> & buffer)
+  {
+    vcl_size_t l = Y.size2();
+    viennacl::matrix<NumericT, column_major> T(l, l, viennacl::traits::context(Y));
+    std::vector<std::vector<NumericT> > T_host(l, std::vector<NumericT>(l));
+    std::vector<NumericT> G, W;
+
+    for (vcl_size_t pass = 0; pass < 2; ++pass)
+    {
+      T = viennacl::linalg::prod(trans(Y), Y);
+      rsvd_to_host(T, G);
+      viennacl::linalg::detail::symmetric_jacobi_eigen(G, l, W);
+
+      NumericT lambda_max = 0;
+      for (vcl_size_t j = 0; j < l; ++j)
+        lambda_max = std::max(lambda_max, G[j + j * l]);
+      NumericT threshold = lambda_max * NumericT(l) * std::numeric_limits<NumericT>::epsilon();
+
+      for (vcl_size_t j = 0; j < l; ++j)
+      {
+        NumericT scale = (G[j + j * l] > threshold) ? NumericT(1) / std::sqrt(G[j + j * l]) : NumericT(0);
+        for (vcl_size_t i = 0; i < l; ++i)
+          T_host[i][j] = W[i + j * l] * scale;
+      }
+      viennacl::copy(T_host, T);
+
+      buffer = viennacl::linalg::prod(Y, T);
+      Y = buffer;
+    }
+  }
+
+  template<typename OperatorT, typename NumericT, typename F1, typename F2>
+  void randomized_svd_impl(OperatorT const & A,
+                           viennacl::matrix<NumericT, F1> & U,
+                           viennacl::vector<NumericT> & S,
+                           viennacl::matrix<NumericT, F2> & V,
+                           randomized_svd_tag const & tag)
+  {
+    typedef viennacl::matrix<NumericT, column_major>   BlockType;
+
+    vcl_size_t m = A.size1();
+    vcl_size_t n = A.size2();
+    vcl_size_t k = std::min(tag.rank(), std::min(m, n));
+    vcl_size_t l = std::min(k + tag.oversampling(), std::min(m, n));
+    viennacl::context ctx = A.context();
+
+    BlockType Q(m, l, ctx), Q_buffer(m, l, ctx);
+    BlockType Z(n, l, ctx), Z_buffer(n, l, ctx);
+
+    // range finder: Q = orth(A * Omega) with Gaussian Omega, followed by power iterations Q = orth(A * orth(A^T Q))
+    viennacl::linalg::fill_random(Z, viennacl::tools::normal_distribution(), tag.seed());
+    A.apply(Z, Q);
+    rsvd_orthonormalize(Q, Q_buffer);
+    for (vcl_size_t iter = 0; iter < tag.power_iterations(); ++iter)
+    {
+      A.apply_trans(Q, Z);
+      rsvd_orthonormalize(Z, Z_buffer);
+      A.apply(Z, Q);
+      rsvd_orthonormalize(Q, Q_buffer);
+    }
+
+    // B^T = A^T Q = Q2 * R with Q2 orthonormal, hence A \approx Q * R^T * Q2^T:
+    A.apply_trans(Q, Z);
+    BlockType Q2(Z);
+    rsvd_orthonormalize(Q2, Z_buffer);
+
+    BlockType R(l, l, ctx);
+    R = viennacl::linalg::prod(trans(Q2), Z);
+
+    // R = U_R * Sigma * V_R^T, hence A \approx (Q * V_R) * Sigma * (Q2 * U_R)^T
+    std::vector<NumericT> U_R, V_R, sigma;
+    rsvd_to_host(R, U_R);
+    rsvd_small_svd(U_R, l, sigma, V_R);
+
+    std::vector<std::pair<NumericT, vcl_size_t> > order(l);
+    for (vcl_size_t j = 0; j < l; ++j)
+      order[j] = std::make_pair(-sigma[j], j);
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::vector<NumericT> > left_host(l, std::vector<NumericT>(k));
+    std::vector<std::vector<NumericT> > right_host(l, std::vector<NumericT>(k));
+    std::vector<NumericT> S_host(k);
+    for (vcl_size_t j = 0; j < k; ++j)
+    {
+      vcl_size_t col = order[j].second;
+      S_host[j] = sigma[col];
+      for (vcl_size_t i = 0; i < l; ++i)
+      {
+        left_host[i][j]  = V_R[i + col * l];
+        right_host[i][j] = U_R[i + col * l];
+      }
+    }
+
+    BlockType coefficients(l, k, ctx);
+    viennacl::copy(left_host, coefficients);
+    U.resize(m, k, false);
+    U = viennacl::linalg::prod(Q, coefficients);
+
+    viennacl::copy(right_host, coefficients);
+    V.resize(n, k, false);
+    V = viennacl::linalg::prod(Q2, coefficients);
+
+    S.resize(k, false);
+    viennacl::copy(S_host.begin(), S_host.end(), S.begin());
+  }
+}
+
+/** @brief Computes the dominant singular triplets A \approx U * diag(S) * V^T of a dense matrix by a randomized range finder with power iterations.
+*
+* Each power iteration costs two passes over A (one product with A and one with A^T).
+* Singular values below about sqrt(l * eps) times the largest singular value, where l is the sample size rank + oversampling, are not resolved and may be returned as zero.
+*
+* @param A     The matrix of size m x n
+* @param U     Left singular vectors (m x rank, column-wise), resized if necessary. Must reside in the same memory context as A.
+* @param S     Singular values in descending order (rank entries), resized if necessary
+* @param V     Right singular vectors (n x rank, column-wise), resized if necessary. Must reside in the same memory context as A.
+* @param tag   Rank, oversampling, number of power iterations, and seed
+*/
+template<typename NumericT, typename F1, typename F2>
+void randomized_svd(matrix_base<NumericT> const & A,
+                    viennacl::matrix<NumericT, F1> & U,
+                    viennacl::vector<NumericT> & S,
+                    viennacl::matrix<NumericT, F2> & V,
+                    randomized_svd_tag const & tag)
+{
+  detail::rsvd_dense_operator<NumericT> op(A);
+  detail::randomized_svd_impl(op, U, S, V, tag);
+}
+
+/** @brief Computes the dominant singular triplets A \approx U * diag(S) * V^T of a sparse matrix by a randomized range finder with power iterations.
+*
+* The transpose of A is set up once, all passes over A are sparse matrix-dense matrix products. See the dense overload for details.
+*/
+template<typename NumericT, typename F1, typename F2>
+void randomized_svd(compressed_matrix<NumericT> const & A,
+                    viennacl::matrix<NumericT, F1> & U,
+                    viennacl::vector<NumericT> & S,
+                    viennacl::matrix<NumericT, F2> & V,
+                    randomized_svd_tag const & tag)
+{
+  detail::rsvd_sparse_operator<NumericT> op(A);
+  detail::randomized_svd_impl(op, U, S, V, tag);
+}
+
+}
+}
+
+#endif
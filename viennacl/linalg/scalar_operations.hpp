@@ -30,6 +30,7 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/scalar_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -65,6 +66,7 @@ namespace viennacl
     as(S1 & s1,
        S2 const & s2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha)
     {
+      VIENNACL_PROFILE_SCOPE("scalar::as", 0, 0);
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -115,6 +117,7 @@ namespace viennacl
          S2 const & s2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
          S3 const & s3, ScalarType2 const & beta,  vcl_size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_SCOPE("scalar::asbs", 0, 0);
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -171,6 +174,7 @@ namespace viennacl
            S2 const & s2, ScalarType1 const & alpha, vcl_size_t len_alpha, bool reciprocal_alpha, bool flip_sign_alpha,
            S3 const & s3, ScalarType2 const & beta,  vcl_size_t len_beta,  bool reciprocal_beta,  bool flip_sign_beta)
     {
+      VIENNACL_PROFILE_SCOPE("scalar::asbs_s", 0, 0);
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -212,6 +216,7 @@ namespace viennacl
                                 >::type
     swap(S1 & s1, S2 & s2)
     {
+      VIENNACL_PROFILE_SCOPE("scalar::swap", 0, 0);
       switch (viennacl::traits::handle(s1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
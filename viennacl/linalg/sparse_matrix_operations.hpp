@@ -27,6 +27,7 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -51,6 +52,7 @@ namespace viennacl
                vector<SCALARTYPE, VEC_ALIGNMENT> & vec,
                row_info_types info_selector)
       {
+        VIENNACL_PROFILE_SCOPE("sparse::row_info", 0, 0);
         switch (viennacl::traits::handle(mat).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
@@ -98,6 +100,7 @@ namespace viennacl
       assert( (mat.size1() == result.size()) && bool("Size check failed for compressed matrix-vector product: size1(mat) != size(result)"));
       assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmv)", viennacl::tools::profiler_sparse_bytes<ScalarType>(mat) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(mat));
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -139,6 +142,7 @@ namespace viennacl
       assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
       assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmm)", viennacl::tools::profiler_sparse_bytes<ScalarType>(sp_mat) + viennacl::tools::profiler_bytes(d_mat) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(sp_mat) * viennacl::traits::size2(result));
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -181,6 +185,7 @@ namespace viennacl
       assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
       assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for compressed matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmm)", viennacl::tools::profiler_sparse_bytes<ScalarType>(sp_mat) + viennacl::tools::profiler_bytes(d_mat) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(sp_mat) * viennacl::traits::size2(result));
       switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -203,6 +208,313 @@ namespace viennacl
       }
     }
 
+    //
+    // block_compressed_matrix: Only implemented for main memory so far
+    //
+
+    /** @brief Carries out matrix-vector multiplication with a block_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param alpha  Scaling factor for the product
+    * @param result The result vector
+    * @param beta   Scaling factor for the previous content of the result vector
+    */
+    template<typename NumericT, unsigned int BlockSize>
+    void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   NumericT alpha,
+                         viennacl::vector_base<NumericT> & result,
+                   NumericT beta)
+    {
+      assert( (mat.size1() == result.size()) && bool("Size check failed for block compressed matrix-vector product: size1(mat) != size(result)"));
+      assert( (mat.size2() == vec.size())    && bool("Size check failed for block compressed matrix-vector product: size2(mat) != size(x)"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmv)", viennacl::tools::profiler_sparse_bytes<NumericT>(mat) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(mat));
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, alpha, result, beta);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out matrix-vector multiplication with a block_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param result The result vector
+    */
+    template<typename NumericT, unsigned int BlockSize>
+    void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                         viennacl::vector_base<NumericT> & result)
+    {
+      prod_impl(mat, vec, NumericT(1), result, NumericT(0));
+    }
+
+    /** @brief Carries out matrix-matrix multiplication of a block_compressed_matrix with a dense matrix
+    *
+    * Implementation of the convenience expression result = prod(sp_mat, d_mat);
+    *
+    * @param sp_mat   The sparse matrix
+    * @param d_mat    The dense matrix
+    * @param result   The result matrix (dense)
+    */
+    template<typename NumericT, unsigned int BlockSize>
+    void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & sp_mat,
+                   const viennacl::matrix_base<NumericT> & d_mat,
+                         viennacl::matrix_base<NumericT> & result)
+    {
+      assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for block compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
+      assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for block compressed matrix - dense matrix product: size2(sp_mat) != size1(d_mat)"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmm)", viennacl::tools::profiler_sparse_bytes<NumericT>(sp_mat) + viennacl::tools::profiler_bytes(d_mat) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(sp_mat) * viennacl::traits::size2(result));
+      switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(sp_mat, d_mat, result);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out matrix-matrix multiplication of a block_compressed_matrix with a transposed dense matrix
+    *
+    * Implementation of the convenience expression result = prod(sp_mat, trans(d_mat));
+    *
+    * @param sp_mat   The sparse matrix
+    * @param d_mat    The transposed dense matrix
+    * @param result   The result matrix (dense)
+    */
+    template<typename NumericT, unsigned int BlockSize>
+    void prod_impl(const viennacl::block_compressed_matrix<NumericT, BlockSize> & sp_mat,
+                   const viennacl::matrix_expression<const viennacl::matrix_base<NumericT>,
+                                                     const viennacl::matrix_base<NumericT>,
+                                                     viennacl::op_trans > & d_mat,
+                         viennacl::matrix_base<NumericT> & result)
+    {
+      assert( (sp_mat.size1() == result.size1()) && bool("Size check failed for block compressed matrix - dense matrix product: size1(sp_mat) != size1(result)"));
+      assert( (sp_mat.size2() == d_mat.size1()) && bool("Size check failed for block compressed matrix - dense matrix product: size2(sp_mat) != size1(trans(d_mat))"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmm)", viennacl::tools::profiler_sparse_bytes<NumericT>(sp_mat) + viennacl::tools::profiler_bytes(d_mat.lhs()) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(sp_mat) * viennacl::traits::size2(result));
+      switch (viennacl::traits::handle(sp_mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(sp_mat, d_mat, result);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    //
+    // index_compressed_matrix: Only implemented for main memory so far
+    //
+
+    /** @brief Carries out matrix-vector multiplication with an index_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param alpha  Scaling factor for the product
+    * @param result The result vector
+    * @param beta   Scaling factor for the previous content of the result vector
+    */
+    template<typename NumericT, typename OffsetT>
+    void prod_impl(const viennacl::index_compressed_matrix<NumericT, OffsetT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   NumericT alpha,
+                         viennacl::vector_base<NumericT> & result,
+                   NumericT beta)
+    {
+      assert( (mat.size1() == result.size()) && bool("Size check failed for index compressed matrix-vector product: size1(mat) != size(result)"));
+      assert( (mat.size2() == vec.size())    && bool("Size check failed for index compressed matrix-vector product: size2(mat) != size(x)"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmv)", double(mat.nnz() * sizeof(NumericT) + mat.index_bytes()) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(mat));
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, alpha, result, beta);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out matrix-vector multiplication with an index_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param result The result vector
+    */
+    template<typename NumericT, typename OffsetT>
+    void prod_impl(const viennacl::index_compressed_matrix<NumericT, OffsetT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                         viennacl::vector_base<NumericT> & result)
+    {
+      prod_impl(mat, vec, NumericT(1), result, NumericT(0));
+    }
+
+    //
+    // mixed_precision_compressed_matrix: Only implemented for main memory so far
+    //
+
+    /** @brief Carries out matrix-vector multiplication with a mixed_precision_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param alpha  Scaling factor for the product
+    * @param result The result vector
+    * @param beta   Scaling factor for the previous content of the result vector
+    */
+    template<typename NumericT, typename StorageT>
+    void prod_impl(const viennacl::mixed_precision_compressed_matrix<NumericT, StorageT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   NumericT alpha,
+                         viennacl::vector_base<NumericT> & result,
+                   NumericT beta)
+    {
+      assert( (mat.size1() == result.size()) && bool("Size check failed for mixed precision compressed matrix-vector product: size1(mat) != size(result)"));
+      assert( (mat.size2() == vec.size())    && bool("Size check failed for mixed precision compressed matrix-vector product: size2(mat) != size(x)"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmv)", viennacl::tools::profiler_sparse_bytes<StorageT>(mat) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(mat));
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, alpha, result, beta);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out matrix-vector multiplication with a mixed_precision_compressed_matrix
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The matrix
+    * @param vec    The vector
+    * @param result The result vector
+    */
+    template<typename NumericT, typename StorageT>
+    void prod_impl(const viennacl::mixed_precision_compressed_matrix<NumericT, StorageT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                         viennacl::vector_base<NumericT> & result)
+    {
+      prod_impl(mat, vec, NumericT(1), result, NumericT(0));
+    }
+
+    //
+    // stencil_operator: Only implemented for main memory so far
+    //
+
+    /** @brief Carries out matrix-vector multiplication with a stencil_operator
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The stencil operator
+    * @param vec    The vector
+    * @param alpha  Scaling factor for the product
+    * @param result The result vector
+    * @param beta   Scaling factor for the previous content of the result vector
+    */
+    template<typename NumericT>
+    void prod_impl(const viennacl::stencil_operator<NumericT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                   NumericT alpha,
+                         viennacl::vector_base<NumericT> & result,
+                   NumericT beta)
+    {
+      assert( (mat.size1() == result.size()) && bool("Size check failed for stencil operator-vector product: size1(mat) != size(result)"));
+      assert( (mat.size2() == vec.size())    && bool("Size check failed for stencil operator-vector product: size2(mat) != size(x)"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spmv)", double(mat.handle().raw_size()) + viennacl::tools::profiler_bytes(vec) + viennacl::tools::profiler_bytes(result), 2 * viennacl::tools::profiler_nnz(mat));
+      switch (viennacl::traits::handle(mat).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::prod_impl(mat, vec, alpha, result, beta);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Carries out matrix-vector multiplication with a stencil_operator
+    *
+    * Implementation of the convenience expression result = prod(mat, vec);
+    *
+    * @param mat    The stencil operator
+    * @param vec    The vector
+    * @param result The result vector
+    */
+    template<typename NumericT>
+    void prod_impl(const viennacl::stencil_operator<NumericT> & mat,
+                   const viennacl::vector_base<NumericT> & vec,
+                         viennacl::vector_base<NumericT> & result)
+    {
+      prod_impl(mat, vec, NumericT(1), result, NumericT(0));
+    }
+
+    /** @brief Runs damped Jacobi iterations x <- x + weight * D^{-1} (rhs - A x) with the diagonal D of a stencil_operator A. The iterations are temporally blocked, i.e. fused into a single sweep over the grid.
+    *
+    * @param iterations  Number of Jacobi iterations
+    * @param A           The stencil operator
+    * @param x           The vector to be smoothed, updated in place
+    * @param x_backup    Vector of the same size as x used as additional storage
+    * @param rhs         The right hand side
+    * @param weight      Damping factor. 1: Undamped Jacobi iteration
+    */
+    template<typename NumericT>
+    void smooth_jacobi(unsigned int iterations,
+                       viennacl::stencil_operator<NumericT> const & A,
+                       viennacl::vector_base<NumericT> & x,
+                       viennacl::vector_base<NumericT> & x_backup,
+                       viennacl::vector_base<NumericT> const & rhs,
+                       NumericT weight)
+    {
+      assert( (A.size1() == x.size() && A.size1() == x_backup.size() && A.size1() == rhs.size()) && bool("Size check failed for Jacobi smoother"));
+      assert( (x.stride() == 1 && x_backup.stride() == 1 && rhs.stride() == 1) && bool("Jacobi smoother requires vectors with unit stride"));
+      assert( (viennacl::traits::handle(x) != viennacl::traits::handle(x_backup)) && bool("Jacobi smoother requires distinct vectors x and x_backup"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::smooth_jacobi", double(A.handle().raw_size()) + 3 * viennacl::tools::profiler_bytes(x), 3 * double(iterations) * viennacl::tools::profiler_nnz(A));
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::smooth_jacobi(iterations, A, x, x_backup, rhs, weight);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
     // A * B with both A and B sparse
 
     /** @brief Carries out sparse_matrix-sparse_matrix multiplication for CSR matrices
@@ -224,6 +536,7 @@ namespace viennacl
       assert( (C.size1() == 0 || C.size1() == A.size1())  && bool("Size check failed for sparse matrix-matrix product: size1(A) != size1(C)"));
       assert( (C.size2() == 0 || C.size2() == B.size2())  && bool("Size check failed for sparse matrix-matrix product: size2(B) != size2(B)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::prod (spgemm)", viennacl::tools::profiler_sparse_bytes<NumericT>(A) + viennacl::tools::profiler_sparse_bytes<NumericT>(B), 0);
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -262,6 +575,7 @@ namespace viennacl
       assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on compressed matrix: size1(mat) != size2(mat)"));
       assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::inplace_solve", viennacl::tools::profiler_sparse_bytes<ScalarType>(mat) + 2 * viennacl::tools::profiler_bytes(vec), 2 * viennacl::tools::profiler_nnz(mat));
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -300,6 +614,7 @@ namespace viennacl
       assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on transposed compressed matrix: size1(mat) != size2(mat)"));
       assert( (mat.size1() == vec.size())    && bool("Size check failed for transposed compressed matrix triangular solve: size1(mat) != size(x)"));
 
+      VIENNACL_PROFILE_SCOPE("sparse::inplace_solve", viennacl::tools::profiler_sparse_bytes<ScalarType>(mat.lhs()) + 2 * viennacl::tools::profiler_bytes(vec), 2 * viennacl::tools::profiler_nnz(mat.lhs()));
       switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -338,6 +653,7 @@ namespace viennacl
         assert( (mat.size1() == mat.size2()) && bool("Size check failed for triangular solve on transposed compressed matrix: size1(mat) != size2(mat)"));
         assert( (mat.size1() == vec.size())  && bool("Size check failed for transposed compressed matrix triangular solve: size1(mat) != size(x)"));
 
+        VIENNACL_PROFILE_SCOPE("sparse::block_inplace_solve", viennacl::tools::profiler_sparse_bytes<ScalarType>(mat.lhs()) + 2 * viennacl::tools::profiler_bytes(vec), 2 * viennacl::tools::profiler_nnz(mat.lhs()));
         switch (viennacl::traits::handle(mat.lhs()).get_active_handle_id())
         {
           case viennacl::MAIN_MEMORY:
@@ -364,6 +680,121 @@ namespace viennacl
     }
 
 
+    /** @brief Converts a coordinate_matrix to a compressed_matrix.
+    *
+    * The conversion runs on the host: If the entries of 'src' are sorted by row (as set up by viennacl::copy()), it is carried out in parallel, otherwise a serial counting sort is used.
+    * Matrices in OpenCL or CUDA memory are transferred to the host first. The result is set up in the memory context of 'dest'.
+    *
+    * @param dest   The compressed_matrix to be set up
+    * @param src    The coordinate_matrix to be converted
+    */
+    template<typename NumericT, unsigned int AlignmentV1, unsigned int AlignmentV2>
+    void convert(compressed_matrix<NumericT, AlignmentV1> & dest, coordinate_matrix<NumericT, AlignmentV2> const & src)
+    {
+      assert( (src.nnz() > 0) && bool("Conversion of empty coordinate_matrix not supported!"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::convert", 2 * viennacl::tools::profiler_sparse_bytes<NumericT>(src), 0);
+
+      std::vector<unsigned int> row_buffer(src.size1() + 1);
+      std::vector<unsigned int> col_buffer(src.nnz());
+      std::vector<NumericT>     elements(src.nnz());
+
+      if (viennacl::traits::handle(src).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::detail::coo_to_csr(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(src.handle12()),
+                                                         viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src.handle()),
+                                                         src.nnz(), src.size1(),
+                                                         &(row_buffer[0]), &(col_buffer[0]), &(elements[0]));
+      else
+      {
+        std::vector<unsigned int> coords(2 * src.nnz());
+        std::vector<NumericT>     src_elements(src.nnz());
+        viennacl::backend::memory_read(src.handle12(), 0, sizeof(unsigned int) * coords.size(),       &(coords[0]));
+        viennacl::backend::memory_read(src.handle(),   0, sizeof(NumericT)     * src_elements.size(), &(src_elements[0]));
+        viennacl::linalg::host_based::detail::coo_to_csr(&(coords[0]), &(src_elements[0]),
+                                                         src.nnz(), src.size1(),
+                                                         &(row_buffer[0]), &(col_buffer[0]), &(elements[0]));
+      }
+
+      dest.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), src.size1(), src.size2(), src.nnz());
+    }
+
+    /** @brief Computes the symmetrically permuted matrix dest = P * src * P^T, e.g. for applying a bandwidth-reducing reordering obtained from viennacl::reorder().
+    *
+    * Entry (i,j) of 'src' becomes entry (perm[i], perm[j]) of 'dest'. Thus, a linear system src * x = b is equivalent to dest * y = c with y[perm[i]] = x[i] and c[perm[i]] = b[i].
+    * The permutation runs on the host in parallel. Matrices in OpenCL or CUDA memory are transferred to the host first. The result is set up in the memory context of 'dest'.
+    *
+    * @param dest   The compressed_matrix to be set up. Must not be the same object as 'src'
+    * @param src    The square compressed_matrix to be permuted
+    * @param perm   The permutation: perm[i] is the new index of row and column i
+    */
+    template<typename NumericT, unsigned int AlignmentV1, unsigned int AlignmentV2, typename IndexT>
+    void permute(compressed_matrix<NumericT, AlignmentV1> & dest, compressed_matrix<NumericT, AlignmentV2> const & src, std::vector<IndexT> const & perm)
+    {
+      assert( (src.size1() == src.size2()) && bool("Symmetric permutation of a non-square matrix!"));
+      assert( (perm.size() == src.size1()) && bool("Size of permutation does not match matrix size!"));
+      assert( (src.nnz() > 0) && bool("Permutation of empty compressed_matrix not supported!"));
+
+      VIENNACL_PROFILE_SCOPE("sparse::permute", 2 * viennacl::tools::profiler_sparse_bytes<NumericT>(src), 0);
+
+      std::vector<unsigned int> row_buffer(src.size1() + 1);
+      std::vector<unsigned int> col_buffer(src.nnz());
+      std::vector<NumericT>     elements(src.nnz());
+
+      if (viennacl::traits::handle(src).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::detail::csr_permute(viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(src.handle1()),
+                                                          viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(src.handle2()),
+                                                          viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src.handle()),
+                                                          src.size1(), &(perm[0]),
+                                                          &(row_buffer[0]), &(col_buffer[0]), &(elements[0]));
+      else
+      {
+        std::vector<unsigned int> src_row_buffer(src.size1() + 1);
+        std::vector<unsigned int> src_col_buffer(src.nnz());
+        std::vector<NumericT>     src_elements(src.nnz());
+        viennacl::backend::memory_read(src.handle1(), 0, sizeof(unsigned int) * src_row_buffer.size(), &(src_row_buffer[0]));
+        viennacl::backend::memory_read(src.handle2(), 0, sizeof(unsigned int) * src_col_buffer.size(), &(src_col_buffer[0]));
+        viennacl::backend::memory_read(src.handle(),  0, sizeof(NumericT)     * src_elements.size(),   &(src_elements[0]));
+        viennacl::linalg::host_based::detail::csr_permute(&(src_row_buffer[0]), &(src_col_buffer[0]), &(src_elements[0]),
+                                                          src.size1(), &(perm[0]),
+                                                          &(row_buffer[0]), &(col_buffer[0]), &(elements[0]));
+      }
+
+      dest.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), src.size1(), src.size2(), src.nnz());
+    }
+
+    /** @brief Permutes the entries of a vector consistently with permute() for compressed_matrix: Entry i of 'src' becomes entry perm[i] of 'dest'.
+    *
+    * The permutation runs on the host. Vectors in OpenCL or CUDA memory are transferred to the host and back.
+    *
+    * @param dest   The result vector. Must not share memory with 'src'
+    * @param src    The vector to be permuted
+    * @param perm   The permutation: perm[i] is the new index of entry i
+    */
+    template<typename NumericT, typename IndexT>
+    void permute(vector_base<NumericT> & dest, vector_base<NumericT> const & src, std::vector<IndexT> const & perm)
+    {
+      assert( (dest.size() == src.size() && perm.size() == src.size()) && bool("Size mismatch in permutation of vector!"));
+      assert( (viennacl::traits::handle(dest) != viennacl::traits::handle(src)) && bool("In-place permutation of vectors not supported!"));
+
+      if (src.size() == 0)
+        return;
+
+      VIENNACL_PROFILE_SCOPE("sparse::permute", viennacl::tools::profiler_bytes(src) + viennacl::tools::profiler_bytes(dest), 0);
+
+      if (viennacl::traits::handle(src).get_active_handle_id() == viennacl::MAIN_MEMORY
+          && viennacl::traits::handle(dest).get_active_handle_id() == viennacl::MAIN_MEMORY)
+        viennacl::linalg::host_based::detail::vector_permute(viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(src.handle()), src.start(), src.stride(),
+                                                             viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(dest.handle()), dest.start(), dest.stride(),
+                                                             src.size(), &(perm[0]));
+      else
+      {
+        std::vector<NumericT> host_src(src.size());
+        std::vector<NumericT> host_dest(src.size());
+        viennacl::copy(src.begin(), src.end(), host_src.begin());
+        viennacl::linalg::host_based::detail::vector_permute(&(host_src[0]), 0, 1, &(host_dest[0]), 0, 1, src.size(), &(perm[0]));
+        viennacl::copy(host_dest.begin(), host_dest.end(), dest.begin());
+      }
+    }
 
   } //namespace linalg
 
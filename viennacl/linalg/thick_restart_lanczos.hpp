@@ -0,0 +1,444 @@
+#ifndef VIENNACL_LINALG_THICK_RESTART_LANCZOS_HPP_
+#define VIENNACL_LINALG_THICK_RESTART_LANCZOS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/thick_restart_lanczos.hpp
+*   @brief Thick-restart Lanczos method (the symmetric Krylov-Schur method) for a few eigenpairs of symmetric matrices, optionally in shift-invert mode.
+*
+*   The Krylov basis is held in a column-major matrix with krylov_size() + 1 columns, so the memory footprint is bounded independently of the number of restarts.
+*   Each new basis vector is orthogonalized against the whole basis by classical Gram-Schmidt with reorthogonalization, carried out by matrix-vector products with the basis.
+*   Only the small projected matrix is decomposed on the host.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/random_operations.hpp"
+#include "viennacl/linalg/detail/symmetric_jacobi.hpp"
+#include "viennacl/tools/random.hpp"
+
+namespace viennacl
+{
+namespace linalg
+{
+
+/** @brief A tag for the thick-restart Lanczos method. */
+class thick_restart_lanczos_tag
+{
+public:
+
+  /** @brief Selects the wanted part of the spectrum (in shift-invert mode, the eigenvalues closest to the shift are computed irrespective of this setting) */
+  enum
+  {
+    largest_eigenvalues = 0,
+    smallest_eigenvalues
+  };
+
+  /** @brief The constructor
+  *
+  * @param numeig       Number of eigenpairs to compute
+  * @param krylov       Maximum size of the Krylov basis. Must be at least numeig + 2, twice numeig or more is recommended.
+  * @param tol          Relative tolerance for the residual norm of the Ritz pairs
+  * @param max_restarts Maximum number of restarts
+  */
+  thick_restart_lanczos_tag(vcl_size_t numeig = 10,
+                            vcl_size_t krylov = 40,
+                            double tol = 1e-10,
+                            vcl_size_t max_restarts = 500)
+    : num_eigenvalues_(numeig), krylov_size_(krylov), tolerance_(tol), max_restarts_(max_restarts),
+      which_(largest_eigenvalues), shift_(0), seed_(0), restarts_(0), num_converged_(0) {}
+
+  /** @brief Sets the number of eigenvalues */
+  void num_eigenvalues(vcl_size_t numeig) { num_eigenvalues_ = numeig; }
+  /** @brief Returns the number of eigenvalues */
+  vcl_size_t num_eigenvalues() const { return num_eigenvalues_; }
+
+  /** @brief Sets the maximum size of the Krylov basis */
+  void krylov_size(vcl_size_t max) { krylov_size_ = max; }
+  /** @brief Returns the maximum size of the Krylov basis */
+  vcl_size_t krylov_size() const { return krylov_size_; }
+
+  /** @brief Sets the relative tolerance for the residual norms of the Ritz pairs */
+  void tolerance(double tol) { tolerance_ = tol; }
+  /** @brief Returns the relative tolerance for the residual norms of the Ritz pairs */
+  double tolerance() const { return tolerance_; }
+
+  /** @brief Sets the maximum number of restarts */
+  void max_restarts(vcl_size_t r) { max_restarts_ = r; }
+  /** @brief Returns the maximum number of restarts */
+  vcl_size_t max_restarts() const { return max_restarts_; }
+
+  /** @brief Selects the largest or the smallest eigenvalues */
+  void which(int w) { which_ = w; }
+  /** @brief Returns whether the largest or the smallest eigenvalues are computed */
+  int which() const { return which_; }
+
+  /** @brief Sets the shift for the shift-invert mode */
+  void shift(double s) { shift_ = s; }
+  /** @brief Returns the shift for the shift-invert mode */
+  double shift() const { return shift_; }
+
+  /** @brief Sets the seed for the random start vector */
+  void seed(vcl_size_t s) { seed_ = s; }
+  /** @brief Returns the seed for the random start vector */
+  vcl_size_t seed() const { return seed_; }
+
+  /** @brief Returns the number of restarts of the last run */
+  vcl_size_t restarts() const { return restarts_; }
+  /** @brief Returns the number of converged eigenpairs of the last run */
+  vcl_size_t num_converged() const { return num_converged_; }
+
+  /** @brief Sets the number of restarts of the last run. Used by the solver. */
+  void restarts(vcl_size_t r) const { restarts_ = r; }
+  /** @brief Sets the number of converged eigenpairs of the last run. Used by the solver. */
+  void num_converged(vcl_size_t n) const { num_converged_ = n; }
+
+private:
+  vcl_size_t num_eigenvalues_;
+  vcl_size_t krylov_size_;
+  double tolerance_;
+  vcl_size_t max_restarts_;
+  int which_;
+  double shift_;
+  vcl_size_t seed_;
+
+  mutable vcl_size_t restarts_;
+  mutable vcl_size_t num_converged_;
+};
+
+
+namespace detail
+{
+  /** @brief The operator (A - sigma I)^{-1} of the shift-invert mode. Each product is a solve with the user-provided solver tag and preconditioner. */
+  template<typename MatrixT, typename NumericT, typename SolverTagT, typename PreconditionerT>
+  class shift_invert_operator
+  {
+  public:
+    /** @brief The shifted matrix A - sigma I, which is passed to the iterative solver as a user-provided operator */
+    class shifted_matrix
+    {
+    public:
+      typedef NumericT    value_type;
+
+      shifted_matrix(MatrixT const & A, NumericT sigma) : A_(A), sigma_(sigma) {}
+
+      vcl_size_t size1() const { return A_.size1(); }
+      vcl_size_t size2() const { return A_.size2(); }
+
+      /** @brief Returns the memory handle of the underlying matrix, from which the solvers deduce the memory context of their work vectors */
+      viennacl::backend::mem_handle const & handle() const { return viennacl::traits::handle(A_); }
+
+      void apply(viennacl::vector_base<NumericT> const & x, viennacl::vector_base<NumericT> & y) const
+      {
+        y = viennacl::linalg::prod(A_, x);
+        y -= sigma_ * x;
+      }
+
+    private:
+      MatrixT const & A_;
+      NumericT sigma_;
+    };
+
+    shift_invert_operator(MatrixT const & A, NumericT sigma, SolverTagT const & solver_tag, PreconditionerT const & precond)
+      : A_shifted_(A, sigma), solver_tag_(solver_tag), precond_(precond) {}
+
+    /** @brief Computes y = (A - sigma I)^{-1} x */
+    void apply(viennacl::vector_base<NumericT> const & x, viennacl::vector_base<NumericT> & y) const
+    {
+      viennacl::vector<NumericT> rhs(x);
+      y = solve(A_shifted_, rhs, solver_tag_, precond_);  // unqualified, so that the solver header may be included after this one
+    }
+
+  private:
+    shifted_matrix A_shifted_;
+    SolverTagT const & solver_tag_;
+    PreconditionerT const & precond_;
+  };
+
+  /** @brief Plain products with the matrix for the standard mode */
+  template<typename MatrixT, typename NumericT>
+  class standard_operator
+  {
+  public:
+    standard_operator(MatrixT const & A) : A_(A) {}
+
+    void apply(viennacl::vector_base<NumericT> const & x, viennacl::vector_base<NumericT> & y) const { y = viennacl::linalg::prod(A_, x); }
+
+  private:
+    MatrixT const & A_;
+  };
+
+  /** @brief Orthogonalizes w against the first num_columns columns of the basis V by classical Gram-Schmidt with one reorthogonalization step (two matrix-vector products with the basis each).
+  *
+  * @return The coefficients V^T w (accumulated over both steps) on the host
+  */
+  template<typename NumericT>
+  std::vector<NumericT> trlan_orthogonalize(viennacl::matrix<NumericT, viennacl::column_major> & V, vcl_size_t num_columns,
+                                            viennacl::vector<NumericT> & w, viennacl::vector<NumericT> & h)
+  {
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_j(V, viennacl::range(0, V.size1()), viennacl::range(0, num_columns));
+    viennacl::vector_range<viennacl::vector<NumericT> > h_j(h, viennacl::range(0, num_columns));
+
+    std::vector<NumericT> coefficients(num_columns, NumericT(0));
+    std::vector<NumericT> h_host(num_columns);
+    for (vcl_size_t pass = 0; pass < 2; ++pass)
+    {
+      h_j = viennacl::linalg::prod(trans(V_j), w);
+      w -= viennacl::linalg::prod(V_j, h_j);
+
+      viennacl::copy(h_j.begin(), h_j.end(), h_host.begin());
+      for (vcl_size_t i = 0; i < num_columns; ++i)
+        coefficients[i] += h_host[i];
+    }
+    return coefficients;
+  }
+
+  /** @brief Returns true if Ritz value a is preferred over Ritz value b */
+  template<typename NumericT>
+  bool trlan_preferred(NumericT a, NumericT b, int which, bool shift_invert)
+  {
+    if (shift_invert)
+      return std::fabs(a) > std::fabs(b);
+    if (which == thick_restart_lanczos_tag::smallest_eigenvalues)
+      return a < b;
+    return a > b;
+  }
+
+  /** @brief Thick-restart Lanczos iteration for the operator op. Returns the wanted Ritz values of op and the Ritz vectors in the columns of eigenvectors_A. */
+  template<typename OperatorT, typename NumericT, typename DenseMatrixT>
+  std::vector<NumericT> thick_restart_lanczos(OperatorT const & op, vcl_size_t n, viennacl::context ctx, DenseMatrixT & eigenvectors_A,
+                                              thick_restart_lanczos_tag const & tag, bool shift_invert)
+  {
+    vcl_size_t nev = tag.num_eigenvalues();
+    vcl_size_t m   = std::min(tag.krylov_size(), n);
+    if (nev == 0 || nev + 2 > m)
+      throw std::invalid_argument("thick_restart_lanczos: Krylov size must exceed the number of eigenvalues by at least two");
+
+    vcl_size_t num_keep = nev + (m - nev) / 2;  // Ritz vectors kept at a restart
+
+    viennacl::matrix<NumericT, viennacl::column_major> V(n, m + 1, ctx);  // Krylov basis, one vector per column
+    viennacl::vector<NumericT> w(n, ctx);
+    viennacl::vector<NumericT> h(m + 1, ctx);
+    std::vector<NumericT> T(m * m, NumericT(0));  // projected matrix V^T op V, column-major
+    std::vector<NumericT> Y, theta(m);
+    std::vector<vcl_size_t> order(m);
+
+    NumericT eps = std::numeric_limits<NumericT>::epsilon();
+    NumericT T_norm = 0;
+    vcl_size_t random_seed = tag.seed();
+
+    // random start vector:
+    viennacl::linalg::fill_random(w, viennacl::tools::uniform_distribution(-1.0, 1.0), random_seed++);
+    {
+      viennacl::vector_base<NumericT> v_0(V.handle(), n, 0, 1);
+      v_0 = w / viennacl::linalg::norm_2(w);
+    }
+
+    vcl_size_t k = 0;        // number of Ritz vectors kept from the previous cycle
+    NumericT beta_m = 0;     // norm of the residual vector (column m of V)
+    vcl_size_t converged = 0;
+
+    for (vcl_size_t restart = 0; restart <= tag.max_restarts(); ++restart)
+    {
+      tag.restarts(restart);
+
+      //
+      // Step 1: Expand the basis from k+1 to m vectors
+      //
+      for (vcl_size_t j = k; j < m; ++j)
+      {
+        viennacl::vector_base<NumericT> v_j(V.handle(), n, j * V.internal_size1(), 1);
+        op.apply(v_j, w);
+
+        std::vector<NumericT> coefficients = trlan_orthogonalize(V, j + 1, w, h);
+        for (vcl_size_t i = 0; i <= j; ++i)
+        {
+          T[i + j * m] = coefficients[i];
+          T[j + i * m] = coefficients[i];
+          T_norm = std::max(T_norm, std::fabs(coefficients[i]));
+        }
+
+        NumericT beta = viennacl::linalg::norm_2(w);
+        if (beta <= eps * T_norm * NumericT(m)) // invariant subspace: continue with a random vector orthogonal to the basis
+        {
+          beta = 0;
+          viennacl::linalg::fill_random(w, viennacl::tools::uniform_distribution(-1.0, 1.0), random_seed++);
+          trlan_orthogonalize(V, j + 1, w, h);
+        }
+
+        viennacl::vector_base<NumericT> v_jplus1(V.handle(), n, (j + 1) * V.internal_size1(), 1);
+        v_jplus1 = w / viennacl::linalg::norm_2(w);
+
+        if (j + 1 < m)
+        {
+          T[(j + 1) + j * m] = beta;
+          T[j + (j + 1) * m] = beta;
+        }
+        else
+          beta_m = beta;
+      }
+
+      //
+      // Step 2: Rayleigh-Ritz on the projected matrix and convergence check
+      //
+      std::vector<NumericT> T_eig = T;
+      viennacl::linalg::detail::symmetric_jacobi_eigen(T_eig, m, Y);
+
+      for (vcl_size_t i = 0; i < m; ++i)
+      {
+        theta[i] = T_eig[i + i * m];
+        order[i] = i;
+      }
+      for (vcl_size_t i = 1; i < m; ++i) // insertion sort of the Ritz values, wanted ones first
+        for (vcl_size_t l = i; l > 0 && trlan_preferred(theta[order[l]], theta[order[l - 1]], tag.which(), shift_invert); --l)
+          std::swap(order[l], order[l - 1]);
+
+      NumericT theta_max = 0;
+      for (vcl_size_t i = 0; i < m; ++i)
+        theta_max = std::max(theta_max, std::fabs(theta[i]));
+
+      converged = 0;
+      while (converged < nev && std::fabs(beta_m * Y[(m - 1) + order[converged] * m]) <= NumericT(tag.tolerance()) * theta_max)
+        ++converged;
+      tag.num_converged(converged);
+
+      if (converged == nev || restart == tag.max_restarts())
+        break;
+
+      //
+      // Step 3: Thick restart with the num_keep wanted Ritz vectors: V_k <- V_m Y_k, v_k <- v_m, and T becomes diagonal with an arrow in row and column k
+      //
+      std::vector<std::vector<NumericT> > Y_keep_host(m, std::vector<NumericT>(num_keep));
+      for (vcl_size_t i = 0; i < m; ++i)
+        for (vcl_size_t l = 0; l < num_keep; ++l)
+          Y_keep_host[i][l] = Y[i + order[l] * m];
+
+      viennacl::matrix<NumericT, viennacl::column_major> Y_keep(m, num_keep, ctx);
+      viennacl::copy(Y_keep_host, Y_keep);
+
+      viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_m(V, viennacl::range(0, n), viennacl::range(0, m));
+      viennacl::matrix<NumericT, viennacl::column_major> ritz_vectors = viennacl::linalg::prod(V_m, Y_keep);
+      viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_keep(V, viennacl::range(0, n), viennacl::range(0, num_keep));
+      V_keep = ritz_vectors;
+
+      viennacl::vector_base<NumericT> v_m(V.handle(), n, m * V.internal_size1(), 1);
+      viennacl::vector_base<NumericT> v_k(V.handle(), n, num_keep * V.internal_size1(), 1);
+      v_k = v_m;
+
+      std::fill(T.begin(), T.end(), NumericT(0));
+      for (vcl_size_t l = 0; l < num_keep; ++l)
+      {
+        T[l + l * m] = theta[order[l]];
+        NumericT s = beta_m * Y[(m - 1) + order[l] * m];
+        T[l + num_keep * m] = s;
+        T[num_keep + l * m] = s;
+      }
+      k = num_keep;
+    }
+
+    //
+    // Step 4: Ritz vectors of the wanted Ritz values
+    //
+    std::vector<std::vector<NumericT> > Y_nev_host(m, std::vector<NumericT>(nev));
+    std::vector<NumericT> ritz_values(nev);
+    for (vcl_size_t l = 0; l < nev; ++l)
+    {
+      ritz_values[l] = theta[order[l]];
+      for (vcl_size_t i = 0; i < m; ++i)
+        Y_nev_host[i][l] = Y[i + order[l] * m];
+    }
+
+    viennacl::matrix<NumericT, viennacl::column_major> Y_nev(m, nev, ctx);
+    viennacl::copy(Y_nev_host, Y_nev);
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > V_m(V, viennacl::range(0, n), viennacl::range(0, m));
+    eigenvectors_A = viennacl::linalg::prod(V_m, Y_nev);
+
+    return ritz_values;
+  }
+}
+
+/**
+*   @brief Computes the largest or smallest eigenvalues (see thick_restart_lanczos_tag::which()) and the eigenvectors of a symmetric matrix by the thick-restart Lanczos method.
+*
+*   @param A               The symmetric system matrix. Any type supporting matrix-vector products via viennacl::linalg::prod().
+*   @param eigenvectors_A  Dense matrix of size A.size1() x tag.num_eigenvalues(), in which the eigenvectors are stored column-wise
+*   @param tag             Number of eigenvalues, Krylov size, tolerance, etc.
+*   @return                The eigenvalues, starting with the largest (or smallest)
+*/
+template<typename MatrixT, typename DenseMatrixT>
+std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, thick_restart_lanczos_tag const & tag)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type   NumericT;
+
+  detail::standard_operator<MatrixT, NumericT> op(A);
+  return detail::thick_restart_lanczos<detail::standard_operator<MatrixT, NumericT>, NumericT>(op, A.size1(), viennacl::traits::context(A), eigenvectors_A, tag, false);
+}
+
+/**
+*   @brief Computes the eigenvalues closest to the shift tag.shift() and the eigenvectors of a symmetric matrix by the thick-restart Lanczos method in shift-invert mode.
+*
+*   Each product with (A - shift * I)^{-1} is a solve of a system with A - shift * I by the iterative solver selected by solver_tag.
+*   Thus, the solver must be suitable for the shifted matrix: For interior eigenvalues, (A - shift * I) is indefinite, so use for example GMRES or BiCGStab rather than CG.
+*   The tolerance of the solver should be tighter than the tolerance of the eigensolver.
+*
+*   @param A               The symmetric system matrix. Any type supporting matrix-vector products via viennacl::linalg::prod().
+*   @param eigenvectors_A  Dense matrix of size A.size1() x tag.num_eigenvalues(), in which the eigenvectors are stored column-wise
+*   @param tag             Number of eigenvalues, Krylov size, tolerance, shift, etc.
+*   @param solver_tag      Tag of the iterative solver for the shifted systems, e.g. viennacl::linalg::gmres_tag
+*   @param precond         Preconditioner for the shifted systems
+*   @return                The eigenvalues, ordered by their distance to the shift
+*/
+template<typename MatrixT, typename DenseMatrixT, typename SolverTagT, typename PreconditionerT>
+std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, thick_restart_lanczos_tag const & tag, SolverTagT const & solver_tag, PreconditionerT const & precond)
+{
+  typedef typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type   NumericT;
+  typedef detail::shift_invert_operator<MatrixT, NumericT, SolverTagT, PreconditionerT>      OperatorType;
+
+  NumericT sigma = static_cast<NumericT>(tag.shift());
+  OperatorType op(A, sigma, solver_tag, precond);
+  std::vector<NumericT> ritz_values = detail::thick_restart_lanczos<OperatorType, NumericT>(op, A.size1(), viennacl::traits::context(A), eigenvectors_A, tag, true);
+
+  // eigenvalue lambda of A relates to the eigenvalue theta of (A - sigma I)^{-1} via theta = 1 / (lambda - sigma):
+  for (vcl_size_t i = 0; i < ritz_values.size(); ++i)
+    ritz_values[i] = sigma + NumericT(1) / ritz_values[i];
+  return ritz_values;
+}
+
+/** @brief Convenience overload of the shift-invert mode without preconditioner. */
+template<typename MatrixT, typename DenseMatrixT, typename SolverTagT>
+std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, thick_restart_lanczos_tag const & tag, SolverTagT const & solver_tag)
+{
+  return eig(A, eigenvectors_A, tag, solver_tag, viennacl::linalg::no_precond());
+}
+
+} // end namespace linalg
+} // end namespace viennacl
+#endif
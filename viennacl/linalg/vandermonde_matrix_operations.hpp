@@ -26,6 +26,7 @@
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/fft.hpp"
 #include "viennacl/linalg/opencl/vandermonde_matrix_operations.hpp"
 
@@ -52,6 +53,7 @@ namespace viennacl
       assert(mat.size1() == result.size());
       assert(mat.size2() == vec.size());
 
+      VIENNACL_PROFILE_SCOPE("vandermonde::prod", 0, 0);
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::OPENCL_MEMORY:
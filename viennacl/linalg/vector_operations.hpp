@@ -33,6 +33,7 @@
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/linalg/detail/op_executor.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -52,6 +53,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(dest) == viennacl::traits::size(src) && bool("Incompatible vector sizes in v1 = v2 (convert): size(v1) != size(v2)"));
 
+      VIENNACL_PROFILE_SCOPE("vector::convert", 0, 0);
       switch (viennacl::traits::handle(dest).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -80,6 +82,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 = v2 @ alpha: size(v1) != size(v2)"));
 
+      VIENNACL_PROFILE_SCOPE("vector::av", 2 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -111,6 +114,7 @@ namespace viennacl
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 = v2 @ alpha + v3 @ beta: size(v1) != size(v2)"));
       assert(viennacl::traits::size(vec2) == viennacl::traits::size(vec3) && bool("Incompatible vector sizes in v1 = v2 @ alpha + v3 @ beta: size(v2) != size(v3)"));
 
+      VIENNACL_PROFILE_SCOPE("vector::avbv", 3 * viennacl::tools::profiler_bytes(vec1), 3 * viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -148,6 +152,7 @@ namespace viennacl
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in v1 += v2 @ alpha + v3 @ beta: size(v1) != size(v2)"));
       assert(viennacl::traits::size(vec2) == viennacl::traits::size(vec3) && bool("Incompatible vector sizes in v1 += v2 @ alpha + v3 @ beta: size(v2) != size(v3)"));
 
+      VIENNACL_PROFILE_SCOPE("vector::avbv_v", 4 * viennacl::tools::profiler_bytes(vec1), 4 * viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -186,6 +191,7 @@ namespace viennacl
     template<typename T>
     void vector_assign(vector_base<T> & vec1, const T & alpha, bool up_to_internal_size = false)
     {
+      VIENNACL_PROFILE_SCOPE("vector::assign", viennacl::tools::profiler_bytes(vec1), 0);
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -219,6 +225,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(vec2) && bool("Incompatible vector sizes in vector_swap()"));
 
+      VIENNACL_PROFILE_SCOPE("vector::swap", 4 * viennacl::tools::profiler_bytes(vec1), 0);
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -257,6 +264,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(proxy) && bool("Incompatible vector sizes in element_op()"));
 
+      VIENNACL_PROFILE_SCOPE("vector::element_op", 3 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -290,6 +298,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(proxy) && bool("Incompatible vector sizes in element_op()"));
 
+      VIENNACL_PROFILE_SCOPE("vector::element_op", 2 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -323,6 +332,7 @@ namespace viennacl
     {
       assert(viennacl::traits::size(vec1) == viennacl::traits::size(proxy) && bool("Incompatible vector sizes in element_op()"));
 
+      VIENNACL_PROFILE_SCOPE("vector::element_op", 3 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -497,6 +507,7 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      VIENNACL_PROFILE_SCOPE("vector::inner_prod", 2 * viennacl::tools::profiler_bytes(vec1), 2 * viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -569,6 +580,7 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      VIENNACL_PROFILE_SCOPE("vector::inner_prod", 2 * viennacl::tools::profiler_bytes(vec1), 2 * viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -641,6 +653,7 @@ namespace viennacl
       assert( x.size() == y_tuple.const_at(0).size() && bool("Size mismatch") );
       assert( result.size() == y_tuple.const_size() && bool("Number of elements does not match result size") );
 
+      VIENNACL_PROFILE_SCOPE("vector::inner_prod (multiple)", double(1 + y_tuple.const_size()) * viennacl::tools::profiler_bytes(x), 2 * y_tuple.const_size() * viennacl::traits::size(x));
       switch (viennacl::traits::handle(x).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -673,6 +686,7 @@ namespace viennacl
     void norm_1_impl(vector_base<T> const & vec,
                      scalar<T> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_1", viennacl::tools::profiler_bytes(vec), 2 * viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -720,6 +734,7 @@ namespace viennacl
     void norm_1_cpu(vector_base<T> const & vec,
                     T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_1", viennacl::tools::profiler_bytes(vec), 2 * viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -767,6 +782,7 @@ namespace viennacl
     void norm_2_impl(vector_base<T> const & vec,
                      scalar<T> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_2", viennacl::tools::profiler_bytes(vec), 2 * viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -812,6 +828,7 @@ namespace viennacl
     void norm_2_cpu(vector_base<T> const & vec,
                     T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_2", viennacl::tools::profiler_bytes(vec), 2 * viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -859,6 +876,7 @@ namespace viennacl
     void norm_inf_impl(vector_base<T> const & vec,
                        scalar<T> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_inf", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -904,6 +922,7 @@ namespace viennacl
     void norm_inf_cpu(vector_base<T> const & vec,
                       T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::norm_inf", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -951,6 +970,7 @@ namespace viennacl
     template<typename T>
     vcl_size_t index_norm_inf(vector_base<T> const & vec)
     {
+      VIENNACL_PROFILE_SCOPE("vector::index_norm_inf", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -991,6 +1011,7 @@ namespace viennacl
     template<typename NumericT>
     void max_impl(vector_base<NumericT> const & vec, viennacl::scalar<NumericT> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::max", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1034,6 +1055,7 @@ namespace viennacl
     template<typename T>
     void max_cpu(vector_base<T> const & vec, T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::max", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1078,6 +1100,7 @@ namespace viennacl
     template<typename NumericT>
     void min_impl(vector_base<NumericT> const & vec, viennacl::scalar<NumericT> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::min", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1121,6 +1144,7 @@ namespace viennacl
     template<typename T>
     void min_cpu(vector_base<T> const & vec, T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::min", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1165,6 +1189,7 @@ namespace viennacl
     template<typename NumericT>
     void sum_impl(vector_base<NumericT> const & vec, viennacl::scalar<NumericT> & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::sum", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1208,6 +1233,7 @@ namespace viennacl
     template<typename T>
     void sum_cpu(vector_base<T> const & vec, T & result)
     {
+      VIENNACL_PROFILE_SCOPE("vector::sum", viennacl::tools::profiler_bytes(vec), viennacl::traits::size(vec));
       switch (viennacl::traits::handle(vec).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1260,6 +1286,7 @@ namespace viennacl
                         vector_base<T> & vec2,
                         T alpha, T beta)
     {
+      VIENNACL_PROFILE_SCOPE("vector::plane_rotation", 4 * viennacl::tools::profiler_bytes(vec1), 6 * viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1297,6 +1324,7 @@ namespace viennacl
     void inclusive_scan(vector_base<NumericT> & vec1,
                         vector_base<NumericT> & vec2)
     {
+      VIENNACL_PROFILE_SCOPE("vector::inclusive_scan", 2 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -1347,6 +1375,7 @@ namespace viennacl
     void exclusive_scan(vector_base<NumericT> & vec1,
                         vector_base<NumericT> & vec2)
     {
+      VIENNACL_PROFILE_SCOPE("vector::exclusive_scan", 2 * viennacl::tools::profiler_bytes(vec1), viennacl::traits::size(vec1));
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -382,6 +382,12 @@ struct is_any_sparse_matrix<viennacl::hyb_matrix<ScalarType, AlignmentV> >
   enum { value = true };
 };
 
+template<typename ScalarType, unsigned int BlockSize>
+struct is_any_sparse_matrix<viennacl::block_compressed_matrix<ScalarType, BlockSize> >
+{
+  enum { value = true };
+};
+
 template<typename T>
 struct is_any_sparse_matrix<const T>
 {
@@ -36,6 +36,8 @@
 #include <cmath>
 
 #include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/graph_operations.hpp"
 
 namespace viennacl
 {
@@ -605,6 +607,102 @@ std::vector<IndexT> reorder(std::vector< std::map<IndexT, ValueT> > const & matr
 }
 
 
+//
+// Part 3: Reverse Cuthill-McKee, and parallel variants operating directly on the CSR arrays of a compressed_matrix
+//
+
+/** @brief A tag class for selecting the reverse Cuthill-McKee algorithm, i.e. the Cuthill-McKee numbering in reverse order.
+*
+* The bandwidth is the same as for the Cuthill-McKee algorithm, but the profile of the matrix and the fill-in of factorizations are usually smaller.
+*/
+struct reverse_cuthill_mckee_tag {};
+
+/** @brief Function for the calculation of a node number permutation to reduce the bandwidth of an incidence matrix by the reverse Cuthill-McKee algorithm
+*
+* @param matrix  vector of n matrix rows, where each row is a map<int, double> containing only the nonzero elements
+* @return permutation vector r. r[i] is the new label of node i.
+*/
+template<typename IndexT, typename ValueT>
+std::vector<IndexT> reorder(std::vector< std::map<IndexT, ValueT> > const & matrix, reverse_cuthill_mckee_tag)
+{
+  std::vector<IndexT> permutation = reorder(matrix, cuthill_mckee_tag());
+  for (vcl_size_t i = 0; i < permutation.size(); ++i)
+    permutation[i] = static_cast<IndexT>(permutation.size() - 1) - permutation[i];
+  return permutation;
+}
+
+namespace detail
+{
+  /** @brief Cuthill-McKee numbering of the graph of a compressed_matrix. Each connected component is numbered by a level-synchronous parallel breadth-first search starting at a pseudo-peripheral node. */
+  template<typename NumericT, unsigned int AlignmentV>
+  std::vector<unsigned int> csr_cuthill_mckee(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix, bool reverse)
+  {
+    namespace hb = viennacl::linalg::host_based::detail;
+
+    hb::csr_graph g(matrix);
+    vcl_size_t n = g.size();
+
+    std::vector<vcl_size_t> degree;
+    hb::csr_graph_degrees(g, degree);
+
+    std::vector<vcl_size_t> label(n, hb::csr_unvisited());         // final position of each node
+    std::vector<vcl_size_t> scratch_label(n, hb::csr_unvisited()); // used by the search for pseudo-peripheral nodes
+    std::vector<vcl_size_t> claim(n);
+    std::vector<vcl_size_t> order;
+    std::vector<vcl_size_t> scratch_order;
+    std::vector<vcl_size_t> level_ptr;
+    order.reserve(n);
+
+    for (vcl_size_t i = 0; i < n; ++i) // each unnumbered node starts a new connected component
+    {
+      if (label[i] != hb::csr_unvisited())
+        continue;
+
+      if (degree[i] == 0) // isolated node
+      {
+        label[i] = order.size();
+        order.push_back(i);
+        continue;
+      }
+
+      vcl_size_t root = hb::csr_pseudo_peripheral_node(g, degree, i, scratch_label, claim, scratch_order, level_ptr);
+      hb::csr_bfs(g, degree, root, true, label, claim, order, level_ptr);
+    }
+
+    std::vector<unsigned int> permutation(n);
+    for (vcl_size_t i = 0; i < n; ++i)
+      permutation[i] = static_cast<unsigned int>(reverse ? n - 1 - label[i] : label[i]);
+    return permutation;
+  }
+}
+
+/** @brief Computes a bandwidth-reducing node numbering of a compressed_matrix by the Cuthill-McKee algorithm.
+*
+* In contrast to the overload for std::vector<std::map<> >, the CSR arrays are used directly and the breadth-first searches run in parallel if OpenMP is enabled.
+* The root of each connected component is a pseudo-peripheral node. The sparsity pattern is assumed to be structurally symmetric.
+* The result can be applied with viennacl::linalg::permute().
+*
+* @param matrix  The square sparse matrix. Matrices in OpenCL or CUDA memory are transferred to the host first.
+* @return permutation vector r. r[i] is the new label of node i.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix, cuthill_mckee_tag)
+{
+  return detail::csr_cuthill_mckee(matrix, false);
+}
+
+/** @brief Computes a bandwidth-reducing node numbering of a compressed_matrix by the reverse Cuthill-McKee algorithm. See the overload for cuthill_mckee_tag for details.
+*
+* @param matrix  The square sparse matrix. Matrices in OpenCL or CUDA memory are transferred to the host first.
+* @return permutation vector r. r[i] is the new label of node i.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix, reverse_cuthill_mckee_tag)
+{
+  return detail::csr_cuthill_mckee(matrix, true);
+}
+
+
 } //namespace viennacl
 
 
@@ -38,6 +38,11 @@
 
 #include "viennacl/misc/cuthill_mckee.hpp"
 
+/** @brief Maximum number of end nodes of a level structure tried as endpoints of a pseudo-diameter by the Gibbs-Poole-Stockmeyer algorithm for compressed_matrix */
+#ifndef VIENNACL_GPS_MAX_CANDIDATES
+  #define VIENNACL_GPS_MAX_CANDIDATES 5
+#endif
+
 namespace viennacl
 {
 namespace detail
@@ -421,6 +426,303 @@ std::vector<int> reorder(MatrixType const & matrix,
   return r;
 }
 
+
+namespace detail
+{
+  /** @brief Orders connected components, given as (size, offset) pairs, by decreasing size */
+  class gps_component_larger
+  {
+  public:
+    gps_component_larger(std::vector< std::pair<vcl_size_t, vcl_size_t> > const & components) : components_(components) {}
+
+    bool operator()(vcl_size_t a, vcl_size_t b) const { return components_[a].first > components_[b].first; }
+
+  private:
+    std::vector< std::pair<vcl_size_t, vcl_size_t> > const & components_;
+  };
+
+  /** @brief Appends the unnumbered neighbors of node u in level l of the GPS level structure to 'order', sorted by increasing degree */
+  inline void gps_number_neighbors(viennacl::linalg::host_based::detail::csr_graph const & g, std::vector<vcl_size_t> const & degree,
+                                   vcl_size_t u, vcl_size_t l, std::vector<vcl_size_t> const & level_of,
+                                   std::vector<vcl_size_t> & label, std::vector<vcl_size_t> & order, std::vector<vcl_size_t> & nodes)
+  {
+    unsigned int const * row_buffer = g.row_buffer();
+    unsigned int const * col_buffer = g.col_buffer();
+
+    nodes.resize(0);
+    for (unsigned int j = row_buffer[u]; j < row_buffer[u+1]; ++j)
+      if (level_of[col_buffer[j]] == l && label[col_buffer[j]] == viennacl::linalg::host_based::detail::csr_unvisited())
+        nodes.push_back(col_buffer[j]);
+    std::sort(nodes.begin(), nodes.end(), viennacl::linalg::host_based::detail::csr_degree_less(degree));
+
+    for (vcl_size_t i = 0; i < nodes.size(); ++i)
+    {
+      label[nodes[i]] = order.size();
+      order.push_back(nodes[i]);
+    }
+  }
+
+  /** @brief Gibbs-Poole-Stockmeyer numbering of the connected component of node 'seed' in the graph of a compressed_matrix.
+  *
+  * The numbering follows the implementation for std::vector<std::map<> > above, but all level structures are computed by the level-synchronous parallel breadth-first search.
+  * In the search for the endpoints of a pseudo-diameter, at most VIENNACL_GPS_MAX_CANDIDATES nodes of the last level, each with a different degree, are tried.
+  */
+  inline void gps_on_connected_component(viennacl::linalg::host_based::detail::csr_graph const & g, std::vector<vcl_size_t> const & degree, vcl_size_t seed,
+                                         std::vector<vcl_size_t> & label, std::vector<vcl_size_t> & scratch_label, std::vector<vcl_size_t> & claim,
+                                         std::vector<vcl_size_t> & depth_g, std::vector<vcl_size_t> & depth_h, std::vector<vcl_size_t> & level_of,
+                                         std::vector<vcl_size_t> & order)
+  {
+    namespace hb = viennacl::linalg::host_based::detail;
+    unsigned int const * row_buffer = g.row_buffer();
+    unsigned int const * col_buffer = g.col_buffer();
+    vcl_size_t unvisited = hb::csr_unvisited();
+
+    std::vector<vcl_size_t> order_g, level_ptr_g;
+    std::vector<vcl_size_t> order_h, level_ptr_h;
+    std::vector<vcl_size_t> candidates;
+
+    // start with a node of minimum degree in the component:
+    hb::csr_bfs(g, degree, seed, false, scratch_label, claim, order_g, level_ptr_g);
+    hb::csr_reset_labels(order_g, 0, order_g.size(), scratch_label);
+    vcl_size_t node_g = hb::csr_min_degree_node(order_g, 0, order_g.size(), degree);
+    vcl_size_t node_h = node_g;
+
+    //
+    // Step 1: Endpoints g and h of a pseudo-diameter
+    //
+    bool new_g = true;
+    while (new_g)
+    {
+      new_g = false;
+      order_g.clear();
+      hb::csr_bfs(g, degree, node_g, false, scratch_label, claim, order_g, level_ptr_g);
+      hb::csr_reset_labels(order_g, 0, order_g.size(), scratch_label);
+
+      candidates.assign(order_g.begin() + static_cast<long>(level_ptr_g[level_ptr_g.size() - 2]), order_g.end());
+      std::sort(candidates.begin(), candidates.end(), hb::csr_degree_less(degree));
+
+      vcl_size_t width_min = unvisited;
+      vcl_size_t num_tried = 0;
+      for (vcl_size_t i = 0; i < candidates.size() && num_tried < VIENNACL_GPS_MAX_CANDIDATES; ++i)
+      {
+        if (i > 0 && degree[candidates[i]] == degree[candidates[i-1]])
+          continue;
+        ++num_tried;
+
+        order_h.clear();
+        hb::csr_bfs(g, degree, candidates[i], false, scratch_label, claim, order_h, level_ptr_h);
+        hb::csr_reset_labels(order_h, 0, order_h.size(), scratch_label);
+        if (level_ptr_h.size() > level_ptr_g.size())
+        {
+          node_g = candidates[i];
+          new_g = true;
+          break;
+        }
+
+        vcl_size_t width = hb::csr_level_width(level_ptr_h);
+        if (width < width_min)
+        {
+          width_min = width;
+          node_h = candidates[i];
+        }
+      }
+    }
+
+    order_h.clear();
+    hb::csr_bfs(g, degree, node_h, false, scratch_label, claim, order_h, level_ptr_h);
+    hb::csr_reset_labels(order_h, 0, order_h.size(), scratch_label);
+
+    //
+    // Step 2: Nodes on the same level in the level structures rooted at g and h (the latter reversed) keep this level. The other nodes form the remaining graph.
+    //
+    vcl_size_t num_levels = level_ptr_g.size() - 1;
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+    {
+      for (vcl_size_t p = level_ptr_g[l]; p < level_ptr_g[l+1]; ++p)
+        depth_g[order_g[p]] = l;
+      for (vcl_size_t p = level_ptr_h[l]; p < level_ptr_h[l+1]; ++p)
+        depth_h[order_h[p]] = num_levels - 1 - l;
+    }
+
+    std::vector<vcl_size_t> level_size(num_levels, 0);
+    std::vector<vcl_size_t> remaining;
+    for (vcl_size_t p = 0; p < order_g.size(); ++p)
+    {
+      vcl_size_t v = order_g[p];
+      if (depth_g[v] == depth_h[v])
+      {
+        level_of[v] = depth_g[v];
+        ++level_size[depth_g[v]];
+      }
+      else
+      {
+        level_of[v] = unvisited;
+        remaining.push_back(v);
+      }
+    }
+
+    //
+    // Step 3: The connected components of the remaining graph, largest first, are added to the level structure resulting in the smaller width
+    //
+    std::sort(remaining.begin(), remaining.end()); // the order within the levels of order_g depends on the number of threads
+
+    std::vector<vcl_size_t> component_nodes;
+    std::vector< std::pair<vcl_size_t, vcl_size_t> > components; // (size, offset in component_nodes)
+    for (vcl_size_t i = 0; i < remaining.size(); ++i)
+    {
+      if (scratch_label[remaining[i]] != unvisited)
+        continue;
+
+      vcl_size_t offset = component_nodes.size();
+      scratch_label[remaining[i]] = 0;
+      component_nodes.push_back(remaining[i]);
+      for (vcl_size_t q = offset; q < component_nodes.size(); ++q)
+      {
+        vcl_size_t u = component_nodes[q];
+        for (unsigned int j = row_buffer[u]; j < row_buffer[u+1]; ++j)
+          if (level_of[col_buffer[j]] == unvisited && scratch_label[col_buffer[j]] == unvisited)
+          {
+            scratch_label[col_buffer[j]] = 0;
+            component_nodes.push_back(col_buffer[j]);
+          }
+      }
+      components.push_back(std::make_pair(component_nodes.size() - offset, offset));
+    }
+    hb::csr_reset_labels(component_nodes, 0, component_nodes.size(), scratch_label);
+
+    std::vector<vcl_size_t> component_index(components.size());
+    for (vcl_size_t i = 0; i < components.size(); ++i)
+      component_index[i] = i;
+    std::stable_sort(component_index.begin(), component_index.end(), gps_component_larger(components));
+
+    vcl_size_t width_g = hb::csr_level_width(level_ptr_g);
+    vcl_size_t width_h = hb::csr_level_width(level_ptr_h);
+    std::vector<vcl_size_t> added_g(num_levels, 0);
+    std::vector<vcl_size_t> added_h(num_levels, 0);
+    for (vcl_size_t c = 0; c < components.size(); ++c)
+    {
+      vcl_size_t begin = components[component_index[c]].second;
+      vcl_size_t end   = begin + components[component_index[c]].first;
+
+      for (vcl_size_t p = begin; p < end; ++p)
+      {
+        ++added_g[depth_g[component_nodes[p]]];
+        ++added_h[depth_h[component_nodes[p]]];
+      }
+
+      vcl_size_t k3 = 0;
+      vcl_size_t k4 = 0;
+      for (vcl_size_t p = begin; p < end; ++p)
+      {
+        vcl_size_t v = component_nodes[p];
+        k3 = std::max(k3, level_size[depth_g[v]] + added_g[depth_g[v]]);
+        k4 = std::max(k4, level_size[depth_h[v]] + added_h[depth_h[v]]);
+      }
+
+      bool use_g = (k3 < k4 || (k3 == k4 && width_g <= width_h));
+      for (vcl_size_t p = begin; p < end; ++p)
+      {
+        vcl_size_t v = component_nodes[p];
+        added_g[depth_g[v]] = 0;
+        added_h[depth_h[v]] = 0;
+        level_of[v] = use_g ? depth_g[v] : depth_h[v];
+      }
+      for (vcl_size_t p = begin; p < end; ++p)
+        ++level_size[level_of[component_nodes[p]]];
+    }
+
+    //
+    // Step 4: Number the nodes level by level. Within a level, neighbors of already numbered nodes are numbered first, by increasing degree.
+    //
+    std::vector<vcl_size_t> level_ptr(num_levels + 1, 0);
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+      level_ptr[l+1] = level_ptr[l] + level_size[l];
+    std::vector<vcl_size_t> level_nodes(order_g.size());
+    std::vector<vcl_size_t> next_entry(level_ptr.begin(), level_ptr.end() - 1);
+    for (vcl_size_t p = 0; p < order_g.size(); ++p)
+      level_nodes[next_entry[level_of[order_g[p]]]++] = order_g[p];
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+      std::sort(level_nodes.begin() + static_cast<long>(level_ptr[l]), level_nodes.begin() + static_cast<long>(level_ptr[l+1]), hb::csr_degree_less(degree));
+
+    std::vector<vcl_size_t> nodes;
+    vcl_size_t prev_begin = order.size();
+    vcl_size_t prev_end   = order.size();
+    for (vcl_size_t l = 0; l < num_levels; ++l)
+    {
+      vcl_size_t level_begin = order.size();
+      for (vcl_size_t p = prev_begin; p < prev_end; ++p)
+        gps_number_neighbors(g, degree, order[p], l, level_of, label, order, nodes);
+
+      vcl_size_t q = level_begin;
+      vcl_size_t cursor = level_ptr[l];
+      while (true)
+      {
+        for (; q < order.size(); ++q)
+          gps_number_neighbors(g, degree, order[q], l, level_of, label, order, nodes);
+
+        if (order.size() - level_begin == level_size[l])
+          break;
+
+        // start again at an unnumbered node of minimum degree:
+        while (label[level_nodes[cursor]] != unvisited)
+          ++cursor;
+        label[level_nodes[cursor]] = order.size();
+        order.push_back(level_nodes[cursor]);
+      }
+
+      prev_begin = level_begin;
+      prev_end   = order.size();
+    }
+  }
+}
+
+/** @brief Computes a bandwidth-reducing node numbering of a compressed_matrix by the Gibbs-Poole-Stockmeyer algorithm.
+*
+* In contrast to the overload for std::vector<std::map<> >, the CSR arrays are used directly and all breadth-first searches run in parallel if OpenMP is enabled.
+* The sparsity pattern is assumed to be structurally symmetric. The result can be applied with viennacl::linalg::permute().
+*
+* @param matrix  The square sparse matrix. Matrices in OpenCL or CUDA memory are transferred to the host first.
+* @return permutation vector r. r[i] is the new label of node i.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix, gibbs_poole_stockmeyer_tag)
+{
+  namespace hb = viennacl::linalg::host_based::detail;
+
+  hb::csr_graph g(matrix);
+  vcl_size_t n = g.size();
+
+  std::vector<vcl_size_t> degree;
+  hb::csr_graph_degrees(g, degree);
+
+  std::vector<vcl_size_t> label(n, hb::csr_unvisited());
+  std::vector<vcl_size_t> scratch_label(n, hb::csr_unvisited());
+  std::vector<vcl_size_t> claim(n);
+  std::vector<vcl_size_t> depth_g(n), depth_h(n), level_of(n);
+  std::vector<vcl_size_t> order;
+  order.reserve(n);
+
+  for (vcl_size_t i = 0; i < n; ++i) // each unnumbered node starts a new connected component
+  {
+    if (label[i] != hb::csr_unvisited())
+      continue;
+
+    if (degree[i] == 0) // isolated node
+    {
+      label[i] = order.size();
+      order.push_back(i);
+      continue;
+    }
+
+    detail::gps_on_connected_component(g, degree, i, label, scratch_label, claim, depth_g, depth_h, level_of, order);
+  }
+
+  std::vector<unsigned int> permutation(n);
+  for (vcl_size_t i = 0; i < n; ++i)
+    permutation[i] = static_cast<unsigned int>(label[i]);
+  return permutation;
+}
+
 } //namespace viennacl
 
 
@@ -0,0 +1,137 @@
+#ifndef VIENNACL_MISC_NESTED_DISSECTION_HPP
+#define VIENNACL_MISC_NESTED_DISSECTION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/nested_dissection.hpp
+*    @brief A simple nested dissection ordering based on level structures.  Experimental.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/host_based/graph_operations.hpp"
+
+namespace viennacl
+{
+
+/** @brief Tag for a nested dissection ordering using level structures as separators.
+*
+* Each connected component is split by the middle level of a level structure rooted at a pseudo-peripheral node.
+* The two remaining parts are numbered recursively, followed by the separator.
+* Parts with at most leaf_size nodes are numbered by the Cuthill-McKee algorithm.
+* In contrast to bandwidth-reducing orderings, the unknowns of each part are contiguous at all scales, which keeps the entries of the vector accessed by a block of rows in a sparse matrix-vector product within a small range.
+*/
+class nested_dissection_tag
+{
+public:
+  /** @brief CTOR
+  *
+  * @param leaf_size   Parts with at most this number of nodes are not split further
+  */
+  nested_dissection_tag(vcl_size_t leaf_size = 256) : leaf_size_(leaf_size) {}
+
+  vcl_size_t leaf_size() const { return leaf_size_; }
+  void leaf_size(vcl_size_t s) { leaf_size_ = s; }
+
+private:
+  vcl_size_t leaf_size_;
+};
+
+namespace detail
+{
+  /** @brief Appends the nested dissection ordering of the part containing node 'seed' to 'order'. Numbered nodes are labeled csr_removed() in 'mark'. */
+  inline void nested_dissection_on_part(viennacl::linalg::host_based::detail::csr_graph const & g, std::vector<vcl_size_t> const & degree,
+                                        vcl_size_t seed, vcl_size_t leaf_size,
+                                        std::vector<vcl_size_t> & mark, std::vector<vcl_size_t> & claim,
+                                        std::vector<vcl_size_t> & order)
+  {
+    namespace hb = viennacl::linalg::host_based::detail;
+
+    std::vector<vcl_size_t> part, level_ptr;
+    vcl_size_t root = hb::csr_pseudo_peripheral_node(g, degree, seed, mark, claim, part, level_ptr);
+    part.clear();
+    hb::csr_bfs(g, degree, root, true, mark, claim, part, level_ptr);
+
+    vcl_size_t num_levels = level_ptr.size() - 1;
+    if (part.size() <= leaf_size || num_levels < 3)
+    {
+      for (vcl_size_t i = 0; i < part.size(); ++i)
+        mark[part[i]] = hb::csr_removed();
+      order.insert(order.end(), part.begin(), part.end());
+      return;
+    }
+
+    // the middle level separates the levels before from the levels after:
+    vcl_size_t separator_begin = level_ptr[num_levels / 2];
+    vcl_size_t separator_end   = level_ptr[num_levels / 2 + 1];
+    hb::csr_reset_labels(part, 0, separator_begin, mark);
+    hb::csr_reset_labels(part, separator_end, part.size(), mark);
+    for (vcl_size_t i = separator_begin; i < separator_end; ++i)
+      mark[part[i]] = hb::csr_removed();
+
+    // each of the two parts may consist of several connected components:
+    for (vcl_size_t i = 0; i < part.size(); ++i)
+      if (mark[part[i]] == hb::csr_unvisited())
+        nested_dissection_on_part(g, degree, part[i], leaf_size, mark, claim, order);
+
+    order.insert(order.end(), part.begin() + static_cast<long>(separator_begin), part.begin() + static_cast<long>(separator_end));
+  }
+}
+
+/** @brief Computes a nested dissection ordering of a compressed_matrix.
+*
+* All breadth-first searches run in parallel if OpenMP is enabled. The sparsity pattern is assumed to be structurally symmetric.
+* The result can be applied with viennacl::linalg::permute().
+*
+* @param matrix  The square sparse matrix. Matrices in OpenCL or CUDA memory are transferred to the host first.
+* @param tag     Parameters of the ordering
+* @return permutation vector r. r[i] is the new label of node i.
+*/
+template<typename NumericT, unsigned int AlignmentV>
+std::vector<unsigned int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix, nested_dissection_tag const & tag)
+{
+  namespace hb = viennacl::linalg::host_based::detail;
+
+  hb::csr_graph g(matrix);
+  vcl_size_t n = g.size();
+
+  std::vector<vcl_size_t> degree;
+  hb::csr_graph_degrees(g, degree);
+
+  std::vector<vcl_size_t> mark(n, hb::csr_unvisited());
+  std::vector<vcl_size_t> claim(n);
+  std::vector<vcl_size_t> order;
+  order.reserve(n);
+
+  for (vcl_size_t i = 0; i < n; ++i)
+    if (mark[i] == hb::csr_unvisited())
+      detail::nested_dissection_on_part(g, degree, i, std::max<vcl_size_t>(tag.leaf_size(), 1), mark, claim, order);
+
+  std::vector<unsigned int> permutation(n);
+  for (vcl_size_t i = 0; i < n; ++i)
+    permutation[order[i]] = static_cast<unsigned int>(i);
+  return permutation;
+}
+
+} //namespace viennacl
+
+
+#endif
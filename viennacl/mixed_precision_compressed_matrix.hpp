@@ -0,0 +1,350 @@
+#ifndef VIENNACL_MIXED_PRECISION_COMPRESSED_MATRIX_HPP_
+#define VIENNACL_MIXED_PRECISION_COMPRESSED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/mixed_precision_compressed_matrix.hpp
+    @brief Implementation of the mixed_precision_compressed_matrix class, a CSR matrix storing its values in a narrower floating point type than the vectors it is applied to.
+*/
+
+#include <vector>
+#include <map>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/tools/reduced_precision.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+
+template<typename NumericT, unsigned int AlignmentV, typename StorageT>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, mixed_precision_compressed_matrix<NumericT, StorageT> & B);
+
+/** @brief Sparse matrix class using the CSR format with values stored in the type StorageT, while products are carried out in the type NumericT.
+*
+* Sparse matrix-vector products with compressed_matrix<double> transfer 12 bytes per nonzero.
+* Storing the values in float reduces this to 8 bytes, and to 6 bytes with 16-bit types (viennacl::bfloat16 or viennacl::half).
+* The values are converted to NumericT when they are loaded, hence vectors and accumulation remain in full precision.
+* This is well suited for matrices which are only known approximately anyway, e.g. preconditioners:
+* ilu0_precond and amg_precond accept mixed_precision_compressed_matrix in order to store their factors or operators in the narrow type.
+*
+* Products are currently only available in main memory.
+*
+* @tparam NumericT    Floating point type of the vectors and of the accumulation (either float or double, checked at compile time)
+* @tparam StorageT    Type of the stored values: float, viennacl::bfloat16, or viennacl::half
+*/
+template<typename NumericT, typename StorageT>
+class mixed_precision_compressed_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>     value_type;
+  typedef vcl_size_t                                                                                 size_type;
+  typedef StorageT                                                                                   storage_type;
+
+  /** @brief Creates an empty matrix in the given context */
+  explicit mixed_precision_compressed_matrix(viennacl::context ctx = viennacl::context()) : rows_(0), cols_(0), nonzeros_(0)
+  {
+    init_handles(ctx);
+  }
+
+  /** @brief Creates the matrix from a compressed_matrix by rounding its values to StorageT. The matrix resides in the same context. */
+  template<unsigned int AlignmentV>
+  explicit mixed_precision_compressed_matrix(viennacl::compressed_matrix<NumericT, AlignmentV> const & A) : rows_(0), cols_(0), nonzeros_(0)
+  {
+    init_handles(viennacl::traits::context(A));
+    viennacl::copy(A, *this);
+  }
+
+  /** @brief Sets the matrix from CSR arrays on the host. The values are rounded to StorageT.
+  *
+  * @param row_buffer   Row offsets, rows + 1 entries
+  * @param col_buffer   Column indices, row_buffer[rows] entries
+  * @param elements     Nonzero values in full precision, row_buffer[rows] entries
+  * @param rows         Number of rows
+  * @param cols         Number of columns
+  */
+  void set(unsigned int const * row_buffer, unsigned int const * col_buffer, NumericT const * elements, vcl_size_t rows, vcl_size_t cols)
+  {
+    rows_     = rows;
+    cols_     = cols;
+    nonzeros_ = row_buffer[rows];
+
+    std::vector<StorageT> narrow_elements(std::max<vcl_size_t>(nonzeros_, 1));
+    viennacl::linalg::host_based::detail::round_to_storage(elements, &(narrow_elements[0]), nonzeros_);
+
+    viennacl::context ctx = viennacl::traits::context(elements_);
+    std::vector<unsigned int> dummy_index(1, 0);
+    viennacl::backend::memory_create(row_buffer_, sizeof(unsigned int) * (rows + 1), ctx, row_buffer);
+    viennacl::backend::memory_create(col_buffer_, sizeof(unsigned int) * std::max<vcl_size_t>(nonzeros_, 1), ctx, nonzeros_ ? col_buffer : &(dummy_index[0]));
+    viennacl::backend::memory_create(elements_,   sizeof(StorageT) * narrow_elements.size(), ctx, &(narrow_elements[0]));
+  }
+
+  /** @brief Returns the number of rows */
+  vcl_size_t size1() const { return rows_; }
+  /** @brief Returns the number of columns */
+  vcl_size_t size2() const { return cols_; }
+  /** @brief Returns the number of nonzero entries */
+  vcl_size_t nnz() const { return nonzeros_; }
+
+  /** @brief Returns the OpenCL handle to the row index array */
+  const handle_type & handle1() const { return row_buffer_; }
+  /** @brief Returns the OpenCL handle to the column index array */
+  const handle_type & handle2() const { return col_buffer_; }
+  /** @brief Returns the OpenCL handle to the matrix entry array, holding values of type StorageT */
+  const handle_type & handle() const { return elements_; }
+
+  /** @brief Switches the memory context of the matrix.
+  *
+  * Allows for e.g. an migration of the full matrix from OpenCL memory to host memory for e.g. computing a preconditioner.
+  */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<unsigned int>(row_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<unsigned int>(col_buffer_, new_ctx);
+    viennacl::backend::switch_memory_context<StorageT>(elements_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the matrix is set up for OpenMP, OpenCL, or CUDA. */
+  viennacl::memory_types memory_context() const
+  {
+    return elements_.get_active_handle_id();
+  }
+
+private:
+  void init_handles(viennacl::context ctx)
+  {
+    handle_type * handles[3] = { &row_buffer_, &col_buffer_, &elements_ };
+    for (vcl_size_t i = 0; i < 3; ++i)
+    {
+      handles[i]->switch_active_handle_id(ctx.memory_type());
+      handles[i]->numa_policy(ctx.numa_policy(), ctx.numa_node());
+#ifdef VIENNACL_WITH_OPENCL
+      if (ctx.memory_type() == OPENCL_MEMORY)
+        handles[i]->opencl_handle().context(ctx.opencl_context());
+#endif
+    }
+  }
+
+  vcl_size_t rows_;
+  vcl_size_t cols_;
+  vcl_size_t nonzeros_;
+  handle_type row_buffer_;
+  handle_type col_buffer_;
+  handle_type elements_;
+};
+
+
+namespace detail
+{
+  /** @brief Reads the CSR arrays of a mixed_precision_compressed_matrix to the host and converts the values to NumericT, regardless of the memory it resides in. */
+  template<typename NumericT, typename StorageT>
+  void read_mixed_precision_compressed_matrix(mixed_precision_compressed_matrix<NumericT, StorageT> const & A,
+                                              std::vector<unsigned int> & row_buffer, std::vector<unsigned int> & col_buffer, std::vector<NumericT> & elements)
+  {
+    std::vector<StorageT> narrow_elements(std::max<vcl_size_t>(A.nnz(), 1));
+    row_buffer.resize(A.size1() + 1);
+    col_buffer.resize(std::max<vcl_size_t>(A.nnz(), 1));
+    elements.resize(narrow_elements.size());
+    viennacl::backend::memory_read(A.handle1(), 0, sizeof(unsigned int) * row_buffer.size(), &(row_buffer[0]));
+    viennacl::backend::memory_read(A.handle2(), 0, sizeof(unsigned int) * col_buffer.size(), &(col_buffer[0]));
+    viennacl::backend::memory_read(A.handle(),  0, sizeof(StorageT) * narrow_elements.size(), &(narrow_elements[0]));
+    for (vcl_size_t i = 0; i < A.nnz(); ++i)
+      elements[i] = static_cast<NumericT>(narrow_elements[i]);
+  }
+}
+
+
+/** @brief Copies a compressed_matrix to a mixed_precision_compressed_matrix, rounding the values to StorageT.
+*
+* The mixed_precision_compressed_matrix remains in its memory context. The values are rounded on the host.
+*/
+template<typename NumericT, unsigned int AlignmentV, typename StorageT>
+void copy(compressed_matrix<NumericT, AlignmentV> const & A, mixed_precision_compressed_matrix<NumericT, StorageT> & B)
+{
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  B.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), A.size1(), A.size2());
+}
+
+/** @brief Copies a mixed_precision_compressed_matrix to a compressed_matrix, converting the values to NumericT. The compressed_matrix remains in its memory context. */
+template<typename NumericT, typename StorageT, unsigned int AlignmentV>
+void copy(mixed_precision_compressed_matrix<NumericT, StorageT> const & A, compressed_matrix<NumericT, AlignmentV> & B)
+{
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_mixed_precision_compressed_matrix(A, row_buffer, col_buffer, elements);
+
+  B.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), A.size1(), A.size2(), A.nnz());
+}
+
+/** @brief Copies a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> > to a mixed_precision_compressed_matrix, rounding the values to StorageT.
+*
+* @param cpu_matrix   The sparse matrix on the host
+* @param B            The mixed_precision_compressed_matrix
+* @param cols         Number of columns. If zero, the largest column index plus one is used.
+*/
+template<typename NumericT, typename StorageT>
+void copy(std::vector< std::map<unsigned int, NumericT> > const & cpu_matrix, mixed_precision_compressed_matrix<NumericT, StorageT> & B, vcl_size_t cols = 0)
+{
+  std::vector<unsigned int> row_buffer(cpu_matrix.size() + 1, 0);
+  std::vector<unsigned int> col_buffer;
+  std::vector<NumericT> elements;
+  vcl_size_t max_col = 0;
+  for (vcl_size_t i = 0; i < cpu_matrix.size(); ++i)
+  {
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = cpu_matrix[i].begin(); it != cpu_matrix[i].end(); ++it)
+    {
+      col_buffer.push_back(it->first);
+      elements.push_back(it->second);
+      max_col = std::max<vcl_size_t>(max_col, it->first + 1);
+    }
+    row_buffer[i+1] = static_cast<unsigned int>(col_buffer.size());
+  }
+  if (cols == 0)
+    cols = max_col;
+  col_buffer.push_back(0); // guard against empty buffers
+  elements.push_back(0);
+
+  B.set(&(row_buffer[0]), &(col_buffer[0]), &(elements[0]), cpu_matrix.size(), cols);
+}
+
+/** @brief Copies a mixed_precision_compressed_matrix to a sparse matrix in the STL format std::vector< std::map<unsigned int, NumericT> >, converting the values to NumericT. */
+template<typename NumericT, typename StorageT>
+void copy(mixed_precision_compressed_matrix<NumericT, StorageT> const & B, std::vector< std::map<unsigned int, NumericT> > & cpu_matrix)
+{
+  std::vector<unsigned int> row_buffer, col_buffer;
+  std::vector<NumericT> elements;
+  detail::read_mixed_precision_compressed_matrix(B, row_buffer, col_buffer, elements);
+
+  cpu_matrix.clear();
+  cpu_matrix.resize(B.size1());
+  for (vcl_size_t row = 0; row < B.size1(); ++row)
+    for (unsigned int k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+      cpu_matrix[row][col_buffer[k]] = elements[k];
+}
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T, typename StorageT>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T, typename StorageT>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T, typename StorageT>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename StorageT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename StorageT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(1), lhs, T(1));
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename StorageT, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const mixed_precision_compressed_matrix<T, StorageT>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(-1), lhs, T(1));
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
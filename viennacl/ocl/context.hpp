@@ -255,7 +255,7 @@ public:
     std::cout << "ViennaCL: Adding new queue for device " << dev << " to context " << h_ << std::endl;
 #endif
       cl_int err;
-#ifdef VIENNACL_PROFILING_ENABLED
+#if defined(VIENNACL_PROFILING_ENABLED) || defined(VIENNACL_WITH_PROFILER)
     viennacl::ocl::handle<cl_command_queue> temp(clCreateCommandQueue(h_.get(), dev, CL_QUEUE_PROFILING_ENABLE, &err), *this);
 #else
     viennacl::ocl::handle<cl_command_queue> temp(clCreateCommandQueue(h_.get(), dev, 0, &err), *this);
@@ -32,6 +32,7 @@
 #include "viennacl/ocl/kernel.hpp"
 #include "viennacl/ocl/command_queue.hpp"
 #include "viennacl/ocl/context.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 namespace viennacl
 {
@@ -45,13 +46,64 @@ namespace device_specific
 namespace ocl
 {
 
+#ifdef VIENNACL_WITH_PROFILER
+namespace detail
+{
+  /** @brief Information on an enqueued kernel, passed to profiler_event_callback() */
+  struct profiler_kernel_info
+  {
+    std::string name;
+    double      enqueue_time;
+  };
+
+  /** @brief Records the execution of a kernel on the device once it has completed. Device times are aligned with host times at the time the kernel was enqueued. */
+  inline void CL_CALLBACK profiler_event_callback(cl_event event, cl_int status, void * user_data)
+  {
+    profiler_kernel_info * info = static_cast<profiler_kernel_info *>(user_data);
+
+    cl_ulong queued = 0, start = 0, end = 0;
+    if (status == CL_COMPLETE
+        && clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &queued, NULL) == CL_SUCCESS
+        && clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_START,  sizeof(cl_ulong), &start,  NULL) == CL_SUCCESS
+        && clGetEventProfilingInfo(event, CL_PROFILING_COMMAND_END,    sizeof(cl_ulong), &end,    NULL) == CL_SUCCESS)
+      viennacl::tools::profiler_record(info->name, info->enqueue_time + 1e-9 * double(start - queued), 1e-9 * double(end - start), 0, 0, true);
+
+    delete info;
+    clReleaseEvent(event);
+  }
+
+  /** @brief Registers profiler_event_callback() for the event of an enqueued kernel. Takes ownership of the event. */
+  inline void profile_kernel(std::string const & name, double enqueue_time, cl_event event)
+  {
+    profiler_kernel_info * info = new profiler_kernel_info();
+    info->name = name;
+    info->enqueue_time = enqueue_time;
+    if (clSetEventCallback(event, CL_COMPLETE, profiler_event_callback, info) != CL_SUCCESS)
+    {
+      delete info;
+      clReleaseEvent(event);
+    }
+  }
+}
+#endif
+
 /** @brief Enqueues a kernel in the provided queue */
 template<typename KernelType>
 void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
 {
-#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL) || defined(VIENNACL_WITH_PROFILER)
   cl_event event;
 #endif
+  cl_event * event_ptr = NULL;
+#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+  event_ptr = &event;
+#endif
+#ifdef VIENNACL_WITH_PROFILER
+  VIENNACL_PROFILE_SCOPE("ocl::enqueue", 0, 0);
+  double enqueue_time = viennacl::tools::profiler_time();
+  if (viennacl::tools::profiler_enabled())
+    event_ptr = &event;
+#endif
 
   // 1D kernel:
   if (k.local_work_size(1) == 0)
@@ -67,17 +119,9 @@ void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
 
     cl_int err;
     if (tmp_global == 1 && tmp_local == 1)
-#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-      err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, &event);
-#else
-      err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, NULL);
-#endif
+      err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, event_ptr);
     else
-#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-      err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, &event);
-#else
-      err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, NULL);
-#endif
+      err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, event_ptr);
 
     if (err != CL_SUCCESS)
     {
@@ -104,11 +148,7 @@ void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
     tmp_local[1] = k.local_work_size(1);
     tmp_local[2] = k.local_work_size(2);
 
-#if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-    cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, &event);
-#else
-    cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, NULL);
-#endif
+    cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, event_ptr);
     if (err != CL_SUCCESS)
     {
       //could not start kernel with any parameters
@@ -123,6 +163,11 @@ void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
   clGetEventInfo(event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &execution_status, NULL);
   std::cout << "ViennaCL: Kernel " << k.name() << " finished with status " << execution_status << "!" << std::endl;
 #endif
+
+#ifdef VIENNACL_WITH_PROFILER
+  if (viennacl::tools::profiler_enabled())
+    detail::profile_kernel(k.name(), enqueue_time, event);
+#endif
 } //enqueue()
 
 
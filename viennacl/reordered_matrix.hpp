@@ -0,0 +1,244 @@
+#ifndef VIENNACL_REORDERED_MATRIX_HPP_
+#define VIENNACL_REORDERED_MATRIX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/reordered_matrix.hpp
+    @brief Implementation of the reordered_matrix class, which stores a symmetrically permuted compressed_matrix for better cache reuse in sparse matrix-vector products.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/misc/cuthill_mckee.hpp"
+#include "viennacl/misc/gibbs_poole_stockmeyer.hpp"
+#include "viennacl/misc/nested_dissection.hpp"
+
+namespace viennacl
+{
+
+/** @brief A compressed_matrix stored in a reordered numbering of its unknowns.
+*
+* The matrix P A P^T is stored, where P is the permutation computed by viennacl::reorder() for the given tag (e.g. reverse_cuthill_mckee_tag or nested_dissection_tag) or supplied by the user.
+* Reordering clusters the column indices of each row, so that the entries of the input vector of a matrix-vector product are reused from cache (cf. viennacl::tools::spmv_vector_cache_misses()).
+*
+* Matrix-vector products with a reordered_matrix operate in the original numbering, i.e. the input vector is permuted and the result is permuted back.
+* The iterative solvers cg, bicgstab, and gmres instead permute only the right hand side and the result, so that all iterations run in the reordered numbering.
+*
+* @tparam NumericT    Floating point type (either float or double, checked at compile time)
+*/
+template<typename NumericT>
+class reordered_matrix
+{
+public:
+  typedef viennacl::backend::mem_handle                                            handle_type;
+  typedef vcl_size_t                                                               size_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>   value_type;
+
+  /** @brief Creates an empty matrix in the given context */
+  explicit reordered_matrix(viennacl::context ctx = viennacl::context()) : matrix_(ctx) {}
+
+  /** @brief Reorders the matrix A using the ordering specified by the tag */
+  template<typename TagT>
+  reordered_matrix(viennacl::compressed_matrix<NumericT> const & A, TagT const & tag) : matrix_(viennacl::traits::context(A)) { set(A, tag); }
+
+  /** @brief Reorders the matrix A using the given permutation. Entry i of 'permutation' is the new index of row and column i. */
+  reordered_matrix(viennacl::compressed_matrix<NumericT> const & A, std::vector<unsigned int> const & permutation) : matrix_(viennacl::traits::context(A)) { set(A, permutation); }
+
+  /** @brief Reorders the matrix A using the ordering specified by the tag */
+  template<typename TagT>
+  void set(viennacl::compressed_matrix<NumericT> const & A, TagT const & tag)
+  {
+    set(A, viennacl::reorder(A, tag));
+  }
+
+  /** @brief Reorders the matrix A using the given permutation. Entry i of 'permutation' is the new index of row and column i. */
+  void set(viennacl::compressed_matrix<NumericT> const & A, std::vector<unsigned int> const & permutation)
+  {
+    assert( (A.size1() == A.size2()) && bool("Reordering of a non-square matrix!"));
+    assert( (permutation.size() == A.size1()) && bool("Size of permutation does not match matrix size!"));
+
+    permutation_ = permutation;
+    inverse_permutation_.resize(permutation.size());
+    for (vcl_size_t i = 0; i < permutation.size(); ++i)
+      inverse_permutation_[permutation[i]] = static_cast<unsigned int>(i);
+
+    matrix_.switch_memory_context(viennacl::traits::context(A));
+    viennacl::linalg::permute(matrix_, A, permutation_);
+  }
+
+  /** @brief Returns the reordered matrix P A P^T. Preconditioners for the iterative solvers need to be set up for this matrix. */
+  viennacl::compressed_matrix<NumericT> const & matrix() const { return matrix_; }
+
+  /** @brief Returns the permutation. Entry i is the new index of row and column i. */
+  std::vector<unsigned int> const & permutation() const { return permutation_; }
+
+  /** @brief Returns the inverse permutation. Entry i is the original index of row and column i of matrix(). */
+  std::vector<unsigned int> const & inverse_permutation() const { return inverse_permutation_; }
+
+  /** @brief Transfers a vector from the original to the reordered numbering: y = P x */
+  void permute(viennacl::vector_base<NumericT> const & x, viennacl::vector_base<NumericT> & y) const
+  {
+    viennacl::linalg::permute(y, x, permutation_);
+  }
+
+  /** @brief Transfers a vector from the reordered to the original numbering: x = P^T y */
+  void unpermute(viennacl::vector_base<NumericT> const & y, viennacl::vector_base<NumericT> & x) const
+  {
+    viennacl::linalg::permute(x, y, inverse_permutation_);
+  }
+
+  vcl_size_t size1() const { return matrix_.size1(); }
+  vcl_size_t size2() const { return matrix_.size2(); }
+  vcl_size_t nnz()   const { return matrix_.nnz(); }
+
+  /** @brief Returns the handle to the values of the reordered matrix */
+  const handle_type & handle() const { return matrix_.handle(); }
+
+private:
+  viennacl::compressed_matrix<NumericT> matrix_;
+  std::vector<unsigned int>             permutation_;
+  std::vector<unsigned int>             inverse_permutation_;
+};
+
+
+namespace linalg
+{
+
+/** @brief Carries out the matrix-vector product result = alpha * prod(A, x) + beta * result in the original numbering of the reordered_matrix */
+template<typename NumericT>
+void prod_impl(reordered_matrix<NumericT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               NumericT alpha,
+               viennacl::vector_base<NumericT> & result,
+               NumericT beta)
+{
+  viennacl::vector<NumericT> x_reordered(x.size(), viennacl::traits::context(x));
+  viennacl::vector<NumericT> y_reordered(A.size1(), viennacl::traits::context(x));
+  A.permute(x, x_reordered);
+  viennacl::linalg::prod_impl(A.matrix(), x_reordered, NumericT(1), y_reordered, NumericT(0));
+
+  if (beta <= 0 && beta >= 0) // beta is zero, do not touch the (possibly uninitialized) entries of result
+  {
+    A.unpermute(y_reordered, result);
+    if (alpha < 1 || alpha > 1)
+      result *= alpha;
+  }
+  else
+  {
+    viennacl::vector<NumericT> y(result.size(), viennacl::traits::context(result));
+    A.unpermute(y_reordered, y);
+    result = alpha * y + beta * result;
+  }
+}
+
+/** @brief Carries out the matrix-vector product result = prod(A, x) */
+template<typename NumericT>
+void prod_impl(reordered_matrix<NumericT> const & A,
+               viennacl::vector_base<NumericT> const & x,
+               viennacl::vector_base<NumericT> & result)
+{
+  prod_impl(A, x, NumericT(1), result, NumericT(0));
+}
+
+} //namespace linalg
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // x = A * x is fine, since x is permuted to a temporary first
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+
+  // x = A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, lhs);
+    }
+  };
+
+  // x += A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(1), lhs, T(1));
+    }
+  };
+
+  // x -= A * vec_op
+  template<typename T, typename LHS, typename RHS, typename OP>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const reordered_matrix<T>, const vector_expression<const LHS, const RHS, OP>, op_prod> const & rhs)
+    {
+      viennacl::vector<T> temp(rhs.rhs(), viennacl::traits::context(rhs));
+      viennacl::linalg::prod_impl(rhs.lhs(), temp, T(-1), lhs, T(1));
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "viennacl/scheduler/execute_elementwise.hpp"
 #include "viennacl/scheduler/execute_matrix_prod.hpp"
 #include "viennacl/scheduler/execute_util.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 namespace viennacl
 {
@@ -278,6 +279,8 @@ namespace detail
 
 inline void execute(statement const & s)
 {
+  VIENNACL_PROFILE_SCOPE("scheduler::execute", 0, 0);
+
   // simply start execution from the root node:
   detail::execute_impl(s, s.array()[s.root()]);
 }
@@ -0,0 +1,318 @@
+#ifndef VIENNACL_STENCIL_OPERATOR_HPP_
+#define VIENNACL_STENCIL_OPERATOR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/stencil_operator.hpp
+    @brief Implementation of the stencil_operator class, which applies a finite difference stencil on a structured grid without assembling a matrix.
+*/
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+
+namespace viennacl
+{
+
+/** @brief The stencils supported by stencil_operator */
+enum stencil_type
+{
+  STENCIL_5_POINT_2D = 0,  ///< Center and the four neighbors in x- and y-direction
+  STENCIL_7_POINT_3D,      ///< Center and the six neighbors in x-, y-, and z-direction
+  STENCIL_27_POINT_3D      ///< Center and all 26 neighbors in the surrounding 3-by-3-by-3 cube
+};
+
+/** @brief A finite difference stencil on a structured 2D or 3D grid, which can be used instead of a sparse matrix in matrix-vector products and in the iterative solvers.
+*
+* The unknowns are numbered with x running fastest, i.e. the grid point (i, j, k) has the index i + nx * (j + ny * k), as in viennacl::tools::generate_fdm_laplace().
+* Neighbors outside the grid are dropped, which corresponds to homogeneous Dirichlet boundary conditions.
+* Each stencil point either has a constant coefficient, or the coefficients of all stencil points are stored per grid point (variable coefficients).
+* In the latter case the coefficients of a stencil point are stored contiguously for all grid points, so that the products vectorize along the x-direction.
+* Since no column indices are stored, a product transfers only the two vectors for constant coefficients.
+*
+* After construction the stencil holds the negative discrete Laplacian (e.g. 4 in the center and -1 for the neighbors of the 5-point stencil).
+* Products and the Jacobi smoother are currently only available in main memory.
+*
+* @tparam NumericT    Floating point type (either float or double, checked at compile time)
+*/
+template<typename NumericT>
+class stencil_operator
+{
+public:
+  typedef viennacl::backend::mem_handle                                                              handle_type;
+  typedef scalar<typename viennacl::tools::CHECK_SCALAR_TEMPLATE_ARGUMENT<NumericT>::ResultType>     value_type;
+  typedef vcl_size_t                                                                                 size_type;
+
+  /** @brief Creates the stencil of the given type on an nx-by-ny-by-nz grid. For STENCIL_5_POINT_2D, nz must be 1.
+  *
+  * @param type   The stencil
+  * @param nx     Number of grid points in x-direction
+  * @param ny     Number of grid points in y-direction
+  * @param nz     Number of grid points in z-direction
+  * @param ctx    The memory context of the coefficients
+  */
+  stencil_operator(stencil_type type, vcl_size_t nx, vcl_size_t ny, vcl_size_t nz = 1, viennacl::context ctx = viennacl::context())
+    : type_(type), nx_(nx), ny_(ny), nz_(nz), variable_(false)
+  {
+    assert( (type != STENCIL_5_POINT_2D || nz == 1) && bool("The 5-point stencil requires a 2D grid (nz == 1)"));
+
+    for (int dk = -1; dk <= 1; ++dk)
+      for (int dj = -1; dj <= 1; ++dj)
+        for (int di = -1; di <= 1; ++di)
+        {
+          int distance = std::abs(di) + std::abs(dj) + std::abs(dk);
+          if (type == STENCIL_27_POINT_3D || (distance <= 1 && (type == STENCIL_7_POINT_3D || dk == 0)))
+          {
+            offsets_.push_back(di);
+            offsets_.push_back(dj);
+            offsets_.push_back(dk);
+          }
+        }
+
+    std::vector<NumericT> coefficients(num_points(), NumericT(-1));
+    coefficients[point_index(0, 0, 0)] = NumericT(num_points() - 1);
+
+    coefficients_.switch_active_handle_id(ctx.memory_type());
+    coefficients_.numa_policy(ctx.numa_policy(), ctx.numa_node());
+#ifdef VIENNACL_WITH_OPENCL
+    if (ctx.memory_type() == OPENCL_MEMORY)
+      coefficients_.opencl_handle().context(ctx.opencl_context());
+#endif
+    viennacl::backend::memory_create(coefficients_, sizeof(NumericT) * coefficients.size(), ctx, &(coefficients[0]));
+  }
+
+  /** @brief Sets a constant coefficient for the stencil point with offset (di, dj, dk) from the center. */
+  void set_coefficient(int di, int dj, int dk, NumericT value)
+  {
+    std::vector<NumericT> values(variable_ ? size1() : 1, value);
+    viennacl::backend::memory_write(coefficients_, sizeof(NumericT) * point_index(di, dj, dk) * values.size(), sizeof(NumericT) * values.size(), &(values[0]));
+  }
+
+  /** @brief Sets the coefficients of the stencil point with offset (di, dj, dk) for each grid point. Switches to variable coefficients if needed.
+  *
+  * @param di, dj, dk   Offset of the stencil point from the center
+  * @param values       Coefficient for each grid point, size1() entries
+  */
+  void set_coefficients(int di, int dj, int dk, NumericT const * values)
+  {
+    vcl_size_t s = point_index(di, dj, dk);
+    if (!variable_)
+    {
+      std::vector<NumericT> constants(num_points());
+      viennacl::backend::memory_read(coefficients_, 0, sizeof(NumericT) * constants.size(), &(constants[0]));
+
+      std::vector<NumericT> coefficients(num_points() * size1());
+      for (vcl_size_t p = 0; p < num_points(); ++p)
+        std::fill(coefficients.begin() + static_cast<long>(p * size1()), coefficients.begin() + static_cast<long>((p + 1) * size1()), constants[p]);
+      std::copy(values, values + size1(), coefficients.begin() + static_cast<long>(s * size1()));
+
+      viennacl::backend::memory_create(coefficients_, sizeof(NumericT) * coefficients.size(), viennacl::traits::context(coefficients_), &(coefficients[0]));
+      variable_ = true;
+    }
+    else
+      viennacl::backend::memory_write(coefficients_, sizeof(NumericT) * s * size1(), sizeof(NumericT) * size1(), values);
+  }
+
+  /** @brief Returns the diagonal of the operator, i.e. the coefficients of the center of the stencil */
+  void diagonal(std::vector<NumericT> & diag) const
+  {
+    diag.resize(size1());
+    if (variable_)
+      viennacl::backend::memory_read(coefficients_, sizeof(NumericT) * point_index(0, 0, 0) * size1(), sizeof(NumericT) * size1(), &(diag[0]));
+    else
+    {
+      NumericT center = 0;
+      viennacl::backend::memory_read(coefficients_, sizeof(NumericT) * point_index(0, 0, 0), sizeof(NumericT), &center);
+      std::fill(diag.begin(), diag.end(), center);
+    }
+  }
+
+  /** @brief Returns the stencil type */
+  stencil_type type() const { return type_; }
+  /** @brief Returns the number of grid points in x-direction */
+  vcl_size_t size_x() const { return nx_; }
+  /** @brief Returns the number of grid points in y-direction */
+  vcl_size_t size_y() const { return ny_; }
+  /** @brief Returns the number of grid points in z-direction */
+  vcl_size_t size_z() const { return nz_; }
+  /** @brief Returns the number of rows, i.e. the number of grid points */
+  vcl_size_t size1() const { return nx_ * ny_ * nz_; }
+  /** @brief Returns the number of columns, i.e. the number of grid points */
+  vcl_size_t size2() const { return nx_ * ny_ * nz_; }
+  /** @brief Returns true if the coefficients are stored per grid point */
+  bool variable_coefficients() const { return variable_; }
+
+  /** @brief Returns the number of stencil points */
+  vcl_size_t num_points() const { return offsets_.size() / 3; }
+  /** @brief Returns the offset of the stencil point s in the direction dim (0: x, 1: y, 2: z). The stencil points are ordered lexicographically by their z-, y-, and x-offset. */
+  int offset(vcl_size_t s, vcl_size_t dim) const { return offsets_[3 * s + dim]; }
+
+  /** @brief Returns the index of the stencil point with offset (di, dj, dk) from the center */
+  vcl_size_t point_index(int di, int dj, int dk) const
+  {
+    for (vcl_size_t s = 0; s < num_points(); ++s)
+      if (offset(s, 0) == di && offset(s, 1) == dj && offset(s, 2) == dk)
+        return s;
+    assert(false && bool("Offset is not part of the stencil"));
+    return 0;
+  }
+
+  /** @brief Returns the number of nonzeros of the equivalent sparse matrix */
+  vcl_size_t nnz() const
+  {
+    vcl_size_t result = 0;
+    for (vcl_size_t s = 0; s < num_points(); ++s)
+    {
+      vcl_size_t ext_x = vcl_size_t(std::abs(offset(s, 0))), ext_y = vcl_size_t(std::abs(offset(s, 1))), ext_z = vcl_size_t(std::abs(offset(s, 2)));
+      if (ext_x < nx_ && ext_y < ny_ && ext_z < nz_)
+        result += (nx_ - ext_x) * (ny_ - ext_y) * (nz_ - ext_z);
+    }
+    return result;
+  }
+
+  /** @brief Returns the handle to the coefficients. For variable coefficients, the coefficients of stencil point s are located at s * size1(). */
+  const handle_type & handle() const { return coefficients_; }
+
+  /** @brief Switches the memory context of the coefficients */
+  void switch_memory_context(viennacl::context new_ctx)
+  {
+    viennacl::backend::switch_memory_context<NumericT>(coefficients_, new_ctx);
+  }
+
+  /** @brief Returns the current memory context to determine whether the operator is set up for OpenMP, OpenCL, or CUDA. */
+  viennacl::memory_types memory_context() const
+  {
+    return coefficients_.get_active_handle_id();
+  }
+
+private:
+  stencil_type     type_;
+  vcl_size_t       nx_;
+  vcl_size_t       ny_;
+  vcl_size_t       nz_;
+  bool             variable_;
+  std::vector<int> offsets_;
+  handle_type      coefficients_;
+};
+
+
+/** @brief Assembles the sparse matrix of a stencil_operator in the STL format std::vector< std::map<unsigned int, NumericT> >, e.g. for setting up preconditioners which require the matrix entries. */
+template<typename NumericT>
+void copy(stencil_operator<NumericT> const & A, std::vector< std::map<unsigned int, NumericT> > & cpu_matrix)
+{
+  vcl_size_t coefficient_size = A.num_points() * (A.variable_coefficients() ? A.size1() : 1);
+  std::vector<NumericT> coefficients(coefficient_size);
+  viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * coefficient_size, &(coefficients[0]));
+
+  long nx = static_cast<long>(A.size_x()), ny = static_cast<long>(A.size_y()), nz = static_cast<long>(A.size_z());
+  cpu_matrix.clear();
+  cpu_matrix.resize(A.size1());
+  for (long k = 0; k < nz; ++k)
+    for (long j = 0; j < ny; ++j)
+      for (long i = 0; i < nx; ++i)
+      {
+        long row = i + nx * (j + ny * k);
+        for (vcl_size_t s = 0; s < A.num_points(); ++s)
+        {
+          long ii = i + A.offset(s, 0), jj = j + A.offset(s, 1), kk = k + A.offset(s, 2);
+          if (ii < 0 || ii >= nx || jj < 0 || jj >= ny || kk < 0 || kk >= nz)
+            continue;
+          NumericT value = A.variable_coefficients() ? coefficients[s * A.size1() + static_cast<vcl_size_t>(row)] : coefficients[s];
+          if (value < 0 || value > 0)
+            cpu_matrix[static_cast<vcl_size_t>(row)][static_cast<unsigned int>(ii + nx * (jj + ny * kk))] = value;
+        }
+      }
+}
+
+
+//
+// Specify available operations:
+//
+
+/** \cond */
+
+namespace linalg
+{
+namespace detail
+{
+  // x = A * y
+  template<typename T>
+  struct op_executor<vector_base<T>, op_assign, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x = A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs = temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(0));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x += A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs += temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), lhs, T(1));
+    }
+  };
+
+  template<typename T>
+  struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> >
+  {
+    static void apply(vector_base<T> & lhs, vector_expression<const stencil_operator<T>, const vector_base<T>, op_prod> const & rhs)
+    {
+      // check for the special case x -= A * x
+      if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+      {
+        viennacl::vector<T> temp(lhs);
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(1), temp, T(0));
+        lhs -= temp;
+      }
+      else
+        viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), T(-1), lhs, T(1));
+    }
+  };
+
+} // namespace detail
+} // namespace linalg
+
+/** \endcond */
+}
+
+#endif
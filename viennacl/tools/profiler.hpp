@@ -0,0 +1,444 @@
+#ifndef VIENNACL_TOOLS_PROFILER_HPP_
+#define VIENNACL_TOOLS_PROFILER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/profiler.hpp
+    @brief Opt-in instrumentation of all dispatched operations: call counts, wall time, bytes moved and floating point operations.
+
+    Profiling is enabled by defining VIENNACL_WITH_PROFILER prior to any ViennaCL-includes. Otherwise, VIENNACL_PROFILE_SCOPE() expands to nothing and its arguments are never evaluated.
+    Records are collected per thread without locking, and aggregated by profiler_summary(), print_profiler_summary() and write_chrome_trace().
+    With the OpenCL backend, the device execution time of each kernel is obtained from OpenCL profiling events.
+*/
+
+#include "viennacl/forwards.h"
+
+#ifdef VIENNACL_WITH_PROFILER
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WINDOWS_LEAN_AND_MEAN
+#include <windows.h>
+#undef min
+#undef max
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+/** @brief Maximum number of trace events kept per thread. Further calls are only counted in the summary. */
+#ifndef VIENNACL_PROFILER_MAX_EVENTS
+ #define VIENNACL_PROFILER_MAX_EVENTS 1000000
+#endif
+
+#define VIENNACL_PROFILER_CONCAT_IMPL(a, b) a##b
+#define VIENNACL_PROFILER_CONCAT(a, b)      VIENNACL_PROFILER_CONCAT_IMPL(a, b)
+
+/** @brief Records the enclosing scope under the given name (a string literal), together with the estimated number of bytes moved and floating point operations */
+#define VIENNACL_PROFILE_SCOPE(NAME, BYTES, FLOPS) \
+  viennacl::tools::profiler_scope VIENNACL_PROFILER_CONCAT(viennacl_profiler_scope_, __LINE__)(NAME, \
+    viennacl::tools::profiler_enabled() ? double(BYTES) : 0.0, viennacl::tools::profiler_enabled() ? double(FLOPS) : 0.0)
+
+namespace viennacl
+{
+namespace tools
+{
+
+/** @brief Aggregated counters of one operation */
+struct profiler_counters
+{
+  profiler_counters() : calls(0), time(0), bytes(0), flops(0) {}
+
+  vcl_size_t calls;
+  double     time;   //in seconds
+  double     bytes;
+  double     flops;
+};
+
+namespace detail
+{
+  /** @brief A single timed call. Device events are the execution of kernels as reported by the compute device. */
+  struct profiler_event
+  {
+    char const * name;
+    double       begin;      //seconds since the profiler epoch
+    double       duration;
+    double       bytes;
+    double       flops;
+    bool         device;
+  };
+
+  struct profiler_thread_data
+  {
+    profiler_thread_data(vcl_size_t id) : thread_id(id) {}
+
+    vcl_size_t                                    thread_id;
+    std::map<char const *, profiler_counters>     counters;
+    std::map<char const *, profiler_counters>     device_counters;
+    std::vector<profiler_event>                   events;
+  };
+
+  /** @brief Minimal mutex, only used when threads are registered and names are interned */
+  class profiler_mutex
+  {
+  public:
+#ifdef _WIN32
+    profiler_mutex()  { InitializeCriticalSection(&cs_); }
+    ~profiler_mutex() { DeleteCriticalSection(&cs_); }
+    void lock()   { EnterCriticalSection(&cs_); }
+    void unlock() { LeaveCriticalSection(&cs_); }
+  private:
+    CRITICAL_SECTION cs_;
+#else
+    profiler_mutex()  { pthread_mutex_init(&mutex_, NULL); }
+    ~profiler_mutex() { pthread_mutex_destroy(&mutex_); }
+    void lock()   { pthread_mutex_lock(&mutex_); }
+    void unlock() { pthread_mutex_unlock(&mutex_); }
+  private:
+    pthread_mutex_t mutex_;
+#endif
+  };
+
+  /** @brief Returns the time in seconds of a monotonic clock */
+  inline double profiler_clock()
+  {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return double(now.QuadPart) / double(freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) + 1e-9 * double(ts.tv_nsec);
+#endif
+  }
+
+  /** @brief Owns the records of all threads. The template parameter is only introduced for linkage reasons, never use a value other than the default. */
+  template<bool dummy = false>
+  class profiler_registry
+  {
+  public:
+    profiler_registry() : enabled_(true), epoch_(profiler_clock()) {}
+
+    ~profiler_registry()
+    {
+      for (vcl_size_t i=0; i<threads_.size(); ++i)
+        delete threads_[i];
+    }
+
+    static profiler_registry & instance()
+    {
+      static profiler_registry registry;
+      return registry;
+    }
+
+    profiler_thread_data * register_thread()
+    {
+      mutex_.lock();
+      threads_.push_back(new profiler_thread_data(threads_.size()));
+      profiler_thread_data * data = threads_.back();
+      mutex_.unlock();
+      return data;
+    }
+
+    /** @brief Returns a pointer to a copy of the name which remains valid for the lifetime of the profiler */
+    char const * intern(std::string const & name)
+    {
+      mutex_.lock();
+      char const * result = names_.insert(name).first->c_str();
+      mutex_.unlock();
+      return result;
+    }
+
+    double now() const { return profiler_clock() - epoch_; }
+
+    bool enabled() const { return enabled_; }
+    void enabled(bool b) { enabled_ = b; }
+
+    std::vector<profiler_thread_data *> const & threads() const { return threads_; }
+
+    void reset()
+    {
+      mutex_.lock();
+      for (vcl_size_t i=0; i<threads_.size(); ++i)
+      {
+        threads_[i]->counters.clear();
+        threads_[i]->device_counters.clear();
+        threads_[i]->events.clear();
+      }
+      epoch_ = profiler_clock();
+      mutex_.unlock();
+    }
+
+  private:
+    bool                                   enabled_;
+    double                                 epoch_;
+    profiler_mutex                         mutex_;
+    std::vector<profiler_thread_data *>    threads_;
+    std::set<std::string>                  names_;
+  };
+
+  /** @brief Returns the records of the calling thread */
+  inline profiler_thread_data & profiler_local_data()
+  {
+#ifdef _MSC_VER
+    static __declspec(thread) profiler_thread_data * data = NULL;
+#else
+    static __thread profiler_thread_data * data = NULL;
+#endif
+    if (!data)
+      data = profiler_registry<>::instance().register_thread();
+    return *data;
+  }
+
+  inline void json_escape(std::ostream & os, char const * str)
+  {
+    for (; *str; ++str)
+    {
+      if (*str == '"' || *str == '\\')
+        os << '\\';
+      os << *str;
+    }
+  }
+
+  inline bool profiler_time_greater(std::pair<std::string, profiler_counters> const & a, std::pair<std::string, profiler_counters> const & b)
+  {
+    return a.second.time > b.second.time;
+  }
+}
+
+/** @brief Returns true if records are collected. Enabled by default. */
+inline bool profiler_enabled() { return detail::profiler_registry<>::instance().enabled(); }
+
+/** @brief Enables or disables the collection of records at runtime */
+inline void enable_profiler(bool b = true) { detail::profiler_registry<>::instance().enabled(b); }
+
+/** @brief Discards all records collected so far. Must not be called while operations are running in other threads. */
+inline void reset_profiler() { detail::profiler_registry<>::instance().reset(); }
+
+/** @brief Adds a record for a call of the given duration. Operations run on compute devices are flagged with 'device'. */
+inline void profiler_record(char const * name, double begin, double duration, double bytes, double flops, bool device = false)
+{
+  detail::profiler_thread_data & data = detail::profiler_local_data();
+
+  profiler_counters & c = device ? data.device_counters[name] : data.counters[name];
+  c.calls += 1;
+  c.time  += duration;
+  c.bytes += bytes;
+  c.flops += flops;
+
+  if (data.events.size() < VIENNACL_PROFILER_MAX_EVENTS)
+  {
+    detail::profiler_event e;
+    e.name = name; e.begin = begin; e.duration = duration; e.bytes = bytes; e.flops = flops; e.device = device;
+    data.events.push_back(e);
+  }
+}
+
+/** @brief Same as above, for names which are not string literals (e.g. the name of an OpenCL kernel) */
+inline void profiler_record(std::string const & name, double begin, double duration, double bytes, double flops, bool device = false)
+{
+  profiler_record(detail::profiler_registry<>::instance().intern(name), begin, duration, bytes, flops, device);
+}
+
+/** @brief Returns the time in seconds since the profiler was started or reset */
+inline double profiler_time() { return detail::profiler_registry<>::instance().now(); }
+
+/** @brief Records the lifetime of the object. Usually created through VIENNACL_PROFILE_SCOPE(). */
+class profiler_scope
+{
+public:
+  profiler_scope(char const * name, double bytes, double flops) : name_(name), bytes_(bytes), flops_(flops), begin_(-1)
+  {
+    if (profiler_enabled())
+      begin_ = profiler_time();
+  }
+
+  ~profiler_scope()
+  {
+    if (begin_ >= 0)
+      profiler_record(name_, begin_, profiler_time() - begin_, bytes_, flops_);
+  }
+
+private:
+  profiler_scope(profiler_scope const &);
+  profiler_scope & operator=(profiler_scope const &);
+
+  char const * name_;
+  double       bytes_;
+  double       flops_;
+  double       begin_;
+};
+
+/** @brief Returns the counters of each operation, aggregated over all threads. Kernels executed on compute devices are prefixed with 'device:'. */
+inline std::map<std::string, profiler_counters> profiler_summary()
+{
+  std::map<std::string, profiler_counters> result;
+  std::vector<detail::profiler_thread_data *> const & threads = detail::profiler_registry<>::instance().threads();
+
+  for (vcl_size_t i=0; i<threads.size(); ++i)
+  {
+    for (int device = 0; device < 2; ++device)
+    {
+      std::map<char const *, profiler_counters> const & counters = device ? threads[i]->device_counters : threads[i]->counters;
+      for (std::map<char const *, profiler_counters>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+      {
+        profiler_counters & c = result[device ? std::string("device:") + it->first : std::string(it->first)];
+        c.calls += it->second.calls;
+        c.time  += it->second.time;
+        c.bytes += it->second.bytes;
+        c.flops += it->second.flops;
+      }
+    }
+  }
+  return result;
+}
+
+/** @brief Prints the aggregated counters as a table sorted by total time. Times of nested operations are included in the time of the enclosing operation. */
+inline void print_profiler_summary(std::ostream & os)
+{
+  std::map<std::string, profiler_counters> summary = profiler_summary();
+  std::vector<std::pair<std::string, profiler_counters> > entries(summary.begin(), summary.end());
+  std::sort(entries.begin(), entries.end(), detail::profiler_time_greater);
+
+  std::ostringstream ss;
+  ss << std::left << std::setw(40) << "Operation" << std::right
+     << std::setw(10) << "Calls" << std::setw(14) << "Total [ms]" << std::setw(14) << "Mean [us]"
+     << std::setw(12) << "GB/sec" << std::setw(12) << "GFLOPs" << std::endl;
+  ss << std::fixed;
+  for (vcl_size_t i=0; i<entries.size(); ++i)
+  {
+    profiler_counters const & c = entries[i].second;
+    ss << std::left << std::setw(40) << entries[i].first << std::right
+       << std::setw(10) << c.calls
+       << std::setw(14) << std::setprecision(3) << 1e3 * c.time
+       << std::setw(14) << std::setprecision(2) << 1e6 * c.time / double(c.calls)
+       << std::setw(12) << std::setprecision(2) << (c.time > 0 ? 1e-9 * c.bytes / c.time : 0.0)
+       << std::setw(12) << std::setprecision(2) << (c.time > 0 ? 1e-9 * c.flops / c.time : 0.0) << std::endl;
+  }
+  os << ss.str();
+}
+
+/** @brief Writes all recorded calls in the Chrome trace event format (JSON), which can be viewed with chrome://tracing or Perfetto.
+  *
+  * Host threads are shown in process 0, kernel executions on compute devices in process 1.
+  */
+inline void write_chrome_trace(std::ostream & os)
+{
+  std::vector<detail::profiler_thread_data *> const & threads = detail::profiler_registry<>::instance().threads();
+
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"traceEvents\":[" << std::endl;
+  ss << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Host\"}}," << std::endl;
+  ss << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Device\"}}";
+  for (vcl_size_t i=0; i<threads.size(); ++i)
+  {
+    std::vector<detail::profiler_event> const & events = threads[i]->events;
+    for (vcl_size_t j=0; j<events.size(); ++j)
+    {
+      ss << "," << std::endl << "{\"name\":\"";
+      detail::json_escape(ss, events[j].name);
+      ss << "\",\"cat\":\"viennacl\",\"ph\":\"X\",\"ts\":" << 1e6 * events[j].begin << ",\"dur\":" << 1e6 * events[j].duration
+         << ",\"pid\":" << (events[j].device ? 1 : 0) << ",\"tid\":" << threads[i]->thread_id
+         << ",\"args\":{\"bytes\":" << std::setprecision(0) << events[j].bytes << ",\"flops\":" << events[j].flops << "}}" << std::setprecision(3);
+    }
+  }
+  ss << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+  os << ss.str();
+}
+
+/** @brief Writes all recorded calls in the Chrome trace event format to the given file */
+inline void write_chrome_trace(std::string const & filename)
+{
+  std::ofstream file(filename.c_str());
+  write_chrome_trace(file);
+}
+
+
+/** @brief Number of bytes of the entries of a vector, for estimates passed to VIENNACL_PROFILE_SCOPE() */
+template<typename NumericT>
+double profiler_bytes(vector_base<NumericT> const & v) { return double(v.size()) * double(sizeof(NumericT)); }
+
+/** @brief Number of bytes of the entries of a dense matrix, for estimates passed to VIENNACL_PROFILE_SCOPE() */
+template<typename NumericT>
+double profiler_bytes(matrix_base<NumericT> const & A) { return double(A.size1()) * double(A.size2()) * double(sizeof(NumericT)); }
+
+/** @brief Number of bytes of the entries of a transposed dense matrix */
+template<typename NumericT>
+double profiler_bytes(matrix_expression<const matrix_base<NumericT>, const matrix_base<NumericT>, op_trans> const & A) { return profiler_bytes(A.lhs()); }
+
+/** @brief Number of nonzeros of a sparse matrix. Zero for formats which do not provide it. */
+template<typename SparseMatrixT>
+double profiler_nnz(SparseMatrixT const &) { return 0; }
+
+template<typename NumericT, unsigned int AlignmentV>
+double profiler_nnz(compressed_matrix<NumericT, AlignmentV> const & A) { return double(A.nnz()); }
+
+template<typename NumericT>
+double profiler_nnz(compressed_compressed_matrix<NumericT> const & A) { return double(A.nnz()); }
+
+template<typename NumericT, unsigned int AlignmentV>
+double profiler_nnz(coordinate_matrix<NumericT, AlignmentV> const & A) { return double(A.nnz()); }
+
+template<typename NumericT, unsigned int AlignmentV>
+double profiler_nnz(ell_matrix<NumericT, AlignmentV> const & A) { return double(A.nnz()); }
+
+template<typename NumericT, unsigned int AlignmentV>
+double profiler_nnz(hyb_matrix<NumericT, AlignmentV> const & A) { return double(A.ell_nnz() * A.size1() + A.csr_nnz()); }
+
+template<typename NumericT, unsigned int BlockSize>
+double profiler_nnz(block_compressed_matrix<NumericT, BlockSize> const & A) { return double(A.nnz()); }
+
+template<typename NumericT, typename OffsetT>
+double profiler_nnz(index_compressed_matrix<NumericT, OffsetT> const & A) { return double(A.nnz()); }
+
+template<typename NumericT, typename StorageT>
+double profiler_nnz(mixed_precision_compressed_matrix<NumericT, StorageT> const & A) { return double(A.nnz()); }
+
+template<typename NumericT>
+double profiler_nnz(stencil_operator<NumericT> const & A) { return double(A.nnz()); }
+
+/** @brief Number of bytes of the nonzeros of a sparse matrix with their column indices and row offsets */
+template<typename NumericT, typename SparseMatrixT>
+double profiler_sparse_bytes(SparseMatrixT const & A)
+{
+  return profiler_nnz(A) * double(sizeof(NumericT) + sizeof(unsigned int)) + double(A.size1() + 1) * double(sizeof(unsigned int));
+}
+
+} //namespace tools
+} //namespace viennacl
+
+#else
+
+/** @brief Expands to nothing if profiling is disabled */
+#define VIENNACL_PROFILE_SCOPE(NAME, BYTES, FLOPS)
+
+#endif
+
+#endif
@@ -18,16 +18,22 @@
    License:         MIT (X11), see file LICENSE in the base directory
 ============================================================================= */
 
-#include <ctime>
-#include <cstdlib>
 #include <cmath>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "viennacl/forwards.h"
 
 
 /** @file   viennacl/tools/random.hpp
- *  @brief  A small collection of sequential random number generators.
+ *  @brief  Counter-based random number generation based on Philox4x32-10.
+ *
+ *  Philox4x32-10 (Salmon et al., 'Parallel random numbers: as easy as 1, 2, 3', SC'11) maps a 128-bit counter and a 64-bit key (the seed) to 128 random bits.
+ *  The k-th random number of a stream is computed from the counter k / (numbers per block) only, hence arbitrary parts of a stream can be generated independently of each other.
+ *  This is used by viennacl::linalg::fill_random() to obtain the same values irrespective of the number of threads and of the compute backend.
  *
- *  Should not be considered a source of high-quality random numbers.
- *  It is, however, enough to produce meaningful initial guesses.
+ *  Each call of Philox4x32-10 yields four random numbers of type float or two random numbers of type double.
  */
 
 namespace viennacl
@@ -35,50 +41,255 @@ namespace viennacl
 namespace tools
 {
 
-/** @brief Random number generator for returning uniformly distributed values in the closed interval [0, 1]
+/** @brief The distributions supported by the random number generators */
+enum random_distribution_type
+{
+  RANDOM_UNIFORM_DISTRIBUTION = 0,
+  RANDOM_NORMAL_DISTRIBUTION
+};
+
+/** @brief Base class for the description of a distribution of random numbers. Use uniform_distribution or normal_distribution instead. */
+class random_distribution
+{
+public:
+  random_distribution(random_distribution_type t, double p1, double p2) : type_(t), param1_(p1), param2_(p2) {}
+
+  /** @brief Returns the type of the distribution */
+  random_distribution_type type() const { return type_; }
+  /** @brief Returns the first parameter: The lower bound for uniform distributions, the mean for normal distributions */
+  double param1() const { return param1_; }
+  /** @brief Returns the second parameter: The upper bound for uniform distributions, the standard deviation for normal distributions */
+  double param2() const { return param2_; }
+
+private:
+  random_distribution_type type_;
+  double param1_;
+  double param2_;
+};
+
+/** @brief Uniform distribution in the half-open interval [a, b) */
+class uniform_distribution : public random_distribution
+{
+public:
+  uniform_distribution(double a = 0.0, double b = 1.0) : random_distribution(RANDOM_UNIFORM_DISTRIBUTION, a, b) {}
+};
+
+/** @brief Normal distribution with given mean and standard deviation */
+class normal_distribution : public random_distribution
+{
+public:
+  normal_distribution(double mean = 0.0, double sigma = 1.0) : random_distribution(RANDOM_NORMAL_DISTRIBUTION, mean, sigma) {}
+};
+
+
+namespace detail
+{
+  /** @brief Computes the high and the low 32 bits of the product of two 32-bit unsigned integers */
+  inline void philox_mulhilo(unsigned int a, unsigned int b, unsigned int & hi, unsigned int & lo)
+  {
+    if (sizeof(vcl_size_t) >= 8)
+    {
+      vcl_size_t product = vcl_size_t(a) * vcl_size_t(b);
+      lo = static_cast<unsigned int>(product);
+      hi = static_cast<unsigned int>((product >> 16) >> 16);
+    }
+    else // 32-bit platforms: compose from 16-bit products
+    {
+      unsigned int a_lo = a & 0xFFFF, a_hi = a >> 16;
+      unsigned int b_lo = b & 0xFFFF, b_hi = b >> 16;
+      unsigned int p_ll = a_lo * b_lo, p_lh = a_lo * b_hi, p_hl = a_hi * b_lo;
+      unsigned int mid = (p_ll >> 16) + (p_lh & 0xFFFF) + (p_hl & 0xFFFF);
+      lo = a * b;
+      hi = a_hi * b_hi + (p_lh >> 16) + (p_hl >> 16) + (mid >> 16);
+    }
+  }
+
+  /** @brief Philox4x32-10: Maps the counter 'ctr' and the key 'key' to the four 32-bit random numbers in 'result' */
+  inline void philox4x32_10(unsigned int const * ctr, unsigned int const * key, unsigned int * result)
+  {
+    unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    unsigned int k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round)
+    {
+      unsigned int hi0, lo0, hi1, lo1;
+      philox_mulhilo(0xD2511F53u, c0, hi0, lo0);
+      philox_mulhilo(0xCD9E8D57u, c2, hi1, lo1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+    result[0] = c0; result[1] = c1; result[2] = c2; result[3] = c3;
+  }
+
+  /** @brief Number of random values of type NumericT obtained from one Philox4x32-10 block: Four for float, two for double */
+  template<typename NumericT>
+  struct random_values_per_block { enum { value = 2 }; };
+
+  template<>
+  struct random_values_per_block<float> { enum { value = 4 }; };
+
+  /** @brief Uniformly distributed value in [0, 1) for lane 'lane' of a Philox block. Uses 24 random bits for float and 53 random bits for double. */
+  inline float random_uniform_lane(unsigned int const * words, unsigned int lane, float)
+  {
+    return float(words[lane] >> 8) * (1.0f / 16777216.0f);
+  }
+
+  inline double random_uniform_lane(unsigned int const * words, unsigned int lane, double)
+  {
+    return (double(words[2*lane] >> 5) * 67108864.0 + double(words[2*lane+1] >> 6)) * (1.0 / 9007199254740992.0);
+  }
+
+  template<typename NumericT>
+  double random_uniform_lane(unsigned int const * words, unsigned int lane, NumericT)
+  {
+    return random_uniform_lane(words, lane, double());
+  }
+
+  /** @brief Computes the random values of the Philox block with index 'block' for the given seed and distribution.
+   *
+   *  Normally distributed values are obtained from pairs of lanes via the Box-Muller transformation:
+   *  https://en.wikipedia.org/wiki/Box%E2%80%93Muller_transform
+   */
+  template<typename NumericT>
+  void random_block(vcl_size_t block, vcl_size_t seed, random_distribution const & dist, NumericT * values)
+  {
+    unsigned int ctr[4] = { static_cast<unsigned int>(block), static_cast<unsigned int>((block >> 16) >> 16), 0, 0 };
+    unsigned int key[2] = { static_cast<unsigned int>(seed),  static_cast<unsigned int>((seed >> 16) >> 16) };
+    unsigned int words[4];
+    philox4x32_10(ctr, key, words);
+
+    NumericT p1 = static_cast<NumericT>(dist.param1());
+    NumericT p2 = static_cast<NumericT>(dist.param2());
+    unsigned int lanes = random_values_per_block<NumericT>::value;
+    if (dist.type() == RANDOM_NORMAL_DISTRIBUTION)
+    {
+      for (unsigned int lane = 0; lane < lanes; lane += 2)
+      {
+        NumericT u = static_cast<NumericT>(random_uniform_lane(words, lane,     NumericT()));
+        NumericT v = static_cast<NumericT>(random_uniform_lane(words, lane + 1, NumericT()));
+        NumericT r     = std::sqrt(NumericT(-2) * std::log(NumericT(1) - u));
+        NumericT angle = NumericT(6.28318530717958647692) * v;
+        values[lane]     = p1 + p2 * r * std::cos(angle);
+        values[lane + 1] = p1 + p2 * r * std::sin(angle);
+      }
+    }
+    else
+    {
+      for (unsigned int lane = 0; lane < lanes; ++lane)
+        values[lane] = p1 + (p2 - p1) * static_cast<NumericT>(random_uniform_lane(words, lane, NumericT()));
+    }
+  }
+
+  /** @brief Provides distinct default seeds for sequential generators. The template parameter is only introduced for linkage reasons, never use a value other than the default.
+   *
+   *  The counter is incremented atomically with GCC-compatible compilers and MSVC, so generators created concurrently by several threads obtain distinct seeds.
+   *  With other compilers, pass explicit seeds to generators created concurrently.
+   */
+  template<bool dummy = false>
+  struct random_default_seed
+  {
+    static vcl_size_t next() { return 0x5EED + 0x9E3779B9u * increment(); }
+
+  private:
+    /** @brief Increments the counter and returns its previous value */
+    static vcl_size_t increment()
+    {
+#if defined(__GNUC__)
+      return static_cast<vcl_size_t>(__sync_fetch_and_add(&counter_, 1L));
+#elif defined(_MSC_VER)
+      return static_cast<vcl_size_t>(_InterlockedIncrement(&counter_) - 1);
+#else
+      return static_cast<vcl_size_t>(counter_++);
+#endif
+    }
+
+    static long volatile counter_;
+  };
+
+  template<bool dummy>
+  long volatile random_default_seed<dummy>::counter_ = 0;
+
+
+  /** @brief Sequential generator returning the random stream for a given seed and distribution value by value.
+   *
+   *  The k-th value returned is identical to the k-th entry of a vector filled by viennacl::linalg::fill_random() with the same seed and distribution.
+   */
+  template<typename NumericT>
+  class random_stream
+  {
+  public:
+    random_stream(random_distribution const & dist, vcl_size_t seed) : dist_(dist), seed_(seed), index_(0) {}
+
+    NumericT next() const
+    {
+      vcl_size_t lanes = random_values_per_block<NumericT>::value;
+      vcl_size_t lane  = index_ % lanes;
+      if (lane == 0)
+        random_block(index_ / lanes, seed_, dist_, values_);
+      ++index_;
+      return values_[lane];
+    }
+
+    vcl_size_t seed() const { return seed_; }
+
+  private:
+    random_distribution dist_;
+    vcl_size_t seed_;
+    mutable vcl_size_t index_;
+    mutable NumericT values_[4];
+  };
+}
+
+
+/** @brief Random number generator for returning uniformly distributed values in the half-open interval [0, 1)
  *
- *  Currently based on rand(), which may have fairly poor quality.
- *  To be replaced in the future, but serves the purpose for the time being.
+ *  Returns the stream of the counter-based generator Philox4x32-10 for the given seed.
+ *  If no seed is provided, each generator object uses a different seed.
  */
 template<typename NumericT>
 class uniform_random_numbers
 {
 public:
-  NumericT operator()() const { return static_cast<NumericT>(double(rand()) / double(RAND_MAX)); }
+  uniform_random_numbers() : stream_(uniform_distribution(), detail::random_default_seed<>::next()) {}
+  explicit uniform_random_numbers(vcl_size_t seed) : stream_(uniform_distribution(), seed) {}
+
+  NumericT operator()() const { return stream_.next(); }
+
+  /** @brief Returns the seed of the generator */
+  vcl_size_t seed() const { return stream_.seed(); }
+
+private:
+  detail::random_stream<NumericT> stream_;
 };
 
 
 /** @brief Random number generator for returning normally distributed values
   *
-  * Implementation based on Box-Muller transformation:
-  * https://en.wikipedia.org/wiki/Box%E2%80%93Muller_transform
+  * Returns the stream of the counter-based generator Philox4x32-10 for the given seed, transformed by the Box-Muller transformation.
+  * If no seed is provided, each generator object uses a different seed.
   */
 template<typename NumericT>
 class normal_random_numbers
 {
 public:
-  normal_random_numbers(NumericT mean = NumericT(0), NumericT sigma = NumericT(1)) : mean_(mean), sigma_(sigma) {}
+  normal_random_numbers(NumericT mean = NumericT(0), NumericT sigma = NumericT(1))
+    : stream_(normal_distribution(mean, sigma), detail::random_default_seed<>::next()) {}
+  normal_random_numbers(NumericT mean, NumericT sigma, vcl_size_t seed)
+    : stream_(normal_distribution(mean, sigma), seed) {}
 
-  NumericT operator()() const
-  {
-    NumericT u = 0;
-    while (std::fabs(u) <= 0 || u >= NumericT(1))
-     u = static_cast<NumericT>(double(rand()) / double(RAND_MAX));
-
-    NumericT v = 0;
-    while (std::fabs(v) <= 0 || v >= NumericT(1))
-     v = static_cast<NumericT>(double(rand()) / double(RAND_MAX));
+  NumericT operator()() const { return stream_.next(); }
 
-    return mean_ + sigma_ * std::sqrt(NumericT(-2) * std::log(u)) * std::cos(NumericT(6.28318530717958647692) * v);
-  }
+  /** @brief Returns the seed of the generator */
+  vcl_size_t seed() const { return stream_.seed(); }
 
 private:
-  NumericT mean_;
-  NumericT sigma_;
+  detail::random_stream<NumericT> stream_;
 };
 
 }
 }
 
 #endif
-
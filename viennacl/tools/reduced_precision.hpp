@@ -0,0 +1,149 @@
+#ifndef VIENNACL_TOOLS_REDUCED_PRECISION_HPP_
+#define VIENNACL_TOOLS_REDUCED_PRECISION_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/reduced_precision.hpp
+    @brief 16-bit floating point storage types (bfloat16 and IEEE half precision) for the values of sparse matrices.
+
+    The types only provide the conversion from and to float, with rounding to nearest even. Arithmetic is carried out after conversion to float or double.
+*/
+
+#include <cstring>
+#include <cmath>
+
+namespace viennacl
+{
+
+namespace detail
+{
+  inline unsigned int float_as_bits(float f)
+  {
+    unsigned int bits;
+    std::memcpy(&bits, &f, sizeof(float));
+    return bits;
+  }
+
+  inline float bits_as_float(unsigned int bits)
+  {
+    float f;
+    std::memcpy(&f, &bits, sizeof(float));
+    return f;
+  }
+}
+
+/** @brief The bfloat16 format: The upper 16 bits of an IEEE single precision number, i.e. 8 exponent bits and 7 mantissa bits.
+*
+* The range of float is preserved, while the relative precision is about 3e-3.
+*/
+class bfloat16
+{
+public:
+  bfloat16() : bits_(0) {}
+
+  /** @brief Rounds a single precision number to the nearest bfloat16 number (ties to even) */
+  explicit bfloat16(float f)
+  {
+    unsigned int bits = detail::float_as_bits(f);
+    if ((bits & 0x7fffffff) > 0x7f800000) // NaN: keep it a (quiet) NaN
+      bits_ = static_cast<unsigned short>((bits >> 16) | 0x40);
+    else
+      bits_ = static_cast<unsigned short>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+  }
+
+  /** @brief Converts to single precision, which is exact */
+  operator float() const { return detail::bits_as_float(static_cast<unsigned int>(bits_) << 16); }
+
+  /** @brief Returns the bit representation */
+  unsigned short bits() const { return bits_; }
+
+private:
+  unsigned short bits_;
+};
+
+/** @brief The IEEE 754 half precision format with 5 exponent bits and 10 mantissa bits.
+*
+* The relative precision is about 5e-4, but the largest finite number is 65504 and numbers below 6.1e-5 are subnormal.
+* Hence, matrix values should be scaled to a moderate range before conversion.
+*/
+class half
+{
+public:
+  half() : bits_(0) {}
+
+  /** @brief Rounds a single precision number to the nearest half precision number (ties to even). Numbers beyond the range of half precision become infinite. */
+  explicit half(float f)
+  {
+    unsigned int bits = detail::float_as_bits(f);
+    unsigned int sign = (bits >> 16) & 0x8000;
+    unsigned int abs  = bits & 0x7fffffff;
+
+    if (abs >= 0x7f800000)      // infinity or NaN
+      bits_ = static_cast<unsigned short>(sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0));
+    else if (abs >= 0x477ff000) // rounds to infinity (65520 and larger)
+      bits_ = static_cast<unsigned short>(sign | 0x7c00);
+    else if (abs >= 0x38800000) // normal number: rebias the exponent and round the mantissa
+    {
+      unsigned int h   = (abs - 0x38000000) >> 13;
+      unsigned int rem = abs & 0x1fff;
+      if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        ++h;
+      bits_ = static_cast<unsigned short>(sign | h);
+    }
+    else if (abs >= 0x33000000) // subnormal number
+    {
+      unsigned int shift    = 126 - (abs >> 23);
+      unsigned int mantissa = (abs & 0x7fffff) | 0x800000;
+      unsigned int h        = mantissa >> shift;
+      unsigned int rem      = mantissa & ((1u << shift) - 1);
+      unsigned int halfway  = 1u << (shift - 1);
+      if (rem > halfway || (rem == halfway && (h & 1)))
+        ++h;
+      bits_ = static_cast<unsigned short>(sign | h);
+    }
+    else                        // underflow to zero
+      bits_ = static_cast<unsigned short>(sign);
+  }
+
+  /** @brief Converts to single precision, which is exact */
+  operator float() const
+  {
+    unsigned int sign     = static_cast<unsigned int>(bits_ & 0x8000) << 16;
+    unsigned int exponent = (bits_ >> 10) & 0x1f;
+    unsigned int mantissa = bits_ & 0x3ff;
+
+    if (exponent == 0) // zero or subnormal
+    {
+      float value = std::ldexp(static_cast<float>(mantissa), -24);
+      return sign ? -value : value;
+    }
+    if (exponent == 31) // infinity or NaN
+      return detail::bits_as_float(sign | 0x7f800000 | (mantissa << 13));
+    return detail::bits_as_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+  }
+
+  /** @brief Returns the bit representation */
+  unsigned short bits() const { return bits_; }
+
+private:
+  unsigned short bits_;
+};
+
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,570 @@
+#ifndef VIENNACL_TOOLS_SPARSE_FORMAT_ANALYZER_HPP_
+#define VIENNACL_TOOLS_SPARSE_FORMAT_ANALYZER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2016, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/sparse_format_analyzer.hpp
+    @brief Row-length statistics of sparse matrices and a roofline model predicting the sparse matrix-vector product time of each sparse matrix format.
+
+    The sparse matrix-vector product is memory bound, hence the predicted time is essentially the number of bytes transferred divided by the memory bandwidth.
+    The bytes transferred depend on the format (index overhead, padding of ELL-type formats) and on the locality of the accesses to the vector (matrix bandwidth vs. cache size).
+    On the host, kernels parallelized over rows are further penalized by the load imbalance of the static row partition, while serial kernels only see the bandwidth of a single core.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include "viennacl/forwards.h"
+#include "viennacl/context.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/timer.hpp"
+
+/** @brief Number of rows per slice assumed for the sliced ELL format (the default of sliced_ell_matrix) */
+#ifndef VIENNACL_SPARSE_ANALYZER_SLICE_ROWS
+  #define VIENNACL_SPARSE_ANALYZER_SLICE_ROWS 32
+#endif
+
+namespace viennacl
+{
+namespace tools
+{
+
+/** @brief The sparse matrix formats supported by the analyzer */
+enum sparse_format
+{
+  SPARSE_FORMAT_CSR = 0,         ///< compressed_matrix
+  SPARSE_FORMAT_COO,             ///< coordinate_matrix
+  SPARSE_FORMAT_ELL,             ///< ell_matrix
+  SPARSE_FORMAT_SLICED_ELL,      ///< sliced_ell_matrix
+  SPARSE_FORMAT_HYB,             ///< hyb_matrix
+  SPARSE_FORMAT_COMPRESSED_CSR,  ///< compressed_compressed_matrix
+  SPARSE_FORMAT_COUNT
+};
+
+/** @brief Returns a human-readable name of the sparse matrix format */
+inline const char * sparse_format_name(sparse_format f)
+{
+  switch (f)
+  {
+  case SPARSE_FORMAT_CSR:            return "compressed_matrix";
+  case SPARSE_FORMAT_COO:            return "coordinate_matrix";
+  case SPARSE_FORMAT_ELL:            return "ell_matrix";
+  case SPARSE_FORMAT_SLICED_ELL:     return "sliced_ell_matrix";
+  case SPARSE_FORMAT_HYB:            return "hyb_matrix";
+  case SPARSE_FORMAT_COMPRESSED_CSR: return "compressed_compressed_matrix";
+  default:                           return "unknown";
+  }
+}
+
+/** @brief Structural properties of a sparse matrix relevant for the choice of the storage format */
+struct sparse_matrix_statistics
+{
+  sparse_matrix_statistics() : rows(0), cols(0), nnz(0), empty_rows(0), min_row_length(0), max_row_length(0),
+                               mean_row_length(0), row_length_stddev(0), bandwidth(0), mean_column_distance(0),
+                               num_partitions(1), partition_imbalance(1), sliced_ell_entries(0), hyb_ell_width(0), hyb_csr_nnz(0) {}
+
+  vcl_size_t rows;
+  vcl_size_t cols;
+  vcl_size_t nnz;
+  vcl_size_t empty_rows;
+  vcl_size_t min_row_length;
+  vcl_size_t max_row_length;        ///< Width of the ELL format
+  double     mean_row_length;
+  double     row_length_stddev;
+  vcl_size_t bandwidth;             ///< Maximum of |i - j| over all nonzeros (i,j)
+  double     mean_column_distance;  ///< Mean of |i - j| over all nonzeros (i,j)
+  vcl_size_t num_partitions;        ///< Number of contiguous row blocks used for the load balance estimate
+  double     partition_imbalance;   ///< Maximum number of nonzeros in a row block divided by the mean
+  vcl_size_t sliced_ell_entries;    ///< Number of stored entries (including padding) of the sliced ELL format
+  vcl_size_t hyb_ell_width;         ///< Width of the ELL part of the HYB format
+  vcl_size_t hyb_csr_nnz;           ///< Number of nonzeros in the CSR part of the HYB format
+
+  /** @brief Ratio of stored entries to nonzeros of the ELL format */
+  double ell_padding() const        { return nnz ? double(rows * max_row_length) / double(nnz) : 1.0; }
+  /** @brief Ratio of stored entries to nonzeros of the sliced ELL format */
+  double sliced_ell_padding() const { return nnz ? double(sliced_ell_entries) / double(nnz) : 1.0; }
+  /** @brief Ratio of stored entries to nonzeros of the HYB format */
+  double hyb_padding() const        { return nnz ? double(rows * hyb_ell_width + hyb_csr_nnz) / double(nnz) : 1.0; }
+};
+
+namespace detail
+{
+  /** @brief Default number of row blocks used for the load balance estimate: the number of OpenMP threads */
+  inline vcl_size_t sparse_analyzer_default_partitions()
+  {
+#ifdef VIENNACL_WITH_OPENMP
+    return static_cast<vcl_size_t>(std::max(1, omp_get_max_threads()));
+#else
+    return 1;
+#endif
+  }
+
+  /** @brief Computes the statistics from the row pointer and column index arrays of a CSR matrix */
+  template<typename IndexArrayT1, typename IndexArrayT2>
+  sparse_matrix_statistics analyze_csr(IndexArrayT1 const & row_buffer, IndexArrayT2 const & col_buffer,
+                                       vcl_size_t rows, vcl_size_t cols, vcl_size_t num_partitions,
+                                       double hyb_threshold = 0.8)
+  {
+    sparse_matrix_statistics stats;
+    stats.rows = rows;
+    stats.cols = cols;
+    stats.nnz  = rows ? vcl_size_t(row_buffer[rows]) : 0;
+    stats.num_partitions = std::max<vcl_size_t>(num_partitions, 1);
+    if (rows == 0)
+      return stats;
+
+    stats.min_row_length = stats.nnz;
+    std::vector<vcl_size_t> row_length_histogram;
+    double sum_squares = 0;
+    double sum_distance = 0;
+    vcl_size_t slice_width = 0;
+    for (vcl_size_t row = 0; row < rows; ++row)
+    {
+      vcl_size_t row_start = vcl_size_t(row_buffer[row]);
+      vcl_size_t row_stop  = vcl_size_t(row_buffer[row+1]);
+      vcl_size_t length = row_stop - row_start;
+
+      if (length == 0)
+        ++stats.empty_rows;
+      stats.min_row_length = std::min(stats.min_row_length, length);
+      stats.max_row_length = std::max(stats.max_row_length, length);
+      sum_squares += double(length) * double(length);
+
+      if (length >= row_length_histogram.size())
+        row_length_histogram.resize(length + 1);
+      row_length_histogram[length] += 1;
+
+      for (vcl_size_t i = row_start; i < row_stop; ++i)
+      {
+        vcl_size_t col = vcl_size_t(col_buffer[i]);
+        vcl_size_t distance = (col > row) ? col - row : row - col;
+        stats.bandwidth = std::max(stats.bandwidth, distance);
+        sum_distance += double(distance);
+      }
+
+      slice_width = std::max(slice_width, length);
+      if (row % VIENNACL_SPARSE_ANALYZER_SLICE_ROWS == VIENNACL_SPARSE_ANALYZER_SLICE_ROWS - 1 || row == rows - 1)
+      {
+        stats.sliced_ell_entries += slice_width * VIENNACL_SPARSE_ANALYZER_SLICE_ROWS;
+        slice_width = 0;
+      }
+    }
+
+    stats.mean_row_length = double(stats.nnz) / double(rows);
+    stats.row_length_stddev = std::sqrt(std::max(0.0, sum_squares / double(rows) - stats.mean_row_length * stats.mean_row_length));
+    stats.mean_column_distance = stats.nnz ? sum_distance / double(stats.nnz) : 0;
+
+    // ELL width of the HYB format, chosen the same way as in viennacl::copy() for hyb_matrix:
+    vcl_size_t sum = 0;
+    stats.hyb_ell_width = stats.max_row_length;
+    for (vcl_size_t length = 0; length < row_length_histogram.size(); ++length)
+    {
+      sum += row_length_histogram[length];
+      if (double(sum) >= hyb_threshold * double(rows))
+      {
+        stats.hyb_ell_width = length;
+        break;
+      }
+    }
+    for (vcl_size_t row = 0; row < rows; ++row)
+    {
+      vcl_size_t length = vcl_size_t(row_buffer[row+1] - row_buffer[row]);
+      if (length > stats.hyb_ell_width)
+        stats.hyb_csr_nnz += length - stats.hyb_ell_width;
+    }
+
+    // load imbalance of a static partition into contiguous row blocks, as used by 'omp parallel for schedule(static)':
+    vcl_size_t partitions = std::min(stats.num_partitions, rows);
+    vcl_size_t max_partition_nnz = 0;
+    for (vcl_size_t p = 0; p < partitions; ++p)
+    {
+      vcl_size_t row_start = (rows * p) / partitions;
+      vcl_size_t row_stop  = (rows * (p + 1)) / partitions;
+      max_partition_nnz = std::max(max_partition_nnz, vcl_size_t(row_buffer[row_stop] - row_buffer[row_start]));
+    }
+    stats.partition_imbalance = stats.nnz ? double(max_partition_nnz) * double(partitions) / double(stats.nnz) : 1.0;
+
+    return stats;
+  }
+}
+
+/** @brief Computes the statistics of a sparse matrix given in the STL format.
+*
+* @param A               The sparse matrix
+* @param cols            Number of columns. If zero, the largest column index plus one is used.
+* @param num_partitions  Number of row blocks for the estimate of the load imbalance. If zero, the number of OpenMP threads is used.
+*/
+template<typename NumericT>
+sparse_matrix_statistics analyze_sparse_matrix(std::vector< std::map<unsigned int, NumericT> > const & A, vcl_size_t cols = 0, vcl_size_t num_partitions = 0)
+{
+  std::vector<unsigned int> row_buffer(A.size() + 1);
+  std::vector<unsigned int> col_buffer;
+  vcl_size_t max_col = 0;
+  for (vcl_size_t row = 0; row < A.size(); ++row)
+  {
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = A[row].begin(); it != A[row].end(); ++it)
+    {
+      col_buffer.push_back(it->first);
+      max_col = std::max<vcl_size_t>(max_col, it->first + 1);
+    }
+    row_buffer[row+1] = static_cast<unsigned int>(col_buffer.size());
+  }
+
+  return detail::analyze_csr(row_buffer, col_buffer, A.size(), cols ? cols : max_col,
+                             num_partitions ? num_partitions : detail::sparse_analyzer_default_partitions());
+}
+
+/** @brief Computes the statistics of a compressed_matrix. The index arrays are read to the host if necessary. */
+template<typename NumericT, unsigned int AlignmentV>
+sparse_matrix_statistics analyze_sparse_matrix(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, vcl_size_t num_partitions = 0)
+{
+  if (num_partitions == 0)
+    num_partitions = detail::sparse_analyzer_default_partitions();
+  if (A.size1() == 0)
+    return detail::analyze_csr(std::vector<unsigned int>(1), std::vector<unsigned int>(), 0, A.size2(), num_partitions);
+
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+  viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), std::max<vcl_size_t>(A.nnz(), 1));
+  viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+  if (A.nnz() > 0)
+    viennacl::backend::memory_read(A.handle2(), 0, col_buffer.element_size() * A.nnz(), col_buffer.get());
+
+  return detail::analyze_csr(row_buffer, col_buffer, A.size1(), A.size2(), num_partitions);
+}
+
+
+/** @brief Reads of the input vector in a sparse matrix-vector product and the resulting cache misses, cf. spmv_vector_cache_misses() */
+struct spmv_vector_cache_statistics
+{
+  spmv_vector_cache_statistics() : accesses(0), compulsory_misses(0), misses(0) {}
+
+  vcl_size_t accesses;           ///< Number of reads of the input vector, i.e. the number of nonzeros
+  vcl_size_t compulsory_misses;  ///< Number of distinct cache lines of the input vector read at least once
+  vcl_size_t misses;             ///< Number of cache misses
+
+  /** @brief Number of misses per read of the input vector */
+  double miss_rate() const { return accesses ? double(misses) / double(accesses) : 0.0; }
+  /** @brief Ratio of misses to compulsory misses. A value of one means that each cache line of the input vector is loaded only once. */
+  double reload_factor() const { return compulsory_misses ? double(misses) / double(compulsory_misses) : 1.0; }
+};
+
+namespace detail
+{
+  /** @brief Simulates the accesses to the input vector by a CSR sparse matrix-vector product traversing the rows in order, using a fully associative cache with least-recently-used replacement. */
+  template<typename IndexArrayT1, typename IndexArrayT2>
+  spmv_vector_cache_statistics simulate_spmv_vector_cache(IndexArrayT1 const & row_buffer, IndexArrayT2 const & col_buffer,
+                                                          vcl_size_t rows, vcl_size_t cols, vcl_size_t value_size,
+                                                          vcl_size_t cache_bytes, vcl_size_t line_bytes)
+  {
+    spmv_vector_cache_statistics stats;
+
+    vcl_size_t values_per_line = std::max<vcl_size_t>(line_bytes / std::max<vcl_size_t>(value_size, 1), 1);
+    vcl_size_t num_lines = (cols + values_per_line - 1) / values_per_line;
+    vcl_size_t capacity  = std::max<vcl_size_t>(cache_bytes / std::max<vcl_size_t>(line_bytes, 1), 1);
+
+    // doubly linked list of cached lines, most recently used first. Entry num_lines is the list head.
+    std::vector<vcl_size_t> prev(num_lines + 1, num_lines);
+    std::vector<vcl_size_t> next(num_lines + 1, num_lines);
+    std::vector<bool> cached(num_lines, false);
+    std::vector<bool> touched(num_lines, false);
+    vcl_size_t head = num_lines;
+    vcl_size_t cached_lines = 0;
+
+    for (vcl_size_t row = 0; row < rows; ++row)
+      for (vcl_size_t i = vcl_size_t(row_buffer[row]); i < vcl_size_t(row_buffer[row+1]); ++i)
+      {
+        vcl_size_t line = vcl_size_t(col_buffer[i]) / values_per_line;
+        ++stats.accesses;
+
+        if (cached[line]) // unlink, then reinsert at the front
+        {
+          next[prev[line]] = next[line];
+          prev[next[line]] = prev[line];
+        }
+        else
+        {
+          ++stats.misses;
+          if (!touched[line])
+          {
+            touched[line] = true;
+            ++stats.compulsory_misses;
+          }
+
+          if (cached_lines == capacity) // evict least recently used line
+          {
+            vcl_size_t victim = prev[head];
+            next[prev[victim]] = head;
+            prev[head] = prev[victim];
+            cached[victim] = false;
+            --cached_lines;
+          }
+          cached[line] = true;
+          ++cached_lines;
+        }
+
+        next[line] = next[head];
+        prev[line] = head;
+        prev[next[head]] = line;
+        next[head] = line;
+      }
+
+    return stats;
+  }
+}
+
+/** @brief Estimates the cache misses caused by reading the input vector x in the sparse matrix-vector product y = A * x.
+*
+* The rows are traversed in order as by a single thread, and a fully associative cache with least-recently-used replacement is simulated.
+* Comparing the result before and after reordering the matrix (cf. viennacl::reorder() and viennacl::reordered_matrix) shows the benefit of the reordering without timing runs.
+* Only the accesses to the input vector are considered, since the matrix entries and the result vector are streamed irrespective of the ordering.
+*
+* @param A            The sparse matrix. The index arrays are read to the host if necessary.
+* @param cache_bytes  Size of the cache available for the input vector in bytes
+* @param line_bytes   Size of a cache line in bytes
+*/
+template<typename NumericT, unsigned int AlignmentV>
+spmv_vector_cache_statistics spmv_vector_cache_misses(viennacl::compressed_matrix<NumericT, AlignmentV> const & A,
+                                                      vcl_size_t cache_bytes = 256 * 1024, vcl_size_t line_bytes = 64)
+{
+  if (A.size1() == 0 || A.nnz() == 0)
+    return spmv_vector_cache_statistics();
+
+  viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+  viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+  viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+  viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+  return detail::simulate_spmv_vector_cache(row_buffer, col_buffer, A.size1(), A.size2(), sizeof(NumericT), cache_bytes, line_bytes);
+}
+
+
+/** @brief Roofline-type model for the execution time of sparse matrix-vector products in the different formats.
+*
+* The parameters default to typical values for the given memory domain and can either be set manually or measured using calibrate().
+*/
+class sparse_performance_model
+{
+public:
+  explicit sparse_performance_model(viennacl::memory_types mem = viennacl::MAIN_MEMORY) : memory_type_(mem)
+  {
+    if (mem == viennacl::MAIN_MEMORY)
+    {
+      bandwidth_        = 20e9;
+      serial_bandwidth_ = 8e9;
+      flop_rate_        = 20e9;
+      cache_size_       = 1 << 20;
+      kernel_overhead_  = 0;
+
+      // efficiency of the access patterns: the host ELL-type kernels traverse the column-major storage row by row
+      efficiency_[SPARSE_FORMAT_CSR]            = 1.0;
+      efficiency_[SPARSE_FORMAT_COO]            = 0.8;
+      efficiency_[SPARSE_FORMAT_ELL]            = 0.5;
+      efficiency_[SPARSE_FORMAT_SLICED_ELL]     = 0.9;
+      efficiency_[SPARSE_FORMAT_HYB]            = 0.5;
+      efficiency_[SPARSE_FORMAT_COMPRESSED_CSR] = 1.0;
+    }
+    else
+    {
+      bandwidth_        = 200e9;
+      serial_bandwidth_ = 200e9;
+      flop_rate_        = 2e12;
+      cache_size_       = 2 << 20;
+      kernel_overhead_  = 5e-6;
+
+      // efficiency of the access patterns: ELL-type formats are fully coalesced, row-based formats suffer from irregular row lengths
+      efficiency_[SPARSE_FORMAT_CSR]            = 0.8;
+      efficiency_[SPARSE_FORMAT_COO]            = 0.6;
+      efficiency_[SPARSE_FORMAT_ELL]            = 1.0;
+      efficiency_[SPARSE_FORMAT_SLICED_ELL]     = 0.95;
+      efficiency_[SPARSE_FORMAT_HYB]            = 0.95;
+      efficiency_[SPARSE_FORMAT_COMPRESSED_CSR] = 0.8;
+    }
+  }
+
+  viennacl::memory_types memory_type() const { return memory_type_; }
+
+  /** @brief Memory bandwidth in bytes per second available to parallel kernels */
+  double bandwidth() const { return bandwidth_; }
+  void bandwidth(double bw) { bandwidth_ = bw; }
+
+  /** @brief Memory bandwidth in bytes per second available to serial kernels (host only) */
+  double serial_bandwidth() const { return serial_bandwidth_; }
+  void serial_bandwidth(double bw) { serial_bandwidth_ = bw; }
+
+  /** @brief Peak floating point operations per second */
+  double flop_rate() const { return flop_rate_; }
+  void flop_rate(double rate) { flop_rate_ = rate; }
+
+  /** @brief Size of the last level cache in bytes. Accesses to the vector within this distance are assumed to hit the cache. */
+  double cache_size() const { return cache_size_; }
+  void cache_size(double bytes) { cache_size_ = bytes; }
+
+  /** @brief Launch overhead per kernel in seconds */
+  double kernel_overhead() const { return kernel_overhead_; }
+  void kernel_overhead(double t) { kernel_overhead_ = t; }
+
+  /** @brief Fraction of the bandwidth achieved by the sparse matrix-vector product kernel of the given format */
+  double efficiency(sparse_format f) const { return efficiency_[f]; }
+  void efficiency(sparse_format f, double e) { efficiency_[f] = e; }
+
+  /** @brief Returns true if the sparse matrix-vector product kernel of the format runs in parallel */
+  bool is_parallel(sparse_format f) const
+  {
+    if (memory_type_ != viennacl::MAIN_MEMORY)
+      return true;
+#ifdef VIENNACL_WITH_OPENMP
+    return f == SPARSE_FORMAT_CSR || f == SPARSE_FORMAT_SLICED_ELL || f == SPARSE_FORMAT_COMPRESSED_CSR;
+#else
+    (void)f;
+    return false;
+#endif
+  }
+
+  /** @brief Number of bytes required for storing the matrix in the given format */
+  double matrix_bytes(sparse_matrix_statistics const & stats, sparse_format f, vcl_size_t value_size) const
+  {
+    double entry_size = double(value_size + sizeof(unsigned int));
+    double index_size = double(sizeof(unsigned int));
+    double rows = double(stats.rows);
+    double slices = double((stats.rows + VIENNACL_SPARSE_ANALYZER_SLICE_ROWS - 1) / VIENNACL_SPARSE_ANALYZER_SLICE_ROWS);
+    switch (f)
+    {
+    case SPARSE_FORMAT_CSR:            return (rows + 1) * index_size + double(stats.nnz) * entry_size;
+    case SPARSE_FORMAT_COO:            return double(stats.nnz) * (entry_size + index_size);
+    case SPARSE_FORMAT_ELL:            return rows * double(stats.max_row_length) * entry_size;
+    case SPARSE_FORMAT_SLICED_ELL:     return 3.0 * slices * index_size + double(stats.sliced_ell_entries) * entry_size;
+    case SPARSE_FORMAT_HYB:            return rows * double(stats.hyb_ell_width) * entry_size + (rows + 1) * index_size + double(stats.hyb_csr_nnz) * entry_size;
+    case SPARSE_FORMAT_COMPRESSED_CSR: return (2.0 * double(stats.rows - stats.empty_rows) + 1) * index_size + double(stats.nnz) * entry_size;
+    default:                           return 0;
+    }
+  }
+
+  /** @brief Number of bytes transferred for accessing the input and the result vector.
+  *
+  * The input vector is read once if all accesses within a row are within the cache, otherwise every nonzero causes a separate load.
+  */
+  double vector_bytes(sparse_matrix_statistics const & stats, sparse_format f, vcl_size_t value_size) const
+  {
+    double cached_fraction = std::min(1.0, cache_size_ / std::max(1.0, 2.0 * double(stats.bandwidth) * double(value_size)));
+    double x_bytes = double(stats.cols) * double(value_size)
+                   + (1.0 - cached_fraction) * std::max(0.0, double(stats.nnz) - double(stats.cols)) * double(value_size);
+    double y_bytes = double(stats.rows) * double(value_size);
+    if (f == SPARSE_FORMAT_COO)  // result is accumulated
+      y_bytes *= 2;
+    return x_bytes + y_bytes;
+  }
+
+  /** @brief Predicted execution time in seconds of y = prod(A, x) with A stored in the given format */
+  double predict_spmv_time(sparse_matrix_statistics const & stats, sparse_format f, vcl_size_t value_size) const
+  {
+    double bytes = matrix_bytes(stats, f, value_size) + vector_bytes(stats, f, value_size);
+    double flops = 2.0 * double(stats.nnz);
+
+    double bw = is_parallel(f) ? bandwidth_ : std::min(bandwidth_, serial_bandwidth_);
+    double time = std::max(bytes / (bw * efficiency_[f]), flops / flop_rate_);
+
+    // static row partition on the host: the busiest thread determines the execution time
+    if (memory_type_ == viennacl::MAIN_MEMORY && is_parallel(f) && f != SPARSE_FORMAT_SLICED_ELL)
+      time *= stats.partition_imbalance;
+
+    double kernels = (f == SPARSE_FORMAT_COO) ? 2.0 : 1.0;  // segmented reduction of COO requires a second pass
+    return time + kernels * kernel_overhead_;
+  }
+
+  /** @brief Returns the format with the smallest predicted execution time */
+  sparse_format best_format(sparse_matrix_statistics const & stats, vcl_size_t value_size) const
+  {
+    sparse_format result = SPARSE_FORMAT_CSR;
+    double best_time = predict_spmv_time(stats, SPARSE_FORMAT_CSR, value_size);
+    for (int i = 1; i < SPARSE_FORMAT_COUNT; ++i)
+    {
+      sparse_format f = static_cast<sparse_format>(i);
+      if (f == SPARSE_FORMAT_COMPRESSED_CSR && stats.rows != stats.cols)
+        continue;
+      double t = predict_spmv_time(stats, f, value_size);
+      if (t < best_time)
+      {
+        best_time = t;
+        result = f;
+      }
+    }
+    return result;
+  }
+
+  /** @brief Measures the memory bandwidth (and the single-threaded bandwidth on the host) using vector copies in the given context */
+  void calibrate(viennacl::context ctx = viennacl::context(), vcl_size_t size = vcl_size_t(1) << 22)
+  {
+    viennacl::vector<double> x(size, ctx), y = viennacl::scalar_vector<double>(size, 1.0, ctx);
+    memory_type_ = ctx.memory_type();
+    bandwidth_ = 2.0 * double(size * sizeof(double)) / min_time(x, y);
+    serial_bandwidth_ = bandwidth_;
+
+    if (memory_type_ == viennacl::MAIN_MEMORY)
+    {
+      std::vector<double> a(size), b(size, 1.0);
+      viennacl::tools::timer timer;
+      double t = 0;
+      for (int i = 0; i < 5; ++i)
+      {
+        timer.start();
+        std::copy(b.begin(), b.end(), a.begin());
+        double t_run = timer.get();
+        t = (i == 0) ? t_run : std::min(t, t_run);
+      }
+      serial_bandwidth_ = std::min(bandwidth_, 2.0 * double(size * sizeof(double)) / std::max(t, 1e-9));
+    }
+  }
+
+private:
+  static double min_time(viennacl::vector<double> & x, viennacl::vector<double> const & y)
+  {
+    viennacl::tools::timer timer;
+    x = y;
+    viennacl::backend::finish();
+    double t = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      timer.start();
+      x = y;
+      viennacl::backend::finish();
+      double t_run = timer.get();
+      t = (i == 0) ? t_run : std::min(t, t_run);
+    }
+    return std::max(t, 1e-9);
+  }
+
+  viennacl::memory_types memory_type_;
+  double bandwidth_;
+  double serial_bandwidth_;
+  double flop_rate_;
+  double cache_size_;
+  double kernel_overhead_;
+  double efficiency_[SPARSE_FORMAT_COUNT];
+};
+
+} //namespace tools
+} //namespace viennacl
+
+#endif
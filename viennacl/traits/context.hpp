@@ -36,26 +36,32 @@ namespace traits
 
 // Context
 /** @brief Returns an ID for the currently active memory domain of an object */
-template<typename T>
-viennacl::context context(T const & t)
+inline viennacl::context context(viennacl::backend::mem_handle const & h)
 {
 #ifdef VIENNACL_WITH_OPENCL
-  if (traits::active_handle_id(t) == OPENCL_MEMORY)
-    return viennacl::context(traits::opencl_handle(t).context());
+  if (h.get_active_handle_id() == OPENCL_MEMORY)
+    return viennacl::context(h.opencl_handle().context());
 #endif
 
-  return viennacl::context(traits::active_handle_id(t));
+  if (h.get_active_handle_id() == MAIN_MEMORY)
+    return viennacl::context(MAIN_MEMORY, h.numa_policy(), h.numa_node());
+
+  return viennacl::context(h.get_active_handle_id());
 }
 
 /** @brief Returns an ID for the currently active memory domain of an object */
-inline viennacl::context context(viennacl::backend::mem_handle const & h)
+template<typename T>
+viennacl::context context(T const & t)
 {
 #ifdef VIENNACL_WITH_OPENCL
-  if (h.get_active_handle_id() == OPENCL_MEMORY)
-    return viennacl::context(h.opencl_handle().context());
+  if (traits::active_handle_id(t) == OPENCL_MEMORY)
+    return viennacl::context(traits::opencl_handle(t).context());
 #endif
 
-  return viennacl::context(h.get_active_handle_id());
+  if (traits::active_handle_id(t) == MAIN_MEMORY)
+    return traits::context(traits::handle(t));
+
+  return viennacl::context(traits::active_handle_id(t));
 }
 
 } //namespace traits